@@ -6,6 +6,16 @@ dnl Function to detect if libpff dependencies are available
 AC_DEFUN([AX_LIBPFF_CHECK_LOCAL],
   [dnl Check for internationalization functions in libpff/libpff_i18n.c
   AC_CHECK_FUNCS([bindtextdomain])
+
+  dnl Date and time functions used in libpff/libpff_io_handle.c
+  AC_CHECK_FUNCS([clock_gettime])
+
+  dnl Headers and functions used in libpff/libpff_descriptor_io_handle.c
+  AC_CHECK_HEADERS([errno.h fcntl.h sys/stat.h unistd.h])
+
+  AC_CHECK_FUNCS([fstat pread])
+
+  AX_LIBCFILE_CHECK_FUNC_POSIX_FADVISE
 ])
 
 dnl Function to detect if pfftools dependencies are available
@@ -21,6 +31,14 @@ AC_DEFUN([AX_PFFTOOLS_CHECK_LOCAL],
      [1])
   ])
 
+  dnl Headers and functions used in pfftools/directory_handle.c
+  AC_CHECK_HEADERS([fcntl.h sys/stat.h])
+
+  AC_CHECK_FUNCS([fdopen mkdirat openat])
+
+  dnl Date and time functions used in pfftools/profile_handle.c
+  AC_CHECK_FUNCS([clock_gettime])
+
   dnl Headers included in pfftools/log_handle.c
   AC_CHECK_HEADERS([stdarg.h varargs.h])
 
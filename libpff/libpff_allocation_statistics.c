@@ -0,0 +1,1893 @@
+/*
+ * Allocation statistics functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libpff_allocation_statistics.h"
+#include "libpff_allocation_table.h"
+#include "libpff_definitions.h"
+#include "libpff_io_handle.h"
+#include "libpff_libbfio.h"
+#include "libpff_libcerror.h"
+#include "libpff_libcthreads.h"
+#include "libpff_types.h"
+
+#include "pff_allocation_table.h"
+
+/* Creates allocation statistics
+ * Make sure the value allocation_statistics is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_allocation_statistics_initialize(
+     libpff_allocation_statistics_t **allocation_statistics,
+     size32_t allocation_unit_size,
+     libcerror_error_t **error )
+{
+	libpff_internal_allocation_statistics_t *internal_allocation_statistics = NULL;
+	static char *function                                                   = "libpff_allocation_statistics_initialize";
+
+	if( allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( *allocation_statistics != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid allocation statistics value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocation_unit_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid allocation unit size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	internal_allocation_statistics = memory_allocate_structure(
+	                                  libpff_internal_allocation_statistics_t );
+
+	if( internal_allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     internal_allocation_statistics,
+	     0,
+	     sizeof( libpff_internal_allocation_statistics_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear allocation statistics.",
+		 function );
+
+		memory_free(
+		 internal_allocation_statistics );
+
+		return( -1 );
+	}
+	internal_allocation_statistics->allocation_unit_size = allocation_unit_size;
+
+	*allocation_statistics = (libpff_allocation_statistics_t *) internal_allocation_statistics;
+
+	return( 1 );
+}
+
+/* Frees allocation statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_allocation_statistics_free(
+     libpff_allocation_statistics_t **allocation_statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_allocation_statistics_free";
+
+	if( allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( *allocation_statistics != NULL )
+	{
+		memory_free(
+		 *allocation_statistics );
+
+		*allocation_statistics = NULL;
+	}
+	return( 1 );
+}
+
+/* Adds a complete extent to the allocation statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_allocation_statistics_add_extent(
+     libpff_internal_allocation_statistics_t *internal_allocation_statistics,
+     uint8_t is_allocated,
+     uint64_t number_of_units,
+     libcerror_error_t **error )
+{
+	static char *function      = "libpff_allocation_statistics_add_extent";
+	size64_t extent_size       = 0;
+	uint64_t value_64bit       = 0;
+	int histogram_bucket_index = 0;
+
+	if( internal_allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_units == 0 )
+	{
+		return( 1 );
+	}
+	extent_size = (size64_t) number_of_units * internal_allocation_statistics->allocation_unit_size;
+
+	for( value_64bit = number_of_units >> 1;
+	     value_64bit != 0;
+	     value_64bit >>= 1 )
+	{
+		histogram_bucket_index++;
+	}
+	if( histogram_bucket_index >= LIBPFF_ALLOCATION_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS )
+	{
+		histogram_bucket_index = LIBPFF_ALLOCATION_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS - 1;
+	}
+	if( is_allocated != 0 )
+	{
+		internal_allocation_statistics->allocated_size += extent_size;
+
+		internal_allocation_statistics->number_of_allocated_extents += 1;
+
+		internal_allocation_statistics->allocated_extents_histogram[ histogram_bucket_index ] += 1;
+	}
+	else
+	{
+		internal_allocation_statistics->unallocated_size += extent_size;
+
+		internal_allocation_statistics->number_of_unallocated_extents += 1;
+
+		internal_allocation_statistics->unallocated_extents_histogram[ histogram_bucket_index ] += 1;
+
+		if( extent_size > internal_allocation_statistics->largest_unallocated_extent_size )
+		{
+			internal_allocation_statistics->largest_unallocated_extent_size = extent_size;
+		}
+	}
+	return( 1 );
+}
+
+/* Appends a run of allocated or unallocated allocation units
+ * A run of the same type as the last run extends the last run
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_allocation_statistics_append_run(
+     libpff_internal_allocation_statistics_t *internal_allocation_statistics,
+     uint8_t is_allocated,
+     uint64_t number_of_units,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_allocation_statistics_append_run";
+
+	if( internal_allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_units == 0 )
+	{
+		return( 1 );
+	}
+	if( is_allocated != 0 )
+	{
+		is_allocated = 1;
+	}
+	if( internal_allocation_statistics->number_of_runs == 0 )
+	{
+		internal_allocation_statistics->first_run_number_of_units = number_of_units;
+		internal_allocation_statistics->first_run_is_allocated    = is_allocated;
+		internal_allocation_statistics->last_run_number_of_units  = number_of_units;
+		internal_allocation_statistics->last_run_is_allocated     = is_allocated;
+		internal_allocation_statistics->number_of_runs            = 1;
+	}
+	else if( internal_allocation_statistics->last_run_is_allocated == is_allocated )
+	{
+		internal_allocation_statistics->last_run_number_of_units += number_of_units;
+
+		if( internal_allocation_statistics->number_of_runs == 1 )
+		{
+			internal_allocation_statistics->first_run_number_of_units += number_of_units;
+		}
+	}
+	else
+	{
+		/* The last run is complete unless it also is the first run
+		 */
+		if( internal_allocation_statistics->number_of_runs > 1 )
+		{
+			if( libpff_allocation_statistics_add_extent(
+			     internal_allocation_statistics,
+			     internal_allocation_statistics->last_run_is_allocated,
+			     internal_allocation_statistics->last_run_number_of_units,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to add last run extent.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		internal_allocation_statistics->last_run_number_of_units = number_of_units;
+		internal_allocation_statistics->last_run_is_allocated    = is_allocated;
+		internal_allocation_statistics->number_of_runs           = 2;
+	}
+	return( 1 );
+}
+
+/* Merges the allocation statistics of the segment that directly follows
+ * the segment of the destination allocation statistics
+ * The runs at the boundary of both segments are joined
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_allocation_statistics_merge(
+     libpff_internal_allocation_statistics_t *destination_allocation_statistics,
+     libpff_internal_allocation_statistics_t *source_allocation_statistics,
+     libcerror_error_t **error )
+{
+	static char *function      = "libpff_allocation_statistics_merge";
+	int histogram_bucket_index = 0;
+
+	if( destination_allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_allocation_statistics->allocation_unit_size != destination_allocation_statistics->allocation_unit_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: mismatch in allocation unit size.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_allocation_statistics->number_of_runs == 0 )
+	{
+		return( 1 );
+	}
+	if( libpff_allocation_statistics_append_run(
+	     destination_allocation_statistics,
+	     source_allocation_statistics->first_run_is_allocated,
+	     source_allocation_statistics->first_run_number_of_units,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append first run.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_allocation_statistics->number_of_runs == 1 )
+	{
+		return( 1 );
+	}
+	/* The first run of the source is followed by another run hence the last run
+	 * of the destination is complete unless it also is the first run
+	 */
+	if( destination_allocation_statistics->number_of_runs > 1 )
+	{
+		if( libpff_allocation_statistics_add_extent(
+		     destination_allocation_statistics,
+		     destination_allocation_statistics->last_run_is_allocated,
+		     destination_allocation_statistics->last_run_number_of_units,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to add last run extent.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	destination_allocation_statistics->allocated_size                += source_allocation_statistics->allocated_size;
+	destination_allocation_statistics->unallocated_size              += source_allocation_statistics->unallocated_size;
+	destination_allocation_statistics->number_of_allocated_extents   += source_allocation_statistics->number_of_allocated_extents;
+	destination_allocation_statistics->number_of_unallocated_extents += source_allocation_statistics->number_of_unallocated_extents;
+
+	if( source_allocation_statistics->largest_unallocated_extent_size > destination_allocation_statistics->largest_unallocated_extent_size )
+	{
+		destination_allocation_statistics->largest_unallocated_extent_size = source_allocation_statistics->largest_unallocated_extent_size;
+	}
+	for( histogram_bucket_index = 0;
+	     histogram_bucket_index < LIBPFF_ALLOCATION_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS;
+	     histogram_bucket_index++ )
+	{
+		destination_allocation_statistics->allocated_extents_histogram[ histogram_bucket_index ]   += source_allocation_statistics->allocated_extents_histogram[ histogram_bucket_index ];
+		destination_allocation_statistics->unallocated_extents_histogram[ histogram_bucket_index ] += source_allocation_statistics->unallocated_extents_histogram[ histogram_bucket_index ];
+	}
+	destination_allocation_statistics->last_run_number_of_units = source_allocation_statistics->last_run_number_of_units;
+	destination_allocation_statistics->last_run_is_allocated    = source_allocation_statistics->last_run_is_allocated;
+	destination_allocation_statistics->number_of_runs           = 2;
+
+	return( 1 );
+}
+
+/* Finalizes the allocation statistics
+ * The first and last run are added as complete extents
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_allocation_statistics_finalize(
+     libpff_internal_allocation_statistics_t *internal_allocation_statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_allocation_statistics_finalize";
+
+	if( internal_allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_allocation_statistics->number_of_runs > 0 )
+	{
+		if( libpff_allocation_statistics_add_extent(
+		     internal_allocation_statistics,
+		     internal_allocation_statistics->first_run_is_allocated,
+		     internal_allocation_statistics->first_run_number_of_units,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to add first run extent.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_allocation_statistics->number_of_runs > 1 )
+	{
+		if( libpff_allocation_statistics_add_extent(
+		     internal_allocation_statistics,
+		     internal_allocation_statistics->last_run_is_allocated,
+		     internal_allocation_statistics->last_run_number_of_units,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to add last run extent.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	internal_allocation_statistics->number_of_runs            = 0;
+	internal_allocation_statistics->first_run_number_of_units = 0;
+	internal_allocation_statistics->last_run_number_of_units  = 0;
+
+	return( 1 );
+}
+
+/* Determines the number of leading zero bits of a non-zero 64-bit value
+ * Returns the number of leading zero bits
+ */
+int libpff_allocation_statistics_get_number_of_leading_zero_bits(
+     uint64_t value_64bit )
+{
+#if defined( __GNUC__ )
+	return( (int) __builtin_clzll( (unsigned long long) value_64bit ) );
+#else
+	int number_of_bits = 0;
+
+	while( ( value_64bit & 0x8000000000000000ULL ) == 0 )
+	{
+		value_64bit <<= 1;
+
+		number_of_bits++;
+	}
+	return( number_of_bits );
+#endif
+}
+
+/* Reads an allocation bitmap
+ * The most significant bit of a byte represents the first allocation unit,
+ * a bit that is set represents an allocated unit. Only the first number of
+ * units bits are read, since the last allocation table can extend beyond
+ * the end of the file.
+ *
+ * The bitmap is read in 64-bit words, that are stored in big-endian to keep
+ * the bit order, a word where all bits are equal is added as a whole
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_allocation_statistics_read_bitmap(
+     libpff_internal_allocation_statistics_t *internal_allocation_statistics,
+     const uint8_t *bitmap_data,
+     size_t bitmap_data_size,
+     uint64_t number_of_units,
+     libcerror_error_t **error )
+{
+	static char *function        = "libpff_allocation_statistics_read_bitmap";
+	size_t bitmap_data_offset    = 0;
+	uint64_t run_number_of_units = 0;
+	uint64_t value_64bit         = 0;
+	uint8_t is_allocated         = 0;
+	uint8_t run_is_allocated     = 0;
+	int number_of_bits           = 0;
+	int number_of_equal_bits     = 0;
+
+	if( internal_allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( bitmap_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bitmap data.",
+		 function );
+
+		return( -1 );
+	}
+	if( bitmap_data_size > (size_t) ( SSIZE_MAX / 8 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid bitmap data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_units > ( (uint64_t) bitmap_data_size * 8 ) )
+	{
+		number_of_units = (uint64_t) bitmap_data_size * 8;
+	}
+	while( number_of_units > 0 )
+	{
+		if( ( bitmap_data_size - bitmap_data_offset ) >= 8 )
+		{
+			byte_stream_copy_to_uint64_big_endian(
+			 &( bitmap_data[ bitmap_data_offset ] ),
+			 value_64bit );
+
+			bitmap_data_offset += 8;
+			number_of_bits      = 64;
+		}
+		else
+		{
+			value_64bit = (uint64_t) bitmap_data[ bitmap_data_offset ] << 56;
+
+			bitmap_data_offset += 1;
+			number_of_bits      = 8;
+		}
+		if( (uint64_t) number_of_bits > number_of_units )
+		{
+			number_of_bits = (int) number_of_units;
+		}
+		number_of_units -= number_of_bits;
+
+		while( number_of_bits > 0 )
+		{
+			is_allocated = (uint8_t) ( value_64bit >> 63 );
+
+			if( is_allocated != 0 )
+			{
+				if( value_64bit == 0xffffffffffffffffULL )
+				{
+					number_of_equal_bits = 64;
+				}
+				else
+				{
+					number_of_equal_bits = libpff_allocation_statistics_get_number_of_leading_zero_bits(
+					                        ~value_64bit );
+				}
+			}
+			else
+			{
+				if( value_64bit == 0 )
+				{
+					number_of_equal_bits = 64;
+				}
+				else
+				{
+					number_of_equal_bits = libpff_allocation_statistics_get_number_of_leading_zero_bits(
+					                        value_64bit );
+				}
+			}
+			if( number_of_equal_bits > number_of_bits )
+			{
+				number_of_equal_bits = number_of_bits;
+			}
+			if( ( run_number_of_units > 0 )
+			 && ( run_is_allocated != is_allocated ) )
+			{
+				if( libpff_allocation_statistics_append_run(
+				     internal_allocation_statistics,
+				     run_is_allocated,
+				     run_number_of_units,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append run.",
+					 function );
+
+					return( -1 );
+				}
+				run_number_of_units = 0;
+			}
+			run_is_allocated     = is_allocated;
+			run_number_of_units += number_of_equal_bits;
+			number_of_bits      -= number_of_equal_bits;
+
+			if( number_of_equal_bits < 64 )
+			{
+				value_64bit <<= number_of_equal_bits;
+			}
+		}
+	}
+	if( libpff_allocation_statistics_append_run(
+	     internal_allocation_statistics,
+	     run_is_allocated,
+	     run_number_of_units,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append run.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads allocation table data
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_allocation_statistics_read_allocation_table_data(
+     libpff_internal_allocation_statistics_t *internal_allocation_statistics,
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t file_type,
+     uint64_t number_of_units,
+     libcerror_error_t **error )
+{
+	const uint8_t *table_data     = NULL;
+	static char *function         = "libpff_allocation_statistics_read_allocation_table_data";
+	size_t table_data_size        = 0;
+	off64_t back_pointer_offset   = 0;
+	uint8_t allocation_table_type = 0;
+
+	if( internal_allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_allocation_table_read_header_data(
+	     data,
+	     data_size,
+	     file_type,
+	     &allocation_table_type,
+	     &back_pointer_offset,
+	     &table_data,
+	     &table_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read allocation table header.",
+		 function );
+
+		return( -1 );
+	}
+	/* Only the data allocation tables (AMap) are used for the statistics
+	 */
+	if( allocation_table_type != LIBPFF_ALLOCATION_TABLE_TYPE_DATA )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+		 "%s: unsupported allocation table type: 0x%02" PRIx8 ".",
+		 function,
+		 allocation_table_type );
+
+		return( -1 );
+	}
+	if( libpff_allocation_statistics_read_bitmap(
+	     internal_allocation_statistics,
+	     table_data,
+	     table_data_size,
+	     number_of_units,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read allocation bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the allocation tables of a worker
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_allocation_statistics_worker_run(
+     libpff_allocation_statistics_worker_t *worker,
+     libcerror_error_t **error )
+{
+	uint8_t *allocation_table_data    = NULL;
+	static char *function             = "libpff_allocation_statistics_worker_run";
+	size_t allocation_table_data_size = 0;
+	size64_t remaining_size           = 0;
+	ssize_t read_count                = 0;
+	off64_t allocation_table_offset   = 0;
+	uint64_t allocation_table_index   = 0;
+	uint64_t number_of_units          = 0;
+	uint32_t allocation_unit_size     = 0;
+	int result                        = 0;
+
+	if( worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( worker->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid worker - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( worker->allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid worker - missing allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( worker->io_handle->file_type == LIBPFF_FILE_TYPE_32BIT )
+	{
+		allocation_table_data_size = sizeof( pff_allocation_table_32bit_t );
+	}
+	else if( worker->io_handle->file_type == LIBPFF_FILE_TYPE_64BIT )
+	{
+		allocation_table_data_size = sizeof( pff_allocation_table_64bit_t );
+	}
+	else
+	{
+		allocation_table_data_size = sizeof( pff_allocation_table_64bit_4k_page_t );
+	}
+	allocation_unit_size    = worker->allocation_statistics->allocation_unit_size;
+	allocation_table_offset = worker->allocation_table_offset;
+
+	/* The buffer is reused for every allocation table of the worker
+	 */
+	allocation_table_data = (uint8_t *) memory_allocate(
+	                                     sizeof( uint8_t ) * allocation_table_data_size );
+
+	if( allocation_table_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create allocation table data.",
+		 function );
+
+		goto on_error;
+	}
+	for( allocation_table_index = 0;
+	     allocation_table_index < worker->number_of_allocation_tables;
+	     allocation_table_index++ )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( worker->read_limits_mutex != NULL )
+		{
+			if( libcthreads_mutex_grab(
+			     worker->read_limits_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab read limits mutex.",
+				 function );
+
+				goto on_error;
+			}
+		}
+#endif
+		result = libpff_io_handle_check_read_limits(
+		          worker->io_handle,
+		          allocation_table_data_size,
+		          error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( worker->read_limits_mutex != NULL )
+		{
+			if( libcthreads_mutex_release(
+			     worker->read_limits_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release read limits mutex.",
+				 function );
+
+				goto on_error;
+			}
+		}
+#endif
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_ABORT_REQUESTED,
+			 "%s: unable to read allocation table data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 allocation_table_offset,
+			 allocation_table_offset );
+
+			goto on_error;
+		}
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              worker->file_io_handle,
+		              allocation_table_data,
+		              allocation_table_data_size,
+		              allocation_table_offset,
+		              error );
+
+		if( read_count != (ssize_t) allocation_table_data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read allocation table data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 allocation_table_offset,
+			 allocation_table_offset );
+
+			goto on_error;
+		}
+		remaining_size = worker->io_handle->file_size - (size64_t) allocation_table_offset;
+
+		if( remaining_size > worker->allocation_table_range )
+		{
+			remaining_size = worker->allocation_table_range;
+		}
+		number_of_units = remaining_size / allocation_unit_size;
+
+		if( libpff_allocation_statistics_read_allocation_table_data(
+		     worker->allocation_statistics,
+		     allocation_table_data,
+		     allocation_table_data_size,
+		     worker->io_handle->file_type,
+		     number_of_units,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read allocation table at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 allocation_table_offset,
+			 allocation_table_offset );
+
+			goto on_error;
+		}
+		allocation_table_offset += worker->allocation_table_range;
+	}
+	memory_free(
+	 allocation_table_data );
+
+	return( 1 );
+
+on_error:
+	if( allocation_table_data != NULL )
+	{
+		memory_free(
+		 allocation_table_data );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The allocation statistics worker thread function
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_allocation_statistics_worker_thread_function(
+     libpff_allocation_statistics_worker_t *worker )
+{
+	if( worker == NULL )
+	{
+		return( -1 );
+	}
+	worker->result = libpff_allocation_statistics_worker_run(
+	                  worker,
+	                  &( worker->error ) );
+
+	return( 1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Frees the allocation statistics workers
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_allocation_statistics_free_workers(
+     libpff_allocation_statistics_worker_t **workers,
+     int number_of_workers,
+     libcerror_error_t **error )
+{
+	libpff_allocation_statistics_worker_t *worker = NULL;
+	static char *function                         = "libpff_allocation_statistics_free_workers";
+	int result                                    = 1;
+	int worker_index                              = 0;
+
+	if( workers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid workers.",
+		 function );
+
+		return( -1 );
+	}
+	if( *workers == NULL )
+	{
+		return( 1 );
+	}
+	for( worker_index = 0;
+	     worker_index < number_of_workers;
+	     worker_index++ )
+	{
+		worker = &( ( *workers )[ worker_index ] );
+
+		if( worker->file_io_handle_opened != 0 )
+		{
+			if( libbfio_handle_close(
+			     worker->file_io_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close worker: %d file IO handle.",
+				 function,
+				 worker_index );
+
+				result = -1;
+			}
+		}
+		if( worker->file_io_handle_cloned != 0 )
+		{
+			if( libbfio_handle_free(
+			     &( worker->file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free worker: %d file IO handle.",
+				 function,
+				 worker_index );
+
+				result = -1;
+			}
+		}
+		if( worker->allocation_statistics != NULL )
+		{
+			if( libpff_allocation_statistics_free(
+			     (libpff_allocation_statistics_t **) &( worker->allocation_statistics ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free worker: %d allocation statistics.",
+				 function,
+				 worker_index );
+
+				result = -1;
+			}
+		}
+		if( worker->error != NULL )
+		{
+			libcerror_error_free(
+			 &( worker->error ) );
+		}
+	}
+	memory_free(
+	 *workers );
+
+	*workers = NULL;
+
+	return( result );
+}
+
+/* Reads the allocation statistics from the data allocation tables (AMap)
+ * The allocation tables are divided in contiguous ranges that are read by
+ * separate workers, the calling thread runs the first worker
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_allocation_statistics_read_file_io_handle(
+     libpff_allocation_statistics_t *allocation_statistics,
+     libpff_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libpff_allocation_statistics_worker_t *worker                           = NULL;
+	libpff_allocation_statistics_worker_t *workers                          = NULL;
+	libpff_internal_allocation_statistics_t *internal_allocation_statistics = NULL;
+	static char *function                                                   = "libpff_allocation_statistics_read_file_io_handle";
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_t *read_limits_mutex                                  = NULL;
+#endif
+	size64_t allocation_table_range                                         = 0;
+	off64_t first_allocation_table_offset                                   = 0;
+	uint64_t number_of_allocation_tables                                    = 0;
+	uint64_t number_of_worker_allocation_tables                             = 0;
+	int number_of_workers                                                   = 0;
+	int result                                                              = 1;
+	int worker_index                                                        = 0;
+
+	if( allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	internal_allocation_statistics = (libpff_internal_allocation_statistics_t *) allocation_statistics;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( io_handle->file_type == LIBPFF_FILE_TYPE_32BIT )
+	 || ( io_handle->file_type == LIBPFF_FILE_TYPE_64BIT ) )
+	{
+		first_allocation_table_offset = 0x4400;
+		allocation_table_range        = 496 * 8 * 64;
+	}
+	else if( io_handle->file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE )
+	{
+		first_allocation_table_offset = 0x22000;
+		allocation_table_range        = 4072 * 8 * 512;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported file type.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBPFF_MAXIMUM_NUMBER_OF_VISIT_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) first_allocation_table_offset < io_handle->file_size )
+	{
+		number_of_allocation_tables = ( io_handle->file_size - first_allocation_table_offset + allocation_table_range - 1 )
+		                            / allocation_table_range;
+	}
+	if( number_of_allocation_tables == 0 )
+	{
+		return( 1 );
+	}
+	number_of_workers = number_of_threads;
+
+	if( (uint64_t) number_of_workers > number_of_allocation_tables )
+	{
+		number_of_workers = (int) number_of_allocation_tables;
+	}
+	workers = (libpff_allocation_statistics_worker_t *) memory_allocate(
+	                                                     sizeof( libpff_allocation_statistics_worker_t ) * number_of_workers );
+
+	if( workers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create workers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     workers,
+	     0,
+	     sizeof( libpff_allocation_statistics_worker_t ) * number_of_workers ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear workers.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( number_of_workers > 1 )
+	{
+		if( libcthreads_mutex_initialize(
+		     &read_limits_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read limits mutex.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	for( worker_index = 0;
+	     worker_index < number_of_workers;
+	     worker_index++ )
+	{
+		worker = &( workers[ worker_index ] );
+
+		number_of_worker_allocation_tables = number_of_allocation_tables / number_of_workers;
+
+		if( (uint64_t) worker_index < ( number_of_allocation_tables % number_of_workers ) )
+		{
+			number_of_worker_allocation_tables += 1;
+		}
+		worker->io_handle                   = io_handle;
+		worker->allocation_table_offset     = first_allocation_table_offset;
+		worker->allocation_table_range      = allocation_table_range;
+		worker->number_of_allocation_tables = number_of_worker_allocation_tables;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		worker->read_limits_mutex = read_limits_mutex;
+#endif
+
+		first_allocation_table_offset += (off64_t) ( number_of_worker_allocation_tables * allocation_table_range );
+
+		if( libpff_allocation_statistics_initialize(
+		     (libpff_allocation_statistics_t **) &( worker->allocation_statistics ),
+		     internal_allocation_statistics->allocation_unit_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create worker: %d allocation statistics.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+		/* The first worker runs on the calling thread and uses the file IO handle
+		 * of the file, the other workers use their own clone
+		 */
+		if( worker_index == 0 )
+		{
+			worker->file_io_handle = file_io_handle;
+
+			continue;
+		}
+		if( libbfio_handle_clone(
+		     &( worker->file_io_handle ),
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to clone worker: %d file IO handle.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+		worker->file_io_handle_cloned = 1;
+
+		result = libbfio_handle_is_open(
+		          worker->file_io_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to determine if worker: %d file IO handle is open.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			if( libbfio_handle_open(
+			     worker->file_io_handle,
+			     LIBBFIO_OPEN_READ,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open worker: %d file IO handle.",
+				 function,
+				 worker_index );
+
+				goto on_error;
+			}
+			worker->file_io_handle_opened = 1;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	for( worker_index = 1;
+	     worker_index < number_of_workers;
+	     worker_index++ )
+	{
+		if( libcthreads_thread_create(
+		     &( workers[ worker_index ].thread ),
+		     NULL,
+		     (int (*)(void *)) &libpff_allocation_statistics_worker_thread_function,
+		     (void *) &( workers[ worker_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create worker: %d thread.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+	}
+#endif
+	workers[ 0 ].result = libpff_allocation_statistics_worker_run(
+	                       &( workers[ 0 ] ),
+	                       &( workers[ 0 ].error ) );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	for( worker_index = 1;
+	     worker_index < number_of_workers;
+	     worker_index++ )
+	{
+		if( libcthreads_thread_join(
+		     &( workers[ worker_index ].thread ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join worker: %d thread.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+	}
+#else
+	/* Without multi-threading support the other workers run after the first
+	 */
+	for( worker_index = 1;
+	     worker_index < number_of_workers;
+	     worker_index++ )
+	{
+		workers[ worker_index ].result = libpff_allocation_statistics_worker_run(
+		                                  &( workers[ worker_index ] ),
+		                                  &( workers[ worker_index ].error ) );
+	}
+#endif
+	result = 1;
+
+	for( worker_index = 0;
+	     worker_index < number_of_workers;
+	     worker_index++ )
+	{
+		worker = &( workers[ worker_index ] );
+
+		if( worker->result == -1 )
+		{
+			/* Hand the error of the first failed worker to the caller
+			 */
+			if( ( error != NULL )
+			 && ( *error == NULL ) )
+			{
+				*error = worker->error;
+
+				worker->error = NULL;
+			}
+			result = -1;
+		}
+		else if( result == 1 )
+		{
+			if( libpff_allocation_statistics_merge(
+			     internal_allocation_statistics,
+			     worker->allocation_statistics,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to merge worker: %d allocation statistics.",
+				 function,
+				 worker_index );
+
+				result = -1;
+			}
+		}
+	}
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read allocation tables.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_allocation_statistics_finalize(
+	     internal_allocation_statistics,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize allocation statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_allocation_statistics_free_workers(
+	     &workers,
+	     number_of_workers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free workers.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( read_limits_mutex != NULL )
+	{
+		if( libcthreads_mutex_free(
+		     &read_limits_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read limits mutex.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( workers != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		for( worker_index = 1;
+		     worker_index < number_of_workers;
+		     worker_index++ )
+		{
+			if( workers[ worker_index ].thread != NULL )
+			{
+				libcthreads_thread_join(
+				 &( workers[ worker_index ].thread ),
+				 NULL );
+			}
+		}
+#endif
+		libpff_allocation_statistics_free_workers(
+		 &workers,
+		 number_of_workers,
+		 NULL );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( read_limits_mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &read_limits_mutex,
+		 NULL );
+	}
+#endif
+	return( -1 );
+}
+
+/* Retrieves the allocation unit size
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_allocation_statistics_get_allocation_unit_size(
+     libpff_allocation_statistics_t *allocation_statistics,
+     size32_t *allocation_unit_size,
+     libcerror_error_t **error )
+{
+	libpff_internal_allocation_statistics_t *internal_allocation_statistics = NULL;
+	static char *function                                                   = "libpff_allocation_statistics_get_allocation_unit_size";
+
+	if( allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	internal_allocation_statistics = (libpff_internal_allocation_statistics_t *) allocation_statistics;
+
+	if( allocation_unit_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation unit size.",
+		 function );
+
+		return( -1 );
+	}
+	*allocation_unit_size = internal_allocation_statistics->allocation_unit_size;
+
+	return( 1 );
+}
+
+/* Retrieves the allocated size
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_allocation_statistics_get_allocated_size(
+     libpff_allocation_statistics_t *allocation_statistics,
+     size64_t *allocated_size,
+     libcerror_error_t **error )
+{
+	libpff_internal_allocation_statistics_t *internal_allocation_statistics = NULL;
+	static char *function                                                   = "libpff_allocation_statistics_get_allocated_size";
+
+	if( allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	internal_allocation_statistics = (libpff_internal_allocation_statistics_t *) allocation_statistics;
+
+	if( allocated_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocated size.",
+		 function );
+
+		return( -1 );
+	}
+	*allocated_size = internal_allocation_statistics->allocated_size;
+
+	return( 1 );
+}
+
+/* Retrieves the unallocated size
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_allocation_statistics_get_unallocated_size(
+     libpff_allocation_statistics_t *allocation_statistics,
+     size64_t *unallocated_size,
+     libcerror_error_t **error )
+{
+	libpff_internal_allocation_statistics_t *internal_allocation_statistics = NULL;
+	static char *function                                                   = "libpff_allocation_statistics_get_unallocated_size";
+
+	if( allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	internal_allocation_statistics = (libpff_internal_allocation_statistics_t *) allocation_statistics;
+
+	if( unallocated_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid unallocated size.",
+		 function );
+
+		return( -1 );
+	}
+	*unallocated_size = internal_allocation_statistics->unallocated_size;
+
+	return( 1 );
+}
+
+/* Retrieves the number of allocated extents
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_allocation_statistics_get_number_of_allocated_extents(
+     libpff_allocation_statistics_t *allocation_statistics,
+     uint64_t *number_of_allocated_extents,
+     libcerror_error_t **error )
+{
+	libpff_internal_allocation_statistics_t *internal_allocation_statistics = NULL;
+	static char *function                                                   = "libpff_allocation_statistics_get_number_of_allocated_extents";
+
+	if( allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	internal_allocation_statistics = (libpff_internal_allocation_statistics_t *) allocation_statistics;
+
+	if( number_of_allocated_extents == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of allocated extents.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_allocated_extents = internal_allocation_statistics->number_of_allocated_extents;
+
+	return( 1 );
+}
+
+/* Retrieves the number of unallocated extents
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_allocation_statistics_get_number_of_unallocated_extents(
+     libpff_allocation_statistics_t *allocation_statistics,
+     uint64_t *number_of_unallocated_extents,
+     libcerror_error_t **error )
+{
+	libpff_internal_allocation_statistics_t *internal_allocation_statistics = NULL;
+	static char *function                                                   = "libpff_allocation_statistics_get_number_of_unallocated_extents";
+
+	if( allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	internal_allocation_statistics = (libpff_internal_allocation_statistics_t *) allocation_statistics;
+
+	if( number_of_unallocated_extents == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of unallocated extents.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_unallocated_extents = internal_allocation_statistics->number_of_unallocated_extents;
+
+	return( 1 );
+}
+
+/* Retrieves the largest unallocated extent size
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_allocation_statistics_get_largest_unallocated_extent_size(
+     libpff_allocation_statistics_t *allocation_statistics,
+     size64_t *largest_unallocated_extent_size,
+     libcerror_error_t **error )
+{
+	libpff_internal_allocation_statistics_t *internal_allocation_statistics = NULL;
+	static char *function                                                   = "libpff_allocation_statistics_get_largest_unallocated_extent_size";
+
+	if( allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	internal_allocation_statistics = (libpff_internal_allocation_statistics_t *) allocation_statistics;
+
+	if( largest_unallocated_extent_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid largest unallocated extent size.",
+		 function );
+
+		return( -1 );
+	}
+	*largest_unallocated_extent_size = internal_allocation_statistics->largest_unallocated_extent_size;
+
+	return( 1 );
+}
+
+/* Retrieves the number of histogram buckets
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_allocation_statistics_get_number_of_histogram_buckets(
+     libpff_allocation_statistics_t *allocation_statistics,
+     int *number_of_histogram_buckets,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_allocation_statistics_get_number_of_histogram_buckets";
+
+	if( allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_histogram_buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of histogram buckets.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_histogram_buckets = LIBPFF_ALLOCATION_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS;
+
+	return( 1 );
+}
+
+/* Retrieves the number of allocated extents in a specific histogram bucket
+ * Bucket N contains the extents of 2^N up to 2^(N+1) allocation units
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_allocation_statistics_get_allocated_extents_histogram_value(
+     libpff_allocation_statistics_t *allocation_statistics,
+     int histogram_bucket_index,
+     uint64_t *number_of_extents,
+     libcerror_error_t **error )
+{
+	libpff_internal_allocation_statistics_t *internal_allocation_statistics = NULL;
+	static char *function                                                   = "libpff_allocation_statistics_get_allocated_extents_histogram_value";
+
+	if( allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	internal_allocation_statistics = (libpff_internal_allocation_statistics_t *) allocation_statistics;
+
+	if( ( histogram_bucket_index < 0 )
+	 || ( histogram_bucket_index >= LIBPFF_ALLOCATION_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid histogram bucket index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_extents == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of extents.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_extents = internal_allocation_statistics->allocated_extents_histogram[ histogram_bucket_index ];
+
+	return( 1 );
+}
+
+/* Retrieves the number of unallocated extents in a specific histogram bucket
+ * Bucket N contains the extents of 2^N up to 2^(N+1) allocation units
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_allocation_statistics_get_unallocated_extents_histogram_value(
+     libpff_allocation_statistics_t *allocation_statistics,
+     int histogram_bucket_index,
+     uint64_t *number_of_extents,
+     libcerror_error_t **error )
+{
+	libpff_internal_allocation_statistics_t *internal_allocation_statistics = NULL;
+	static char *function                                                   = "libpff_allocation_statistics_get_unallocated_extents_histogram_value";
+
+	if( allocation_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation statistics.",
+		 function );
+
+		return( -1 );
+	}
+	internal_allocation_statistics = (libpff_internal_allocation_statistics_t *) allocation_statistics;
+
+	if( ( histogram_bucket_index < 0 )
+	 || ( histogram_bucket_index >= LIBPFF_ALLOCATION_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid histogram bucket index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_extents == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of extents.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_extents = internal_allocation_statistics->unallocated_extents_histogram[ histogram_bucket_index ];
+
+	return( 1 );
+}
+
@@ -0,0 +1,299 @@
+/*
+ * Allocation statistics functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#if !defined( _LIBPFF_ALLOCATION_STATISTICS_H )
+#define _LIBPFF_ALLOCATION_STATISTICS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libpff_extern.h"
+#include "libpff_io_handle.h"
+#include "libpff_libbfio.h"
+#include "libpff_libcerror.h"
+#include "libpff_libcthreads.h"
+#include "libpff_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The number of extent histogram buckets
+ * Bucket N contains the extents of 2^N up to 2^(N+1) allocation units,
+ * the last bucket also contains the larger extents
+ */
+#define LIBPFF_ALLOCATION_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS	32
+
+typedef struct libpff_internal_allocation_statistics libpff_internal_allocation_statistics_t;
+
+/* The allocation statistics are gathered from consecutive runs of allocated
+ * or unallocated allocation units. The first and last run are kept apart
+ * since they can continue in an adjacent segment, see
+ * libpff_allocation_statistics_merge
+ */
+struct libpff_internal_allocation_statistics
+{
+	/* The allocation unit size
+	 */
+	size32_t allocation_unit_size;
+
+	/* The allocated size
+	 */
+	size64_t allocated_size;
+
+	/* The unallocated size
+	 */
+	size64_t unallocated_size;
+
+	/* The number of allocated extents
+	 */
+	uint64_t number_of_allocated_extents;
+
+	/* The number of unallocated extents
+	 */
+	uint64_t number_of_unallocated_extents;
+
+	/* The largest unallocated extent size
+	 */
+	size64_t largest_unallocated_extent_size;
+
+	/* The allocated extents histogram
+	 */
+	uint64_t allocated_extents_histogram[ LIBPFF_ALLOCATION_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS ];
+
+	/* The unallocated extents histogram
+	 */
+	uint64_t unallocated_extents_histogram[ LIBPFF_ALLOCATION_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS ];
+
+	/* The number of runs, 0, 1 or 2 if there are 2 or more runs
+	 */
+	uint8_t number_of_runs;
+
+	/* The number of allocation units of the first run
+	 */
+	uint64_t first_run_number_of_units;
+
+	/* Value to indicate the first run is allocated
+	 */
+	uint8_t first_run_is_allocated;
+
+	/* The number of allocation units of the last run
+	 */
+	uint64_t last_run_number_of_units;
+
+	/* Value to indicate the last run is allocated
+	 */
+	uint8_t last_run_is_allocated;
+};
+
+typedef struct libpff_allocation_statistics_worker libpff_allocation_statistics_worker_t;
+
+/* A worker reads a contiguous range of allocation tables
+ */
+struct libpff_allocation_statistics_worker
+{
+	/* The IO handle
+	 */
+	libpff_io_handle_t *io_handle;
+
+	/* The file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* Value to indicate the file IO handle was cloned by the worker
+	 */
+	uint8_t file_io_handle_cloned;
+
+	/* Value to indicate the file IO handle was opened by the worker
+	 */
+	uint8_t file_io_handle_opened;
+
+	/* The (segment) allocation statistics
+	 */
+	libpff_internal_allocation_statistics_t *allocation_statistics;
+
+	/* The offset of the first allocation table
+	 */
+	off64_t allocation_table_offset;
+
+	/* The range of the file covered by an allocation table
+	 */
+	size64_t allocation_table_range;
+
+	/* The number of allocation tables
+	 */
+	uint64_t number_of_allocation_tables;
+
+	/* The result of the worker
+	 */
+	int result;
+
+	/* The error of the worker
+	 */
+	libcerror_error_t *error;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The thread
+	 */
+	libcthreads_thread_t *thread;
+
+	/* The mutex that serializes the read limits accounting of the IO handle
+	 * shared by the workers, this is a reference
+	 */
+	libcthreads_mutex_t *read_limits_mutex;
+#endif
+};
+
+int libpff_allocation_statistics_initialize(
+     libpff_allocation_statistics_t **allocation_statistics,
+     size32_t allocation_unit_size,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_allocation_statistics_free(
+     libpff_allocation_statistics_t **allocation_statistics,
+     libcerror_error_t **error );
+
+int libpff_allocation_statistics_add_extent(
+     libpff_internal_allocation_statistics_t *internal_allocation_statistics,
+     uint8_t is_allocated,
+     uint64_t number_of_units,
+     libcerror_error_t **error );
+
+int libpff_allocation_statistics_append_run(
+     libpff_internal_allocation_statistics_t *internal_allocation_statistics,
+     uint8_t is_allocated,
+     uint64_t number_of_units,
+     libcerror_error_t **error );
+
+int libpff_allocation_statistics_merge(
+     libpff_internal_allocation_statistics_t *destination_allocation_statistics,
+     libpff_internal_allocation_statistics_t *source_allocation_statistics,
+     libcerror_error_t **error );
+
+int libpff_allocation_statistics_finalize(
+     libpff_internal_allocation_statistics_t *internal_allocation_statistics,
+     libcerror_error_t **error );
+
+int libpff_allocation_statistics_get_number_of_leading_zero_bits(
+     uint64_t value_64bit );
+
+int libpff_allocation_statistics_read_bitmap(
+     libpff_internal_allocation_statistics_t *internal_allocation_statistics,
+     const uint8_t *bitmap_data,
+     size_t bitmap_data_size,
+     uint64_t number_of_units,
+     libcerror_error_t **error );
+
+int libpff_allocation_statistics_read_allocation_table_data(
+     libpff_internal_allocation_statistics_t *internal_allocation_statistics,
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t file_type,
+     uint64_t number_of_units,
+     libcerror_error_t **error );
+
+int libpff_allocation_statistics_worker_run(
+     libpff_allocation_statistics_worker_t *worker,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int libpff_allocation_statistics_worker_thread_function(
+     libpff_allocation_statistics_worker_t *worker );
+
+#endif
+
+int libpff_allocation_statistics_free_workers(
+     libpff_allocation_statistics_worker_t **workers,
+     int number_of_workers,
+     libcerror_error_t **error );
+
+int libpff_allocation_statistics_read_file_io_handle(
+     libpff_allocation_statistics_t *allocation_statistics,
+     libpff_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_allocation_statistics_get_allocation_unit_size(
+     libpff_allocation_statistics_t *allocation_statistics,
+     size32_t *allocation_unit_size,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_allocation_statistics_get_allocated_size(
+     libpff_allocation_statistics_t *allocation_statistics,
+     size64_t *allocated_size,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_allocation_statistics_get_unallocated_size(
+     libpff_allocation_statistics_t *allocation_statistics,
+     size64_t *unallocated_size,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_allocation_statistics_get_number_of_allocated_extents(
+     libpff_allocation_statistics_t *allocation_statistics,
+     uint64_t *number_of_allocated_extents,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_allocation_statistics_get_number_of_unallocated_extents(
+     libpff_allocation_statistics_t *allocation_statistics,
+     uint64_t *number_of_unallocated_extents,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_allocation_statistics_get_largest_unallocated_extent_size(
+     libpff_allocation_statistics_t *allocation_statistics,
+     size64_t *largest_unallocated_extent_size,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_allocation_statistics_get_number_of_histogram_buckets(
+     libpff_allocation_statistics_t *allocation_statistics,
+     int *number_of_histogram_buckets,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_allocation_statistics_get_allocated_extents_histogram_value(
+     libpff_allocation_statistics_t *allocation_statistics,
+     int histogram_bucket_index,
+     uint64_t *number_of_extents,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_allocation_statistics_get_unallocated_extents_histogram_value(
+     libpff_allocation_statistics_t *allocation_statistics,
+     int histogram_bucket_index,
+     uint64_t *number_of_extents,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPFF_ALLOCATION_STATISTICS_H ) */
+
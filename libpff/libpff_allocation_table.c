@@ -26,6 +26,7 @@
 
 #include "libpff_allocation_table.h"
 #include "libpff_definitions.h"
+#include "libpff_io_handle.h"
 #include "libpff_libbfio.h"
 #include "libpff_libcdata.h"
 #include "libpff_libcerror.h"
@@ -34,49 +35,35 @@
 
 #include "pff_allocation_table.h"
 
-/* Reads allocation table data
+/* Reads the header of allocation table data
+ * The checksum and the allocation table type are validated
  * Returns 1 if successful or -1 on error
  */
-int libpff_allocation_table_read_data(
-     libcdata_range_list_t *unallocated_block_list,
+int libpff_allocation_table_read_header_data(
      const uint8_t *data,
      size_t data_size,
      uint8_t file_type,
+     uint8_t *allocation_table_type,
+     off64_t *back_pointer_offset,
+     const uint8_t **table_data,
+     size_t *table_data_size,
      libcerror_error_t **error )
 {
-	uint8_t *table_data                = NULL;
-	static char *function              = "libpff_allocation_table_read_data";
-	size_t allocation_block_size       = 0;
+	const uint8_t *safe_table_data     = NULL;
+	static char *function              = "libpff_allocation_table_read_header_data";
 	size_t allocation_table_data_size  = 0;
-	size_t unallocated_size            = 0;
-	off64_t back_pointer_offset        = 0;
-	off64_t unallocated_offset         = 0;
+	size_t safe_table_data_size        = 0;
+	off64_t safe_back_pointer_offset   = 0;
 	uint32_t calculated_checksum       = 0;
 	uint32_t stored_checksum           = 0;
-	uint16_t table_data_index          = 0;
-	uint16_t table_data_size           = 0;
-	uint8_t allocation_table_entry     = 0;
-	uint8_t allocation_table_type      = 0;
 	uint8_t allocation_table_type_copy = 0;
-	uint8_t bit_index                  = 0;
-	int result                         = 0;
+	uint8_t safe_allocation_table_type = 0;
 
 #if defined( HAVE_DEBUG_OUTPUT )
 	uint64_t value_64bit               = 0;
 	uint16_t value_16bit               = 0;
 #endif
 
-	if( unallocated_block_list == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid unallocated block list.",
-		 function );
-
-		return( -1 );
-	}
 	if( data == NULL )
 	{
 		libcerror_error_set(
@@ -112,20 +99,64 @@ int libpff_allocation_table_read_data(
 
 		return( -1 );
 	}
+	if( allocation_table_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation table type.",
+		 function );
+
+		return( -1 );
+	}
+	if( back_pointer_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid back pointer offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( table_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table data.",
+		 function );
+
+		return( -1 );
+	}
+	if( table_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table data size.",
+		 function );
+
+		return( -1 );
+	}
 	if( file_type == LIBPFF_FILE_TYPE_32BIT )
 	{
 		allocation_table_data_size = sizeof( pff_allocation_table_32bit_t );
-		table_data_size            = 496;
+		safe_table_data_size       = 496;
 	}
 	else if( file_type == LIBPFF_FILE_TYPE_64BIT )
 	{
 		allocation_table_data_size = sizeof( pff_allocation_table_64bit_t );
-		table_data_size            = 496;
+		safe_table_data_size       = 496;
 	}
 	else if( file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE )
 	{
 		allocation_table_data_size = sizeof( pff_allocation_table_64bit_4k_page_t );
-		table_data_size            = 4072;
+		safe_table_data_size       = 4072;
 	}
 	if( data_size < allocation_table_data_size )
 	{
@@ -152,21 +183,21 @@ int libpff_allocation_table_read_data(
 #endif
 	if( file_type == LIBPFF_FILE_TYPE_32BIT )
 	{
-		table_data                 = ( (pff_allocation_table_32bit_t *) data )->data;
-		allocation_table_type      = ( (pff_allocation_table_32bit_t *) data )->type;
+		safe_table_data            = ( (pff_allocation_table_32bit_t *) data )->data;
+		safe_allocation_table_type = ( (pff_allocation_table_32bit_t *) data )->type;
 		allocation_table_type_copy = ( (pff_allocation_table_32bit_t *) data )->type_copy;
 
 		byte_stream_copy_to_uint32_little_endian(
 		 ( (pff_allocation_table_32bit_t *) data )->back_pointer,
-		 back_pointer_offset );
+		 safe_back_pointer_offset );
 		byte_stream_copy_to_uint32_little_endian(
 		 ( (pff_allocation_table_32bit_t *) data )->checksum,
 		 stored_checksum );
 	}
 	else if( file_type == LIBPFF_FILE_TYPE_64BIT )
 	{
-		table_data                 = ( (pff_allocation_table_64bit_t *) data )->data;
-		allocation_table_type      = ( (pff_allocation_table_64bit_t *) data )->type;
+		safe_table_data            = ( (pff_allocation_table_64bit_t *) data )->data;
+		safe_allocation_table_type = ( (pff_allocation_table_64bit_t *) data )->type;
 		allocation_table_type_copy = ( (pff_allocation_table_64bit_t *) data )->type_copy;
 
 		byte_stream_copy_to_uint32_little_endian(
@@ -174,12 +205,12 @@ int libpff_allocation_table_read_data(
 		 stored_checksum );
 		byte_stream_copy_to_uint64_little_endian(
 		 ( (pff_allocation_table_64bit_t *) data )->back_pointer,
-		 back_pointer_offset );
+		 safe_back_pointer_offset );
 	}
 	else if( file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE )
 	{
-		table_data                 = ( (pff_allocation_table_64bit_4k_page_t *) data )->data;
-		allocation_table_type      = ( (pff_allocation_table_64bit_4k_page_t *) data )->type;
+		safe_table_data            = ( (pff_allocation_table_64bit_4k_page_t *) data )->data;
+		safe_allocation_table_type = ( (pff_allocation_table_64bit_4k_page_t *) data )->type;
 		allocation_table_type_copy = ( (pff_allocation_table_64bit_4k_page_t *) data )->type_copy;
 
 		byte_stream_copy_to_uint32_little_endian(
@@ -187,7 +218,7 @@ int libpff_allocation_table_read_data(
 		 stored_checksum );
 		byte_stream_copy_to_uint64_little_endian(
 		 ( (pff_allocation_table_64bit_4k_page_t *) data )->back_pointer,
-		 back_pointer_offset );
+		 safe_back_pointer_offset );
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
@@ -195,7 +226,7 @@ int libpff_allocation_table_read_data(
 		libcnotify_printf(
 		 "%s: type\t\t\t\t\t: 0x%02" PRIx8 "\n",
 		 function,
-		 allocation_table_type );
+		 safe_allocation_table_type );
 		libcnotify_printf(
 		 "%s: type copy\t\t\t\t: 0x%02" PRIx8 "\n",
 		 function,
@@ -214,7 +245,7 @@ int libpff_allocation_table_read_data(
 			libcnotify_printf(
 			 "%s: back pointer\t\t\t\t: %" PRIu64 "\n",
 			 function,
-			 back_pointer_offset );
+			 safe_back_pointer_offset );
 
 			libcnotify_printf(
 			 "%s: checksum\t\t\t\t: 0x%" PRIx32 "\n",
@@ -249,7 +280,7 @@ int libpff_allocation_table_read_data(
 			libcnotify_printf(
 			 "%s: back pointer\t\t\t\t: %" PRIu64 "\n",
 			 function,
-			 back_pointer_offset );
+			 safe_back_pointer_offset );
 
 			if( file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE )
 			{
@@ -269,8 +300,8 @@ int libpff_allocation_table_read_data(
 
 	if( libfmapi_checksum_calculate_weak_crc32(
 	     &calculated_checksum,
-	     table_data,
-	     (size_t) table_data_size,
+	     safe_table_data,
+	     safe_table_data_size,
 	     0,
 	     error ) != 1 )
 	{
@@ -281,7 +312,7 @@ int libpff_allocation_table_read_data(
 		 "%s: unable to calculate weak CRC-32.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 	if( stored_checksum != calculated_checksum )
 	{
@@ -295,9 +326,9 @@ int libpff_allocation_table_read_data(
 		 calculated_checksum );
 
 /* TODO implement error tollerance */
-		goto on_error;
+		return( -1 );
 	}
-	if( allocation_table_type != allocation_table_type_copy )
+	if( safe_allocation_table_type != allocation_table_type_copy )
 	{
 		libcerror_error_set(
 		 error,
@@ -305,24 +336,85 @@ int libpff_allocation_table_read_data(
 		 LIBCERROR_INPUT_ERROR_CHECKSUM_MISMATCH,
 		 "%s: mismatch in allocation table type ( 0x%02" PRIx8 " != 0x%02" PRIx8 " ).",
 		 function,
-		 allocation_table_type,
+		 safe_allocation_table_type,
 		 allocation_table_type_copy );
 
 /* TODO implement error tollerance */
-		goto on_error;
+		return( -1 );
 	}
-	if( ( allocation_table_type != LIBPFF_ALLOCATION_TABLE_TYPE_DATA )
-	 && ( allocation_table_type != LIBPFF_ALLOCATION_TABLE_TYPE_PAGE ) )
+	if( ( safe_allocation_table_type != LIBPFF_ALLOCATION_TABLE_TYPE_DATA )
+	 && ( safe_allocation_table_type != LIBPFF_ALLOCATION_TABLE_TYPE_PAGE ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported allocation table type: 0x%08" PRIx32 "",
+		 "%s: unsupported allocation table type: 0x%02" PRIx8 ".",
 		 function,
-		 allocation_table_type );
+		 safe_allocation_table_type );
 
 /* TODO implement error tollerance */
+		return( -1 );
+	}
+	*allocation_table_type = safe_allocation_table_type;
+	*back_pointer_offset   = safe_back_pointer_offset;
+	*table_data            = safe_table_data;
+	*table_data_size       = safe_table_data_size;
+
+	return( 1 );
+}
+
+/* Reads allocation table data
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_allocation_table_read_data(
+     libcdata_range_list_t *unallocated_block_list,
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t file_type,
+     libcerror_error_t **error )
+{
+	const uint8_t *table_data      = NULL;
+	static char *function          = "libpff_allocation_table_read_data";
+	size_t allocation_block_size   = 0;
+	size_t table_data_index        = 0;
+	size_t table_data_size         = 0;
+	size_t unallocated_size        = 0;
+	off64_t back_pointer_offset    = 0;
+	off64_t unallocated_offset     = 0;
+	uint8_t allocation_table_entry = 0;
+	uint8_t allocation_table_type  = 0;
+	uint8_t bit_index              = 0;
+	int result                     = 0;
+
+	if( unallocated_block_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid unallocated block list.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_allocation_table_read_header_data(
+	     data,
+	     data_size,
+	     file_type,
+	     &allocation_table_type,
+	     &back_pointer_offset,
+	     &table_data,
+	     &table_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read allocation table header.",
+		 function );
+
 		goto on_error;
 	}
 	if( allocation_table_type == LIBPFF_ALLOCATION_TABLE_TYPE_PAGE )
@@ -451,9 +543,9 @@ on_error:
  */
 int libpff_allocation_table_read_file_io_handle(
      libcdata_range_list_t *unallocated_block_list,
+     libpff_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      off64_t allocation_table_offset,
-     uint8_t file_type,
      libcerror_error_t **error )
 {
 	uint8_t *allocation_table_data    = NULL;
@@ -472,6 +564,17 @@ int libpff_allocation_table_read_file_io_handle(
 
 		return( -1 );
 	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
 	if( file_io_handle == NULL )
 	{
 		libcerror_error_set(
@@ -483,9 +586,9 @@ int libpff_allocation_table_read_file_io_handle(
 
 		return( -1 );
 	}
-	if( ( file_type != LIBPFF_FILE_TYPE_32BIT )
-	 && ( file_type != LIBPFF_FILE_TYPE_64BIT )
-	 && ( file_type != LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
+	if( ( io_handle->file_type != LIBPFF_FILE_TYPE_32BIT )
+	 && ( io_handle->file_type != LIBPFF_FILE_TYPE_64BIT )
+	 && ( io_handle->file_type != LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -496,18 +599,34 @@ int libpff_allocation_table_read_file_io_handle(
 
 		return( -1 );
 	}
-	if( file_type == LIBPFF_FILE_TYPE_32BIT )
+	if( io_handle->file_type == LIBPFF_FILE_TYPE_32BIT )
 	{
 		allocation_table_data_size = sizeof( pff_allocation_table_32bit_t );
 	}
-	else if( file_type == LIBPFF_FILE_TYPE_64BIT )
+	else if( io_handle->file_type == LIBPFF_FILE_TYPE_64BIT )
 	{
 		allocation_table_data_size = sizeof( pff_allocation_table_64bit_t );
 	}
-	else if( file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE )
+	else if( io_handle->file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE )
 	{
 		allocation_table_data_size = sizeof( pff_allocation_table_64bit_4k_page_t );
 	}
+	if( libpff_io_handle_check_read_limits(
+	     io_handle,
+	     allocation_table_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_ABORT_REQUESTED,
+		 "%s: unable to read allocation table data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 allocation_table_offset,
+		 allocation_table_offset );
+
+		return( -1 );
+	}
 	allocation_table_data = (uint8_t *) memory_allocate(
 	                                     sizeof( uint8_t ) * allocation_table_data_size );
 
@@ -556,7 +675,7 @@ int libpff_allocation_table_read_file_io_handle(
 	     unallocated_block_list,
 	     allocation_table_data,
 	     allocation_table_data_size,
-	     file_type,
+	     io_handle->file_type,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
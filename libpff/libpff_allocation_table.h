@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libpff_io_handle.h"
 #include "libpff_libbfio.h"
 #include "libpff_libcdata.h"
 #include "libpff_libcerror.h"
@@ -33,6 +34,16 @@
 extern "C" {
 #endif
 
+int libpff_allocation_table_read_header_data(
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t file_type,
+     uint8_t *allocation_table_type,
+     off64_t *back_pointer_offset,
+     const uint8_t **table_data,
+     size_t *table_data_size,
+     libcerror_error_t **error );
+
 int libpff_allocation_table_read_data(
      libcdata_range_list_t *unallocated_block_list,
      const uint8_t *data,
@@ -42,9 +53,9 @@ int libpff_allocation_table_read_data(
 
 int libpff_allocation_table_read_file_io_handle(
      libcdata_range_list_t *unallocated_block_list,
+     libpff_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      off64_t allocation_table_offset,
-     uint8_t file_type,
      libcerror_error_t **error );
 
 #if defined( __cplusplus )
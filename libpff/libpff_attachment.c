@@ -28,6 +28,7 @@
 #include "libpff_attachment.h"
 #include "libpff_debug.h"
 #include "libpff_definitions.h"
+#include "libpff_io_handle.h"
 #include "libpff_item.h"
 #include "libpff_item_descriptor.h"
 #include "libpff_item_tree.h"
@@ -397,11 +398,11 @@ ssize_t libpff_attachment_data_read_buffer(
          size_t buffer_size,
          libcerror_error_t **error )
 {
+	libfdata_stream_t *data_stream        = NULL;
 	libpff_internal_item_t *internal_item = NULL;
 	libpff_record_entry_t *record_entry   = NULL;
 	static char *function                 = "libpff_attachment_data_read_buffer";
 	ssize_t read_count                    = 0;
-	uint32_t value_type                   = 0;
 	int result                            = 0;
 
 	if( attachment == NULL )
@@ -417,67 +418,43 @@ ssize_t libpff_attachment_data_read_buffer(
 	}
 	internal_item = (libpff_internal_item_t *) attachment;
 
-	result = libpff_item_values_get_record_entry_by_type(
-	          internal_item->item_values,
-	          internal_item->name_to_id_map_list,
-	          internal_item->io_handle,
-	          internal_item->file_io_handle,
-	          internal_item->offsets_index,
-	          0,
-	          LIBPFF_ENTRY_TYPE_ATTACHMENT_DATA_OBJECT,
-	          0,
-	          &record_entry,
-	          LIBPFF_ENTRY_VALUE_FLAG_MATCH_ANY_VALUE_TYPE,
-	          error );
-
-	if( result != 1 )
+	if( internal_item->io_handle != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve record entry.",
-		 function );
+		if( libpff_io_handle_clear_pending_read(
+		     internal_item->io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to clear pending read.",
+			 function );
 
-		return( -1 );
+			return( -1 );
+		}
 	}
-	if( libpff_record_entry_get_value_type(
-	     record_entry,
-	     &value_type,
-	     error ) != 1 )
+	result = libpff_internal_item_get_attachment_data_stream(
+	          internal_item,
+	          &data_stream,
+	          &record_entry,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve value type.",
+		 "%s: unable to retrieve attachment data stream.",
 		 function );
 
 		return( -1 );
 	}
-	/* The OLE attachment method could refer to an OLE embedded object
-	 */
-	if( value_type == LIBPFF_VALUE_TYPE_OBJECT )
+	else if( result != 0 )
 	{
-		if( internal_item->embedded_object_data_stream == NULL )
-		{
-			if( libpff_internal_item_get_embedded_object_data(
-			     internal_item,
-			     record_entry,
-			     error ) == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve embedded object data.",
-				 function );
-
-				return( -1 );
-			}
-		}
 		read_count = libfdata_stream_read_buffer(
-			      internal_item->embedded_object_data_stream,
+			      data_stream,
 			      (intptr_t *) internal_item->file_io_handle,
 			      buffer,
 			      buffer_size,
@@ -490,7 +467,7 @@ ssize_t libpff_attachment_data_read_buffer(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read buffer from embedded object data stream.",
+			 "%s: unable to read buffer from attachment data stream.",
 			 function );
 
 			return( -1 );
@@ -528,10 +505,10 @@ off64_t libpff_attachment_data_seek_offset(
          int whence,
          libcerror_error_t **error )
 {
+	libfdata_stream_t *data_stream        = NULL;
 	libpff_internal_item_t *internal_item = NULL;
 	libpff_record_entry_t *record_entry   = NULL;
 	static char *function                 = "libpff_attachment_data_seek_offset";
-	uint32_t value_type                   = 0;
 	int result                            = 0;
 
 	if( attachment == NULL )
@@ -547,78 +524,27 @@ off64_t libpff_attachment_data_seek_offset(
 	}
 	internal_item = (libpff_internal_item_t *) attachment;
 
-	if( internal_item->item_values == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid attachment - missing item values.",
-		 function );
-
-		return( -1 );
-	}
-	result = libpff_item_values_get_record_entry_by_type(
-	          internal_item->item_values,
-	          internal_item->name_to_id_map_list,
-	          internal_item->io_handle,
-	          internal_item->file_io_handle,
-	          internal_item->offsets_index,
-	          0,
-	          LIBPFF_ENTRY_TYPE_ATTACHMENT_DATA_OBJECT,
-	          0,
+	result = libpff_internal_item_get_attachment_data_stream(
+	          internal_item,
+	          &data_stream,
 	          &record_entry,
-	          LIBPFF_ENTRY_VALUE_FLAG_MATCH_ANY_VALUE_TYPE,
 	          error );
 
-	if( result != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve record entry.",
-		 function );
-
-		return( -1 );
-	}
-	if( libpff_record_entry_get_value_type(
-	     record_entry,
-	     &value_type,
-	     error ) != 1 )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve value type.",
+		 "%s: unable to retrieve attachment data stream.",
 		 function );
 
 		return( -1 );
 	}
-	/* The OLE attachment method could refer to an OLE embedded object
-	 */
-	if( value_type == LIBPFF_VALUE_TYPE_OBJECT )
+	else if( result != 0 )
 	{
-		if( internal_item->embedded_object_data_stream == NULL )
-		{
-			if( libpff_internal_item_get_embedded_object_data(
-			     internal_item,
-			     record_entry,
-			     error ) == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve embedded object data.",
-				 function );
-
-				return( -1 );
-			}
-		}
 		offset = libfdata_stream_seek_offset(
-			  internal_item->embedded_object_data_stream,
+			  data_stream,
 			  offset,
 			  whence,
 			  error );
@@ -629,7 +555,7 @@ off64_t libpff_attachment_data_seek_offset(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek offset in embedded object data stream.",
+			 "%s: unable to seek offset in attachment data stream.",
 			 function );
 
 			return( -1 );
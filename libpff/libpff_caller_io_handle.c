@@ -0,0 +1,2359 @@
+/*
+ * Caller driven IO handle functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libpff_caller_io_handle.h"
+#include "libpff_definitions.h"
+#include "libpff_libbfio.h"
+#include "libpff_libcdata.h"
+#include "libpff_libcerror.h"
+
+/* Creates a caller IO segment from a copy of the data
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_caller_io_segment_initialize(
+     libpff_caller_io_segment_t **segment,
+     off64_t offset,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_caller_io_segment_initialize";
+
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*segment = memory_allocate_structure(
+	            libpff_caller_io_segment_t );
+
+	if( *segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *segment,
+	     0,
+	     sizeof( libpff_caller_io_segment_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segment.",
+		 function );
+
+		memory_free(
+		 *segment );
+
+		*segment = NULL;
+
+		return( -1 );
+	}
+	( *segment )->data = (uint8_t *) memory_allocate(
+	                                  sizeof( uint8_t ) * data_size );
+
+	if( ( *segment )->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     ( *segment )->data,
+	     data,
+	     data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy segment data.",
+		 function );
+
+		goto on_error;
+	}
+	( *segment )->offset    = offset;
+	( *segment )->data_size = data_size;
+
+	return( 1 );
+
+on_error:
+	if( *segment != NULL )
+	{
+		libpff_caller_io_segment_free(
+		 segment,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a caller IO segment
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_caller_io_segment_free(
+     libpff_caller_io_segment_t **segment,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_caller_io_segment_free";
+
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment != NULL )
+	{
+		if( ( *segment )->data != NULL )
+		{
+			memory_free(
+			 ( *segment )->data );
+		}
+		memory_free(
+		 *segment );
+
+		*segment = NULL;
+	}
+	return( 1 );
+}
+
+/* Clones a caller IO segment
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_caller_io_segment_clone(
+     libpff_caller_io_segment_t **destination_segment,
+     libpff_caller_io_segment_t *source_segment,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_caller_io_segment_clone";
+
+	if( destination_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_segment == NULL )
+	{
+		*destination_segment = NULL;
+
+		return( 1 );
+	}
+	if( libpff_caller_io_segment_initialize(
+	     destination_segment,
+	     source_segment->offset,
+	     source_segment->data,
+	     source_segment->data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination segment.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Creates a caller IO handle
+ * Make sure the value io_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_caller_io_handle_initialize(
+     libpff_caller_io_handle_t **io_handle,
+     size64_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_caller_io_handle_initialize";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*io_handle = memory_allocate_structure(
+	              libpff_caller_io_handle_t );
+
+	if( *io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *io_handle,
+	     0,
+	     sizeof( libpff_caller_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear IO handle.",
+		 function );
+
+		memory_free(
+		 *io_handle );
+
+		*io_handle = NULL;
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( ( *io_handle )->segments_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segments array.",
+		 function );
+
+		goto on_error;
+	}
+	( *io_handle )->data_size = data_size;
+
+	return( 1 );
+
+on_error:
+	if( *io_handle != NULL )
+	{
+		memory_free(
+		 *io_handle );
+
+		*io_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a caller IO handle
+ * Returns 1 if succesful or -1 on error
+ */
+int libpff_caller_io_handle_free(
+     libpff_caller_io_handle_t **io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_caller_io_handle_free";
+	int result            = 1;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_handle != NULL )
+	{
+		if( libcdata_array_free(
+		     &( ( *io_handle )->segments_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_caller_io_segment_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segments array.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *io_handle );
+
+		*io_handle = NULL;
+	}
+	return( result );
+}
+
+/* Clones (duplicates) the IO handle and its attributes
+ * The supplied data is copied, the pending read is not
+ * Returns 1 if succesful or -1 on error
+ */
+int libpff_caller_io_handle_clone(
+     libpff_caller_io_handle_t **destination_io_handle,
+     libpff_caller_io_handle_t *source_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_caller_io_handle_clone";
+
+	if( destination_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: destination IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_io_handle == NULL )
+	{
+		*destination_io_handle = NULL;
+
+		return( 1 );
+	}
+	*destination_io_handle = memory_allocate_structure(
+	                          libpff_caller_io_handle_t );
+
+	if( *destination_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create destination IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *destination_io_handle,
+	     0,
+	     sizeof( libpff_caller_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear destination IO handle.",
+		 function );
+
+		memory_free(
+		 *destination_io_handle );
+
+		*destination_io_handle = NULL;
+
+		return( -1 );
+	}
+	if( libcdata_array_clone(
+	     &( ( *destination_io_handle )->segments_array ),
+	     source_io_handle->segments_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_caller_io_segment_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libpff_caller_io_segment_clone,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination segments array.",
+		 function );
+
+		goto on_error;
+	}
+	( *destination_io_handle )->data_size          = source_io_handle->data_size;
+	( *destination_io_handle )->supplied_data_size = source_io_handle->supplied_data_size;
+	( *destination_io_handle )->access_flags       = source_io_handle->access_flags;
+
+	return( 1 );
+
+on_error:
+	if( *destination_io_handle != NULL )
+	{
+		memory_free(
+		 *destination_io_handle );
+
+		*destination_io_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Opens the IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_caller_io_handle_open(
+     libpff_caller_io_handle_t *io_handle,
+     int flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_caller_io_handle_open";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: IO handle already open.",
+		 function );
+
+		return( -1 );
+	}
+	/* Currently only support for reading data
+	 */
+	if( ( ( flags & LIBBFIO_ACCESS_FLAG_READ ) == 0 )
+	 || ( ( flags & ~( LIBBFIO_ACCESS_FLAG_READ ) ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported flags.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle->access_flags   = flags;
+	io_handle->current_offset = 0;
+	io_handle->is_open        = 1;
+
+	return( 1 );
+}
+
+/* Closes the IO handle
+ * Returns 0 if successful or -1 on error
+ */
+int libpff_caller_io_handle_close(
+     libpff_caller_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_caller_io_handle_close";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle->is_open = 0;
+
+	return( 0 );
+}
+
+/* Retrieves the index of the first supplied segment that ends after a specific offset
+ * The segments are stored sorted by offset and do not overlap
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_caller_io_handle_get_segment_index_after_offset(
+     libpff_caller_io_handle_t *io_handle,
+     off64_t offset,
+     int *segment_index,
+     libcerror_error_t **error )
+{
+	libpff_caller_io_segment_t *segment = NULL;
+	static char *function               = "libpff_caller_io_handle_get_segment_index_after_offset";
+	int lower_segment_index             = 0;
+	int middle_segment_index            = 0;
+	int upper_segment_index             = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     io_handle->segments_array,
+	     &upper_segment_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		return( -1 );
+	}
+	while( lower_segment_index < upper_segment_index )
+	{
+		middle_segment_index = lower_segment_index + ( ( upper_segment_index - lower_segment_index ) / 2 );
+
+		if( libcdata_array_get_entry_by_index(
+		     io_handle->segments_array,
+		     middle_segment_index,
+		     (intptr_t **) &segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %d.",
+			 function,
+			 middle_segment_index );
+
+			return( -1 );
+		}
+		if( segment == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment: %d.",
+			 function,
+			 middle_segment_index );
+
+			return( -1 );
+		}
+		if( ( segment->offset + (off64_t) segment->data_size ) <= offset )
+		{
+			lower_segment_index = middle_segment_index + 1;
+		}
+		else
+		{
+			upper_segment_index = middle_segment_index;
+		}
+	}
+	*segment_index = lower_segment_index;
+
+	return( 1 );
+}
+
+/* Retrieves the supplied segment that contains a specific offset
+ * Returns 1 if successful, 0 if no such segment or -1 on error
+ */
+int libpff_caller_io_handle_get_segment_at_offset(
+     libpff_caller_io_handle_t *io_handle,
+     off64_t offset,
+     libpff_caller_io_segment_t **segment,
+     libcerror_error_t **error )
+{
+	libpff_caller_io_segment_t *safe_segment = NULL;
+	static char *function                    = "libpff_caller_io_handle_get_segment_at_offset";
+	int number_of_segments                   = 0;
+	int segment_index                        = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     io_handle->segments_array,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_caller_io_handle_get_segment_index_after_offset(
+	     io_handle,
+	     offset,
+	     &segment_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment index after offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	if( segment_index >= number_of_segments )
+	{
+		return( 0 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     io_handle->segments_array,
+	     segment_index,
+	     (intptr_t **) &safe_segment,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment: %d.",
+		 function,
+		 segment_index );
+
+		return( -1 );
+	}
+	if( safe_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing segment: %d.",
+		 function,
+		 segment_index );
+
+		return( -1 );
+	}
+	if( offset < safe_segment->offset )
+	{
+		return( 0 );
+	}
+	*segment = safe_segment;
+
+	return( 1 );
+}
+
+/* Reads a buffer from the IO handle
+ * If the data was not supplied the read is marked as pending
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libpff_caller_io_handle_read(
+         libpff_caller_io_handle_t *io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	libpff_caller_io_segment_t *segment = NULL;
+	static char *function               = "libpff_caller_io_handle_read";
+	size_t buffer_offset                = 0;
+	size_t read_size                    = 0;
+	size_t segment_data_offset          = 0;
+	off64_t current_offset              = 0;
+	int result                          = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( io_handle->access_flags & LIBBFIO_ACCESS_FLAG_READ ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - no read access.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) io_handle->current_offset >= io_handle->data_size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) size > ( io_handle->data_size - io_handle->current_offset ) )
+	{
+		size = (size_t) ( io_handle->data_size - io_handle->current_offset );
+	}
+	current_offset = io_handle->current_offset;
+
+	while( buffer_offset < size )
+	{
+		result = libpff_caller_io_handle_get_segment_at_offset(
+		          io_handle,
+		          current_offset,
+		          &segment,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 current_offset,
+			 current_offset );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			io_handle->pending_read_offset = current_offset;
+			io_handle->pending_read_size   = (size64_t) ( size - buffer_offset );
+			io_handle->has_pending_read    = 1;
+
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: data at offset: %" PRIi64 " (0x%08" PRIx64 ") of size: %" PRIzd " not supplied.",
+			 function,
+			 current_offset,
+			 current_offset,
+			 size - buffer_offset );
+
+			return( -1 );
+		}
+		segment_data_offset = (size_t) ( current_offset - segment->offset );
+		read_size           = segment->data_size - segment_data_offset;
+
+		if( read_size > ( size - buffer_offset ) )
+		{
+			read_size = size - buffer_offset;
+		}
+		if( memory_copy(
+		     &( buffer[ buffer_offset ] ),
+		     &( segment->data[ segment_data_offset ] ),
+		     read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy segment data.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_offset  += read_size;
+		current_offset += (off64_t) read_size;
+	}
+	io_handle->current_offset = current_offset;
+
+	return( (ssize_t) size );
+}
+
+/* Writes a buffer to the IO handle
+ * Returns the number of bytes written if successful, or -1 on error
+ */
+ssize_t libpff_caller_io_handle_write(
+         libpff_caller_io_handle_t *io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libpff_caller_io_handle_write";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( io_handle->access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - no write access.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/* Seeks a certain offset within the IO handle
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t libpff_caller_io_handle_seek_offset(
+         libpff_caller_io_handle_t *io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libpff_caller_io_handle_seek_offset";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += io_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		offset += (off64_t) io_handle->data_size;
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Function to determine if the data exists
+ * Returns 1 if the data exists, 0 if not or -1 on error
+ */
+int libpff_caller_io_handle_exists(
+     libpff_caller_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_caller_io_handle_exists";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Check if the IO handle is open
+ * Returns 1 if open, 0 if not or -1 on error
+ */
+int libpff_caller_io_handle_is_open(
+     libpff_caller_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_caller_io_handle_is_open";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the data size
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_caller_io_handle_get_size(
+     libpff_caller_io_handle_t *io_handle,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_caller_io_handle_get_size";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	*size = io_handle->data_size;
+
+	return( 1 );
+}
+
+/* Determines if a range of data has been supplied
+ * Returns 1 if the range was supplied, 0 if not or -1 on error
+ */
+int libpff_caller_io_handle_range_is_supplied(
+     libpff_caller_io_handle_t *io_handle,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	libpff_caller_io_segment_t *segment = NULL;
+	static char *function               = "libpff_caller_io_handle_range_is_supplied";
+	off64_t range_end_offset            = 0;
+	int result                          = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( size > (size64_t) ( INT64_MAX - offset ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	range_end_offset = offset + (off64_t) size;
+
+	while( offset < range_end_offset )
+	{
+		result = libpff_caller_io_handle_get_segment_at_offset(
+		          io_handle,
+		          offset,
+		          &segment,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+		/* Supplied segments that are adjacent are not merged
+		 * hence continue with the segment that follows
+		 */
+		offset = segment->offset + (off64_t) segment->data_size;
+	}
+	return( 1 );
+}
+
+/* Supplies data to the IO handle
+ * The data is copied. The segments are kept sorted by offset and data that overlaps
+ * previously supplied segments is merged with them. The pending read is cleared when
+ * the supplied data covers it
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_caller_io_handle_supply_data(
+     libpff_caller_io_handle_t *io_handle,
+     off64_t offset,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libpff_caller_io_segment_t *overlapping_segment = NULL;
+	libpff_caller_io_segment_t *segment             = NULL;
+	uint8_t *merged_data                            = NULL;
+	static char *function                           = "libpff_caller_io_handle_supply_data";
+	size_t merged_data_size                         = 0;
+	off64_t data_end_offset                         = 0;
+	off64_t merged_end_offset                       = 0;
+	off64_t merged_offset                           = 0;
+	off64_t segment_end_offset                      = 0;
+	off64_t segment_offset                          = 0;
+	int first_segment_index                         = 0;
+	int last_segment_index                          = 0;
+	int number_of_overlapping_segments              = 0;
+	int number_of_segments                          = 0;
+	int result                                      = 0;
+	int segment_index                               = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= io_handle->data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( (size64_t) data_size > ( io_handle->data_size - (size64_t) offset ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     io_handle->segments_array,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_caller_io_handle_get_segment_index_after_offset(
+	     io_handle,
+	     offset,
+	     &first_segment_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment index after offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		goto on_error;
+	}
+	data_end_offset   = offset + (off64_t) data_size;
+	merged_offset     = offset;
+	merged_end_offset = data_end_offset;
+
+	/* Determine the supplied segments that overlap with the data
+	 */
+	for( last_segment_index = first_segment_index;
+	     last_segment_index < number_of_segments;
+	     last_segment_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     io_handle->segments_array,
+		     last_segment_index,
+		     (intptr_t **) &overlapping_segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %d.",
+			 function,
+			 last_segment_index );
+
+			goto on_error;
+		}
+		if( overlapping_segment == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment: %d.",
+			 function,
+			 last_segment_index );
+
+			goto on_error;
+		}
+		if( overlapping_segment->offset >= data_end_offset )
+		{
+			break;
+		}
+		if( last_segment_index == first_segment_index )
+		{
+			segment_offset = overlapping_segment->offset;
+		}
+		segment_end_offset = overlapping_segment->offset + (off64_t) overlapping_segment->data_size;
+
+		if( overlapping_segment->offset < merged_offset )
+		{
+			merged_offset = overlapping_segment->offset;
+		}
+		if( segment_end_offset > merged_end_offset )
+		{
+			merged_end_offset = segment_end_offset;
+		}
+	}
+	number_of_overlapping_segments = last_segment_index - first_segment_index;
+
+	/* Data that lies within a single previously supplied segment is already available
+	 */
+	if( ( number_of_overlapping_segments == 1 )
+	 && ( merged_offset == segment_offset )
+	 && ( merged_end_offset == segment_end_offset ) )
+	{
+		overlapping_segment = NULL;
+	}
+	else if( number_of_overlapping_segments == 0 )
+	{
+		if( libpff_caller_io_segment_initialize(
+		     &segment,
+		     offset,
+		     data,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcdata_array_resize(
+		     io_handle->segments_array,
+		     number_of_segments + 1,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_caller_io_segment_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize segments array.",
+			 function );
+
+			goto on_error;
+		}
+		/* Move the segments that follow the data to make room for the segment
+		 */
+		for( segment_index = number_of_segments;
+		     segment_index > first_segment_index;
+		     segment_index-- )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     io_handle->segments_array,
+			     segment_index - 1,
+			     (intptr_t **) &overlapping_segment,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve segment: %d.",
+				 function,
+				 segment_index - 1 );
+
+				goto on_error;
+			}
+			if( libcdata_array_set_entry_by_index(
+			     io_handle->segments_array,
+			     segment_index,
+			     (intptr_t *) overlapping_segment,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set segment: %d.",
+				 function,
+				 segment_index );
+
+				goto on_error;
+			}
+		}
+		if( libcdata_array_set_entry_by_index(
+		     io_handle->segments_array,
+		     first_segment_index,
+		     (intptr_t *) segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set segment: %d.",
+			 function,
+			 first_segment_index );
+
+			goto on_error;
+		}
+		segment = NULL;
+
+		io_handle->supplied_data_size += data_size;
+	}
+	else
+	{
+		if( (size64_t) ( merged_end_offset - merged_offset ) > (size64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid merged data size value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		merged_data_size = (size_t) ( merged_end_offset - merged_offset );
+
+		merged_data = (uint8_t *) memory_allocate(
+		                           sizeof( uint8_t ) * merged_data_size );
+
+		if( merged_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create merged data.",
+			 function );
+
+			goto on_error;
+		}
+		for( segment_index = first_segment_index;
+		     segment_index < last_segment_index;
+		     segment_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     io_handle->segments_array,
+			     segment_index,
+			     (intptr_t **) &overlapping_segment,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve segment: %d.",
+				 function,
+				 segment_index );
+
+				goto on_error;
+			}
+			if( memory_copy(
+			     &( merged_data[ overlapping_segment->offset - merged_offset ] ),
+			     overlapping_segment->data,
+			     overlapping_segment->data_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy segment: %d data.",
+				 function,
+				 segment_index );
+
+				goto on_error;
+			}
+		}
+		if( memory_copy(
+		     &( merged_data[ offset - merged_offset ] ),
+		     data,
+		     data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data.",
+			 function );
+
+			goto on_error;
+		}
+		if( libpff_caller_io_segment_initialize(
+		     &segment,
+		     merged_offset,
+		     merged_data,
+		     merged_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create merged segment.",
+			 function );
+
+			goto on_error;
+		}
+		memory_free(
+		 merged_data );
+
+		merged_data = NULL;
+
+		/* Replace the overlapping segments by the merged segment
+		 */
+		for( segment_index = first_segment_index;
+		     segment_index < last_segment_index;
+		     segment_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     io_handle->segments_array,
+			     segment_index,
+			     (intptr_t **) &overlapping_segment,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve segment: %d.",
+				 function,
+				 segment_index );
+
+				goto on_error;
+			}
+			if( libcdata_array_set_entry_by_index(
+			     io_handle->segments_array,
+			     segment_index,
+			     NULL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set segment: %d.",
+				 function,
+				 segment_index );
+
+				goto on_error;
+			}
+			io_handle->supplied_data_size -= overlapping_segment->data_size;
+
+			if( libpff_caller_io_segment_free(
+			     &overlapping_segment,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free segment: %d.",
+				 function,
+				 segment_index );
+
+				goto on_error;
+			}
+		}
+		if( libcdata_array_set_entry_by_index(
+		     io_handle->segments_array,
+		     first_segment_index,
+		     (intptr_t *) segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set segment: %d.",
+			 function,
+			 first_segment_index );
+
+			goto on_error;
+		}
+		segment = NULL;
+
+		io_handle->supplied_data_size += merged_data_size;
+
+		/* Move the segments that follow the merged segment
+		 */
+		for( segment_index = last_segment_index;
+		     segment_index < number_of_segments;
+		     segment_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     io_handle->segments_array,
+			     segment_index,
+			     (intptr_t **) &overlapping_segment,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve segment: %d.",
+				 function,
+				 segment_index );
+
+				goto on_error;
+			}
+			if( libcdata_array_set_entry_by_index(
+			     io_handle->segments_array,
+			     segment_index - number_of_overlapping_segments + 1,
+			     (intptr_t *) overlapping_segment,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set segment: %d.",
+				 function,
+				 segment_index - number_of_overlapping_segments + 1 );
+
+				goto on_error;
+			}
+			if( libcdata_array_set_entry_by_index(
+			     io_handle->segments_array,
+			     segment_index,
+			     NULL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set segment: %d.",
+				 function,
+				 segment_index );
+
+				goto on_error;
+			}
+		}
+		if( libcdata_array_resize(
+		     io_handle->segments_array,
+		     number_of_segments - number_of_overlapping_segments + 1,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_caller_io_segment_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize segments array.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( io_handle->has_pending_read != 0 )
+	{
+		result = libpff_caller_io_handle_range_is_supplied(
+		          io_handle,
+		          io_handle->pending_read_offset,
+		          io_handle->pending_read_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if pending read was supplied.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			io_handle->pending_read_offset = 0;
+			io_handle->pending_read_size   = 0;
+			io_handle->has_pending_read    = 0;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( segment != NULL )
+	{
+		libpff_caller_io_segment_free(
+		 &segment,
+		 NULL );
+	}
+	if( merged_data != NULL )
+	{
+		memory_free(
+		 merged_data );
+	}
+	return( -1 );
+}
+
+/* Releases the supplied data within a specific range
+ * Segments that lie partially within the range are trimmed
+ * Returns 1 if successful, 0 if no data was supplied within the range or -1 on error
+ */
+int libpff_caller_io_handle_release_data(
+     libpff_caller_io_handle_t *io_handle,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	libpff_caller_io_segment_t *first_segment = NULL;
+	libpff_caller_io_segment_t *head_segment  = NULL;
+	libpff_caller_io_segment_t *last_segment  = NULL;
+	libpff_caller_io_segment_t *segment       = NULL;
+	libpff_caller_io_segment_t *tail_segment  = NULL;
+	static char *function                     = "libpff_caller_io_handle_release_data";
+	size64_t released_data_size               = 0;
+	off64_t end_offset                        = 0;
+	off64_t last_segment_end_offset           = 0;
+	int first_segment_index                   = 0;
+	int last_segment_index                    = 0;
+	int number_of_released_segments           = 0;
+	int number_of_remaining_segments          = 0;
+	int number_of_segments                    = 0;
+	int segment_index                         = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= io_handle->data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( size > ( io_handle->data_size - (size64_t) offset ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     io_handle->segments_array,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_caller_io_handle_get_segment_index_after_offset(
+	     io_handle,
+	     offset,
+	     &first_segment_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment index after offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		goto on_error;
+	}
+	end_offset = offset + (off64_t) size;
+
+	/* Determine the supplied segments that overlap with the range
+	 */
+	for( last_segment_index = first_segment_index;
+	     last_segment_index < number_of_segments;
+	     last_segment_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     io_handle->segments_array,
+		     last_segment_index,
+		     (intptr_t **) &segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %d.",
+			 function,
+			 last_segment_index );
+
+			goto on_error;
+		}
+		if( segment == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment: %d.",
+			 function,
+			 last_segment_index );
+
+			goto on_error;
+		}
+		if( segment->offset >= end_offset )
+		{
+			break;
+		}
+		if( last_segment_index == first_segment_index )
+		{
+			first_segment = segment;
+		}
+		last_segment        = segment;
+		released_data_size += segment->data_size;
+	}
+	number_of_released_segments = last_segment_index - first_segment_index;
+
+	if( number_of_released_segments == 0 )
+	{
+		return( 0 );
+	}
+	/* Since the segments do not overlap only the first and last segment
+	 * can lie partially outside the range
+	 */
+	if( first_segment->offset < offset )
+	{
+		if( libpff_caller_io_segment_initialize(
+		     &head_segment,
+		     first_segment->offset,
+		     first_segment->data,
+		     (size_t) ( offset - first_segment->offset ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create head segment.",
+			 function );
+
+			goto on_error;
+		}
+		released_data_size -= head_segment->data_size;
+
+		number_of_remaining_segments++;
+	}
+	last_segment_end_offset = last_segment->offset + (off64_t) last_segment->data_size;
+
+	if( last_segment_end_offset > end_offset )
+	{
+		if( libpff_caller_io_segment_initialize(
+		     &tail_segment,
+		     end_offset,
+		     &( last_segment->data[ end_offset - last_segment->offset ] ),
+		     (size_t) ( last_segment_end_offset - end_offset ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create tail segment.",
+			 function );
+
+			goto on_error;
+		}
+		released_data_size -= tail_segment->data_size;
+
+		number_of_remaining_segments++;
+	}
+	first_segment = NULL;
+	last_segment  = NULL;
+
+	for( segment_index = first_segment_index;
+	     segment_index < last_segment_index;
+	     segment_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     io_handle->segments_array,
+		     segment_index,
+		     (intptr_t **) &segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		if( libcdata_array_set_entry_by_index(
+		     io_handle->segments_array,
+		     segment_index,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		if( libpff_caller_io_segment_free(
+		     &segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+	}
+	/* Move the segments that follow the range, a range within a single
+	 * segment splits the segment in a head and a tail segment
+	 */
+	if( number_of_remaining_segments > number_of_released_segments )
+	{
+		if( libcdata_array_resize(
+		     io_handle->segments_array,
+		     number_of_segments + 1,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_caller_io_segment_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize segments array.",
+			 function );
+
+			goto on_error;
+		}
+		for( segment_index = number_of_segments;
+		     segment_index > last_segment_index;
+		     segment_index-- )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     io_handle->segments_array,
+			     segment_index - 1,
+			     (intptr_t **) &segment,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve segment: %d.",
+				 function,
+				 segment_index - 1 );
+
+				goto on_error;
+			}
+			if( libcdata_array_set_entry_by_index(
+			     io_handle->segments_array,
+			     segment_index,
+			     (intptr_t *) segment,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set segment: %d.",
+				 function,
+				 segment_index );
+
+				goto on_error;
+			}
+		}
+	}
+	else if( number_of_remaining_segments < number_of_released_segments )
+	{
+		for( segment_index = last_segment_index;
+		     segment_index < number_of_segments;
+		     segment_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     io_handle->segments_array,
+			     segment_index,
+			     (intptr_t **) &segment,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve segment: %d.",
+				 function,
+				 segment_index );
+
+				goto on_error;
+			}
+			if( libcdata_array_set_entry_by_index(
+			     io_handle->segments_array,
+			     segment_index - number_of_released_segments + number_of_remaining_segments,
+			     (intptr_t *) segment,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set segment: %d.",
+				 function,
+				 segment_index - number_of_released_segments + number_of_remaining_segments );
+
+				goto on_error;
+			}
+			if( libcdata_array_set_entry_by_index(
+			     io_handle->segments_array,
+			     segment_index,
+			     NULL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set segment: %d.",
+				 function,
+				 segment_index );
+
+				goto on_error;
+			}
+		}
+		if( libcdata_array_resize(
+		     io_handle->segments_array,
+		     number_of_segments - number_of_released_segments + number_of_remaining_segments,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_caller_io_segment_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize segments array.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	segment_index = first_segment_index;
+
+	if( head_segment != NULL )
+	{
+		if( libcdata_array_set_entry_by_index(
+		     io_handle->segments_array,
+		     segment_index,
+		     (intptr_t *) head_segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set head segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		head_segment = NULL;
+
+		segment_index++;
+	}
+	if( tail_segment != NULL )
+	{
+		if( libcdata_array_set_entry_by_index(
+		     io_handle->segments_array,
+		     segment_index,
+		     (intptr_t *) tail_segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set tail segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		tail_segment = NULL;
+	}
+	io_handle->supplied_data_size -= released_data_size;
+
+	return( 1 );
+
+on_error:
+	if( tail_segment != NULL )
+	{
+		libpff_caller_io_segment_free(
+		 &tail_segment,
+		 NULL );
+	}
+	if( head_segment != NULL )
+	{
+		libpff_caller_io_segment_free(
+		 &head_segment,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the total size of the supplied data
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_caller_io_handle_get_supplied_data_size(
+     libpff_caller_io_handle_t *io_handle,
+     size64_t *supplied_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_caller_io_handle_get_supplied_data_size";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( supplied_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid supplied data size.",
+		 function );
+
+		return( -1 );
+	}
+	*supplied_data_size = io_handle->supplied_data_size;
+
+	return( 1 );
+}
+
+/* Clears the pending read
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_caller_io_handle_clear_pending_read(
+     libpff_caller_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_caller_io_handle_clear_pending_read";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle->pending_read_offset = 0;
+	io_handle->pending_read_size   = 0;
+	io_handle->has_pending_read    = 0;
+
+	return( 1 );
+}
+
+/* Retrieves the pending read
+ * Returns 1 if successful, 0 if no read is pending or -1 on error
+ */
+int libpff_caller_io_handle_get_pending_read(
+     libpff_caller_io_handle_t *io_handle,
+     off64_t *offset,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_caller_io_handle_get_pending_read";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->has_pending_read == 0 )
+	{
+		return( 0 );
+	}
+	*offset = io_handle->pending_read_offset;
+	*size   = io_handle->pending_read_size;
+
+	return( 1 );
+}
+
@@ -0,0 +1,219 @@
+/*
+ * Caller driven IO handle functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPFF_CALLER_IO_HANDLE_H )
+#define _LIBPFF_CALLER_IO_HANDLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libpff_libcdata.h"
+#include "libpff_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libpff_caller_io_segment libpff_caller_io_segment_t;
+
+struct libpff_caller_io_segment
+{
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+};
+
+typedef struct libpff_caller_io_handle libpff_caller_io_handle_t;
+
+/* The caller driven IO handle does not read data itself.
+ * Data is supplied by the caller. A read of data that has not been
+ * supplied fails and records the range that is needed, after which
+ * the caller can supply the range and retry the operation.
+ */
+struct libpff_caller_io_handle
+{
+	/* The data size
+	 */
+	size64_t data_size;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+	/* The supplied segments array, sorted by offset and without overlap
+	 */
+	libcdata_array_t *segments_array;
+
+	/* The total size of the supplied segments
+	 */
+	size64_t supplied_data_size;
+
+	/* The pending read offset
+	 */
+	off64_t pending_read_offset;
+
+	/* The pending read size
+	 */
+	size64_t pending_read_size;
+
+	/* Value to indicate a read is pending
+	 */
+	uint8_t has_pending_read;
+
+	/* Value to indicate the IO handle is open
+	 */
+	uint8_t is_open;
+
+	/* The current access flags
+	 */
+	int access_flags;
+};
+
+int libpff_caller_io_segment_initialize(
+     libpff_caller_io_segment_t **segment,
+     off64_t offset,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libpff_caller_io_segment_free(
+     libpff_caller_io_segment_t **segment,
+     libcerror_error_t **error );
+
+int libpff_caller_io_segment_clone(
+     libpff_caller_io_segment_t **destination_segment,
+     libpff_caller_io_segment_t *source_segment,
+     libcerror_error_t **error );
+
+int libpff_caller_io_handle_initialize(
+     libpff_caller_io_handle_t **io_handle,
+     size64_t data_size,
+     libcerror_error_t **error );
+
+int libpff_caller_io_handle_free(
+     libpff_caller_io_handle_t **io_handle,
+     libcerror_error_t **error );
+
+int libpff_caller_io_handle_clone(
+     libpff_caller_io_handle_t **destination_io_handle,
+     libpff_caller_io_handle_t *source_io_handle,
+     libcerror_error_t **error );
+
+int libpff_caller_io_handle_open(
+     libpff_caller_io_handle_t *io_handle,
+     int flags,
+     libcerror_error_t **error );
+
+int libpff_caller_io_handle_close(
+     libpff_caller_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+ssize_t libpff_caller_io_handle_read(
+         libpff_caller_io_handle_t *io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t libpff_caller_io_handle_write(
+         libpff_caller_io_handle_t *io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+off64_t libpff_caller_io_handle_seek_offset(
+         libpff_caller_io_handle_t *io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
+int libpff_caller_io_handle_exists(
+     libpff_caller_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+int libpff_caller_io_handle_is_open(
+     libpff_caller_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+int libpff_caller_io_handle_get_size(
+     libpff_caller_io_handle_t *io_handle,
+     size64_t *size,
+     libcerror_error_t **error );
+
+int libpff_caller_io_handle_get_segment_index_after_offset(
+     libpff_caller_io_handle_t *io_handle,
+     off64_t offset,
+     int *segment_index,
+     libcerror_error_t **error );
+
+int libpff_caller_io_handle_get_segment_at_offset(
+     libpff_caller_io_handle_t *io_handle,
+     off64_t offset,
+     libpff_caller_io_segment_t **segment,
+     libcerror_error_t **error );
+
+int libpff_caller_io_handle_range_is_supplied(
+     libpff_caller_io_handle_t *io_handle,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+int libpff_caller_io_handle_supply_data(
+     libpff_caller_io_handle_t *io_handle,
+     off64_t offset,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libpff_caller_io_handle_release_data(
+     libpff_caller_io_handle_t *io_handle,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+int libpff_caller_io_handle_get_supplied_data_size(
+     libpff_caller_io_handle_t *io_handle,
+     size64_t *supplied_data_size,
+     libcerror_error_t **error );
+
+int libpff_caller_io_handle_clear_pending_read(
+     libpff_caller_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+int libpff_caller_io_handle_get_pending_read(
+     libpff_caller_io_handle_t *io_handle,
+     off64_t *offset,
+     size64_t *size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPFF_CALLER_IO_HANDLE_H ) */
+
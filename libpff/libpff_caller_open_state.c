@@ -0,0 +1,291 @@
+/*
+ * Caller driven open state functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libpff_caller_open_state.h"
+#include "libpff_definitions.h"
+#include "libpff_libcerror.h"
+
+/* Creates a caller driven open state
+ * Make sure the value caller_open_state is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_caller_open_state_initialize(
+     libpff_caller_open_state_t **caller_open_state,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_caller_open_state_initialize";
+
+	if( caller_open_state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid caller open state.",
+		 function );
+
+		return( -1 );
+	}
+	if( *caller_open_state != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid caller open state value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*caller_open_state = memory_allocate_structure(
+	                      libpff_caller_open_state_t );
+
+	if( *caller_open_state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create caller open state.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *caller_open_state,
+	     0,
+	     sizeof( libpff_caller_open_state_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear caller open state.",
+		 function );
+
+		goto on_error;
+	}
+	( *caller_open_state )->stage = LIBPFF_CALLER_OPEN_STAGE_FILE_HEADER;
+
+	return( 1 );
+
+on_error:
+	if( *caller_open_state != NULL )
+	{
+		memory_free(
+		 *caller_open_state );
+
+		*caller_open_state = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a caller driven open state
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_caller_open_state_free(
+     libpff_caller_open_state_t **caller_open_state,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_caller_open_state_free";
+
+	if( caller_open_state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid caller open state.",
+		 function );
+
+		return( -1 );
+	}
+	if( *caller_open_state != NULL )
+	{
+		if( ( *caller_open_state )->index_nodes != NULL )
+		{
+			memory_free(
+			 ( *caller_open_state )->index_nodes );
+		}
+		memory_free(
+		 *caller_open_state );
+
+		*caller_open_state = NULL;
+	}
+	return( 1 );
+}
+
+/* Pushes an index node that remains to be read
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_caller_open_state_push_index_node(
+     libpff_caller_open_state_t *caller_open_state,
+     off64_t offset,
+     int level,
+     libcerror_error_t **error )
+{
+	libpff_caller_open_index_node_t *index_nodes = NULL;
+	static char *function                        = "libpff_caller_open_state_push_index_node";
+	size_t index_nodes_size                      = 0;
+	int maximum_number_of_index_nodes            = 0;
+
+	if( caller_open_state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid caller open state.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( caller_open_state->number_of_index_nodes >= caller_open_state->maximum_number_of_index_nodes )
+	{
+		if( caller_open_state->maximum_number_of_index_nodes == 0 )
+		{
+			maximum_number_of_index_nodes = 64;
+		}
+		else if( caller_open_state->maximum_number_of_index_nodes < ( INT_MAX / 2 ) )
+		{
+			maximum_number_of_index_nodes = caller_open_state->maximum_number_of_index_nodes * 2;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid maximum number of index nodes value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		index_nodes_size = sizeof( libpff_caller_open_index_node_t ) * maximum_number_of_index_nodes;
+
+		if( index_nodes_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid index nodes size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		index_nodes = (libpff_caller_open_index_node_t *) memory_reallocate(
+		                                                   caller_open_state->index_nodes,
+		                                                   index_nodes_size );
+
+		if( index_nodes == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize index nodes.",
+			 function );
+
+			return( -1 );
+		}
+		caller_open_state->index_nodes                   = index_nodes;
+		caller_open_state->maximum_number_of_index_nodes = maximum_number_of_index_nodes;
+	}
+	caller_open_state->index_nodes[ caller_open_state->number_of_index_nodes ].offset = offset;
+	caller_open_state->index_nodes[ caller_open_state->number_of_index_nodes ].level  = level;
+
+	caller_open_state->number_of_index_nodes += 1;
+
+	return( 1 );
+}
+
+/* Pops the last pushed index node that remains to be read
+ * Returns 1 if successful, 0 if no index node remains or -1 on error
+ */
+int libpff_caller_open_state_pop_index_node(
+     libpff_caller_open_state_t *caller_open_state,
+     off64_t *offset,
+     int *level,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_caller_open_state_pop_index_node";
+
+	if( caller_open_state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid caller open state.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( level == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid level.",
+		 function );
+
+		return( -1 );
+	}
+	if( caller_open_state->number_of_index_nodes <= 0 )
+	{
+		return( 0 );
+	}
+	caller_open_state->number_of_index_nodes -= 1;
+
+	*offset = caller_open_state->index_nodes[ caller_open_state->number_of_index_nodes ].offset;
+	*level  = caller_open_state->index_nodes[ caller_open_state->number_of_index_nodes ].level;
+
+	return( 1 );
+}
+
@@ -0,0 +1,97 @@
+/*
+ * Caller driven open state functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPFF_CALLER_OPEN_STATE_H )
+#define _LIBPFF_CALLER_OPEN_STATE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libpff_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libpff_caller_open_index_node libpff_caller_open_index_node_t;
+
+struct libpff_caller_open_index_node
+{
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The level, -1 if not known
+	 */
+	int level;
+};
+
+typedef struct libpff_caller_open_state libpff_caller_open_state_t;
+
+/* The caller driven open state is kept while a caller driven open waits
+ * for data to be supplied, so that a retried open continues with the stage
+ * it stopped at instead of reading the file from the start
+ */
+struct libpff_caller_open_state
+{
+	/* The stage
+	 */
+	int stage;
+
+	/* The index nodes that remain to be read
+	 */
+	libpff_caller_open_index_node_t *index_nodes;
+
+	/* The number of index nodes that remain to be read
+	 */
+	int number_of_index_nodes;
+
+	/* The maximum number of index nodes
+	 */
+	int maximum_number_of_index_nodes;
+};
+
+int libpff_caller_open_state_initialize(
+     libpff_caller_open_state_t **caller_open_state,
+     libcerror_error_t **error );
+
+int libpff_caller_open_state_free(
+     libpff_caller_open_state_t **caller_open_state,
+     libcerror_error_t **error );
+
+int libpff_caller_open_state_push_index_node(
+     libpff_caller_open_state_t *caller_open_state,
+     off64_t offset,
+     int level,
+     libcerror_error_t **error );
+
+int libpff_caller_open_state_pop_index_node(
+     libpff_caller_open_state_t *caller_open_state,
+     off64_t *offset,
+     int *level,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPFF_CALLER_OPEN_STATE_H ) */
+
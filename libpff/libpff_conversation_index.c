@@ -0,0 +1,347 @@
+/*
+ * Conversation index functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libpff_conversation_index.h"
+#include "libpff_libcerror.h"
+
+/* Retrieves the values of the conversation index header block
+ * The header block consists of the upper 48-bits of a FILETIME and a GUID
+ * both stored in big-endian. The GUID data is copied as stored
+ * Returns 1 if successful, 0 if the data does not contain a header block or -1 on error
+ */
+int libpff_conversation_index_get_header_values(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t *filetime,
+     uint8_t *guid_data,
+     size_t guid_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_conversation_index_get_header_values";
+	uint64_t value_64bit  = 0;
+	uint8_t byte_index    = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( filetime == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filetime.",
+		 function );
+
+		return( -1 );
+	}
+	if( guid_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid GUID data.",
+		 function );
+
+		return( -1 );
+	}
+	if( guid_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: GUID data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( guid_data_size < 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: GUID data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	/* According to MSDN the first byte is reserved
+	 * and should always be 0x01 however it makes
+	 * more sense that it's the most significant
+	 * part of the current system filetime data
+	 */
+	if( ( data_size < LIBPFF_CONVERSATION_INDEX_HEADER_BLOCK_SIZE )
+	 || ( data[ 0 ] != 0x01 ) )
+	{
+		return( 0 );
+	}
+	for( byte_index = 0;
+	     byte_index < 6;
+	     byte_index++ )
+	{
+		value_64bit <<= 8;
+		value_64bit  |= data[ byte_index ];
+	}
+	*filetime = value_64bit << 16;
+
+	if( memory_copy(
+	     guid_data,
+	     &( data[ 6 ] ),
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy GUID data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of conversation index child blocks
+ * Trailing data that is too small to contain a child block is ignored
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_conversation_index_get_number_of_child_blocks(
+     const uint8_t *data,
+     size_t data_size,
+     int *number_of_child_blocks,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_conversation_index_get_number_of_child_blocks";
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_child_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of child blocks.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size < LIBPFF_CONVERSATION_INDEX_HEADER_BLOCK_SIZE )
+	{
+		*number_of_child_blocks = 0;
+	}
+	else
+	{
+		*number_of_child_blocks = (int) ( ( data_size - LIBPFF_CONVERSATION_INDEX_HEADER_BLOCK_SIZE ) / LIBPFF_CONVERSATION_INDEX_CHILD_BLOCK_SIZE );
+	}
+	return( 1 );
+}
+
+/* Retrieves the values of a specific conversation index child block
+ * The time delta of a child block is relative to the filetime of the previous
+ * block, not to that of the header block as MSDN states, hence the filetime
+ * of a child block is determined by adding the time deltas of the child blocks
+ * up to and including this one to the filetime of the header block
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_conversation_index_get_child_block_values(
+     const uint8_t *data,
+     size_t data_size,
+     int child_block_index,
+     uint64_t *time_delta,
+     uint8_t *random_number,
+     uint8_t *sequence_count,
+     libcerror_error_t **error )
+{
+	uint8_t guid_data[ 16 ];
+
+	static char *function      = "libpff_conversation_index_get_child_block_values";
+	size_t data_offset         = 0;
+	uint64_t value_64bit       = 0;
+	uint32_t value_32bit       = 0;
+	int number_of_child_blocks = 0;
+	int result                 = 0;
+
+	if( time_delta == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid time delta.",
+		 function );
+
+		return( -1 );
+	}
+	if( random_number == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid random number.",
+		 function );
+
+		return( -1 );
+	}
+	if( sequence_count == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sequence count.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_conversation_index_get_number_of_child_blocks(
+	     data,
+	     data_size,
+	     &number_of_child_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of child blocks.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( child_block_index < 0 )
+	 || ( child_block_index >= number_of_child_blocks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid child block index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	result = libpff_conversation_index_get_header_values(
+	          data,
+	          data_size,
+	          &value_64bit,
+	          guid_data,
+	          16,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve header values.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported conversation index header block.",
+		 function );
+
+		return( -1 );
+	}
+	data_offset = LIBPFF_CONVERSATION_INDEX_HEADER_BLOCK_SIZE
+	            + ( (size_t) child_block_index * LIBPFF_CONVERSATION_INDEX_CHILD_BLOCK_SIZE );
+
+	/* The delta code is stored in the most significant bit
+	 * followed by 31-bits of time delta, both in big-endian
+	 */
+	byte_stream_copy_to_uint32_big_endian(
+	 &( data[ data_offset ] ),
+	 value_32bit );
+
+	if( ( value_32bit & 0x80000000UL ) == 0 )
+	{
+		/* The time delta contains bits 18 to 48 of the delta
+		 */
+		*time_delta = (uint64_t) value_32bit << 18;
+	}
+	else
+	{
+		/* The time delta contains bits 23 to 53 of the delta
+		 */
+		*time_delta = (uint64_t) ( value_32bit & 0x7fffffffUL ) << 23;
+	}
+	*random_number  = ( data[ data_offset + 4 ] & 0xf0 ) >> 4;
+	*sequence_count = data[ data_offset + 4 ] & 0x0f;
+
+	return( 1 );
+}
+
@@ -0,0 +1,70 @@
+/*
+ * Conversation index functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPFF_CONVERSATION_INDEX_H )
+#define _LIBPFF_CONVERSATION_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libpff_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The size of the conversation index header block
+ */
+#define LIBPFF_CONVERSATION_INDEX_HEADER_BLOCK_SIZE		22
+
+/* The size of a conversation index child block
+ */
+#define LIBPFF_CONVERSATION_INDEX_CHILD_BLOCK_SIZE		5
+
+int libpff_conversation_index_get_header_values(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t *filetime,
+     uint8_t *guid_data,
+     size_t guid_data_size,
+     libcerror_error_t **error );
+
+int libpff_conversation_index_get_number_of_child_blocks(
+     const uint8_t *data,
+     size_t data_size,
+     int *number_of_child_blocks,
+     libcerror_error_t **error );
+
+int libpff_conversation_index_get_child_block_values(
+     const uint8_t *data,
+     size_t data_size,
+     int child_block_index,
+     uint64_t *time_delta,
+     uint8_t *random_number,
+     uint8_t *sequence_count,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPFF_CONVERSATION_INDEX_H ) */
+
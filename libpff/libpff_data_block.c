@@ -518,29 +518,130 @@ int libpff_data_block_read_footer_data(
 	return( 1 );
 }
 
-/* Reads the data block
+/* Determines the stored size of a data block
+ * The stored size includes the padding and the footer of the data block
  * Returns 1 if successful or -1 on error
  */
-int libpff_data_block_read_file_io_handle(
+int libpff_data_block_get_stored_size(
+     size32_t data_size,
+     uint8_t file_type,
+     size_t *stored_size,
+     libcerror_error_t **error )
+{
+	static char *function              = "libpff_data_block_get_stored_size";
+	uint32_t data_block_data_size      = 0;
+	uint32_t data_block_footer_size    = 0;
+	uint32_t data_block_increment_size = 0;
+	uint32_t maximum_data_block_size   = 0;
+
+	if( ( file_type != LIBPFF_FILE_TYPE_32BIT )
+	 && ( file_type != LIBPFF_FILE_TYPE_64BIT )
+	 && ( file_type != LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported file type.",
+		 function );
+
+		return( -1 );
+	}
+	if( stored_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stored size.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == 0 )
+	{
+		*stored_size = 0;
+
+		return( 1 );
+	}
+	if( file_type == LIBPFF_FILE_TYPE_32BIT )
+	{
+		data_block_footer_size    = (uint32_t) sizeof( pff_block_footer_32bit_t );
+		data_block_increment_size = 64;
+		maximum_data_block_size   = 8192;
+	}
+	else if( file_type == LIBPFF_FILE_TYPE_64BIT )
+	{
+		data_block_footer_size    = (uint32_t) sizeof( pff_block_footer_64bit_t );
+		data_block_increment_size = 64;
+		maximum_data_block_size   = 8192;
+	}
+	else if( file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE )
+	{
+		data_block_footer_size    = (uint32_t) sizeof( pff_block_footer_64bit_4k_page_t );
+		data_block_increment_size = 512;
+/* TODO: this value is currently assumed based on the 512 x 8 = 4k page */
+		maximum_data_block_size   = 65536;
+	}
+	if( data_size > maximum_data_block_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data block data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	data_block_data_size = (uint32_t) data_size / data_block_increment_size;
+
+	if( ( (uint32_t) data_size % data_block_increment_size ) != 0 )
+	{
+		data_block_data_size += 1;
+	}
+	data_block_data_size *= data_block_increment_size;
+
+	if( ( data_block_data_size - (uint32_t) data_size ) < data_block_footer_size )
+	{
+		data_block_data_size += data_block_increment_size;
+	}
+	if( ( data_block_data_size == 0 )
+	 || ( data_block_data_size > maximum_data_block_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data block data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*stored_size = (size_t) data_block_data_size;
+
+	return( 1 );
+}
+
+/* Reads the data block from its stored data
+ * The data of the data block must contain the stored data including the padding and the footer
+ * The data is freed on error
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_data_block_read_stored_data(
      libpff_data_block_t *data_block,
-     libbfio_handle_t *file_io_handle,
-     off64_t file_offset,
      size32_t data_size,
      uint8_t file_type,
      libcerror_error_t **error )
 {
 	uint8_t *uncompressed_data            = NULL;
-	static char *function                 = "libpff_data_block_read_file_io_handle";
+	static char *function                 = "libpff_data_block_read_stored_data";
 	size_t data_block_footer_offset       = 0;
 	size_t data_block_padding_size        = 0;
 	size_t uncompressed_data_size         = 0;
-	ssize_t read_count                    = 0;
 	uint64_t data_block_back_pointer      = 0;
 	uint32_t calculated_checksum          = 0;
-	uint32_t data_block_data_size         = 0;
-	uint32_t data_block_increment_size    = 0;
 	uint32_t data_block_footer_size       = 0;
-	uint32_t maximum_data_block_size      = 0;
 
 #if defined( HAVE_VERBOSE_OUTPUT )
 	uint32_t maximum_data_block_data_size = 0;
@@ -557,20 +658,30 @@ int libpff_data_block_read_file_io_handle(
 
 		return( -1 );
 	}
-	if( data_block->data != NULL )
+	if( data_block->data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid data block - data value already set.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data block - missing data.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( file_type != LIBPFF_FILE_TYPE_32BIT )
-	 && ( file_type != LIBPFF_FILE_TYPE_64BIT )
-	 && ( file_type != LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
+	if( file_type == LIBPFF_FILE_TYPE_32BIT )
+	{
+		data_block_footer_size = (uint32_t) sizeof( pff_block_footer_32bit_t );
+	}
+	else if( file_type == LIBPFF_FILE_TYPE_64BIT )
+	{
+		data_block_footer_size = (uint32_t) sizeof( pff_block_footer_64bit_t );
+	}
+	else if( file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE )
+	{
+		data_block_footer_size = (uint32_t) sizeof( pff_block_footer_64bit_4k_page_t );
+	}
+	else
 	{
 		libcerror_error_set(
 		 error,
@@ -579,315 +690,539 @@ int libpff_data_block_read_file_io_handle(
 		 "%s: unsupported file type.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#if UINT32_MAX > SSIZE_MAX
-	if( data_size > (size32_t) SSIZE_MAX )
+#if defined( HAVE_VERBOSE_OUTPUT )
+	if( file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE )
+	{
+		maximum_data_block_data_size = 65536 - data_block_footer_size;
+	}
+	else
+	{
+		maximum_data_block_data_size = 8192 - data_block_footer_size;
+	}
+#endif
+	if( ( data_block->data_size < data_block_footer_size )
+	 || ( ( data_block->data_size - data_block_footer_size ) < data_size ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: data size value exceeds maximum.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data block data size value out of bounds.",
 		 function );
 
-		return( -1 );
+		goto on_error;
+	}
+	data_block_footer_offset = data_block->data_size - data_block_footer_size;
+	data_block_padding_size  = data_block_footer_offset - data_size;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: data block padding size\t\t: %" PRIzd "\n",
+		 function,
+		 data_block_padding_size );
+
+		libcnotify_printf(
+		 "%s: data block padding:\n",
+		 function );
+		libcnotify_print_data(
+		 &( data_block->data[ data_size ] ),
+		 data_block_padding_size,
+		 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
 	}
 #endif
-	if( data_size != 0 )
+	if( libpff_data_block_read_footer_data(
+	     data_block,
+	     &( data_block->data[ data_block_footer_offset ] ),
+	     data_block_footer_size,
+	     file_type,
+	     error ) != 1 )
 	{
-		if( file_type == LIBPFF_FILE_TYPE_32BIT )
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data block footer.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_VERBOSE_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		if( data_block->data_size > maximum_data_block_data_size )
 		{
-			data_block_footer_size    = (uint32_t) sizeof( pff_block_footer_32bit_t );
-			data_block_increment_size = 64;
-			maximum_data_block_size   = 8192;
+			libcnotify_printf(
+			 "%s: data size: %" PRIu32 " exceeds format specified maximum: %" PRIu32 ".\n",
+			 function,
+			 data_block->data_size,
+                         maximum_data_block_data_size );
 		}
-		else if( file_type == LIBPFF_FILE_TYPE_64BIT )
+	}
+#endif
+	if( file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE )
+	{
+		if( ( data_block->data_size != 0 )
+		 && ( data_block->uncompressed_data_size != 0 )
+		 && ( data_block->data_size != data_block->uncompressed_data_size ) )
 		{
-			data_block_footer_size    = (uint32_t) sizeof( pff_block_footer_64bit_t );
-			data_block_increment_size = 64;
-			maximum_data_block_size   = 8192;
+			data_block->flags |= LIBPFF_DATA_BLOCK_FLAG_COMPRESSED;
 		}
-		else if( file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE )
+	}
+	if( ( data_block->flags & LIBPFF_DATA_BLOCK_FLAG_VALIDATED ) == 0 )
+	{
+		if( data_block->data_size != 0 )
 		{
-			data_block_footer_size    = (uint32_t) sizeof( pff_block_footer_64bit_4k_page_t );
-			data_block_increment_size = 512;
-/* TODO: this value is currently assumed based on the 512 x 8 = 4k page */
-			maximum_data_block_size   = 65536;
+			if( (size32_t) data_block->data_size != data_size )
+			{
+/* TODO flag size mismatch and error tollerance */
+				data_block->flags |= LIBPFF_DATA_BLOCK_FLAG_SIZE_MISMATCH;
+
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_INPUT,
+				 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+				 "%s: mismatch in data size ( %" PRIu32 " != %" PRIu32 " ).",
+				 function,
+				 data_block->data_size,
+				 data_size );
+
+				goto on_error;
+			}
 		}
-#if defined( HAVE_VERBOSE_OUTPUT )
-		maximum_data_block_data_size = maximum_data_block_size - data_block_footer_size;
+		if( data_block->stored_checksum != 0 )
+		{
+			if( libfmapi_checksum_calculate_weak_crc32(
+			     &calculated_checksum,
+			     data_block->data,
+			     (size_t) data_size,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unable to calculate weak CRC-32.",
+				 function );
+
+				goto on_error;
+			}
+			if( data_block->stored_checksum != calculated_checksum )
+			{
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: mismatch in data block checksum ( 0x%08" PRIx32 " != 0x%08" PRIx32 " ).\n",
+					 function,
+					 data_block->stored_checksum,
+					 calculated_checksum );
+				}
 #endif
-		data_block_data_size = (uint32_t) data_size / data_block_increment_size;
+				data_block->flags |= LIBPFF_DATA_BLOCK_FLAG_CRC_MISMATCH;
 
-		if( ( (uint32_t) data_size % data_block_increment_size ) != 0 )
-		{
-			data_block_data_size += 1;
+/* TODO smart error handling */
+			}
 		}
-		data_block_data_size *= data_block_increment_size;
-
-		if( ( data_block_data_size - (uint32_t) data_size ) < data_block_footer_size )
+		if( data_block_back_pointer != 0 )
 		{
-			data_block_data_size += data_block_increment_size;
+			if( data_block->data_identifier != data_block_back_pointer )
+			{
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: mismatch in data identifier: %" PRIu64 " (0x%08" PRIx64 ") and back pointer: 0x%08" PRIx64 ".\n",
+					 function,
+					 data_block->data_identifier,
+					 data_block->data_identifier,
+					 data_block_back_pointer );
+				}
+#endif
+				data_block->flags |= LIBPFF_DATA_BLOCK_FLAG_IDENTIFIER_MISMATCH;
+
+/* TODO smart error handling */
+			}
 		}
-		if( ( data_block_data_size == 0 )
-		 || ( data_block_data_size > maximum_data_block_size ) )
+		data_block->flags |= LIBPFF_DATA_BLOCK_FLAG_VALIDATED;
+	}
+/* TODO refactor after testing */
+	if( ( data_block->flags & LIBPFF_DATA_BLOCK_FLAG_COMPRESSED ) != 0 )
+	{
+		uncompressed_data_size = (size_t) data_block->uncompressed_data_size;
+
+		if( ( uncompressed_data_size == 0 )
+		 || ( uncompressed_data_size > MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid data block data size value out of bounds.",
+			 "%s: invalid uncompressed data size value out of bounds.",
 			 function );
 
 			goto on_error;
 		}
-		data_block->data = (uint8_t *) memory_allocate(
-		                                sizeof( uint8_t ) * data_block_data_size );
+		uncompressed_data = (uint8_t *) memory_allocate(
+		                                 sizeof( uint8_t ) * uncompressed_data_size );
 
-		if( data_block->data == NULL )
+		if( uncompressed_data == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_MEMORY,
 			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create data block data.",
+			 "%s: unable to create uncompressed data.",
 			 function );
 
 			goto on_error;
 		}
-		data_block->data_size = data_block_data_size;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: reading data block at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-			 function,
-			 file_offset,
-			 file_offset );
-		}
-#endif
-		read_count = libbfio_handle_read_buffer_at_offset(
-		              file_io_handle,
-		              data_block->data,
-		              data_block->data_size,
-		              file_offset,
-		              error );
-
-		if( read_count != (ssize_t) data_block->data_size )
+		if( libpff_decompress_data(
+		     data_block->data,
+		     (size_t) data_block->data_size,
+		     LIBPFF_COMPRESSION_METHOD_DEFLATE,
+		     uncompressed_data,
+		     &uncompressed_data_size,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read data block data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
-			 function,
-			 file_offset,
-			 file_offset );
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress data block data.",
+			 function );
 
 			goto on_error;
 		}
-		data_block_footer_offset = data_block->data_size - data_block_footer_size;
-		data_block_padding_size  = data_block_footer_offset - data_size;
+		memory_free(
+		 data_block->data );
 
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: data block padding size\t\t: %" PRIzd "\n",
-			 function,
-			 data_block_padding_size );
+		data_block->data      = uncompressed_data;
+		data_block->data_size = data_block->uncompressed_data_size;
+		uncompressed_data     = NULL;
 
-			libcnotify_printf(
-			 "%s: data block padding:\n",
-			 function );
-			libcnotify_print_data(
-			 &( data_block->data[ data_size ] ),
-			 data_block_padding_size,
-			 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
-		}
-#endif
-		if( libpff_data_block_read_footer_data(
-		     data_block,
-		     &( data_block->data[ data_block_footer_offset ] ),
-		     data_block_footer_size,
-		     file_type,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read data block footer.",
-			 function );
+		data_block->io_handle->total_number_of_decompressed_blocks += 1;
+	}
+	return( 1 );
 
-			goto on_error;
-		}
-#if defined( HAVE_VERBOSE_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			if( data_block->data_size > maximum_data_block_data_size )
-			{
-				libcnotify_printf(
-				 "%s: data size: %" PRIu32 " exceeds format specified maximum: %" PRIu32 ".\n",
-				 function,
-				 data_block->data_size,
-                                 maximum_data_block_data_size );
-			}
-		}
-#endif
-		if( file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE )
-		{
-			if( ( data_block->data_size != 0 )
-			 && ( data_block->uncompressed_data_size != 0 )
-			 && ( data_block->data_size != data_block->uncompressed_data_size ) )
-			{
-				data_block->flags |= LIBPFF_DATA_BLOCK_FLAG_COMPRESSED;
-			}
-		}
-		if( ( data_block->flags & LIBPFF_DATA_BLOCK_FLAG_VALIDATED ) == 0 )
-		{
-			if( data_block->data_size != 0 )
-			{
-				if( (size32_t) data_block->data_size != data_size )
-				{
-/* TODO flag size mismatch and error tollerance */
-					data_block->flags |= LIBPFF_DATA_BLOCK_FLAG_SIZE_MISMATCH;
+on_error:
+	if( uncompressed_data != NULL )
+	{
+		memory_free(
+		 uncompressed_data );
+	}
+	if( data_block->data != NULL )
+	{
+		memory_free(
+		 data_block->data );
 
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_INPUT,
-					 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-					 "%s: mismatch in data size ( %" PRIu32 " != %" PRIu32 " ).",
-					 function,
-					 data_block->data_size,
-					 data_size );
+		data_block->data = NULL;
+	}
+	data_block->data_size = 0;
 
-					goto on_error;
-				}
-			}
-			if( data_block->stored_checksum != 0 )
-			{
-				if( libfmapi_checksum_calculate_weak_crc32(
-				     &calculated_checksum,
-				     data_block->data,
-				     (size_t) data_size,
-				     0,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-					 "%s: unable to calculate weak CRC-32.",
-					 function );
+	return( -1 );
+}
 
-					goto on_error;
-				}
-				if( data_block->stored_checksum != calculated_checksum )
-				{
-#if defined( HAVE_DEBUG_OUTPUT )
-					if( libcnotify_verbose != 0 )
-					{
-						libcnotify_printf(
-						 "%s: mismatch in data block checksum ( 0x%08" PRIx32 " != 0x%08" PRIx32 " ).\n",
-						 function,
-						 data_block->stored_checksum,
-						 calculated_checksum );
-					}
-#endif
-					data_block->flags |= LIBPFF_DATA_BLOCK_FLAG_CRC_MISMATCH;
+/* Reads the data block
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_data_block_read_data(
+     libpff_data_block_t *data_block,
+     const uint8_t *stored_data,
+     size_t stored_data_size,
+     size32_t data_size,
+     uint8_t file_type,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_data_block_read_data";
+	size_t stored_size    = 0;
 
-/* TODO smart error handling */
-				}
-			}
-			if( data_block_back_pointer != 0 )
-			{
-				if( data_block->data_identifier != data_block_back_pointer )
-				{
-#if defined( HAVE_DEBUG_OUTPUT )
-					if( libcnotify_verbose != 0 )
-					{
-						libcnotify_printf(
-						 "%s: mismatch in data identifier: %" PRIu64 " (0x%08" PRIx64 ") and back pointer: 0x%08" PRIx64 ".\n",
-						 function,
-						 data_block->data_identifier,
-						 data_block->data_identifier,
-						 data_block_back_pointer );
-					}
-#endif
-					data_block->flags |= LIBPFF_DATA_BLOCK_FLAG_IDENTIFIER_MISMATCH;
+	if( data_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data block.",
+		 function );
 
-/* TODO smart error handling */
-				}
-			}
-			data_block->flags |= LIBPFF_DATA_BLOCK_FLAG_VALIDATED;
-		}
-/* TODO refactor after testing */
-		if( ( data_block->flags & LIBPFF_DATA_BLOCK_FLAG_COMPRESSED ) != 0 )
-		{
-			uncompressed_data_size = (size_t) data_block->uncompressed_data_size;
+		return( -1 );
+	}
+	if( data_block->data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid data block - data value already set.",
+		 function );
 
-			if( ( uncompressed_data_size == 0 )
-			 || ( uncompressed_data_size > MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-				 "%s: invalid uncompressed data size value out of bounds.",
-				 function );
+		return( -1 );
+	}
+	if( stored_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stored data.",
+		 function );
 
-				goto on_error;
-			}
-			uncompressed_data = (uint8_t *) memory_allocate(
-			                                 sizeof( uint8_t ) * uncompressed_data_size );
+		return( -1 );
+	}
+	if( libpff_data_block_get_stored_size(
+	     data_size,
+	     file_type,
+	     &stored_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine stored size.",
+		 function );
 
-			if( uncompressed_data == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-				 "%s: unable to create uncompressed data.",
-				 function );
+		return( -1 );
+	}
+	if( stored_size == 0 )
+	{
+		return( 1 );
+	}
+	if( stored_data_size < stored_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid stored data size value too small.",
+		 function );
 
-				goto on_error;
-			}
-			if( libpff_decompress_data(
-			     data_block->data,
-			     (size_t) data_block->data_size,
-			     LIBPFF_COMPRESSION_METHOD_DEFLATE,
-			     uncompressed_data,
-			     &uncompressed_data_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
-				 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
-				 "%s: unable to decompress data block data.",
-				 function );
+		return( -1 );
+	}
+	if( libpff_io_handle_check_read_limits(
+	     data_block->io_handle,
+	     stored_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_ABORT_REQUESTED,
+		 "%s: unable to read data block.",
+		 function );
 
-				goto on_error;
-			}
-			memory_free(
-			 data_block->data );
+		return( -1 );
+	}
+	data_block->data = (uint8_t *) memory_allocate(
+	                                sizeof( uint8_t ) * stored_size );
 
-			data_block->data      = uncompressed_data;
-			data_block->data_size = data_block->uncompressed_data_size;
-			uncompressed_data     = NULL;
-		}
+	if( data_block->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data block data.",
+		 function );
+
+		return( -1 );
 	}
-	return( 1 );
+	data_block->data_size = (uint32_t) stored_size;
 
-on_error:
-	if( uncompressed_data != NULL )
+	if( memory_copy(
+	     data_block->data,
+	     stored_data,
+	     stored_size ) == NULL )
 	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy data block data.",
+		 function );
+
 		memory_free(
-		 uncompressed_data );
+		 data_block->data );
+
+		data_block->data      = NULL;
+		data_block->data_size = 0;
+
+		return( -1 );
+	}
+	if( libpff_data_block_read_stored_data(
+	     data_block,
+	     data_size,
+	     file_type,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data block.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the data block
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_data_block_read_file_io_handle(
+     libpff_data_block_t *data_block,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     size32_t data_size,
+     uint8_t file_type,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_data_block_read_file_io_handle";
+	size_t stored_size    = 0;
+	ssize_t read_count    = 0;
+
+	if( data_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data block.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_block->data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid data block - data value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if UINT32_MAX > SSIZE_MAX
+	if( data_size > (size32_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libpff_data_block_get_stored_size(
+	     data_size,
+	     file_type,
+	     &stored_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine stored size.",
+		 function );
+
+		return( -1 );
+	}
+	if( stored_size == 0 )
+	{
+		return( 1 );
+	}
+	if( libpff_io_handle_check_read_limits(
+	     data_block->io_handle,
+	     stored_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_ABORT_REQUESTED,
+		 "%s: unable to read data block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		return( -1 );
+	}
+	data_block->data = (uint8_t *) memory_allocate(
+	                                sizeof( uint8_t ) * stored_size );
+
+	if( data_block->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data block data.",
+		 function );
+
+		goto on_error;
+	}
+	data_block->data_size = (uint32_t) stored_size;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading data block at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 function,
+		 file_offset,
+		 file_offset );
 	}
+#endif
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              file_io_handle,
+	              data_block->data,
+	              data_block->data_size,
+	              file_offset,
+	              error );
+
+	if( read_count != (ssize_t) data_block->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data block data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		goto on_error;
+	}
+	if( libpff_data_block_read_stored_data(
+	     data_block,
+	     data_size,
+	     file_type,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
 	if( data_block->data != NULL )
 	{
 		memory_free(
@@ -97,6 +97,26 @@ int libpff_data_block_read_footer_data(
      uint8_t file_type,
      libcerror_error_t **error );
 
+int libpff_data_block_get_stored_size(
+     size32_t data_size,
+     uint8_t file_type,
+     size_t *stored_size,
+     libcerror_error_t **error );
+
+int libpff_data_block_read_stored_data(
+     libpff_data_block_t *data_block,
+     size32_t data_size,
+     uint8_t file_type,
+     libcerror_error_t **error );
+
+int libpff_data_block_read_data(
+     libpff_data_block_t *data_block,
+     const uint8_t *stored_data,
+     size_t stored_data_size,
+     size32_t data_size,
+     uint8_t file_type,
+     libcerror_error_t **error );
+
 int libpff_data_block_read_file_io_handle(
      libpff_data_block_t *data_block,
      libbfio_handle_t *file_io_handle,
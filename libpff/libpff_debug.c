@@ -352,6 +352,15 @@ int libpff_debug_print_record_entry(
 	}
 	internal_record_entry = (libpff_internal_record_entry_t *) record_entry;
 
+	if( ( internal_record_entry->value_data == NULL )
+	 && ( internal_record_entry->value_data_list != NULL ) )
+	{
+		libcnotify_printf(
+		 "Deferred value data of size\t: %" PRIzd "\n\n",
+		 internal_record_entry->value_data_size );
+
+		return( 1 );
+	}
 	if( libpff_debug_property_type_value_print(
 	     name_to_id_map_list,
 	     internal_record_entry->identifier.entry_type,
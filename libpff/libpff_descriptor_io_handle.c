@@ -0,0 +1,1714 @@
+/*
+ * Descriptor IO handle functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libpff_definitions.h"
+#include "libpff_descriptor_io_handle.h"
+#include "libpff_libbfio.h"
+#include "libpff_libcerror.h"
+
+#if defined( LIBPFF_HAVE_DESCRIPTOR_IO_HANDLE )
+
+/* Creates a descriptor IO handle
+ * Make sure the value io_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_descriptor_io_handle_initialize(
+     libpff_descriptor_io_handle_t **io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_descriptor_io_handle_initialize";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*io_handle = memory_allocate_structure(
+	              libpff_descriptor_io_handle_t );
+
+	if( *io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *io_handle,
+	     0,
+	     sizeof( libpff_descriptor_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *io_handle )->descriptor        = -1;
+	( *io_handle )->direct_descriptor = -1;
+	( *io_handle )->access_hint_flags = LIBPFF_ACCESS_HINT_FLAG_ADVISE;
+	( *io_handle )->access_pattern    = LIBPFF_ACCESS_PATTERN_NORMAL;
+
+	return( 1 );
+
+on_error:
+	if( *io_handle != NULL )
+	{
+		memory_free(
+		 *io_handle );
+
+		*io_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a descriptor IO handle
+ * Returns 1 if succesful or -1 on error
+ */
+int libpff_descriptor_io_handle_free(
+     libpff_descriptor_io_handle_t **io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_descriptor_io_handle_free";
+	int result            = 1;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_handle != NULL )
+	{
+		if( ( *io_handle )->descriptor != -1 )
+		{
+			if( libpff_descriptor_io_handle_close(
+			     *io_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *io_handle )->direct_buffer_allocation != NULL )
+		{
+			memory_free(
+			 ( *io_handle )->direct_buffer_allocation );
+		}
+		if( ( *io_handle )->name != NULL )
+		{
+			memory_free(
+			 ( *io_handle )->name );
+		}
+		memory_free(
+		 *io_handle );
+
+		*io_handle = NULL;
+	}
+	return( result );
+}
+
+/* Clones (duplicates) the IO handle and its attributes
+ * The clone is not opened
+ * Returns 1 if succesful or -1 on error
+ */
+int libpff_descriptor_io_handle_clone(
+     libpff_descriptor_io_handle_t **destination_io_handle,
+     libpff_descriptor_io_handle_t *source_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_descriptor_io_handle_clone";
+
+	if( destination_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: destination IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_io_handle == NULL )
+	{
+		*destination_io_handle = NULL;
+
+		return( 1 );
+	}
+	if( libpff_descriptor_io_handle_initialize(
+	     destination_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( source_io_handle->name != NULL )
+	{
+		if( libpff_descriptor_io_handle_set_name(
+		     *destination_io_handle,
+		     source_io_handle->name,
+		     source_io_handle->name_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set name in destination IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	( *destination_io_handle )->direct_io_is_unsupported = source_io_handle->direct_io_is_unsupported;
+	( *destination_io_handle )->access_hint_flags        = source_io_handle->access_hint_flags;
+	( *destination_io_handle )->access_pattern           = source_io_handle->access_pattern;
+
+	return( 1 );
+
+on_error:
+	if( *destination_io_handle != NULL )
+	{
+		libpff_descriptor_io_handle_free(
+		 destination_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Sets the name
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_descriptor_io_handle_set_name(
+     libpff_descriptor_io_handle_t *io_handle,
+     const char *name,
+     size_t name_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_descriptor_io_handle_set_name";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid IO handle - already open.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name_size <= 1 )
+	 || ( name_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid name size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->name != NULL )
+	{
+		memory_free(
+		 io_handle->name );
+
+		io_handle->name      = NULL;
+		io_handle->name_size = 0;
+	}
+	io_handle->name = narrow_string_allocate(
+	                   name_size );
+
+	if( io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create name.",
+		 function );
+
+		goto on_error;
+	}
+	if( narrow_string_copy(
+	     io_handle->name,
+	     name,
+	     name_size - 1 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy name.",
+		 function );
+
+		goto on_error;
+	}
+	io_handle->name[ name_size - 1 ] = 0;
+
+	io_handle->name_size = name_size;
+
+	return( 1 );
+
+on_error:
+	if( io_handle->name != NULL )
+	{
+		memory_free(
+		 io_handle->name );
+
+		io_handle->name = NULL;
+	}
+	return( -1 );
+}
+
+/* Sets the access hint flags
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_descriptor_io_handle_set_access_hint_flags(
+     libpff_descriptor_io_handle_t *io_handle,
+     uint8_t access_hint_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_descriptor_io_handle_set_access_hint_flags";
+	int access_pattern    = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_hint_flags & ~( LIBPFF_ACCESS_HINT_FLAG_ADVISE | LIBPFF_ACCESS_HINT_FLAG_DROP_SCANNED_DATA | LIBPFF_ACCESS_HINT_FLAG_DIRECT_SCAN ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access hint flags: 0x%02" PRIx8 ".",
+		 function,
+		 access_hint_flags );
+
+		return( -1 );
+	}
+	/* The access pattern is left and entered again so that
+	 * the scan state matches the new flags
+	 */
+	access_pattern = io_handle->access_pattern;
+
+	if( libpff_descriptor_io_handle_set_access_pattern(
+	     io_handle,
+	     LIBPFF_ACCESS_PATTERN_NORMAL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to reset access pattern.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( access_hint_flags & LIBPFF_ACCESS_HINT_FLAG_DIRECT_SCAN ) == 0 )
+	 && ( io_handle->direct_descriptor != -1 ) )
+	{
+		if( libpff_descriptor_io_handle_close_direct(
+		     io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close direct IO descriptor.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	io_handle->access_hint_flags = access_hint_flags;
+
+	if( libpff_descriptor_io_handle_set_access_pattern(
+	     io_handle,
+	     access_pattern,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set access pattern.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the access pattern
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_descriptor_io_handle_get_access_pattern(
+     libpff_descriptor_io_handle_t *io_handle,
+     int *access_pattern,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_descriptor_io_handle_get_access_pattern";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( access_pattern == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid access pattern.",
+		 function );
+
+		return( -1 );
+	}
+	*access_pattern = io_handle->access_pattern;
+
+	return( 1 );
+}
+
+/* Sets the access pattern of the operations that follow
+ * When a scan ends the data it read is dropped from the page cache
+ * if requested by the access hint flags
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_descriptor_io_handle_set_access_pattern(
+     libpff_descriptor_io_handle_t *io_handle,
+     int access_pattern,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_descriptor_io_handle_set_access_pattern";
+	int result            = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_pattern != LIBPFF_ACCESS_PATTERN_NORMAL )
+	 && ( access_pattern != LIBPFF_ACCESS_PATTERN_RANDOM )
+	 && ( access_pattern != LIBPFF_ACCESS_PATTERN_SCAN ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access pattern: %d.",
+		 function,
+		 access_pattern );
+
+		return( -1 );
+	}
+	if( access_pattern == io_handle->access_pattern )
+	{
+		return( 1 );
+	}
+	if( io_handle->access_pattern == LIBPFF_ACCESS_PATTERN_SCAN )
+	{
+		if( libpff_descriptor_io_handle_drop_scanned_data(
+		     io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to drop scanned data.",
+			 function );
+
+			return( -1 );
+		}
+		/* The data in the direct IO buffer is not kept after the scan
+		 * since the file can be modified in the mean time
+		 */
+		io_handle->direct_buffer_data_size = 0;
+	}
+	io_handle->access_pattern = access_pattern;
+
+	if( io_handle->descriptor == -1 )
+	{
+		return( 1 );
+	}
+	if( ( access_pattern == LIBPFF_ACCESS_PATTERN_SCAN )
+	 && ( ( io_handle->access_hint_flags & LIBPFF_ACCESS_HINT_FLAG_DIRECT_SCAN ) != 0 )
+	 && ( io_handle->direct_descriptor == -1 )
+	 && ( io_handle->direct_io_is_unsupported == 0 ) )
+	{
+		result = libpff_descriptor_io_handle_open_direct(
+		          io_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open direct IO descriptor.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libpff_descriptor_io_handle_advise(
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to advise access pattern.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Passes the access pattern on to the operating system
+ * The advice is a hint, hence it not being applied is not considered an error
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_descriptor_io_handle_advise(
+     libpff_descriptor_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_descriptor_io_handle_advise";
+
+#if defined( HAVE_POSIX_FADVISE )
+	int advice            = 0;
+#endif
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_POSIX_FADVISE )
+	if( ( io_handle->access_hint_flags & LIBPFF_ACCESS_HINT_FLAG_ADVISE ) != 0 )
+	{
+		switch( io_handle->access_pattern )
+		{
+			case LIBPFF_ACCESS_PATTERN_RANDOM:
+				advice = POSIX_FADV_RANDOM;
+				break;
+
+			case LIBPFF_ACCESS_PATTERN_SCAN:
+				advice = POSIX_FADV_SEQUENTIAL;
+				break;
+
+			default:
+				advice = POSIX_FADV_NORMAL;
+				break;
+		}
+		posix_fadvise(
+		 io_handle->descriptor,
+		 0,
+		 0,
+		 advice );
+	}
+#endif /* defined( HAVE_POSIX_FADVISE ) */
+
+	return( 1 );
+}
+
+/* Drops the data read by the current scan from the page cache
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_descriptor_io_handle_drop_scanned_data(
+     libpff_descriptor_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_descriptor_io_handle_drop_scanned_data";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_POSIX_FADVISE )
+	if( ( io_handle->descriptor != -1 )
+	 && ( ( io_handle->access_hint_flags & LIBPFF_ACCESS_HINT_FLAG_DROP_SCANNED_DATA ) != 0 )
+	 && ( io_handle->scanned_end_offset > io_handle->scanned_start_offset ) )
+	{
+		posix_fadvise(
+		 io_handle->descriptor,
+		 (off_t) io_handle->scanned_start_offset,
+		 (off_t) ( io_handle->scanned_end_offset - io_handle->scanned_start_offset ),
+		 POSIX_FADV_DONTNEED );
+	}
+#endif /* defined( HAVE_POSIX_FADVISE ) */
+
+	io_handle->scanned_start_offset = 0;
+	io_handle->scanned_end_offset   = 0;
+
+	return( 1 );
+}
+
+/* Opens the direct IO descriptor used by scans
+ * Direct IO bypasses the page cache, it is considered unsupported
+ * if the file system does not allow it
+ * Returns 1 if successful, 0 if direct IO is not supported or -1 on error
+ */
+int libpff_descriptor_io_handle_open_direct(
+     libpff_descriptor_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_descriptor_io_handle_open_direct";
+
+#if defined( O_DIRECT )
+	size_t alignment_size = 0;
+	ssize_t read_count    = 0;
+	int open_flags        = 0;
+#endif
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->direct_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid IO handle - direct IO descriptor already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( O_DIRECT )
+	if( io_handle->direct_buffer_allocation == NULL )
+	{
+		/* Direct IO requires a buffer that is aligned to the block size
+		 */
+		io_handle->direct_buffer_allocation = (uint8_t *) memory_allocate(
+		                                                   LIBPFF_DESCRIPTOR_IO_HANDLE_DIRECT_BUFFER_SIZE + LIBPFF_DESCRIPTOR_IO_HANDLE_DIRECT_ALIGNMENT );
+
+		if( io_handle->direct_buffer_allocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create direct IO buffer.",
+			 function );
+
+			return( -1 );
+		}
+		alignment_size = (size_t) ( (intptr_t) io_handle->direct_buffer_allocation % LIBPFF_DESCRIPTOR_IO_HANDLE_DIRECT_ALIGNMENT );
+
+		if( alignment_size != 0 )
+		{
+			alignment_size = LIBPFF_DESCRIPTOR_IO_HANDLE_DIRECT_ALIGNMENT - alignment_size;
+		}
+		io_handle->direct_buffer = &( io_handle->direct_buffer_allocation[ alignment_size ] );
+	}
+	io_handle->direct_buffer_data_size = 0;
+
+	open_flags = O_RDONLY | O_DIRECT;
+
+#if defined( O_CLOEXEC )
+	open_flags |= O_CLOEXEC;
+#endif
+	io_handle->direct_descriptor = open(
+	                                io_handle->name,
+	                                open_flags );
+
+	if( io_handle->direct_descriptor != -1 )
+	{
+		/* Some file systems accept O_DIRECT on open but fail the reads
+		 */
+		do
+		{
+			read_count = pread(
+			              io_handle->direct_descriptor,
+			              io_handle->direct_buffer,
+			              LIBPFF_DESCRIPTOR_IO_HANDLE_DIRECT_ALIGNMENT,
+			              0 );
+		}
+		while( ( read_count == -1 )
+		    && ( errno == EINTR ) );
+
+		if( read_count != -1 )
+		{
+			return( 1 );
+		}
+		close(
+		 io_handle->direct_descriptor );
+
+		io_handle->direct_descriptor = -1;
+	}
+#endif /* defined( O_DIRECT ) */
+
+	io_handle->direct_io_is_unsupported = 1;
+
+	return( 0 );
+}
+
+/* Closes the direct IO descriptor
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_descriptor_io_handle_close_direct(
+     libpff_descriptor_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_descriptor_io_handle_close_direct";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle->direct_buffer_data_size = 0;
+
+	if( io_handle->direct_descriptor == -1 )
+	{
+		return( 1 );
+	}
+	if( close(
+	     io_handle->direct_descriptor ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close direct IO descriptor.",
+		 function );
+
+		io_handle->direct_descriptor = -1;
+
+		return( -1 );
+	}
+	io_handle->direct_descriptor = -1;
+
+	return( 1 );
+}
+
+/* Opens the IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_descriptor_io_handle_open(
+     libpff_descriptor_io_handle_t *io_handle,
+     int flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_descriptor_io_handle_open";
+	int error_code        = 0;
+	int open_flags        = 0;
+	int result            = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: IO handle already open.",
+		 function );
+
+		return( -1 );
+	}
+	/* Currently only support for reading data
+	 */
+	if( ( ( flags & LIBBFIO_ACCESS_FLAG_READ ) == 0 )
+	 || ( ( flags & ~( LIBBFIO_ACCESS_FLAG_READ ) ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported flags.",
+		 function );
+
+		return( -1 );
+	}
+	open_flags = O_RDONLY;
+
+#if defined( O_CLOEXEC )
+	open_flags |= O_CLOEXEC;
+#endif
+	io_handle->descriptor = open(
+	                         io_handle->name,
+	                         open_flags );
+
+	if( io_handle->descriptor == -1 )
+	{
+		error_code = errno;
+
+		switch( error_code )
+		{
+			case EACCES:
+				libcerror_system_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_ACCESS_DENIED,
+				 error_code,
+				 "%s: access denied to file: %s.",
+				 function,
+				 io_handle->name );
+
+				break;
+
+			case ENOENT:
+				libcerror_system_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_INVALID_RESOURCE,
+				 error_code,
+				 "%s: no such file: %s.",
+				 function,
+				 io_handle->name );
+
+				break;
+
+			default:
+				libcerror_system_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 error_code,
+				 "%s: unable to open file: %s.",
+				 function,
+				 io_handle->name );
+
+				break;
+		}
+		return( -1 );
+	}
+	io_handle->access_flags         = flags;
+	io_handle->current_offset       = 0;
+	io_handle->scanned_start_offset = 0;
+	io_handle->scanned_end_offset   = 0;
+
+	if( ( io_handle->access_pattern == LIBPFF_ACCESS_PATTERN_SCAN )
+	 && ( ( io_handle->access_hint_flags & LIBPFF_ACCESS_HINT_FLAG_DIRECT_SCAN ) != 0 )
+	 && ( io_handle->direct_io_is_unsupported == 0 ) )
+	{
+		result = libpff_descriptor_io_handle_open_direct(
+		          io_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open direct IO descriptor.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libpff_descriptor_io_handle_advise(
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to advise access pattern.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	libpff_descriptor_io_handle_close_direct(
+	 io_handle,
+	 NULL );
+
+	close(
+	 io_handle->descriptor );
+
+	io_handle->descriptor = -1;
+
+	return( -1 );
+}
+
+/* Closes the IO handle
+ * Returns 0 if successful or -1 on error
+ */
+int libpff_descriptor_io_handle_close(
+     libpff_descriptor_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_descriptor_io_handle_close";
+	int result            = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_descriptor_io_handle_drop_scanned_data(
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to drop scanned data.",
+		 function );
+
+		result = -1;
+	}
+	if( libpff_descriptor_io_handle_close_direct(
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close direct IO descriptor.",
+		 function );
+
+		result = -1;
+	}
+	if( close(
+	     io_handle->descriptor ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close file.",
+		 function );
+
+		result = -1;
+	}
+	io_handle->descriptor = -1;
+
+	return( result );
+}
+
+/* Reads a buffer from the IO handle using the direct IO descriptor
+ * The data is read in aligned blocks into the direct IO buffer
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libpff_descriptor_io_handle_read_direct(
+         libpff_descriptor_io_handle_t *io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function      = "libpff_descriptor_io_handle_read_direct";
+	size_t buffer_offset       = 0;
+	size_t direct_buffer_index = 0;
+	size_t read_size           = 0;
+	ssize_t read_count         = 0;
+	off64_t aligned_offset     = 0;
+	off64_t read_offset        = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->direct_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing direct IO descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+		read_offset = io_handle->current_offset + (off64_t) buffer_offset;
+
+		if( ( read_offset < io_handle->direct_buffer_offset )
+		 || ( read_offset >= ( io_handle->direct_buffer_offset + (off64_t) io_handle->direct_buffer_data_size ) ) )
+		{
+			aligned_offset = read_offset - ( read_offset % LIBPFF_DESCRIPTOR_IO_HANDLE_DIRECT_ALIGNMENT );
+
+			do
+			{
+				read_count = pread(
+				              io_handle->direct_descriptor,
+				              io_handle->direct_buffer,
+				              LIBPFF_DESCRIPTOR_IO_HANDLE_DIRECT_BUFFER_SIZE,
+				              (off_t) aligned_offset );
+			}
+			while( ( read_count == -1 )
+			    && ( errno == EINTR ) );
+
+			if( read_count == -1 )
+			{
+				libcerror_system_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 errno,
+				 "%s: unable to read from file at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 aligned_offset,
+				 aligned_offset );
+
+				io_handle->direct_buffer_data_size = 0;
+
+				return( -1 );
+			}
+			io_handle->direct_buffer_offset    = aligned_offset;
+			io_handle->direct_buffer_data_size = (size_t) read_count;
+
+			if( read_offset >= ( aligned_offset + (off64_t) read_count ) )
+			{
+				break;
+			}
+		}
+		direct_buffer_index = (size_t) ( read_offset - io_handle->direct_buffer_offset );
+		read_size           = io_handle->direct_buffer_data_size - direct_buffer_index;
+
+		if( read_size > ( size - buffer_offset ) )
+		{
+			read_size = size - buffer_offset;
+		}
+		if( memory_copy(
+		     &( buffer[ buffer_offset ] ),
+		     &( io_handle->direct_buffer[ direct_buffer_index ] ),
+		     read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy direct IO buffer data.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_offset += read_size;
+	}
+	io_handle->current_offset += (off64_t) buffer_offset;
+
+	return( (ssize_t) buffer_offset );
+}
+
+/* Reads a buffer from the IO handle
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libpff_descriptor_io_handle_read(
+         libpff_descriptor_io_handle_t *io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libpff_descriptor_io_handle_read";
+	size_t buffer_offset  = 0;
+	ssize_t read_count    = 0;
+	off64_t read_offset   = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( io_handle->access_flags & LIBBFIO_ACCESS_FLAG_READ ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - no read access.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( io_handle->access_pattern == LIBPFF_ACCESS_PATTERN_SCAN )
+	 && ( io_handle->direct_descriptor != -1 ) )
+	{
+		read_count = libpff_descriptor_io_handle_read_direct(
+		              io_handle,
+		              buffer,
+		              size,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read using direct IO.",
+			 function );
+
+			return( -1 );
+		}
+		return( read_count );
+	}
+	read_offset = io_handle->current_offset;
+
+	while( buffer_offset < size )
+	{
+		read_count = pread(
+		              io_handle->descriptor,
+		              &( buffer[ buffer_offset ] ),
+		              size - buffer_offset,
+		              (off_t) ( read_offset + (off64_t) buffer_offset ) );
+
+		if( read_count == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 errno,
+			 "%s: unable to read from file at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 read_offset + (off64_t) buffer_offset,
+			 read_offset + (off64_t) buffer_offset );
+
+			return( -1 );
+		}
+		else if( read_count == 0 )
+		{
+			break;
+		}
+		buffer_offset += (size_t) read_count;
+	}
+	io_handle->current_offset += (off64_t) buffer_offset;
+
+	if( ( io_handle->access_pattern == LIBPFF_ACCESS_PATTERN_SCAN )
+	 && ( ( io_handle->access_hint_flags & LIBPFF_ACCESS_HINT_FLAG_DROP_SCANNED_DATA ) != 0 )
+	 && ( buffer_offset > 0 ) )
+	{
+		/* The scanned data is tracked as a single range that is dropped
+		 * from the page cache once it grows large enough
+		 */
+		if( io_handle->scanned_end_offset <= io_handle->scanned_start_offset )
+		{
+			io_handle->scanned_start_offset = read_offset;
+			io_handle->scanned_end_offset   = io_handle->current_offset;
+		}
+		else
+		{
+			if( read_offset < io_handle->scanned_start_offset )
+			{
+				io_handle->scanned_start_offset = read_offset;
+			}
+			if( io_handle->current_offset > io_handle->scanned_end_offset )
+			{
+				io_handle->scanned_end_offset = io_handle->current_offset;
+			}
+		}
+		if( ( io_handle->scanned_end_offset - io_handle->scanned_start_offset ) >= LIBPFF_DESCRIPTOR_IO_HANDLE_DROP_BEHIND_SIZE )
+		{
+			if( libpff_descriptor_io_handle_drop_scanned_data(
+			     io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to drop scanned data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Writes a buffer to the IO handle
+ * Returns the number of bytes written if successful, or -1 on error
+ */
+ssize_t libpff_descriptor_io_handle_write(
+         libpff_descriptor_io_handle_t *io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libpff_descriptor_io_handle_write";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( io_handle->access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - no write access.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/* Seeks a certain offset within the IO handle
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t libpff_descriptor_io_handle_seek_offset(
+         libpff_descriptor_io_handle_t *io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libpff_descriptor_io_handle_seek_offset";
+	size64_t size         = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += io_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		if( libpff_descriptor_io_handle_get_size(
+		     io_handle,
+		     &size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve size.",
+			 function );
+
+			return( -1 );
+		}
+		offset += (off64_t) size;
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Function to determine if the file exists
+ * Returns 1 if the file exists, 0 if not or -1 on error
+ */
+int libpff_descriptor_io_handle_exists(
+     libpff_descriptor_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	struct stat file_statistics;
+
+	static char *function = "libpff_descriptor_io_handle_exists";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( stat(
+	     io_handle->name,
+	     &file_statistics ) != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Check if the IO handle is open
+ * Returns 1 if open, 0 if not or -1 on error
+ */
+int libpff_descriptor_io_handle_is_open(
+     libpff_descriptor_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_descriptor_io_handle_is_open";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->descriptor == -1 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the file size
+ * The size is determined on every call since the file can still be written to
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_descriptor_io_handle_get_size(
+     libpff_descriptor_io_handle_t *io_handle,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	struct stat file_statistics;
+
+	static char *function = "libpff_descriptor_io_handle_get_size";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( fstat(
+	     io_handle->descriptor,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 errno,
+		 "%s: unable to retrieve file statistics.",
+		 function );
+
+		return( -1 );
+	}
+	*size = (size64_t) file_statistics.st_size;
+
+	return( 1 );
+}
+
+#endif /* defined( LIBPFF_HAVE_DESCRIPTOR_IO_HANDLE ) */
+
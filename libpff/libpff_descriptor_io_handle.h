@@ -0,0 +1,212 @@
+/*
+ * Descriptor IO handle functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPFF_DESCRIPTOR_IO_HANDLE_H )
+#define _LIBPFF_DESCRIPTOR_IO_HANDLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libpff_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if !defined( WINAPI ) && defined( HAVE_FCNTL_H ) && defined( HAVE_SYS_STAT_H ) && defined( HAVE_UNISTD_H ) && defined( HAVE_FSTAT ) && defined( HAVE_PREAD )
+#define LIBPFF_HAVE_DESCRIPTOR_IO_HANDLE	1
+#endif
+
+#if defined( LIBPFF_HAVE_DESCRIPTOR_IO_HANDLE )
+
+typedef struct libpff_descriptor_io_handle libpff_descriptor_io_handle_t;
+
+/* The descriptor IO handle reads a file using a file descriptor
+ * that is owned by the library, so that the access pattern of
+ * the current operation can be passed on to the operating system
+ */
+struct libpff_descriptor_io_handle
+{
+	/* The name
+	 */
+	char *name;
+
+	/* The name size
+	 */
+	size_t name_size;
+
+	/* The file descriptor
+	 */
+	int descriptor;
+
+	/* The file descriptor opened for direct IO, used by scans
+	 */
+	int direct_descriptor;
+
+	/* Value to indicate direct IO is not supported for the file
+	 */
+	uint8_t direct_io_is_unsupported;
+
+	/* The current access flags
+	 */
+	int access_flags;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+	/* The access hint flags
+	 */
+	uint8_t access_hint_flags;
+
+	/* The access pattern
+	 */
+	int access_pattern;
+
+	/* The start offset of the scanned data that has not been dropped from the page cache
+	 */
+	off64_t scanned_start_offset;
+
+	/* The end offset of the scanned data that has not been dropped from the page cache
+	 */
+	off64_t scanned_end_offset;
+
+	/* The direct IO buffer allocation
+	 */
+	uint8_t *direct_buffer_allocation;
+
+	/* The direct IO buffer, aligned within the allocation
+	 */
+	uint8_t *direct_buffer;
+
+	/* The offset of the data in the direct IO buffer
+	 */
+	off64_t direct_buffer_offset;
+
+	/* The size of the data in the direct IO buffer
+	 */
+	size_t direct_buffer_data_size;
+};
+
+int libpff_descriptor_io_handle_initialize(
+     libpff_descriptor_io_handle_t **io_handle,
+     libcerror_error_t **error );
+
+int libpff_descriptor_io_handle_free(
+     libpff_descriptor_io_handle_t **io_handle,
+     libcerror_error_t **error );
+
+int libpff_descriptor_io_handle_clone(
+     libpff_descriptor_io_handle_t **destination_io_handle,
+     libpff_descriptor_io_handle_t *source_io_handle,
+     libcerror_error_t **error );
+
+int libpff_descriptor_io_handle_set_name(
+     libpff_descriptor_io_handle_t *io_handle,
+     const char *name,
+     size_t name_size,
+     libcerror_error_t **error );
+
+int libpff_descriptor_io_handle_set_access_hint_flags(
+     libpff_descriptor_io_handle_t *io_handle,
+     uint8_t access_hint_flags,
+     libcerror_error_t **error );
+
+int libpff_descriptor_io_handle_get_access_pattern(
+     libpff_descriptor_io_handle_t *io_handle,
+     int *access_pattern,
+     libcerror_error_t **error );
+
+int libpff_descriptor_io_handle_set_access_pattern(
+     libpff_descriptor_io_handle_t *io_handle,
+     int access_pattern,
+     libcerror_error_t **error );
+
+int libpff_descriptor_io_handle_advise(
+     libpff_descriptor_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+int libpff_descriptor_io_handle_drop_scanned_data(
+     libpff_descriptor_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+int libpff_descriptor_io_handle_open_direct(
+     libpff_descriptor_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+int libpff_descriptor_io_handle_close_direct(
+     libpff_descriptor_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+int libpff_descriptor_io_handle_open(
+     libpff_descriptor_io_handle_t *io_handle,
+     int flags,
+     libcerror_error_t **error );
+
+int libpff_descriptor_io_handle_close(
+     libpff_descriptor_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+ssize_t libpff_descriptor_io_handle_read_direct(
+         libpff_descriptor_io_handle_t *io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t libpff_descriptor_io_handle_read(
+         libpff_descriptor_io_handle_t *io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t libpff_descriptor_io_handle_write(
+         libpff_descriptor_io_handle_t *io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+off64_t libpff_descriptor_io_handle_seek_offset(
+         libpff_descriptor_io_handle_t *io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
+int libpff_descriptor_io_handle_exists(
+     libpff_descriptor_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+int libpff_descriptor_io_handle_is_open(
+     libpff_descriptor_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+int libpff_descriptor_io_handle_get_size(
+     libpff_descriptor_io_handle_t *io_handle,
+     size64_t *size,
+     libcerror_error_t **error );
+
+#endif /* defined( LIBPFF_HAVE_DESCRIPTOR_IO_HANDLE ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPFF_DESCRIPTOR_IO_HANDLE_H ) */
+
@@ -32,6 +32,7 @@
 #include "libpff_libcerror.h"
 #include "libpff_libfcache.h"
 #include "libpff_libfdata.h"
+#include "libpff_recovered_index.h"
 
 /* Creates a descriptors index
  * Make sure the value descriptors_index is referencing, is set to NULL
@@ -163,17 +164,17 @@ int libpff_descriptors_index_free(
 				result = -1;
 			}
 		}
-		if( ( *descriptors_index )->recovered_index_tree != NULL )
+		if( ( *descriptors_index )->recovered_index != NULL )
 		{
-			if( libpff_index_tree_free(
-			     &( ( *descriptors_index )->recovered_index_tree ),
+			if( libpff_recovered_index_free(
+			     &( ( *descriptors_index )->recovered_index ),
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free recovered index tree.",
+				 "%s: unable to free recovered index.",
 				 function );
 
 				result = -1;
@@ -268,39 +269,16 @@ int libpff_descriptors_index_set_root_node(
 	}
 	else
 	{
-		if( libpff_index_tree_initialize(
-		     &( descriptors_index->recovered_index_tree ),
-		     descriptors_index->io_handle,
-		     descriptors_index->index_nodes_vector,
-		     descriptors_index->index_nodes_cache,
+		if( libpff_recovered_index_initialize(
+		     &( descriptors_index->recovered_index ),
 		     LIBPFF_INDEX_TYPE_DESCRIPTOR,
-		     0,
-		     0,
-		     recovered,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create index tree.",
-			 function );
-
-			goto on_error;
-		}
-		/* Point the root node data offset to LIBPFF_RECOVERED_DESCRIPTOR_INDEX_TREE_ROOT_OFFSET
-		 * otherwise it will mess up the caching of the first index value
-		 */
-		if( libpff_index_tree_set_root_node(
-		     descriptors_index->recovered_index_tree,
-		     LIBPFF_RECOVERED_DESCRIPTOR_INDEX_TREE_ROOT_OFFSET,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set recovered index tree root node.",
+			 "%s: unable to create recovered index.",
 			 function );
 
 			goto on_error;
@@ -337,16 +315,81 @@ on_error:
 	}
 	else
 	{
-		if( descriptors_index->recovered_index_tree != NULL )
+		if( descriptors_index->recovered_index != NULL )
 		{
-			libpff_index_tree_free(
-			 &( descriptors_index->recovered_index_tree ),
+			libpff_recovered_index_free(
+			 &( descriptors_index->recovered_index ),
 			 NULL );
 		}
 	}
 	return( -1 );
 }
 
+/* Swaps the root node with that of another descriptors index
+ * The index tree, the cached index values and the recovered index are swapped,
+ * the index nodes vector and cache are shared. This allows to replace the root
+ * node of an index that is referenced elsewhere, at a point where nothing can fail
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_descriptors_index_swap_root_node(
+     libpff_descriptors_index_t *descriptors_index,
+     libpff_descriptors_index_t *other_descriptors_index,
+     libcerror_error_t **error )
+{
+	libfcache_cache_t *index_cache            = NULL;
+	libpff_index_tree_t *index_tree           = NULL;
+	libpff_recovered_index_t *recovered_index = NULL;
+	static char *function                     = "libpff_descriptors_index_swap_root_node";
+
+	if( descriptors_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid descriptors index.",
+		 function );
+
+		return( -1 );
+	}
+	if( other_descriptors_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid other descriptors index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( descriptors_index->index_nodes_vector != other_descriptors_index->index_nodes_vector )
+	 || ( descriptors_index->index_nodes_cache != other_descriptors_index->index_nodes_cache ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid other descriptors index - index nodes vector and cache are not shared.",
+		 function );
+
+		return( -1 );
+	}
+	index_tree                          = descriptors_index->index_tree;
+	descriptors_index->index_tree       = other_descriptors_index->index_tree;
+	other_descriptors_index->index_tree = index_tree;
+
+	recovered_index                          = descriptors_index->recovered_index;
+	descriptors_index->recovered_index       = other_descriptors_index->recovered_index;
+	other_descriptors_index->recovered_index = recovered_index;
+
+	index_cache                          = descriptors_index->index_cache;
+	descriptors_index->index_cache       = other_descriptors_index->index_cache;
+	other_descriptors_index->index_cache = index_cache;
+
+	return( 1 );
+}
+
 /* Retrieves an index value for a specific identifier
  * Returns 1 if successful, 0 if no index value was found or -1 on error
  */
@@ -358,9 +401,8 @@ int libpff_descriptors_index_get_index_value_by_identifier(
      libpff_index_value_t **index_value,
      libcerror_error_t **error )
 {
-	static char *function      = "libpff_descriptors_index_get_index_value_by_identifier";
-	int number_of_index_values = 0;
-	int result                 = 0;
+	static char *function = "libpff_descriptors_index_get_index_value_by_identifier";
+	int result            = 0;
 
 	if( descriptors_index == NULL )
 	{
@@ -399,30 +441,10 @@ int libpff_descriptors_index_get_index_value_by_identifier(
 	}
 	else
 	{
-		if( libpff_index_tree_get_number_of_leaf_nodes_by_identifier(
-		     descriptors_index->recovered_index_tree,
-		     file_io_handle,
-		     descriptors_index->index_cache,
-		     descriptor_identifier,
-		     &number_of_index_values,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve number of recovered index values for identifier: %" PRIu32 ".",
-			 function,
-			 descriptor_identifier );
-
-			return( -1 );
-		}
 /* TODO is it necessary to lookup removed descriptors with a value index > 0 ? */
-		result = libpff_index_tree_get_value_by_identifier(
-			  descriptors_index->recovered_index_tree,
-			  file_io_handle,
-			  descriptors_index->index_cache,
-			  descriptor_identifier,
+		result = libpff_recovered_index_get_index_value_by_identifier(
+			  descriptors_index->recovered_index,
+			  (uint64_t) descriptor_identifier,
 			  0,
 			  index_value,
 			  error );
@@ -31,6 +31,7 @@
 #include "libpff_libcerror.h"
 #include "libpff_libfcache.h"
 #include "libpff_libfdata.h"
+#include "libpff_recovered_index.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -56,9 +57,9 @@ struct libpff_descriptors_index
 	 */
 	libpff_index_tree_t *index_tree;
 
-	/* The recovered index tree
+	/* The recovered index
 	 */
-	libpff_index_tree_t *recovered_index_tree;
+	libpff_recovered_index_t *recovered_index;
 
 	/* The index cache
 	 */
@@ -83,6 +84,11 @@ int libpff_descriptors_index_set_root_node(
      uint8_t recovered,
      libcerror_error_t **error );
 
+int libpff_descriptors_index_swap_root_node(
+     libpff_descriptors_index_t *descriptors_index,
+     libpff_descriptors_index_t *other_descriptors_index,
+     libcerror_error_t **error );
+
 int libpff_descriptors_index_get_index_value_by_identifier(
      libpff_descriptors_index_t *descriptors_index,
      libbfio_handle_t *file_io_handle,
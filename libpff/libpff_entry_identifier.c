@@ -0,0 +1,232 @@
+/*
+ * Entry identifier functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libpff_entry_identifier.h"
+#include "libpff_libcerror.h"
+
+/* Retrieves the values of the entry identifier header
+ * The header consists of 32-bit flags and a service provider identifier (GUID)
+ * The service provider identifier is copied as stored
+ * Returns 1 if successful, 0 if the data is too small to contain an entry identifier or -1 on error
+ */
+int libpff_entry_identifier_get_header_values(
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t *flags,
+     uint8_t *service_provider_identifier,
+     size_t service_provider_identifier_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_entry_identifier_get_header_values";
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( service_provider_identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid service provider identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( service_provider_identifier_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: service provider identifier size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( service_provider_identifier_size < 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: service provider identifier size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size < 20 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 data,
+	 *flags );
+
+	if( memory_copy(
+	     service_provider_identifier,
+	     &( data[ 4 ] ),
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy service provider identifier.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the item identifier of a PFF message store entry identifier
+ * This type of entry identifier consists of the header followed by
+ * the 32-bit (descriptor) identifier of the item in the same file
+ * The service provider identifier of the header must match the record key of the message store
+ * Returns 1 if successful, 0 if the data is not a message store entry identifier of the store or -1 on error
+ */
+int libpff_entry_identifier_get_item_identifier(
+     const uint8_t *data,
+     size_t data_size,
+     const uint8_t *record_key,
+     size_t record_key_size,
+     uint32_t *item_identifier,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_entry_identifier_get_item_identifier";
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record key.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_key_size != 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: record key size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( item_identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item identifier.",
+		 function );
+
+		return( -1 );
+	}
+	/* The flags of a message store entry identifier are always 0
+	 */
+	if( ( data_size != 24 )
+	 || ( data[ 0 ] != 0 )
+	 || ( data[ 1 ] != 0 )
+	 || ( data[ 2 ] != 0 )
+	 || ( data[ 3 ] != 0 ) )
+	{
+		return( 0 );
+	}
+	/* An entry identifier of another message store refers to an item in another file
+	 */
+	if( memory_compare(
+	     &( data[ 4 ] ),
+	     record_key,
+	     16 ) != 0 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 &( data[ 20 ] ),
+	 *item_identifier );
+
+	return( 1 );
+}
+
@@ -0,0 +1,55 @@
+/*
+ * Entry identifier functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPFF_ENTRY_IDENTIFIER_H )
+#define _LIBPFF_ENTRY_IDENTIFIER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libpff_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+int libpff_entry_identifier_get_header_values(
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t *flags,
+     uint8_t *service_provider_identifier,
+     size_t service_provider_identifier_size,
+     libcerror_error_t **error );
+
+int libpff_entry_identifier_get_item_identifier(
+     const uint8_t *data,
+     size_t data_size,
+     const uint8_t *record_key,
+     size_t record_key_size,
+     uint32_t *item_identifier,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPFF_ENTRY_IDENTIFIER_H ) */
+
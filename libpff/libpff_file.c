@@ -25,6 +25,9 @@
 #include <types.h>
 #include <wide_string.h>
 
+#include "libpff_allocation_statistics.h"
+#include "libpff_caller_io_handle.h"
+#include "libpff_caller_open_state.h"
 #include "libpff_codepage.h"
 #include "libpff_debug.h"
 #include "libpff_definitions.h"
@@ -32,19 +35,31 @@
 #include "libpff_file.h"
 #include "libpff_file_header.h"
 #include "libpff_folder.h"
+#include "libpff_index_layout.h"
+#include "libpff_index_node.h"
+#include "libpff_index_tree.h"
+#include "libpff_index_value.h"
 #include "libpff_io_handle.h"
 #include "libpff_item.h"
 #include "libpff_item_descriptor.h"
 #include "libpff_item_tree.h"
+#include "libpff_item_tree_update.h"
+#include "libpff_item_visitor.h"
 #include "libpff_libbfio.h"
 #include "libpff_libcdata.h"
 #include "libpff_libcerror.h"
 #include "libpff_libcnotify.h"
 #include "libpff_libfcache.h"
 #include "libpff_libfdata.h"
+#include "libpff_local_descriptor_node.h"
+#include "libpff_local_descriptor_nodes_cache.h"
 #include "libpff_name_to_id_map.h"
 #include "libpff_offsets_index.h"
+#include "libpff_open_worker.h"
+#include "libpff_property_set.h"
 #include "libpff_recover.h"
+#include "libpff_table.h"
+#include "libpff_table_cache.h"
 #include "libpff_types.h"
 
 /* Creates a file
@@ -121,6 +136,8 @@ int libpff_file_initialize(
 
 		goto on_error;
 	}
+	internal_file->access_hint_flags = 0;
+
 	*file = (libpff_file_t *) internal_file;
 
 	return( 1 );
@@ -178,6 +195,39 @@ int libpff_file_free(
 		}
 		*file = NULL;
 
+		if( internal_file->caller_file_io_handle != NULL )
+		{
+			/* Free the values of a caller driven open that was not completed
+			 */
+			if( libpff_internal_file_free_open_values(
+			     internal_file,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free open values.",
+				 function );
+
+				result = -1;
+			}
+			internal_file->io_handle->caller_io_handle = NULL;
+
+			if( libbfio_handle_free(
+			     &( internal_file->caller_file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free caller file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( libpff_io_handle_free(
 		     &( internal_file->io_handle ),
 		     error ) != 1 )
@@ -236,19 +286,18 @@ int libpff_file_signal_abort(
 	return( 1 );
 }
 
-/* Opens a file
+/* Sets the deadline of the file
+ * The timeout is in milliseconds from now, 0 removes the deadline.
+ * Once the deadline has passed reading a block fails
  * Returns 1 if successful or -1 on error
  */
-int libpff_file_open(
+int libpff_file_set_deadline(
      libpff_file_t *file,
-     const char *filename,
-     int access_flags,
+     uint32_t timeout,
      libcerror_error_t **error )
 {
-	libbfio_handle_t *file_io_handle      = NULL;
 	libpff_internal_file_t *internal_file = NULL;
-	static char *function                 = "libpff_file_open";
-	size_t filename_length                = 0;
+	static char *function                 = "libpff_file_set_deadline";
 
 	if( file == NULL )
 	{
@@ -263,109 +312,83 @@ int libpff_file_open(
 	}
 	internal_file = (libpff_internal_file_t *) file;
 
-	if( filename == NULL )
+	if( libpff_io_handle_set_deadline(
+	     internal_file->io_handle,
+	     timeout,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid filename.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set deadline in IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( libbfio_file_initialize(
-	     &file_io_handle,
-	     error ) != 1 )
+	return( 1 );
+}
+
+/* Sets the read budget of the file
+ * The budget is the maximum number of bytes and blocks that can be read from now,
+ * a value of 0 removes the corresponding limit.
+ * Once the budget is used up reading a block fails
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_file_set_read_budget(
+     libpff_file_t *file,
+     size64_t maximum_read_size,
+     uint32_t maximum_number_of_read_blocks,
+     libcerror_error_t **error )
+{
+	libpff_internal_file_t *internal_file = NULL;
+	static char *function                 = "libpff_file_set_read_budget";
+
+	if( file == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
 		 function );
 
-		goto on_error;
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libbfio_handle_set_track_offsets_read(
-	     file_io_handle,
-	     1,
-	     error ) != 1 )
-	{
-                libcerror_error_set(
-                 error,
-                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-                 "%s: unable to set track offsets read in file IO handle.",
-                 function );
-
-		goto on_error;
+		return( -1 );
 	}
-#endif
-	filename_length = narrow_string_length(
-	                   filename );
-
-	if( libbfio_file_set_name(
-	     file_io_handle,
-	     filename,
-	     filename_length + 1,
-	     error ) != 1 )
-	{
-                libcerror_error_set(
-                 error,
-                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-                 "%s: unable to set filename in file IO handle.",
-                 function );
+	internal_file = (libpff_internal_file_t *) file;
 
-		goto on_error;
-	}
-	if( libpff_file_open_file_io_handle(
-	     file,
-	     file_io_handle,
-	     access_flags,
+	if( libpff_io_handle_set_read_budget(
+	     internal_file->io_handle,
+	     maximum_read_size,
+	     maximum_number_of_read_blocks,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open file: %s.",
-		 function,
-		 filename );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set read budget in IO handle.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	internal_file->file_io_handle_created_in_library = 1;
-
 	return( 1 );
-
-on_error:
-	if( file_io_handle != NULL )
-	{
-		libbfio_handle_free(
-		 &file_io_handle,
-		 NULL );
-	}
-	return( -1 );
 }
 
-#if defined( HAVE_WIDE_CHARACTER_TYPE )
-
-/* Opens a file
+/* Retrieves the read statistics of the file
+ * The statistics are the number of bytes and blocks read and the number of blocks decompressed
+ * since the file was opened
  * Returns 1 if successful or -1 on error
  */
-int libpff_file_open_wide(
+int libpff_file_get_read_statistics(
      libpff_file_t *file,
-     const wchar_t *filename,
-     int access_flags,
+     size64_t *read_size,
+     uint64_t *number_of_read_blocks,
+     uint64_t *number_of_decompressed_blocks,
      libcerror_error_t **error )
 {
-	libbfio_handle_t *file_io_handle      = NULL;
 	libpff_internal_file_t *internal_file = NULL;
-	static char *function                 = "libpff_file_open_wide";
-	size_t filename_length                = 0;
+	static char *function                 = "libpff_file_get_read_statistics";
 
 	if( file == NULL )
 	{
@@ -380,109 +403,71 @@ int libpff_file_open_wide(
 	}
 	internal_file = (libpff_internal_file_t *) file;
 
-	if( filename == NULL )
+	if( internal_file->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid filename.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( libbfio_file_initialize(
-	     &file_io_handle,
-	     error ) != 1 )
+	if( read_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read size.",
 		 function );
 
-		goto on_error;
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libbfio_handle_set_track_offsets_read(
-	     file_io_handle,
-	     1,
-	     error ) != 1 )
-	{
-                libcerror_error_set(
-                 error,
-                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-                 "%s: unable to set track offsets read in file IO handle.",
-                 function );
-
-		goto on_error;
+		return( -1 );
 	}
-#endif
-	filename_length = wide_string_length(
-	                   filename );
-
-	if( libbfio_file_set_name_wide(
-	     file_io_handle,
-	     filename,
-	     filename_length + 1,
-	     error ) != 1 )
+	if( number_of_read_blocks == NULL )
 	{
-                libcerror_error_set(
-                 error,
-                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-                 "%s: unable to set filename in file IO handle.",
-                 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of read blocks.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libpff_file_open_file_io_handle(
-	     file,
-	     file_io_handle,
-	     access_flags,
-	     error ) != 1 )
+	if( number_of_decompressed_blocks == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open file: %ls.",
-		 function,
-		 filename );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of decompressed blocks.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	internal_file->file_io_handle_created_in_library = 1;
+	*read_size                     = internal_file->io_handle->total_read_size;
+	*number_of_read_blocks         = internal_file->io_handle->total_number_of_read_blocks;
+	*number_of_decompressed_blocks = internal_file->io_handle->total_number_of_decompressed_blocks;
 
 	return( 1 );
-
-on_error:
-	if( file_io_handle != NULL )
-	{
-		libbfio_handle_free(
-		 &file_io_handle,
-		 NULL );
-	}
-	return( -1 );
 }
 
-#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
-
-/* Opens a file using a Basic File IO (bfio) handle
+/* Sets if the file should be opened using multiple threads
+ * When set the name to ID map is read and the offsets index is prefetched
+ * on a separate thread while the item tree is created. The descriptors index
+ * is read in shards on separate threads after which the items are linked
+ * to their parent folder.
  * Returns 1 if successful or -1 on error
  */
-int libpff_file_open_file_io_handle(
+int libpff_file_set_parallel_open(
      libpff_file_t *file,
-     libbfio_handle_t *file_io_handle,
-     int access_flags,
+     uint8_t parallel_open,
      libcerror_error_t **error )
 {
 	libpff_internal_file_t *internal_file = NULL;
-	static char *function                 = "libpff_file_open_file_io_handle";
-	int bfio_access_flags                 = 0;
-	int file_io_handle_is_open            = 0;
+	static char *function                 = "libpff_file_set_parallel_open";
 
 	if( file == NULL )
 	{
@@ -497,131 +482,104 @@ int libpff_file_open_file_io_handle(
 	}
 	internal_file = (libpff_internal_file_t *) file;
 
-	if( internal_file->file_io_handle != NULL )
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( parallel_open != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file - file IO handle already set.",
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading is not supported.",
 		 function );
 
 		return( -1 );
 	}
-	if( file_io_handle == NULL )
+#endif
+	internal_file->parallel_open = parallel_open;
+
+	return( 1 );
+}
+
+/* Sets the access hint flags
+ * The access hints are passed on to the operating system for a file opened by name
+ * after the access hint flags were set
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_file_set_access_hint_flags(
+     libpff_file_t *file,
+     uint8_t access_hint_flags,
+     libcerror_error_t **error )
+{
+	libpff_internal_file_t *internal_file = NULL;
+	static char *function                 = "libpff_file_set_access_hint_flags";
+
+	if( file == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file IO handle.",
+		 "%s: invalid file.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( ( access_flags & LIBPFF_ACCESS_FLAG_READ ) == 0 )
-	 && ( ( access_flags & LIBPFF_ACCESS_FLAG_WRITE ) == 0 ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported access flags.",
-		 function );
+	internal_file = (libpff_internal_file_t *) file;
 
-		return( -1 );
-	}
-	if( ( access_flags & LIBPFF_ACCESS_FLAG_WRITE ) != 0 )
+	if( ( access_hint_flags & ~( LIBPFF_ACCESS_HINT_FLAG_ADVISE | LIBPFF_ACCESS_HINT_FLAG_DROP_SCANNED_DATA | LIBPFF_ACCESS_HINT_FLAG_DIRECT_SCAN ) ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: write access currently not supported.",
-		 function );
+		 "%s: unsupported access hint flags: 0x%02" PRIx8 ".",
+		 function,
+		 access_hint_flags );
 
 		return( -1 );
 	}
-	if( ( access_flags & LIBPFF_ACCESS_FLAG_READ ) != 0 )
+#if defined( LIBPFF_HAVE_DESCRIPTOR_IO_HANDLE )
+	if( internal_file->descriptor_io_handle != NULL )
 	{
-		bfio_access_flags = LIBBFIO_ACCESS_FLAG_READ;
-	}
-	file_io_handle_is_open = libbfio_handle_is_open(
-	                          file_io_handle,
-	                          error );
-
-	if( file_io_handle_is_open == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to determine if file IO handle is open.",
-		 function );
-
-		goto on_error;
-	}
-	else if( file_io_handle_is_open == 0 )
-	{
-		if( libbfio_handle_open(
-		     file_io_handle,
-		     bfio_access_flags,
+		if( libpff_descriptor_io_handle_set_access_hint_flags(
+		     internal_file->descriptor_io_handle,
+		     access_hint_flags,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_OPEN_FAILED,
-			 "%s: unable to open file IO handle.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set access hint flags in descriptor IO handle.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
-		internal_file->file_io_handle_opened_in_library = 1;
-	}
-	if( libpff_internal_file_open_read(
-	     internal_file,
-	     file_io_handle,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read from file handle.",
-		 function );
-
-		goto on_error;
 	}
-	internal_file->file_io_handle = file_io_handle;
+#endif
+	internal_file->access_hint_flags = access_hint_flags;
 
 	return( 1 );
-
-on_error:
-	if( ( file_io_handle_is_open == 0 )
-	 && ( internal_file->file_io_handle_opened_in_library != 0 ) )
-	{
-		libbfio_handle_close(
-		 file_io_handle,
-		 error );
-
-		internal_file->file_io_handle_opened_in_library = 0;
-	}
-	internal_file->file_io_handle = NULL;
-
-	return( -1 );
 }
 
-/* Closes a file
- * Returns 0 if successful or -1 on error
+/* Opens a file
+ * Returns 1 if successful or -1 on error
  */
-int libpff_file_close(
+int libpff_file_open(
      libpff_file_t *file,
+     const char *filename,
+     int access_flags,
      libcerror_error_t **error )
 {
-	libpff_internal_file_t *internal_file = NULL;
-	static char *function                 = "libpff_file_close";
-	int result                            = 0;
+	libbfio_handle_t *file_io_handle                            = NULL;
+	libpff_internal_file_t *internal_file                       = NULL;
+	static char *function                                       = "libpff_file_open";
+	size_t filename_length                                      = 0;
+
+#if defined( LIBPFF_HAVE_DESCRIPTOR_IO_HANDLE )
+	libpff_descriptor_io_handle_t *descriptor_io_handle         = NULL;
+	libpff_descriptor_io_handle_t *managed_descriptor_io_handle = NULL;
+#endif
 
 	if( file == NULL )
 	{
@@ -636,263 +594,338 @@ int libpff_file_close(
 	}
 	internal_file = (libpff_internal_file_t *) file;
 
-	if( internal_file->file_io_handle == NULL )
+	if( filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - missing file IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	filename_length = narrow_string_length(
+	                   filename );
+
+#if defined( LIBPFF_HAVE_DESCRIPTOR_IO_HANDLE )
+	/* The file is only read using a descriptor owned by the library when access hints
+	 * are set, so that they can be passed on to the operating system
+	 */
+	if( internal_file->access_hint_flags != 0 )
 	{
-		if( internal_file->file_io_handle_created_in_library != 0 )
+		if( libpff_descriptor_io_handle_initialize(
+		     &descriptor_io_handle,
+		     error ) != 1 )
 		{
-			if( libpff_debug_print_read_offsets(
-			     internal_file->file_io_handle,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-				 "%s: unable to print the read offsets.",
-				 function );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create descriptor IO handle.",
+			 function );
 
-				result = -1;
-			}
+			goto on_error;
 		}
-	}
-#endif
-	if( internal_file->file_io_handle_opened_in_library != 0 )
-	{
-		if( libbfio_handle_close(
-		     internal_file->file_io_handle,
-		     error ) != 0 )
+		if( libpff_descriptor_io_handle_set_name(
+		     descriptor_io_handle,
+		     filename,
+		     filename_length + 1,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-			 "%s: unable to close file IO handle.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set filename in descriptor IO handle.",
 			 function );
 
-			result = -1;
+			goto on_error;
 		}
-		internal_file->file_io_handle_opened_in_library = 0;
+		if( libpff_descriptor_io_handle_set_access_hint_flags(
+		     descriptor_io_handle,
+		     internal_file->access_hint_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set access hint flags in descriptor IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libpff_descriptor_io_handle_set_access_pattern(
+		     descriptor_io_handle,
+		     LIBPFF_ACCESS_PATTERN_RANDOM,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set access pattern in descriptor IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_handle_initialize(
+		     &file_io_handle,
+		     (intptr_t *) descriptor_io_handle,
+		     (int (*)(intptr_t **, libcerror_error_t **)) libpff_descriptor_io_handle_free,
+		     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) libpff_descriptor_io_handle_clone,
+		     (int (*)(intptr_t *, int flags, libcerror_error_t **)) libpff_descriptor_io_handle_open,
+		     (int (*)(intptr_t *, libcerror_error_t **)) libpff_descriptor_io_handle_close,
+		     (ssize_t (*)(intptr_t *, uint8_t *, size_t, libcerror_error_t **)) libpff_descriptor_io_handle_read,
+		     (ssize_t (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) libpff_descriptor_io_handle_write,
+		     (off64_t (*)(intptr_t *, off64_t, int, libcerror_error_t **)) libpff_descriptor_io_handle_seek_offset,
+		     (int (*)(intptr_t *, libcerror_error_t **)) libpff_descriptor_io_handle_exists,
+		     (int (*)(intptr_t *, libcerror_error_t **)) libpff_descriptor_io_handle_is_open,
+		     (int (*)(intptr_t *, size64_t *, libcerror_error_t **)) libpff_descriptor_io_handle_get_size,
+		     LIBBFIO_FLAG_IO_HANDLE_MANAGED | LIBBFIO_FLAG_IO_HANDLE_CLONE_BY_FUNCTION,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		/* The descriptor IO handle is now managed by the file IO handle
+		 */
+		managed_descriptor_io_handle = descriptor_io_handle;
+		descriptor_io_handle         = NULL;
 	}
-	if( internal_file->file_io_handle_created_in_library != 0 )
+#endif /* defined( LIBPFF_HAVE_DESCRIPTOR_IO_HANDLE ) */
+
+	if( file_io_handle == NULL )
 	{
-		if( libbfio_handle_free(
-		     &( internal_file->file_io_handle ),
+		if( libbfio_file_initialize(
+		     &file_io_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free file IO handle.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle.",
 			 function );
 
-			result = -1;
+			goto on_error;
+		}
+		if( libbfio_file_set_name(
+		     file_io_handle,
+		     filename,
+		     filename_length + 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set filename in file IO handle.",
+			 function );
+
+			goto on_error;
 		}
-		internal_file->file_io_handle_created_in_library = 0;
 	}
-	internal_file->file_io_handle = NULL;
 
-	if( libpff_io_handle_clear(
-	     internal_file->io_handle,
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libbfio_handle_set_track_offsets_read(
+	     file_io_handle,
+	     1,
 	     error ) != 1 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to clear IO handle.",
-		 function );
+                libcerror_error_set(
+                 error,
+                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+                 "%s: unable to set track offsets read in file IO handle.",
+                 function );
 
-		result = -1;
+		goto on_error;
 	}
-	if( libpff_file_header_free(
-	     &( internal_file->file_header ),
+#endif
+	if( libpff_file_open_file_io_handle(
+	     file,
+	     file_io_handle,
+	     access_flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free file header.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file: %s.",
+		 function,
+		 filename );
 
-		result = -1;
+		goto on_error;
 	}
-	if( libfdata_vector_free(
-	     &( internal_file->index_nodes_vector ),
-	     error ) != 1 )
+	internal_file->file_io_handle_created_in_library = 1;
+
+#if defined( LIBPFF_HAVE_DESCRIPTOR_IO_HANDLE )
+	internal_file->descriptor_io_handle = managed_descriptor_io_handle;
+#endif
+
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+#if defined( LIBPFF_HAVE_DESCRIPTOR_IO_HANDLE )
+	if( descriptor_io_handle != NULL )
+	{
+		libpff_descriptor_io_handle_free(
+		 &descriptor_io_handle,
+		 NULL );
+	}
+#endif
+	return( -1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Opens a file
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_file_open_wide(
+     libpff_file_t *file,
+     const wchar_t *filename,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle      = NULL;
+	libpff_internal_file_t *internal_file = NULL;
+	static char *function                 = "libpff_file_open_wide";
+	size_t filename_length                = 0;
+
+	if( file == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free index nodes vector.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-	if( libfcache_cache_free(
-	     &( internal_file->index_nodes_cache ),
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free index nodes cache.",
-		 function );
+	internal_file = (libpff_internal_file_t *) file;
 
-		result = -1;
-	}
-	if( libpff_descriptors_index_free(
-	     &( internal_file->descriptors_index ),
-	     error ) != 1 )
+	if( filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free descriptors index.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-	if( libpff_offsets_index_free(
-	     &( internal_file->offsets_index ),
+	if( libbfio_file_initialize(
+	     &file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free offsets index.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
 		 function );
 
-		result = -1;
+		goto on_error;
 	}
-	if( libpff_item_tree_free(
-	     &( internal_file->item_tree ),
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libbfio_handle_set_track_offsets_read(
+	     file_io_handle,
+	     1,
 	     error ) != 1 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free item tree.",
-		 function );
+                libcerror_error_set(
+                 error,
+                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+                 "%s: unable to set track offsets read in file IO handle.",
+                 function );
 
-		result = -1;
+		goto on_error;
 	}
-	internal_file->root_folder_item_tree_node = NULL;
+#endif
+	filename_length = wide_string_length(
+	                   filename );
 
-	if( libcdata_list_free(
-	     &( internal_file->orphan_item_list ),
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_tree_node_free_recovered,
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length + 1,
 	     error ) != 1 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free orphan item list.",
-		 function );
+                libcerror_error_set(
+                 error,
+                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+                 "%s: unable to set filename in file IO handle.",
+                 function );
 
-		result = -1;
+		goto on_error;
 	}
-	if( libcdata_list_free(
-	     &( internal_file->name_to_id_map_list ),
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_name_to_id_map_entry_free,
+	if( libpff_file_open_file_io_handle(
+	     file,
+	     file_io_handle,
+	     access_flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free name to id map list.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file: %ls.",
+		 function,
+		 filename );
 
-		result = -1;
+		goto on_error;
 	}
-	if( internal_file->recovered_item_list != NULL )
-	{
-		if( libcdata_list_free(
-		     &( internal_file->recovered_item_list ),
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_tree_node_free_recovered,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free recovered item list.",
-			 function );
+	internal_file->file_io_handle_created_in_library = 1;
 
-			result = -1;
-		}
-	}
-	if( internal_file->unallocated_data_block_list != NULL )
-	{
-		if( libcdata_range_list_free(
-		     &( internal_file->unallocated_data_block_list ),
-		     NULL,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free unallocated data block list.",
-			 function );
+	return( 1 );
 
-			result = -1;
-		}
-	}
-	if( internal_file->unallocated_page_block_list != NULL )
+on_error:
+	if( file_io_handle != NULL )
 	{
-		if( libcdata_range_list_free(
-		     &( internal_file->unallocated_page_block_list ),
-		     NULL,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free unallocated page block list.",
-			 function );
-
-			result = -1;
-		}
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
 	}
-	return( result );
+	return( -1 );
 }
 
-/* Opens a file for reading
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Opens a file using a Basic File IO (bfio) handle
  * Returns 1 if successful or -1 on error
  */
-int libpff_internal_file_open_read(
-     libpff_internal_file_t *internal_file,
+int libpff_file_open_file_io_handle(
+     libpff_file_t *file,
      libbfio_handle_t *file_io_handle,
+     int access_flags,
      libcerror_error_t **error )
 {
-	static char *function = "libpff_internal_file_open_read";
-	size_t page_size      = 0;
-	int result            = 0;
-	int segment_index     = 0;
+	libpff_internal_file_t *internal_file = NULL;
+	static char *function                 = "libpff_file_open_file_io_handle";
+	int bfio_access_flags                 = 0;
+	int file_io_handle_is_open            = 0;
 
-	if( internal_file == NULL )
+	if( file == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -903,435 +936,4616 @@ int libpff_internal_file_open_read(
 
 		return( -1 );
 	}
-	if( internal_file->file_header != NULL )
+	internal_file = (libpff_internal_file_t *) file;
+
+	if( internal_file->file_io_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file - file header value already set.",
+		 "%s: invalid file - file IO handle already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_file->descriptors_index != NULL )
+	if( file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file - descriptors index value already set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_file->offsets_index != NULL )
+	if( ( ( access_flags & LIBPFF_ACCESS_FLAG_READ ) == 0 )
+	 && ( ( access_flags & LIBPFF_ACCESS_FLAG_WRITE ) == 0 ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file - offsets index value already set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_file->item_tree != NULL )
+	if( ( access_flags & LIBPFF_ACCESS_FLAG_WRITE ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file - item tree value already set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: write access currently not supported.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_file->root_folder_item_tree_node != NULL )
+	if( ( access_flags & LIBPFF_ACCESS_FLAG_READ ) != 0 )
+	{
+		bfio_access_flags = LIBBFIO_ACCESS_FLAG_READ;
+	}
+	file_io_handle_is_open = libbfio_handle_is_open(
+	                          file_io_handle,
+	                          error );
+
+	if( file_io_handle_is_open == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file - root folder item tree root node value already set.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to determine if file IO handle is open.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_file->orphan_item_list != NULL )
+	else if( file_io_handle_is_open == 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file - orphan item list value already set.",
-		 function );
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     bfio_access_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file IO handle.",
+			 function );
 
-		return( -1 );
+			goto on_error;
+		}
+		internal_file->file_io_handle_opened_in_library = 1;
 	}
-	if( internal_file->name_to_id_map_list != NULL )
+	if( libpff_internal_file_open_read(
+	     internal_file,
+	     file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file - name to id map list value already set.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from file handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	internal_file->file_io_handle = file_io_handle;
+
+	return( 1 );
+
+on_error:
+	if( ( file_io_handle_is_open == 0 )
+	 && ( internal_file->file_io_handle_opened_in_library != 0 ) )
 	{
-		libcnotify_printf(
-		 "Reading file header:\n" );
-	}
-#endif
-	if( libpff_file_header_initialize(
-	     &( internal_file->file_header ),
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file header.",
-		 function );
+		libbfio_handle_close(
+		 file_io_handle,
+		 error );
 
-		goto on_error;
+		internal_file->file_io_handle_opened_in_library = 0;
 	}
-	if( libpff_file_header_read_file_io_handle(
-	     internal_file->file_header,
-	     file_io_handle,
-	     error ) != 1 )
+	internal_file->file_io_handle = NULL;
+
+	return( -1 );
+}
+
+/* Opens a file in caller driven mode
+ * The file size and access flags are only used by the first call, the values
+ * read by the previous call are kept when the open is retried
+ * Returns 1 if successful, 0 if data needs to be supplied or -1 on error
+ */
+int libpff_file_open_caller_driven(
+     libpff_file_t *file,
+     size64_t file_size,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	libpff_caller_io_handle_t *caller_io_handle = NULL;
+	libpff_internal_file_t *internal_file       = NULL;
+	static char *function                       = "libpff_file_open_caller_driven";
+	int result                                  = 0;
+
+	if( file == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read file header data.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	internal_file->io_handle->encryption_type = internal_file->file_header->encryption_type;
-	internal_file->io_handle->file_size       = internal_file->file_header->file_size;
-	internal_file->io_handle->file_type       = internal_file->file_header->file_type;
+	internal_file = (libpff_internal_file_t *) file;
 
-	if( ( internal_file->io_handle->encryption_type != LIBPFF_ENCRYPTION_TYPE_NONE )
-	 && ( internal_file->io_handle->encryption_type != LIBPFF_ENCRYPTION_TYPE_COMPRESSIBLE )
-	 && ( internal_file->io_handle->encryption_type != LIBPFF_ENCRYPTION_TYPE_HIGH ) )
+	if( internal_file->file_io_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported encryption type: 0x%02x",
-		 function,
-		 internal_file->io_handle->encryption_type );
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file - file IO handle already set.",
+		 function );
 
-		goto on_error;
-	}
-	if( internal_file->io_handle->file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE )
-	{
-		page_size = 4096;
-	}
-	else
-	{
-		page_size = 512;
+		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( internal_file->caller_file_io_handle == NULL )
 	{
-		libcnotify_printf(
-		 "%s: file type\t\t\t\t: %" PRIu8 "\n",
-		 function,
-		 internal_file->io_handle->file_type );
+		if( ( ( access_flags & LIBPFF_ACCESS_FLAG_READ ) == 0 )
+		 && ( ( access_flags & LIBPFF_ACCESS_FLAG_WRITE ) == 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported access flags.",
+			 function );
 
-		libcnotify_printf(
-		 "%s: page size\t\t\t\t: %" PRIzd "\n",
-		 function,
-		 page_size );
+			return( -1 );
+		}
+		if( ( access_flags & LIBPFF_ACCESS_FLAG_WRITE ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: write access currently not supported.",
+			 function );
 
-		libcnotify_printf(
-		 "\n" );
+			return( -1 );
+		}
+		if( libpff_caller_io_handle_initialize(
+		     &caller_io_handle,
+		     file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create caller IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_handle_initialize(
+		     &( internal_file->caller_file_io_handle ),
+		     (intptr_t *) caller_io_handle,
+		     (int (*)(intptr_t **, libcerror_error_t **)) libpff_caller_io_handle_free,
+		     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) libpff_caller_io_handle_clone,
+		     (int (*)(intptr_t *, int flags, libcerror_error_t **)) libpff_caller_io_handle_open,
+		     (int (*)(intptr_t *, libcerror_error_t **)) libpff_caller_io_handle_close,
+		     (ssize_t (*)(intptr_t *, uint8_t *, size_t, libcerror_error_t **)) libpff_caller_io_handle_read,
+		     (ssize_t (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) libpff_caller_io_handle_write,
+		     (off64_t (*)(intptr_t *, off64_t, int, libcerror_error_t **)) libpff_caller_io_handle_seek_offset,
+		     (int (*)(intptr_t *, libcerror_error_t **)) libpff_caller_io_handle_exists,
+		     (int (*)(intptr_t *, libcerror_error_t **)) libpff_caller_io_handle_is_open,
+		     (int (*)(intptr_t *, size64_t *, libcerror_error_t **)) libpff_caller_io_handle_get_size,
+		     LIBBFIO_FLAG_IO_HANDLE_MANAGED | LIBBFIO_FLAG_IO_HANDLE_CLONE_BY_FUNCTION,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create caller file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		/* The caller IO handle is now managed by the caller file IO handle
+		 */
+		internal_file->caller_io_handle = caller_io_handle;
+		caller_io_handle                = NULL;
+
+		if( libbfio_handle_open(
+		     internal_file->caller_file_io_handle,
+		     LIBBFIO_ACCESS_FLAG_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open caller file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libpff_caller_open_state_initialize(
+		     &( internal_file->caller_open_state ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create caller open state.",
+			 function );
+
+			goto on_error;
+		}
+		internal_file->io_handle->caller_io_handle = internal_file->caller_io_handle;
 	}
-#endif
-/* TODO free and clone function ? */
-	if( libfdata_vector_initialize(
-	     &( internal_file->index_nodes_vector ),
-	     page_size,
-	     (intptr_t *) internal_file->io_handle,
-	     NULL,
-	     NULL,
-	     (int (*)(intptr_t *, intptr_t *, libfdata_vector_t *, libfdata_cache_t *, int, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &libpff_io_handle_read_index_node,
-	     NULL,
-	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	if( libpff_io_handle_clear_pending_read(
+	     internal_file->io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create index nodes vector.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to clear pending read.",
 		 function );
 
 		goto on_error;
 	}
-	if( libfdata_vector_append_segment(
-	     internal_file->index_nodes_vector,
-	     &segment_index,
-	     0,
-	     0,
-	     internal_file->io_handle->file_size,
-	     0,
-	     error ) != 1 )
+	result = libpff_internal_file_open_read_caller_driven(
+	          internal_file,
+	          internal_file->caller_file_io_handle,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to create append segment to nodes vector.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
 		 function );
 
 		goto on_error;
 	}
-	if( libfcache_cache_initialize(
-	     &( internal_file->index_nodes_cache ),
-	     LIBPFF_MAXIMUM_CACHE_ENTRIES_INDEX_NODES,
+	else if( result == 0 )
+	{
+		/* The open is retried after the data has been supplied
+		 */
+		return( 0 );
+	}
+	if( libpff_caller_open_state_free(
+	     &( internal_file->caller_open_state ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create index nodes cache.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free caller open state.",
 		 function );
 
 		goto on_error;
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	internal_file->file_io_handle                    = internal_file->caller_file_io_handle;
+	internal_file->file_io_handle_created_in_library = 1;
+	internal_file->file_io_handle_opened_in_library  = 1;
+	internal_file->caller_file_io_handle             = NULL;
+
+	return( 1 );
+
+on_error:
+	libpff_internal_file_free_open_values(
+	 internal_file,
+	 NULL );
+
+	if( internal_file->caller_file_io_handle != NULL )
 	{
-		libcnotify_printf(
-		 "Creating item tree:\n" );
+		libbfio_handle_free(
+		 &( internal_file->caller_file_io_handle ),
+		 NULL );
 	}
-#endif
-	if( libpff_descriptors_index_initialize(
-	     &( internal_file->descriptors_index ),
-	     internal_file->io_handle,
-	     internal_file->index_nodes_vector,
-	     internal_file->index_nodes_cache,
-	     error ) != 1 )
+	if( caller_io_handle != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create descriptors index.",
-		 function );
-
-		goto on_error;
+		libpff_caller_io_handle_free(
+		 &caller_io_handle,
+		 NULL );
 	}
-	if( libpff_descriptors_index_set_root_node(
-	     internal_file->descriptors_index,
-	     internal_file->file_header->descriptors_index_root_node_offset,
-	     internal_file->file_header->descriptors_index_root_node_back_pointer,
-	     0,
-	     error ) != 1 )
+	internal_file->caller_io_handle            = NULL;
+	internal_file->io_handle->caller_io_handle = NULL;
+
+	return( -1 );
+}
+
+/* Retrieves the range of data needed by the last failed operation
+ * in caller driven mode
+ * Returns 1 if successful, 0 if no read is pending or -1 on error
+ */
+int libpff_file_get_pending_read(
+     libpff_file_t *file,
+     off64_t *offset,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	libpff_internal_file_t *internal_file = NULL;
+	static char *function                 = "libpff_file_get_pending_read";
+	int result                            = 0;
+
+	if( file == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set descriptors index root node.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libpff_offsets_index_initialize(
-	     &( internal_file->offsets_index ),
-	     internal_file->io_handle,
-	     internal_file->index_nodes_vector,
-	     internal_file->index_nodes_cache,
-	     error ) != 1 )
+	internal_file = (libpff_internal_file_t *) file;
+
+	if( internal_file->caller_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create offsets index.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing caller IO handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libpff_offsets_index_set_root_node(
-	     internal_file->offsets_index,
-	     internal_file->file_header->offsets_index_root_node_offset,
-	     internal_file->file_header->offsets_index_root_node_back_pointer,
-	     0,
-	     error ) != 1 )
+	result = libpff_caller_io_handle_get_pending_read(
+	          internal_file->caller_io_handle,
+	          offset,
+	          size,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set offsets index root node.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve pending read.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libcdata_list_initialize(
-	     &( internal_file->orphan_item_list ),
+	return( result );
+}
+
+/* Supplies data to a file in caller driven mode
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_file_supply_data(
+     libpff_file_t *file,
+     off64_t offset,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libpff_internal_file_t *internal_file = NULL;
+	static char *function                 = "libpff_file_supply_data";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libpff_internal_file_t *) file;
+
+	if( internal_file->caller_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing caller IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_caller_io_handle_supply_data(
+	     internal_file->caller_io_handle,
+	     offset,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to supply data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Releases supplied data of a file in caller driven mode
+ * Returns 1 if successful, 0 if no data was supplied within the range or -1 on error
+ */
+int libpff_file_release_data(
+     libpff_file_t *file,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	libpff_internal_file_t *internal_file = NULL;
+	static char *function                 = "libpff_file_release_data";
+	int result                            = 0;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libpff_internal_file_t *) file;
+
+	if( internal_file->caller_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing caller IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = libpff_caller_io_handle_release_data(
+	          internal_file->caller_io_handle,
+	          offset,
+	          size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to release data.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the total size of the data supplied to a file in caller driven mode
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_file_get_supplied_data_size(
+     libpff_file_t *file,
+     size64_t *supplied_data_size,
+     libcerror_error_t **error )
+{
+	libpff_internal_file_t *internal_file = NULL;
+	static char *function                 = "libpff_file_get_supplied_data_size";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libpff_internal_file_t *) file;
+
+	if( internal_file->caller_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing caller IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_caller_io_handle_get_supplied_data_size(
+	     internal_file->caller_io_handle,
+	     supplied_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve supplied data size.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Closes a file
+ * Returns 0 if successful or -1 on error
+ */
+int libpff_file_close(
+     libpff_file_t *file,
+     libcerror_error_t **error )
+{
+	libpff_internal_file_t *internal_file = NULL;
+	static char *function                 = "libpff_file_close";
+	int result                            = 0;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libpff_internal_file_t *) file;
+
+	if( internal_file->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		if( internal_file->file_io_handle_created_in_library != 0 )
+		{
+			if( libpff_debug_print_read_offsets(
+			     internal_file->file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print the read offsets.",
+				 function );
+
+				result = -1;
+			}
+		}
+	}
+#endif
+	if( internal_file->file_io_handle_opened_in_library != 0 )
+	{
+		if( libbfio_handle_close(
+		     internal_file->file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		internal_file->file_io_handle_opened_in_library = 0;
+	}
+	if( internal_file->file_io_handle_created_in_library != 0 )
+	{
+		if( libbfio_handle_free(
+		     &( internal_file->file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		internal_file->file_io_handle_created_in_library = 0;
+	}
+	internal_file->file_io_handle   = NULL;
+	internal_file->caller_io_handle = NULL;
+
+#if defined( LIBPFF_HAVE_DESCRIPTOR_IO_HANDLE )
+	internal_file->descriptor_io_handle = NULL;
+#endif
+
+	if( libpff_io_handle_clear(
+	     internal_file->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear IO handle.",
+		 function );
+
+		result = -1;
+	}
+	if( libpff_file_header_free(
+	     &( internal_file->file_header ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file header.",
+		 function );
+
+		result = -1;
+	}
+	if( libfdata_vector_free(
+	     &( internal_file->index_nodes_vector ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create orphan item list.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free index nodes vector.",
+		 function );
+
+		result = -1;
+	}
+	if( libfcache_cache_free(
+	     &( internal_file->index_nodes_cache ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free index nodes cache.",
+		 function );
+
+		result = -1;
+	}
+	if( libpff_descriptors_index_free(
+	     &( internal_file->descriptors_index ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free descriptors index.",
+		 function );
+
+		result = -1;
+	}
+	if( libpff_offsets_index_free(
+	     &( internal_file->offsets_index ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free offsets index.",
+		 function );
+
+		result = -1;
+	}
+	if( libpff_item_tree_free(
+	     &( internal_file->item_tree ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free item tree.",
+		 function );
+
+		result = -1;
+	}
+	internal_file->root_folder_item_tree_node = NULL;
+
+	if( libcdata_array_free(
+	     &( internal_file->orphan_item_array ),
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_tree_node_free_recovered,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free orphan item array.",
+		 function );
+
+		result = -1;
+	}
+	if( internal_file->descriptors_index_layout != NULL )
+	{
+		if( libpff_index_layout_free(
+		     &( internal_file->descriptors_index_layout ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free descriptors index layout.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcdata_list_free(
+	     &( internal_file->name_to_id_map_list ),
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_name_to_id_map_entry_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free name to id map list.",
+		 function );
+
+		result = -1;
+	}
+	/* Invalidate the property sets prepared against the name to ID map
+	 */
+	internal_file->io_handle->name_to_id_map_generation += 1;
+
+	if( internal_file->recovered_item_array != NULL )
+	{
+		if( libcdata_array_free(
+		     &( internal_file->recovered_item_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_tree_node_free_recovered,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free recovered item array.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_file->unallocated_data_block_list != NULL )
+	{
+		if( libcdata_range_list_free(
+		     &( internal_file->unallocated_data_block_list ),
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free unallocated data block list.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_file->unallocated_page_block_list != NULL )
+	{
+		if( libcdata_range_list_free(
+		     &( internal_file->unallocated_page_block_list ),
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free unallocated page block list.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Reads the file header
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_internal_file_read_file_header(
+     libpff_internal_file_t *internal_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_internal_file_read_file_header";
+
+	if( internal_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "Reading file header:\n" );
+	}
+#endif
+	if( libpff_file_header_initialize(
+	     &( internal_file->file_header ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file header.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_file_header_read_file_io_handle(
+	     internal_file->file_header,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file header data.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file->io_handle->encryption_type = internal_file->file_header->encryption_type;
+	internal_file->io_handle->file_size       = internal_file->file_header->file_size;
+
+	if( libpff_io_handle_set_file_type(
+	     internal_file->io_handle,
+	     internal_file->file_header->file_type,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set file type.",
+		 function );
+
+		return( -1 );
+	}
+
+	if( ( internal_file->io_handle->encryption_type != LIBPFF_ENCRYPTION_TYPE_NONE )
+	 && ( internal_file->io_handle->encryption_type != LIBPFF_ENCRYPTION_TYPE_COMPRESSIBLE )
+	 && ( internal_file->io_handle->encryption_type != LIBPFF_ENCRYPTION_TYPE_HIGH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported encryption type: 0x%02x",
+		 function,
+		 internal_file->io_handle->encryption_type );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Creates the indexes, caches and lists of a file of which the file header was read
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_internal_file_create_indexes(
+     libpff_internal_file_t *internal_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_internal_file_create_indexes";
+	size_t page_size      = 0;
+	int segment_index     = 0;
+
+	if( internal_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->file_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing file header.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->io_handle->file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE )
+	{
+		page_size = 4096;
+	}
+	else
+	{
+		page_size = 512;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: file type\t\t\t\t: %" PRIu8 "\n",
+		 function,
+		 internal_file->io_handle->file_type );
+
+		libcnotify_printf(
+		 "%s: page size\t\t\t\t: %" PRIzd "\n",
+		 function,
+		 page_size );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif
+/* TODO free and clone function ? */
+	if( libfdata_vector_initialize(
+	     &( internal_file->index_nodes_vector ),
+	     page_size,
+	     (intptr_t *) internal_file->io_handle,
+	     NULL,
+	     NULL,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_vector_t *, libfdata_cache_t *, int, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &libpff_io_handle_read_index_node,
+	     NULL,
+	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create index nodes vector.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_vector_append_segment(
+	     internal_file->index_nodes_vector,
+	     &segment_index,
+	     0,
+	     0,
+	     internal_file->io_handle->file_size,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to create append segment to nodes vector.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfcache_cache_initialize(
+	     &( internal_file->index_nodes_cache ),
+	     LIBPFF_MAXIMUM_CACHE_ENTRIES_INDEX_NODES,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create index nodes cache.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "Creating item tree:\n" );
+	}
+#endif
+	if( libpff_descriptors_index_initialize(
+	     &( internal_file->descriptors_index ),
+	     internal_file->io_handle,
+	     internal_file->index_nodes_vector,
+	     internal_file->index_nodes_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create descriptors index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_descriptors_index_set_root_node(
+	     internal_file->descriptors_index,
+	     internal_file->file_header->descriptors_index_root_node_offset,
+	     internal_file->file_header->descriptors_index_root_node_back_pointer,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set descriptors index root node.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_offsets_index_initialize(
+	     &( internal_file->offsets_index ),
+	     internal_file->io_handle,
+	     internal_file->index_nodes_vector,
+	     internal_file->index_nodes_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create offsets index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_offsets_index_set_root_node(
+	     internal_file->offsets_index,
+	     internal_file->file_header->offsets_index_root_node_offset,
+	     internal_file->file_header->offsets_index_root_node_back_pointer,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set offsets index root node.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_table_cache_initialize(
+	     &( internal_file->io_handle->table_cache ),
+	     LIBPFF_MAXIMUM_CACHE_ENTRIES_ITEM,
+	     LIBPFF_MAXIMUM_CACHE_SIZE_ITEM,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_table_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libpff_table_clone,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create table cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_local_descriptor_nodes_cache_initialize(
+	     &( internal_file->io_handle->local_descriptor_nodes_cache ),
+	     LIBPFF_NUMBER_OF_CACHE_SHARDS_LOCAL_DESCRIPTORS_NODES,
+	     LIBPFF_MAXIMUM_CACHE_ENTRIES_LOCAL_DESCRIPTORS_NODES,
+	     LIBPFF_MAXIMUM_CACHE_SIZE_LOCAL_DESCRIPTORS_NODES,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_local_descriptor_node_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create local descriptor nodes cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( internal_file->orphan_item_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create orphan item array.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_list_initialize(
+	     &( internal_file->name_to_id_map_list ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create name to id map list.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Frees the values read and created when opening a file
+ * This is used to clean up a failed or abandoned open
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_internal_file_free_open_values(
+     libpff_internal_file_t *internal_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_internal_file_free_open_values";
+
+	if( internal_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->caller_open_state != NULL )
+	{
+		libpff_caller_open_state_free(
+		 &( internal_file->caller_open_state ),
+		 NULL );
+	}
+	if( internal_file->name_to_id_map_list != NULL )
+	{
+		libcdata_list_free(
+		 &( internal_file->name_to_id_map_list ),
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libpff_name_to_id_map_entry_free,
+		 NULL );
+
+		if( internal_file->io_handle != NULL )
+		{
+			internal_file->io_handle->name_to_id_map_generation += 1;
+		}
+	}
+	internal_file->root_folder_item_tree_node = NULL;
+
+	if( internal_file->orphan_item_array != NULL )
+	{
+		libcdata_array_free(
+		 &( internal_file->orphan_item_array ),
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_tree_node_free_recovered,
+		 NULL );
+	}
+	if( internal_file->item_tree != NULL )
+	{
+		libpff_item_tree_free(
+		 &( internal_file->item_tree ),
+		 NULL );
+	}
+	if( internal_file->io_handle->local_descriptor_nodes_cache != NULL )
+	{
+		libpff_local_descriptor_nodes_cache_free(
+		 &( internal_file->io_handle->local_descriptor_nodes_cache ),
+		 NULL );
+	}
+	if( internal_file->io_handle->table_cache != NULL )
+	{
+		libpff_table_cache_free(
+		 &( internal_file->io_handle->table_cache ),
+		 NULL );
+	}
+	if( internal_file->descriptors_index_layout != NULL )
+	{
+		libpff_index_layout_free(
+		 &( internal_file->descriptors_index_layout ),
+		 NULL );
+	}
+	if( internal_file->offsets_index != NULL )
+	{
+		libpff_offsets_index_free(
+		 &( internal_file->offsets_index ),
+		 NULL );
+	}
+	if( internal_file->descriptors_index != NULL )
+	{
+		libpff_descriptors_index_free(
+		 &( internal_file->descriptors_index ),
+		 NULL );
+	}
+	if( internal_file->index_nodes_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &( internal_file->index_nodes_cache ),
+		 NULL );
+	}
+	if( internal_file->index_nodes_vector != NULL )
+	{
+		libfdata_vector_free(
+		 &( internal_file->index_nodes_vector ),
+		 NULL );
+	}
+	if( internal_file->file_header != NULL )
+	{
+		libpff_file_header_free(
+		 &( internal_file->file_header ),
+		 NULL );
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates the item tree from the descriptors index read in shards on separate threads
+ * Every shard reads a range of the sub nodes of the descriptors index root node,
+ * after which the item tree nodes are linked to their parent on the calling thread
+ * Returns 1 if successful, 0 if the descriptors index cannot be read in shards or -1 on error
+ */
+int libpff_internal_file_create_item_tree_in_shards(
+     libpff_internal_file_t *internal_file,
+     libbfio_handle_t *file_io_handle,
+     size_t index_node_size,
+     libcerror_error_t **error )
+{
+	libpff_open_worker_t *shard_workers[ LIBPFF_MAXIMUM_NUMBER_OF_OPEN_SHARDS ];
+
+	libcdata_array_t *index_values_array                  = NULL;
+	libfdata_tree_node_t *descriptor_index_tree_root_node = NULL;
+	libpff_index_value_t *index_value                     = NULL;
+	static char *function                                 = "libpff_internal_file_create_item_tree_in_shards";
+	int entry_index                                       = 0;
+	int first_sub_node_index                              = 0;
+	int number_of_index_values                            = 0;
+	int number_of_shards                                  = 0;
+	int number_of_sub_nodes                               = 0;
+	int result                                            = 0;
+	int shard_index                                       = 0;
+	int value_index                                       = 0;
+
+	if( internal_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->descriptors_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing descriptors index.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     shard_workers,
+	     0,
+	     sizeof( libpff_open_worker_t * ) * LIBPFF_MAXIMUM_NUMBER_OF_OPEN_SHARDS ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear shard workers.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_index_tree_get_root_node(
+	     internal_file->descriptors_index->index_tree,
+	     &descriptor_index_tree_root_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve descriptor index tree root node.",
+		 function );
+
+		return( -1 );
+	}
+	/* A descriptors index root node that cannot be read is handled
+	 * when the item tree is created from the descriptors index
+	 */
+	if( libfdata_tree_node_get_number_of_sub_nodes(
+	     descriptor_index_tree_root_node,
+	     (intptr_t *) file_io_handle,
+	     (libfdata_cache_t *) internal_file->descriptors_index->index_cache,
+	     &number_of_sub_nodes,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_free(
+		 error );
+
+		return( 0 );
+	}
+	result = libfdata_tree_node_is_leaf(
+	          descriptor_index_tree_root_node,
+	          (intptr_t *) file_io_handle,
+	          (libfdata_cache_t *) internal_file->descriptors_index->index_cache,
+	          0,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if descriptor index tree root node is a leaf node.",
+		 function );
+
+		return( -1 );
+	}
+	else if( ( result != 0 )
+	      || ( number_of_sub_nodes < 2 ) )
+	{
+		return( 0 );
+	}
+	number_of_shards = number_of_sub_nodes;
+
+	if( number_of_shards > LIBPFF_MAXIMUM_NUMBER_OF_OPEN_SHARDS )
+	{
+		number_of_shards = LIBPFF_MAXIMUM_NUMBER_OF_OPEN_SHARDS;
+	}
+	for( shard_index = 0;
+	     shard_index < number_of_shards;
+	     shard_index++ )
+	{
+		if( libpff_open_worker_initialize(
+		     &( shard_workers[ shard_index ] ),
+		     internal_file->io_handle,
+		     file_io_handle,
+		     internal_file->file_header,
+		     index_node_size,
+		     NULL,
+		     error ) != 1 )
+		{
+			/* Fall back to creating the item tree on the calling thread,
+			 * for example if the file IO handle cannot be cloned
+			 */
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( ( libcnotify_verbose != 0 )
+			 && ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+#endif
+			libcerror_error_free(
+			 error );
+
+			result = 0;
+
+			goto on_error;
+		}
+		if( libpff_open_worker_set_descriptors_shard(
+		     shard_workers[ shard_index ],
+		     first_sub_node_index,
+		     ( number_of_sub_nodes / number_of_shards ) + ( shard_index < ( number_of_sub_nodes % number_of_shards ) ? 1 : 0 ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set descriptors shard: %d.",
+			 function,
+			 shard_index );
+
+			result = -1;
+
+			goto on_error;
+		}
+		first_sub_node_index += shard_workers[ shard_index ]->number_of_sub_nodes;
+	}
+	for( shard_index = 0;
+	     shard_index < number_of_shards;
+	     shard_index++ )
+	{
+		if( libpff_open_worker_start(
+		     shard_workers[ shard_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to start descriptors shard: %d.",
+			 function,
+			 shard_index );
+
+			result = -1;
+
+			goto on_error;
+		}
+	}
+	if( libcdata_array_initialize(
+	     &index_values_array,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create index values array.",
+		 function );
+
+		result = -1;
+
+		goto on_error;
+	}
+	/* The shards are joined in order, so that the index values are
+	 * in the order of the descriptors index
+	 */
+	for( shard_index = 0;
+	     shard_index < number_of_shards;
+	     shard_index++ )
+	{
+		if( libpff_open_worker_join(
+		     shard_workers[ shard_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read descriptors shard: %d.",
+			 function,
+			 shard_index );
+
+			result = -1;
+
+			goto on_error;
+		}
+		if( libcdata_array_get_number_of_entries(
+		     shard_workers[ shard_index ]->index_values_array,
+		     &number_of_index_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of index values of descriptors shard: %d.",
+			 function,
+			 shard_index );
+
+			result = -1;
+
+			goto on_error;
+		}
+		for( value_index = 0;
+		     value_index < number_of_index_values;
+		     value_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     shard_workers[ shard_index ]->index_values_array,
+			     value_index,
+			     (intptr_t **) &index_value,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve index value: %d of descriptors shard: %d.",
+				 function,
+				 value_index,
+				 shard_index );
+
+				result = -1;
+
+				goto on_error;
+			}
+			if( libcdata_array_append_entry(
+			     index_values_array,
+			     &entry_index,
+			     (intptr_t *) index_value,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append index value to array.",
+				 function );
+
+				result = -1;
+
+				goto on_error;
+			}
+			/* The index value is now managed by the index values array
+			 */
+			if( libcdata_array_set_entry_by_index(
+			     shard_workers[ shard_index ]->index_values_array,
+			     value_index,
+			     NULL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set index value: %d of descriptors shard: %d.",
+				 function,
+				 value_index,
+				 shard_index );
+
+				result = -1;
+
+				goto on_error;
+			}
+		}
+		if( libpff_open_worker_free(
+		     &( shard_workers[ shard_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free descriptors shard: %d.",
+			 function,
+			 shard_index );
+
+			result = -1;
+
+			goto on_error;
+		}
+	}
+	if( libpff_item_tree_create_from_index_values(
+	     internal_file->item_tree,
+	     index_values_array,
+	     internal_file->orphan_item_array,
+	     &( internal_file->root_folder_item_tree_node ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create item tree.",
+		 function );
+
+		result = -1;
+
+		goto on_error;
+	}
+	if( libcdata_array_free(
+	     &index_values_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_index_value_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free index values array.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	/* Freeing an open worker waits for its thread to finish
+	 */
+	for( shard_index = 0;
+	     shard_index < number_of_shards;
+	     shard_index++ )
+	{
+		if( shard_workers[ shard_index ] != NULL )
+		{
+			libpff_open_worker_free(
+			 &( shard_workers[ shard_index ] ),
+			 NULL );
+		}
+	}
+	if( index_values_array != NULL )
+	{
+		libcdata_array_free(
+		 &index_values_array,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libpff_index_value_free,
+		 NULL );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Opens a file for reading
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_internal_file_open_read(
+     libpff_internal_file_t *internal_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libpff_open_worker_t *open_worker = NULL;
+	static char *function             = "libpff_internal_file_open_read";
+	int result                        = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	size_t page_size                  = 0;
+#endif
+
+	if( internal_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->file_header != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file - file header value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->descriptors_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file - descriptors index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->offsets_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file - offsets index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->item_tree != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file - item tree value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->root_folder_item_tree_node != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file - root folder item tree root node value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->orphan_item_array != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file - orphan item array value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->name_to_id_map_list != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file - name to id map list value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_internal_file_read_file_header(
+	     internal_file,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file header.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_internal_file_create_indexes(
+	     internal_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create indexes.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( internal_file->io_handle->file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE )
+	{
+		page_size = 4096;
+	}
+	else
+	{
+		page_size = 512;
+	}
+	/* In a parallel open the name to ID map is read on a separate thread
+	 * while the item tree is created. The descriptors index is read in shards
+	 * on separate threads and the item tree nodes are linked to their parent
+	 * once all the shards have been read.
+	 */
+	if( ( internal_file->parallel_open != 0 )
+	 && ( internal_file->caller_io_handle == NULL ) )
+	{
+		if( libpff_open_worker_initialize(
+		     &open_worker,
+		     internal_file->io_handle,
+		     file_io_handle,
+		     internal_file->file_header,
+		     page_size,
+		     internal_file->name_to_id_map_list,
+		     error ) != 1 )
+		{
+			/* Fall back to reading the name to ID map on the calling thread,
+			 * for example if the file IO handle cannot be cloned
+			 */
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( ( libcnotify_verbose != 0 )
+			 && ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+#endif
+			libcerror_error_free(
+			 error );
+		}
+		else if( libpff_open_worker_start(
+		          open_worker,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to start open worker.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	if( libpff_item_tree_initialize(
+	     &( internal_file->item_tree ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create item tree.",
+		 function );
+
+		goto on_error;
+	}
+	result = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( internal_file->parallel_open != 0 )
+	 && ( internal_file->caller_io_handle == NULL ) )
+	{
+		result = libpff_internal_file_create_item_tree_in_shards(
+		          internal_file,
+		          file_io_handle,
+		          page_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create item tree in shards.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	if( result == 0 )
+	{
+		if( libpff_item_tree_create(
+		     internal_file->item_tree,
+		     file_io_handle,
+		     internal_file->descriptors_index,
+		     internal_file->orphan_item_array,
+		     &( internal_file->root_folder_item_tree_node ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create item tree.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "Name to ID map:\n" );
+	}
+#endif
+	if( open_worker != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libpff_open_worker_join(
+		     open_worker,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read name to id map.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		result = open_worker->name_to_id_map_result;
+
+		if( libpff_open_worker_free(
+		     &open_worker,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free open worker.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		result = libpff_name_to_id_map_read(
+			  internal_file->name_to_id_map_list,
+			  internal_file->io_handle,
+			  file_io_handle,
+			  internal_file->descriptors_index,
+			  internal_file->offsets_index,
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read name to id map.",
+			 function );
+
+			goto on_error;
+		}
+	}
+/* TODO flag missing name to id map if 0 */
+	return( 1 );
+
+on_error:
+	if( open_worker != NULL )
+	{
+		libpff_open_worker_free(
+		 &open_worker,
+		 NULL );
+	}
+	libpff_internal_file_free_open_values(
+	 internal_file,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Determines if a read is pending in caller driven mode
+ * Returns 1 if a read is pending, 0 if not or -1 on error
+ */
+int libpff_internal_file_has_pending_read(
+     libpff_internal_file_t *internal_file,
+     libcerror_error_t **error )
+{
+	static char *function       = "libpff_internal_file_has_pending_read";
+	off64_t pending_read_offset = 0;
+	size64_t pending_read_size  = 0;
+	int result                  = 0;
+
+	if( internal_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->caller_io_handle == NULL )
+	{
+		return( 0 );
+	}
+	result = libpff_caller_io_handle_get_pending_read(
+	          internal_file->caller_io_handle,
+	          &pending_read_offset,
+	          &pending_read_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve pending read.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Reads the descriptors index nodes in a caller driven open
+ * Every node is read once, so that all the data of the descriptors index
+ * has been supplied before the item tree is created. The nodes that remain
+ * to be read are kept in the caller open state when data needs to be supplied
+ * Returns 1 if successful, 0 if data needs to be supplied or -1 on error
+ */
+int libpff_internal_file_read_caller_driven_descriptors_index_nodes(
+     libpff_internal_file_t *internal_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libpff_index_node_t *index_node  = NULL;
+	uint64_t *sub_node_back_pointers = NULL;
+	uint64_t *sub_node_offsets       = NULL;
+	uint8_t *node_entries_data       = NULL;
+	static char *function            = "libpff_internal_file_read_caller_driven_descriptors_index_nodes";
+	off64_t element_data_offset      = 0;
+	off64_t node_offset              = 0;
+	uint16_t entry_index             = 0;
+	int level                        = 0;
+	int result                       = 0;
+
+	if( internal_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->caller_open_state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing caller open state.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->io_handle->format_functions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - invalid IO handle - missing format functions.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		result = libpff_caller_open_state_pop_index_node(
+		          internal_file->caller_open_state,
+		          &node_offset,
+		          &level,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve index node.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( libfdata_vector_get_element_value_at_offset(
+		     internal_file->index_nodes_vector,
+		     (intptr_t *) file_io_handle,
+		     (libfdata_cache_t *) internal_file->index_nodes_cache,
+		     node_offset,
+		     &element_data_offset,
+		     (intptr_t **) &index_node,
+		     0,
+		     error ) != 1 )
+		{
+			result = libpff_internal_file_has_pending_read(
+			          internal_file,
+			          NULL );
+
+			if( result == 1 )
+			{
+				/* The index node is read again after the data has been supplied
+				 */
+				if( libpff_caller_open_state_push_index_node(
+				     internal_file->caller_open_state,
+				     node_offset,
+				     level,
+				     NULL ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to push index node at offset: %" PRIi64 ".",
+					 function,
+					 node_offset );
+
+					return( -1 );
+				}
+				libcerror_error_free(
+				 error );
+
+				return( 0 );
+			}
+			/* Index nodes that cannot be read are handled when the item tree is created
+			 */
+			libcerror_error_free(
+			 error );
+
+			continue;
+		}
+		if( index_node == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing index node.",
+			 function );
+
+			return( -1 );
+		}
+		/* The level of the sub nodes is checked so that a corrupted index cannot loop
+		 */
+		if( ( index_node->type != LIBPFF_INDEX_TYPE_DESCRIPTOR )
+		 || ( index_node->level == LIBPFF_INDEX_NODE_LEVEL_LEAF )
+		 || ( ( level != -1 )
+		  &&  ( (int) index_node->level != level ) ) )
+		{
+			continue;
+		}
+		if( index_node->number_of_entries == 0 )
+		{
+			continue;
+		}
+		sub_node_back_pointers = (uint64_t *) memory_allocate(
+		                                       sizeof( uint64_t ) * index_node->number_of_entries );
+
+		if( sub_node_back_pointers == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create sub node back pointers.",
+			 function );
+
+			goto on_error;
+		}
+		sub_node_offsets = (uint64_t *) memory_allocate(
+		                                 sizeof( uint64_t ) * index_node->number_of_entries );
+
+		if( sub_node_offsets == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create sub node offsets.",
+			 function );
+
+			goto on_error;
+		}
+		if( libpff_index_node_get_entries_data(
+		     index_node,
+		     0,
+		     index_node->number_of_entries,
+		     internal_file->io_handle->format_functions->index_node_entry_size,
+		     &node_entries_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve node entries data.",
+			 function );
+
+			goto on_error;
+		}
+		internal_file->io_handle->format_functions->read_index_node_branch_entries(
+		 node_entries_data,
+		 index_node->number_of_entries,
+		 sub_node_back_pointers,
+		 sub_node_offsets );
+
+		for( entry_index = 0;
+		     entry_index < index_node->number_of_entries;
+		     entry_index++ )
+		{
+			if( sub_node_offsets[ entry_index ] > (uint64_t) INT64_MAX )
+			{
+				continue;
+			}
+			if( libpff_caller_open_state_push_index_node(
+			     internal_file->caller_open_state,
+			     (off64_t) sub_node_offsets[ entry_index ],
+			     (int) index_node->level - 1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push index node at offset: %" PRIu64 ".",
+				 function,
+				 sub_node_offsets[ entry_index ] );
+
+				goto on_error;
+			}
+		}
+		memory_free(
+		 sub_node_back_pointers );
+
+		sub_node_back_pointers = NULL;
+
+		memory_free(
+		 sub_node_offsets );
+
+		sub_node_offsets = NULL;
+	}
+	while( result != 0 );
+
+	return( 1 );
+
+on_error:
+	if( sub_node_offsets != NULL )
+	{
+		memory_free(
+		 sub_node_offsets );
+	}
+	if( sub_node_back_pointers != NULL )
+	{
+		memory_free(
+		 sub_node_back_pointers );
+	}
+	return( -1 );
+}
+
+/* Opens a file for reading in caller driven mode
+ * The values read are kept when data needs to be supplied, so that a retried
+ * open continues at the stage it stopped at instead of at the start of the file
+ * Returns 1 if successful, 0 if data needs to be supplied or -1 on error
+ */
+int libpff_internal_file_open_read_caller_driven(
+     libpff_internal_file_t *internal_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_internal_file_open_read_caller_driven";
+	int result            = 0;
+
+	if( internal_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->caller_open_state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing caller open state.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->caller_open_state->stage == LIBPFF_CALLER_OPEN_STAGE_FILE_HEADER )
+	{
+		if( libpff_internal_file_read_file_header(
+		     internal_file,
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			result = libpff_internal_file_has_pending_read(
+			          internal_file,
+			          NULL );
+
+			if( result == 1 )
+			{
+				libcerror_error_free(
+				 error );
+
+				if( libpff_file_header_free(
+				     &( internal_file->file_header ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free file header.",
+					 function );
+
+					return( -1 );
+				}
+				return( 0 );
+			}
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read file header.",
+			 function );
+
+			return( -1 );
+		}
+		if( libpff_internal_file_create_indexes(
+		     internal_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create indexes.",
+			 function );
+
+			return( -1 );
+		}
+		if( internal_file->file_header->descriptors_index_root_node_offset <= (uint64_t) INT64_MAX )
+		{
+			if( libpff_caller_open_state_push_index_node(
+			     internal_file->caller_open_state,
+			     (off64_t) internal_file->file_header->descriptors_index_root_node_offset,
+			     -1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push descriptors index root node.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		internal_file->caller_open_state->stage = LIBPFF_CALLER_OPEN_STAGE_DESCRIPTORS_INDEX;
+	}
+	if( internal_file->caller_open_state->stage == LIBPFF_CALLER_OPEN_STAGE_DESCRIPTORS_INDEX )
+	{
+		result = libpff_internal_file_read_caller_driven_descriptors_index_nodes(
+		          internal_file,
+		          file_io_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read descriptors index nodes.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+		internal_file->caller_open_state->stage = LIBPFF_CALLER_OPEN_STAGE_ITEM_TREE;
+	}
+	if( internal_file->caller_open_state->stage == LIBPFF_CALLER_OPEN_STAGE_ITEM_TREE )
+	{
+		if( libpff_item_tree_initialize(
+		     &( internal_file->item_tree ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create item tree.",
+			 function );
+
+			return( -1 );
+		}
+		result = libpff_item_tree_create(
+		          internal_file->item_tree,
+		          file_io_handle,
+		          internal_file->descriptors_index,
+		          internal_file->orphan_item_array,
+		          &( internal_file->root_folder_item_tree_node ),
+		          error );
+
+		if( result != 1 )
+		{
+			result = libpff_internal_file_has_pending_read(
+			          internal_file,
+			          NULL );
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create item tree.",
+				 function );
+
+				return( -1 );
+			}
+			libcerror_error_free(
+			 error );
+		}
+		else
+		{
+			/* The item tree ignores descriptors index nodes that cannot be read
+			 * hence check if one of them still needs data to be supplied
+			 */
+			result = libpff_internal_file_has_pending_read(
+			          internal_file,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if a read is pending.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( result != 0 )
+		{
+			/* The item tree is created again after the data has been supplied
+			 */
+			internal_file->root_folder_item_tree_node = NULL;
+
+			if( libpff_item_tree_free(
+			     &( internal_file->item_tree ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free item tree.",
+				 function );
+
+				return( -1 );
+			}
+			if( libcdata_array_empty(
+			     internal_file->orphan_item_array,
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_tree_node_free_recovered,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to empty orphan item array.",
+				 function );
+
+				return( -1 );
+			}
+			return( 0 );
+		}
+		internal_file->caller_open_state->stage = LIBPFF_CALLER_OPEN_STAGE_NAME_TO_ID_MAP;
+	}
+	if( internal_file->caller_open_state->stage == LIBPFF_CALLER_OPEN_STAGE_NAME_TO_ID_MAP )
+	{
+		result = libpff_name_to_id_map_read(
+			  internal_file->name_to_id_map_list,
+			  internal_file->io_handle,
+			  file_io_handle,
+			  internal_file->descriptors_index,
+			  internal_file->offsets_index,
+			  error );
+
+		if( result == -1 )
+		{
+			result = libpff_internal_file_has_pending_read(
+			          internal_file,
+			          NULL );
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read name to id map.",
+				 function );
+
+				return( -1 );
+			}
+			libcerror_error_free(
+			 error );
+		}
+		else
+		{
+			result = libpff_internal_file_has_pending_read(
+			          internal_file,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if a read is pending.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( result != 0 )
+		{
+			/* The name to ID map is read again after the data has been supplied
+			 */
+			if( libcdata_list_empty(
+			     internal_file->name_to_id_map_list,
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_name_to_id_map_entry_free,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to empty name to id map list.",
+				 function );
+
+				return( -1 );
+			}
+			return( 0 );
+		}
+		internal_file->caller_open_state->stage = LIBPFF_CALLER_OPEN_STAGE_DONE;
+	}
+	return( 1 );
+}
+
+/* Sets the access pattern of the reads that follow
+ * This only has effect for a file that was opened by name
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_internal_file_set_access_pattern(
+     libpff_internal_file_t *internal_file,
+     int access_pattern,
+     int *previous_access_pattern,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_internal_file_set_access_pattern";
+
+	if( internal_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( previous_access_pattern != NULL )
+	{
+		*previous_access_pattern = LIBPFF_ACCESS_PATTERN_NORMAL;
+	}
+#if defined( LIBPFF_HAVE_DESCRIPTOR_IO_HANDLE )
+	if( internal_file->descriptor_io_handle == NULL )
+	{
+		return( 1 );
+	}
+	if( previous_access_pattern != NULL )
+	{
+		if( libpff_descriptor_io_handle_get_access_pattern(
+		     internal_file->descriptor_io_handle,
+		     previous_access_pattern,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve access pattern from descriptor IO handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libpff_descriptor_io_handle_set_access_pattern(
+	     internal_file->descriptor_io_handle,
+	     access_pattern,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set access pattern in descriptor IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#endif /* defined( LIBPFF_HAVE_DESCRIPTOR_IO_HANDLE ) */
+
+	return( 1 );
+}
+
+/* Reads the allocation tables
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_internal_file_read_allocation_tables(
+     libpff_internal_file_t *internal_file,
+     libcerror_error_t **error )
+{
+	static char *function       = "libpff_internal_file_read_allocation_tables";
+	int previous_access_pattern = 0;
+
+	if( internal_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_file->io_handle->file_type != LIBPFF_FILE_TYPE_32BIT )
+	 && ( internal_file->io_handle->file_type != LIBPFF_FILE_TYPE_64BIT )
+	 && ( internal_file->io_handle->file_type != LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported file type.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->read_allocation_tables != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file - allocation tables already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->unallocated_data_block_list != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file - allocaled data block list already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->unallocated_page_block_list != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file - allocaled page block list already set.",
+		 function );
+
+		return( -1 );
+	}
+	/* The allocation tables are spread over the whole file and read only once
+	 */
+	if( libpff_internal_file_set_access_pattern(
+	     internal_file,
+	     LIBPFF_ACCESS_PATTERN_SCAN,
+	     &previous_access_pattern,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set access pattern.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "Reading the unallocated data blocks:\n" );
+	}
+#endif
+	if( libcdata_range_list_initialize(
+	     &( internal_file->unallocated_data_block_list ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create unallocated data block list.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_io_handle_read_unallocated_data_blocks(
+	     internal_file->io_handle,
+	     internal_file->file_io_handle,
+	     internal_file->unallocated_data_block_list,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read unallocated data blocks.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( internal_file->io_handle->file_type == LIBPFF_FILE_TYPE_32BIT )
+	 || ( internal_file->io_handle->file_type == LIBPFF_FILE_TYPE_64BIT ) )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "Reading the unallocated page blocks:\n" );
+		}
+#endif
+		if( libcdata_range_list_initialize(
+		     &( internal_file->unallocated_page_block_list ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create unallocated page block list.",
+			 function );
+
+			goto on_error;
+		}
+		if( libpff_io_handle_read_unallocated_page_blocks(
+		     internal_file->io_handle,
+		     internal_file->file_io_handle,
+		     internal_file->unallocated_page_block_list,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read unallocated page blocks.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libpff_internal_file_set_access_pattern(
+	     internal_file,
+	     previous_access_pattern,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to restore access pattern.",
+		 function );
+
+		goto on_error;
+	}
+	internal_file->read_allocation_tables = 1;
+
+	return( 1 );
+
+on_error:
+	libpff_internal_file_set_access_pattern(
+	 internal_file,
+	 previous_access_pattern,
+	 NULL,
+	 NULL );
+
+	if( internal_file->unallocated_page_block_list != NULL )
+	{
+		libcdata_range_list_free(
+		 &( internal_file->unallocated_page_block_list ),
+		 NULL,
+		 NULL );
+	}
+	if( internal_file->unallocated_data_block_list != NULL )
+	{
+		libcdata_range_list_free(
+		 &( internal_file->unallocated_data_block_list ),
+		 NULL,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Refreshes a file that is still being written to
+ * The file header is read again and when the index root nodes changed the indexes,
+ * the item tree and, if its data changed, the name to id map are updated.
+ * Only the descriptors index nodes that were rewritten are read and the item tree
+ * is updated with the changed descriptors, or created again if the changes cannot
+ * be applied as an update. The new state is prepared first and only replaces the
+ * current state once nothing can fail, hence on error the file is left unchanged.
+ * Recovered items are discarded and can be recovered again.
+ * Items retrieved before the refresh are invalidated and must be freed beforehand
+ * Returns 1 if the file was refreshed, 0 if the file did not change or -1 on error
+ */
+int libpff_file_refresh(
+     libpff_file_t *file,
+     libcerror_error_t **error )
+{
+	libcdata_array_t *orphan_item_array                         = NULL;
+	libcdata_array_t *previous_orphan_item_array                = NULL;
+	libcdata_array_t *previous_recovered_item_array             = NULL;
+	libcdata_list_t *name_to_id_map_list                        = NULL;
+	libcdata_list_t *previous_name_to_id_map_list               = NULL;
+	libcdata_range_list_t *previous_unallocated_data_block_list = NULL;
+	libcdata_range_list_t *previous_unallocated_page_block_list = NULL;
+	libcdata_tree_node_t *root_folder_item_tree_node            = NULL;
+	libpff_descriptors_index_t *descriptors_index               = NULL;
+	libpff_file_header_t *file_header                           = NULL;
+	libpff_file_header_t *previous_file_header                  = NULL;
+	libpff_index_layout_t *descriptors_index_layout             = NULL;
+	libpff_index_layout_t *previous_descriptors_index_layout    = NULL;
+	libpff_index_value_t *index_value                           = NULL;
+	libpff_internal_file_t *internal_file                       = NULL;
+	libpff_item_tree_t *item_tree                               = NULL;
+	libpff_item_tree_t *previous_item_tree                      = NULL;
+	libpff_item_tree_update_t *item_tree_update                 = NULL;
+	libpff_offsets_index_t *offsets_index                       = NULL;
+	static char *function                                       = "libpff_file_refresh";
+	size64_t file_size                                          = 0;
+	uint64_t name_to_id_map_data_identifier                     = 0;
+	uint64_t name_to_id_map_local_descriptors_identifier        = 0;
+	uint8_t file_size_changed                                   = 0;
+	uint8_t indexes_swapped                                     = 0;
+	int name_to_id_map_changed                                  = 0;
+	int result                                                  = 0;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libpff_internal_file_t *) file;
+
+	if( libpff_io_handle_clear_pending_read(
+	     internal_file->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to clear pending read.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->file_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing file header.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_file_header_initialize(
+	     &file_header,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file header.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_file_header_read_file_io_handle(
+	     file_header,
+	     internal_file->file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file header data.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( file_header->file_type != internal_file->file_header->file_type )
+	 || ( file_header->encryption_type != internal_file->file_header->encryption_type ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported file type or encryption type change.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( file_header->file_size == internal_file->file_header->file_size )
+	 && ( file_header->descriptors_index_root_node_offset == internal_file->file_header->descriptors_index_root_node_offset )
+	 && ( file_header->descriptors_index_root_node_back_pointer == internal_file->file_header->descriptors_index_root_node_back_pointer )
+	 && ( file_header->offsets_index_root_node_offset == internal_file->file_header->offsets_index_root_node_offset )
+	 && ( file_header->offsets_index_root_node_back_pointer == internal_file->file_header->offsets_index_root_node_back_pointer ) )
+	{
+		if( libpff_file_header_free(
+		     &file_header,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file header.",
+			 function );
+
+			goto on_error;
+		}
+		return( 0 );
+	}
+	/* Determine the current name to id map data to detect if it changed
+	 */
+	result = libpff_descriptors_index_get_index_value_by_identifier(
+		  internal_file->descriptors_index,
+		  internal_file->file_io_handle,
+		  (uint32_t) LIBPFF_DESCRIPTOR_IDENTIFIER_NAME_TO_ID_MAP,
+		  0,
+		  &index_value,
+		  error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve name to id map descriptor index value.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		name_to_id_map_data_identifier              = index_value->data_identifier;
+		name_to_id_map_local_descriptors_identifier = index_value->local_descriptors_identifier;
+	}
+	/* The layout of the current descriptors index is determined on the first refresh,
+	 * if this fails the item tree is created again
+	 */
+	if( internal_file->descriptors_index_layout == NULL )
+	{
+		if( libpff_index_layout_initialize(
+		     &( internal_file->descriptors_index_layout ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create descriptors index layout.",
+			 function );
+
+			goto on_error;
+		}
+		if( libpff_index_layout_read(
+		     internal_file->descriptors_index_layout,
+		     NULL,
+		     internal_file->io_handle,
+		     internal_file->file_io_handle,
+		     internal_file->index_nodes_vector,
+		     internal_file->index_nodes_cache,
+		     internal_file->file_header->descriptors_index_root_node_offset,
+		     internal_file->file_header->descriptors_index_root_node_back_pointer,
+		     error ) != 1 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( ( libcnotify_verbose != 0 )
+			 && ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+#endif
+			libcerror_error_free(
+			 error );
+
+			libpff_index_layout_free(
+			 &( internal_file->descriptors_index_layout ),
+			 NULL );
+		}
+		else if( libpff_index_layout_clear_changes(
+		          internal_file->descriptors_index_layout,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to clear changes of descriptors index layout.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* The new root nodes are set in separate indexes that are swapped
+	 * with the current indexes, since these are referenced elsewhere
+	 */
+	if( libpff_descriptors_index_initialize(
+	     &descriptors_index,
+	     internal_file->io_handle,
+	     internal_file->index_nodes_vector,
+	     internal_file->index_nodes_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create descriptors index.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_descriptors_index_set_root_node(
+	     descriptors_index,
+	     file_header->descriptors_index_root_node_offset,
+	     file_header->descriptors_index_root_node_back_pointer,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set descriptors index root node.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_offsets_index_initialize(
+	     &offsets_index,
+	     internal_file->io_handle,
+	     internal_file->index_nodes_vector,
+	     internal_file->index_nodes_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create offsets index.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_offsets_index_set_root_node(
+	     offsets_index,
+	     file_header->offsets_index_root_node_offset,
+	     file_header->offsets_index_root_node_back_pointer,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set offsets index root node.",
+		 function );
+
+		goto on_error;
+	}
+	file_size                           = internal_file->io_handle->file_size;
+	internal_file->io_handle->file_size = file_header->file_size;
+	file_size_changed                   = 1;
+
+	if( libfdata_vector_set_segment_by_index(
+	     internal_file->index_nodes_vector,
+	     0,
+	     0,
+	     0,
+	     internal_file->io_handle->file_size,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set segment in index nodes vector.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_descriptors_index_swap_root_node(
+	     internal_file->descriptors_index,
+	     descriptors_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to swap descriptors index root node.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_offsets_index_swap_root_node(
+	     internal_file->offsets_index,
+	     offsets_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to swap offsets index root node.",
+		 function );
+
+		libpff_descriptors_index_swap_root_node(
+		 internal_file->descriptors_index,
+		 descriptors_index,
+		 NULL );
+
+		goto on_error;
+	}
+	indexes_swapped = 1;
+
+	result = libpff_descriptors_index_get_index_value_by_identifier(
+		  internal_file->descriptors_index,
+		  internal_file->file_io_handle,
+		  (uint32_t) LIBPFF_DESCRIPTOR_IDENTIFIER_NAME_TO_ID_MAP,
+		  0,
+		  &index_value,
+		  error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve name to id map descriptor index value.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( name_to_id_map_data_identifier != 0 )
+		{
+			name_to_id_map_changed = 1;
+		}
+	}
+	else if( ( index_value->data_identifier != name_to_id_map_data_identifier )
+	      || ( index_value->local_descriptors_identifier != name_to_id_map_local_descriptors_identifier ) )
+	{
+		name_to_id_map_changed = 1;
+	}
+	/* Only read the descriptors index nodes that were rewritten
+	 * and update the item tree with the changed descriptors
+	 */
+	if( internal_file->descriptors_index_layout != NULL )
+	{
+		if( libpff_index_layout_initialize(
+		     &descriptors_index_layout,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create descriptors index layout.",
+			 function );
+
+			goto on_error;
+		}
+		if( libpff_index_layout_read(
+		     descriptors_index_layout,
+		     internal_file->descriptors_index_layout,
+		     internal_file->io_handle,
+		     internal_file->file_io_handle,
+		     internal_file->index_nodes_vector,
+		     internal_file->index_nodes_cache,
+		     file_header->descriptors_index_root_node_offset,
+		     file_header->descriptors_index_root_node_back_pointer,
+		     error ) != 1 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( ( libcnotify_verbose != 0 )
+			 && ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+#endif
+			libcerror_error_free(
+			 error );
+
+			libpff_index_layout_free(
+			 &descriptors_index_layout,
+			 NULL );
+		}
+	}
+	if( descriptors_index_layout != NULL )
+	{
+		if( libpff_item_tree_update_initialize(
+		     &item_tree_update,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create item tree update.",
+			 function );
+
+			goto on_error;
+		}
+		result = libpff_item_tree_update_prepare(
+		          item_tree_update,
+		          internal_file->item_tree,
+		          internal_file->root_folder_item_tree_node,
+		          internal_file->orphan_item_array,
+		          descriptors_index_layout,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to prepare item tree update.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			if( libpff_item_tree_update_free(
+			     &item_tree_update,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free item tree update.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	if( item_tree_update == NULL )
+	{
+		if( libcdata_array_initialize(
+		     &orphan_item_array,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create orphan item array.",
+			 function );
+
+			goto on_error;
+		}
+		if( libpff_item_tree_initialize(
+		     &item_tree,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create item tree.",
+			 function );
+
+			goto on_error;
+		}
+		if( libpff_item_tree_create(
+		     item_tree,
+		     internal_file->file_io_handle,
+		     internal_file->descriptors_index,
+		     orphan_item_array,
+		     &root_folder_item_tree_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create item tree.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( name_to_id_map_changed != 0 )
+	{
+		if( libcdata_list_initialize(
+		     &name_to_id_map_list,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create name to id map list.",
+			 function );
+
+			goto on_error;
+		}
+		result = libpff_name_to_id_map_read(
+			  name_to_id_map_list,
+			  internal_file->io_handle,
+			  internal_file->file_io_handle,
+			  internal_file->descriptors_index,
+			  internal_file->offsets_index,
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read name to id map.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( item_tree_update != NULL )
+	{
+		if( libpff_item_tree_update_commit(
+		     item_tree_update,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to commit item tree update.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* From here on the current state is replaced, which cannot fail
+	 */
+	if( item_tree != NULL )
+	{
+		previous_item_tree                        = internal_file->item_tree;
+		internal_file->item_tree                  = item_tree;
+		item_tree                                 = NULL;
+		internal_file->root_folder_item_tree_node = root_folder_item_tree_node;
+		root_folder_item_tree_node                = NULL;
+
+		previous_orphan_item_array       = internal_file->orphan_item_array;
+		internal_file->orphan_item_array = orphan_item_array;
+		orphan_item_array                = NULL;
+	}
+	if( name_to_id_map_list != NULL )
+	{
+		previous_name_to_id_map_list       = internal_file->name_to_id_map_list;
+		internal_file->name_to_id_map_list = name_to_id_map_list;
+		name_to_id_map_list                = NULL;
+
+		/* Invalidate the property sets prepared against the previous name to ID map
+		 */
+		internal_file->io_handle->name_to_id_map_generation += 1;
+	}
+	previous_file_header       = internal_file->file_header;
+	internal_file->file_header = file_header;
+	file_header                = NULL;
+
+	previous_descriptors_index_layout       = internal_file->descriptors_index_layout;
+	internal_file->descriptors_index_layout = descriptors_index_layout;
+	descriptors_index_layout                = NULL;
+
+	/* The recovered items refer to the previous indexes and are recovered again when needed
+	 */
+	previous_recovered_item_array       = internal_file->recovered_item_array;
+	internal_file->recovered_item_array = NULL;
+
+	/* The allocation tables are read again when needed
+	 */
+	previous_unallocated_data_block_list       = internal_file->unallocated_data_block_list;
+	internal_file->unallocated_data_block_list = NULL;
+	previous_unallocated_page_block_list       = internal_file->unallocated_page_block_list;
+	internal_file->unallocated_page_block_list = NULL;
+	internal_file->read_allocation_tables      = 0;
+
+	/* Free the replaced values, the separate indexes now contain the previous root nodes
+	 */
+	result = 1;
+
+	if( internal_file->descriptors_index_layout != NULL )
+	{
+		if( libpff_index_layout_clear_changes(
+		     internal_file->descriptors_index_layout,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to clear changes of descriptors index layout.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( previous_descriptors_index_layout != NULL )
+	{
+		if( libpff_index_layout_free(
+		     &previous_descriptors_index_layout,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free previous descriptors index layout.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( item_tree_update != NULL )
+	{
+		if( libpff_item_tree_update_free(
+		     &item_tree_update,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free item tree update.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( previous_item_tree != NULL )
+	{
+		if( libpff_item_tree_free(
+		     &previous_item_tree,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free previous item tree.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( previous_orphan_item_array != NULL )
+	{
+		if( libcdata_array_free(
+		     &previous_orphan_item_array,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_tree_node_free_recovered,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free previous orphan item array.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( previous_recovered_item_array != NULL )
+	{
+		if( libcdata_array_free(
+		     &previous_recovered_item_array,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_tree_node_free_recovered,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free previous recovered item array.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( previous_name_to_id_map_list != NULL )
+	{
+		if( libcdata_list_free(
+		     &previous_name_to_id_map_list,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_name_to_id_map_entry_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free previous name to id map list.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( previous_unallocated_data_block_list != NULL )
+	{
+		if( libcdata_range_list_free(
+		     &previous_unallocated_data_block_list,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free previous unallocated data block list.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( previous_unallocated_page_block_list != NULL )
+	{
+		if( libcdata_range_list_free(
+		     &previous_unallocated_page_block_list,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free previous unallocated page block list.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libpff_file_header_free(
+	     &previous_file_header,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free previous file header.",
+		 function );
+
+		result = -1;
+	}
+	if( libpff_offsets_index_free(
+	     &offsets_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free previous offsets index.",
+		 function );
+
+		result = -1;
+	}
+	if( libpff_descriptors_index_free(
+	     &descriptors_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free previous descriptors index.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+
+on_error:
+	/* Restore the current state
+	 */
+	if( indexes_swapped != 0 )
+	{
+		libpff_offsets_index_swap_root_node(
+		 internal_file->offsets_index,
+		 offsets_index,
+		 NULL );
+
+		libpff_descriptors_index_swap_root_node(
+		 internal_file->descriptors_index,
+		 descriptors_index,
+		 NULL );
+	}
+	if( file_size_changed != 0 )
+	{
+		internal_file->io_handle->file_size = file_size;
+
+		libfdata_vector_set_segment_by_index(
+		 internal_file->index_nodes_vector,
+		 0,
+		 0,
+		 0,
+		 file_size,
+		 0,
+		 NULL );
+	}
+	if( name_to_id_map_list != NULL )
+	{
+		libcdata_list_free(
+		 &name_to_id_map_list,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libpff_name_to_id_map_entry_free,
+		 NULL );
+	}
+	if( item_tree != NULL )
+	{
+		libpff_item_tree_free(
+		 &item_tree,
+		 NULL );
+	}
+	if( orphan_item_array != NULL )
+	{
+		libcdata_array_free(
+		 &orphan_item_array,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_tree_node_free_recovered,
+		 NULL );
+	}
+	if( item_tree_update != NULL )
+	{
+		libpff_item_tree_update_free(
+		 &item_tree_update,
+		 NULL );
+	}
+	if( descriptors_index_layout != NULL )
+	{
+		libpff_index_layout_free(
+		 &descriptors_index_layout,
+		 NULL );
+	}
+	if( offsets_index != NULL )
+	{
+		libpff_offsets_index_free(
+		 &offsets_index,
+		 NULL );
+	}
+	if( descriptors_index != NULL )
+	{
+		libpff_descriptors_index_free(
+		 &descriptors_index,
+		 NULL );
+	}
+	if( file_header != NULL )
+	{
+		libpff_file_header_free(
+		 &file_header,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Determine if the file corrupted
+ * Returns 1 if corrupted, 0 if not or -1 on error
+ */
+int libpff_file_is_corrupted(
+     libpff_file_t *file,
+     libcerror_error_t **error )
+{
+	libpff_internal_file_t *internal_file = NULL;
+	static char *function                 = "libpff_file_is_corrupted";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libpff_internal_file_t *) file;
+
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_file->io_handle->flags & LIBPFF_IO_HANDLE_FLAG_IS_CORRUPTED ) != 0 )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Recovers deleted items
+ * By default only the unallocated space is checked for recoverable items
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_file_recover_items(
+     libpff_file_t *file,
+     uint8_t recovery_flags,
+     libcerror_error_t **error )
+{
+	libpff_internal_file_t *internal_file = NULL;
+	static char *function                 = "libpff_file_recover_items";
+	int previous_access_pattern           = 0;
+	int result                            = 0;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libpff_internal_file_t *) file;
+
+	if( libpff_io_handle_clear_pending_read(
+	     internal_file->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to clear pending read.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->recovered_item_array != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file - recovered item array already set.",
+		 function );
+
+		return( -1 );
+	}
+	/* Recovering items reads the unallocated and index data of the whole file
+	 */
+	if( libpff_internal_file_set_access_pattern(
+	     internal_file,
+	     LIBPFF_ACCESS_PATTERN_SCAN,
+	     &previous_access_pattern,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set access pattern.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->read_allocation_tables == 0 )
+	{
+		if( libpff_internal_file_read_allocation_tables(
+		     internal_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read allocation tables.",
+			 function );
+
+			if( internal_file->io_handle->read_limits_exceeded != 0 )
+			{
+				libpff_internal_file_set_access_pattern(
+				 internal_file,
+				 previous_access_pattern,
+				 NULL,
+				 NULL );
+
+				return( -1 );
+			}
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+#endif
+			libcerror_error_free(
+			 error );
+
+/* TODO set recovery_flags |= LIBPFF_RECOVERY_FLAG_IGNORE_ALLOCATION_DATA ? */
+		}
+	}
+	if( libcdata_array_initialize(
+	     &( internal_file->recovered_item_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create recovered item array.",
+		 function );
+
+		libpff_internal_file_set_access_pattern(
+		 internal_file,
+		 previous_access_pattern,
+		 NULL,
+		 NULL );
+
+		return( -1 );
+	}
+	result = libpff_recover_items(
+	          internal_file->io_handle,
+	          internal_file->file_io_handle,
+	          internal_file->descriptors_index,
+	          internal_file->offsets_index,
+	          internal_file->unallocated_data_block_list,
+	          internal_file->unallocated_page_block_list,
+	          internal_file->recovered_item_array,
+	          recovery_flags,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to recover items.",
+		 function );
+	}
+	if( libpff_internal_file_set_access_pattern(
+	     internal_file,
+	     previous_access_pattern,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to restore access pattern.",
+		 function );
+
+		result = -1;
+	}
+        if( internal_file->io_handle->abort != 0 )
+        {
+                internal_file->io_handle->abort = 0;
+        }
+	return( result );
+}
+
+/* Retrieves the file size
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libpff_file_get_size(
+     libpff_file_t *file,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	libpff_internal_file_t *internal_file = NULL;
+	static char *function                 = "libpff_file_get_size";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libpff_internal_file_t *) file;
+
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->file_io_handle == NULL )
+	{
+		return( 0 );
+	}
+	*size = internal_file->io_handle->file_size;
+
+	return( 1 );
+}
+
+/* Retrieves the content type
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libpff_file_get_content_type(
+     libpff_file_t *file,
+     uint8_t *content_type,
+     libcerror_error_t **error )
+{
+	libpff_internal_file_t *internal_file = NULL;
+	static char *function                 = "libpff_file_get_content_type";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libpff_internal_file_t *) file;
+
+	if( internal_file->file_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing file header.",
+		 function );
+
+		return( -1 );
+	}
+	if( content_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid content type.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->file_io_handle == NULL )
+	{
+		return( 0 );
+	}
+	*content_type = (uint8_t) internal_file->file_header->file_content_type;
+
+	return( 1 );
+}
+
+/* Retrieves the file type
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libpff_file_get_type(
+     libpff_file_t *file,
+     uint8_t *type,
+     libcerror_error_t **error )
+{
+	libpff_internal_file_t *internal_file = NULL;
+	static char *function                 = "libpff_file_get_type";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libpff_internal_file_t *) file;
+
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid type.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->file_io_handle == NULL )
+	{
+		return( 0 );
+	}
+	*type = internal_file->io_handle->file_type;
+
+	return( 1 );
+}
+
+/* Retrieves the encryption type
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libpff_file_get_encryption_type(
+     libpff_file_t *file,
+     uint8_t *encryption_type,
+     libcerror_error_t **error )
+{
+	libpff_internal_file_t *internal_file = NULL;
+	static char *function                 = "libpff_file_get_encryption_type";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libpff_internal_file_t *) file;
+
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( encryption_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encryption type.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->file_io_handle == NULL )
+	{
+		return( 0 );
+	}
+	*encryption_type = internal_file->io_handle->encryption_type;
+
+	return( 1 );
+}
+
+/* Retrieves the ASCII codepage
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_file_get_ascii_codepage(
+     libpff_file_t *file,
+     int *ascii_codepage,
+     libcerror_error_t **error )
+{
+	libpff_internal_file_t *internal_file = NULL;
+	static char *function                 = "libpff_file_get_ascii_codepage";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libpff_internal_file_t *) file;
+
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ascii_codepage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ASCII codepage.",
+		 function );
+
+		return( -1 );
+	}
+	*ascii_codepage = internal_file->io_handle->ascii_codepage;
+
+	return( 1 );
+}
+
+/* Sets the ASCII codepage
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_file_set_ascii_codepage(
+     libpff_file_t *file,
+     int ascii_codepage,
+     libcerror_error_t **error )
+{
+	libpff_internal_file_t *internal_file = NULL;
+	static char *function                 = "libpff_file_set_ascii_codepage";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libpff_internal_file_t *) file;
+
+	if( internal_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ascii_codepage != LIBPFF_CODEPAGE_ASCII )
+	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_874 )
+	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_932 )
+	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_936 )
+	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_949 )
+	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_950 )
+	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_1250 )
+	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_1251 )
+	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_1252 )
+	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_1253 )
+	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_1254 )
+	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_1255 )
+	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_1256 )
+	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_1257 )
+	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_1258 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported ASCII codepage.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file->io_handle->ascii_codepage = ascii_codepage;
+
+	return( 1 );
+}
+
+/* Retrieves the number of unallocated blocks
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_file_get_number_of_unallocated_blocks(
+     libpff_file_t *file,
+     int unallocated_block_type,
+     int *number_of_unallocated_blocks,
+     libcerror_error_t **error )
+{
+	libcdata_range_list_t *unallocated_block_list = NULL;
+	libpff_internal_file_t *internal_file         = NULL;
+	static char *function                         = "libpff_file_get_number_of_unallocated_blocks";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( unallocated_block_type != LIBPFF_UNALLOCATED_BLOCK_TYPE_DATA )
+	 && ( unallocated_block_type != LIBPFF_UNALLOCATED_BLOCK_TYPE_PAGE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported unallocated block type.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libpff_item_tree_initialize(
-	     &( internal_file->item_tree ),
+	internal_file = (libpff_internal_file_t *) file;
+
+	if( libpff_io_handle_clear_pending_read(
+	     internal_file->io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create item tree.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to clear pending read.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libpff_item_tree_create(
-             internal_file->item_tree,
-	     file_io_handle,
-	     internal_file->descriptors_index,
-	     internal_file->orphan_item_list,
-	     &( internal_file->root_folder_item_tree_node ),
-	     error ) != 1 )
+	if( internal_file->read_allocation_tables == 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create item tree.",
-		 function );
+		if( libpff_internal_file_read_allocation_tables(
+		     internal_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read allocation tables.",
+			 function );
 
-		goto on_error;
+			return( -1 );
+		}
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( unallocated_block_type == LIBPFF_UNALLOCATED_BLOCK_TYPE_DATA )
 	{
-		libcnotify_printf(
-		 "Name to ID map:\n" );
+		unallocated_block_list = internal_file->unallocated_data_block_list;
 	}
-#endif
-	if( libcdata_list_initialize(
-	     &( internal_file->name_to_id_map_list ),
-	     error ) != 1 )
+	else if( unallocated_block_type == LIBPFF_UNALLOCATED_BLOCK_TYPE_PAGE )
+	{
+		unallocated_block_list = internal_file->unallocated_page_block_list;
+	}
+	if( unallocated_block_list == NULL )
+	{
+		if( number_of_unallocated_blocks == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid number of unallocated blocks.",
+			 function );
+
+			return( -1 );
+		}
+		*number_of_unallocated_blocks = 0;
+	}
+	else
+	{
+		if( libcdata_range_list_get_number_of_elements(
+		     unallocated_block_list,
+		     number_of_unallocated_blocks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of unallocated blocks.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves a specific unallocated block
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_file_get_unallocated_block(
+     libpff_file_t *file,
+     int unallocated_block_type,
+     int unallocated_block_index,
+     off64_t *offset,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	libcdata_range_list_t *unallocated_block_list = NULL;
+	libpff_internal_file_t *internal_file         = NULL;
+	intptr_t *value                               = NULL;
+	static char *function                         = "libpff_file_get_unallocated_block";
+
+	if( file == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create name to id map list.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	result = libpff_name_to_id_map_read(
-		  internal_file->name_to_id_map_list,
-		  internal_file->io_handle,
-		  file_io_handle,
-		  internal_file->descriptors_index,
-		  internal_file->offsets_index,
-		  error );
-
-	if( result == -1 )
+	if( ( unallocated_block_type != LIBPFF_UNALLOCATED_BLOCK_TYPE_DATA )
+	 && ( unallocated_block_type != LIBPFF_UNALLOCATED_BLOCK_TYPE_PAGE ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read name to id map.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported unallocated block type.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-/* TODO flag missing name to id map if 0 */
-	return( 1 );
+	internal_file = (libpff_internal_file_t *) file;
 
-on_error:
-	if( internal_file->name_to_id_map_list != NULL )
+	if( libpff_io_handle_clear_pending_read(
+	     internal_file->io_handle,
+	     error ) != 1 )
 	{
-		libcdata_list_free(
-		 &( internal_file->name_to_id_map_list ),
-		 (int (*)(intptr_t **, libcerror_error_t **)) &libpff_name_to_id_map_entry_free,
-		 NULL );
-	}
-	internal_file->root_folder_item_tree_node = NULL;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to clear pending read.",
+		 function );
 
-	if( internal_file->orphan_item_list != NULL )
-	{
-		libcdata_list_free(
-		 &( internal_file->orphan_item_list ),
-		 (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_tree_node_free_recovered,
-		 NULL );
-	}
-	if( internal_file->item_tree != NULL )
-	{
-		libpff_item_tree_free(
-		 &( internal_file->item_tree ),
-		 NULL );
+		return( -1 );
 	}
-	if( internal_file->offsets_index != NULL )
+	if( unallocated_block_type == LIBPFF_UNALLOCATED_BLOCK_TYPE_DATA )
 	{
-		libpff_offsets_index_free(
-		 &( internal_file->offsets_index ),
-		 NULL );
+		unallocated_block_list = internal_file->unallocated_data_block_list;
 	}
-	if( internal_file->descriptors_index != NULL )
+	else if( unallocated_block_type == LIBPFF_UNALLOCATED_BLOCK_TYPE_PAGE )
 	{
-		libpff_descriptors_index_free(
-		 &( internal_file->descriptors_index ),
-		 NULL );
+		unallocated_block_list = internal_file->unallocated_page_block_list;
 	}
-	if( internal_file->index_nodes_cache != NULL )
+	if( unallocated_block_list == NULL )
 	{
-		libfcache_cache_free(
-		 &( internal_file->index_nodes_cache ),
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing unallocated block list.",
+		 function );
+
+		return( -1 );
 	}
-	if( internal_file->index_nodes_vector != NULL )
+	if( internal_file->read_allocation_tables == 0 )
 	{
-		libfdata_vector_free(
-		 &( internal_file->index_nodes_vector ),
-		 NULL );
+		if( libpff_internal_file_read_allocation_tables(
+		     internal_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read allocation tables.",
+			 function );
+
+			return( -1 );
+		}
 	}
-	if( internal_file->file_header != NULL )
+	if( libcdata_range_list_get_range_by_index(
+	     unallocated_block_list,
+	     unallocated_block_index,
+	     (uint64_t *) offset,
+	     (uint64_t *) size,
+	     &value,
+	     error ) != 1 )
 	{
-		libpff_file_header_free(
-		 &( internal_file->file_header ),
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve range list element: %d.",
+		 function,
+		 unallocated_block_index );
+
+		return( -1 );
 	}
-	return( -1 );
+	return( 1 );
 }
 
-/* Reads the allocation tables
+/* Retrieves the allocation statistics
+ * The allocation statistics are read from the data allocation tables (AMap)
+ * using multiple threads, the allocation statistics are not cached
  * Returns 1 if successful or -1 on error
  */
-int libpff_internal_file_read_allocation_tables(
-     libpff_internal_file_t *internal_file,
+int libpff_file_get_allocation_statistics(
+     libpff_file_t *file,
+     int number_of_threads,
+     libpff_allocation_statistics_t **allocation_statistics,
      libcerror_error_t **error )
 {
-	static char *function = "libpff_internal_file_read_allocation_tables";
+	libpff_internal_file_t *internal_file = NULL;
+	static char *function                 = "libpff_file_get_allocation_statistics";
+	size32_t allocation_unit_size         = 0;
 
-	if( internal_file == NULL )
+	if( file == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -1342,6 +5556,8 @@ int libpff_internal_file_read_allocation_tables(
 
 		return( -1 );
 	}
+	internal_file = (libpff_internal_file_t *) file;
+
 	if( internal_file->io_handle == NULL )
 	{
 		libcerror_error_set(
@@ -1353,157 +5569,136 @@ int libpff_internal_file_read_allocation_tables(
 
 		return( -1 );
 	}
-	if( ( internal_file->io_handle->file_type != LIBPFF_FILE_TYPE_32BIT )
-	 && ( internal_file->io_handle->file_type != LIBPFF_FILE_TYPE_64BIT )
-	 && ( internal_file->io_handle->file_type != LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
+	if( internal_file->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBPFF_MAXIMUM_NUMBER_OF_VISIT_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( number_of_threads > 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported file type.",
+		 "%s: multi-threading is not supported.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_file->read_allocation_tables != 0 )
+#endif
+	if( ( number_of_threads > 1 )
+	 && ( internal_file->caller_io_handle != NULL ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file - allocation tables already set.",
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid file - unsupported caller IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_file->unallocated_data_block_list != NULL )
+	if( allocation_statistics == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file - allocaled data block list already set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation statistics.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_file->unallocated_page_block_list != NULL )
+	if( *allocation_statistics != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file - allocaled page block list already set.",
+		 "%s: allocation statistics already set.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( internal_file->io_handle->file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE )
 	{
-		libcnotify_printf(
-		 "Reading the unallocated data blocks:\n" );
+		allocation_unit_size = 512;
 	}
-#endif
-	if( libcdata_range_list_initialize(
-	     &( internal_file->unallocated_data_block_list ),
+	else
+	{
+		allocation_unit_size = 64;
+	}
+	if( libpff_allocation_statistics_initialize(
+	     allocation_statistics,
+	     allocation_unit_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create unallocated data block list.",
+		 "%s: unable to create allocation statistics.",
 		 function );
 
 		goto on_error;
 	}
-	if( libpff_io_handle_read_unallocated_data_blocks(
+	if( libpff_allocation_statistics_read_file_io_handle(
+	     *allocation_statistics,
 	     internal_file->io_handle,
 	     internal_file->file_io_handle,
-	     internal_file->unallocated_data_block_list,
+	     number_of_threads,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read unallocated data blocks.",
+		 "%s: unable to read allocation statistics.",
 		 function );
 
 		goto on_error;
 	}
-	if( ( internal_file->io_handle->file_type == LIBPFF_FILE_TYPE_32BIT )
-	 || ( internal_file->io_handle->file_type == LIBPFF_FILE_TYPE_64BIT ) )
-	{
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "Reading the unallocated page blocks:\n" );
-		}
-#endif
-		if( libcdata_range_list_initialize(
-		     &( internal_file->unallocated_page_block_list ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create unallocated page block list.",
-			 function );
-
-			goto on_error;
-		}
-		if( libpff_io_handle_read_unallocated_page_blocks(
-		     internal_file->io_handle,
-		     internal_file->file_io_handle,
-		     internal_file->unallocated_page_block_list,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read unallocated page blocks.",
-			 function );
-
-			goto on_error;
-		}
-	}
-	internal_file->read_allocation_tables = 1;
-
 	return( 1 );
 
 on_error:
-	if( internal_file->unallocated_page_block_list != NULL )
-	{
-		libcdata_range_list_free(
-		 &( internal_file->unallocated_page_block_list ),
-		 NULL,
-		 NULL );
-	}
-	if( internal_file->unallocated_data_block_list != NULL )
+	if( *allocation_statistics != NULL )
 	{
-		libcdata_range_list_free(
-		 &( internal_file->unallocated_data_block_list ),
-		 NULL,
+		libpff_allocation_statistics_free(
+		 allocation_statistics,
 		 NULL );
 	}
 	return( -1 );
 }
 
-/* Determine if the file corrupted
- * Returns 1 if corrupted, 0 if not or -1 on error
+/* Retrieves the root item
+ * Returns 1 if successful or -1 on error
  */
-int libpff_file_is_corrupted(
+int libpff_file_get_root_item(
      libpff_file_t *file,
+     libpff_item_t **root_item,
      libcerror_error_t **error )
 {
 	libpff_internal_file_t *internal_file = NULL;
-	static char *function                 = "libpff_file_is_corrupted";
+	static char *function                 = "libpff_file_get_root_item";
 
 	if( file == NULL )
 	{
@@ -1518,36 +5713,86 @@ int libpff_file_is_corrupted(
 	}
 	internal_file = (libpff_internal_file_t *) file;
 
-	if( internal_file->io_handle == NULL )
+	if( internal_file->file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - missing IO handle.",
+		 "%s: invalid file - missing file IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_file->io_handle->flags & LIBPFF_IO_HANDLE_FLAG_IS_CORRUPTED ) != 0 )
+	if( internal_file->item_tree == NULL )
 	{
-		return( 1 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing item tree.",
+		 function );
+
+		return( -1 );
 	}
-	return( 0 );
+	if( root_item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid root item.",
+		 function );
+
+		return( -1 );
+	}
+	if( *root_item != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: root item already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_item_initialize(
+	     root_item,
+	     internal_file->io_handle,
+	     internal_file->file_io_handle,
+	     internal_file->name_to_id_map_list,
+	     internal_file->descriptors_index,
+	     internal_file->offsets_index,
+	     internal_file->item_tree,
+	     internal_file->item_tree->root_node,
+	     LIBPFF_ITEM_FLAGS_DEFAULT,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create root item.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
 }
 
-/* Recovers deleted items
- * By default only the unallocated space is checked for recoverable items
- * Returns 1 if successful or -1 on error
+/* Retrieves the message store
+ * Returns 1 if successful, 0 if not available or -1 on error
  */
-int libpff_file_recover_items(
+int libpff_file_get_message_store(
      libpff_file_t *file,
-     uint8_t recovery_flags,
+     libpff_item_t **message_store,
      libcerror_error_t **error )
 {
-	libpff_internal_file_t *internal_file = NULL;
-	static char *function                 = "libpff_file_recover_items";
-	int result                            = 0;
+	libcdata_tree_node_t *message_store_item_tree_node = NULL;
+	libpff_internal_file_t *internal_file              = NULL;
+	static char *function                              = "libpff_file_get_message_store";
+	int result                                         = 0;
 
 	if( file == NULL )
 	{
@@ -1562,105 +5807,109 @@ int libpff_file_recover_items(
 	}
 	internal_file = (libpff_internal_file_t *) file;
 
-	if( internal_file->io_handle == NULL )
+	if( libpff_io_handle_clear_pending_read(
+	     internal_file->io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to clear pending read.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_file->recovered_item_list != NULL )
+	if( internal_file->file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file - recovered item list already set.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing file IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_file->read_allocation_tables == 0 )
+	if( message_store == NULL )
 	{
-		if( libpff_internal_file_read_allocation_tables(
-		     internal_file,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read allocation tables.",
-			 function );
-
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( ( error != NULL )
-			 && ( *error != NULL ) )
-			{
-				libcnotify_print_error_backtrace(
-				 *error );
-			}
-#endif
-			libcerror_error_free(
-			 error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid message store.",
+		 function );
 
-/* TODO set recovery_flags |= LIBPFF_RECOVERY_FLAG_IGNORE_ALLOCATION_DATA ? */
-		}
+		return( -1 );
 	}
-	if( libcdata_list_initialize(
-	     &( internal_file->recovered_item_list ),
-	     error ) != 1 )
+	if( *message_store != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create recovered item list.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: message store already set.",
 		 function );
 
 		return( -1 );
 	}
-	result = libpff_recover_items(
-	          internal_file->io_handle,
-	          internal_file->file_io_handle,
-	          internal_file->descriptors_index,
-	          internal_file->offsets_index,
-	          internal_file->unallocated_data_block_list,
-	          internal_file->unallocated_page_block_list,
-	          internal_file->recovered_item_list,
-	          recovery_flags,
+	result = libpff_item_tree_get_node_by_identifier(
+	          internal_file->item_tree,
+	          LIBPFF_DESCRIPTOR_IDENTIFIER_MESSAGE_STORE,
+                  &message_store_item_tree_node,
 	          error );
 
-	if( result != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to recover items.",
-		 function );
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve message store item tree node: %" PRIu32 ".",
+		 function,
+		 LIBPFF_DESCRIPTOR_IDENTIFIER_MESSAGE_STORE );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( libpff_item_initialize(
+		     message_store,
+		     internal_file->io_handle,
+		     internal_file->file_io_handle,
+		     internal_file->name_to_id_map_list,
+		     internal_file->descriptors_index,
+		     internal_file->offsets_index,
+		     internal_file->item_tree,
+		     message_store_item_tree_node,
+		     LIBPFF_ITEM_FLAGS_DEFAULT,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create message store.",
+			 function );
+
+			return( -1 );
+		}
 	}
-        if( internal_file->io_handle->abort != 0 )
-        {
-                internal_file->io_handle->abort = 0;
-        }
 	return( result );
 }
 
-/* Retrieves the file size
+/* Retrieves the name to id map
  * Returns 1 if successful, 0 if not available or -1 on error
  */
-int libpff_file_get_size(
+int libpff_file_get_name_to_id_map(
      libpff_file_t *file,
-     size64_t *size,
+     libpff_item_t **name_to_id_map,
      libcerror_error_t **error )
 {
-	libpff_internal_file_t *internal_file = NULL;
-	static char *function                 = "libpff_file_get_size";
+	libcdata_tree_node_t *name_to_id_map_item_tree_node = NULL;
+	libpff_internal_file_t *internal_file               = NULL;
+	static char *function                               = "libpff_file_get_name_to_id_map";
+	int result                                          = 0;
 
 	if( file == NULL )
 	{
@@ -1675,47 +5924,107 @@ int libpff_file_get_size(
 	}
 	internal_file = (libpff_internal_file_t *) file;
 
-	if( internal_file->io_handle == NULL )
+	if( libpff_io_handle_clear_pending_read(
+	     internal_file->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to clear pending read.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - missing IO handle.",
+		 "%s: invalid file - missing file IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( size == NULL )
+	if( name_to_id_map == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid size.",
+		 "%s: invalid name to id map.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_file->file_io_handle == NULL )
+	if( *name_to_id_map != NULL )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: name to id map already set.",
+		 function );
+
+		return( -1 );
 	}
-	*size = internal_file->io_handle->file_size;
+	result = libpff_item_tree_get_node_by_identifier(
+	          internal_file->item_tree,
+	          LIBPFF_DESCRIPTOR_IDENTIFIER_NAME_TO_ID_MAP,
+                  &name_to_id_map_item_tree_node,
+	          error );
 
-	return( 1 );
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve name to ip map item tree node: %" PRIu32 ".",
+		 function,
+		 LIBPFF_DESCRIPTOR_IDENTIFIER_NAME_TO_ID_MAP );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( libpff_item_initialize(
+		     name_to_id_map,
+		     internal_file->io_handle,
+		     internal_file->file_io_handle,
+		     internal_file->name_to_id_map_list,
+		     internal_file->descriptors_index,
+		     internal_file->offsets_index,
+		     internal_file->item_tree,
+		     name_to_id_map_item_tree_node,
+		     LIBPFF_ITEM_FLAGS_DEFAULT,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create name to id map.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
 }
 
-/* Retrieves the content type
+/* Retrieves the root folder
  * Returns 1 if successful, 0 if not available or -1 on error
  */
-int libpff_file_get_content_type(
+int libpff_file_get_root_folder(
      libpff_file_t *file,
-     uint8_t *content_type,
+     libpff_item_t **root_folder,
      libcerror_error_t **error )
 {
 	libpff_internal_file_t *internal_file = NULL;
-	static char *function                 = "libpff_file_get_content_type";
+	static char *function                 = "libpff_file_get_root_folder";
 
 	if( file == NULL )
 	{
@@ -1730,47 +6039,80 @@ int libpff_file_get_content_type(
 	}
 	internal_file = (libpff_internal_file_t *) file;
 
-	if( internal_file->file_header == NULL )
+	if( internal_file->file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - missing file header.",
+		 "%s: invalid file - missing file IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( content_type == NULL )
+	if( root_folder == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid content type.",
+		 "%s: invalid root folder.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_file->file_io_handle == NULL )
+	if( *root_folder != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: root folder already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->root_folder_item_tree_node == NULL )
 	{
 		return( 0 );
 	}
-	*content_type = (uint8_t) internal_file->file_header->file_content_type;
+	if( libpff_item_initialize(
+	     root_folder,
+	     internal_file->io_handle,
+	     internal_file->file_io_handle,
+	     internal_file->name_to_id_map_list,
+	     internal_file->descriptors_index,
+	     internal_file->offsets_index,
+	     internal_file->item_tree,
+	     internal_file->root_folder_item_tree_node,
+	     LIBPFF_ITEM_FLAGS_DEFAULT,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create root folder.",
+		 function );
 
+		return( -1 );
+	}
 	return( 1 );
 }
 
-/* Retrieves the file type
+/* Retrieves an item for a specific identifier
  * Returns 1 if successful, 0 if not available or -1 on error
  */
-int libpff_file_get_type(
+int libpff_file_get_item_by_identifier(
      libpff_file_t *file,
-     uint8_t *type,
+     uint32_t item_identifier,
+     libpff_item_t **item,
      libcerror_error_t **error )
 {
+	libcdata_tree_node_t *item_tree_node  = NULL;
 	libpff_internal_file_t *internal_file = NULL;
-	static char *function                 = "libpff_file_get_type";
+	static char *function                 = "libpff_file_get_item_by_identifier";
+	int result                            = 0;
 
 	if( file == NULL )
 	{
@@ -1785,102 +6127,132 @@ int libpff_file_get_type(
 	}
 	internal_file = (libpff_internal_file_t *) file;
 
-	if( internal_file->io_handle == NULL )
+	if( libpff_io_handle_clear_pending_read(
+	     internal_file->io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to clear pending read.",
 		 function );
 
 		return( -1 );
 	}
-	if( type == NULL )
+	if( internal_file->file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid type.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing file IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_file->file_io_handle == NULL )
-	{
-		return( 0 );
-	}
-	*type = internal_file->io_handle->file_type;
-
-	return( 1 );
-}
-
-/* Retrieves the encryption type
- * Returns 1 if successful, 0 if not available or -1 on error
- */
-int libpff_file_get_encryption_type(
-     libpff_file_t *file,
-     uint8_t *encryption_type,
-     libcerror_error_t **error )
-{
-	libpff_internal_file_t *internal_file = NULL;
-	static char *function                 = "libpff_file_get_encryption_type";
-
-	if( file == NULL )
+	if( item == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file.",
+		 "%s: invalid item.",
 		 function );
 
 		return( -1 );
 	}
-	internal_file = (libpff_internal_file_t *) file;
-
-	if( internal_file->io_handle == NULL )
+	if( *item != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: item already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( encryption_type == NULL )
+	result = libpff_item_tree_get_node_by_identifier(
+	          internal_file->item_tree,
+                  item_identifier,
+                  &item_tree_node,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid encryption type.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve item tree node: %" PRIu32 ".",
+		 function,
+		 item_identifier );
 
 		return( -1 );
 	}
-	if( internal_file->file_io_handle == NULL )
+	else if( result == 0 )
 	{
 		return( 0 );
 	}
-	*encryption_type = internal_file->io_handle->encryption_type;
+	if( item_tree_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid item tree node.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_item_initialize(
+	     item,
+	     internal_file->io_handle,
+	     internal_file->file_io_handle,
+	     internal_file->name_to_id_map_list,
+	     internal_file->descriptors_index,
+	     internal_file->offsets_index,
+	     internal_file->item_tree,
+	     item_tree_node,
+	     LIBPFF_ITEM_FLAGS_DEFAULT,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize item.",
+		 function );
 
+		return( -1 );
+	}
 	return( 1 );
 }
 
-/* Retrieves the ASCII codepage
- * Returns 1 if successful or -1 on error
+/* Visits the items of the item tree using multiple threads
+ * The items are visited starting at the root folder. The callback function
+ * is called on the thread of the worker that visits the item, concurrently
+ * with other callbacks. The item is freed when the callback function returns.
+ * The callback function returns 1 to continue, 0 to stop the visit or -1 on error
+ * Returns 1 if successful, 0 if the visit was stopped or -1 on error
  */
-int libpff_file_get_ascii_codepage(
+int libpff_file_parallel_visit_items(
      libpff_file_t *file,
-     int *ascii_codepage,
+     uint8_t flags,
+     int (*callback_function)(
+            libpff_item_t *item,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     int number_of_threads,
      libcerror_error_t **error )
 {
 	libpff_internal_file_t *internal_file = NULL;
-	static char *function                 = "libpff_file_get_ascii_codepage";
+	libpff_item_visitor_t *item_visitor   = NULL;
+	static char *function                 = "libpff_file_parallel_visit_items";
+	size_t index_node_size                = 0;
+	int result                            = 0;
 
 	if( file == NULL )
 	{
@@ -1906,199 +6278,162 @@ int libpff_file_get_ascii_codepage(
 
 		return( -1 );
 	}
-	if( ascii_codepage == NULL )
+	if( internal_file->file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid ASCII codepage.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing file IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	*ascii_codepage = internal_file->io_handle->ascii_codepage;
-
-	return( 1 );
-}
-
-/* Sets the ASCII codepage
- * Returns 1 if successful or -1 on error
- */
-int libpff_file_set_ascii_codepage(
-     libpff_file_t *file,
-     int ascii_codepage,
-     libcerror_error_t **error )
-{
-	libpff_internal_file_t *internal_file = NULL;
-	static char *function                 = "libpff_file_set_ascii_codepage";
-
-	if( file == NULL )
+	if( internal_file->caller_io_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid file - unsupported caller IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	internal_file = (libpff_internal_file_t *) file;
-
-	if( internal_file->io_handle == NULL )
+	if( ( flags & ~( LIBPFF_VISIT_FLAG_SKIP_FOLDERS | LIBPFF_VISIT_FLAG_SKIP_MESSAGES | LIBPFF_VISIT_FLAG_SKIP_OTHER_ITEMS ) ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - missing IO handle.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported flags: 0x%02" PRIx8 ".",
+		 function,
+		 flags );
 
 		return( -1 );
 	}
-	if( ( ascii_codepage != LIBPFF_CODEPAGE_ASCII )
-	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_874 )
-	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_932 )
-	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_936 )
-	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_949 )
-	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_950 )
-	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_1250 )
-	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_1251 )
-	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_1252 )
-	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_1253 )
-	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_1254 )
-	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_1255 )
-	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_1256 )
-	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_1257 )
-	 && ( ascii_codepage != LIBPFF_CODEPAGE_WINDOWS_1258 ) )
+	if( callback_function == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported ASCII codepage.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback function.",
 		 function );
 
 		return( -1 );
 	}
-	internal_file->io_handle->ascii_codepage = ascii_codepage;
-
-	return( 1 );
-}
-
-/* Retrieves the number of unallocated blocks
- * Returns 1 if successful or -1 on error
- */
-int libpff_file_get_number_of_unallocated_blocks(
-     libpff_file_t *file,
-     int unallocated_block_type,
-     int *number_of_unallocated_blocks,
-     libcerror_error_t **error )
-{
-	libcdata_range_list_t *unallocated_block_list = NULL;
-	libpff_internal_file_t *internal_file         = NULL;
-	static char *function                         = "libpff_file_get_number_of_unallocated_blocks";
-
-	if( file == NULL )
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBPFF_MAXIMUM_NUMBER_OF_VISIT_THREADS ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( unallocated_block_type != LIBPFF_UNALLOCATED_BLOCK_TYPE_DATA )
-	 && ( unallocated_block_type != LIBPFF_UNALLOCATED_BLOCK_TYPE_PAGE ) )
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( number_of_threads > 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported unallocated block type.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading is not supported.",
 		 function );
 
 		return( -1 );
 	}
-	internal_file = (libpff_internal_file_t *) file;
-
-	if( internal_file->read_allocation_tables == 0 )
+#endif
+	if( internal_file->root_folder_item_tree_node == NULL )
 	{
-		if( libpff_internal_file_read_allocation_tables(
-		     internal_file,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read allocation tables.",
-			 function );
-
-			return( -1 );
-		}
+		return( 1 );
 	}
-	if( unallocated_block_type == LIBPFF_UNALLOCATED_BLOCK_TYPE_DATA )
+	if( internal_file->io_handle->file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE )
 	{
-		unallocated_block_list = internal_file->unallocated_data_block_list;
+		index_node_size = 4096;
 	}
-	else if( unallocated_block_type == LIBPFF_UNALLOCATED_BLOCK_TYPE_PAGE )
+	else
 	{
-		unallocated_block_list = internal_file->unallocated_page_block_list;
+		index_node_size = 512;
 	}
-	if( unallocated_block_list == NULL )
+	if( libpff_item_visitor_initialize(
+	     &item_visitor,
+	     internal_file->io_handle,
+	     internal_file->file_io_handle,
+	     internal_file->file_header,
+	     index_node_size,
+	     internal_file->name_to_id_map_list,
+	     internal_file->item_tree,
+	     number_of_threads,
+	     flags,
+	     callback_function,
+	     callback_data,
+	     error ) != 1 )
 	{
-		if( number_of_unallocated_blocks == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-			 "%s: invalid number of unallocated blocks.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create item visitor.",
+		 function );
 
-			return( -1 );
-		}
-		*number_of_unallocated_blocks = 0;
+		goto on_error;
 	}
-	else
+	result = libpff_item_visitor_visit(
+	          item_visitor,
+	          internal_file->root_folder_item_tree_node,
+	          error );
+
+	if( result == -1 )
 	{
-		if( libcdata_range_list_get_number_of_elements(
-		     unallocated_block_list,
-		     number_of_unallocated_blocks,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve number of unallocated blocks.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to visit items.",
+		 function );
 
-			return( -1 );
-		}
+		goto on_error;
 	}
-	return( 1 );
+	if( libpff_item_visitor_free(
+	     &item_visitor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free item visitor.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( item_visitor != NULL )
+	{
+		libpff_item_visitor_free(
+		 &item_visitor,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Retrieves a specific unallocated block
+/* Retrieves the number of orphan items
  * Returns 1 if successful or -1 on error
  */
-int libpff_file_get_unallocated_block(
+int libpff_file_get_number_of_orphan_items(
      libpff_file_t *file,
-     int unallocated_block_type,
-     int unallocated_block_index,
-     off64_t *offset,
-     size64_t *size,
+     int *number_of_orphan_items,
      libcerror_error_t **error )
 {
-	libcdata_range_list_t *unallocated_block_list = NULL;
-	libpff_internal_file_t *internal_file         = NULL;
-	intptr_t *value                               = NULL;
-	static char *function                         = "libpff_file_get_unallocated_block";
+	libpff_internal_file_t *internal_file = NULL;
+	static char *function                 = "libpff_file_get_number_of_orphan_items";
 
 	if( file == NULL )
 	{
@@ -2111,86 +6446,48 @@ int libpff_file_get_unallocated_block(
 
 		return( -1 );
 	}
-	if( ( unallocated_block_type != LIBPFF_UNALLOCATED_BLOCK_TYPE_DATA )
-	 && ( unallocated_block_type != LIBPFF_UNALLOCATED_BLOCK_TYPE_PAGE ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported unallocated block type.",
-		 function );
-
-		return( -1 );
-	}
 	internal_file = (libpff_internal_file_t *) file;
 
-	if( unallocated_block_type == LIBPFF_UNALLOCATED_BLOCK_TYPE_DATA )
-	{
-		unallocated_block_list = internal_file->unallocated_data_block_list;
-	}
-	else if( unallocated_block_type == LIBPFF_UNALLOCATED_BLOCK_TYPE_PAGE )
-	{
-		unallocated_block_list = internal_file->unallocated_page_block_list;
-	}
-	if( unallocated_block_list == NULL )
+	if( internal_file->file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - missing unallocated block list.",
+		 "%s: invalid file - missing file IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_file->read_allocation_tables == 0 )
-	{
-		if( libpff_internal_file_read_allocation_tables(
-		     internal_file,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read allocation tables.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( libcdata_range_list_get_range_by_index(
-	     unallocated_block_list,
-	     unallocated_block_index,
-	     (uint64_t *) offset,
-	     (uint64_t *) size,
-	     &value,
+	if( libcdata_array_get_number_of_entries(
+	     internal_file->orphan_item_array,
+	     number_of_orphan_items,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve range list element: %d.",
-		 function,
-		 unallocated_block_index );
+		 "%s: unable to retrieve number of orphan items.",
+		 function );
 
 		return( -1 );
 	}
 	return( 1 );
 }
 
-/* Retrieves the root item
+/* Retrieves a specific orphan item
  * Returns 1 if successful or -1 on error
  */
-int libpff_file_get_root_item(
+int libpff_file_get_orphan_item_by_index(
      libpff_file_t *file,
-     libpff_item_t **root_item,
+     int orphan_item_index,
+     libpff_item_t **orphan_item,
      libcerror_error_t **error )
 {
-	libpff_internal_file_t *internal_file = NULL;
-	static char *function                 = "libpff_file_get_root_item";
+	libcdata_tree_node_t *orphan_item_tree_node = NULL;
+	libpff_internal_file_t *internal_file       = NULL;
+	static char *function                       = "libpff_file_get_orphan_item_by_index";
 
 	if( file == NULL )
 	{
@@ -2216,48 +6513,42 @@ int libpff_file_get_root_item(
 
 		return( -1 );
 	}
-	if( internal_file->item_tree == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - missing item tree.",
-		 function );
-
-		return( -1 );
-	}
-	if( root_item == NULL )
+	if( orphan_item == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid root item.",
+		 "%s: invalid orphan item.",
 		 function );
 
 		return( -1 );
 	}
-	if( *root_item != NULL )
+	if( libcdata_array_get_entry_by_index(
+	     internal_file->orphan_item_array,
+	     orphan_item_index,
+	     (intptr_t **) &orphan_item_tree_node,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: root item already set.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve orphan item tree node: %d.",
+		 function,
+		 orphan_item_index );
 
 		return( -1 );
 	}
 	if( libpff_item_initialize(
-	     root_item,
+	     orphan_item,
 	     internal_file->io_handle,
 	     internal_file->file_io_handle,
 	     internal_file->name_to_id_map_list,
 	     internal_file->descriptors_index,
 	     internal_file->offsets_index,
 	     internal_file->item_tree,
-	     internal_file->item_tree->root_node,
+	     orphan_item_tree_node,
 	     LIBPFF_ITEM_FLAGS_DEFAULT,
 	     error ) != 1 )
 	{
@@ -2265,7 +6556,7 @@ int libpff_file_get_root_item(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create root item.",
+		 "%s: unable to create orphan item.",
 		 function );
 
 		return( -1 );
@@ -2273,20 +6564,18 @@ int libpff_file_get_root_item(
 	return( 1 );
 }
 
-/* Retrieves the message store
- * Returns 1 if successful, 0 if not available or -1 on error
+/* Validates the recovered item of a tree node when its validation was deferred
+ * Returns 1 if the recovered item is valid, 0 if not or -1 on error
  */
-int libpff_file_get_message_store(
-     libpff_file_t *file,
-     libpff_item_t **message_store,
+int libpff_internal_file_validate_recovered_item_tree_node(
+     libpff_internal_file_t *internal_file,
+     libcdata_tree_node_t *recovered_item_tree_node,
      libcerror_error_t **error )
 {
-	libcdata_tree_node_t *message_store_item_tree_node = NULL;
-	libpff_internal_file_t *internal_file              = NULL;
-	static char *function                              = "libpff_file_get_message_store";
-	int result                                         = 0;
+	libpff_item_descriptor_t *item_descriptor = NULL;
+	static char *function                     = "libpff_internal_file_validate_recovered_item_tree_node";
 
-	if( file == NULL )
+	if( internal_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -2297,98 +6586,69 @@ int libpff_file_get_message_store(
 
 		return( -1 );
 	}
-	internal_file = (libpff_internal_file_t *) file;
-
-	if( internal_file->file_io_handle == NULL )
+	if( libcdata_tree_node_get_value(
+	     recovered_item_tree_node,
+	     (intptr_t **) &item_descriptor,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - missing file IO handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( message_store == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid message store.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve item descriptor from recovered item tree node.",
 		 function );
 
 		return( -1 );
 	}
-	if( *message_store != NULL )
+	if( item_descriptor == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: message store already set.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing item descriptor.",
 		 function );
 
 		return( -1 );
 	}
-	result = libpff_item_tree_get_node_by_identifier(
-	          internal_file->item_tree,
-	          LIBPFF_DESCRIPTOR_IDENTIFIER_MESSAGE_STORE,
-                  &message_store_item_tree_node,
-	          error );
-
-	if( result == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve message store item tree node: %" PRIu32 ".",
-		 function,
-		 LIBPFF_DESCRIPTOR_IDENTIFIER_MESSAGE_STORE );
-
-		return( -1 );
-	}
-	else if( result != 0 )
+	if( item_descriptor->validation_status == LIBPFF_VALIDATION_STATUS_PENDING )
 	{
-		if( libpff_item_initialize(
-		     message_store,
+		if( libpff_recover_validate_item_descriptor(
 		     internal_file->io_handle,
 		     internal_file->file_io_handle,
-		     internal_file->name_to_id_map_list,
-		     internal_file->descriptors_index,
 		     internal_file->offsets_index,
-		     internal_file->item_tree,
-		     message_store_item_tree_node,
-		     LIBPFF_ITEM_FLAGS_DEFAULT,
-		     error ) != 1 )
+		     item_descriptor,
+		     1,
+		     error ) == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create message store.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to validate item descriptor: %" PRIu32 ".",
+			 function,
+			 item_descriptor->descriptor_identifier );
 
 			return( -1 );
 		}
 	}
-	return( result );
+	if( item_descriptor->validation_status != LIBPFF_VALIDATION_STATUS_VALID )
+	{
+		return( 0 );
+	}
+	return( 1 );
 }
 
-/* Retrieves the name to id map
- * Returns 1 if successful, 0 if not available or -1 on error
+/* Retrieves the number of recovered items
+ * Returns 1 if successful or -1 on error
  */
-int libpff_file_get_name_to_id_map(
+int libpff_file_get_number_of_recovered_items(
      libpff_file_t *file,
-     libpff_item_t **name_to_id_map,
+     int *number_of_recovered_items,
      libcerror_error_t **error )
 {
-	libcdata_tree_node_t *name_to_id_map_item_tree_node = NULL;
-	libpff_internal_file_t *internal_file               = NULL;
-	static char *function                               = "libpff_file_get_name_to_id_map";
-	int result                                          = 0;
+	libpff_internal_file_t *internal_file = NULL;
+	static char *function                 = "libpff_file_get_number_of_recovered_items";
 
 	if( file == NULL )
 	{
@@ -2414,83 +6674,36 @@ int libpff_file_get_name_to_id_map(
 
 		return( -1 );
 	}
-	if( name_to_id_map == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid name to id map.",
-		 function );
-
-		return( -1 );
-	}
-	if( *name_to_id_map != NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: name to id map already set.",
-		 function );
-
-		return( -1 );
-	}
-	result = libpff_item_tree_get_node_by_identifier(
-	          internal_file->item_tree,
-	          LIBPFF_DESCRIPTOR_IDENTIFIER_NAME_TO_ID_MAP,
-                  &name_to_id_map_item_tree_node,
-	          error );
-
-	if( result == -1 )
+	if( libcdata_array_get_number_of_entries(
+	     internal_file->recovered_item_array,
+	     number_of_recovered_items,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve name to ip map item tree node: %" PRIu32 ".",
-		 function,
-		 LIBPFF_DESCRIPTOR_IDENTIFIER_NAME_TO_ID_MAP );
+		 "%s: unable to retrieve number of recovered items.",
+		 function );
 
 		return( -1 );
 	}
-	else if( result != 0 )
-	{
-		if( libpff_item_initialize(
-		     name_to_id_map,
-		     internal_file->io_handle,
-		     internal_file->file_io_handle,
-		     internal_file->name_to_id_map_list,
-		     internal_file->descriptors_index,
-		     internal_file->offsets_index,
-		     internal_file->item_tree,
-		     name_to_id_map_item_tree_node,
-		     LIBPFF_ITEM_FLAGS_DEFAULT,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create name to id map.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	return( result );
+	return( 1 );
 }
 
-/* Retrieves the root folder
- * Returns 1 if successful, 0 if not available or -1 on error
+/* Retrieves a specific recovered item
+ * Returns 1 if successful or -1 on error
  */
-int libpff_file_get_root_folder(
+int libpff_file_get_recovered_item_by_index(
      libpff_file_t *file,
-     libpff_item_t **root_folder,
+     int recovered_item_index,
+     libpff_item_t **recovered_item,
      libcerror_error_t **error )
 {
-	libpff_internal_file_t *internal_file = NULL;
-	static char *function                 = "libpff_file_get_root_folder";
+	libcdata_tree_node_t *recovered_item_tree_node = NULL;
+	libpff_internal_file_t *internal_file          = NULL;
+	static char *function                          = "libpff_file_get_recovered_item_by_index";
+	int result                                     = 0;
 
 	if( file == NULL )
 	{
@@ -2505,6 +6718,19 @@ int libpff_file_get_root_folder(
 	}
 	internal_file = (libpff_internal_file_t *) file;
 
+	if( libpff_io_handle_clear_pending_read(
+	     internal_file->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to clear pending read.",
+		 function );
+
+		return( -1 );
+	}
 	if( internal_file->file_io_handle == NULL )
 	{
 		libcerror_error_set(
@@ -2516,41 +6742,71 @@ int libpff_file_get_root_folder(
 
 		return( -1 );
 	}
-	if( root_folder == NULL )
+	if( recovered_item == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid root folder.",
+		 "%s: invalid recovered item.",
 		 function );
 
 		return( -1 );
 	}
-	if( *root_folder != NULL )
+	if( libcdata_array_get_entry_by_index(
+	     internal_file->recovered_item_array,
+	     recovered_item_index,
+	     (intptr_t **) &recovered_item_tree_node,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: root folder already set.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve recovered item tree node: %d.",
+		 function,
+		 recovered_item_index );
 
 		return( -1 );
 	}
-	if( internal_file->root_folder_item_tree_node == NULL )
+	result = libpff_internal_file_validate_recovered_item_tree_node(
+	          internal_file,
+	          recovered_item_tree_node,
+	          error );
+
+	if( result == -1 )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to validate recovered item: %d.",
+		 function,
+		 recovered_item_index );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: recovered item: %d is not recoverable.",
+		 function,
+		 recovered_item_index );
+
+		return( -1 );
 	}
 	if( libpff_item_initialize(
-	     root_folder,
+	     recovered_item,
 	     internal_file->io_handle,
 	     internal_file->file_io_handle,
 	     internal_file->name_to_id_map_list,
 	     internal_file->descriptors_index,
 	     internal_file->offsets_index,
 	     internal_file->item_tree,
-	     internal_file->root_folder_item_tree_node,
+	     recovered_item_tree_node,
 	     LIBPFF_ITEM_FLAGS_DEFAULT,
 	     error ) != 1 )
 	{
@@ -2558,7 +6814,7 @@ int libpff_file_get_root_folder(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create root folder.",
+		 "%s: unable to create recovered item.",
 		 function );
 
 		return( -1 );
@@ -2566,19 +6822,24 @@ int libpff_file_get_root_folder(
 	return( 1 );
 }
 
-/* Retrieves an item for a specific identifier
- * Returns 1 if successful, 0 if not available or -1 on error
+/* Retrieves the recovered item for the specific identifier
+ * If multiple versions of the item were recovered the first valid one is returned,
+ * the other versions directly follow it in the recovered items
+ * Returns 1 if successful, 0 if no such (valid) recovered item or -1 on error
  */
-int libpff_file_get_item_by_identifier(
+int libpff_file_get_recovered_item_by_identifier(
      libpff_file_t *file,
      uint32_t item_identifier,
-     libpff_item_t **item,
+     libpff_item_t **recovered_item,
      libcerror_error_t **error )
 {
-	libcdata_tree_node_t *item_tree_node  = NULL;
-	libpff_internal_file_t *internal_file = NULL;
-	static char *function                 = "libpff_file_get_item_by_identifier";
-	int result                            = 0;
+	libcdata_tree_node_t *recovered_item_tree_node = NULL;
+	libpff_internal_file_t *internal_file          = NULL;
+	libpff_item_descriptor_t *item_descriptor      = NULL;
+	static char *function                          = "libpff_file_get_recovered_item_by_identifier";
+	int number_of_recovered_items                  = 0;
+	int recovered_item_index                       = 0;
+	int result                                     = 0;
 
 	if( file == NULL )
 	{
@@ -2593,6 +6854,19 @@ int libpff_file_get_item_by_identifier(
 	}
 	internal_file = (libpff_internal_file_t *) file;
 
+	if( libpff_io_handle_clear_pending_read(
+	     internal_file->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to clear pending read.",
+		 function );
+
+		return( -1 );
+	}
 	if( internal_file->file_io_handle == NULL )
 	{
 		libcerror_error_set(
@@ -2604,32 +6878,32 @@ int libpff_file_get_item_by_identifier(
 
 		return( -1 );
 	}
-	if( item == NULL )
+	if( recovered_item == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid item.",
+		 "%s: invalid recovered item.",
 		 function );
 
 		return( -1 );
 	}
-	if( *item != NULL )
+	if( *recovered_item != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: item already set.",
+		 "%s: recovered item already set.",
 		 function );
 
 		return( -1 );
 	}
-	result = libpff_item_tree_get_node_by_identifier(
-	          internal_file->item_tree,
-                  item_identifier,
-                  &item_tree_node,
+	result = libpff_item_tree_get_node_index_by_identifier(
+	          internal_file->recovered_item_array,
+	          item_identifier,
+	          &recovered_item_index,
 	          error );
 
 	if( result == -1 )
@@ -2638,7 +6912,7 @@ int libpff_file_get_item_by_identifier(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve item tree node: %" PRIu32 ".",
+		 "%s: unable to retrieve recovered item index for identifier: %" PRIu32 ".",
 		 function,
 		 item_identifier );
 
@@ -2648,26 +6922,109 @@ int libpff_file_get_item_by_identifier(
 	{
 		return( 0 );
 	}
-	if( item_tree_node == NULL )
+	if( libcdata_array_get_number_of_entries(
+	     internal_file->recovered_item_array,
+	     &number_of_recovered_items,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid item tree node.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of recovered items.",
 		 function );
 
 		return( -1 );
 	}
+	/* Skip the versions of the recovered item that fail validation
+	 */
+	result = 0;
+
+	while( recovered_item_index < number_of_recovered_items )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_file->recovered_item_array,
+		     recovered_item_index,
+		     (intptr_t **) &recovered_item_tree_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve recovered item tree node: %d.",
+			 function,
+			 recovered_item_index );
+
+			return( -1 );
+		}
+		if( libcdata_tree_node_get_value(
+		     recovered_item_tree_node,
+		     (intptr_t **) &item_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve item descriptor from recovered item tree node: %d.",
+			 function,
+			 recovered_item_index );
+
+			return( -1 );
+		}
+		if( item_descriptor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing item descriptor: %d.",
+			 function,
+			 recovered_item_index );
+
+			return( -1 );
+		}
+		if( item_descriptor->descriptor_identifier != item_identifier )
+		{
+			break;
+		}
+		result = libpff_internal_file_validate_recovered_item_tree_node(
+		          internal_file,
+		          recovered_item_tree_node,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to validate recovered item: %d.",
+			 function,
+			 recovered_item_index );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			break;
+		}
+		recovered_item_index++;
+	}
+	if( result == 0 )
+	{
+		return( 0 );
+	}
 	if( libpff_item_initialize(
-	     item,
+	     recovered_item,
 	     internal_file->io_handle,
 	     internal_file->file_io_handle,
 	     internal_file->name_to_id_map_list,
 	     internal_file->descriptors_index,
 	     internal_file->offsets_index,
 	     internal_file->item_tree,
-	     item_tree_node,
+	     recovered_item_tree_node,
 	     LIBPFF_ITEM_FLAGS_DEFAULT,
 	     error ) != 1 )
 	{
@@ -2675,7 +7032,7 @@ int libpff_file_get_item_by_identifier(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to initialize item.",
+		 "%s: unable to create recovered item.",
 		 function );
 
 		return( -1 );
@@ -2683,16 +7040,19 @@ int libpff_file_get_item_by_identifier(
 	return( 1 );
 }
 
-/* Retrieves the number of orphan items
+/* Retrieves the validation status of a specific recovered item
  * Returns 1 if successful or -1 on error
  */
-int libpff_file_get_number_of_orphan_items(
+int libpff_file_get_recovered_item_validation_status(
      libpff_file_t *file,
-     int *number_of_orphan_items,
+     int recovered_item_index,
+     uint8_t *validation_status,
      libcerror_error_t **error )
 {
-	libpff_internal_file_t *internal_file = NULL;
-	static char *function                 = "libpff_file_get_number_of_orphan_items";
+	libcdata_tree_node_t *recovered_item_tree_node = NULL;
+	libpff_internal_file_t *internal_file          = NULL;
+	libpff_item_descriptor_t *item_descriptor      = NULL;
+	static char *function                          = "libpff_file_get_recovered_item_validation_status";
 
 	if( file == NULL )
 	{
@@ -2707,132 +7067,78 @@ int libpff_file_get_number_of_orphan_items(
 	}
 	internal_file = (libpff_internal_file_t *) file;
 
-	if( internal_file->file_io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - missing file IO handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( libcdata_list_get_number_of_elements(
-	     internal_file->orphan_item_list,
-	     number_of_orphan_items,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of orphan items.",
-		 function );
-
-		return( -1 );
-	}
-	return( 1 );
-}
-
-/* Retrieves a specific orphan item
- * Returns 1 if successful or -1 on error
- */
-int libpff_file_get_orphan_item_by_index(
-     libpff_file_t *file,
-     int orphan_item_index,
-     libpff_item_t **orphan_item,
-     libcerror_error_t **error )
-{
-	libcdata_tree_node_t *orphan_item_tree_node = NULL;
-	libpff_internal_file_t *internal_file       = NULL;
-	static char *function                       = "libpff_file_get_orphan_item_by_index";
-
-	if( file == NULL )
+	if( validation_status == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file.",
+		 "%s: invalid validation status.",
 		 function );
 
 		return( -1 );
 	}
-	internal_file = (libpff_internal_file_t *) file;
-
-	if( internal_file->file_io_handle == NULL )
+	if( libcdata_array_get_entry_by_index(
+	     internal_file->recovered_item_array,
+	     recovered_item_index,
+	     (intptr_t **) &recovered_item_tree_node,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - missing file IO handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( orphan_item == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid orphan item.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve recovered item tree node: %d.",
+		 function,
+		 recovered_item_index );
 
 		return( -1 );
 	}
-	if( libcdata_list_get_value_by_index(
-	     internal_file->orphan_item_list,
-	     orphan_item_index,
-	     (intptr_t **) &orphan_item_tree_node,
+	if( libcdata_tree_node_get_value(
+	     recovered_item_tree_node,
+	     (intptr_t **) &item_descriptor,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve orphan item tree node: %d.",
+		 "%s: unable to retrieve item descriptor from recovered item tree node: %d.",
 		 function,
-		 orphan_item_index );
+		 recovered_item_index );
 
 		return( -1 );
 	}
-	if( libpff_item_initialize(
-	     orphan_item,
-	     internal_file->io_handle,
-	     internal_file->file_io_handle,
-	     internal_file->name_to_id_map_list,
-	     internal_file->descriptors_index,
-	     internal_file->offsets_index,
-	     internal_file->item_tree,
-	     orphan_item_tree_node,
-	     LIBPFF_ITEM_FLAGS_DEFAULT,
-	     error ) != 1 )
+	if( item_descriptor == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create orphan item.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing item descriptor: %d.",
+		 function,
+		 recovered_item_index );
 
 		return( -1 );
 	}
+	*validation_status = item_descriptor->validation_status;
+
 	return( 1 );
 }
 
-/* Retrieves the number of recovered items
- * Returns 1 if successful or -1 on error
+/* Validates a specific recovered item
+ * Reads the data block and local descriptors of a recovered item of which the validation was deferred
+ * Returns 1 if the recovered item is valid, 0 if not or -1 on error
  */
-int libpff_file_get_number_of_recovered_items(
+int libpff_file_validate_recovered_item(
      libpff_file_t *file,
-     int *number_of_recovered_items,
+     int recovered_item_index,
      libcerror_error_t **error )
 {
-	libpff_internal_file_t *internal_file = NULL;
-	static char *function                 = "libpff_file_get_number_of_recovered_items";
+	libcdata_tree_node_t *recovered_item_tree_node = NULL;
+	libpff_internal_file_t *internal_file          = NULL;
+	static char *function                          = "libpff_file_validate_recovered_item";
+	int result                                     = 0;
 
 	if( file == NULL )
 	{
@@ -2858,35 +7164,54 @@ int libpff_file_get_number_of_recovered_items(
 
 		return( -1 );
 	}
-	if( libcdata_list_get_number_of_elements(
-	     internal_file->recovered_item_list,
-	     number_of_recovered_items,
+	if( libcdata_array_get_entry_by_index(
+	     internal_file->recovered_item_array,
+	     recovered_item_index,
+	     (intptr_t **) &recovered_item_tree_node,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of recovered items.",
-		 function );
+		 "%s: unable to retrieve recovered item tree node: %d.",
+		 function,
+		 recovered_item_index );
 
 		return( -1 );
 	}
-	return( 1 );
+	result = libpff_internal_file_validate_recovered_item_tree_node(
+	          internal_file,
+	          recovered_item_tree_node,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to validate recovered item: %d.",
+		 function,
+		 recovered_item_index );
+
+		return( -1 );
+	}
+	return( result );
 }
 
-/* Retrieves a specific recovered item
+/* Prepares a property set against the name to ID map of the file
+ * The named property requests are resolved once, after which the property set
+ * can be applied to the items of the file
  * Returns 1 if successful or -1 on error
  */
-int libpff_file_get_recovered_item_by_index(
+int libpff_file_prepare_property_set(
      libpff_file_t *file,
-     int recovered_item_index,
-     libpff_item_t **recovered_item,
+     libpff_property_set_t *property_set,
      libcerror_error_t **error )
 {
-	libcdata_tree_node_t *recovered_item_tree_node = NULL;
-	libpff_internal_file_t *internal_file          = NULL;
-	static char *function                          = "libpff_file_get_recovered_item_by_index";
+	libpff_internal_file_t *internal_file = NULL;
+	static char *function                 = "libpff_file_prepare_property_set";
 
 	if( file == NULL )
 	{
@@ -2912,50 +7237,17 @@ int libpff_file_get_recovered_item_by_index(
 
 		return( -1 );
 	}
-	if( recovered_item == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid recovered item.",
-		 function );
-
-		return( -1 );
-	}
-	if( libcdata_list_get_value_by_index(
-	     internal_file->recovered_item_list,
-	     recovered_item_index,
-	     (intptr_t **) &recovered_item_tree_node,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve recovered item tree node: %d.",
-		 function,
-		 recovered_item_index );
-
-		return( -1 );
-	}
-	if( libpff_item_initialize(
-	     recovered_item,
+	if( libpff_property_set_prepare(
+	     property_set,
 	     internal_file->io_handle,
-	     internal_file->file_io_handle,
 	     internal_file->name_to_id_map_list,
-	     internal_file->descriptors_index,
-	     internal_file->offsets_index,
-	     internal_file->item_tree,
-	     recovered_item_tree_node,
-	     LIBPFF_ITEM_FLAGS_DEFAULT,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create recovered item.",
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to prepare property set.",
 		 function );
 
 		return( -1 );
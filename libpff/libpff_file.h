@@ -25,9 +25,13 @@
 #include <common.h>
 #include <types.h>
 
+#include "libpff_caller_io_handle.h"
+#include "libpff_caller_open_state.h"
 #include "libpff_descriptors_index.h"
+#include "libpff_descriptor_io_handle.h"
 #include "libpff_extern.h"
 #include "libpff_file_header.h"
+#include "libpff_index_layout.h"
 #include "libpff_io_handle.h"
 #include "libpff_item_tree.h"
 #include "libpff_libbfio.h"
@@ -70,6 +74,28 @@ struct libpff_internal_file
 	 */
 	uint8_t file_io_handle_opened_in_library;
 
+	/* The caller driven IO handle
+	 */
+	libpff_caller_io_handle_t *caller_io_handle;
+
+	/* The caller driven file IO handle, while the file is being opened
+	 */
+	libbfio_handle_t *caller_file_io_handle;
+
+	/* The caller driven open state, while the file is being opened
+	 */
+	libpff_caller_open_state_t *caller_open_state;
+
+#if defined( LIBPFF_HAVE_DESCRIPTOR_IO_HANDLE )
+	/* The descriptor IO handle of a file opened by name, managed by the file IO handle
+	 */
+	libpff_descriptor_io_handle_t *descriptor_io_handle;
+#endif
+
+	/* The access hint flags
+	 */
+	uint8_t access_hint_flags;
+
 	/* The file header
 	 */
 	libpff_file_header_t *file_header;
@@ -90,6 +116,10 @@ struct libpff_internal_file
 	 */
 	libpff_offsets_index_t *offsets_index;
 
+	/* The descriptors index layout, used to refresh the file
+	 */
+	libpff_index_layout_t *descriptors_index_layout;
+
 	/* The item tree
 	 */
 	libpff_item_tree_t *item_tree;
@@ -98,13 +128,13 @@ struct libpff_internal_file
 	 */
 	libcdata_tree_node_t *root_folder_item_tree_node;
 
-	/* The orphan item list
+	/* The orphan item array
 	 */
-	libcdata_list_t *orphan_item_list;
+	libcdata_array_t *orphan_item_array;
 
-	/* The recovered item list
+	/* The recovered item array
 	 */
-	libcdata_list_t *recovered_item_list;
+	libcdata_array_t *recovered_item_array;
 
 	/* Value to indicate if the allocation tables
 	 * have been read
@@ -126,6 +156,10 @@ struct libpff_internal_file
 	/* The content type
 	 */
 	int content_type;
+
+	/* Value to indicate if the file should be opened using multiple threads
+	 */
+	uint8_t parallel_open;
 };
 
 LIBPFF_EXTERN \
@@ -143,6 +177,39 @@ int libpff_file_signal_abort(
      libpff_file_t *file,
      libcerror_error_t **error );
 
+LIBPFF_EXTERN \
+int libpff_file_set_deadline(
+     libpff_file_t *file,
+     uint32_t timeout,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_file_set_read_budget(
+     libpff_file_t *file,
+     size64_t maximum_read_size,
+     uint32_t maximum_number_of_read_blocks,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_file_get_read_statistics(
+     libpff_file_t *file,
+     size64_t *read_size,
+     uint64_t *number_of_read_blocks,
+     uint64_t *number_of_decompressed_blocks,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_file_set_parallel_open(
+     libpff_file_t *file,
+     uint8_t parallel_open,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_file_set_access_hint_flags(
+     libpff_file_t *file,
+     uint8_t access_hint_flags,
+     libcerror_error_t **error );
+
 LIBPFF_EXTERN \
 int libpff_file_open(
      libpff_file_t *file,
@@ -168,20 +235,103 @@ int libpff_file_open_file_io_handle(
      int access_flags,
      libcerror_error_t **error );
 
+LIBPFF_EXTERN \
+int libpff_file_open_caller_driven(
+     libpff_file_t *file,
+     size64_t file_size,
+     int access_flags,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_file_get_pending_read(
+     libpff_file_t *file,
+     off64_t *offset,
+     size64_t *size,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_file_supply_data(
+     libpff_file_t *file,
+     off64_t offset,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_file_release_data(
+     libpff_file_t *file,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_file_get_supplied_data_size(
+     libpff_file_t *file,
+     size64_t *supplied_data_size,
+     libcerror_error_t **error );
+
 LIBPFF_EXTERN \
 int libpff_file_close(
      libpff_file_t *file,
      libcerror_error_t **error );
 
+int libpff_internal_file_read_file_header(
+     libpff_internal_file_t *internal_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libpff_internal_file_create_indexes(
+     libpff_internal_file_t *internal_file,
+     libcerror_error_t **error );
+
+int libpff_internal_file_free_open_values(
+     libpff_internal_file_t *internal_file,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int libpff_internal_file_create_item_tree_in_shards(
+     libpff_internal_file_t *internal_file,
+     libbfio_handle_t *file_io_handle,
+     size_t index_node_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 int libpff_internal_file_open_read(
      libpff_internal_file_t *internal_file,
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
+int libpff_internal_file_has_pending_read(
+     libpff_internal_file_t *internal_file,
+     libcerror_error_t **error );
+
+int libpff_internal_file_read_caller_driven_descriptors_index_nodes(
+     libpff_internal_file_t *internal_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libpff_internal_file_open_read_caller_driven(
+     libpff_internal_file_t *internal_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libpff_internal_file_set_access_pattern(
+     libpff_internal_file_t *internal_file,
+     int access_pattern,
+     int *previous_access_pattern,
+     libcerror_error_t **error );
+
 int libpff_internal_file_read_allocation_tables(
      libpff_internal_file_t *internal_file,
      libcerror_error_t **error );
 
+LIBPFF_EXTERN \
+int libpff_file_refresh(
+     libpff_file_t *file,
+     libcerror_error_t **error );
+
 LIBPFF_EXTERN \
 int libpff_file_is_corrupted(
      libpff_file_t *file,
@@ -245,6 +395,13 @@ int libpff_file_get_unallocated_block(
      size64_t *size,
      libcerror_error_t **error );
 
+LIBPFF_EXTERN \
+int libpff_file_get_allocation_statistics(
+     libpff_file_t *file,
+     int number_of_threads,
+     libpff_allocation_statistics_t **allocation_statistics,
+     libcerror_error_t **error );
+
 LIBPFF_EXTERN \
 int libpff_file_get_root_item(
      libpff_file_t *file,
@@ -276,6 +433,18 @@ int libpff_file_get_item_by_identifier(
      libpff_item_t **item,
      libcerror_error_t **error );
 
+LIBPFF_EXTERN \
+int libpff_file_parallel_visit_items(
+     libpff_file_t *file,
+     uint8_t flags,
+     int (*callback_function)(
+            libpff_item_t *item,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     int number_of_threads,
+     libcerror_error_t **error );
+
 LIBPFF_EXTERN \
 int libpff_file_get_number_of_orphan_items(
      libpff_file_t *file,
@@ -289,6 +458,11 @@ int libpff_file_get_orphan_item_by_index(
      libpff_item_t **orphan_item,
      libcerror_error_t **error );
 
+int libpff_internal_file_validate_recovered_item_tree_node(
+     libpff_internal_file_t *internal_file,
+     libcdata_tree_node_t *recovered_item_tree_node,
+     libcerror_error_t **error );
+
 LIBPFF_EXTERN \
 int libpff_file_get_number_of_recovered_items(
      libpff_file_t *file,
@@ -302,6 +476,32 @@ int libpff_file_get_recovered_item_by_index(
      libpff_item_t **recovered_item,
      libcerror_error_t **error );
 
+LIBPFF_EXTERN \
+int libpff_file_get_recovered_item_by_identifier(
+     libpff_file_t *file,
+     uint32_t item_identifier,
+     libpff_item_t **recovered_item,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_file_get_recovered_item_validation_status(
+     libpff_file_t *file,
+     int recovered_item_index,
+     uint8_t *validation_status,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_file_validate_recovered_item(
+     libpff_file_t *file,
+     int recovered_item_index,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_file_prepare_property_set(
+     libpff_file_t *file,
+     libpff_property_set_t *property_set,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -41,7 +41,9 @@
 #include "libpff_libfmapi.h"
 #include "libpff_local_descriptor_value.h"
 #include "libpff_mapi.h"
+#include "libpff_offsets_index.h"
 #include "libpff_record_entry.h"
+#include "libpff_sort_entry.h"
 
 #define LIBPFF_FOLDER_SUB_ITEM_SUB_FOLDERS		0
 #define LIBPFF_FOLDER_SUB_ITEM_SUB_MESSAGES		1
@@ -3233,6 +3235,654 @@ on_error:
 	return( -1 );
 }
 
+/* Retrieves the descriptor identifiers of the sub messages of a folder sorted by a column of the contents table
+ * The sort order can be LIBPFF_SORT_ORDER_ASCENDING or LIBPFF_SORT_ORDER_DESCENDING,
+ * sub messages without a value for the column are sorted last
+ * Only the first first_index + maximum_number_of_sub_message_identifiers sub messages are selected and sorted,
+ * of which the identifiers from first_index onwards are returned
+ * Integer, boolean, floating-point and time columns are supported
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_folder_get_sorted_sub_message_identifiers(
+     libpff_item_t *folder,
+     uint32_t entry_type,
+     int sort_order,
+     int first_index,
+     uint32_t *sub_message_identifiers,
+     int maximum_number_of_sub_message_identifiers,
+     int *number_of_sub_message_identifiers,
+     libcerror_error_t **error )
+{
+	libpff_sort_entry_t sort_entry;
+
+	libpff_internal_item_t *internal_item = NULL;
+	libpff_record_entry_t *record_entry   = NULL;
+	libpff_sort_entry_t *sort_entries     = NULL;
+	static char *function                 = "libpff_folder_get_sorted_sub_message_identifiers";
+	int maximum_number_of_sort_entries    = 0;
+	int number_of_sort_entries            = 0;
+	int number_of_sub_messages            = 0;
+	int result                            = 0;
+	int sort_entry_index                  = 0;
+	int sub_message_index                 = 0;
+
+	if( folder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid folder.",
+		 function );
+
+		return( -1 );
+	}
+	internal_item = (libpff_internal_item_t *) folder;
+
+	if( internal_item->type == LIBPFF_ITEM_TYPE_UNDEFINED )
+	{
+		if( libpff_internal_item_determine_type(
+		     internal_item,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine item type.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_item->type != LIBPFF_ITEM_TYPE_FOLDER )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported item type: 0x%08" PRIx32 "",
+		 function,
+		 internal_item->type );
+
+		return( -1 );
+	}
+	if( ( sort_order != LIBPFF_SORT_ORDER_ASCENDING )
+	 && ( sort_order != LIBPFF_SORT_ORDER_DESCENDING ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported sort order.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid first index value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( sub_message_identifiers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub message identifiers.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_sub_message_identifiers < 0 )
+	 || ( maximum_number_of_sub_message_identifiers > ( INT_MAX - first_index ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of sub message identifiers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_sub_message_identifiers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of sub message identifiers.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_item->sub_item_values[ LIBPFF_FOLDER_SUB_ITEM_SUB_MESSAGES ] == NULL )
+	{
+		if( libpff_folder_determine_sub_messages(
+		     internal_item,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine sub messages.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	*number_of_sub_message_identifiers = 0;
+
+	if( internal_item->sub_item_values[ LIBPFF_FOLDER_SUB_ITEM_SUB_MESSAGES ] == NULL )
+	{
+		return( 1 );
+	}
+	if( libpff_item_values_get_number_of_record_sets(
+	     internal_item->sub_item_values[ LIBPFF_FOLDER_SUB_ITEM_SUB_MESSAGES ],
+	     internal_item->name_to_id_map_list,
+	     internal_item->io_handle,
+	     internal_item->file_io_handle,
+	     internal_item->offsets_index,
+	     &number_of_sub_messages,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine the number of sub messages.",
+		 function );
+
+		goto on_error;
+	}
+	maximum_number_of_sort_entries = first_index + maximum_number_of_sub_message_identifiers;
+
+	if( maximum_number_of_sort_entries > number_of_sub_messages )
+	{
+		maximum_number_of_sort_entries = number_of_sub_messages;
+	}
+	if( maximum_number_of_sort_entries <= first_index )
+	{
+		return( 1 );
+	}
+	if( (size_t) maximum_number_of_sort_entries > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libpff_sort_entry_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum number of sort entries value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	sort_entries = (libpff_sort_entry_t *) memory_allocate(
+	                                        sizeof( libpff_sort_entry_t ) * maximum_number_of_sort_entries );
+
+	if( sort_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sort entries.",
+		 function );
+
+		goto on_error;
+	}
+	/* The rows of the contents table are read from the cached table,
+	 * the sub messages themselves are not opened
+	 */
+	for( sub_message_index = 0;
+	     sub_message_index < number_of_sub_messages;
+	     sub_message_index++ )
+	{
+		if( memory_set(
+		     &sort_entry,
+		     0,
+		     sizeof( libpff_sort_entry_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear sort entry.",
+			 function );
+
+			goto on_error;
+		}
+		sort_entry.row_index = sub_message_index;
+
+		if( libpff_item_values_get_record_entry_by_type(
+		     internal_item->sub_item_values[ LIBPFF_FOLDER_SUB_ITEM_SUB_MESSAGES ],
+		     internal_item->name_to_id_map_list,
+		     internal_item->io_handle,
+		     internal_item->file_io_handle,
+		     internal_item->offsets_index,
+		     sub_message_index,
+		     LIBPFF_ENTRY_TYPE_SUB_ITEM_IDENTIFIER,
+		     LIBPFF_VALUE_TYPE_INTEGER_32BIT_SIGNED,
+		     &record_entry,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub item identifier record entry: %d.",
+			 function,
+			 sub_message_index );
+
+			goto on_error;
+		}
+		if( libpff_record_entry_get_data_as_32bit_integer(
+		     record_entry,
+		     &( sort_entry.identifier ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve 32-bit integer value.",
+			 function );
+
+			goto on_error;
+		}
+		record_entry = NULL;
+
+		result = libpff_item_values_get_record_entry_by_type(
+		          internal_item->sub_item_values[ LIBPFF_FOLDER_SUB_ITEM_SUB_MESSAGES ],
+		          internal_item->name_to_id_map_list,
+		          internal_item->io_handle,
+		          internal_item->file_io_handle,
+		          internal_item->offsets_index,
+		          sub_message_index,
+		          entry_type,
+		          0,
+		          &record_entry,
+		          LIBPFF_ENTRY_VALUE_FLAG_MATCH_ANY_VALUE_TYPE,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve record entry: 0x%04" PRIx32 " of sub message: %d.",
+			 function,
+			 entry_type,
+			 sub_message_index );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			result = libpff_sort_entry_set_key_from_record_entry(
+			          &sort_entry,
+			          record_entry,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set sort key of sub message: %d.",
+				 function,
+				 sub_message_index );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported value type of entry type: 0x%04" PRIx32 ".",
+				 function,
+				 entry_type );
+
+				goto on_error;
+			}
+		}
+		record_entry = NULL;
+
+		if( libpff_sort_entries_select(
+		     sort_entries,
+		     maximum_number_of_sort_entries,
+		     &number_of_sort_entries,
+		     &sort_entry,
+		     sort_order,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to select sort entry of sub message: %d.",
+			 function,
+			 sub_message_index );
+
+			goto on_error;
+		}
+	}
+	if( libpff_sort_entries_sort(
+	     sort_entries,
+	     number_of_sort_entries,
+	     sort_order,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to sort entries.",
+		 function );
+
+		goto on_error;
+	}
+	for( sort_entry_index = first_index;
+	     sort_entry_index < number_of_sort_entries;
+	     sort_entry_index++ )
+	{
+		sub_message_identifiers[ sort_entry_index - first_index ] = sort_entries[ sort_entry_index ].identifier;
+	}
+	*number_of_sub_message_identifiers = number_of_sort_entries - first_index;
+
+	memory_free(
+	 sort_entries );
+
+	return( 1 );
+
+on_error:
+	if( sort_entries != NULL )
+	{
+		memory_free(
+		 sort_entries );
+	}
+	return( -1 );
+}
+
+/* Retrieves the block locality of a folder
+ * The blocks are the data and local descriptors blocks referenced by the folder
+ * and the items directly contained in the folder, such as sub folders and messages.
+ * The span size is the size of the part of the file that contains the blocks
+ * and the seek distance the sum of the distances between the end of a block
+ * and the start of the next block, when the blocks are read in item order
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_folder_get_block_locality(
+     libpff_item_t *folder,
+     int *number_of_blocks,
+     size64_t *blocks_size,
+     size64_t *span_size,
+     size64_t *seek_distance,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *item_tree_node      = NULL;
+	libpff_index_value_t *offset_index_value  = NULL;
+	libpff_internal_item_t *internal_item     = NULL;
+	libpff_item_descriptor_t *item_descriptor = NULL;
+	static char *function                     = "libpff_folder_get_block_locality";
+	size64_t safe_blocks_size                 = 0;
+	size64_t safe_seek_distance               = 0;
+	off64_t block_end_offset                  = 0;
+	off64_t first_block_offset                = 0;
+	off64_t last_block_end_offset             = 0;
+	off64_t previous_block_end_offset         = 0;
+	uint64_t data_identifier                  = 0;
+	int identifier_index                      = 0;
+	int number_of_sub_nodes                   = 0;
+	int recovered_value_index                 = 0;
+	int result                                = 0;
+	int safe_number_of_blocks                 = 0;
+	int sub_node_index                        = 0;
+
+	if( folder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid folder.",
+		 function );
+
+		return( -1 );
+	}
+	internal_item = (libpff_internal_item_t *) folder;
+
+	if( internal_item->type == LIBPFF_ITEM_TYPE_UNDEFINED )
+	{
+		if( libpff_internal_item_determine_type(
+		     internal_item,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine item type.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_item->type != LIBPFF_ITEM_TYPE_FOLDER )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported item type: 0x%08" PRIx32 "",
+		 function,
+		 internal_item->type );
+
+		return( -1 );
+	}
+	if( number_of_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of blocks.",
+		 function );
+
+		return( -1 );
+	}
+	if( blocks_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid blocks size.",
+		 function );
+
+		return( -1 );
+	}
+	if( span_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid span size.",
+		 function );
+
+		return( -1 );
+	}
+	if( seek_distance == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid seek distance.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_tree_node_get_number_of_sub_nodes(
+	     internal_item->item_tree_node,
+	     &number_of_sub_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub nodes.",
+		 function );
+
+		return( -1 );
+	}
+	/* The sub node index -1 represents the folder itself
+	 */
+	for( sub_node_index = -1;
+	     sub_node_index < number_of_sub_nodes;
+	     sub_node_index++ )
+	{
+		if( sub_node_index == -1 )
+		{
+			item_descriptor = internal_item->item_descriptor;
+		}
+		else
+		{
+			if( libcdata_tree_node_get_sub_node_by_index(
+			     internal_item->item_tree_node,
+			     sub_node_index,
+			     &item_tree_node,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve sub node: %d.",
+				 function,
+				 sub_node_index );
+
+				return( -1 );
+			}
+			if( libcdata_tree_node_get_value(
+			     item_tree_node,
+			     (intptr_t **) &item_descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve sub node: %d item descriptor.",
+				 function,
+				 sub_node_index );
+
+				return( -1 );
+			}
+		}
+		if( item_descriptor == NULL )
+		{
+			continue;
+		}
+		for( identifier_index = 0;
+		     identifier_index < 2;
+		     identifier_index++ )
+		{
+			if( identifier_index == 0 )
+			{
+				data_identifier       = item_descriptor->data_identifier;
+				recovered_value_index = item_descriptor->recovered_data_identifier_value_index;
+			}
+			else
+			{
+				data_identifier       = item_descriptor->local_descriptors_identifier;
+				recovered_value_index = item_descriptor->recovered_local_descriptors_identifier_value_index;
+			}
+			if( data_identifier == 0 )
+			{
+				continue;
+			}
+			result = libpff_offsets_index_get_index_value_by_identifier(
+			          internal_item->offsets_index,
+			          internal_item->file_io_handle,
+			          data_identifier,
+			          item_descriptor->recovered,
+			          recovered_value_index,
+			          &offset_index_value,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to find offset index value identifier: %" PRIu64 ".",
+				 function,
+				 data_identifier );
+
+				return( -1 );
+			}
+			else if( ( result == 0 )
+			      || ( offset_index_value == NULL ) )
+			{
+				continue;
+			}
+			block_end_offset = offset_index_value->file_offset + (off64_t) offset_index_value->data_size;
+
+			if( safe_number_of_blocks == 0 )
+			{
+				first_block_offset    = offset_index_value->file_offset;
+				last_block_end_offset = block_end_offset;
+			}
+			else
+			{
+				if( offset_index_value->file_offset < first_block_offset )
+				{
+					first_block_offset = offset_index_value->file_offset;
+				}
+				if( block_end_offset > last_block_end_offset )
+				{
+					last_block_end_offset = block_end_offset;
+				}
+				if( offset_index_value->file_offset >= previous_block_end_offset )
+				{
+					safe_seek_distance += (size64_t) ( offset_index_value->file_offset - previous_block_end_offset );
+				}
+				else
+				{
+					safe_seek_distance += (size64_t) ( previous_block_end_offset - offset_index_value->file_offset );
+				}
+			}
+			previous_block_end_offset = block_end_offset;
+			safe_blocks_size         += offset_index_value->data_size;
+
+			safe_number_of_blocks++;
+		}
+	}
+	*number_of_blocks = safe_number_of_blocks;
+	*blocks_size      = safe_blocks_size;
+	*span_size        = (size64_t) ( last_block_end_offset - first_block_offset );
+	*seek_distance    = safe_seek_distance;
+
+	return( 1 );
+}
+
 /* Retrieves the number of sub associated contents from a folder
  * Returns 1 if successful or -1 on error
  */
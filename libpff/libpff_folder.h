@@ -152,6 +152,26 @@ int libpff_folder_get_sub_messages(
      libpff_item_t **sub_messages,
      libcerror_error_t **error );
 
+LIBPFF_EXTERN \
+int libpff_folder_get_sorted_sub_message_identifiers(
+     libpff_item_t *folder,
+     uint32_t entry_type,
+     int sort_order,
+     int first_index,
+     uint32_t *sub_message_identifiers,
+     int maximum_number_of_sub_message_identifiers,
+     int *number_of_sub_message_identifiers,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_folder_get_block_locality(
+     libpff_item_t *folder,
+     int *number_of_blocks,
+     size64_t *blocks_size,
+     size64_t *span_size,
+     size64_t *seek_distance,
+     libcerror_error_t **error );
+
 LIBPFF_EXTERN \
 int libpff_folder_get_number_of_sub_associated_contents(
      libpff_item_t *folder,
@@ -0,0 +1,401 @@
+/*
+ * Format specific functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <types.h>
+
+#include "libpff_definitions.h"
+#include "libpff_format_functions.h"
+#include "libpff_libcerror.h"
+
+#include "pff_block.h"
+#include "pff_index_node.h"
+#include "pff_local_descriptor_node.h"
+
+/* Defines the entry read functions for a specific integer size
+ * The 32-bit and 64-bit formats only differ in the size of the identifiers
+ * and offsets, hence the functions are generated from the same definition
+ */
+#define LIBPFF_FORMAT_FUNCTIONS_DEFINE_ENTRY_READ_FUNCTIONS( bits ) \
+\
+static void libpff_format_functions_read_node_entry_identifier_ ## bits ## bit( \
+             const uint8_t *entry_data, \
+             uint64_t *identifier ) \
+{ \
+	byte_stream_copy_to_uint ## bits ## _little_endian( \
+	 entry_data, \
+	 *identifier ); \
+} \
+\
+static void libpff_format_functions_read_index_node_branch_entry_ ## bits ## bit( \
+             const uint8_t *entry_data, \
+             uint64_t *back_pointer, \
+             uint64_t *file_offset ) \
+{ \
+	byte_stream_copy_to_uint ## bits ## _little_endian( \
+	 ( (pff_index_node_branch_entry_ ## bits ## bit_t *) entry_data )->back_pointer, \
+	 *back_pointer ); \
+	byte_stream_copy_to_uint ## bits ## _little_endian( \
+	 ( (pff_index_node_branch_entry_ ## bits ## bit_t *) entry_data )->file_offset, \
+	 *file_offset ); \
+} \
+\
+static void libpff_format_functions_read_index_node_descriptor_entry_ ## bits ## bit( \
+             const uint8_t *entry_data, \
+             uint64_t *data_identifier, \
+             uint64_t *local_descriptors_identifier, \
+             uint32_t *parent_identifier ) \
+{ \
+	byte_stream_copy_to_uint ## bits ## _little_endian( \
+	 ( (pff_index_node_descriptor_entry_ ## bits ## bit_t *) entry_data )->data_identifier, \
+	 *data_identifier ); \
+	byte_stream_copy_to_uint ## bits ## _little_endian( \
+	 ( (pff_index_node_descriptor_entry_ ## bits ## bit_t *) entry_data )->local_descriptors_identifier, \
+	 *local_descriptors_identifier ); \
+	byte_stream_copy_to_uint32_little_endian( \
+	 ( (pff_index_node_descriptor_entry_ ## bits ## bit_t *) entry_data )->parent_identifier, \
+	 *parent_identifier ); \
+} \
+\
+static void libpff_format_functions_read_index_node_offset_entry_ ## bits ## bit( \
+             const uint8_t *entry_data, \
+             uint64_t *file_offset, \
+             uint16_t *data_size, \
+             uint16_t *reference_count ) \
+{ \
+	byte_stream_copy_to_uint ## bits ## _little_endian( \
+	 ( (pff_index_node_offset_entry_ ## bits ## bit_t *) entry_data )->file_offset, \
+	 *file_offset ); \
+	byte_stream_copy_to_uint16_little_endian( \
+	 ( (pff_index_node_offset_entry_ ## bits ## bit_t *) entry_data )->data_size, \
+	 *data_size ); \
+	byte_stream_copy_to_uint16_little_endian( \
+	 ( (pff_index_node_offset_entry_ ## bits ## bit_t *) entry_data )->reference_count, \
+	 *reference_count ); \
+} \
+\
+static void libpff_format_functions_read_local_descriptor_branch_entry_ ## bits ## bit( \
+             const uint8_t *entry_data, \
+             uint64_t *sub_node_identifier ) \
+{ \
+	byte_stream_copy_to_uint ## bits ## _little_endian( \
+	 ( (pff_local_descriptor_branch_node_entry_type_ ## bits ## bit_t *) entry_data )->sub_node_identifier, \
+	 *sub_node_identifier ); \
+} \
+\
+static void libpff_format_functions_read_local_descriptor_leaf_entry_ ## bits ## bit( \
+             const uint8_t *entry_data, \
+             uint64_t *data_identifier, \
+             uint64_t *local_descriptors_identifier ) \
+{ \
+	byte_stream_copy_to_uint ## bits ## _little_endian( \
+	 ( (pff_local_descriptor_leaf_node_entry_type_ ## bits ## bit_t *) entry_data )->data_identifier, \
+	 *data_identifier ); \
+	byte_stream_copy_to_uint ## bits ## _little_endian( \
+	 ( (pff_local_descriptor_leaf_node_entry_type_ ## bits ## bit_t *) entry_data )->local_descriptors_identifier, \
+	 *local_descriptors_identifier ); \
+}
+
+/* Defines the data block footer read function for a specific footer type
+ */
+#define LIBPFF_FORMAT_FUNCTIONS_DEFINE_DATA_BLOCK_FOOTER_READ_FUNCTION( footer_type, bits ) \
+\
+static void libpff_format_functions_read_data_block_footer_ ## footer_type( \
+             const uint8_t *footer_data, \
+             uint16_t *data_size, \
+             uint32_t *checksum, \
+             uint64_t *back_pointer ) \
+{ \
+	byte_stream_copy_to_uint16_little_endian( \
+	 ( (pff_block_footer_ ## footer_type ## _t *) footer_data )->data_size, \
+	 *data_size ); \
+	byte_stream_copy_to_uint32_little_endian( \
+	 ( (pff_block_footer_ ## footer_type ## _t *) footer_data )->checksum, \
+	 *checksum ); \
+	byte_stream_copy_to_uint ## bits ## _little_endian( \
+	 ( (pff_block_footer_ ## footer_type ## _t *) footer_data )->back_pointer, \
+	 *back_pointer ); \
+}
+
+/* Defines the node read functions for a specific integer size
+ * These process all the entries of a node in a single call, hence the entry
+ * size is a constant and the entry values are read without an indirect call
+ */
+#define LIBPFF_FORMAT_FUNCTIONS_DEFINE_NODE_READ_FUNCTIONS( bits ) \
+\
+static void libpff_format_functions_read_index_node_branch_entries_ ## bits ## bit( \
+             const uint8_t *entries_data, \
+             uint16_t number_of_entries, \
+             uint64_t *back_pointers, \
+             uint64_t *file_offsets ) \
+{ \
+	const pff_index_node_branch_entry_ ## bits ## bit_t *entries = NULL; \
+	uint16_t entry_index                                        = 0; \
+\
+	entries = (const pff_index_node_branch_entry_ ## bits ## bit_t *) entries_data; \
+\
+	for( entry_index = 0; \
+	     entry_index < number_of_entries; \
+	     entry_index++ ) \
+	{ \
+		byte_stream_copy_to_uint ## bits ## _little_endian( \
+		 entries[ entry_index ].back_pointer, \
+		 back_pointers[ entry_index ] ); \
+		byte_stream_copy_to_uint ## bits ## _little_endian( \
+		 entries[ entry_index ].file_offset, \
+		 file_offsets[ entry_index ] ); \
+	} \
+} \
+\
+static int libpff_format_functions_scan_index_node_leaf_entries_ ## bits ## bit( \
+            const uint8_t *entries_data, \
+            uint8_t index_type, \
+            uint16_t number_of_entries, \
+            uint16_t *entry_index ) \
+{ \
+	const pff_index_node_descriptor_entry_ ## bits ## bit_t *descriptor_entries = NULL; \
+	const pff_index_node_offset_entry_ ## bits ## bit_t *offset_entries         = NULL; \
+	uint64_t value_64bit                                                      = 0; \
+	uint16_t safe_entry_index                                                 = 0; \
+	uint16_t value_16bit                                                      = 0; \
+\
+	if( index_type == LIBPFF_INDEX_TYPE_DESCRIPTOR ) \
+	{ \
+		descriptor_entries = (const pff_index_node_descriptor_entry_ ## bits ## bit_t *) entries_data; \
+\
+		for( safe_entry_index = *entry_index; \
+		     safe_entry_index < number_of_entries; \
+		     safe_entry_index++ ) \
+		{ \
+			/* Ignore the upper 32-bit of descriptor identifiers \
+			 */ \
+			byte_stream_copy_to_uint32_little_endian( \
+			 descriptor_entries[ safe_entry_index ].identifier, \
+			 value_64bit ); \
+\
+			if( value_64bit == 0 ) \
+			{ \
+				continue; \
+			} \
+			byte_stream_copy_to_uint ## bits ## _little_endian( \
+			 descriptor_entries[ safe_entry_index ].data_identifier, \
+			 value_64bit ); \
+\
+			if( value_64bit != 0 ) \
+			{ \
+				*entry_index = safe_entry_index; \
+\
+				return( 1 ); \
+			} \
+		} \
+	} \
+	else if( index_type == LIBPFF_INDEX_TYPE_OFFSET ) \
+	{ \
+		offset_entries = (const pff_index_node_offset_entry_ ## bits ## bit_t *) entries_data; \
+\
+		for( safe_entry_index = *entry_index; \
+		     safe_entry_index < number_of_entries; \
+		     safe_entry_index++ ) \
+		{ \
+			byte_stream_copy_to_uint ## bits ## _little_endian( \
+			 offset_entries[ safe_entry_index ].identifier, \
+			 value_64bit ); \
+\
+			if( value_64bit == 0 ) \
+			{ \
+				continue; \
+			} \
+			byte_stream_copy_to_uint ## bits ## _little_endian( \
+			 offset_entries[ safe_entry_index ].file_offset, \
+			 value_64bit ); \
+\
+			if( ( value_64bit == 0 ) \
+			 || ( value_64bit > (uint64_t) INT64_MAX ) ) \
+			{ \
+				continue; \
+			} \
+			byte_stream_copy_to_uint16_little_endian( \
+			 offset_entries[ safe_entry_index ].data_size, \
+			 value_16bit ); \
+\
+			if( value_16bit != 0 ) \
+			{ \
+				*entry_index = safe_entry_index; \
+\
+				return( 1 ); \
+			} \
+		} \
+	} \
+	*entry_index = number_of_entries; \
+\
+	return( 0 ); \
+} \
+\
+static int libpff_format_functions_check_local_descriptor_leaf_entries_ ## bits ## bit( \
+            const uint8_t *entries_data, \
+            uint16_t number_of_entries ) \
+{ \
+	const pff_local_descriptor_leaf_node_entry_type_ ## bits ## bit_t *entries = NULL; \
+	uint64_t value_64bit                                                     = 0; \
+	uint16_t entry_index                                                     = 0; \
+\
+	entries = (const pff_local_descriptor_leaf_node_entry_type_ ## bits ## bit_t *) entries_data; \
+\
+	for( entry_index = 0; \
+	     entry_index < number_of_entries; \
+	     entry_index++ ) \
+	{ \
+		/* Ignore the upper 32-bit of local descriptor identifiers \
+		 */ \
+		byte_stream_copy_to_uint32_little_endian( \
+		 entries[ entry_index ].identifier, \
+		 value_64bit ); \
+\
+		if( value_64bit == 0 ) \
+		{ \
+			return( 0 ); \
+		} \
+		byte_stream_copy_to_uint ## bits ## _little_endian( \
+		 entries[ entry_index ].data_identifier, \
+		 value_64bit ); \
+\
+		if( value_64bit == 0 ) \
+		{ \
+			return( 0 ); \
+		} \
+	} \
+	return( 1 ); \
+}
+
+LIBPFF_FORMAT_FUNCTIONS_DEFINE_ENTRY_READ_FUNCTIONS( 32 )
+LIBPFF_FORMAT_FUNCTIONS_DEFINE_ENTRY_READ_FUNCTIONS( 64 )
+
+LIBPFF_FORMAT_FUNCTIONS_DEFINE_NODE_READ_FUNCTIONS( 32 )
+LIBPFF_FORMAT_FUNCTIONS_DEFINE_NODE_READ_FUNCTIONS( 64 )
+
+LIBPFF_FORMAT_FUNCTIONS_DEFINE_DATA_BLOCK_FOOTER_READ_FUNCTION( 32bit, 32 )
+LIBPFF_FORMAT_FUNCTIONS_DEFINE_DATA_BLOCK_FOOTER_READ_FUNCTION( 64bit, 64 )
+LIBPFF_FORMAT_FUNCTIONS_DEFINE_DATA_BLOCK_FOOTER_READ_FUNCTION( 64bit_4k_page, 64 )
+
+#define LIBPFF_FORMAT_FUNCTIONS_ENTRY_READ_FUNCTIONS( bits ) \
+	&libpff_format_functions_read_node_entry_identifier_ ## bits ## bit, \
+	&libpff_format_functions_read_index_node_branch_entry_ ## bits ## bit, \
+	&libpff_format_functions_read_index_node_descriptor_entry_ ## bits ## bit, \
+	&libpff_format_functions_read_index_node_offset_entry_ ## bits ## bit, \
+	&libpff_format_functions_read_local_descriptor_branch_entry_ ## bits ## bit, \
+	&libpff_format_functions_read_local_descriptor_leaf_entry_ ## bits ## bit
+
+#define LIBPFF_FORMAT_FUNCTIONS_NODE_READ_FUNCTIONS( bits ) \
+	&libpff_format_functions_read_index_node_branch_entries_ ## bits ## bit, \
+	&libpff_format_functions_scan_index_node_leaf_entries_ ## bits ## bit, \
+	&libpff_format_functions_check_local_descriptor_leaf_entries_ ## bits ## bit
+
+const libpff_format_functions_t libpff_format_functions_32bit = {
+	LIBPFF_FILE_TYPE_32BIT,
+	512,
+	500,
+	sizeof( pff_index_node_32bit_footer_t ),
+	sizeof( pff_index_node_branch_entry_32bit_t ),
+	sizeof( pff_index_node_descriptor_entry_32bit_t ),
+	sizeof( pff_local_descriptor_branch_node_entry_type_32bit_t ),
+	sizeof( pff_local_descriptor_leaf_node_entry_type_32bit_t ),
+	sizeof( pff_block_footer_32bit_t ),
+	LIBPFF_FORMAT_FUNCTIONS_ENTRY_READ_FUNCTIONS( 32 ),
+	&libpff_format_functions_read_data_block_footer_32bit,
+	LIBPFF_FORMAT_FUNCTIONS_NODE_READ_FUNCTIONS( 32 ) };
+
+const libpff_format_functions_t libpff_format_functions_64bit = {
+	LIBPFF_FILE_TYPE_64BIT,
+	512,
+	496,
+	sizeof( pff_index_node_64bit_footer_t ),
+	sizeof( pff_index_node_branch_entry_64bit_t ),
+	sizeof( pff_index_node_descriptor_entry_64bit_t ),
+	sizeof( pff_local_descriptor_branch_node_entry_type_64bit_t ),
+	sizeof( pff_local_descriptor_leaf_node_entry_type_64bit_t ),
+	sizeof( pff_block_footer_64bit_t ),
+	LIBPFF_FORMAT_FUNCTIONS_ENTRY_READ_FUNCTIONS( 64 ),
+	&libpff_format_functions_read_data_block_footer_64bit,
+	LIBPFF_FORMAT_FUNCTIONS_NODE_READ_FUNCTIONS( 64 ) };
+
+const libpff_format_functions_t libpff_format_functions_64bit_4k_page = {
+	LIBPFF_FILE_TYPE_64BIT_4K_PAGE,
+	4096,
+	4072,
+	sizeof( pff_index_node_64bit_4k_page_footer_t ),
+	sizeof( pff_index_node_branch_entry_64bit_t ),
+	sizeof( pff_index_node_descriptor_entry_64bit_t ),
+	sizeof( pff_local_descriptor_branch_node_entry_type_64bit_t ),
+	sizeof( pff_local_descriptor_leaf_node_entry_type_64bit_t ),
+	sizeof( pff_block_footer_64bit_4k_page_t ),
+	LIBPFF_FORMAT_FUNCTIONS_ENTRY_READ_FUNCTIONS( 64 ),
+	&libpff_format_functions_read_data_block_footer_64bit_4k_page,
+	LIBPFF_FORMAT_FUNCTIONS_NODE_READ_FUNCTIONS( 64 ) };
+
+/* Retrieves the format specific functions of a specific file type
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_format_functions_get(
+     uint8_t file_type,
+     const libpff_format_functions_t **format_functions,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_format_functions_get";
+
+	if( format_functions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid format functions.",
+		 function );
+
+		return( -1 );
+	}
+	switch( file_type )
+	{
+		case LIBPFF_FILE_TYPE_32BIT:
+			*format_functions = &libpff_format_functions_32bit;
+			break;
+
+		case LIBPFF_FILE_TYPE_64BIT:
+			*format_functions = &libpff_format_functions_64bit;
+			break;
+
+		case LIBPFF_FILE_TYPE_64BIT_4K_PAGE:
+			*format_functions = &libpff_format_functions_64bit_4k_page;
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported file type.",
+			 function );
+
+			return( -1 );
+	}
+	return( 1 );
+}
+
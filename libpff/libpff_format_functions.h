@@ -0,0 +1,165 @@
+/*
+ * Format specific functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPFF_FORMAT_FUNCTIONS_H )
+#define _LIBPFF_FORMAT_FUNCTIONS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libpff_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libpff_format_functions libpff_format_functions_t;
+
+/* The format specific functions and values
+ * These are selected once per file type so that the per entry
+ * decoding does not need to check the file type
+ */
+struct libpff_format_functions
+{
+	/* The file type
+	 */
+	uint8_t file_type;
+
+	/* The index node size
+	 */
+	size_t index_node_size;
+
+	/* The index node checksum data size
+	 */
+	size_t index_node_checksum_data_size;
+
+	/* The index node footer size
+	 */
+	size_t index_node_footer_size;
+
+	/* The index node branch and offset entry size
+	 */
+	uint8_t index_node_entry_size;
+
+	/* The index node descriptor entry size
+	 */
+	uint8_t index_node_descriptor_entry_size;
+
+	/* The local descriptor node branch entry size
+	 */
+	uint8_t local_descriptor_branch_entry_size;
+
+	/* The local descriptor node leaf entry size
+	 */
+	uint8_t local_descriptor_leaf_entry_size;
+
+	/* The data block footer size
+	 */
+	size_t data_block_footer_size;
+
+	/* The read index or local descriptor node entry identifier function
+	 */
+	void (*read_node_entry_identifier)(
+	       const uint8_t *entry_data,
+	       uint64_t *identifier );
+
+	/* The read index node branch entry function
+	 */
+	void (*read_index_node_branch_entry)(
+	       const uint8_t *entry_data,
+	       uint64_t *back_pointer,
+	       uint64_t *file_offset );
+
+	/* The read index node descriptor entry function
+	 */
+	void (*read_index_node_descriptor_entry)(
+	       const uint8_t *entry_data,
+	       uint64_t *data_identifier,
+	       uint64_t *local_descriptors_identifier,
+	       uint32_t *parent_identifier );
+
+	/* The read index node offset entry function
+	 */
+	void (*read_index_node_offset_entry)(
+	       const uint8_t *entry_data,
+	       uint64_t *file_offset,
+	       uint16_t *data_size,
+	       uint16_t *reference_count );
+
+	/* The read local descriptor node branch entry function
+	 */
+	void (*read_local_descriptor_branch_entry)(
+	       const uint8_t *entry_data,
+	       uint64_t *sub_node_identifier );
+
+	/* The read local descriptor node leaf entry function
+	 */
+	void (*read_local_descriptor_leaf_entry)(
+	       const uint8_t *entry_data,
+	       uint64_t *data_identifier,
+	       uint64_t *local_descriptors_identifier );
+
+	/* The read data block footer function
+	 */
+	void (*read_data_block_footer)(
+	       const uint8_t *footer_data,
+	       uint16_t *data_size,
+	       uint32_t *checksum,
+	       uint64_t *back_pointer );
+
+	/* The read index node branch entries function
+	 */
+	void (*read_index_node_branch_entries)(
+	       const uint8_t *entries_data,
+	       uint16_t number_of_entries,
+	       uint64_t *back_pointers,
+	       uint64_t *file_offsets );
+
+	/* The scan index node leaf entries function
+	 */
+	int (*scan_index_node_leaf_entries)(
+	      const uint8_t *entries_data,
+	      uint8_t index_type,
+	      uint16_t number_of_entries,
+	      uint16_t *entry_index );
+
+	/* The check local descriptor node leaf entries function
+	 */
+	int (*check_local_descriptor_leaf_entries)(
+	      const uint8_t *entries_data,
+	      uint16_t number_of_entries );
+};
+
+extern const libpff_format_functions_t libpff_format_functions_32bit;
+extern const libpff_format_functions_t libpff_format_functions_64bit;
+extern const libpff_format_functions_t libpff_format_functions_64bit_4k_page;
+
+int libpff_format_functions_get(
+     uint8_t file_type,
+     const libpff_format_functions_t **format_functions,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPFF_FORMAT_FUNCTIONS_H ) */
+
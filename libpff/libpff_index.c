@@ -20,11 +20,11 @@
  */
 
 #include <common.h>
-#include <byte_stream.h>
 #include <memory.h>
 #include <types.h>
 
 #include "libpff_definitions.h"
+#include "libpff_format_functions.h"
 #include "libpff_index.h"
 #include "libpff_index_node.h"
 #include "libpff_index_value.h"
@@ -36,8 +36,6 @@
 #include "libpff_libfmapi.h"
 #include "libpff_unused.h"
 
-#include "pff_index_node.h"
-
 /* Creates an index
  * Make sure the value index is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
@@ -241,17 +239,15 @@ int libpff_index_read_node(
      libpff_index_value_t *index_value,
      libcerror_error_t **error )
 {
-	libpff_index_node_t *index_node      = NULL;
-	uint8_t *node_entry_data             = NULL;
-	static char *function                = "libpff_index_read_node";
-	off64_t element_data_offset          = 0;
-	off64_t node_data_offset             = 0;
-	uint64_t index_value_data_identifier = 0;
-	uint64_t index_value_file_offset     = 0;
-	uint64_t index_value_identifier      = 0;
-	uint16_t entry_index                 = 0;
-	uint16_t index_value_data_size       = 0;
-	int sub_node_index                   = 0;
+	const libpff_format_functions_t *format_functions = NULL;
+	libpff_index_node_t *index_node                   = NULL;
+	uint8_t *node_entries_data                        = NULL;
+	static char *function                             = "libpff_index_read_node";
+	off64_t element_data_offset                       = 0;
+	off64_t node_data_offset                          = 0;
+	uint16_t entry_index                              = 0;
+	uint8_t entry_size                                = 0;
+	int sub_node_index                                = 0;
 
 	if( index == NULL )
 	{
@@ -275,6 +271,19 @@ int libpff_index_read_node(
 
 		return( -1 );
 	}
+	format_functions = index->io_handle->format_functions;
+
+	if( format_functions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid index - invalid IO handle - missing format functions.",
+		 function );
+
+		return( -1 );
+	}
 	if( index_value == NULL )
 	{
 		libcerror_error_set(
@@ -317,6 +326,45 @@ int libpff_index_read_node(
 
 		return( -1 );
 	}
+	if( ( index->recovered == 0 )
+	 && ( index_node->number_of_entries > 0 )
+	 && ( index_value->back_pointer != index_node->back_pointer ) )
+	{
+		/* The cached index node is stale if the file was refreshed
+		 * and its page has been reused, hence read it again
+		 */
+		if( libfdata_vector_get_element_value_at_offset(
+		     index->index_nodes_vector,
+		     (intptr_t *) file_io_handle,
+		     (libfdata_cache_t *) index->index_nodes_cache,
+		     node_offset,
+		     &element_data_offset,
+		     (intptr_t **) &index_node,
+		     LIBFDATA_READ_FLAG_IGNORE_CACHE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve index node at offset: %" PRIi64 ".",
+			 function,
+			 node_offset );
+
+			return( -1 );
+		}
+		if( index_node == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing index node.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	if( index->type != index_node->type )
 	{
 		libcerror_error_set(
@@ -393,124 +441,52 @@ int libpff_index_read_node(
 			}
 			node_data_offset += (off64_t) index_node->entry_size;
 		}
-		if( index_node->level == LIBPFF_INDEX_NODE_LEVEL_LEAF )
+		if( ( index_node->level == LIBPFF_INDEX_NODE_LEVEL_LEAF )
+		 && ( index_node->number_of_entries < index_node->maximum_number_of_entries ) )
 		{
-			for( entry_index = index_node->number_of_entries;
-			     entry_index < index_node->maximum_number_of_entries;
-			     entry_index++ )
+			if( index_node->type == LIBPFF_INDEX_TYPE_DESCRIPTOR )
 			{
-				if( libpff_index_node_get_entry_data(
-				     index_node,
-				     entry_index,
-				     &node_entry_data,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve node entry: %" PRIu16 " data.",
-					 function,
-					 entry_index );
-
-					return( -1 );
-				}
-				if( node_entry_data == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: missing node entry: %" PRIu8 " data.",
-					 function,
-					 entry_index );
+				entry_size = format_functions->index_node_descriptor_entry_size;
+			}
+			else
+			{
+				entry_size = format_functions->index_node_entry_size;
+			}
+			if( libpff_index_node_get_entries_data(
+			     index_node,
+			     0,
+			     index_node->maximum_number_of_entries,
+			     entry_size,
+			     &node_entries_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve node entries data.",
+				 function );
 
-					return( -1 );
-				}
-				if( index->io_handle->file_type == LIBPFF_FILE_TYPE_32BIT )
-				{
-					byte_stream_copy_to_uint32_little_endian(
-					 node_entry_data,
-					 index_value_identifier );
-				}
-				else if( ( index->io_handle->file_type == LIBPFF_FILE_TYPE_64BIT )
-				      || ( index->io_handle->file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
-				{
-					byte_stream_copy_to_uint64_little_endian(
-					 node_entry_data,
-					 index_value_identifier );
-				}
-				/* Ignore the upper 32-bit of descriptor identifiers
-				 */
-				if( index_node->type == LIBPFF_INDEX_TYPE_DESCRIPTOR )
-				{
-					index_value_identifier &= 0xffffffffUL;
-				}
-				/* Ignore index values without an identifier
-				 */
-				if( index_value_identifier == 0 )
-				{
-					continue;
-				}
-				if( index_node->type == LIBPFF_INDEX_TYPE_DESCRIPTOR )
-				{
-					if( index->io_handle->file_type == LIBPFF_FILE_TYPE_32BIT )
-					{
-						byte_stream_copy_to_uint32_little_endian(
-						 ( (pff_index_node_descriptor_entry_32bit_t *) node_entry_data )->data_identifier,
-						 index_value_data_identifier );
-					}
-					else if( ( index->io_handle->file_type == LIBPFF_FILE_TYPE_64BIT )
-					      || ( index->io_handle->file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
-					{
-						byte_stream_copy_to_uint64_little_endian(
-						 ( (pff_index_node_descriptor_entry_64bit_t *) node_entry_data )->data_identifier,
-						 index_value_data_identifier );
-					}
-					/* Ignore descriptor index values without a data identifier
-					 */
-					if( index_value_data_identifier == 0 )
-					{
-						continue;
-					}
-				}
-				else if( index_node->type == LIBPFF_INDEX_TYPE_OFFSET )
-				{
-					if( index->io_handle->file_type == LIBPFF_FILE_TYPE_32BIT )
-					{
-						byte_stream_copy_to_uint32_little_endian(
-						 ( (pff_index_node_offset_entry_32bit_t *) node_entry_data )->file_offset,
-						 index_value_file_offset );
-						byte_stream_copy_to_uint16_little_endian(
-						 ( (pff_index_node_offset_entry_32bit_t *) node_entry_data )->data_size,
-						 index_value_data_size );
-					}
-					else if( ( index->io_handle->file_type == LIBPFF_FILE_TYPE_64BIT )
-					      || ( index->io_handle->file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
-					{
-						byte_stream_copy_to_uint64_little_endian(
-						 ( (pff_index_node_offset_entry_64bit_t *) node_entry_data )->file_offset,
-						 index_value_file_offset );
-						byte_stream_copy_to_uint16_little_endian(
-						 ( (pff_index_node_offset_entry_64bit_t *) node_entry_data )->data_size,
-						 index_value_data_size );
-					}
-					/* Ignore offset index values without a file offset and data size
-					 */
-					if( ( index_value_file_offset == 0 )
-					 || ( index_value_file_offset > (uint64_t) INT64_MAX )
-					 || ( index_value_data_size == 0 ) )
-					{
-						continue;
-					}
-				}
+				return( -1 );
+			}
+			/* The unused entries are scanned for deleted index values
+			 * with a single call per index value found
+			 */
+			entry_index = index_node->number_of_entries;
+
+			while( format_functions->scan_index_node_leaf_entries(
+			        node_entries_data,
+			        index_node->type,
+			        index_node->maximum_number_of_entries,
+			        &entry_index ) == 1 )
+			{
 #if defined( HAVE_DEBUG_OUTPUT )
 				if( libcnotify_verbose != 0 )
 				{
 					libcnotify_printf(
-					 "%s: adding deleted index value: %" PRIu64 ".\n",
+					 "%s: adding deleted index value in entry: %" PRIu16 ".\n",
 					 function,
-					 index_value_identifier );
+					 entry_index );
 				}
 #endif
 				if( libfdata_tree_node_append_sub_node(
@@ -542,11 +518,14 @@ int libpff_index_read_node(
 					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
 					 "%s: unable to set deleted in sub node: %d.",
+					 function,
 					 sub_node_index );
 
 					return( -1 );
 				}
 				node_data_offset += (off64_t) index_node->entry_size;
+
+				entry_index++;
 			}
 		}
 	}
@@ -565,13 +544,15 @@ int libpff_index_read_node_entry(
      libpff_index_value_t *index_value,
      libcerror_error_t **error )
 {
-	libpff_index_node_t *index_node = NULL;
-	uint8_t *node_entry_data        = NULL;
-	static char *function           = "libpff_index_read_node_entry";
-	off64_t element_data_offset     = 0;
-	uint64_t safe_file_offset       = 0;
-	uint64_t sub_nodes_offset       = 0;
-	int result                      = 0;
+	const libpff_format_functions_t *format_functions = NULL;
+	libpff_index_node_t *index_node                   = NULL;
+	uint8_t *node_entry_data                          = NULL;
+	static char *function                             = "libpff_index_read_node_entry";
+	off64_t element_data_offset                       = 0;
+	uint64_t safe_file_offset                         = 0;
+	uint64_t sub_nodes_offset                         = 0;
+	uint16_t data_size                                = 0;
+	int result                                        = 0;
 
 	if( index == NULL )
 	{
@@ -595,15 +576,15 @@ int libpff_index_read_node_entry(
 
 		return( -1 );
 	}
-	if( ( index->io_handle->file_type != LIBPFF_FILE_TYPE_32BIT )
-	 && ( index->io_handle->file_type != LIBPFF_FILE_TYPE_64BIT )
-	 && ( index->io_handle->file_type != LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
+	format_functions = index->io_handle->format_functions;
+
+	if( format_functions == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported file type.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid index - invalid IO handle - missing format functions.",
 		 function );
 
 		return( -1 );
@@ -693,19 +674,10 @@ int libpff_index_read_node_entry(
 
 		return( -1 );
 	}
-	if( index->io_handle->file_type == LIBPFF_FILE_TYPE_32BIT )
-	{
-		byte_stream_copy_to_uint32_little_endian(
-		 node_entry_data,
-		 index_value->identifier );
-	}
-	else if( ( index->io_handle->file_type == LIBPFF_FILE_TYPE_64BIT )
-	      || ( index->io_handle->file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
-	{
-		byte_stream_copy_to_uint64_little_endian(
-		 node_entry_data,
-		 index_value->identifier );
-	}
+	format_functions->read_node_entry_identifier(
+	 node_entry_data,
+	 &( index_value->identifier ) );
+
 	/* Ignore the upper 32-bit of descriptor identifiers
 	 */
 	if( index_node->type == LIBPFF_INDEX_TYPE_DESCRIPTOR )
@@ -716,59 +688,22 @@ int libpff_index_read_node_entry(
 	{
 		if( index_node->type == LIBPFF_INDEX_TYPE_DESCRIPTOR )
 		{
-			if( index->io_handle->file_type == LIBPFF_FILE_TYPE_32BIT )
-			{
-				byte_stream_copy_to_uint32_little_endian(
-				 ( (pff_index_node_descriptor_entry_32bit_t *) node_entry_data )->data_identifier,
-				 index_value->data_identifier );
-				byte_stream_copy_to_uint32_little_endian(
-				 ( (pff_index_node_descriptor_entry_32bit_t *) node_entry_data )->local_descriptors_identifier,
-				 index_value->local_descriptors_identifier );
-				byte_stream_copy_to_uint32_little_endian(
-				 ( (pff_index_node_descriptor_entry_32bit_t *) node_entry_data )->parent_identifier,
-				 index_value->parent_identifier );
-			}
-			else if( ( index->io_handle->file_type == LIBPFF_FILE_TYPE_64BIT )
-			      || ( index->io_handle->file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
-			{
-				byte_stream_copy_to_uint64_little_endian(
-				 ( (pff_index_node_descriptor_entry_64bit_t *) node_entry_data )->data_identifier,
-				 index_value->data_identifier );
-				byte_stream_copy_to_uint64_little_endian(
-				 ( (pff_index_node_descriptor_entry_64bit_t *) node_entry_data )->local_descriptors_identifier,
-				 index_value->local_descriptors_identifier );
-				byte_stream_copy_to_uint32_little_endian(
-				 ( (pff_index_node_descriptor_entry_64bit_t *) node_entry_data )->parent_identifier,
-				 index_value->parent_identifier );
-			}
+			format_functions->read_index_node_descriptor_entry(
+			 node_entry_data,
+			 &( index_value->data_identifier ),
+			 &( index_value->local_descriptors_identifier ),
+			 &( index_value->parent_identifier ) );
 		}
 		else if( index_node->type == LIBPFF_INDEX_TYPE_OFFSET )
 		{
-			if( index->io_handle->file_type == LIBPFF_FILE_TYPE_32BIT )
-			{
-				byte_stream_copy_to_uint32_little_endian(
-				 ( (pff_index_node_offset_entry_32bit_t *) node_entry_data )->file_offset,
-				 safe_file_offset );
-				byte_stream_copy_to_uint16_little_endian(
-				 ( (pff_index_node_offset_entry_32bit_t *) node_entry_data )->data_size,
-				 index_value->data_size );
-				byte_stream_copy_to_uint16_little_endian(
-				 ( (pff_index_node_offset_entry_32bit_t *) node_entry_data )->reference_count,
-				 index_value->reference_count );
-			}
-			else if( ( index->io_handle->file_type == LIBPFF_FILE_TYPE_64BIT )
-			      || ( index->io_handle->file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
-			{
-				byte_stream_copy_to_uint64_little_endian(
-				 ( (pff_index_node_offset_entry_64bit_t *) node_entry_data )->file_offset,
-				 safe_file_offset );
-				byte_stream_copy_to_uint16_little_endian(
-				 ( (pff_index_node_offset_entry_64bit_t *) node_entry_data )->data_size,
-				 index_value->data_size );
-				byte_stream_copy_to_uint16_little_endian(
-				 ( (pff_index_node_offset_entry_64bit_t *) node_entry_data )->reference_count,
-				 index_value->reference_count );
-			}
+			format_functions->read_index_node_offset_entry(
+			 node_entry_data,
+			 &safe_file_offset,
+			 &data_size,
+			 &( index_value->reference_count ) );
+
+			index_value->data_size = (size32_t) data_size;
+
 			if( safe_file_offset > (uint64_t) INT64_MAX )
 			{
 				libcerror_error_set(
@@ -799,25 +734,11 @@ int libpff_index_read_node_entry(
 	}
 	else
 	{
-		if( index->io_handle->file_type == LIBPFF_FILE_TYPE_32BIT )
-		{
-			byte_stream_copy_to_uint32_little_endian(
-			 ( (pff_index_node_branch_entry_32bit_t *) node_entry_data )->file_offset,
-			 sub_nodes_offset );
-			byte_stream_copy_to_uint32_little_endian(
-			 ( (pff_index_node_branch_entry_32bit_t *) node_entry_data )->back_pointer,
-			 index_value->back_pointer );
-		}
-		else if( ( index->io_handle->file_type == LIBPFF_FILE_TYPE_64BIT )
-		      || ( index->io_handle->file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
-		{
-			byte_stream_copy_to_uint64_little_endian(
-			 ( (pff_index_node_branch_entry_64bit_t *) node_entry_data )->file_offset,
-			 sub_nodes_offset );
-			byte_stream_copy_to_uint64_little_endian(
-			 ( (pff_index_node_branch_entry_64bit_t *) node_entry_data )->back_pointer,
-			 index_value->back_pointer );
-		}
+		format_functions->read_index_node_branch_entry(
+		 node_entry_data,
+		 &( index_value->back_pointer ),
+		 &sub_nodes_offset );
+
 		result = libfdata_tree_node_sub_nodes_data_range_is_set(
 		          index_tree_node,
 		          error );
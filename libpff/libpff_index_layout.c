@@ -0,0 +1,1654 @@
+/*
+ * Index layout functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libpff_definitions.h"
+#include "libpff_format_functions.h"
+#include "libpff_index_layout.h"
+#include "libpff_index_node.h"
+#include "libpff_io_handle.h"
+#include "libpff_libbfio.h"
+#include "libpff_libcerror.h"
+#include "libpff_libfcache.h"
+#include "libpff_libfdata.h"
+
+/* Creates an index layout
+ * Make sure the value index_layout is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_index_layout_initialize(
+     libpff_index_layout_t **index_layout,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_index_layout_initialize";
+
+	if( index_layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index layout.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index_layout != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid index layout value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*index_layout = memory_allocate_structure(
+	                 libpff_index_layout_t );
+
+	if( *index_layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create index layout.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *index_layout,
+	     0,
+	     sizeof( libpff_index_layout_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear index layout.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *index_layout != NULL )
+	{
+		memory_free(
+		 *index_layout );
+
+		*index_layout = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an index layout
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_index_layout_free(
+     libpff_index_layout_t **index_layout,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_index_layout_free";
+
+	if( index_layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index layout.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index_layout != NULL )
+	{
+		if( ( *index_layout )->removed_identifiers != NULL )
+		{
+			memory_free(
+			 ( *index_layout )->removed_identifiers );
+		}
+		if( ( *index_layout )->changed_values != NULL )
+		{
+			memory_free(
+			 ( *index_layout )->changed_values );
+		}
+		if( ( *index_layout )->identifiers != NULL )
+		{
+			memory_free(
+			 ( *index_layout )->identifiers );
+		}
+		if( ( *index_layout )->sorted_node_indexes != NULL )
+		{
+			memory_free(
+			 ( *index_layout )->sorted_node_indexes );
+		}
+		if( ( *index_layout )->nodes != NULL )
+		{
+			memory_free(
+			 ( *index_layout )->nodes );
+		}
+		memory_free(
+		 *index_layout );
+
+		*index_layout = NULL;
+	}
+	return( 1 );
+}
+
+/* Resizes an array so that it can hold at least one more entry
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_index_layout_resize_array(
+     void **array,
+     int *maximum_number_of_entries,
+     int number_of_entries,
+     size_t entry_size,
+     libcerror_error_t **error )
+{
+	void *reallocated_array            = NULL;
+	static char *function              = "libpff_index_layout_resize_array";
+	size_t array_size                  = 0;
+	int safe_maximum_number_of_entries = 0;
+
+	if( array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid array.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_entries < 0 )
+	 || ( number_of_entries > *maximum_number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid entry size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_entries < *maximum_number_of_entries )
+	{
+		return( 1 );
+	}
+	if( *maximum_number_of_entries == 0 )
+	{
+		safe_maximum_number_of_entries = 64;
+	}
+	else if( *maximum_number_of_entries < ( INT_MAX / 2 ) )
+	{
+		safe_maximum_number_of_entries = *maximum_number_of_entries * 2;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size_t) safe_maximum_number_of_entries > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / entry_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid array size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	array_size = entry_size * safe_maximum_number_of_entries;
+
+	reallocated_array = memory_reallocate(
+	                     *array,
+	                     array_size );
+
+	if( reallocated_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize array.",
+		 function );
+
+		return( -1 );
+	}
+	*array                     = reallocated_array;
+	*maximum_number_of_entries = safe_maximum_number_of_entries;
+
+	return( 1 );
+}
+
+/* Appends a node
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_index_layout_append_node(
+     libpff_index_layout_t *index_layout,
+     off64_t offset,
+     uint64_t back_pointer,
+     int *node_index,
+     libcerror_error_t **error )
+{
+	libpff_index_layout_node_t *node = NULL;
+	void *nodes                      = NULL;
+	static char *function            = "libpff_index_layout_append_node";
+
+	if( index_layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index layout.",
+		 function );
+
+		return( -1 );
+	}
+	if( node_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node index.",
+		 function );
+
+		return( -1 );
+	}
+	nodes = (void *) index_layout->nodes;
+
+	if( libpff_index_layout_resize_array(
+	     &nodes,
+	     &( index_layout->maximum_number_of_nodes ),
+	     index_layout->number_of_nodes,
+	     sizeof( libpff_index_layout_node_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize nodes.",
+		 function );
+
+		return( -1 );
+	}
+	index_layout->nodes = (libpff_index_layout_node_t *) nodes;
+
+	node = &( index_layout->nodes[ index_layout->number_of_nodes ] );
+
+	node->offset                   = offset;
+	node->back_pointer             = back_pointer;
+	node->number_of_sub_tree_nodes = 1;
+	node->first_identifier_index   = index_layout->number_of_identifiers;
+	node->number_of_identifiers    = 0;
+	node->is_present               = 0;
+
+	*node_index = index_layout->number_of_nodes;
+
+	index_layout->number_of_nodes += 1;
+
+	return( 1 );
+}
+
+/* Appends a descriptor identifier
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_index_layout_append_identifier(
+     libpff_index_layout_t *index_layout,
+     uint32_t identifier,
+     libcerror_error_t **error )
+{
+	void *identifiers     = NULL;
+	static char *function = "libpff_index_layout_append_identifier";
+
+	if( index_layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index layout.",
+		 function );
+
+		return( -1 );
+	}
+	identifiers = (void *) index_layout->identifiers;
+
+	if( libpff_index_layout_resize_array(
+	     &identifiers,
+	     &( index_layout->maximum_number_of_identifiers ),
+	     index_layout->number_of_identifiers,
+	     sizeof( uint32_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize identifiers.",
+		 function );
+
+		return( -1 );
+	}
+	index_layout->identifiers = (uint32_t *) identifiers;
+
+	index_layout->identifiers[ index_layout->number_of_identifiers ] = identifier;
+
+	index_layout->number_of_identifiers += 1;
+
+	return( 1 );
+}
+
+/* Appends a changed value
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_index_layout_append_changed_value(
+     libpff_index_layout_t *index_layout,
+     uint32_t identifier,
+     uint32_t parent_identifier,
+     uint64_t data_identifier,
+     uint64_t local_descriptors_identifier,
+     libcerror_error_t **error )
+{
+	libpff_index_layout_value_t *changed_value = NULL;
+	void *changed_values                       = NULL;
+	static char *function                      = "libpff_index_layout_append_changed_value";
+
+	if( index_layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index layout.",
+		 function );
+
+		return( -1 );
+	}
+	changed_values = (void *) index_layout->changed_values;
+
+	if( libpff_index_layout_resize_array(
+	     &changed_values,
+	     &( index_layout->maximum_number_of_changed_values ),
+	     index_layout->number_of_changed_values,
+	     sizeof( libpff_index_layout_value_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize changed values.",
+		 function );
+
+		return( -1 );
+	}
+	index_layout->changed_values = (libpff_index_layout_value_t *) changed_values;
+
+	changed_value = &( index_layout->changed_values[ index_layout->number_of_changed_values ] );
+
+	changed_value->identifier                   = identifier;
+	changed_value->parent_identifier            = parent_identifier;
+	changed_value->data_identifier              = data_identifier;
+	changed_value->local_descriptors_identifier = local_descriptors_identifier;
+
+	index_layout->number_of_changed_values += 1;
+
+	return( 1 );
+}
+
+/* Appends a removed descriptor identifier
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_index_layout_append_removed_identifier(
+     libpff_index_layout_t *index_layout,
+     uint32_t identifier,
+     libcerror_error_t **error )
+{
+	void *removed_identifiers = NULL;
+	static char *function     = "libpff_index_layout_append_removed_identifier";
+
+	if( index_layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index layout.",
+		 function );
+
+		return( -1 );
+	}
+	removed_identifiers = (void *) index_layout->removed_identifiers;
+
+	if( libpff_index_layout_resize_array(
+	     &removed_identifiers,
+	     &( index_layout->maximum_number_of_removed_identifiers ),
+	     index_layout->number_of_removed_identifiers,
+	     sizeof( uint32_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize removed identifiers.",
+		 function );
+
+		return( -1 );
+	}
+	index_layout->removed_identifiers = (uint32_t *) removed_identifiers;
+
+	index_layout->removed_identifiers[ index_layout->number_of_removed_identifiers ] = identifier;
+
+	index_layout->number_of_removed_identifiers += 1;
+
+	return( 1 );
+}
+
+/* Retrieves the index of the node with a specific offset and back pointer
+ * Returns 1 if successful, 0 if no such node or -1 on error
+ */
+int libpff_index_layout_get_node_index(
+     libpff_index_layout_t *index_layout,
+     off64_t offset,
+     uint64_t back_pointer,
+     int *node_index,
+     libcerror_error_t **error )
+{
+	libpff_index_layout_node_t *node = NULL;
+	static char *function            = "libpff_index_layout_get_node_index";
+	int lower_index                  = 0;
+	int middle_index                 = 0;
+	int upper_index                  = 0;
+
+	if( index_layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index layout.",
+		 function );
+
+		return( -1 );
+	}
+	if( node_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node index.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_layout->sorted_node_indexes == NULL )
+	{
+		return( 0 );
+	}
+	upper_index = index_layout->number_of_nodes;
+
+	while( lower_index < upper_index )
+	{
+		middle_index = lower_index + ( ( upper_index - lower_index ) / 2 );
+
+		node = &( index_layout->nodes[ index_layout->sorted_node_indexes[ middle_index ] ] );
+
+		if( ( node->offset == offset )
+		 && ( node->back_pointer == back_pointer ) )
+		{
+			*node_index = index_layout->sorted_node_indexes[ middle_index ];
+
+			return( 1 );
+		}
+		if( ( node->offset < offset )
+		 || ( ( node->offset == offset )
+		  &&  ( node->back_pointer < back_pointer ) ) )
+		{
+			lower_index = middle_index + 1;
+		}
+		else
+		{
+			upper_index = middle_index;
+		}
+	}
+	return( 0 );
+}
+
+/* Copies the sub tree of a node of a previous layout
+ * The nodes of the sub tree are marked as present in the previous layout
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_index_layout_copy_sub_tree(
+     libpff_index_layout_t *index_layout,
+     libpff_index_layout_t *previous_index_layout,
+     int previous_node_index,
+     libcerror_error_t **error )
+{
+	libpff_index_layout_node_t *previous_node = NULL;
+	static char *function                     = "libpff_index_layout_copy_sub_tree";
+	int identifier_index                      = 0;
+	int last_node_index                       = 0;
+	int node_index                            = 0;
+
+	if( index_layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index layout.",
+		 function );
+
+		return( -1 );
+	}
+	if( previous_index_layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid previous index layout.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( previous_node_index < 0 )
+	 || ( previous_node_index >= previous_index_layout->number_of_nodes ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid previous node index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	last_node_index = previous_node_index + previous_index_layout->nodes[ previous_node_index ].number_of_sub_tree_nodes;
+
+	if( last_node_index > previous_index_layout->number_of_nodes )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid previous node: %d - number of sub tree nodes value out of bounds.",
+		 function,
+		 previous_node_index );
+
+		return( -1 );
+	}
+	while( previous_node_index < last_node_index )
+	{
+		previous_node = &( previous_index_layout->nodes[ previous_node_index ] );
+
+		if( libpff_index_layout_append_node(
+		     index_layout,
+		     previous_node->offset,
+		     previous_node->back_pointer,
+		     &node_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append node.",
+			 function );
+
+			return( -1 );
+		}
+		for( identifier_index = 0;
+		     identifier_index < previous_node->number_of_identifiers;
+		     identifier_index++ )
+		{
+			if( libpff_index_layout_append_identifier(
+			     index_layout,
+			     previous_index_layout->identifiers[ previous_node->first_identifier_index + identifier_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append identifier.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		index_layout->nodes[ node_index ].number_of_sub_tree_nodes = previous_node->number_of_sub_tree_nodes;
+		index_layout->nodes[ node_index ].number_of_identifiers    = previous_node->number_of_identifiers;
+
+		previous_node->is_present = 1;
+
+		previous_node_index++;
+	}
+	return( 1 );
+}
+
+/* Reads the layout of the descriptors index
+ * The sub trees that are part of the previous layout, if any, are not read again.
+ * The values of the leaf nodes that are read are stored as changed values
+ * and the identifiers of the previous layout that are no longer present are
+ * stored as removed identifiers
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_index_layout_read(
+     libpff_index_layout_t *index_layout,
+     libpff_index_layout_t *previous_index_layout,
+     libpff_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libfdata_vector_t *index_nodes_vector,
+     libfcache_cache_t *index_nodes_cache,
+     off64_t root_node_offset,
+     uint64_t root_node_back_pointer,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_index_layout_read";
+	int node_index        = 0;
+
+	if( index_layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index layout.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_layout->number_of_nodes != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid index layout - nodes already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( previous_index_layout != NULL )
+	{
+		for( node_index = 0;
+		     node_index < previous_index_layout->number_of_nodes;
+		     node_index++ )
+		{
+			previous_index_layout->nodes[ node_index ].is_present = 0;
+		}
+	}
+	if( libpff_index_layout_read_node(
+	     index_layout,
+	     previous_index_layout,
+	     io_handle,
+	     file_io_handle,
+	     index_nodes_vector,
+	     index_nodes_cache,
+	     root_node_offset,
+	     root_node_back_pointer,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read root node at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 root_node_offset,
+		 root_node_offset );
+
+		return( -1 );
+	}
+	if( libpff_index_layout_sort_node_indexes(
+	     index_layout,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to sort node indexes.",
+		 function );
+
+		return( -1 );
+	}
+	if( previous_index_layout != NULL )
+	{
+		if( libpff_index_layout_determine_removed_identifiers(
+		     index_layout,
+		     previous_index_layout,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to determine removed identifiers.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Reads the layout of a descriptors index node and its sub nodes
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_index_layout_read_node(
+     libpff_index_layout_t *index_layout,
+     libpff_index_layout_t *previous_index_layout,
+     libpff_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libfdata_vector_t *index_nodes_vector,
+     libfcache_cache_t *index_nodes_cache,
+     off64_t node_offset,
+     uint64_t back_pointer,
+     int recursion_depth,
+     libcerror_error_t **error )
+{
+	const libpff_format_functions_t *format_functions = NULL;
+	libpff_index_node_t *index_node                   = NULL;
+	uint64_t *sub_node_back_pointers                  = NULL;
+	uint64_t *sub_node_offsets                        = NULL;
+	uint8_t *node_entry_data                          = NULL;
+	uint8_t *node_entries_data                        = NULL;
+	static char *function                             = "libpff_index_layout_read_node";
+	uint64_t data_identifier                          = 0;
+	uint64_t identifier                               = 0;
+	uint64_t local_descriptors_identifier             = 0;
+	uint32_t parent_identifier                        = 0;
+	uint16_t entry_index                              = 0;
+	uint16_t number_of_entries                        = 0;
+	int element_data_offset                           = 0;
+	int node_index                                    = 0;
+	int previous_node_index                           = 0;
+	int result                                        = 0;
+
+	if( index_layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index layout.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	format_functions = io_handle->format_functions;
+
+	if( format_functions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing format functions.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( recursion_depth < 0 )
+	 || ( recursion_depth > LIBPFF_MAXIMUM_INDEX_TREE_RECURSION_DEPTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid recursion depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( previous_index_layout != NULL )
+	{
+		result = libpff_index_layout_get_node_index(
+		          previous_index_layout,
+		          node_offset,
+		          back_pointer,
+		          &previous_node_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve previous node index.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			/* The node was not rewritten hence its sub tree is unchanged
+			 */
+			if( libpff_index_layout_copy_sub_tree(
+			     index_layout,
+			     previous_index_layout,
+			     previous_node_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+				 "%s: unable to copy sub tree of previous node: %d.",
+				 function,
+				 previous_node_index );
+
+				goto on_error;
+			}
+			return( 1 );
+		}
+	}
+	if( libfdata_vector_get_element_value_at_offset(
+	     index_nodes_vector,
+	     (intptr_t *) file_io_handle,
+	     (libfdata_cache_t *) index_nodes_cache,
+	     node_offset,
+	     &element_data_offset,
+	     (intptr_t **) &index_node,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve index node at offset: %" PRIi64 ".",
+		 function,
+		 node_offset );
+
+		goto on_error;
+	}
+	if( index_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing index node.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( index_node->number_of_entries > 0 )
+	 && ( index_node->back_pointer != back_pointer ) )
+	{
+		/* The cached index node is stale if its page has been reused
+		 */
+		if( libfdata_vector_get_element_value_at_offset(
+		     index_nodes_vector,
+		     (intptr_t *) file_io_handle,
+		     (libfdata_cache_t *) index_nodes_cache,
+		     node_offset,
+		     &element_data_offset,
+		     (intptr_t **) &index_node,
+		     LIBFDATA_READ_FLAG_IGNORE_CACHE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve index node at offset: %" PRIi64 ".",
+			 function,
+			 node_offset );
+
+			goto on_error;
+		}
+		if( index_node == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing index node.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( index_node->type != LIBPFF_INDEX_TYPE_DESCRIPTOR )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported index node type: 0x%02" PRIx8 ".",
+		 function,
+		 index_node->type );
+
+		goto on_error;
+	}
+	if( ( index_node->number_of_entries > 0 )
+	 && ( index_node->level != LIBPFF_INDEX_NODE_LEVEL_LEAF )
+	 && ( index_node->back_pointer != back_pointer ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: back pointer mismatch (entry: %" PRIu64 ", node: %" PRIu64 ").",
+		 function,
+		 back_pointer,
+		 index_node->back_pointer );
+
+		goto on_error;
+	}
+	if( libpff_index_layout_append_node(
+	     index_layout,
+	     node_offset,
+	     back_pointer,
+	     &node_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append node.",
+		 function );
+
+		goto on_error;
+	}
+	number_of_entries = index_node->number_of_entries;
+
+	if( index_node->level == LIBPFF_INDEX_NODE_LEVEL_LEAF )
+	{
+		for( entry_index = 0;
+		     entry_index < number_of_entries;
+		     entry_index++ )
+		{
+			if( libpff_index_node_get_entry_data(
+			     index_node,
+			     entry_index,
+			     &node_entry_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve node entry: %" PRIu16 " data.",
+				 function,
+				 entry_index );
+
+				goto on_error;
+			}
+			if( node_entry_data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing node entry: %" PRIu16 " data.",
+				 function,
+				 entry_index );
+
+				goto on_error;
+			}
+			format_functions->read_node_entry_identifier(
+			 node_entry_data,
+			 &identifier );
+
+			/* Ignore the upper 32-bit of descriptor identifiers
+			 */
+			identifier &= 0xffffffffUL;
+
+			format_functions->read_index_node_descriptor_entry(
+			 node_entry_data,
+			 &data_identifier,
+			 &local_descriptors_identifier,
+			 &parent_identifier );
+
+			if( libpff_index_layout_append_identifier(
+			     index_layout,
+			     (uint32_t) identifier,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append identifier.",
+				 function );
+
+				goto on_error;
+			}
+			if( libpff_index_layout_append_changed_value(
+			     index_layout,
+			     (uint32_t) identifier,
+			     parent_identifier,
+			     data_identifier,
+			     local_descriptors_identifier,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append changed value.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		index_layout->nodes[ node_index ].number_of_identifiers = (int) number_of_entries;
+	}
+	else if( number_of_entries > 0 )
+	{
+		/* The index node can be evicted from the cache when its sub nodes
+		 * are read hence the branch entries are copied first
+		 */
+		sub_node_offsets = (uint64_t *) memory_allocate(
+		                                 sizeof( uint64_t ) * number_of_entries );
+
+		if( sub_node_offsets == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create sub node offsets.",
+			 function );
+
+			goto on_error;
+		}
+		sub_node_back_pointers = (uint64_t *) memory_allocate(
+		                                       sizeof( uint64_t ) * number_of_entries );
+
+		if( sub_node_back_pointers == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create sub node back pointers.",
+			 function );
+
+			goto on_error;
+		}
+		if( libpff_index_node_get_entries_data(
+		     index_node,
+		     0,
+		     number_of_entries,
+		     format_functions->index_node_entry_size,
+		     &node_entries_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve node entries data.",
+			 function );
+
+			goto on_error;
+		}
+		format_functions->read_index_node_branch_entries(
+		 node_entries_data,
+		 number_of_entries,
+		 sub_node_back_pointers,
+		 sub_node_offsets );
+
+		for( entry_index = 0;
+		     entry_index < number_of_entries;
+		     entry_index++ )
+		{
+			if( sub_node_offsets[ entry_index ] > (uint64_t) INT64_MAX )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid node entry: %" PRIu16 " offset value out of bounds.",
+				 function,
+				 entry_index );
+
+				goto on_error;
+			}
+		}
+		for( entry_index = 0;
+		     entry_index < number_of_entries;
+		     entry_index++ )
+		{
+			if( libpff_index_layout_read_node(
+			     index_layout,
+			     previous_index_layout,
+			     io_handle,
+			     file_io_handle,
+			     index_nodes_vector,
+			     index_nodes_cache,
+			     (off64_t) sub_node_offsets[ entry_index ],
+			     sub_node_back_pointers[ entry_index ],
+			     recursion_depth + 1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read sub node: %" PRIu16 " at offset: %" PRIu64 " (0x%08" PRIx64 ").",
+				 function,
+				 entry_index,
+				 sub_node_offsets[ entry_index ],
+				 sub_node_offsets[ entry_index ] );
+
+				goto on_error;
+			}
+		}
+		memory_free(
+		 sub_node_back_pointers );
+
+		sub_node_back_pointers = NULL;
+
+		memory_free(
+		 sub_node_offsets );
+
+		sub_node_offsets = NULL;
+	}
+	index_layout->nodes[ node_index ].number_of_sub_tree_nodes = index_layout->number_of_nodes - node_index;
+
+	return( 1 );
+
+on_error:
+	if( sub_node_back_pointers != NULL )
+	{
+		memory_free(
+		 sub_node_back_pointers );
+	}
+	if( sub_node_offsets != NULL )
+	{
+		memory_free(
+		 sub_node_offsets );
+	}
+	return( -1 );
+}
+
+/* Sorts the node indexes by offset and back pointer
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_index_layout_sort_node_indexes(
+     libpff_index_layout_t *index_layout,
+     libcerror_error_t **error )
+{
+	libpff_index_layout_node_t *child_node = NULL;
+	libpff_index_layout_node_t *node       = NULL;
+	static char *function                  = "libpff_index_layout_sort_node_indexes";
+	int *sorted_node_indexes               = NULL;
+	int child_index                        = 0;
+	int end_index                          = 0;
+	int node_index                         = 0;
+	int parent_index                       = 0;
+	int start_index                        = 0;
+
+	if( index_layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index layout.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_layout->sorted_node_indexes != NULL )
+	{
+		memory_free(
+		 index_layout->sorted_node_indexes );
+
+		index_layout->sorted_node_indexes = NULL;
+	}
+	if( index_layout->number_of_nodes == 0 )
+	{
+		return( 1 );
+	}
+	if( (size_t) index_layout->number_of_nodes > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( int ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of nodes value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	sorted_node_indexes = (int *) memory_allocate(
+	                               sizeof( int ) * index_layout->number_of_nodes );
+
+	if( sorted_node_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sorted node indexes.",
+		 function );
+
+		return( -1 );
+	}
+	for( node_index = 0;
+	     node_index < index_layout->number_of_nodes;
+	     node_index++ )
+	{
+		sorted_node_indexes[ node_index ] = node_index;
+	}
+	/* Heap sort the node indexes
+	 */
+	start_index = index_layout->number_of_nodes / 2;
+	end_index   = index_layout->number_of_nodes;
+
+	while( end_index > 1 )
+	{
+		if( start_index > 0 )
+		{
+			start_index--;
+		}
+		else
+		{
+			end_index--;
+
+			node_index                       = sorted_node_indexes[ end_index ];
+			sorted_node_indexes[ end_index ] = sorted_node_indexes[ 0 ];
+			sorted_node_indexes[ 0 ]         = node_index;
+		}
+		parent_index = start_index;
+
+		while( ( ( 2 * parent_index ) + 1 ) < end_index )
+		{
+			child_index = ( 2 * parent_index ) + 1;
+
+			if( ( child_index + 1 ) < end_index )
+			{
+				node       = &( index_layout->nodes[ sorted_node_indexes[ child_index ] ] );
+				child_node = &( index_layout->nodes[ sorted_node_indexes[ child_index + 1 ] ] );
+
+				if( ( node->offset < child_node->offset )
+				 || ( ( node->offset == child_node->offset )
+				  &&  ( node->back_pointer < child_node->back_pointer ) ) )
+				{
+					child_index++;
+				}
+			}
+			node       = &( index_layout->nodes[ sorted_node_indexes[ parent_index ] ] );
+			child_node = &( index_layout->nodes[ sorted_node_indexes[ child_index ] ] );
+
+			if( ( node->offset > child_node->offset )
+			 || ( ( node->offset == child_node->offset )
+			  &&  ( node->back_pointer >= child_node->back_pointer ) ) )
+			{
+				break;
+			}
+			node_index                          = sorted_node_indexes[ parent_index ];
+			sorted_node_indexes[ parent_index ] = sorted_node_indexes[ child_index ];
+			sorted_node_indexes[ child_index ]  = node_index;
+
+			parent_index = child_index;
+		}
+	}
+	index_layout->sorted_node_indexes = sorted_node_indexes;
+
+	return( 1 );
+}
+
+/* Sorts descriptor identifiers
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_index_layout_sort_identifiers(
+     uint32_t *identifiers,
+     int number_of_identifiers,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_index_layout_sort_identifiers";
+	uint32_t identifier   = 0;
+	int child_index       = 0;
+	int end_index         = 0;
+	int parent_index      = 0;
+	int start_index       = 0;
+
+	if( identifiers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid identifiers.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_identifiers < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of identifiers value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	/* Heap sort the identifiers
+	 */
+	start_index = number_of_identifiers / 2;
+	end_index   = number_of_identifiers;
+
+	while( end_index > 1 )
+	{
+		if( start_index > 0 )
+		{
+			start_index--;
+		}
+		else
+		{
+			end_index--;
+
+			identifier               = identifiers[ end_index ];
+			identifiers[ end_index ] = identifiers[ 0 ];
+			identifiers[ 0 ]         = identifier;
+		}
+		parent_index = start_index;
+
+		while( ( ( 2 * parent_index ) + 1 ) < end_index )
+		{
+			child_index = ( 2 * parent_index ) + 1;
+
+			if( ( ( child_index + 1 ) < end_index )
+			 && ( identifiers[ child_index ] < identifiers[ child_index + 1 ] ) )
+			{
+				child_index++;
+			}
+			if( identifiers[ parent_index ] >= identifiers[ child_index ] )
+			{
+				break;
+			}
+			identifier                  = identifiers[ parent_index ];
+			identifiers[ parent_index ] = identifiers[ child_index ];
+			identifiers[ child_index ]  = identifier;
+
+			parent_index = child_index;
+		}
+	}
+	return( 1 );
+}
+
+/* Determines the identifiers of the previous layout that are no longer present
+ * These are the identifiers of the leaf nodes of the previous layout that are
+ * not part of this layout and are not one of the changed values
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_index_layout_determine_removed_identifiers(
+     libpff_index_layout_t *index_layout,
+     libpff_index_layout_t *previous_index_layout,
+     libcerror_error_t **error )
+{
+	libpff_index_layout_node_t *previous_node = NULL;
+	uint32_t *changed_identifiers             = NULL;
+	static char *function                     = "libpff_index_layout_determine_removed_identifiers";
+	uint32_t identifier                       = 0;
+	int identifier_index                      = 0;
+	int lower_index                           = 0;
+	int middle_index                          = 0;
+	int node_index                            = 0;
+	int upper_index                           = 0;
+	int value_index                           = 0;
+
+	if( index_layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index layout.",
+		 function );
+
+		return( -1 );
+	}
+	if( previous_index_layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid previous index layout.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_layout->number_of_changed_values > 0 )
+	{
+		changed_identifiers = (uint32_t *) memory_allocate(
+		                                    sizeof( uint32_t ) * index_layout->number_of_changed_values );
+
+		if( changed_identifiers == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create changed identifiers.",
+			 function );
+
+			goto on_error;
+		}
+		for( value_index = 0;
+		     value_index < index_layout->number_of_changed_values;
+		     value_index++ )
+		{
+			changed_identifiers[ value_index ] = index_layout->changed_values[ value_index ].identifier;
+		}
+		if( libpff_index_layout_sort_identifiers(
+		     changed_identifiers,
+		     index_layout->number_of_changed_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to sort changed identifiers.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( node_index = 0;
+	     node_index < previous_index_layout->number_of_nodes;
+	     node_index++ )
+	{
+		previous_node = &( previous_index_layout->nodes[ node_index ] );
+
+		if( previous_node->is_present != 0 )
+		{
+			continue;
+		}
+		for( identifier_index = 0;
+		     identifier_index < previous_node->number_of_identifiers;
+		     identifier_index++ )
+		{
+			identifier = previous_index_layout->identifiers[ previous_node->first_identifier_index + identifier_index ];
+
+			lower_index = 0;
+			upper_index = index_layout->number_of_changed_values;
+
+			while( lower_index < upper_index )
+			{
+				middle_index = lower_index + ( ( upper_index - lower_index ) / 2 );
+
+				if( changed_identifiers[ middle_index ] == identifier )
+				{
+					break;
+				}
+				if( changed_identifiers[ middle_index ] < identifier )
+				{
+					lower_index = middle_index + 1;
+				}
+				else
+				{
+					upper_index = middle_index;
+				}
+			}
+			if( lower_index < upper_index )
+			{
+				continue;
+			}
+			if( libpff_index_layout_append_removed_identifier(
+			     index_layout,
+			     identifier,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append removed identifier.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	if( changed_identifiers != NULL )
+	{
+		memory_free(
+		 changed_identifiers );
+	}
+	return( 1 );
+
+on_error:
+	if( changed_identifiers != NULL )
+	{
+		memory_free(
+		 changed_identifiers );
+	}
+	return( -1 );
+}
+
+/* Clears the changed values and removed identifiers
+ * This is used once the changes have been applied, to retain the layout
+ * as the previous layout of a next refresh
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_index_layout_clear_changes(
+     libpff_index_layout_t *index_layout,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_index_layout_clear_changes";
+
+	if( index_layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index layout.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_layout->changed_values != NULL )
+	{
+		memory_free(
+		 index_layout->changed_values );
+
+		index_layout->changed_values = NULL;
+	}
+	index_layout->number_of_changed_values         = 0;
+	index_layout->maximum_number_of_changed_values = 0;
+
+	if( index_layout->removed_identifiers != NULL )
+	{
+		memory_free(
+		 index_layout->removed_identifiers );
+
+		index_layout->removed_identifiers = NULL;
+	}
+	index_layout->number_of_removed_identifiers         = 0;
+	index_layout->maximum_number_of_removed_identifiers = 0;
+
+	return( 1 );
+}
+
@@ -0,0 +1,249 @@
+/*
+ * Index layout functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPFF_INDEX_LAYOUT_H )
+#define _LIBPFF_INDEX_LAYOUT_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libpff_io_handle.h"
+#include "libpff_libbfio.h"
+#include "libpff_libcerror.h"
+#include "libpff_libfcache.h"
+#include "libpff_libfdata.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libpff_index_layout_node libpff_index_layout_node_t;
+
+struct libpff_index_layout_node
+{
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The back pointer
+	 */
+	uint64_t back_pointer;
+
+	/* The number of nodes in the sub tree, including the node itself
+	 */
+	int number_of_sub_tree_nodes;
+
+	/* The index of the first descriptor identifier of a leaf node
+	 */
+	int first_identifier_index;
+
+	/* The number of descriptor identifiers of a leaf node
+	 */
+	int number_of_identifiers;
+
+	/* Value to indicate the node is also part of a newer layout
+	 */
+	uint8_t is_present;
+};
+
+typedef struct libpff_index_layout_value libpff_index_layout_value_t;
+
+struct libpff_index_layout_value
+{
+	/* The descriptor identifier
+	 */
+	uint32_t identifier;
+
+	/* The parent descriptor identifier
+	 */
+	uint32_t parent_identifier;
+
+	/* The data identifier
+	 */
+	uint64_t data_identifier;
+
+	/* The local descriptors identifier
+	 */
+	uint64_t local_descriptors_identifier;
+};
+
+typedef struct libpff_index_layout libpff_index_layout_t;
+
+/* The index layout records the nodes of the descriptors index and the descriptor
+ * identifiers stored in its leaf nodes. Index nodes are written to a new location,
+ * with a new back pointer, when they change, hence a node with the same offset and
+ * back pointer as in a previous layout has the same sub tree and is not read again
+ */
+struct libpff_index_layout
+{
+	/* The nodes, in the order of a depth first walk
+	 */
+	libpff_index_layout_node_t *nodes;
+
+	/* The number of nodes
+	 */
+	int number_of_nodes;
+
+	/* The maximum number of nodes
+	 */
+	int maximum_number_of_nodes;
+
+	/* The node indexes sorted by offset and back pointer
+	 */
+	int *sorted_node_indexes;
+
+	/* The descriptor identifiers of the leaf nodes
+	 */
+	uint32_t *identifiers;
+
+	/* The number of descriptor identifiers
+	 */
+	int number_of_identifiers;
+
+	/* The maximum number of descriptor identifiers
+	 */
+	int maximum_number_of_identifiers;
+
+	/* The values of the leaf nodes that are not part of the previous layout
+	 */
+	libpff_index_layout_value_t *changed_values;
+
+	/* The number of changed values
+	 */
+	int number_of_changed_values;
+
+	/* The maximum number of changed values
+	 */
+	int maximum_number_of_changed_values;
+
+	/* The descriptor identifiers of the previous layout that no longer exist
+	 */
+	uint32_t *removed_identifiers;
+
+	/* The number of removed descriptor identifiers
+	 */
+	int number_of_removed_identifiers;
+
+	/* The maximum number of removed descriptor identifiers
+	 */
+	int maximum_number_of_removed_identifiers;
+};
+
+int libpff_index_layout_initialize(
+     libpff_index_layout_t **index_layout,
+     libcerror_error_t **error );
+
+int libpff_index_layout_free(
+     libpff_index_layout_t **index_layout,
+     libcerror_error_t **error );
+
+int libpff_index_layout_resize_array(
+     void **array,
+     int *maximum_number_of_entries,
+     int number_of_entries,
+     size_t entry_size,
+     libcerror_error_t **error );
+
+int libpff_index_layout_append_node(
+     libpff_index_layout_t *index_layout,
+     off64_t offset,
+     uint64_t back_pointer,
+     int *node_index,
+     libcerror_error_t **error );
+
+int libpff_index_layout_append_identifier(
+     libpff_index_layout_t *index_layout,
+     uint32_t identifier,
+     libcerror_error_t **error );
+
+int libpff_index_layout_append_changed_value(
+     libpff_index_layout_t *index_layout,
+     uint32_t identifier,
+     uint32_t parent_identifier,
+     uint64_t data_identifier,
+     uint64_t local_descriptors_identifier,
+     libcerror_error_t **error );
+
+int libpff_index_layout_append_removed_identifier(
+     libpff_index_layout_t *index_layout,
+     uint32_t identifier,
+     libcerror_error_t **error );
+
+int libpff_index_layout_get_node_index(
+     libpff_index_layout_t *index_layout,
+     off64_t offset,
+     uint64_t back_pointer,
+     int *node_index,
+     libcerror_error_t **error );
+
+int libpff_index_layout_copy_sub_tree(
+     libpff_index_layout_t *index_layout,
+     libpff_index_layout_t *previous_index_layout,
+     int previous_node_index,
+     libcerror_error_t **error );
+
+int libpff_index_layout_read(
+     libpff_index_layout_t *index_layout,
+     libpff_index_layout_t *previous_index_layout,
+     libpff_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libfdata_vector_t *index_nodes_vector,
+     libfcache_cache_t *index_nodes_cache,
+     off64_t root_node_offset,
+     uint64_t root_node_back_pointer,
+     libcerror_error_t **error );
+
+int libpff_index_layout_read_node(
+     libpff_index_layout_t *index_layout,
+     libpff_index_layout_t *previous_index_layout,
+     libpff_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libfdata_vector_t *index_nodes_vector,
+     libfcache_cache_t *index_nodes_cache,
+     off64_t node_offset,
+     uint64_t back_pointer,
+     int recursion_depth,
+     libcerror_error_t **error );
+
+int libpff_index_layout_sort_node_indexes(
+     libpff_index_layout_t *index_layout,
+     libcerror_error_t **error );
+
+int libpff_index_layout_sort_identifiers(
+     uint32_t *identifiers,
+     int number_of_identifiers,
+     libcerror_error_t **error );
+
+int libpff_index_layout_determine_removed_identifiers(
+     libpff_index_layout_t *index_layout,
+     libpff_index_layout_t *previous_index_layout,
+     libcerror_error_t **error );
+
+int libpff_index_layout_clear_changes(
+     libpff_index_layout_t *index_layout,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPFF_INDEX_LAYOUT_H ) */
+
@@ -25,7 +25,9 @@
 #include <types.h>
 
 #include "libpff_definitions.h"
+#include "libpff_format_functions.h"
 #include "libpff_index_node.h"
+#include "libpff_io_handle.h"
 #include "libpff_libbfio.h"
 #include "libpff_libcerror.h"
 #include "libpff_libcnotify.h"
@@ -216,6 +218,96 @@ int libpff_index_node_get_entry_data(
 	return( 1 );
 }
 
+/* Retrieves the data of a range of entries
+ * The entry size is the format specific size the entries data is processed with
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_index_node_get_entries_data(
+     libpff_index_node_t *index_node,
+     uint16_t entry_index,
+     uint16_t number_of_entries,
+     uint8_t entry_size,
+     uint8_t **entries_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_index_node_get_entries_data";
+	size_t entries_size   = 0;
+	size_t entry_offset   = 0;
+
+	if( index_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index node.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_node->entries_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid index node - missing entries data.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid entry size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( entries_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entries data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( (uint32_t) entry_index + (uint32_t) number_of_entries ) > (uint32_t) index_node->maximum_number_of_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	entry_offset = (size_t) entry_size * entry_index;
+	entries_size = (size_t) entry_size * number_of_entries;
+
+	if( ( entry_offset + entries_size ) > (size_t) index_node->maximum_entries_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: number of entries value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*entries_data = &( index_node->entries_data[ entry_offset ] );
+
+	return( 1 );
+}
+
 /* Reads an index node
  * Returns 1 if successful or -1 on error
  */
@@ -226,23 +318,24 @@ int libpff_index_node_read_data(
      uint8_t file_type,
      libcerror_error_t **error )
 {
-	static char *function                        = "libpff_index_node_read_data";
-	size_t checksum_data_size                    = 0;
-	size_t index_node_data_size                  = 0;
-	size_t index_node_footer_data_size           = 0;
-	size_t maximum_entries_data_size             = 0;
-	uint32_t calculated_checksum                 = 0;
-	uint8_t calculated_entry_size                = 0;
-	uint8_t calculated_maximum_number_of_entries = 0;
+	const libpff_format_functions_t *format_functions = NULL;
+	static char *function                             = "libpff_index_node_read_data";
+	size_t checksum_data_size                         = 0;
+	size_t index_node_data_size                       = 0;
+	size_t index_node_footer_data_size                = 0;
+	size_t maximum_entries_data_size                  = 0;
+	uint32_t calculated_checksum                      = 0;
+	uint8_t calculated_entry_size                     = 0;
+	uint8_t calculated_maximum_number_of_entries      = 0;
 
 #if defined( HAVE_DEBUG_OUTPUT )
-	uint8_t *index_node_entry_data               = NULL;
-	uint64_t value_64bit                         = 0;
-	uint32_t value_32bit                         = 0;
-	uint16_t entry_index                         = 0;
-	uint16_t index_node_entry_data_size          = 0;
-	uint16_t value_16bit                         = 0;
-	int result                                   = 0;
+	uint8_t *index_node_entry_data                    = NULL;
+	uint64_t value_64bit                              = 0;
+	uint32_t value_32bit                              = 0;
+	uint16_t entry_index                              = 0;
+	uint16_t index_node_entry_data_size               = 0;
+	uint16_t value_16bit                              = 0;
+	int result                                        = 0;
 #endif
 
 	if( index_node == NULL )
@@ -278,38 +371,24 @@ int libpff_index_node_read_data(
 
 		return( -1 );
 	}
-	if( ( file_type != LIBPFF_FILE_TYPE_32BIT )
-	 && ( file_type != LIBPFF_FILE_TYPE_64BIT )
-	 && ( file_type != LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
+	if( libpff_format_functions_get(
+	     file_type,
+	     &format_functions,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported file type.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve format functions.",
 		 function );
 
 		return( -1 );
 	}
-	if( file_type == LIBPFF_FILE_TYPE_32BIT )
-	{
-		checksum_data_size          = 500;
-		index_node_data_size        = 512;
-		index_node_footer_data_size = sizeof( pff_index_node_32bit_footer_t );
-	}
-	else if( file_type == LIBPFF_FILE_TYPE_64BIT )
-	{
-		checksum_data_size          = 496;
-		index_node_data_size        = 512;
-		index_node_footer_data_size = sizeof( pff_index_node_64bit_footer_t );
-	}
-	else if( file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE )
-	{
-		checksum_data_size          = 4072;
-		index_node_data_size        = 4096;
-		index_node_footer_data_size = sizeof( pff_index_node_64bit_4k_page_footer_t );
-	}
-	maximum_entries_data_size = index_node_data_size - index_node_footer_data_size;
+	checksum_data_size          = format_functions->index_node_checksum_data_size;
+	index_node_data_size        = format_functions->index_node_size;
+	index_node_footer_data_size = format_functions->index_node_footer_size;
+	maximum_entries_data_size   = index_node_data_size - index_node_footer_data_size;
 
 	if( data_size < index_node_data_size )
 	{
@@ -380,48 +459,17 @@ int libpff_index_node_read_data(
 #endif
 		/* TODO smart error handling */
 	}
-	if( file_type == LIBPFF_FILE_TYPE_32BIT )
+	if( ( index_node->type == LIBPFF_INDEX_TYPE_DESCRIPTOR )
+	 && ( index_node->level == LIBPFF_INDEX_NODE_LEVEL_LEAF ) )
 	{
-		if( ( index_node->type == LIBPFF_INDEX_TYPE_DESCRIPTOR )
-		 && ( index_node->level == LIBPFF_INDEX_NODE_LEVEL_LEAF ) )
-		{
-			calculated_entry_size                = 16;
-			calculated_maximum_number_of_entries = 496 / 16;
-		}
-		else
-		{
-			calculated_entry_size                = 12;
-			calculated_maximum_number_of_entries = 496 / 12;
-		}
+		calculated_entry_size = format_functions->index_node_descriptor_entry_size;
 	}
-	else if( file_type == LIBPFF_FILE_TYPE_64BIT )
+	else
 	{
-		if( ( index_node->type == LIBPFF_INDEX_TYPE_DESCRIPTOR )
-		 && ( index_node->level == LIBPFF_INDEX_NODE_LEVEL_LEAF ) )
-		{
-			calculated_entry_size                = 32;
-			calculated_maximum_number_of_entries = 488 / 32;
-		}
-		else
-		{
-			calculated_entry_size                = 24;
-			calculated_maximum_number_of_entries = 488 / 24;
-		}
-	}
-	else if( file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE )
-	{
-		if( ( index_node->type == LIBPFF_INDEX_TYPE_DESCRIPTOR )
-		 && ( index_node->level == LIBPFF_INDEX_NODE_LEVEL_LEAF ) )
-		{
-			calculated_entry_size                = 32;
-			calculated_maximum_number_of_entries = 4056 / 32;
-		}
-		else
-		{
-			calculated_entry_size                = 24;
-			calculated_maximum_number_of_entries = 4056 / 24;
-		}
+		calculated_entry_size = format_functions->index_node_entry_size;
 	}
+	calculated_maximum_number_of_entries = (uint8_t) ( maximum_entries_data_size / calculated_entry_size );
+
 	if( ( index_node->entry_size != 0 )
 	 && ( index_node->entry_size != calculated_entry_size ) )
 	{
@@ -1071,9 +1119,9 @@ int libpff_index_node_read_footer_data(
  */
 int libpff_index_node_read_file_io_handle(
      libpff_index_node_t *index_node,
+     libpff_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      off64_t node_offset,
-     uint8_t file_type,
      libcerror_error_t **error )
 {
 	static char *function = "libpff_index_node_read_file_io_handle";
@@ -1101,9 +1149,20 @@ int libpff_index_node_read_file_io_handle(
 
 		return( -1 );
 	}
-	if( ( file_type != LIBPFF_FILE_TYPE_32BIT )
-	 && ( file_type != LIBPFF_FILE_TYPE_64BIT )
-	 && ( file_type != LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( io_handle->file_type != LIBPFF_FILE_TYPE_32BIT )
+	 && ( io_handle->file_type != LIBPFF_FILE_TYPE_64BIT )
+	 && ( io_handle->file_type != LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -1114,15 +1173,31 @@ int libpff_index_node_read_file_io_handle(
 
 		return( -1 );
 	}
-	if( (file_type == LIBPFF_FILE_TYPE_32BIT )
-	 || ( file_type == LIBPFF_FILE_TYPE_64BIT ) )
+	if( ( io_handle->file_type == LIBPFF_FILE_TYPE_32BIT )
+	 || ( io_handle->file_type == LIBPFF_FILE_TYPE_64BIT ) )
 	{
 		index_node->data_size = 512;
 	}
-	else if( file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE )
+	else if( io_handle->file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE )
 	{
 		index_node->data_size = 4096;
 	}
+	if( libpff_io_handle_check_read_limits(
+	     io_handle,
+	     (size_t) index_node->data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_ABORT_REQUESTED,
+		 "%s: unable to read index node data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 node_offset,
+		 node_offset );
+
+		return( -1 );
+	}
 	index_node->data = (uint8_t *) memory_allocate(
 	                                sizeof( uint8_t ) * index_node->data_size );
 
@@ -1171,7 +1246,7 @@ int libpff_index_node_read_file_io_handle(
 	     index_node,
 	     index_node->data,
 	     index_node->data_size,
-	     file_type,
+	     io_handle->file_type,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libpff_io_handle.h"
 #include "libpff_libbfio.h"
 #include "libpff_libcerror.h"
 
@@ -95,6 +96,14 @@ int libpff_index_node_get_entry_data(
      uint8_t **entry_data,
      libcerror_error_t **error );
 
+int libpff_index_node_get_entries_data(
+     libpff_index_node_t *index_node,
+     uint16_t entry_index,
+     uint16_t number_of_entries,
+     uint8_t entry_size,
+     uint8_t **entries_data,
+     libcerror_error_t **error );
+
 int libpff_index_node_read_data(
      libpff_index_node_t *index_node,
      const uint8_t *data,
@@ -111,9 +120,9 @@ int libpff_index_node_read_footer_data(
 
 int libpff_index_node_read_file_io_handle(
      libpff_index_node_t *index_node,
+     libpff_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      off64_t node_offset,
-     uint8_t file_type,
      libcerror_error_t **error );
 
 int libpff_index_node_check_for_empty_block(
@@ -1834,3 +1834,193 @@ int libpff_index_tree_insert_value(
 	return( 1 );
 }
 
+/* Prefetches the upper levels of the index tree
+ * Reads the branch nodes up to maximum depth levels, where the root node is level 1
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_index_tree_prefetch(
+     libpff_index_tree_t *index_tree,
+     libbfio_handle_t *file_io_handle,
+     libfcache_cache_t *cache,
+     int maximum_depth,
+     libcerror_error_t **error )
+{
+	libfdata_tree_node_t *index_tree_root_node = NULL;
+	static char *function                      = "libpff_index_tree_prefetch";
+
+	if( index_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_depth < 0 )
+	 || ( maximum_depth > LIBPFF_MAXIMUM_INDEX_TREE_RECURSION_DEPTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_tree_get_root_node(
+	     index_tree->tree,
+	     &index_tree_root_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve root node from index tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_index_tree_node_prefetch(
+	     index_tree_root_node,
+	     file_io_handle,
+	     cache,
+	     maximum_depth,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to prefetch root node.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Prefetches the branch nodes of the index tree node
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_index_tree_node_prefetch(
+     libfdata_tree_node_t *index_tree_node,
+     libbfio_handle_t *file_io_handle,
+     libfcache_cache_t *cache,
+     int maximum_depth,
+     libcerror_error_t **error )
+{
+	libfdata_tree_node_t *index_tree_sub_node = NULL;
+	static char *function                     = "libpff_index_tree_node_prefetch";
+	int number_of_sub_nodes                   = 0;
+	int result                                = 0;
+	int sub_node_index                        = 0;
+
+	if( index_tree_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index tree node.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_depth <= 0 )
+	{
+		return( 1 );
+	}
+	result = libfdata_tree_node_is_leaf(
+	          index_tree_node,
+	          (intptr_t *) file_io_handle,
+	          (libfdata_cache_t *) cache,
+	          0,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if index tree node is a leaf node.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		return( 1 );
+	}
+	/* Retrieving the number of sub nodes reads the branch node
+	 */
+	if( libfdata_tree_node_get_number_of_sub_nodes(
+	     index_tree_node,
+	     (intptr_t *) file_io_handle,
+	     (libfdata_cache_t *) cache,
+	     &number_of_sub_nodes,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub nodes from index tree node.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_depth == 1 )
+	{
+		return( 1 );
+	}
+	for( sub_node_index = 0;
+	     sub_node_index < number_of_sub_nodes;
+	     sub_node_index++ )
+	{
+		if( libfdata_tree_node_get_sub_node_by_index(
+		     index_tree_node,
+		     (intptr_t *) file_io_handle,
+		     (libfdata_cache_t *) cache,
+		     sub_node_index,
+		     &index_tree_sub_node,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub node: %d from index tree node.",
+			 function,
+			 sub_node_index );
+
+			return( -1 );
+		}
+		if( libpff_index_tree_node_prefetch(
+		     index_tree_sub_node,
+		     file_io_handle,
+		     cache,
+		     maximum_depth - 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to prefetch sub node: %d.",
+			 function,
+			 sub_node_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
@@ -161,6 +161,20 @@ int libpff_index_tree_insert_value(
      size64_t node_data_size,
      libcerror_error_t **error );
 
+int libpff_index_tree_prefetch(
+     libpff_index_tree_t *index_tree,
+     libbfio_handle_t *file_io_handle,
+     libfcache_cache_t *cache,
+     int maximum_depth,
+     libcerror_error_t **error );
+
+int libpff_index_tree_node_prefetch(
+     libfdata_tree_node_t *index_tree_node,
+     libbfio_handle_t *file_io_handle,
+     libfcache_cache_t *cache,
+     int maximum_depth,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -24,10 +24,16 @@
 #include <memory.h>
 #include <types.h>
 
+#if !defined( WINAPI )
+#include <time.h>
+#endif
+
 #include "libpff_allocation_table.h"
+#include "libpff_caller_io_handle.h"
 #include "libpff_codepage.h"
 #include "libpff_definitions.h"
 #include "libpff_file_header.h"
+#include "libpff_format_functions.h"
 #include "libpff_index.h"
 #include "libpff_index_node.h"
 #include "libpff_index_tree.h"
@@ -42,6 +48,8 @@
 #include "libpff_libfdata.h"
 #include "libpff_libfmapi.h"
 #include "libpff_local_descriptor_node.h"
+#include "libpff_local_descriptor_nodes_cache.h"
+#include "libpff_table_cache.h"
 #include "libpff_unused.h"
 
 #include "pff_file_header.h"
@@ -174,8 +182,9 @@ int libpff_io_handle_clear(
      libpff_io_handle_t *io_handle,
      libcerror_error_t **error )
 {
-	static char *function = "libpff_io_handle_clear";
-	int result            = 1;
+	static char *function              = "libpff_io_handle_clear";
+	uint32_t name_to_id_map_generation = 0;
+	int result                         = 1;
 
 	if( io_handle == NULL )
 	{
@@ -188,6 +197,40 @@ int libpff_io_handle_clear(
 
 		return( -1 );
 	}
+	if( io_handle->table_cache != NULL )
+	{
+		if( libpff_table_cache_free(
+		     &( io_handle->table_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free table cache.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( io_handle->local_descriptor_nodes_cache != NULL )
+	{
+		if( libpff_local_descriptor_nodes_cache_free(
+		     &( io_handle->local_descriptor_nodes_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free local descriptor nodes cache.",
+			 function );
+
+			result = -1;
+		}
+	}
+	name_to_id_map_generation = io_handle->name_to_id_map_generation;
+
 	if( memory_set(
 	     io_handle,
 	     0,
@@ -202,11 +245,338 @@ int libpff_io_handle_clear(
 
 		result = -1;
 	}
-	io_handle->ascii_codepage = LIBPFF_CODEPAGE_WINDOWS_1252;
+	io_handle->ascii_codepage            = LIBPFF_CODEPAGE_WINDOWS_1252;
+	io_handle->name_to_id_map_generation = name_to_id_map_generation;
 
 	return( result );
 }
 
+/* Sets the file type
+ * This also selects the format specific functions
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_io_handle_set_file_type(
+     libpff_io_handle_t *io_handle,
+     uint8_t file_type,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_io_handle_set_file_type";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_format_functions_get(
+	     file_type,
+	     &( io_handle->format_functions ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve format functions.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle->file_type = file_type;
+
+	return( 1 );
+}
+
+/* Retrieves the current time of a monotonic clock in milliseconds
+ * Falls back to the system time if no monotonic clock is available
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_io_handle_get_current_time(
+     int64_t *current_time,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	struct timespec time_structure;
+#elif !defined( WINAPI )
+	time_t timestamp      = 0;
+#endif
+
+	static char *function = "libpff_io_handle_get_current_time";
+
+	if( current_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid current time.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI ) && ( WINVER >= 0x0600 )
+	*current_time = (int64_t) GetTickCount64();
+
+#elif defined( WINAPI )
+	*current_time = (int64_t) GetTickCount();
+
+#elif defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_structure ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		return( -1 );
+	}
+	*current_time = ( (int64_t) time_structure.tv_sec * 1000 )
+	              + ( (int64_t) time_structure.tv_nsec / 1000000 );
+#else
+	timestamp = time(
+	             NULL );
+
+	if( timestamp == (time_t) -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		return( -1 );
+	}
+	*current_time = (int64_t) timestamp * 1000;
+#endif
+	return( 1 );
+}
+
+/* Sets the deadline
+ * The timeout is relative to the current time in milliseconds, 0 removes the deadline
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_io_handle_set_deadline(
+     libpff_io_handle_t *io_handle,
+     uint32_t timeout,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_io_handle_set_deadline";
+	int64_t current_time  = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle->read_limits_exceeded = 0;
+
+	if( timeout == 0 )
+	{
+		io_handle->deadline = 0;
+
+		return( 1 );
+	}
+	if( libpff_io_handle_get_current_time(
+	     &current_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle->deadline = current_time + (int64_t) timeout;
+
+	return( 1 );
+}
+
+/* Sets the read budget
+ * This also resets the number of bytes and blocks read, 0 removes the corresponding limit
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_io_handle_set_read_budget(
+     libpff_io_handle_t *io_handle,
+     size64_t maximum_read_size,
+     uint32_t maximum_number_of_read_blocks,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_io_handle_set_read_budget";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle->maximum_read_size             = maximum_read_size;
+	io_handle->maximum_number_of_read_blocks = maximum_number_of_read_blocks;
+	io_handle->read_size                     = 0;
+	io_handle->number_of_read_blocks         = 0;
+	io_handle->read_limits_exceeded          = 0;
+
+	return( 1 );
+}
+
+/* Checks the deadline and read budget before a block of read_size bytes is read
+ * The block is accounted for in the read budget and the read statistics
+ * If a limit is exceeded read_limits_exceeded is set, so that callers that
+ * ignore read errors, such as recovery, can stop
+ * Returns 1 if the block can be read or -1 on error
+ */
+int libpff_io_handle_check_read_limits(
+     libpff_io_handle_t *io_handle,
+     size_t read_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_io_handle_check_read_limits";
+	int64_t current_time  = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->deadline != 0 )
+	{
+		if( libpff_io_handle_get_current_time(
+		     &current_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve current time.",
+			 function );
+
+			return( -1 );
+		}
+		if( current_time >= io_handle->deadline )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_ABORT_REQUESTED,
+			 "%s: deadline exceeded.",
+			 function );
+
+			io_handle->read_limits_exceeded = 1;
+
+			return( -1 );
+		}
+	}
+	if( io_handle->maximum_number_of_read_blocks != 0 )
+	{
+		if( io_handle->number_of_read_blocks >= io_handle->maximum_number_of_read_blocks )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_ABORT_REQUESTED,
+			 "%s: maximum number of read blocks exceeded.",
+			 function );
+
+			io_handle->read_limits_exceeded = 1;
+
+			return( -1 );
+		}
+	}
+	if( io_handle->maximum_read_size != 0 )
+	{
+		if( (size64_t) read_size > ( io_handle->maximum_read_size - io_handle->read_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_ABORT_REQUESTED,
+			 "%s: maximum read size exceeded.",
+			 function );
+
+			io_handle->read_limits_exceeded = 1;
+
+			return( -1 );
+		}
+	}
+	io_handle->read_size                   += read_size;
+	io_handle->number_of_read_blocks       += 1;
+	io_handle->total_read_size             += read_size;
+	io_handle->total_number_of_read_blocks += 1;
+
+	return( 1 );
+}
+
+/* Clears the pending read of the caller driven IO handle
+ * This is done at the start of an operation, so that the pending read
+ * reflects the data needed by the last failed operation only
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_io_handle_clear_pending_read(
+     libpff_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_io_handle_clear_pending_read";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->caller_io_handle != NULL )
+	{
+		if( libpff_caller_io_handle_clear_pending_read(
+		     io_handle->caller_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to clear pending read.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
 /* Reads the unallocated data blocks
  * Returns 1 if successful or -1 on error
  */
@@ -259,9 +629,9 @@ int libpff_io_handle_read_unallocated_data_blocks(
 	{
 		if( libpff_allocation_table_read_file_io_handle(
 		     unallocated_data_block_list,
+		     io_handle,
 		     file_io_handle,
 		     allocation_table_offset,
-		     (int) io_handle->file_type,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -322,9 +692,9 @@ int libpff_io_handle_read_unallocated_page_blocks(
 	{
 		if( libpff_allocation_table_read_file_io_handle(
 		     unallocated_page_block_list,
+		     io_handle,
 		     file_io_handle,
 		     allocation_table_offset,
-		     (int) io_handle->file_type,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -353,7 +723,7 @@ int libpff_io_handle_read_index_node(
      int element_index,
      int element_data_file_index LIBPFF_ATTRIBUTE_UNUSED,
      off64_t element_data_offset,
-     size64_t element_data_size LIBPFF_ATTRIBUTE_UNUSED,
+     size64_t element_data_size,
      uint32_t element_data_flags LIBPFF_ATTRIBUTE_UNUSED,
      uint8_t read_flags LIBPFF_ATTRIBUTE_UNUSED,
      libcerror_error_t **error )
@@ -362,7 +732,6 @@ int libpff_io_handle_read_index_node(
 	static char *function           = "libpff_io_handle_read_index_node";
 
 	LIBPFF_UNREFERENCED_PARAMETER( element_data_file_index )
-	LIBPFF_UNREFERENCED_PARAMETER( element_data_size )
 	LIBPFF_UNREFERENCED_PARAMETER( element_data_flags )
 	LIBPFF_UNREFERENCED_PARAMETER( read_flags )
 
@@ -395,9 +764,9 @@ int libpff_io_handle_read_index_node(
 	}
 	if( libpff_index_node_read_file_io_handle(
 	     index_node,
+	     io_handle,
 	     file_io_handle,
 	     element_data_offset,
-	     io_handle->file_type,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
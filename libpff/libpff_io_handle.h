@@ -25,12 +25,16 @@
 #include <common.h>
 #include <types.h>
 
+#include "libpff_caller_io_handle.h"
+#include "libpff_format_functions.h"
 #include "libpff_index_value.h"
 #include "libpff_libbfio.h"
 #include "libpff_libcdata.h"
 #include "libpff_libcerror.h"
 #include "libpff_libfcache.h"
 #include "libpff_libfdata.h"
+#include "libpff_local_descriptor_nodes_cache.h"
+#include "libpff_table_cache.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -58,6 +62,10 @@ struct libpff_io_handle
 	 */
 	uint8_t file_type;
 
+	/* The format specific functions
+	 */
+	const libpff_format_functions_t *format_functions;
+
 	/* Various flags
 	 */
 	uint8_t flags;
@@ -69,6 +77,60 @@ struct libpff_io_handle
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
+
+	/* The deadline in milliseconds of the monotonic clock, 0 if not set
+	 */
+	int64_t deadline;
+
+	/* The maximum number of bytes that can be read, 0 if not set
+	 */
+	size64_t maximum_read_size;
+
+	/* The maximum number of blocks that can be read, 0 if not set
+	 */
+	uint32_t maximum_number_of_read_blocks;
+
+	/* The number of bytes read since the read budget was set
+	 */
+	size64_t read_size;
+
+	/* The number of blocks read since the read budget was set
+	 */
+	uint32_t number_of_read_blocks;
+
+	/* Value to indicate if the deadline or read budget was exceeded
+	 */
+	uint8_t read_limits_exceeded;
+
+	/* The number of bytes read since the file was opened
+	 */
+	size64_t total_read_size;
+
+	/* The number of blocks read since the file was opened
+	 */
+	uint64_t total_number_of_read_blocks;
+
+	/* The number of blocks decompressed since the file was opened
+	 */
+	uint64_t total_number_of_decompressed_blocks;
+
+	/* The item table cache
+	 */
+	libpff_table_cache_t *table_cache;
+
+	/* The local descriptor nodes cache
+	 */
+	libpff_local_descriptor_nodes_cache_t *local_descriptor_nodes_cache;
+
+	/* The caller driven IO handle, which is not owned by the IO handle
+	 */
+	libpff_caller_io_handle_t *caller_io_handle;
+
+	/* The generation of the name to ID map of the file
+	 * changes every time the name to ID map is freed or replaced
+	 * and is retained when the IO handle is cleared
+	 */
+	uint32_t name_to_id_map_generation;
 };
 
 int libpff_io_handle_initialize(
@@ -83,6 +145,35 @@ int libpff_io_handle_clear(
      libpff_io_handle_t *io_handle,
      libcerror_error_t **error );
 
+int libpff_io_handle_set_file_type(
+     libpff_io_handle_t *io_handle,
+     uint8_t file_type,
+     libcerror_error_t **error );
+
+int libpff_io_handle_get_current_time(
+     int64_t *current_time,
+     libcerror_error_t **error );
+
+int libpff_io_handle_set_deadline(
+     libpff_io_handle_t *io_handle,
+     uint32_t timeout,
+     libcerror_error_t **error );
+
+int libpff_io_handle_set_read_budget(
+     libpff_io_handle_t *io_handle,
+     size64_t maximum_read_size,
+     uint32_t maximum_number_of_read_blocks,
+     libcerror_error_t **error );
+
+int libpff_io_handle_check_read_limits(
+     libpff_io_handle_t *io_handle,
+     size_t read_size,
+     libcerror_error_t **error );
+
+int libpff_io_handle_clear_pending_read(
+     libpff_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
 int libpff_io_handle_read_unallocated_data_blocks(
      libpff_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
@@ -42,7 +42,9 @@
 #include "libpff_libfmapi.h"
 #include "libpff_mapi.h"
 #include "libpff_offsets_index.h"
+#include "libpff_property_set.h"
 #include "libpff_record_entry.h"
+#include "libpff_record_set.h"
 #include "libpff_table.h"
 #include "libpff_types.h"
 #include "libpff_value_type.h"
@@ -367,6 +369,22 @@ int libpff_item_free(
 				result = -1;
 			}
 		}
+		if( internal_item->attachment_data_stream != NULL )
+		{
+			if( libfdata_stream_free(
+			     &( internal_item->attachment_data_stream ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free attachment data stream.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 internal_item );
 	}
@@ -1034,6 +1052,111 @@ int libpff_item_get_record_set_by_index(
 	return( 1 );
 }
 
+/* Retrieves the record entries of a specific set matching the requests of a property set
+ * The property set must be prepared against the file the item belongs to
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_item_get_entries_by_property_set(
+     libpff_item_t *item,
+     int record_set_index,
+     libpff_property_set_t *property_set,
+     libpff_record_entry_t **record_entries,
+     int number_of_record_entries,
+     libcerror_error_t **error )
+{
+	libpff_internal_item_t *internal_item                 = NULL;
+	libpff_internal_property_set_t *internal_property_set = NULL;
+	libpff_record_set_t *record_set                       = NULL;
+	static char *function                                 = "libpff_item_get_entries_by_property_set";
+
+	if( item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
+
+		return( -1 );
+	}
+	internal_item = (libpff_internal_item_t *) item;
+
+	if( property_set == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid property set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_property_set = (libpff_internal_property_set_t *) property_set;
+
+	if( internal_property_set->is_prepared == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid property set - not prepared.",
+		 function );
+
+		return( -1 );
+	}
+	/* The mapped entry types of named properties differ per file
+	 * and can change when the file is closed, reopened or refreshed
+	 */
+	if( ( internal_property_set->io_handle != internal_item->io_handle )
+	 || ( internal_property_set->name_to_id_map_generation != internal_item->io_handle->name_to_id_map_generation ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid property set - prepared against a different file or name to ID map.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_item_get_record_set_by_index(
+	     item,
+	     record_set_index,
+	     &record_set,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve record set: %d.",
+		 function,
+		 record_set_index );
+
+		return( -1 );
+	}
+	if( libpff_record_set_get_entries_by_property_set(
+	     record_set,
+	     property_set,
+	     record_entries,
+	     number_of_record_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entries by property set from record set: %d.",
+		 function,
+		 record_set_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Retrieves the number of entries (of a set)
  * All sets in an item contain the same number of entries
  * Returns 1 if successful or -1 on error
@@ -1994,6 +2117,167 @@ on_error:
 	return( -1 );
 }
 
+/* Retrieves the attachment data stream
+ * The stream is created on first use and cached in the item
+ * Returns 1 if successful, 0 if the attachment data is not stored as a stream or -1 on error
+ * If 0 is returned the record entry is set to the attachment data record entry
+ */
+int libpff_internal_item_get_attachment_data_stream(
+     libpff_internal_item_t *internal_item,
+     libfdata_stream_t **data_stream,
+     libpff_record_entry_t **record_entry,
+     libcerror_error_t **error )
+{
+	libpff_record_entry_t *attachment_data_record_entry = NULL;
+	static char *function                               = "libpff_internal_item_get_attachment_data_stream";
+	uint32_t value_type                                 = 0;
+	int result                                          = 0;
+
+	if( internal_item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_item->embedded_object_data_stream != NULL )
+	{
+		*data_stream = internal_item->embedded_object_data_stream;
+
+		return( 1 );
+	}
+	if( internal_item->attachment_data_stream != NULL )
+	{
+		*data_stream = internal_item->attachment_data_stream;
+
+		return( 1 );
+	}
+	if( internal_item->item_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid item - missing item values.",
+		 function );
+
+		return( -1 );
+	}
+	result = libpff_item_values_get_record_entry_by_type(
+	          internal_item->item_values,
+	          internal_item->name_to_id_map_list,
+	          internal_item->io_handle,
+	          internal_item->file_io_handle,
+	          internal_item->offsets_index,
+	          0,
+	          LIBPFF_ENTRY_TYPE_ATTACHMENT_DATA_OBJECT,
+	          0,
+	          &attachment_data_record_entry,
+	          LIBPFF_ENTRY_VALUE_FLAG_MATCH_ANY_VALUE_TYPE,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve record entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_record_entry_get_value_type(
+	     attachment_data_record_entry,
+	     &value_type,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value type.",
+		 function );
+
+		return( -1 );
+	}
+	/* The OLE attachment method could refer to an OLE embedded object
+	 */
+	if( value_type == LIBPFF_VALUE_TYPE_OBJECT )
+	{
+		if( libpff_internal_item_get_embedded_object_data(
+		     internal_item,
+		     attachment_data_record_entry,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve embedded object data.",
+			 function );
+
+			return( -1 );
+		}
+		*data_stream = internal_item->embedded_object_data_stream;
+
+		return( 1 );
+	}
+	/* Binary attachment data that was not read into memory is read from a stream
+	 */
+	result = libpff_record_entry_get_value_data_stream(
+	          attachment_data_record_entry,
+	          &( internal_item->attachment_data_stream ),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve attachment data stream.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		*record_entry = attachment_data_record_entry;
+
+		return( 0 );
+	}
+	*data_stream = internal_item->attachment_data_stream;
+
+	return( 1 );
+}
+
 /* Retrieves the type
  * Determines the item type if neccessary
  * Returns 1 if successful or -1 on error
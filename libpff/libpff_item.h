@@ -117,6 +117,10 @@ struct libpff_internal_item
 	/* Embedded object data stream
 	 */
 	libfdata_stream_t *embedded_object_data_stream;
+
+	/* Attachment data stream
+	 */
+	libfdata_stream_t *attachment_data_stream;
 };
 
 int libpff_item_initialize(
@@ -159,6 +163,15 @@ int libpff_item_get_record_set_by_index(
      libpff_record_set_t **record_set,
      libcerror_error_t **error );
 
+LIBPFF_EXTERN \
+int libpff_item_get_entries_by_property_set(
+     libpff_item_t *item,
+     int record_set_index,
+     libpff_property_set_t *property_set,
+     libpff_record_entry_t **record_entries,
+     int number_of_record_entries,
+     libcerror_error_t **error );
+
 LIBPFF_EXTERN \
 int libpff_item_get_number_of_entries(
      libpff_item_t *item,
@@ -212,6 +225,12 @@ int libpff_internal_item_get_embedded_object_data(
      libpff_record_entry_t *record_entry,
      libcerror_error_t **error );
 
+int libpff_internal_item_get_attachment_data_stream(
+     libpff_internal_item_t *internal_item,
+     libfdata_stream_t **data_stream,
+     libpff_record_entry_t **record_entry,
+     libcerror_error_t **error );
+
 LIBPFF_EXTERN \
 int libpff_item_get_type(
      libpff_item_t *item,
@@ -58,6 +58,10 @@ struct libpff_item_descriptor
 	/* The value index of the recovered local descriptors identifier
 	 */
 	int recovered_local_descriptors_identifier_value_index;
+
+	/* The validation status of the recovered item
+	 */
+	uint8_t validation_status;
 };
 
 int libpff_item_descriptor_initialize(
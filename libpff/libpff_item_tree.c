@@ -623,20 +623,15 @@ on_error:
 	return( -1 );
 }
 
-/* Creates an item tree from the descriptors index
+/* Creates the root node of an item tree
  * Returns 1 if successful or -1 on error
  */
-int libpff_item_tree_create(
+int libpff_item_tree_create_root_node(
      libpff_item_tree_t *item_tree,
-     libbfio_handle_t *file_io_handle,
-     libpff_descriptors_index_t *descriptors_index,
-     libcdata_list_t *orphan_node_list,
-     libcdata_tree_node_t **root_folder_item_tree_node,
      libcerror_error_t **error )
 {
-	libfdata_tree_node_t *descriptor_index_tree_root_node = NULL;
-	libpff_item_descriptor_t *item_descriptor             = NULL;
-	static char *function                                 = "libpff_item_tree_create";
+	libpff_item_descriptor_t *item_descriptor = NULL;
+	static char *function                     = "libpff_item_tree_create_root_node";
 
 	if( item_tree == NULL )
 	{
@@ -660,20 +655,6 @@ int libpff_item_tree_create(
 
 		return( -1 );
 	}
-	if( libpff_index_tree_get_root_node(
-	     descriptors_index->index_tree,
-	     &descriptor_index_tree_root_node,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to retrieve descriptor index tree root node.",
-		 function );
-
-		goto on_error;
-	}
 	if( libpff_item_descriptor_initialize(
 	     &item_descriptor,
 	     0,
@@ -718,17 +699,95 @@ int libpff_item_tree_create(
 
 		goto on_error;
 	}
-	/* The item descriptor is now managed by the item tree root node
-	 */
-	item_descriptor = NULL;
+	return( 1 );
+
+on_error:
+	if( item_tree->root_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 &( item_tree->root_node ),
+		 NULL,
+		 NULL );
+	}
+	if( item_descriptor != NULL )
+	{
+		libpff_item_descriptor_free(
+		 &item_descriptor,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Creates an item tree from the descriptors index
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_item_tree_create(
+     libpff_item_tree_t *item_tree,
+     libbfio_handle_t *file_io_handle,
+     libpff_descriptors_index_t *descriptors_index,
+     libcdata_array_t *orphan_node_array,
+     libcdata_tree_node_t **root_folder_item_tree_node,
+     libcerror_error_t **error )
+{
+	libfdata_tree_node_t *descriptor_index_tree_root_node = NULL;
+	static char *function                                 = "libpff_item_tree_create";
+
+	if( item_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( item_tree->root_node != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid item tree - root node already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_index_tree_get_root_node(
+	     descriptors_index->index_tree,
+	     &descriptor_index_tree_root_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to retrieve descriptor index tree root node.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_item_tree_create_root_node(
+	     item_tree,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create item tree root node.",
+		 function );
 
+		goto on_error;
+	}
 	if( libpff_item_tree_create_node(
 	     item_tree,
 	     file_io_handle,
 	     descriptors_index->index_tree,
 	     descriptor_index_tree_root_node,
 	     descriptors_index->index_cache,
-	     orphan_node_list,
+	     orphan_node_array,
 	     root_folder_item_tree_node,
 	     0,
 	     error ) != 1 )
@@ -752,18 +811,12 @@ on_error:
 		 (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_descriptor_free,
 		 NULL );
 	}
-	if( item_descriptor != NULL )
-	{
-		libpff_item_descriptor_free(
-		 &item_descriptor,
-		 NULL );
-	}
 	return( -1 );
 }
 
 /* Creates an item tree node from the descriptor index
  *
- * If a descriptor index value has no existing parent it is added to the orphan node list
+ * If a descriptor index value has no existing parent it is added to the orphan node array
  *
  * Returns 1 if successful or -1 on error
  */
@@ -773,7 +826,7 @@ int libpff_item_tree_create_node(
      libpff_index_tree_t *descriptor_index_tree,
      libfdata_tree_node_t *descriptor_index_tree_node,
      libfcache_cache_t *index_tree_cache,
-     libcdata_list_t *orphan_node_list,
+     libcdata_array_t *orphan_node_array,
      libcdata_tree_node_t **root_folder_item_tree_node,
      int recursion_depth,
      libcerror_error_t **error )
@@ -896,7 +949,7 @@ int libpff_item_tree_create_node(
 		     descriptor_index_tree,
 		     descriptor_index_tree_node,
 		     index_tree_cache,
-		     orphan_node_list,
+		     orphan_node_array,
 		     root_folder_item_tree_node,
 		     recursion_depth,
 		     error ) != 1 )
@@ -942,7 +995,7 @@ int libpff_item_tree_create_node(
 			     descriptor_index_tree,
 			     descriptor_index_tree_sub_node,
 			     index_tree_cache,
-			     orphan_node_list,
+			     orphan_node_array,
 			     root_folder_item_tree_node,
 			     recursion_depth + 1,
 			     error ) != 1 )
@@ -974,7 +1027,7 @@ on_error:
 
 /* Creates an item tree leaf node from the descriptor index
  *
- * If a descriptor index value has no existing parent it is added to the orphan node list
+ * If a descriptor index value has no existing parent it is added to the orphan node array
  *
  * Returns 1 if successful or -1 on error
  */
@@ -984,7 +1037,7 @@ int libpff_item_tree_create_leaf_node(
      libpff_index_tree_t *descriptor_index_tree,
      libfdata_tree_node_t *descriptor_index_tree_node,
      libfcache_cache_t *index_tree_cache,
-     libcdata_list_t *orphan_node_list,
+     libcdata_array_t *orphan_node_array,
      libcdata_tree_node_t **root_folder_item_tree_node,
      int recursion_depth,
      libcerror_error_t **error )
@@ -997,6 +1050,7 @@ int libpff_item_tree_create_leaf_node(
 	static char *function                                   = "libpff_item_tree_create_leaf_node";
 	uint32_t identifier                                     = 0;
 	uint32_t parent_identifier                              = 0;
+	int entry_index                                         = 0;
 	int leaf_node_index                                     = 0;
 	int result                                              = 0;
 
@@ -1219,7 +1273,7 @@ int libpff_item_tree_create_leaf_node(
 				     descriptor_index_tree,
 				     descriptor_index_tree_parent_node,
 				     index_tree_cache,
-				     orphan_node_list,
+				     orphan_node_array,
 				     root_folder_item_tree_node,
 				     recursion_depth + 1,
 				     error ) != 1 )
@@ -1297,8 +1351,9 @@ int libpff_item_tree_create_leaf_node(
 			}
 			item_descriptor = NULL;
 
-			if( libcdata_list_append_value(
-			     orphan_node_list,
+			if( libcdata_array_append_entry(
+			     orphan_node_array,
+			     &entry_index,
 			     (intptr_t *) item_tree_node,
 			     error ) != 1 )
 			{
@@ -1306,7 +1361,7 @@ int libpff_item_tree_create_leaf_node(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to append orphan node in orphan node list.",
+				 "%s: unable to append orphan node in orphan node array.",
 				 function );
 
 				goto on_error;
@@ -1379,34 +1434,85 @@ on_error:
 	return( -1 );
 }
 
-/* Retrieves the tree node of an item node
- * Returns 1 if successful, 0 if the item node was not found or -1 on error
+/* Reads the descriptor index values of a descriptor index tree node and its sub nodes
+ * The values are appended to the array in the order of the descriptor index.
+ * Descriptor index tree nodes that cannot be read are skipped, as when the item
+ * tree is created from the descriptors index
+ * Returns 1 if successful or -1 on error
  */
-int libpff_item_tree_get_node_by_identifier(
-     libpff_item_tree_t *item_tree,
-     uint32_t item_identifier,
-     libcdata_tree_node_t **item_tree_node,
+int libpff_item_tree_read_index_values(
+     libbfio_handle_t *file_io_handle,
+     libfdata_tree_node_t *descriptor_index_tree_node,
+     libfcache_cache_t *index_tree_cache,
+     libcdata_array_t *index_values_array,
+     int recursion_depth,
      libcerror_error_t **error )
 {
-	static char *function = "libpff_item_tree_get_node_by_identifier";
-	int result            = 0;
+	libfdata_tree_node_t *descriptor_index_tree_sub_node = NULL;
+	libpff_index_value_t *descriptor_index_value         = NULL;
+	libpff_index_value_t *index_value                    = NULL;
+	static char *function                                = "libpff_item_tree_read_index_values";
+	int entry_index                                      = 0;
+	int number_of_sub_nodes                              = 0;
+	int result                                           = 0;
+	int sub_node_index                                   = 0;
 
-	if( item_tree == NULL )
+	if( index_values_array == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid item tree.",
+		 "%s: invalid index values array.",
 		 function );
 
 		return( -1 );
 	}
-	result = libpff_item_tree_get_tree_node_by_identifier(
-	          item_tree->root_node,
-	          item_identifier,
-                  item_tree_node,
-                  0,
+	if( ( recursion_depth < 0 )
+	 || ( recursion_depth > LIBPFF_MAXIMUM_ITEM_TREE_RECURSION_DEPTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid recursion depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Check if the index node can be read
+	 */
+	if( libfdata_tree_node_get_number_of_sub_nodes(
+	     descriptor_index_tree_node,
+	     (intptr_t *) file_io_handle,
+	     (libfdata_cache_t *) index_tree_cache,
+	     &number_of_sub_nodes,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub nodes from descriptor index tree node.",
+		 function );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( ( libcnotify_verbose != 0 )
+		 && ( error != NULL )
+		 && ( *error != NULL ) )
+		{
+			libcnotify_print_error_backtrace(
+			 *error );
+		}
+#endif
+		libcerror_error_free(
+		 error );
+
+		return( 1 );
+	}
+	result = libfdata_tree_node_is_deleted(
+	          descriptor_index_tree_node,
 	          error );
 
 	if( result == -1 )
@@ -1415,12 +1521,1300 @@ int libpff_item_tree_get_node_by_identifier(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve item tree node: %" PRIu32 ".",
-		 function,
-		 item_identifier );
+		 "%s: unable to determine if descriptor index tree node is deleted.",
+		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	return( result );
+	else if( result != 0 )
+	{
+		return( 1 );
+	}
+	result = libfdata_tree_node_is_leaf(
+	          descriptor_index_tree_node,
+	          (intptr_t *) file_io_handle,
+	          (libfdata_cache_t *) index_tree_cache,
+	          0,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if descriptor index tree node is a leaf node.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( libfdata_tree_node_get_node_value(
+		     descriptor_index_tree_node,
+		     (intptr_t *) file_io_handle,
+		     (libfdata_cache_t *) index_tree_cache,
+		     (intptr_t **) &descriptor_index_value,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve descriptor index tree node value.",
+			 function );
+
+			goto on_error;
+		}
+		if( descriptor_index_value == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing descriptor index tree node value.",
+			 function );
+
+			goto on_error;
+		}
+		if( libpff_index_value_initialize(
+		     &index_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create index value.",
+			 function );
+
+			goto on_error;
+		}
+		/* The descriptor index value is owned by the index tree cache
+		 * and can be cached out by a next read hence a copy is stored
+		 */
+		if( memory_copy(
+		     index_value,
+		     descriptor_index_value,
+		     sizeof( libpff_index_value_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy index value.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcdata_array_append_entry(
+		     index_values_array,
+		     &entry_index,
+		     (intptr_t *) index_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append index value to array.",
+			 function );
+
+			goto on_error;
+		}
+		index_value = NULL;
+	}
+	else
+	{
+		for( sub_node_index = 0;
+		     sub_node_index < number_of_sub_nodes;
+		     sub_node_index++ )
+		{
+			if( libfdata_tree_node_get_sub_node_by_index(
+			     descriptor_index_tree_node,
+			     (intptr_t *) file_io_handle,
+			     (libfdata_cache_t *) index_tree_cache,
+			     sub_node_index,
+			     &descriptor_index_tree_sub_node,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve sub node: %d from descriptor index tree node.",
+				 function,
+				 sub_node_index );
+
+				goto on_error;
+			}
+			if( libpff_item_tree_read_index_values(
+			     file_io_handle,
+			     descriptor_index_tree_sub_node,
+			     index_tree_cache,
+			     index_values_array,
+			     recursion_depth + 1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to read index values of descriptor index tree sub node: %d.",
+				 function,
+				 sub_node_index );
+
+				goto on_error;
+			}
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( index_value != NULL )
+	{
+		libpff_index_value_free(
+		 &index_value,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Creates an item tree from descriptor index values
+ * The item tree nodes are created first and then linked to the item tree node
+ * of their parent by identifier, so that the descriptor index values can be read
+ * in shards. Item tree nodes that cannot be linked to the root folder, because
+ * their parent is missing or they are part of a parent loop, are added to
+ * the orphan node array
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_item_tree_create_from_index_values(
+     libpff_item_tree_t *item_tree,
+     libcdata_array_t *index_values_array,
+     libcdata_array_t *orphan_node_array,
+     libcdata_tree_node_t **root_folder_item_tree_node,
+     libcerror_error_t **error )
+{
+	libcdata_array_t *sorted_node_array       = NULL;
+	libcdata_tree_node_t **item_tree_nodes    = NULL;
+	libcdata_tree_node_t *ancestor_node       = NULL;
+	libcdata_tree_node_t *item_tree_node      = NULL;
+	libcdata_tree_node_t *parent_node         = NULL;
+	libpff_index_value_t *index_value         = NULL;
+	libpff_item_descriptor_t *item_descriptor = NULL;
+	uint32_t *parent_identifiers              = NULL;
+	uint8_t *orphan_flags                     = NULL;
+	static char *function                     = "libpff_item_tree_create_from_index_values";
+	uint32_t identifier                       = 0;
+	int depth                                 = 0;
+	int entry_index                           = 0;
+	int node_index                            = 0;
+	int number_of_index_values                = 0;
+	int result                                = 0;
+	int value_index                           = 0;
+
+	if( item_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( item_tree->root_node != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid item tree - root node already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( root_folder_item_tree_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid root folder item tree node.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     index_values_array,
+	     &number_of_index_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of index values.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size_t) number_of_index_values > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libcdata_tree_node_t * ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of index values value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_item_tree_create_root_node(
+	     item_tree,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create item tree root node.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_index_values == 0 )
+	{
+		return( 1 );
+	}
+	if( libcdata_array_initialize(
+	     &sorted_node_array,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sorted item tree node array.",
+		 function );
+
+		goto on_error;
+	}
+	item_tree_nodes = (libcdata_tree_node_t **) memory_allocate(
+	                                             sizeof( libcdata_tree_node_t * ) * number_of_index_values );
+
+	if( item_tree_nodes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create item tree nodes.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     item_tree_nodes,
+	     0,
+	     sizeof( libcdata_tree_node_t * ) * number_of_index_values ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear item tree nodes.",
+		 function );
+
+		memory_free(
+		 item_tree_nodes );
+
+		item_tree_nodes = NULL;
+
+		goto on_error;
+	}
+	parent_identifiers = (uint32_t *) memory_allocate(
+	                                   sizeof( uint32_t ) * number_of_index_values );
+
+	if( parent_identifiers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create parent identifiers.",
+		 function );
+
+		goto on_error;
+	}
+	orphan_flags = (uint8_t *) memory_allocate(
+	                            sizeof( uint8_t ) * number_of_index_values );
+
+	if( orphan_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create orphan flags.",
+		 function );
+
+		goto on_error;
+	}
+	/* Create the item tree nodes in the order of the descriptor index
+	 */
+	for( value_index = 0;
+	     value_index < number_of_index_values;
+	     value_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     index_values_array,
+		     value_index,
+		     (intptr_t **) &index_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve index value: %d.",
+			 function,
+			 value_index );
+
+			goto on_error;
+		}
+		if( index_value == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing index value: %d.",
+			 function,
+			 value_index );
+
+			goto on_error;
+		}
+		if( index_value->identifier > (uint64_t) UINT32_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: descriptor index identifier value exceeds maximum.",
+			 function );
+
+			goto on_error;
+		}
+		if( libpff_item_descriptor_initialize(
+		     &item_descriptor,
+		     (uint32_t) index_value->identifier,
+		     index_value->data_identifier,
+		     index_value->local_descriptors_identifier,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create item descriptor.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcdata_tree_node_initialize(
+		     &( item_tree_nodes[ value_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create item tree node: %d.",
+			 function,
+			 value_index );
+
+			goto on_error;
+		}
+		if( libcdata_tree_node_set_value(
+		     item_tree_nodes[ value_index ],
+		     (intptr_t *) item_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set item descriptor in item tree node: %d.",
+			 function,
+			 value_index );
+
+			goto on_error;
+		}
+		item_descriptor = NULL;
+
+		parent_identifiers[ value_index ] = index_value->parent_identifier;
+
+		if( libcdata_array_append_entry(
+		     sorted_node_array,
+		     &entry_index,
+		     (intptr_t *) item_tree_nodes[ value_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append item tree node: %d to sorted array.",
+			 function,
+			 value_index );
+
+			goto on_error;
+		}
+	}
+	/* The sort is stable, hence the parent look up returns the first item tree node
+	 * in the order of the descriptor index, as when the item tree is created from
+	 * the descriptors index
+	 */
+	if( libpff_item_tree_sort_nodes_by_identifier(
+	     sorted_node_array,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to sort item tree nodes.",
+		 function );
+
+		goto on_error;
+	}
+	/* Link the item tree nodes to the item tree node of their parent
+	 */
+	for( value_index = 0;
+	     value_index < number_of_index_values;
+	     value_index++ )
+	{
+		item_tree_node = item_tree_nodes[ value_index ];
+
+		if( libcdata_tree_node_get_value(
+		     item_tree_node,
+		     (intptr_t **) &item_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve item descriptor: %d.",
+			 function,
+			 value_index );
+
+			goto on_error;
+		}
+		if( item_descriptor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing item descriptor: %d.",
+			 function,
+			 value_index );
+
+			goto on_error;
+		}
+		identifier = item_descriptor->descriptor_identifier;
+
+		/* The item descriptor is managed by the item tree node
+		 */
+		item_descriptor = NULL;
+
+		/* The root folder index descriptor points to itself as its parent
+		 */
+		if( identifier == parent_identifiers[ value_index ] )
+		{
+			if( *root_folder_item_tree_node != NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+				 "%s: root folder item tree node already set.",
+				 function );
+
+				goto on_error;
+			}
+			parent_node = item_tree->root_node;
+		}
+		else
+		{
+			result = libpff_item_tree_get_node_index_by_identifier(
+			          sorted_node_array,
+			          parent_identifiers[ value_index ],
+			          &node_index,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to find parent node: %" PRIu32 ".",
+				 function,
+				 parent_identifiers[ value_index ] );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				continue;
+			}
+			if( libcdata_array_get_entry_by_index(
+			     sorted_node_array,
+			     node_index,
+			     (intptr_t **) &parent_node,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve parent node: %" PRIu32 ".",
+				 function,
+				 parent_identifiers[ value_index ] );
+
+				goto on_error;
+			}
+			/* Do not link the item tree node if its parent is one of its sub nodes
+			 * or if the parent is nested too deeply
+			 */
+			ancestor_node = parent_node;
+			depth         = 0;
+
+			while( ( ancestor_node != NULL )
+			    && ( ancestor_node != item_tree_node )
+			    && ( depth <= LIBPFF_MAXIMUM_ITEM_TREE_RECURSION_DEPTH ) )
+			{
+				if( libcdata_tree_node_get_parent_node(
+				     ancestor_node,
+				     &ancestor_node,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve parent node.",
+					 function );
+
+					goto on_error;
+				}
+				depth++;
+			}
+			if( ancestor_node != NULL )
+			{
+				continue;
+			}
+		}
+		result = libcdata_tree_node_insert_node(
+		          parent_node,
+		          item_tree_node,
+		          (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libpff_item_descriptor_compare,
+		          LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert item tree node: %d.",
+			 function,
+			 value_index );
+
+			goto on_error;
+		}
+		else if( ( result == 1 )
+		      && ( parent_node == item_tree->root_node ) )
+		{
+			*root_folder_item_tree_node = item_tree_node;
+		}
+	}
+	/* Determine the item tree nodes that are not linked to the root of the item tree
+	 * before any of them are removed from their parent
+	 */
+	for( value_index = 0;
+	     value_index < number_of_index_values;
+	     value_index++ )
+	{
+		ancestor_node = item_tree_nodes[ value_index ];
+		depth         = 0;
+
+		while( depth <= LIBPFF_MAXIMUM_ITEM_TREE_RECURSION_DEPTH )
+		{
+			if( libcdata_tree_node_get_parent_node(
+			     ancestor_node,
+			     &parent_node,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve parent node.",
+				 function );
+
+				goto on_error;
+			}
+			if( parent_node == NULL )
+			{
+				break;
+			}
+			ancestor_node = parent_node;
+
+			depth++;
+		}
+		if( ( ancestor_node != item_tree->root_node )
+		 || ( depth > LIBPFF_MAXIMUM_ITEM_TREE_RECURSION_DEPTH ) )
+		{
+			orphan_flags[ value_index ] = 1;
+		}
+		else
+		{
+			orphan_flags[ value_index ] = 0;
+		}
+	}
+	/* Orphan item tree nodes are added without their sub nodes, as when the item
+	 * tree is created from the descriptors index
+	 */
+	for( value_index = 0;
+	     value_index < number_of_index_values;
+	     value_index++ )
+	{
+		if( orphan_flags[ value_index ] == 0 )
+		{
+			continue;
+		}
+		item_tree_node = item_tree_nodes[ value_index ];
+
+		if( libcdata_tree_node_get_parent_node(
+		     item_tree_node,
+		     &parent_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve parent node.",
+			 function );
+
+			goto on_error;
+		}
+		if( parent_node != NULL )
+		{
+			if( libcdata_tree_node_remove_node(
+			     parent_node,
+			     item_tree_node,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+				 "%s: unable to remove item tree node: %d from parent.",
+				 function,
+				 value_index );
+
+				goto on_error;
+			}
+		}
+		if( item_tree_node == *root_folder_item_tree_node )
+		{
+			*root_folder_item_tree_node = NULL;
+		}
+		if( libcdata_array_append_entry(
+		     orphan_node_array,
+		     &entry_index,
+		     (intptr_t *) item_tree_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append orphan node in orphan node array.",
+			 function );
+
+			goto on_error;
+		}
+		/* The item tree node is now managed by the orphan node array
+		 */
+		item_tree_nodes[ value_index ] = NULL;
+	}
+	memory_free(
+	 orphan_flags );
+
+	memory_free(
+	 parent_identifiers );
+
+	memory_free(
+	 item_tree_nodes );
+
+	if( libcdata_array_free(
+	     &sorted_node_array,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free sorted item tree node array.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	/* Detach the item tree nodes so that each of them can be freed separately
+	 */
+	if( item_tree_nodes != NULL )
+	{
+		for( value_index = 0;
+		     value_index < number_of_index_values;
+		     value_index++ )
+		{
+			if( item_tree_nodes[ value_index ] == NULL )
+			{
+				continue;
+			}
+			parent_node = NULL;
+
+			if( libcdata_tree_node_get_parent_node(
+			     item_tree_nodes[ value_index ],
+			     &parent_node,
+			     NULL ) == 1 )
+			{
+				if( parent_node != NULL )
+				{
+					libcdata_tree_node_remove_node(
+					 parent_node,
+					 item_tree_nodes[ value_index ],
+					 NULL );
+				}
+			}
+		}
+		for( value_index = 0;
+		     value_index < number_of_index_values;
+		     value_index++ )
+		{
+			if( item_tree_nodes[ value_index ] != NULL )
+			{
+				libcdata_tree_node_free(
+				 &( item_tree_nodes[ value_index ] ),
+				 (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_descriptor_free,
+				 NULL );
+			}
+		}
+		memory_free(
+		 item_tree_nodes );
+	}
+	*root_folder_item_tree_node = NULL;
+
+	if( orphan_flags != NULL )
+	{
+		memory_free(
+		 orphan_flags );
+	}
+	if( parent_identifiers != NULL )
+	{
+		memory_free(
+		 parent_identifiers );
+	}
+	if( sorted_node_array != NULL )
+	{
+		libcdata_array_free(
+		 &sorted_node_array,
+		 NULL,
+		 NULL );
+	}
+	if( item_tree->root_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 &( item_tree->root_node ),
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_descriptor_free,
+		 NULL );
+	}
+	if( item_descriptor != NULL )
+	{
+		libpff_item_descriptor_free(
+		 &item_descriptor,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the tree node of an item node
+ * Returns 1 if successful, 0 if the item node was not found or -1 on error
+ */
+int libpff_item_tree_get_node_by_identifier(
+     libpff_item_tree_t *item_tree,
+     uint32_t item_identifier,
+     libcdata_tree_node_t **item_tree_node,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_item_tree_get_node_by_identifier";
+	int result            = 0;
+
+	if( item_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item tree.",
+		 function );
+
+		return( -1 );
+	}
+	result = libpff_item_tree_get_tree_node_by_identifier(
+	          item_tree->root_node,
+	          item_identifier,
+                  item_tree_node,
+                  0,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve item tree node: %" PRIu32 ".",
+		 function,
+		 item_identifier );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Sorts an array of item tree nodes by descriptor identifier
+ * The sort is stable, hence item tree nodes with the same identifier, such as
+ * multiple recovered versions of an item, keep their original order
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_item_tree_sort_nodes_by_identifier(
+     libcdata_array_t *item_tree_node_array,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *item_tree_node          = NULL;
+	libpff_item_descriptor_t *item_descriptor     = NULL;
+	libpff_item_tree_sort_value_t *scratch_values = NULL;
+	libpff_item_tree_sort_value_t *sort_values    = NULL;
+	libpff_item_tree_sort_value_t *swap_values    = NULL;
+	static char *function                         = "libpff_item_tree_sort_nodes_by_identifier";
+	int destination_index                         = 0;
+	int end_index                                 = 0;
+	int entry_index                               = 0;
+	int is_sorted                                 = 1;
+	int left_index                                = 0;
+	int merge_size                                = 0;
+	int middle_index                              = 0;
+	int number_of_entries                         = 0;
+	int right_index                               = 0;
+
+	if( libcdata_array_get_number_of_entries(
+	     item_tree_node_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of item tree nodes.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_entries <= 1 )
+	{
+		return( 1 );
+	}
+	if( (size_t) number_of_entries > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libpff_item_tree_sort_value_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of item tree nodes value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	sort_values = (libpff_item_tree_sort_value_t *) memory_allocate(
+	                                                 sizeof( libpff_item_tree_sort_value_t ) * number_of_entries );
+
+	if( sort_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sort values.",
+		 function );
+
+		goto on_error;
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     item_tree_node_array,
+		     entry_index,
+		     (intptr_t **) &item_tree_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve item tree node: %d.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+		if( libcdata_tree_node_get_value(
+		     item_tree_node,
+		     (intptr_t **) &item_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve item descriptor: %d.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+		if( item_descriptor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing item descriptor: %d.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+		sort_values[ entry_index ].identifier     = item_descriptor->descriptor_identifier;
+		sort_values[ entry_index ].item_tree_node = item_tree_node;
+
+		if( ( entry_index > 0 )
+		 && ( sort_values[ entry_index ].identifier < sort_values[ entry_index - 1 ].identifier ) )
+		{
+			is_sorted = 0;
+		}
+	}
+	if( is_sorted != 0 )
+	{
+		memory_free(
+		 sort_values );
+
+		return( 1 );
+	}
+	scratch_values = (libpff_item_tree_sort_value_t *) memory_allocate(
+	                                                    sizeof( libpff_item_tree_sort_value_t ) * number_of_entries );
+
+	if( scratch_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create scratch sort values.",
+		 function );
+
+		goto on_error;
+	}
+	/* Bottom-up merge sort, which unlike qsort is stable
+	 */
+	merge_size = 1;
+
+	while( merge_size < number_of_entries )
+	{
+		left_index = 0;
+
+		while( left_index < number_of_entries )
+		{
+			middle_index = left_index;
+
+			if( merge_size < ( number_of_entries - left_index ) )
+			{
+				middle_index += merge_size;
+			}
+			else
+			{
+				middle_index = number_of_entries;
+			}
+			end_index = middle_index;
+
+			if( merge_size < ( number_of_entries - middle_index ) )
+			{
+				end_index += merge_size;
+			}
+			else
+			{
+				end_index = number_of_entries;
+			}
+			destination_index = left_index;
+			right_index       = middle_index;
+
+			while( destination_index < end_index )
+			{
+				if( ( left_index < middle_index )
+				 && ( ( right_index >= end_index )
+				  ||  ( sort_values[ left_index ].identifier <= sort_values[ right_index ].identifier ) ) )
+				{
+					scratch_values[ destination_index++ ] = sort_values[ left_index++ ];
+				}
+				else
+				{
+					scratch_values[ destination_index++ ] = sort_values[ right_index++ ];
+				}
+			}
+			left_index = end_index;
+		}
+		swap_values    = sort_values;
+		sort_values    = scratch_values;
+		scratch_values = swap_values;
+
+		if( merge_size > ( number_of_entries / 2 ) )
+		{
+			break;
+		}
+		merge_size *= 2;
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_set_entry_by_index(
+		     item_tree_node_array,
+		     entry_index,
+		     (intptr_t *) sort_values[ entry_index ].item_tree_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set item tree node: %d.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 scratch_values );
+
+	memory_free(
+	 sort_values );
+
+	return( 1 );
+
+on_error:
+	if( scratch_values != NULL )
+	{
+		memory_free(
+		 scratch_values );
+	}
+	if( sort_values != NULL )
+	{
+		memory_free(
+		 sort_values );
+	}
+	return( -1 );
+}
+
+/* Retrieves the index of the first item tree node with a specific descriptor identifier
+ * The item tree nodes in the array must be sorted by descriptor identifier
+ * Returns 1 if successful, 0 if no such item tree node or -1 on error
+ */
+int libpff_item_tree_get_node_index_by_identifier(
+     libcdata_array_t *item_tree_node_array,
+     uint32_t item_identifier,
+     int *item_tree_node_index,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *item_tree_node      = NULL;
+	libpff_item_descriptor_t *item_descriptor = NULL;
+	static char *function                     = "libpff_item_tree_get_node_index_by_identifier";
+	int lower_index                           = 0;
+	int middle_index                          = 0;
+	int number_of_entries                     = 0;
+	int upper_index                           = 0;
+
+	if( item_tree_node_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item tree node index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     item_tree_node_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of item tree nodes.",
+		 function );
+
+		return( -1 );
+	}
+	upper_index = number_of_entries;
+
+	/* Determine the lower bound so the first of multiple item tree nodes
+	 * with the same identifier is returned
+	 */
+	while( lower_index < upper_index )
+	{
+		middle_index = lower_index + ( ( upper_index - lower_index ) / 2 );
+
+		if( libcdata_array_get_entry_by_index(
+		     item_tree_node_array,
+		     middle_index,
+		     (intptr_t **) &item_tree_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve item tree node: %d.",
+			 function,
+			 middle_index );
+
+			return( -1 );
+		}
+		if( libcdata_tree_node_get_value(
+		     item_tree_node,
+		     (intptr_t **) &item_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve item descriptor: %d.",
+			 function,
+			 middle_index );
+
+			return( -1 );
+		}
+		if( item_descriptor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing item descriptor: %d.",
+			 function,
+			 middle_index );
+
+			return( -1 );
+		}
+		if( item_descriptor->descriptor_identifier < item_identifier )
+		{
+			lower_index = middle_index + 1;
+		}
+		else
+		{
+			upper_index = middle_index;
+		}
+	}
+	if( lower_index >= number_of_entries )
+	{
+		return( 0 );
+	}
+	if( lower_index != middle_index )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     item_tree_node_array,
+		     lower_index,
+		     (intptr_t **) &item_tree_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve item tree node: %d.",
+			 function,
+			 lower_index );
+
+			return( -1 );
+		}
+		if( libcdata_tree_node_get_value(
+		     item_tree_node,
+		     (intptr_t **) &item_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve item descriptor: %d.",
+			 function,
+			 lower_index );
+
+			return( -1 );
+		}
+		if( item_descriptor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing item descriptor: %d.",
+			 function,
+			 lower_index );
+
+			return( -1 );
+		}
+	}
+	if( item_descriptor->descriptor_identifier != item_identifier )
+	{
+		return( 0 );
+	}
+	*item_tree_node_index = lower_index;
+
+	return( 1 );
 }
 
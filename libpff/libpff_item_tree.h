@@ -37,6 +37,19 @@
 extern "C" {
 #endif
 
+typedef struct libpff_item_tree_sort_value libpff_item_tree_sort_value_t;
+
+struct libpff_item_tree_sort_value
+{
+	/* The descriptor identifier
+	 */
+	uint32_t identifier;
+
+	/* The item tree node
+	 */
+	libcdata_tree_node_t *item_tree_node;
+};
+
 typedef struct libpff_item_tree libpff_item_tree_t;
 
 struct libpff_item_tree
@@ -79,11 +92,15 @@ int libpff_item_tree_append_identifier(
      uint8_t recovered,
      libcerror_error_t **error );
 
+int libpff_item_tree_create_root_node(
+     libpff_item_tree_t *item_tree,
+     libcerror_error_t **error );
+
 int libpff_item_tree_create(
      libpff_item_tree_t *item_tree,
      libbfio_handle_t *file_io_handle,
      libpff_descriptors_index_t *descriptors_index,
-     libcdata_list_t *orphan_node_list,
+     libcdata_array_t *orphan_node_array,
      libcdata_tree_node_t **root_folder_item_tree_node,
      libcerror_error_t **error );
 
@@ -93,7 +110,7 @@ int libpff_item_tree_create_node(
      libpff_index_tree_t *descriptor_index_tree,
      libfdata_tree_node_t *descriptor_index_tree_node,
      libfcache_cache_t *index_tree_cache,
-     libcdata_list_t *orphan_node_list,
+     libcdata_array_t *orphan_node_array,
      libcdata_tree_node_t **root_folder_item_tree_node,
      int recursion_depth,
      libcerror_error_t **error );
@@ -104,17 +121,42 @@ int libpff_item_tree_create_leaf_node(
      libpff_index_tree_t *descriptor_index_tree,
      libfdata_tree_node_t *descriptor_index_tree_node,
      libfcache_cache_t *index_tree_cache,
-     libcdata_list_t *orphan_node_list,
+     libcdata_array_t *orphan_node_array,
      libcdata_tree_node_t **root_folder_item_tree_node,
      int recursion_depth,
      libcerror_error_t **error );
 
+int libpff_item_tree_read_index_values(
+     libbfio_handle_t *file_io_handle,
+     libfdata_tree_node_t *descriptor_index_tree_node,
+     libfcache_cache_t *index_tree_cache,
+     libcdata_array_t *index_values_array,
+     int recursion_depth,
+     libcerror_error_t **error );
+
+int libpff_item_tree_create_from_index_values(
+     libpff_item_tree_t *item_tree,
+     libcdata_array_t *index_values_array,
+     libcdata_array_t *orphan_node_array,
+     libcdata_tree_node_t **root_folder_item_tree_node,
+     libcerror_error_t **error );
+
 int libpff_item_tree_get_node_by_identifier(
      libpff_item_tree_t *item_tree,
      uint32_t item_identifier,
      libcdata_tree_node_t **item_tree_node,
      libcerror_error_t **error );
 
+int libpff_item_tree_sort_nodes_by_identifier(
+     libcdata_array_t *item_tree_node_array,
+     libcerror_error_t **error );
+
+int libpff_item_tree_get_node_index_by_identifier(
+     libcdata_array_t *item_tree_node_array,
+     uint32_t item_identifier,
+     int *item_tree_node_index,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,1587 @@
+/*
+ * Item tree update functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libpff_definitions.h"
+#include "libpff_index_layout.h"
+#include "libpff_item_descriptor.h"
+#include "libpff_item_tree.h"
+#include "libpff_item_tree_update.h"
+#include "libpff_libcdata.h"
+#include "libpff_libcerror.h"
+
+/* Creates an item tree update
+ * Make sure the value item_tree_update is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_item_tree_update_initialize(
+     libpff_item_tree_update_t **item_tree_update,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_item_tree_update_initialize";
+
+	if( item_tree_update == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item tree update.",
+		 function );
+
+		return( -1 );
+	}
+	if( *item_tree_update != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid item tree update value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*item_tree_update = memory_allocate_structure(
+	                     libpff_item_tree_update_t );
+
+	if( *item_tree_update == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create item tree update.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *item_tree_update,
+	     0,
+	     sizeof( libpff_item_tree_update_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear item tree update.",
+		 function );
+
+		memory_free(
+		 *item_tree_update );
+
+		*item_tree_update = NULL;
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( ( *item_tree_update )->item_tree_node_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create item tree node array.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *item_tree_update != NULL )
+	{
+		memory_free(
+		 *item_tree_update );
+
+		*item_tree_update = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an item tree update
+ * The item tree nodes of add operations that were not applied
+ * and of remove operations that were applied are freed
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_item_tree_update_free(
+     libpff_item_tree_update_t **item_tree_update,
+     libcerror_error_t **error )
+{
+	libpff_item_tree_update_operation_t *operation = NULL;
+	static char *function                          = "libpff_item_tree_update_free";
+	int operation_index                            = 0;
+	int result                                     = 1;
+
+	if( item_tree_update == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item tree update.",
+		 function );
+
+		return( -1 );
+	}
+	if( *item_tree_update != NULL )
+	{
+		if( ( *item_tree_update )->operations != NULL )
+		{
+			for( operation_index = 0;
+			     operation_index < ( *item_tree_update )->number_of_operations;
+			     operation_index++ )
+			{
+				operation = &( ( ( *item_tree_update )->operations )[ operation_index ] );
+
+				if( ( ( operation->type == LIBPFF_ITEM_TREE_UPDATE_OPERATION_TYPE_ADD )
+				  &&  ( operation->is_applied == 0 ) )
+				 || ( ( operation->type == LIBPFF_ITEM_TREE_UPDATE_OPERATION_TYPE_REMOVE )
+				  &&  ( operation->is_applied != 0 ) ) )
+				{
+					if( libcdata_tree_node_free(
+					     &( operation->item_tree_node ),
+					     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_descriptor_free,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free item tree node of operation: %d.",
+						 function,
+						 operation_index );
+
+						result = -1;
+					}
+				}
+			}
+			memory_free(
+			 ( *item_tree_update )->operations );
+		}
+		if( ( *item_tree_update )->removed_identifiers != NULL )
+		{
+			memory_free(
+			 ( *item_tree_update )->removed_identifiers );
+		}
+		/* The item tree nodes in the array are managed by the item tree
+		 */
+		if( libcdata_array_free(
+		     &( ( *item_tree_update )->item_tree_node_array ),
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free item tree node array.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *item_tree_update );
+
+		*item_tree_update = NULL;
+	}
+	return( result );
+}
+
+/* Appends an operation
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_item_tree_update_append_operation(
+     libpff_item_tree_update_t *item_tree_update,
+     uint8_t type,
+     libcdata_tree_node_t *item_tree_node,
+     uint32_t parent_identifier,
+     uint64_t data_identifier,
+     uint64_t local_descriptors_identifier,
+     libcerror_error_t **error )
+{
+	libpff_item_tree_update_operation_t *operation = NULL;
+	void *operations                               = NULL;
+	static char *function                          = "libpff_item_tree_update_append_operation";
+
+	if( item_tree_update == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item tree update.",
+		 function );
+
+		return( -1 );
+	}
+	if( item_tree_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item tree node.",
+		 function );
+
+		return( -1 );
+	}
+	operations = (void *) item_tree_update->operations;
+
+	if( libpff_index_layout_resize_array(
+	     &operations,
+	     &( item_tree_update->maximum_number_of_operations ),
+	     item_tree_update->number_of_operations,
+	     sizeof( libpff_item_tree_update_operation_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize operations.",
+		 function );
+
+		return( -1 );
+	}
+	item_tree_update->operations = (libpff_item_tree_update_operation_t *) operations;
+
+	operation = &( item_tree_update->operations[ item_tree_update->number_of_operations ] );
+
+	operation->type                         = type;
+	operation->item_tree_node               = item_tree_node;
+	operation->parent_item_tree_node        = NULL;
+	operation->parent_operation_index       = -1;
+	operation->parent_identifier            = parent_identifier;
+	operation->data_identifier              = data_identifier;
+	operation->local_descriptors_identifier = local_descriptors_identifier;
+
+	operation->previous_parent_item_tree_node        = NULL;
+	operation->previous_data_identifier              = 0;
+	operation->previous_local_descriptors_identifier = 0;
+	operation->is_removed                            = 0;
+	operation->is_applied                            = 0;
+
+	item_tree_update->number_of_operations += 1;
+
+	return( 1 );
+}
+
+/* Appends the sub nodes of an item tree node to the item tree node array
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_item_tree_update_append_item_tree_nodes(
+     libpff_item_tree_update_t *item_tree_update,
+     libcdata_tree_node_t *item_tree_node,
+     int recursion_depth,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *sub_tree_node = NULL;
+	static char *function               = "libpff_item_tree_update_append_item_tree_nodes";
+	int entry_index                     = 0;
+	int number_of_sub_nodes             = 0;
+	int sub_node_index                  = 0;
+
+	if( item_tree_update == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item tree update.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( recursion_depth < 0 )
+	 || ( recursion_depth > LIBPFF_MAXIMUM_ITEM_TREE_RECURSION_DEPTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid recursion depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_tree_node_get_number_of_sub_nodes(
+	     item_tree_node,
+	     &number_of_sub_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub nodes.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_sub_nodes == 0 )
+	{
+		return( 1 );
+	}
+	if( libcdata_tree_node_get_sub_node_by_index(
+	     item_tree_node,
+	     0,
+	     &sub_tree_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve first sub node.",
+		 function );
+
+		return( -1 );
+	}
+	for( sub_node_index = 0;
+	     sub_node_index < number_of_sub_nodes;
+	     sub_node_index++ )
+	{
+		if( sub_tree_node == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: corruption detected for sub node: %d.",
+			 function,
+			 sub_node_index );
+
+			return( -1 );
+		}
+		if( libcdata_array_append_entry(
+		     item_tree_update->item_tree_node_array,
+		     &entry_index,
+		     (intptr_t *) sub_tree_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append sub node: %d to item tree node array.",
+			 function,
+			 sub_node_index );
+
+			return( -1 );
+		}
+		if( libpff_item_tree_update_append_item_tree_nodes(
+		     item_tree_update,
+		     sub_tree_node,
+		     recursion_depth + 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append sub nodes of sub node: %d.",
+			 function,
+			 sub_node_index );
+
+			return( -1 );
+		}
+		if( libcdata_tree_node_get_next_node(
+		     sub_tree_node,
+		     &sub_tree_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next node of sub node: %d.",
+			 function,
+			 sub_node_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the item tree node with a specific descriptor identifier from the item tree
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libpff_item_tree_update_get_item_tree_node_by_identifier(
+     libpff_item_tree_update_t *item_tree_update,
+     uint32_t descriptor_identifier,
+     libcdata_tree_node_t **item_tree_node,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_item_tree_update_get_item_tree_node_by_identifier";
+	int entry_index       = 0;
+	int result            = 0;
+
+	if( item_tree_update == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item tree update.",
+		 function );
+
+		return( -1 );
+	}
+	if( item_tree_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item tree node.",
+		 function );
+
+		return( -1 );
+	}
+	result = libpff_item_tree_get_node_index_by_identifier(
+	          item_tree_update->item_tree_node_array,
+	          descriptor_identifier,
+	          &entry_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve item tree node index: %" PRIu32 ".",
+		 function,
+		 descriptor_identifier );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     item_tree_update->item_tree_node_array,
+		     entry_index,
+		     (intptr_t **) item_tree_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve item tree node: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Retrieves the parent item tree node of an add or move operation
+ * The parent is either an item tree node that is not removed or
+ * the item tree node of an add operation
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libpff_item_tree_update_get_parent_item_tree_node(
+     libpff_item_tree_update_t *item_tree_update,
+     uint32_t parent_identifier,
+     libcdata_tree_node_t **parent_item_tree_node,
+     int *operation_index,
+     libcerror_error_t **error )
+{
+	libpff_item_descriptor_t *item_descriptor      = NULL;
+	libpff_item_tree_update_operation_t *operation = NULL;
+	static char *function                          = "libpff_item_tree_update_get_parent_item_tree_node";
+	int lower_index                                = 0;
+	int middle_index                               = 0;
+	int result                                     = 0;
+	int safe_operation_index                       = 0;
+	int upper_index                                = 0;
+
+	if( item_tree_update == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item tree update.",
+		 function );
+
+		return( -1 );
+	}
+	if( parent_item_tree_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parent item tree node.",
+		 function );
+
+		return( -1 );
+	}
+	if( operation_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid operation index.",
+		 function );
+
+		return( -1 );
+	}
+	upper_index = item_tree_update->number_of_removed_identifiers;
+
+	while( lower_index < upper_index )
+	{
+		middle_index = lower_index + ( ( upper_index - lower_index ) / 2 );
+
+		if( item_tree_update->removed_identifiers[ middle_index ] == parent_identifier )
+		{
+			return( 0 );
+		}
+		if( item_tree_update->removed_identifiers[ middle_index ] < parent_identifier )
+		{
+			lower_index = middle_index + 1;
+		}
+		else
+		{
+			upper_index = middle_index;
+		}
+	}
+	result = libpff_item_tree_update_get_item_tree_node_by_identifier(
+	          item_tree_update,
+	          parent_identifier,
+	          parent_item_tree_node,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve item tree node: %" PRIu32 ".",
+		 function,
+		 parent_identifier );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		*operation_index = -1;
+
+		return( 1 );
+	}
+	for( safe_operation_index = 0;
+	     safe_operation_index < item_tree_update->number_of_operations;
+	     safe_operation_index++ )
+	{
+		operation = &( item_tree_update->operations[ safe_operation_index ] );
+
+		if( operation->type != LIBPFF_ITEM_TREE_UPDATE_OPERATION_TYPE_ADD )
+		{
+			continue;
+		}
+		if( libcdata_tree_node_get_value(
+		     operation->item_tree_node,
+		     (intptr_t **) &item_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve item descriptor of operation: %d.",
+			 function,
+			 safe_operation_index );
+
+			return( -1 );
+		}
+		if( item_descriptor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing item descriptor of operation: %d.",
+			 function,
+			 safe_operation_index );
+
+			return( -1 );
+		}
+		if( item_descriptor->descriptor_identifier == parent_identifier )
+		{
+			*parent_item_tree_node = operation->item_tree_node;
+			*operation_index       = safe_operation_index;
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Prepares the update of the item tree from the changes of the descriptors index layout
+ *
+ * Changes that cannot be applied as an update, such as those that involve orphan items,
+ * the root folder or removed items with sub items, require the item tree to be created
+ * again, which is indicated by returning 0
+ *
+ * Returns 1 if successful, 0 if the item tree cannot be updated or -1 on error
+ */
+int libpff_item_tree_update_prepare(
+     libpff_item_tree_update_t *item_tree_update,
+     libpff_item_tree_t *item_tree,
+     libcdata_tree_node_t *root_folder_item_tree_node,
+     libcdata_array_t *orphan_node_array,
+     libpff_index_layout_t *index_layout,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *added_item_tree_node      = NULL;
+	libcdata_tree_node_t *ancestor_item_tree_node   = NULL;
+	libcdata_tree_node_t *item_tree_node            = NULL;
+	libcdata_tree_node_t *parent_item_tree_node     = NULL;
+	libpff_index_layout_value_t *changed_value      = NULL;
+	libpff_item_descriptor_t *added_item_descriptor = NULL;
+	libpff_item_descriptor_t *item_descriptor       = NULL;
+	libpff_item_descriptor_t *parent_descriptor     = NULL;
+	libpff_item_tree_update_operation_t *operation  = NULL;
+	uint32_t *changed_identifiers                   = NULL;
+	static char *function                           = "libpff_item_tree_update_prepare";
+	int ancestor_depth                              = 0;
+	int number_of_branch_moves                      = 0;
+	int number_of_orphan_nodes                      = 0;
+	int number_of_sub_nodes                         = 0;
+	int operation_index                             = 0;
+	int parent_operation_index                      = 0;
+	int result                                      = 0;
+	int value_index                                 = 0;
+
+	if( item_tree_update == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item tree update.",
+		 function );
+
+		return( -1 );
+	}
+	if( item_tree_update->number_of_operations != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid item tree update - operations already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( item_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_layout == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index layout.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     orphan_node_array,
+	     &number_of_orphan_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of orphan nodes.",
+		 function );
+
+		goto on_error;
+	}
+	/* An orphan item could get a parent
+	 */
+	if( number_of_orphan_nodes != 0 )
+	{
+		return( 0 );
+	}
+	if( index_layout->number_of_changed_values > 0 )
+	{
+		changed_identifiers = (uint32_t *) memory_allocate(
+		                                    sizeof( uint32_t ) * index_layout->number_of_changed_values );
+
+		if( changed_identifiers == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create changed identifiers.",
+			 function );
+
+			goto on_error;
+		}
+		for( value_index = 0;
+		     value_index < index_layout->number_of_changed_values;
+		     value_index++ )
+		{
+			changed_identifiers[ value_index ] = index_layout->changed_values[ value_index ].identifier;
+		}
+		if( libpff_index_layout_sort_identifiers(
+		     changed_identifiers,
+		     index_layout->number_of_changed_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to sort changed identifiers.",
+			 function );
+
+			goto on_error;
+		}
+		/* A descriptor identifier that is stored more than once
+		 * is handled by creating the item tree again
+		 */
+		for( value_index = 1;
+		     value_index < index_layout->number_of_changed_values;
+		     value_index++ )
+		{
+			if( changed_identifiers[ value_index ] == changed_identifiers[ value_index - 1 ] )
+			{
+				memory_free(
+				 changed_identifiers );
+
+				return( 0 );
+			}
+		}
+		memory_free(
+		 changed_identifiers );
+
+		changed_identifiers = NULL;
+	}
+	if( libpff_item_tree_update_append_item_tree_nodes(
+	     item_tree_update,
+	     item_tree->root_node,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append item tree nodes.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_item_tree_sort_nodes_by_identifier(
+	     item_tree_update->item_tree_node_array,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to sort item tree nodes.",
+		 function );
+
+		goto on_error;
+	}
+	if( index_layout->number_of_removed_identifiers > 0 )
+	{
+		item_tree_update->removed_identifiers = (uint32_t *) memory_allocate(
+		                                                      sizeof( uint32_t ) * index_layout->number_of_removed_identifiers );
+
+		if( item_tree_update->removed_identifiers == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create removed identifiers.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     item_tree_update->removed_identifiers,
+		     index_layout->removed_identifiers,
+		     sizeof( uint32_t ) * index_layout->number_of_removed_identifiers ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy removed identifiers.",
+			 function );
+
+			goto on_error;
+		}
+		item_tree_update->number_of_removed_identifiers = index_layout->number_of_removed_identifiers;
+
+		if( libpff_index_layout_sort_identifiers(
+		     item_tree_update->removed_identifiers,
+		     item_tree_update->number_of_removed_identifiers,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to sort removed identifiers.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( value_index = 0;
+	     value_index < item_tree_update->number_of_removed_identifiers;
+	     value_index++ )
+	{
+		item_tree_node = NULL;
+
+		result = libpff_item_tree_update_get_item_tree_node_by_identifier(
+		          item_tree_update,
+		          item_tree_update->removed_identifiers[ value_index ],
+		          &item_tree_node,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve item tree node: %" PRIu32 ".",
+			 function,
+			 item_tree_update->removed_identifiers[ value_index ] );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			continue;
+		}
+		if( item_tree_node == root_folder_item_tree_node )
+		{
+			return( 0 );
+		}
+		if( libcdata_tree_node_get_number_of_sub_nodes(
+		     item_tree_node,
+		     &number_of_sub_nodes,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of sub nodes.",
+			 function );
+
+			goto on_error;
+		}
+		if( number_of_sub_nodes != 0 )
+		{
+			return( 0 );
+		}
+		if( libpff_item_tree_update_append_operation(
+		     item_tree_update,
+		     LIBPFF_ITEM_TREE_UPDATE_OPERATION_TYPE_REMOVE,
+		     item_tree_node,
+		     0,
+		     0,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append remove operation.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( value_index = 0;
+	     value_index < index_layout->number_of_changed_values;
+	     value_index++ )
+	{
+		changed_value  = &( index_layout->changed_values[ value_index ] );
+		item_tree_node = NULL;
+
+		if( changed_value->identifier == 0 )
+		{
+			return( 0 );
+		}
+		result = libpff_item_tree_update_get_item_tree_node_by_identifier(
+		          item_tree_update,
+		          changed_value->identifier,
+		          &item_tree_node,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve item tree node: %" PRIu32 ".",
+			 function,
+			 changed_value->identifier );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			/* The root folder index descriptor points to itself as its parent
+			 */
+			if( changed_value->identifier == changed_value->parent_identifier )
+			{
+				return( 0 );
+			}
+			if( libpff_item_descriptor_initialize(
+			     &added_item_descriptor,
+			     changed_value->identifier,
+			     changed_value->data_identifier,
+			     changed_value->local_descriptors_identifier,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create item descriptor.",
+				 function );
+
+				goto on_error;
+			}
+			if( libcdata_tree_node_initialize(
+			     &added_item_tree_node,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create item tree node.",
+				 function );
+
+				goto on_error;
+			}
+			if( libcdata_tree_node_set_value(
+			     added_item_tree_node,
+			     (intptr_t *) added_item_descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set item descriptor in item tree node.",
+				 function );
+
+				goto on_error;
+			}
+			added_item_descriptor = NULL;
+
+			if( libpff_item_tree_update_append_operation(
+			     item_tree_update,
+			     LIBPFF_ITEM_TREE_UPDATE_OPERATION_TYPE_ADD,
+			     added_item_tree_node,
+			     changed_value->parent_identifier,
+			     changed_value->data_identifier,
+			     changed_value->local_descriptors_identifier,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append add operation.",
+				 function );
+
+				goto on_error;
+			}
+			/* The item tree node is now managed by the operation
+			 */
+			added_item_tree_node = NULL;
+
+			continue;
+		}
+		if( libcdata_tree_node_get_value(
+		     item_tree_node,
+		     (intptr_t **) &item_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve item descriptor.",
+			 function );
+
+			goto on_error;
+		}
+		if( item_descriptor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing item descriptor.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( item_descriptor->data_identifier != changed_value->data_identifier )
+		 || ( item_descriptor->local_descriptors_identifier != changed_value->local_descriptors_identifier ) )
+		{
+			if( libpff_item_tree_update_append_operation(
+			     item_tree_update,
+			     LIBPFF_ITEM_TREE_UPDATE_OPERATION_TYPE_SET_VALUES,
+			     item_tree_node,
+			     changed_value->parent_identifier,
+			     changed_value->data_identifier,
+			     changed_value->local_descriptors_identifier,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append set values operation.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( ( item_tree_node == root_folder_item_tree_node )
+		 || ( changed_value->identifier == changed_value->parent_identifier ) )
+		{
+			if( ( item_tree_node != root_folder_item_tree_node )
+			 || ( changed_value->identifier != changed_value->parent_identifier ) )
+			{
+				return( 0 );
+			}
+			continue;
+		}
+		if( libcdata_tree_node_get_parent_node(
+		     item_tree_node,
+		     &parent_item_tree_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve parent node.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcdata_tree_node_get_value(
+		     parent_item_tree_node,
+		     (intptr_t **) &parent_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve parent item descriptor.",
+			 function );
+
+			goto on_error;
+		}
+		if( parent_descriptor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing parent item descriptor.",
+			 function );
+
+			goto on_error;
+		}
+		if( parent_descriptor->descriptor_identifier != changed_value->parent_identifier )
+		{
+			if( libpff_item_tree_update_append_operation(
+			     item_tree_update,
+			     LIBPFF_ITEM_TREE_UPDATE_OPERATION_TYPE_MOVE,
+			     item_tree_node,
+			     changed_value->parent_identifier,
+			     changed_value->data_identifier,
+			     changed_value->local_descriptors_identifier,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append move operation.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	/* Resolve the parents of the add and move operations
+	 */
+	for( operation_index = 0;
+	     operation_index < item_tree_update->number_of_operations;
+	     operation_index++ )
+	{
+		operation = &( item_tree_update->operations[ operation_index ] );
+
+		if( ( operation->type != LIBPFF_ITEM_TREE_UPDATE_OPERATION_TYPE_ADD )
+		 && ( operation->type != LIBPFF_ITEM_TREE_UPDATE_OPERATION_TYPE_MOVE ) )
+		{
+			continue;
+		}
+		result = libpff_item_tree_update_get_parent_item_tree_node(
+		          item_tree_update,
+		          operation->parent_identifier,
+		          &( operation->parent_item_tree_node ),
+		          &( operation->parent_operation_index ),
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve parent item tree node: %" PRIu32 ".",
+			 function,
+			 operation->parent_identifier );
+
+			goto on_error;
+		}
+		/* An item without a parent is an orphan item
+		 */
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+	}
+	/* Make sure the operations cannot create a cycle. The parents of the add
+	 * operations must eventually be part of the item tree. A moved item cannot
+	 * become a sub item of an added or another moved item and only a single
+	 * moved item can have sub items, which cannot become its own ancestor
+	 */
+	for( operation_index = 0;
+	     operation_index < item_tree_update->number_of_operations;
+	     operation_index++ )
+	{
+		operation = &( item_tree_update->operations[ operation_index ] );
+
+		if( operation->type == LIBPFF_ITEM_TREE_UPDATE_OPERATION_TYPE_ADD )
+		{
+			parent_operation_index = operation->parent_operation_index;
+			ancestor_depth         = 0;
+
+			while( parent_operation_index != -1 )
+			{
+				if( ancestor_depth > item_tree_update->number_of_operations )
+				{
+					return( 0 );
+				}
+				parent_operation_index = item_tree_update->operations[ parent_operation_index ].parent_operation_index;
+
+				ancestor_depth++;
+			}
+		}
+		else if( operation->type == LIBPFF_ITEM_TREE_UPDATE_OPERATION_TYPE_MOVE )
+		{
+			if( operation->parent_operation_index != -1 )
+			{
+				return( 0 );
+			}
+			for( parent_operation_index = 0;
+			     parent_operation_index < item_tree_update->number_of_operations;
+			     parent_operation_index++ )
+			{
+				if( ( item_tree_update->operations[ parent_operation_index ].type == LIBPFF_ITEM_TREE_UPDATE_OPERATION_TYPE_MOVE )
+				 && ( item_tree_update->operations[ parent_operation_index ].item_tree_node == operation->parent_item_tree_node ) )
+				{
+					return( 0 );
+				}
+			}
+			if( libcdata_tree_node_get_number_of_sub_nodes(
+			     operation->item_tree_node,
+			     &number_of_sub_nodes,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of sub nodes.",
+				 function );
+
+				goto on_error;
+			}
+			if( number_of_sub_nodes == 0 )
+			{
+				continue;
+			}
+			number_of_branch_moves++;
+
+			if( number_of_branch_moves > 1 )
+			{
+				return( 0 );
+			}
+			ancestor_item_tree_node = operation->parent_item_tree_node;
+			ancestor_depth          = 0;
+
+			while( ancestor_item_tree_node != NULL )
+			{
+				if( ( ancestor_item_tree_node == operation->item_tree_node )
+				 || ( ancestor_depth > LIBPFF_MAXIMUM_ITEM_TREE_RECURSION_DEPTH ) )
+				{
+					return( 0 );
+				}
+				if( libcdata_tree_node_get_parent_node(
+				     ancestor_item_tree_node,
+				     &ancestor_item_tree_node,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve parent node.",
+					 function );
+
+					goto on_error;
+				}
+				ancestor_depth++;
+			}
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( added_item_tree_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 &added_item_tree_node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_descriptor_free,
+		 NULL );
+	}
+	if( added_item_descriptor != NULL )
+	{
+		libpff_item_descriptor_free(
+		 &added_item_descriptor,
+		 NULL );
+	}
+	if( changed_identifiers != NULL )
+	{
+		memory_free(
+		 changed_identifiers );
+	}
+	return( -1 );
+}
+
+/* Commits the prepared update of the item tree
+ * The item tree nodes are only relinked, if this fails the applied operations are reverted
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_item_tree_update_commit(
+     libpff_item_tree_update_t *item_tree_update,
+     libcerror_error_t **error )
+{
+	libpff_item_descriptor_t *item_descriptor      = NULL;
+	libpff_item_tree_update_operation_t *operation = NULL;
+	static char *function                          = "libpff_item_tree_update_commit";
+	int operation_index                            = 0;
+
+	if( item_tree_update == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item tree update.",
+		 function );
+
+		return( -1 );
+	}
+	for( operation_index = 0;
+	     operation_index < item_tree_update->number_of_operations;
+	     operation_index++ )
+	{
+		operation = &( item_tree_update->operations[ operation_index ] );
+
+		if( operation->is_applied != 0 )
+		{
+			continue;
+		}
+		if( operation->type == LIBPFF_ITEM_TREE_UPDATE_OPERATION_TYPE_SET_VALUES )
+		{
+			if( libcdata_tree_node_get_value(
+			     operation->item_tree_node,
+			     (intptr_t **) &item_descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve item descriptor of operation: %d.",
+				 function,
+				 operation_index );
+
+				goto on_error;
+			}
+			if( item_descriptor == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing item descriptor of operation: %d.",
+				 function,
+				 operation_index );
+
+				goto on_error;
+			}
+			operation->previous_data_identifier              = item_descriptor->data_identifier;
+			operation->previous_local_descriptors_identifier = item_descriptor->local_descriptors_identifier;
+
+			item_descriptor->data_identifier              = operation->data_identifier;
+			item_descriptor->local_descriptors_identifier = operation->local_descriptors_identifier;
+		}
+		else if( ( operation->type == LIBPFF_ITEM_TREE_UPDATE_OPERATION_TYPE_MOVE )
+		      || ( operation->type == LIBPFF_ITEM_TREE_UPDATE_OPERATION_TYPE_REMOVE ) )
+		{
+			if( libcdata_tree_node_get_parent_node(
+			     operation->item_tree_node,
+			     &( operation->previous_parent_item_tree_node ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve parent node of operation: %d.",
+				 function,
+				 operation_index );
+
+				goto on_error;
+			}
+			if( libcdata_tree_node_remove_node(
+			     operation->previous_parent_item_tree_node,
+			     operation->item_tree_node,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+				 "%s: unable to remove item tree node of operation: %d.",
+				 function,
+				 operation_index );
+
+				goto on_error;
+			}
+			operation->is_removed = 1;
+		}
+		if( ( operation->type == LIBPFF_ITEM_TREE_UPDATE_OPERATION_TYPE_ADD )
+		 || ( operation->type == LIBPFF_ITEM_TREE_UPDATE_OPERATION_TYPE_MOVE ) )
+		{
+			if( libcdata_tree_node_insert_node(
+			     operation->parent_item_tree_node,
+			     operation->item_tree_node,
+			     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libpff_item_descriptor_compare,
+			     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to insert item tree node of operation: %d.",
+				 function,
+				 operation_index );
+
+				goto on_error;
+			}
+		}
+		operation->is_applied = 1;
+	}
+	return( 1 );
+
+on_error:
+	libpff_item_tree_update_revert(
+	 item_tree_update,
+	 operation_index,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Reverts the applied operations of the update of the item tree
+ * The operations are reverted in reverse order starting with the last operation index
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_item_tree_update_revert(
+     libpff_item_tree_update_t *item_tree_update,
+     int last_operation_index,
+     libcerror_error_t **error )
+{
+	libpff_item_descriptor_t *item_descriptor      = NULL;
+	libpff_item_tree_update_operation_t *operation = NULL;
+	static char *function                          = "libpff_item_tree_update_revert";
+	int operation_index                            = 0;
+	int result                                     = 1;
+
+	if( item_tree_update == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item tree update.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( last_operation_index < 0 )
+	 || ( last_operation_index >= item_tree_update->number_of_operations ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid last operation index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( operation_index = last_operation_index;
+	     operation_index >= 0;
+	     operation_index-- )
+	{
+		operation = &( item_tree_update->operations[ operation_index ] );
+
+		if( operation->is_applied != 0 )
+		{
+			if( operation->type == LIBPFF_ITEM_TREE_UPDATE_OPERATION_TYPE_SET_VALUES )
+			{
+				if( libcdata_tree_node_get_value(
+				     operation->item_tree_node,
+				     (intptr_t **) &item_descriptor,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve item descriptor of operation: %d.",
+					 function,
+					 operation_index );
+
+					result = -1;
+				}
+				else if( item_descriptor != NULL )
+				{
+					item_descriptor->data_identifier              = operation->previous_data_identifier;
+					item_descriptor->local_descriptors_identifier = operation->previous_local_descriptors_identifier;
+				}
+			}
+			else if( ( operation->type == LIBPFF_ITEM_TREE_UPDATE_OPERATION_TYPE_ADD )
+			      || ( operation->type == LIBPFF_ITEM_TREE_UPDATE_OPERATION_TYPE_MOVE ) )
+			{
+				if( libcdata_tree_node_remove_node(
+				     operation->parent_item_tree_node,
+				     operation->item_tree_node,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+					 "%s: unable to remove item tree node of operation: %d.",
+					 function,
+					 operation_index );
+
+					result = -1;
+				}
+			}
+			operation->is_applied = 0;
+		}
+		if( operation->is_removed != 0 )
+		{
+			if( libcdata_tree_node_insert_node(
+			     operation->previous_parent_item_tree_node,
+			     operation->item_tree_node,
+			     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libpff_item_descriptor_compare,
+			     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to insert item tree node of operation: %d.",
+				 function,
+				 operation_index );
+
+				result = -1;
+			}
+			operation->is_removed = 0;
+		}
+	}
+	return( result );
+}
+
@@ -0,0 +1,182 @@
+/*
+ * Item tree update functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPFF_ITEM_TREE_UPDATE_H )
+#define _LIBPFF_ITEM_TREE_UPDATE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libpff_index_layout.h"
+#include "libpff_item_tree.h"
+#include "libpff_libcdata.h"
+#include "libpff_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libpff_item_tree_update_operation libpff_item_tree_update_operation_t;
+
+struct libpff_item_tree_update_operation
+{
+	/* The operation type
+	 */
+	uint8_t type;
+
+	/* The item tree node
+	 */
+	libcdata_tree_node_t *item_tree_node;
+
+	/* The (new) parent item tree node
+	 */
+	libcdata_tree_node_t *parent_item_tree_node;
+
+	/* The index of the operation that adds the parent item tree node
+	 * or -1 if the parent item tree node is part of the item tree
+	 */
+	int parent_operation_index;
+
+	/* The parent descriptor identifier
+	 */
+	uint32_t parent_identifier;
+
+	/* The data identifier
+	 */
+	uint64_t data_identifier;
+
+	/* The local descriptors identifier
+	 */
+	uint64_t local_descriptors_identifier;
+
+	/* The parent item tree node before the operation was applied
+	 */
+	libcdata_tree_node_t *previous_parent_item_tree_node;
+
+	/* The data identifier before the operation was applied
+	 */
+	uint64_t previous_data_identifier;
+
+	/* The local descriptors identifier before the operation was applied
+	 */
+	uint64_t previous_local_descriptors_identifier;
+
+	/* Value to indicate the item tree node was removed from its previous parent
+	 */
+	uint8_t is_removed;
+
+	/* Value to indicate the operation was applied to the item tree
+	 */
+	uint8_t is_applied;
+};
+
+typedef struct libpff_item_tree_update libpff_item_tree_update_t;
+
+/* The item tree update contains the changes of the descriptors index
+ * translated into operations on the item tree. The operations are prepared,
+ * which can fail, and then committed, which only relinks item tree nodes
+ */
+struct libpff_item_tree_update
+{
+	/* The item tree nodes sorted by descriptor identifier
+	 */
+	libcdata_array_t *item_tree_node_array;
+
+	/* The operations
+	 */
+	libpff_item_tree_update_operation_t *operations;
+
+	/* The number of operations
+	 */
+	int number_of_operations;
+
+	/* The maximum number of operations
+	 */
+	int maximum_number_of_operations;
+
+	/* The descriptor identifiers of the removed item tree nodes
+	 */
+	uint32_t *removed_identifiers;
+
+	/* The number of removed descriptor identifiers
+	 */
+	int number_of_removed_identifiers;
+};
+
+int libpff_item_tree_update_initialize(
+     libpff_item_tree_update_t **item_tree_update,
+     libcerror_error_t **error );
+
+int libpff_item_tree_update_free(
+     libpff_item_tree_update_t **item_tree_update,
+     libcerror_error_t **error );
+
+int libpff_item_tree_update_append_operation(
+     libpff_item_tree_update_t *item_tree_update,
+     uint8_t type,
+     libcdata_tree_node_t *item_tree_node,
+     uint32_t parent_identifier,
+     uint64_t data_identifier,
+     uint64_t local_descriptors_identifier,
+     libcerror_error_t **error );
+
+int libpff_item_tree_update_append_item_tree_nodes(
+     libpff_item_tree_update_t *item_tree_update,
+     libcdata_tree_node_t *item_tree_node,
+     int recursion_depth,
+     libcerror_error_t **error );
+
+int libpff_item_tree_update_get_item_tree_node_by_identifier(
+     libpff_item_tree_update_t *item_tree_update,
+     uint32_t descriptor_identifier,
+     libcdata_tree_node_t **item_tree_node,
+     libcerror_error_t **error );
+
+int libpff_item_tree_update_get_parent_item_tree_node(
+     libpff_item_tree_update_t *item_tree_update,
+     uint32_t parent_identifier,
+     libcdata_tree_node_t **parent_item_tree_node,
+     int *operation_index,
+     libcerror_error_t **error );
+
+int libpff_item_tree_update_prepare(
+     libpff_item_tree_update_t *item_tree_update,
+     libpff_item_tree_t *item_tree,
+     libcdata_tree_node_t *root_folder_item_tree_node,
+     libcdata_array_t *orphan_node_array,
+     libpff_index_layout_t *index_layout,
+     libcerror_error_t **error );
+
+int libpff_item_tree_update_commit(
+     libpff_item_tree_update_t *item_tree_update,
+     libcerror_error_t **error );
+
+int libpff_item_tree_update_revert(
+     libpff_item_tree_update_t *item_tree_update,
+     int last_operation_index,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPFF_ITEM_TREE_UPDATE_H ) */
+
@@ -39,6 +39,7 @@
 #include "libpff_offsets_index.h"
 #include "libpff_record_entry.h"
 #include "libpff_table.h"
+#include "libpff_table_cache.h"
 #include "libpff_types.h"
 #include "libpff_value_type.h"
 
@@ -244,7 +245,11 @@ int libpff_item_values_read(
      int debug_item_type,
      libcerror_error_t **error )
 {
-	static char *function = "libpff_item_values_read";
+	libpff_table_t *cached_table = NULL;
+	static char *function        = "libpff_item_values_read";
+	size_t value_data_size       = 0;
+	int result                   = 0;
+	int use_table_cache          = 0;
 
 	if( item_values == NULL )
 	{
@@ -268,6 +273,64 @@ int libpff_item_values_read(
 
 		return( -1 );
 	}
+	/* In caller driven mode reading the item values starts a new operation
+	 */
+	if( io_handle != NULL )
+	{
+		if( libpff_io_handle_clear_pending_read(
+		     io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to clear pending read.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* Only tables that are read with the name to ID map are cached
+	 * recovered tables are not cached since their identifiers are not unique
+	 * The name to ID map descriptor itself is read without the name to ID map
+	 * but contains no named properties so its table is cached as well
+	 */
+	if( ( io_handle != NULL )
+	 && ( io_handle->table_cache != NULL )
+	 && ( ( name_to_id_map_list != NULL )
+	  || ( item_values->descriptor_identifier == LIBPFF_DESCRIPTOR_IDENTIFIER_NAME_TO_ID_MAP ) )
+	 && ( item_values->recovered == 0 ) )
+	{
+		/* The item values receive their own copy of the cached table
+		 * since reading value data moves the read offset of its record entries
+		 */
+		result = libpff_table_cache_get_value(
+		          io_handle->table_cache,
+		          item_values->descriptor_identifier,
+		          item_values->data_identifier,
+		          item_values->local_descriptors_identifier,
+		          (intptr_t **) &( item_values->table ),
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve table of descriptor: %" PRIu32 " from cache.",
+			 function,
+			 item_values->descriptor_identifier );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			return( 1 );
+		}
+		use_table_cache = 1;
+	}
 	if( libpff_table_initialize(
 	     &( item_values->table ),
 	     item_values->descriptor_identifier,
@@ -303,6 +366,69 @@ int libpff_item_values_read(
 
 		goto on_error;
 	}
+	if( use_table_cache != 0 )
+	{
+		if( libpff_table_get_value_data_size(
+		     item_values->table,
+		     &value_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve table value data size.",
+			 function );
+
+			goto on_error;
+		}
+		/* Tables that exceed the maximum cache size are not copied
+		 */
+		if( value_data_size <= io_handle->table_cache->maximum_size )
+		{
+			if( libpff_table_clone(
+			     &cached_table,
+			     item_values->table,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to clone table.",
+				 function );
+
+				goto on_error;
+			}
+			result = libpff_table_cache_set_value(
+			          io_handle->table_cache,
+			          item_values->descriptor_identifier,
+			          item_values->data_identifier,
+			          item_values->local_descriptors_identifier,
+			          (intptr_t *) cached_table,
+			          value_data_size,
+			          error );
+
+			if( result != 1 )
+			{
+				libpff_table_free(
+				 &cached_table,
+				 NULL );
+			}
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set table of descriptor: %" PRIu32 " in cache.",
+				 function,
+				 item_values->descriptor_identifier );
+
+				goto on_error;
+			}
+		}
+	}
 	return( 1 );
 
 on_error:
@@ -0,0 +1,1810 @@
+/*
+ * Item visitor functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libpff_definitions.h"
+#include "libpff_file_header.h"
+#include "libpff_io_handle.h"
+#include "libpff_item.h"
+#include "libpff_item_descriptor.h"
+#include "libpff_item_tree.h"
+#include "libpff_item_visitor.h"
+#include "libpff_libbfio.h"
+#include "libpff_libcdata.h"
+#include "libpff_libcerror.h"
+#include "libpff_libcthreads.h"
+#include "libpff_reader_context.h"
+#include "libpff_task_deque.h"
+#include "libpff_types.h"
+
+/* Creates an item visitor
+ * Make sure the value item_visitor is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_item_visitor_initialize(
+     libpff_item_visitor_t **item_visitor,
+     libpff_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libpff_file_header_t *file_header,
+     size_t index_node_size,
+     libcdata_list_t *name_to_id_map_list,
+     libpff_item_tree_t *item_tree,
+     int number_of_workers,
+     uint8_t flags,
+     int (*callback_function)(
+            libpff_item_t *item,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	libpff_item_visitor_worker_t *worker = NULL;
+	static char *function                = "libpff_item_visitor_initialize";
+	size_t workers_size                  = 0;
+	int worker_index                     = 0;
+
+	if( item_visitor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item visitor.",
+		 function );
+
+		return( -1 );
+	}
+	if( *item_visitor != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid item visitor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( item_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_workers <= 0 )
+	 || ( number_of_workers > LIBPFF_MAXIMUM_NUMBER_OF_VISIT_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of workers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( callback_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback function.",
+		 function );
+
+		return( -1 );
+	}
+	*item_visitor = memory_allocate_structure(
+	                 libpff_item_visitor_t );
+
+	if( *item_visitor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create item visitor.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *item_visitor,
+	     0,
+	     sizeof( libpff_item_visitor_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear item visitor.",
+		 function );
+
+		memory_free(
+		 *item_visitor );
+
+		*item_visitor = NULL;
+
+		return( -1 );
+	}
+	workers_size = sizeof( libpff_item_visitor_worker_t ) * number_of_workers;
+
+	( *item_visitor )->workers = (libpff_item_visitor_worker_t *) memory_allocate(
+	                                                               workers_size );
+
+	if( ( *item_visitor )->workers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create workers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *item_visitor )->workers,
+	     0,
+	     workers_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear workers.",
+		 function );
+
+		memory_free(
+		 ( *item_visitor )->workers );
+
+		( *item_visitor )->workers = NULL;
+
+		goto on_error;
+	}
+	( *item_visitor )->io_handle           = io_handle;
+	( *item_visitor )->name_to_id_map_list = name_to_id_map_list;
+	( *item_visitor )->item_tree           = item_tree;
+	( *item_visitor )->flags               = flags;
+	( *item_visitor )->callback_function   = callback_function;
+	( *item_visitor )->callback_data       = callback_data;
+	( *item_visitor )->number_of_workers   = number_of_workers;
+
+	for( worker_index = 0;
+	     worker_index < number_of_workers;
+	     worker_index++ )
+	{
+		worker = &( ( *item_visitor )->workers[ worker_index ] );
+
+		worker->item_visitor = *item_visitor;
+		worker->worker_index = worker_index;
+		worker->result       = 1;
+
+		if( libpff_reader_context_initialize(
+		     &( worker->reader_context ),
+		     io_handle,
+		     file_io_handle,
+		     file_header,
+		     index_node_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create worker: %d reader context.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+		if( libpff_task_deque_initialize(
+		     &( worker->task_deque ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create worker: %d task deque.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *item_visitor )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *item_visitor )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *item_visitor != NULL )
+	{
+		libpff_item_visitor_free(
+		 item_visitor,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees an item visitor
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_item_visitor_free(
+     libpff_item_visitor_t **item_visitor,
+     libcerror_error_t **error )
+{
+	libpff_item_visitor_worker_t *worker = NULL;
+	static char *function                = "libpff_item_visitor_free";
+	int result                           = 1;
+	int worker_index                     = 0;
+
+	if( item_visitor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item visitor.",
+		 function );
+
+		return( -1 );
+	}
+	if( *item_visitor != NULL )
+	{
+		if( ( *item_visitor )->workers != NULL )
+		{
+			for( worker_index = 0;
+			     worker_index < ( *item_visitor )->number_of_workers;
+			     worker_index++ )
+			{
+				worker = &( ( *item_visitor )->workers[ worker_index ] );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+				if( worker->thread != NULL )
+				{
+					if( libcthreads_thread_join(
+					     &( worker->thread ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to join worker: %d thread.",
+						 function,
+						 worker_index );
+
+						result = -1;
+					}
+				}
+#endif
+				if( worker->error != NULL )
+				{
+					libcerror_error_free(
+					 &( worker->error ) );
+				}
+				if( worker->task_deque != NULL )
+				{
+					if( libpff_task_deque_free(
+					     &( worker->task_deque ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free worker: %d task deque.",
+						 function,
+						 worker_index );
+
+						result = -1;
+					}
+				}
+				if( worker->reader_context != NULL )
+				{
+					if( libpff_reader_context_free(
+					     &( worker->reader_context ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free worker: %d reader context.",
+						 function,
+						 worker_index );
+
+						result = -1;
+					}
+				}
+			}
+			memory_free(
+			 ( *item_visitor )->workers );
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *item_visitor )->condition != NULL )
+		{
+			if( libcthreads_condition_free(
+			     &( ( *item_visitor )->condition ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *item_visitor )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *item_visitor )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		memory_free(
+		 *item_visitor );
+
+		*item_visitor = NULL;
+	}
+	return( result );
+}
+
+/* Pushes a task onto the task deque of the worker
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_item_visitor_push_task(
+     libpff_item_visitor_t *item_visitor,
+     libpff_item_visitor_worker_t *worker,
+     libcdata_tree_node_t *item_tree_node,
+     libcdata_tree_node_t *first_sub_node,
+     int first_sub_node_index,
+     int number_of_sub_nodes,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_item_visitor_push_task";
+
+	if( item_visitor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item visitor.",
+		 function );
+
+		return( -1 );
+	}
+	if( worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid worker.",
+		 function );
+
+		return( -1 );
+	}
+	/* The task is counted as pending before it can be stolen, otherwise
+	 * a worker that completes it could see no pending tasks too early
+	 */
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     item_visitor->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	item_visitor->number_of_pending_tasks += 1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     item_visitor->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libpff_task_deque_push_bottom(
+	     worker->task_deque,
+	     item_tree_node,
+	     first_sub_node,
+	     first_sub_node_index,
+	     number_of_sub_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push task onto worker: %d task deque.",
+		 function,
+		 worker->worker_index );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     item_visitor->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	item_visitor->generation += 1;
+
+	if( item_visitor->number_of_waiting_workers > 0 )
+	{
+		if( libcthreads_condition_broadcast(
+		     item_visitor->condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 item_visitor->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_release(
+	     item_visitor->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves a task for the worker
+ * The worker takes the most recent task from its own task deque, if that
+ * is empty it steals the oldest task of one of the other workers. If no
+ * task can be stolen the worker waits until a task is pushed or until
+ * there are no more pending tasks
+ * Returns 1 if successful, 0 if no more tasks are available or -1 on error
+ */
+int libpff_item_visitor_get_task(
+     libpff_item_visitor_t *item_visitor,
+     libpff_item_visitor_worker_t *worker,
+     libpff_task_deque_task_t *task,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_item_visitor_get_task";
+	int result            = 0;
+	int victim_index      = 0;
+	int worker_offset     = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	uint32_t generation   = 0;
+	uint8_t is_done       = 0;
+#endif
+
+	if( item_visitor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item visitor.",
+		 function );
+
+		return( -1 );
+	}
+	if( worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid worker.",
+		 function );
+
+		return( -1 );
+	}
+	while( 1 )
+	{
+		result = libpff_item_visitor_is_stopped(
+		          item_visitor,
+		          error );
+
+		if( result != 0 )
+		{
+			if( result == 1 )
+			{
+				result = 0;
+			}
+			break;
+		}
+		result = libpff_task_deque_pop_bottom(
+		          worker->task_deque,
+		          task,
+		          error );
+
+		if( result != 0 )
+		{
+			break;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		/* The generation is retrieved before trying to steal, so that a task
+		 * pushed after a failed steal attempt is never missed
+		 */
+		if( libcthreads_mutex_grab(
+		     item_visitor->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+		generation = item_visitor->generation;
+
+		if( libcthreads_mutex_release(
+		     item_visitor->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		for( worker_offset = 1;
+		     worker_offset < item_visitor->number_of_workers;
+		     worker_offset++ )
+		{
+			victim_index = ( worker->worker_index + worker_offset ) % item_visitor->number_of_workers;
+
+			result = libpff_task_deque_steal_top(
+			          item_visitor->workers[ victim_index ].task_deque,
+			          task,
+			          error );
+
+			if( result != 0 )
+			{
+				break;
+			}
+		}
+		if( result != 0 )
+		{
+			break;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     item_visitor->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+		while( ( item_visitor->stop == 0 )
+		    && ( item_visitor->number_of_pending_tasks > 0 )
+		    && ( item_visitor->generation == generation ) )
+		{
+			item_visitor->number_of_waiting_workers += 1;
+
+			result = libcthreads_condition_wait(
+			          item_visitor->condition,
+			          item_visitor->mutex,
+			          error );
+
+			item_visitor->number_of_waiting_workers -= 1;
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 item_visitor->mutex,
+				 NULL );
+
+				return( -1 );
+			}
+			result = 0;
+		}
+		if( ( item_visitor->stop != 0 )
+		 || ( item_visitor->number_of_pending_tasks == 0 ) )
+		{
+			is_done = 1;
+		}
+		if( libcthreads_mutex_release(
+		     item_visitor->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+		if( is_done != 0 )
+		{
+			break;
+		}
+#else
+		/* Without multi-threading there is only one worker,
+		 * an empty task deque means all tasks are completed
+		 */
+		break;
+#endif
+	}
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve task.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Marks a task as completed
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_item_visitor_complete_task(
+     libpff_item_visitor_t *item_visitor,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_item_visitor_complete_task";
+
+	if( item_visitor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item visitor.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     item_visitor->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( item_visitor->number_of_pending_tasks > 0 )
+	{
+		item_visitor->number_of_pending_tasks -= 1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( item_visitor->number_of_pending_tasks == 0 )
+	 && ( item_visitor->number_of_waiting_workers > 0 ) )
+	{
+		if( libcthreads_condition_broadcast(
+		     item_visitor->condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 item_visitor->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_release(
+	     item_visitor->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Stops the visit and wakes up the waiting workers
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_item_visitor_stop(
+     libpff_item_visitor_t *item_visitor,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_item_visitor_stop";
+
+	if( item_visitor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item visitor.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     item_visitor->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	item_visitor->stop = 1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( item_visitor->number_of_waiting_workers > 0 )
+	{
+		if( libcthreads_condition_broadcast(
+		     item_visitor->condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 item_visitor->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_release(
+	     item_visitor->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Determines if the visit was stopped
+ * An abort signalled on the IO handle stops the visit
+ * Returns 1 if stopped, 0 if not or -1 on error
+ */
+int libpff_item_visitor_is_stopped(
+     libpff_item_visitor_t *item_visitor,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_item_visitor_is_stopped";
+	int result            = 0;
+
+	if( item_visitor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item visitor.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     item_visitor->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( item_visitor->io_handle != NULL )
+	 && ( item_visitor->io_handle->abort != 0 ) )
+	{
+		item_visitor->stop = 1;
+	}
+	if( item_visitor->stop != 0 )
+	{
+		result = 1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     item_visitor->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Visits an item tree node
+ * The callback function is called with an item of the item tree node when
+ * the item type is not skipped by the visit flags
+ * Returns 1 if successful, 0 if the callback function stopped the visit or -1 on error
+ */
+int libpff_item_visitor_visit_item_tree_node(
+     libpff_item_visitor_t *item_visitor,
+     libpff_item_visitor_worker_t *worker,
+     libcdata_tree_node_t *item_tree_node,
+     libcerror_error_t **error )
+{
+	libpff_item_descriptor_t *item_descriptor = NULL;
+	libpff_item_t *item                       = NULL;
+	static char *function                     = "libpff_item_visitor_visit_item_tree_node";
+	uint8_t node_identifier_type              = 0;
+	uint8_t skip_flag                         = 0;
+	int result                                = 0;
+
+	if( item_visitor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item visitor.",
+		 function );
+
+		return( -1 );
+	}
+	if( worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( worker->reader_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid worker - missing reader context.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_tree_node_get_value(
+	     item_tree_node,
+	     (intptr_t **) &item_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve item descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( item_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing item descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	node_identifier_type = (uint8_t) ( item_descriptor->descriptor_identifier & 0x0000001fUL );
+
+	switch( node_identifier_type )
+	{
+		case LIBPFF_NODE_IDENTIFIER_TYPE_FOLDER:
+		case LIBPFF_NODE_IDENTIFIER_TYPE_SEARCH_FOLDER:
+			skip_flag = LIBPFF_VISIT_FLAG_SKIP_FOLDERS;
+			break;
+
+		case LIBPFF_NODE_IDENTIFIER_TYPE_MESSAGE:
+			skip_flag = LIBPFF_VISIT_FLAG_SKIP_MESSAGES;
+			break;
+
+		default:
+			skip_flag = LIBPFF_VISIT_FLAG_SKIP_OTHER_ITEMS;
+			break;
+	}
+	if( ( item_visitor->flags & skip_flag ) != 0 )
+	{
+		return( 1 );
+	}
+	if( libpff_item_initialize(
+	     &item,
+	     worker->reader_context->io_handle,
+	     worker->reader_context->file_io_handle,
+	     item_visitor->name_to_id_map_list,
+	     worker->reader_context->descriptors_index,
+	     worker->reader_context->offsets_index,
+	     item_visitor->item_tree,
+	     item_tree_node,
+	     LIBPFF_ITEM_FLAGS_DEFAULT,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create item: %" PRIu32 ".",
+		 function,
+		 item_descriptor->descriptor_identifier );
+
+		goto on_error;
+	}
+	result = item_visitor->callback_function(
+	          item,
+	          item_visitor->callback_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: callback function failed for item: %" PRIu32 ".",
+		 function,
+		 item_descriptor->descriptor_identifier );
+
+		goto on_error;
+	}
+	if( libpff_item_free(
+	     &item,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free item: %" PRIu32 ".",
+		 function,
+		 item_descriptor->descriptor_identifier );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( item != NULL )
+	{
+		libpff_item_free(
+		 &item,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Pushes a task for the sub nodes of an item tree node
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_item_visitor_push_sub_nodes(
+     libpff_item_visitor_t *item_visitor,
+     libpff_item_visitor_worker_t *worker,
+     libcdata_tree_node_t *item_tree_node,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *first_sub_node = NULL;
+	static char *function                = "libpff_item_visitor_push_sub_nodes";
+	int number_of_sub_nodes              = 0;
+
+	if( libcdata_tree_node_get_number_of_sub_nodes(
+	     item_tree_node,
+	     &number_of_sub_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub nodes.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_sub_nodes == 0 )
+	{
+		return( 1 );
+	}
+	if( libcdata_tree_node_get_sub_node_by_index(
+	     item_tree_node,
+	     0,
+	     &first_sub_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve first sub node.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_item_visitor_push_task(
+	     item_visitor,
+	     worker,
+	     item_tree_node,
+	     first_sub_node,
+	     0,
+	     number_of_sub_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push task.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Runs a task
+ * Ranges larger than the maximum task size are split and the upper part
+ * is pushed back, so that it can be stolen by another worker
+ * Returns 1 if successful, 0 if the visit was stopped or -1 on error
+ */
+int libpff_item_visitor_run_task(
+     libpff_item_visitor_t *item_visitor,
+     libpff_item_visitor_worker_t *worker,
+     libpff_task_deque_task_t *task,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *split_sub_node = NULL;
+	libcdata_tree_node_t *sub_node       = NULL;
+	static char *function                = "libpff_item_visitor_run_task";
+	int number_of_split_sub_nodes        = 0;
+	int result                           = 0;
+	int sub_node_index                   = 0;
+
+	if( item_visitor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item visitor.",
+		 function );
+
+		return( -1 );
+	}
+	if( item_visitor->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid item visitor - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( task == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid task.",
+		 function );
+
+		return( -1 );
+	}
+	/* The sub nodes are a linked list, the first sub node of the upper part
+	 * is found by walking half the range, so that the total cost of splitting
+	 * a range remains proportional to its size
+	 */
+	while( task->number_of_sub_nodes > LIBPFF_ITEM_VISITOR_MAXIMUM_TASK_SIZE )
+	{
+		number_of_split_sub_nodes = task->number_of_sub_nodes / 2;
+
+		split_sub_node = task->first_sub_node;
+
+		for( sub_node_index = 0;
+		     sub_node_index < number_of_split_sub_nodes;
+		     sub_node_index++ )
+		{
+			if( libcdata_tree_node_get_next_node(
+			     split_sub_node,
+			     &split_sub_node,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve next node of sub node: %d.",
+				 function,
+				 task->first_sub_node_index + sub_node_index );
+
+				return( -1 );
+			}
+		}
+		if( libpff_item_visitor_push_task(
+		     item_visitor,
+		     worker,
+		     task->item_tree_node,
+		     split_sub_node,
+		     task->first_sub_node_index + number_of_split_sub_nodes,
+		     task->number_of_sub_nodes - number_of_split_sub_nodes,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push split task.",
+			 function );
+
+			return( -1 );
+		}
+		task->number_of_sub_nodes = number_of_split_sub_nodes;
+	}
+	sub_node = task->first_sub_node;
+
+	for( sub_node_index = 0;
+	     sub_node_index < task->number_of_sub_nodes;
+	     sub_node_index++ )
+	{
+		result = libpff_item_visitor_is_stopped(
+		          item_visitor,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if visit was stopped.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			return( 0 );
+		}
+		if( sub_node_index > 0 )
+		{
+			if( libcdata_tree_node_get_next_node(
+			     sub_node,
+			     &sub_node,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve next node of sub node: %d.",
+				 function,
+				 task->first_sub_node_index + sub_node_index - 1 );
+
+				return( -1 );
+			}
+		}
+		result = libpff_item_visitor_visit_item_tree_node(
+		          item_visitor,
+		          worker,
+		          sub_node,
+		          error );
+
+		if( result != 1 )
+		{
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to visit sub node: %d.",
+				 function,
+				 task->first_sub_node_index + sub_node_index );
+			}
+			return( result );
+		}
+		if( libpff_item_visitor_push_sub_nodes(
+		     item_visitor,
+		     worker,
+		     sub_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push task for sub nodes of sub node: %d.",
+			 function,
+			 task->first_sub_node_index + sub_node_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Runs a worker until no more tasks are available or the visit is stopped
+ * Returns 1 if successful, 0 if the visit was stopped or -1 on error
+ */
+int libpff_item_visitor_worker_run(
+     libpff_item_visitor_worker_t *worker,
+     libcerror_error_t **error )
+{
+	libpff_task_deque_task_t task;
+
+	libpff_item_visitor_t *item_visitor = NULL;
+	static char *function               = "libpff_item_visitor_worker_run";
+	int result                          = 0;
+
+	if( worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid worker.",
+		 function );
+
+		return( -1 );
+	}
+	item_visitor = worker->item_visitor;
+
+	if( item_visitor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid worker - missing item visitor.",
+		 function );
+
+		return( -1 );
+	}
+	while( 1 )
+	{
+		result = libpff_item_visitor_get_task(
+		          item_visitor,
+		          worker,
+		          &task,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve task.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		result = libpff_item_visitor_run_task(
+		          item_visitor,
+		          worker,
+		          &task,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to run task.",
+			 function );
+
+			goto on_error;
+		}
+		if( libpff_item_visitor_complete_task(
+		     item_visitor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to complete task.",
+			 function );
+
+			goto on_error;
+		}
+		if( result == 0 )
+		{
+			if( libpff_item_visitor_stop(
+			     item_visitor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to stop visit.",
+				 function );
+
+				goto on_error;
+			}
+			break;
+		}
+	}
+	result = libpff_item_visitor_is_stopped(
+	          item_visitor,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if visit was stopped.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+
+on_error:
+	libpff_item_visitor_stop(
+	 item_visitor,
+	 NULL );
+
+	return( -1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Callback function of the worker thread
+ * The outcome of the worker is stored in the worker
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_item_visitor_worker_thread_function(
+     libpff_item_visitor_worker_t *worker )
+{
+	if( worker == NULL )
+	{
+		return( -1 );
+	}
+	worker->result = libpff_item_visitor_worker_run(
+	                  worker,
+	                  &( worker->error ) );
+
+	return( 1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Visits the root item tree node and its sub nodes
+ * The calling thread runs the first worker, the other workers are run on
+ * separate threads
+ * Returns 1 if successful, 0 if the visit was stopped or -1 on error
+ */
+int libpff_item_visitor_visit(
+     libpff_item_visitor_t *item_visitor,
+     libcdata_tree_node_t *root_item_tree_node,
+     libcerror_error_t **error )
+{
+	libpff_item_visitor_worker_t *worker = NULL;
+	static char *function                = "libpff_item_visitor_visit";
+	int result                           = 0;
+	int worker_index                     = 0;
+
+	if( item_visitor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item visitor.",
+		 function );
+
+		return( -1 );
+	}
+	if( item_visitor->workers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid item visitor - missing workers.",
+		 function );
+
+		return( -1 );
+	}
+	if( root_item_tree_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid root item tree node.",
+		 function );
+
+		return( -1 );
+	}
+	worker = &( item_visitor->workers[ 0 ] );
+
+	result = libpff_item_visitor_visit_item_tree_node(
+	          item_visitor,
+	          worker,
+	          root_item_tree_node,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to visit root item tree node.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libpff_item_visitor_stop(
+		     item_visitor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to stop visit.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		if( libpff_item_visitor_push_sub_nodes(
+		     item_visitor,
+		     worker,
+		     root_item_tree_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push task for sub nodes of root item tree node.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( item_visitor->number_of_pending_tasks > 0 )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		for( worker_index = 1;
+		     worker_index < item_visitor->number_of_workers;
+		     worker_index++ )
+		{
+			if( libcthreads_thread_create(
+			     &( item_visitor->workers[ worker_index ].thread ),
+			     NULL,
+			     (int (*)(void *)) &libpff_item_visitor_worker_thread_function,
+			     (void *) &( item_visitor->workers[ worker_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create worker: %d thread.",
+				 function,
+				 worker_index );
+
+				goto on_error;
+			}
+		}
+#endif
+		worker->result = libpff_item_visitor_worker_run(
+		                  worker,
+		                  &( worker->error ) );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		for( worker_index = 1;
+		     worker_index < item_visitor->number_of_workers;
+		     worker_index++ )
+		{
+			if( libcthreads_thread_join(
+			     &( item_visitor->workers[ worker_index ].thread ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join worker: %d thread.",
+				 function,
+				 worker_index );
+
+				goto on_error;
+			}
+		}
+#endif
+	}
+	for( worker_index = 0;
+	     worker_index < item_visitor->number_of_workers;
+	     worker_index++ )
+	{
+		if( libpff_reader_context_merge_read_state(
+		     item_visitor->workers[ worker_index ].reader_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to merge worker: %d read state.",
+			 function,
+			 worker_index );
+
+			return( -1 );
+		}
+	}
+	for( worker_index = 0;
+	     worker_index < item_visitor->number_of_workers;
+	     worker_index++ )
+	{
+		worker = &( item_visitor->workers[ worker_index ] );
+
+		if( worker->result == -1 )
+		{
+			/* Hand the error of the first failed worker to the caller
+			 */
+			if( ( error != NULL )
+			 && ( *error == NULL ) )
+			{
+				*error = worker->error;
+
+				worker->error = NULL;
+			}
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: worker: %d failed.",
+			 function,
+			 worker_index );
+
+			return( -1 );
+		}
+	}
+	result = libpff_item_visitor_is_stopped(
+	          item_visitor,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if visit was stopped.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+
+on_error:
+	libpff_item_visitor_stop(
+	 item_visitor,
+	 NULL );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	for( worker_index = 1;
+	     worker_index < item_visitor->number_of_workers;
+	     worker_index++ )
+	{
+		if( item_visitor->workers[ worker_index ].thread != NULL )
+		{
+			libcthreads_thread_join(
+			 &( item_visitor->workers[ worker_index ].thread ),
+			 NULL );
+		}
+	}
+#endif
+	return( -1 );
+}
+
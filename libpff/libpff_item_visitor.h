@@ -0,0 +1,237 @@
+/*
+ * Item visitor functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPFF_ITEM_VISITOR_H )
+#define _LIBPFF_ITEM_VISITOR_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libpff_file_header.h"
+#include "libpff_io_handle.h"
+#include "libpff_item_tree.h"
+#include "libpff_libbfio.h"
+#include "libpff_libcdata.h"
+#include "libpff_libcerror.h"
+#include "libpff_libcthreads.h"
+#include "libpff_reader_context.h"
+#include "libpff_task_deque.h"
+#include "libpff_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libpff_item_visitor libpff_item_visitor_t;
+
+typedef struct libpff_item_visitor_worker libpff_item_visitor_worker_t;
+
+struct libpff_item_visitor_worker
+{
+	/* The item visitor
+	 */
+	libpff_item_visitor_t *item_visitor;
+
+	/* The worker index
+	 */
+	int worker_index;
+
+	/* The reader context
+	 */
+	libpff_reader_context_t *reader_context;
+
+	/* The task deque
+	 */
+	libpff_task_deque_t *task_deque;
+
+	/* The result of the worker
+	 */
+	int result;
+
+	/* The error of the worker
+	 */
+	libcerror_error_t *error;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The thread
+	 */
+	libcthreads_thread_t *thread;
+#endif
+};
+
+/* The item visitor traverses the item tree using multiple workers.
+ * Every worker has its own reader context and task deque, a task is a range
+ * of sub nodes of an item tree node. Workers that run out of tasks steal
+ * tasks from the other workers, large ranges are split so that the sub nodes
+ * of a single large folder are spread over the workers
+ */
+struct libpff_item_visitor
+{
+	/* The IO handle of the file
+	 */
+	libpff_io_handle_t *io_handle;
+
+	/* The name to ID map list, owned by the file
+	 */
+	libcdata_list_t *name_to_id_map_list;
+
+	/* The item tree, owned by the file
+	 */
+	libpff_item_tree_t *item_tree;
+
+	/* The visit flags
+	 */
+	uint8_t flags;
+
+	/* The callback function
+	 */
+	int (*callback_function)(
+	       libpff_item_t *item,
+	       void *callback_data,
+	       libcerror_error_t **error );
+
+	/* The callback data
+	 */
+	void *callback_data;
+
+	/* The workers
+	 */
+	libpff_item_visitor_worker_t *workers;
+
+	/* The number of workers
+	 */
+	int number_of_workers;
+
+	/* The number of tasks that were pushed but not yet completed
+	 */
+	int number_of_pending_tasks;
+
+	/* The number of workers waiting for a task
+	 */
+	int number_of_waiting_workers;
+
+	/* The generation, changes every time a task is pushed
+	 */
+	uint32_t generation;
+
+	/* Value to indicate the visit was stopped
+	 */
+	uint8_t stop;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition
+	 */
+	libcthreads_condition_t *condition;
+#endif
+};
+
+int libpff_item_visitor_initialize(
+     libpff_item_visitor_t **item_visitor,
+     libpff_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libpff_file_header_t *file_header,
+     size_t index_node_size,
+     libcdata_list_t *name_to_id_map_list,
+     libpff_item_tree_t *item_tree,
+     int number_of_workers,
+     uint8_t flags,
+     int (*callback_function)(
+            libpff_item_t *item,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error );
+
+int libpff_item_visitor_free(
+     libpff_item_visitor_t **item_visitor,
+     libcerror_error_t **error );
+
+int libpff_item_visitor_push_task(
+     libpff_item_visitor_t *item_visitor,
+     libpff_item_visitor_worker_t *worker,
+     libcdata_tree_node_t *item_tree_node,
+     libcdata_tree_node_t *first_sub_node,
+     int first_sub_node_index,
+     int number_of_sub_nodes,
+     libcerror_error_t **error );
+
+int libpff_item_visitor_push_sub_nodes(
+     libpff_item_visitor_t *item_visitor,
+     libpff_item_visitor_worker_t *worker,
+     libcdata_tree_node_t *item_tree_node,
+     libcerror_error_t **error );
+
+int libpff_item_visitor_get_task(
+     libpff_item_visitor_t *item_visitor,
+     libpff_item_visitor_worker_t *worker,
+     libpff_task_deque_task_t *task,
+     libcerror_error_t **error );
+
+int libpff_item_visitor_complete_task(
+     libpff_item_visitor_t *item_visitor,
+     libcerror_error_t **error );
+
+int libpff_item_visitor_stop(
+     libpff_item_visitor_t *item_visitor,
+     libcerror_error_t **error );
+
+int libpff_item_visitor_is_stopped(
+     libpff_item_visitor_t *item_visitor,
+     libcerror_error_t **error );
+
+int libpff_item_visitor_visit_item_tree_node(
+     libpff_item_visitor_t *item_visitor,
+     libpff_item_visitor_worker_t *worker,
+     libcdata_tree_node_t *item_tree_node,
+     libcerror_error_t **error );
+
+int libpff_item_visitor_run_task(
+     libpff_item_visitor_t *item_visitor,
+     libpff_item_visitor_worker_t *worker,
+     libpff_task_deque_task_t *task,
+     libcerror_error_t **error );
+
+int libpff_item_visitor_worker_run(
+     libpff_item_visitor_worker_t *worker,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int libpff_item_visitor_worker_thread_function(
+     libpff_item_visitor_worker_t *worker );
+
+#endif
+
+int libpff_item_visitor_visit(
+     libpff_item_visitor_t *item_visitor,
+     libcdata_tree_node_t *root_item_tree_node,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPFF_ITEM_VISITOR_H ) */
+
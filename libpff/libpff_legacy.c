@@ -82,8 +82,8 @@ int libpff_file_get_orphan_item(
 
 		return( -1 );
 	}
-	if( libcdata_list_get_value_by_index(
-	     internal_file->orphan_item_list,
+	if( libcdata_array_get_entry_by_index(
+	     internal_file->orphan_item_array,
 	     orphan_item_index,
 	     (intptr_t **) &orphan_item_tree_node,
 	     error ) != 1 )
@@ -170,8 +170,8 @@ int libpff_file_get_recovered_item(
 
 		return( -1 );
 	}
-	if( libcdata_list_get_value_by_index(
-	     internal_file->recovered_item_list,
+	if( libcdata_array_get_entry_by_index(
+	     internal_file->recovered_item_array,
 	     recovered_item_index,
 	     (intptr_t **) &recovered_item_tree_node,
 	     error ) != 1 )
@@ -252,15 +252,13 @@ int libpff_local_descriptor_node_get_entry_identifier(
 
 		return( -1 );
 	}
-	if( ( io_handle->file_type != LIBPFF_FILE_TYPE_32BIT )
-	 && ( io_handle->file_type != LIBPFF_FILE_TYPE_64BIT )
-	 && ( io_handle->file_type != LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
+	if( io_handle->format_functions == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: invalid IO handle - unsupported file type.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing format functions.",
 		 function );
 
 		return( -1 );
@@ -291,19 +289,10 @@ int libpff_local_descriptor_node_get_entry_identifier(
 	}
 	node_entry_data = &( local_descriptor_node->entries_data[ entry_offset ] );
 
-	if( io_handle->file_type == LIBPFF_FILE_TYPE_32BIT )
-	{
-		byte_stream_copy_to_uint32_little_endian(
-		 node_entry_data,
-		 *entry_identifier );
-	}
-	else if( ( io_handle->file_type == LIBPFF_FILE_TYPE_64BIT )
-	      || ( io_handle->file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
-	{
-		byte_stream_copy_to_uint64_little_endian(
-		 node_entry_data,
-		 *entry_identifier );
-	}
+	io_handle->format_functions->read_node_entry_identifier(
+	 node_entry_data,
+	 entry_identifier );
+
 	return( 1 );
 }
 
@@ -354,15 +343,13 @@ int libpff_local_descriptor_node_get_entry_sub_node_identifier(
 
 		return( -1 );
 	}
-	if( ( io_handle->file_type != LIBPFF_FILE_TYPE_32BIT )
-	 && ( io_handle->file_type != LIBPFF_FILE_TYPE_64BIT )
-	 && ( io_handle->file_type != LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
+	if( io_handle->format_functions == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: invalid IO handle - unsupported file type.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing format functions.",
 		 function );
 
 		return( -1 );
@@ -393,19 +380,10 @@ int libpff_local_descriptor_node_get_entry_sub_node_identifier(
 	}
 	node_entry_data = &( local_descriptor_node->entries_data[ entry_offset ] );
 
-	if( io_handle->file_type == LIBPFF_FILE_TYPE_32BIT )
-	{
-		byte_stream_copy_to_uint32_little_endian(
-		 ( (pff_local_descriptor_branch_node_entry_type_32bit_t *) node_entry_data )->sub_node_identifier,
-		 *entry_sub_node_identifier );
-	}
-	else if( ( io_handle->file_type == LIBPFF_FILE_TYPE_64BIT )
-	      || ( io_handle->file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
-	{
-		byte_stream_copy_to_uint64_little_endian(
-		 ( (pff_local_descriptor_branch_node_entry_type_64bit_t *) node_entry_data )->sub_node_identifier,
-		 *entry_sub_node_identifier );
-	}
+	io_handle->format_functions->read_local_descriptor_branch_entry(
+	 node_entry_data,
+	 entry_sub_node_identifier );
+
 	return( 1 );
 }
 
@@ -922,3 +900,136 @@ on_error:
 	return( -1 );
 }
 
+/* Reads a local descriptor node from its stored data
+ * The stored data must contain the stored data block including the padding and the footer
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_local_descriptor_node_read_stored_data(
+     libpff_local_descriptor_node_t *local_descriptor_node,
+     libpff_io_handle_t *io_handle,
+     uint32_t descriptor_identifier,
+     uint64_t data_identifier,
+     const uint8_t *stored_data,
+     size_t stored_data_size,
+     size32_t node_size,
+     libcerror_error_t **error )
+{
+	libpff_data_block_t *data_block = NULL;
+	static char *function           = "libpff_local_descriptor_node_read_stored_data";
+
+	if( local_descriptor_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid local descriptor node.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( node_size > (size32_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: node size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_data_block_initialize(
+	     &data_block,
+	     io_handle,
+	     descriptor_identifier,
+	     data_identifier,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create data block.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_data_block_read_data(
+	     data_block,
+	     stored_data,
+	     stored_data_size,
+	     node_size,
+	     io_handle->file_type,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data block.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_local_descriptor_node_read_data(
+	     local_descriptor_node,
+	     io_handle,
+	     data_block->data,
+	     data_block->uncompressed_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read local descriptor node.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_data_block_free(
+	     &data_block,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free data block.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( local_descriptor_node->entries_data != NULL )
+	{
+		memory_free(
+		 local_descriptor_node->entries_data );
+
+		local_descriptor_node->entries_data = NULL;
+	}
+	local_descriptor_node->entries_data_size = 0;
+
+	if( data_block != NULL )
+	{
+		libpff_data_block_free(
+		 &data_block,
+		 NULL );
+	}
+	return( -1 );
+}
+
@@ -103,6 +103,16 @@ int libpff_local_descriptor_node_read_file_io_handle(
      size32_t node_size,
      libcerror_error_t **error );
 
+int libpff_local_descriptor_node_read_stored_data(
+     libpff_local_descriptor_node_t *local_descriptor_node,
+     libpff_io_handle_t *io_handle,
+     uint32_t descriptor_identifier,
+     uint64_t data_identifier,
+     const uint8_t *stored_data,
+     size_t stored_data_size,
+     size32_t node_size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,1056 @@
+/*
+ * Local descriptor nodes cache functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libpff_local_descriptor_nodes_cache.h"
+#include "libpff_libcerror.h"
+#include "libpff_libcthreads.h"
+
+/* Creates a local descriptor nodes cache
+ * Make sure the value local_descriptor_nodes_cache is referencing, is set to NULL
+ * The number of shards must be a power of 2, the maximum number of entries
+ * and maximum size are divided evenly over the shards
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_local_descriptor_nodes_cache_initialize(
+     libpff_local_descriptor_nodes_cache_t **local_descriptor_nodes_cache,
+     int number_of_shards,
+     int maximum_number_of_entries,
+     size_t maximum_size,
+     int (*value_free_function)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	libpff_local_descriptor_nodes_cache_shard_t *shard = NULL;
+	static char *function                              = "libpff_local_descriptor_nodes_cache_initialize";
+	size_t entries_size                                = 0;
+	int hash_bucket_index                              = 0;
+	int maximum_number_of_entries_per_shard            = 0;
+	int number_of_hash_buckets                         = 0;
+	int shard_index                                    = 0;
+
+	if( local_descriptor_nodes_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid local descriptor nodes cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *local_descriptor_nodes_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid local descriptor nodes cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_shards <= 0 )
+	 || ( ( number_of_shards & ( number_of_shards - 1 ) ) != 0 )
+	 || ( (size_t) number_of_shards > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libpff_local_descriptor_nodes_cache_shard_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of shards value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_entries < number_of_shards )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	maximum_number_of_entries_per_shard = maximum_number_of_entries / number_of_shards;
+
+	if( (size_t) maximum_number_of_entries_per_shard > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libpff_local_descriptor_nodes_cache_entry_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_free_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value free function.",
+		 function );
+
+		return( -1 );
+	}
+	*local_descriptor_nodes_cache = memory_allocate_structure(
+	                libpff_local_descriptor_nodes_cache_t );
+
+	if( *local_descriptor_nodes_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create local descriptor nodes cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *local_descriptor_nodes_cache,
+	     0,
+	     sizeof( libpff_local_descriptor_nodes_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear local descriptor nodes cache.",
+		 function );
+
+		memory_free(
+		 *local_descriptor_nodes_cache );
+
+		*local_descriptor_nodes_cache = NULL;
+
+		return( -1 );
+	}
+	( *local_descriptor_nodes_cache )->shards = (libpff_local_descriptor_nodes_cache_shard_t *) memory_allocate(
+	                                                           sizeof( libpff_local_descriptor_nodes_cache_shard_t ) * number_of_shards );
+
+	if( ( *local_descriptor_nodes_cache )->shards == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create shards.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *local_descriptor_nodes_cache )->shards,
+	     0,
+	     sizeof( libpff_local_descriptor_nodes_cache_shard_t ) * number_of_shards ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear shards.",
+		 function );
+
+		memory_free(
+		 ( *local_descriptor_nodes_cache )->shards );
+
+		( *local_descriptor_nodes_cache )->shards = NULL;
+
+		goto on_error;
+	}
+	( *local_descriptor_nodes_cache )->number_of_shards                    = number_of_shards;
+	( *local_descriptor_nodes_cache )->maximum_number_of_entries_per_shard = maximum_number_of_entries_per_shard;
+	( *local_descriptor_nodes_cache )->maximum_size_per_shard              = maximum_size / number_of_shards;
+	( *local_descriptor_nodes_cache )->value_free_function                 = value_free_function;
+
+	entries_size = sizeof( libpff_local_descriptor_nodes_cache_entry_t ) * maximum_number_of_entries_per_shard;
+
+	/* Use at least twice as many hash buckets as entries to keep the chains short
+	 */
+	number_of_hash_buckets = 16;
+
+	while( ( number_of_hash_buckets / 2 ) < maximum_number_of_entries_per_shard )
+	{
+		number_of_hash_buckets *= 2;
+	}
+	( *local_descriptor_nodes_cache )->number_of_hash_buckets = number_of_hash_buckets;
+
+	for( shard_index = 0;
+	     shard_index < number_of_shards;
+	     shard_index++ )
+	{
+		shard = &( ( *local_descriptor_nodes_cache )->shards[ shard_index ] );
+
+		shard->entries = (libpff_local_descriptor_nodes_cache_entry_t *) memory_allocate(
+		                                                 entries_size );
+
+		if( shard->entries == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create shard: %d entries.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     shard->entries,
+		     0,
+		     entries_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear shard: %d entries.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		shard->hash_buckets = (int *) memory_allocate(
+		                               sizeof( int ) * number_of_hash_buckets );
+
+		if( shard->hash_buckets == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create shard: %d hash buckets.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		for( hash_bucket_index = 0;
+		     hash_bucket_index < number_of_hash_buckets;
+		     hash_bucket_index++ )
+		{
+			shard->hash_buckets[ hash_bucket_index ] = -1;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_initialize(
+		     &( shard->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create shard: %d mutex.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+#endif
+	}
+	return( 1 );
+
+on_error:
+	if( *local_descriptor_nodes_cache != NULL )
+	{
+		libpff_local_descriptor_nodes_cache_free(
+		 local_descriptor_nodes_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a local descriptor nodes cache
+ * The values are freed regardless of whether they are still pinned
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_local_descriptor_nodes_cache_free(
+     libpff_local_descriptor_nodes_cache_t **local_descriptor_nodes_cache,
+     libcerror_error_t **error )
+{
+	libpff_local_descriptor_nodes_cache_shard_t *shard = NULL;
+	static char *function                              = "libpff_local_descriptor_nodes_cache_free";
+	int entry_index                                    = 0;
+	int result                                         = 1;
+	int shard_index                                    = 0;
+
+	if( local_descriptor_nodes_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid local descriptor nodes cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *local_descriptor_nodes_cache != NULL )
+	{
+		if( ( *local_descriptor_nodes_cache )->shards != NULL )
+		{
+			for( shard_index = 0;
+			     shard_index < ( *local_descriptor_nodes_cache )->number_of_shards;
+			     shard_index++ )
+			{
+				shard = &( ( *local_descriptor_nodes_cache )->shards[ shard_index ] );
+
+				for( entry_index = 0;
+				     entry_index < shard->number_of_entries;
+				     entry_index++ )
+				{
+					if( ( *local_descriptor_nodes_cache )->value_free_function(
+					     &( shard->entries[ entry_index ].value ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free shard: %d value: %d.",
+						 function,
+						 shard_index,
+						 entry_index );
+
+						result = -1;
+					}
+				}
+				if( shard->hash_buckets != NULL )
+				{
+					memory_free(
+					 shard->hash_buckets );
+				}
+				if( shard->entries != NULL )
+				{
+					memory_free(
+					 shard->entries );
+				}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+				if( shard->mutex != NULL )
+				{
+					if( libcthreads_mutex_free(
+					     &( shard->mutex ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free shard: %d mutex.",
+						 function,
+						 shard_index );
+
+						result = -1;
+					}
+				}
+#endif
+			}
+			memory_free(
+			 ( *local_descriptor_nodes_cache )->shards );
+		}
+		memory_free(
+		 *local_descriptor_nodes_cache );
+
+		*local_descriptor_nodes_cache = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the index of the shard of specific identifiers
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_local_descriptor_nodes_cache_get_shard_index(
+     libpff_local_descriptor_nodes_cache_t *local_descriptor_nodes_cache,
+     uint32_t descriptor_identifier,
+     uint64_t data_identifier,
+     int *shard_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_local_descriptor_nodes_cache_get_shard_index";
+	uint64_t hash         = 0;
+
+	if( local_descriptor_nodes_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid local descriptor nodes cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( shard_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shard index.",
+		 function );
+
+		return( -1 );
+	}
+	/* Identifiers are mostly sequential and have their lower bits used as flags,
+	 * hence they are scrambled using Fibonacci hashing before the shard is selected
+	 */
+	hash = ( data_identifier ^ ( (uint64_t) descriptor_identifier << 32 ) ) * 0x9e3779b97f4a7c15ULL;
+
+	*shard_index = (int) ( ( hash >> 32 ) & (uint64_t) ( local_descriptor_nodes_cache->number_of_shards - 1 ) );
+
+	return( 1 );
+}
+
+/* Determines the hash bucket index of specific identifiers within their shard
+ * Returns the hash bucket index
+ */
+int libpff_local_descriptor_nodes_cache_get_hash_bucket_index(
+     libpff_local_descriptor_nodes_cache_t *local_descriptor_nodes_cache,
+     uint32_t descriptor_identifier,
+     uint64_t data_identifier )
+{
+	uint64_t hash       = 0;
+	uint32_t hash_value = 0;
+
+	hash = ( data_identifier ^ ( (uint64_t) descriptor_identifier << 32 ) ) * 0x9e3779b97f4a7c15ULL;
+
+	/* The lower bits of the upper 32-bit of the hash select the shard,
+	 * hence the bits above them select the hash bucket
+	 */
+	hash_value = (uint32_t) ( hash >> 32 ) / (uint32_t) local_descriptor_nodes_cache->number_of_shards;
+
+	return( (int) ( hash_value & (uint32_t) ( local_descriptor_nodes_cache->number_of_hash_buckets - 1 ) ) );
+}
+
+/* Replaces the reference to an entry index in its hash bucket chain
+ * The shard must be locked by the caller
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_local_descriptor_nodes_cache_replace_entry_index(
+     libpff_local_descriptor_nodes_cache_t *local_descriptor_nodes_cache,
+     libpff_local_descriptor_nodes_cache_shard_t *shard,
+     int entry_index,
+     int replacement_entry_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_local_descriptor_nodes_cache_replace_entry_index";
+	int chain_entry_index = 0;
+	int hash_bucket_index = 0;
+
+	if( local_descriptor_nodes_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid local descriptor nodes cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( shard == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shard.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_index < 0 )
+	 || ( entry_index >= shard->number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	hash_bucket_index = libpff_local_descriptor_nodes_cache_get_hash_bucket_index(
+	                     local_descriptor_nodes_cache,
+	                     shard->entries[ entry_index ].descriptor_identifier,
+	                     shard->entries[ entry_index ].data_identifier );
+
+	if( shard->hash_buckets[ hash_bucket_index ] == entry_index )
+	{
+		shard->hash_buckets[ hash_bucket_index ] = replacement_entry_index;
+
+		return( 1 );
+	}
+	chain_entry_index = shard->hash_buckets[ hash_bucket_index ];
+
+	while( chain_entry_index != -1 )
+	{
+		if( shard->entries[ chain_entry_index ].next_entry_index == entry_index )
+		{
+			shard->entries[ chain_entry_index ].next_entry_index = replacement_entry_index;
+
+			return( 1 );
+		}
+		chain_entry_index = shard->entries[ chain_entry_index ].next_entry_index;
+	}
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+	 "%s: missing entry: %d in hash bucket: %d.",
+	 function,
+	 entry_index,
+	 hash_bucket_index );
+
+	return( -1 );
+}
+
+/* Removes an entry from a shard and frees its value
+ * The last entry is moved into the slot of the removed entry
+ * The shard must be locked by the caller
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_local_descriptor_nodes_cache_remove_entry(
+     libpff_local_descriptor_nodes_cache_t *local_descriptor_nodes_cache,
+     libpff_local_descriptor_nodes_cache_shard_t *shard,
+     int entry_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_local_descriptor_nodes_cache_remove_entry";
+	int last_entry_index  = 0;
+	int result            = 1;
+
+	if( local_descriptor_nodes_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid local descriptor nodes cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( shard == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shard.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_index < 0 )
+	 || ( entry_index >= shard->number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Unlink the entry from its hash bucket chain
+	 */
+	if( libpff_local_descriptor_nodes_cache_replace_entry_index(
+	     local_descriptor_nodes_cache,
+	     shard,
+	     entry_index,
+	     shard->entries[ entry_index ].next_entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to unlink entry: %d.",
+		 function,
+		 entry_index );
+
+		return( -1 );
+	}
+	shard->size -= shard->entries[ entry_index ].value_size;
+
+	if( local_descriptor_nodes_cache->value_free_function(
+	     &( shard->entries[ entry_index ].value ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free value: %d.",
+		 function,
+		 entry_index );
+
+		result = -1;
+	}
+	last_entry_index = shard->number_of_entries - 1;
+
+	if( entry_index != last_entry_index )
+	{
+		shard->entries[ entry_index ] = shard->entries[ last_entry_index ];
+
+		if( libpff_local_descriptor_nodes_cache_replace_entry_index(
+		     local_descriptor_nodes_cache,
+		     shard,
+		     last_entry_index,
+		     entry_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to relink entry: %d.",
+			 function,
+			 last_entry_index );
+
+			result = -1;
+		}
+	}
+	shard->entries[ last_entry_index ].value            = NULL;
+	shard->entries[ last_entry_index ].value_size       = 0;
+	shard->entries[ last_entry_index ].next_entry_index = -1;
+
+	shard->number_of_entries -= 1;
+
+	return( result );
+}
+
+/* Retrieves a value from the local descriptor nodes cache
+ * On success the value is pinned and remains owned by the local descriptor nodes cache,
+ * it must be released using libpff_local_descriptor_nodes_cache_release_value
+ * Returns 1 if successful, 0 if no such value or -1 on error
+ */
+int libpff_local_descriptor_nodes_cache_get_value(
+     libpff_local_descriptor_nodes_cache_t *local_descriptor_nodes_cache,
+     uint32_t descriptor_identifier,
+     uint64_t data_identifier,
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	libpff_local_descriptor_nodes_cache_entry_t *entry = NULL;
+	libpff_local_descriptor_nodes_cache_shard_t *shard = NULL;
+	static char *function                              = "libpff_local_descriptor_nodes_cache_get_value";
+	int entry_index                                    = 0;
+	int hash_bucket_index                              = 0;
+	int result                                         = 0;
+	int shard_index                                    = 0;
+
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_local_descriptor_nodes_cache_get_shard_index(
+	     local_descriptor_nodes_cache,
+	     descriptor_identifier,
+	     data_identifier,
+	     &shard_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve shard index.",
+		 function );
+
+		return( -1 );
+	}
+	shard = &( local_descriptor_nodes_cache->shards[ shard_index ] );
+
+	hash_bucket_index = libpff_local_descriptor_nodes_cache_get_hash_bucket_index(
+	                     local_descriptor_nodes_cache,
+	                     descriptor_identifier,
+	                     data_identifier );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shard: %d mutex.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	entry_index = shard->hash_buckets[ hash_bucket_index ];
+
+	while( entry_index != -1 )
+	{
+		entry = &( shard->entries[ entry_index ] );
+
+		if( ( entry->descriptor_identifier == descriptor_identifier )
+		 && ( entry->data_identifier == data_identifier ) )
+		{
+			entry->number_of_pins += 1;
+			entry->is_referenced   = 1;
+
+			*value = entry->value;
+
+			result = 1;
+
+			break;
+		}
+		entry_index = entry->next_entry_index;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release shard: %d mutex.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets a value in the local descriptor nodes cache
+ * On success the local descriptor nodes cache takes over management of the value and the value
+ * is pinned, it must be released using libpff_local_descriptor_nodes_cache_release_value
+ * Unpinned entries are evicted in CLOCK order until the value fits the shard
+ * Returns 1 if successful, 0 if the value was not cached or -1 on error
+ * If the value was not cached the caller retains management of the value,
+ * which is the case if the identifiers are already set, the value is too large or
+ * all the entries of the shard are pinned
+ */
+int libpff_local_descriptor_nodes_cache_set_value(
+     libpff_local_descriptor_nodes_cache_t *local_descriptor_nodes_cache,
+     uint32_t descriptor_identifier,
+     uint64_t data_identifier,
+     intptr_t *value,
+     size_t value_size,
+     libcerror_error_t **error )
+{
+	libpff_local_descriptor_nodes_cache_entry_t *entry = NULL;
+	libpff_local_descriptor_nodes_cache_shard_t *shard = NULL;
+	static char *function                              = "libpff_local_descriptor_nodes_cache_set_value";
+	int entry_index                                    = 0;
+	int hash_bucket_index                              = 0;
+	int maximum_number_of_steps                        = 0;
+	int result                                         = 1;
+	int shard_index                                    = 0;
+	int step                                           = 0;
+
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_local_descriptor_nodes_cache_get_shard_index(
+	     local_descriptor_nodes_cache,
+	     descriptor_identifier,
+	     data_identifier,
+	     &shard_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve shard index.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_size > local_descriptor_nodes_cache->maximum_size_per_shard )
+	{
+		return( 0 );
+	}
+	shard = &( local_descriptor_nodes_cache->shards[ shard_index ] );
+
+	hash_bucket_index = libpff_local_descriptor_nodes_cache_get_hash_bucket_index(
+	                     local_descriptor_nodes_cache,
+	                     descriptor_identifier,
+	                     data_identifier );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shard: %d mutex.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	/* Another thread can have cached the same identifiers in the meantime
+	 */
+	entry_index = shard->hash_buckets[ hash_bucket_index ];
+
+	while( entry_index != -1 )
+	{
+		entry = &( shard->entries[ entry_index ] );
+
+		if( ( entry->descriptor_identifier == descriptor_identifier )
+		 && ( entry->data_identifier == data_identifier ) )
+		{
+			result = 0;
+
+			break;
+		}
+		entry_index = entry->next_entry_index;
+	}
+	while( ( result == 1 )
+	    && ( ( shard->number_of_entries >= local_descriptor_nodes_cache->maximum_number_of_entries_per_shard )
+	     ||  ( ( local_descriptor_nodes_cache->maximum_size_per_shard - shard->size ) < value_size ) ) )
+	{
+		/* Referenced entries get a second chance, hence two passes of the clock hand
+		 * are sufficient to find an unpinned entry if there is one
+		 */
+		maximum_number_of_steps = 2 * shard->number_of_entries;
+		result                  = 0;
+
+		for( step = 0;
+		     step < maximum_number_of_steps;
+		     step++ )
+		{
+			if( shard->clock_hand >= shard->number_of_entries )
+			{
+				shard->clock_hand = 0;
+			}
+			entry = &( shard->entries[ shard->clock_hand ] );
+
+			if( entry->number_of_pins == 0 )
+			{
+				if( entry->is_referenced == 0 )
+				{
+					result = 1;
+
+					break;
+				}
+				entry->is_referenced = 0;
+			}
+			shard->clock_hand += 1;
+		}
+		if( result == 0 )
+		{
+			break;
+		}
+		if( libpff_local_descriptor_nodes_cache_remove_entry(
+		     local_descriptor_nodes_cache,
+		     shard,
+		     shard->clock_hand,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove shard: %d entry: %d.",
+			 function,
+			 shard_index,
+			 shard->clock_hand );
+
+			goto on_error;
+		}
+	}
+	if( result == 1 )
+	{
+		entry = &( shard->entries[ shard->number_of_entries ] );
+
+		entry->descriptor_identifier = descriptor_identifier;
+		entry->data_identifier       = data_identifier;
+		entry->value                 = value;
+		entry->value_size            = value_size;
+		entry->number_of_pins        = 1;
+		entry->is_referenced         = 1;
+		entry->next_entry_index      = shard->hash_buckets[ hash_bucket_index ];
+
+		shard->hash_buckets[ hash_bucket_index ] = shard->number_of_entries;
+
+		shard->number_of_entries += 1;
+		shard->size              += value_size;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release shard: %d mutex.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 shard->mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Releases a value pinned by libpff_local_descriptor_nodes_cache_get_value or libpff_local_descriptor_nodes_cache_set_value
+ * Returns 1 if successful, 0 if no such value or -1 on error
+ */
+int libpff_local_descriptor_nodes_cache_release_value(
+     libpff_local_descriptor_nodes_cache_t *local_descriptor_nodes_cache,
+     uint32_t descriptor_identifier,
+     uint64_t data_identifier,
+     intptr_t *value,
+     libcerror_error_t **error )
+{
+	libpff_local_descriptor_nodes_cache_entry_t *entry = NULL;
+	libpff_local_descriptor_nodes_cache_shard_t *shard = NULL;
+	static char *function                              = "libpff_local_descriptor_nodes_cache_release_value";
+	int entry_index                                    = 0;
+	int hash_bucket_index                              = 0;
+	int result                                         = 0;
+	int shard_index                                    = 0;
+
+	if( libpff_local_descriptor_nodes_cache_get_shard_index(
+	     local_descriptor_nodes_cache,
+	     descriptor_identifier,
+	     data_identifier,
+	     &shard_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve shard index.",
+		 function );
+
+		return( -1 );
+	}
+	shard = &( local_descriptor_nodes_cache->shards[ shard_index ] );
+
+	hash_bucket_index = libpff_local_descriptor_nodes_cache_get_hash_bucket_index(
+	                     local_descriptor_nodes_cache,
+	                     descriptor_identifier,
+	                     data_identifier );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shard: %d mutex.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	entry_index = shard->hash_buckets[ hash_bucket_index ];
+
+	while( entry_index != -1 )
+	{
+		entry = &( shard->entries[ entry_index ] );
+
+		if( ( entry->descriptor_identifier == descriptor_identifier )
+		 && ( entry->data_identifier == data_identifier )
+		 && ( entry->value == value ) )
+		{
+			if( entry->number_of_pins > 0 )
+			{
+				entry->number_of_pins -= 1;
+			}
+			result = 1;
+
+			break;
+		}
+		entry_index = entry->next_entry_index;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release shard: %d mutex.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
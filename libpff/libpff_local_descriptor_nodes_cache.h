@@ -0,0 +1,201 @@
+/*
+ * Local descriptor nodes cache functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPFF_LOCAL_DESCRIPTOR_NODES_CACHE_H )
+#define _LIBPFF_LOCAL_DESCRIPTOR_NODES_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libpff_libcerror.h"
+#include "libpff_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libpff_local_descriptor_nodes_cache_entry libpff_local_descriptor_nodes_cache_entry_t;
+
+struct libpff_local_descriptor_nodes_cache_entry
+{
+	/* The descriptor identifier
+	 */
+	uint32_t descriptor_identifier;
+
+	/* The data identifier
+	 */
+	uint64_t data_identifier;
+
+	/* The value
+	 */
+	intptr_t *value;
+
+	/* The value size
+	 */
+	size_t value_size;
+
+	/* The number of pins
+	 */
+	int number_of_pins;
+
+	/* Value to indicate the entry was referenced since the clock hand last passed it
+	 */
+	uint8_t is_referenced;
+
+	/* The index of the next entry in the same hash bucket or -1 if not set
+	 */
+	int next_entry_index;
+};
+
+typedef struct libpff_local_descriptor_nodes_cache_shard libpff_local_descriptor_nodes_cache_shard_t;
+
+struct libpff_local_descriptor_nodes_cache_shard
+{
+	/* The entries
+	 */
+	libpff_local_descriptor_nodes_cache_entry_t *entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The hash buckets, which contain the index of the first entry
+	 * in the bucket or -1 if the bucket is empty
+	 */
+	int *hash_buckets;
+
+	/* The size
+	 */
+	size_t size;
+
+	/* The clock hand
+	 */
+	int clock_hand;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+typedef struct libpff_local_descriptor_nodes_cache libpff_local_descriptor_nodes_cache_t;
+
+/* The local descriptor nodes cache is divided in shards that are selected by the hash of the identifiers,
+ * each shard has its own lock, entries and byte budget. Values are pinned while
+ * in use and only unpinned values are evicted, in CLOCK (second chance) order
+ */
+struct libpff_local_descriptor_nodes_cache
+{
+	/* The shards
+	 */
+	libpff_local_descriptor_nodes_cache_shard_t *shards;
+
+	/* The number of shards
+	 */
+	int number_of_shards;
+
+	/* The maximum number of entries per shard
+	 */
+	int maximum_number_of_entries_per_shard;
+
+	/* The maximum size per shard
+	 */
+	size_t maximum_size_per_shard;
+
+	/* The number of hash buckets per shard, which is a power of 2
+	 */
+	int number_of_hash_buckets;
+
+	/* The value free function
+	 */
+	int (*value_free_function)(
+	       intptr_t **value,
+	       libcerror_error_t **error );
+};
+
+int libpff_local_descriptor_nodes_cache_initialize(
+     libpff_local_descriptor_nodes_cache_t **local_descriptor_nodes_cache,
+     int number_of_shards,
+     int maximum_number_of_entries,
+     size_t maximum_size,
+     int (*value_free_function)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+int libpff_local_descriptor_nodes_cache_free(
+     libpff_local_descriptor_nodes_cache_t **local_descriptor_nodes_cache,
+     libcerror_error_t **error );
+
+int libpff_local_descriptor_nodes_cache_get_shard_index(
+     libpff_local_descriptor_nodes_cache_t *local_descriptor_nodes_cache,
+     uint32_t descriptor_identifier,
+     uint64_t data_identifier,
+     int *shard_index,
+     libcerror_error_t **error );
+
+int libpff_local_descriptor_nodes_cache_get_hash_bucket_index(
+     libpff_local_descriptor_nodes_cache_t *local_descriptor_nodes_cache,
+     uint32_t descriptor_identifier,
+     uint64_t data_identifier );
+
+int libpff_local_descriptor_nodes_cache_replace_entry_index(
+     libpff_local_descriptor_nodes_cache_t *local_descriptor_nodes_cache,
+     libpff_local_descriptor_nodes_cache_shard_t *shard,
+     int entry_index,
+     int replacement_entry_index,
+     libcerror_error_t **error );
+
+int libpff_local_descriptor_nodes_cache_remove_entry(
+     libpff_local_descriptor_nodes_cache_t *local_descriptor_nodes_cache,
+     libpff_local_descriptor_nodes_cache_shard_t *shard,
+     int entry_index,
+     libcerror_error_t **error );
+
+int libpff_local_descriptor_nodes_cache_get_value(
+     libpff_local_descriptor_nodes_cache_t *local_descriptor_nodes_cache,
+     uint32_t descriptor_identifier,
+     uint64_t data_identifier,
+     intptr_t **value,
+     libcerror_error_t **error );
+
+int libpff_local_descriptor_nodes_cache_set_value(
+     libpff_local_descriptor_nodes_cache_t *local_descriptor_nodes_cache,
+     uint32_t descriptor_identifier,
+     uint64_t data_identifier,
+     intptr_t *value,
+     size_t value_size,
+     libcerror_error_t **error );
+
+int libpff_local_descriptor_nodes_cache_release_value(
+     libpff_local_descriptor_nodes_cache_t *local_descriptor_nodes_cache,
+     uint32_t descriptor_identifier,
+     uint64_t data_identifier,
+     intptr_t *value,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPFF_LOCAL_DESCRIPTOR_NODES_CACHE_H ) */
+
@@ -20,11 +20,11 @@
  */
 
 #include <common.h>
-#include <byte_stream.h>
 #include <memory.h>
 #include <types.h>
 
 #include "libpff_definitions.h"
+#include "libpff_format_functions.h"
 #include "libpff_io_handle.h"
 #include "libpff_libbfio.h"
 #include "libpff_libcerror.h"
@@ -32,6 +32,7 @@
 #include "libpff_libfcache.h"
 #include "libpff_libfdata.h"
 #include "libpff_local_descriptor_node.h"
+#include "libpff_local_descriptor_nodes_cache.h"
 #include "libpff_local_descriptor_value.h"
 #include "libpff_local_descriptors.h"
 #include "libpff_offsets_index.h"
@@ -129,20 +130,6 @@ int libpff_local_descriptors_initialize(
 
 		return( -1 );
 	}
-	if( libfcache_cache_initialize(
-	     &( ( *local_descriptors )->local_descriptor_nodes_cache ),
-	     LIBPFF_MAXIMUM_CACHE_ENTRIES_LOCAL_DESCRIPTORS_NODES,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create local descriptor nodes cache.",
-		 function );
-
-		goto on_error;
-	}
 	( *local_descriptors )->io_handle             = io_handle;
 	( *local_descriptors )->offsets_index         = offsets_index;
 	( *local_descriptors )->descriptor_identifier = descriptor_identifier;
@@ -170,7 +157,6 @@ int libpff_local_descriptors_free(
      libcerror_error_t **error )
 {
 	static char *function = "libpff_local_descriptors_free";
-	int result            = 1;
 
 	if( local_descriptors == NULL )
 	{
@@ -185,25 +171,12 @@ int libpff_local_descriptors_free(
 	}
 	if( *local_descriptors != NULL )
 	{
-		if( libfcache_cache_free(
-		     &( ( *local_descriptors )->local_descriptor_nodes_cache ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free local descriptor nodes cache.",
-			 function );
-
-			result = -1;
-		}
 		memory_free(
 		 *local_descriptors );
 
 		*local_descriptors = NULL;
 	}
-	return( result );
+	return( 1 );
 }
 
 /* Clones the local descriptors
@@ -266,6 +239,8 @@ int libpff_local_descriptors_clone(
 }
 
 /* Reads the local descriptor node
+ * The local descriptor node is cached in the local descriptor nodes cache of the IO handle,
+ * if available, and must be released using libpff_local_descriptors_release_local_descriptor_node
  * Returns 1 if successful or -1 on error
  */
 int libpff_local_descriptors_read_local_descriptor_node(
@@ -275,14 +250,12 @@ int libpff_local_descriptors_read_local_descriptor_node(
      libpff_local_descriptor_node_t **local_descriptor_node,
      libcerror_error_t **error )
 {
-	libfcache_cache_value_t *cache_value     = NULL;
-	libpff_index_value_t *offset_index_value = NULL;
-	static char *function                    = "libpff_local_descriptors_read_local_descriptor_node";
-	off64_t cache_value_offset               = 0;
-	int64_t cache_value_timestamp            = 0;
-	int cache_value_file_index               = 0;
-	int cache_value_index                    = 0;
-	int is_cached                            = 0;
+	libpff_local_descriptor_nodes_cache_t *local_descriptor_nodes_cache = NULL;
+	libpff_index_value_t *offset_index_value                            = NULL;
+	static char *function                                               = "libpff_local_descriptors_read_local_descriptor_node";
+	uint64_t cache_data_identifier                                      = 0;
+	int is_cached                                                       = 0;
+	int result                                                          = 0;
 
 	if( local_descriptors == NULL )
 	{
@@ -295,6 +268,17 @@ int libpff_local_descriptors_read_local_descriptor_node(
 
 		return( -1 );
 	}
+	if( local_descriptors->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid local descriptors - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
 	if( local_descriptor_node == NULL )
 	{
 		libcerror_error_set(
@@ -315,43 +299,40 @@ int libpff_local_descriptors_read_local_descriptor_node(
 		 data_identifier );
 	}
 #endif
-	cache_value_index = data_identifier % LIBPFF_MAXIMUM_CACHE_ENTRIES_LOCAL_DESCRIPTORS_NODES;
+	local_descriptor_nodes_cache = local_descriptors->io_handle->local_descriptor_nodes_cache;
 
-	if( libfcache_cache_get_value_by_index(
-	     local_descriptors->local_descriptor_nodes_cache,
-	     cache_value_index,
-	     &cache_value,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to find data identifier: %" PRIu64 ".",
-		 function,
-		 data_identifier );
+	/* Bit 0 of the data identifier is ignored by the offsets index
+	 * and is used to distinguish recovered local descriptor nodes
+	 */
+	cache_data_identifier = data_identifier & LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK;
 
-		return( -1 );
+	if( local_descriptors->recovered != 0 )
+	{
+		cache_data_identifier |= 1;
 	}
-	if( cache_value != NULL )
+
+	if( local_descriptor_nodes_cache != NULL )
 	{
-		if( libfcache_cache_value_get_identifier(
-		     cache_value,
-		     &cache_value_file_index,
-		     &cache_value_offset,
-		     &cache_value_timestamp,
-		     error ) != 1 )
+		result = libpff_local_descriptor_nodes_cache_get_value(
+		          local_descriptor_nodes_cache,
+		          local_descriptors->descriptor_identifier,
+		          cache_data_identifier,
+		          (intptr_t **) local_descriptor_node,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve cache value identifier.",
-			 function );
+			 "%s: unable to retrieve local descriptor node: %" PRIu64 " from cache.",
+			 function,
+			 data_identifier );
 
 			return( -1 );
 		}
-		if( (uint64_t) cache_value_offset == data_identifier )
+		else if( result != 0 )
 		{
 			is_cached = 1;
 		}
@@ -378,7 +359,7 @@ int libpff_local_descriptors_read_local_descriptor_node(
 			 function,
 			 data_identifier );
 
-			return( -1 );
+			goto on_error;
 		}
 		if( offset_index_value == NULL )
 		{
@@ -390,7 +371,7 @@ int libpff_local_descriptors_read_local_descriptor_node(
 			 function,
 			 data_identifier );
 
-			return( -1 );
+			goto on_error;
 		}
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( libcnotify_verbose != 0 )
@@ -405,24 +386,7 @@ int libpff_local_descriptors_read_local_descriptor_node(
 		}
 #endif
 	}
-	if( is_cached != 0 )
-	{
-		if( libfcache_cache_value_get_value(
-		     cache_value,
-		     (intptr_t **) local_descriptor_node,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve local descriptor node from cache value.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	else
+	if( is_cached == 0 )
 	{
 		if( libpff_local_descriptor_node_initialize(
 		     local_descriptor_node,
@@ -437,7 +401,7 @@ int libpff_local_descriptors_read_local_descriptor_node(
 
 			return( -1 );
 		}
-		if( local_descriptor_node == NULL )
+		if( *local_descriptor_node == NULL )
 		{
 			libcerror_error_set(
 			 error,
@@ -472,34 +436,352 @@ int libpff_local_descriptors_read_local_descriptor_node(
 
 			return( -1 );
 		}
-		if( libfcache_cache_set_value_by_index(
-		     local_descriptors->local_descriptor_nodes_cache,
-		     cache_value_index,
-		     0,
-		     (off64_t) data_identifier,
-		     0,
-		     (intptr_t *) *local_descriptor_node,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_local_descriptor_node_free,
-		     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
-		     error ) != 1 )
+		if( local_descriptor_nodes_cache != NULL )
+		{
+			/* If the local descriptor node could not be cached it remains owned
+			 * by the caller and is freed on release
+			 */
+			result = libpff_local_descriptor_nodes_cache_set_value(
+			          local_descriptor_nodes_cache,
+			          local_descriptors->descriptor_identifier,
+			          cache_data_identifier,
+			          (intptr_t *) *local_descriptor_node,
+			          sizeof( libpff_local_descriptor_node_t ) + ( *local_descriptor_node )->entries_data_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set local descriptor node in cache.",
+				 function );
+
+				libpff_local_descriptor_node_free(
+				 local_descriptor_node,
+				 NULL );
+
+				return( -1 );
+			}
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( is_cached != 0 )
+	{
+		libpff_local_descriptors_release_local_descriptor_node(
+		 local_descriptors,
+		 data_identifier,
+		 local_descriptor_node,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Releases a local descriptor node retrieved by libpff_local_descriptors_read_local_descriptor_node
+ * The local descriptor node is freed if it was not cached
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_local_descriptors_release_local_descriptor_node(
+     libpff_local_descriptors_t *local_descriptors,
+     uint64_t data_identifier,
+     libpff_local_descriptor_node_t **local_descriptor_node,
+     libcerror_error_t **error )
+{
+	libpff_local_descriptor_nodes_cache_t *local_descriptor_nodes_cache = NULL;
+	static char *function                                               = "libpff_local_descriptors_release_local_descriptor_node";
+	uint64_t cache_data_identifier                                      = 0;
+	int result                                                          = 0;
+
+	if( local_descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid local descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	if( local_descriptors->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid local descriptors - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( local_descriptor_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid local descriptor node.",
+		 function );
+
+		return( -1 );
+	}
+	if( *local_descriptor_node == NULL )
+	{
+		return( 1 );
+	}
+	local_descriptor_nodes_cache = local_descriptors->io_handle->local_descriptor_nodes_cache;
+
+	if( local_descriptor_nodes_cache != NULL )
+	{
+		cache_data_identifier = data_identifier & LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK;
+
+		if( local_descriptors->recovered != 0 )
+		{
+			cache_data_identifier |= 1;
+		}
+		result = libpff_local_descriptor_nodes_cache_release_value(
+		          local_descriptor_nodes_cache,
+		          local_descriptors->descriptor_identifier,
+		          cache_data_identifier,
+		          (intptr_t *) *local_descriptor_node,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set local descriptor node in cache.",
-			 function );
+			 "%s: unable to release local descriptor node: %" PRIu64 " in cache.",
+			 function,
+			 data_identifier );
 
-			libpff_local_descriptor_node_free(
-			 local_descriptor_node,
-			 NULL );
+			return( -1 );
+		}
+	}
+	if( result == 0 )
+	{
+		if( libpff_local_descriptor_node_free(
+		     local_descriptor_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free local descriptor node.",
+			 function );
 
 			return( -1 );
 		}
 	}
+	*local_descriptor_node = NULL;
+
 	return( 1 );
 }
 
+/* Determines if a local descriptor node is cached in the local descriptor nodes cache of the IO handle
+ * Returns 1 if cached, 0 if not or -1 on error
+ */
+int libpff_local_descriptors_has_cached_local_descriptor_node(
+     libpff_local_descriptors_t *local_descriptors,
+     uint64_t data_identifier,
+     libcerror_error_t **error )
+{
+	libpff_local_descriptor_nodes_cache_t *local_descriptor_nodes_cache = NULL;
+	libpff_local_descriptor_node_t *local_descriptor_node               = NULL;
+	static char *function                                               = "libpff_local_descriptors_has_cached_local_descriptor_node";
+	uint64_t cache_data_identifier                                      = 0;
+	int result                                                          = 0;
+
+	if( local_descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid local descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	if( local_descriptors->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid local descriptors - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	local_descriptor_nodes_cache = local_descriptors->io_handle->local_descriptor_nodes_cache;
+
+	if( local_descriptor_nodes_cache == NULL )
+	{
+		return( 0 );
+	}
+	cache_data_identifier = data_identifier & LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK;
+
+	if( local_descriptors->recovered != 0 )
+	{
+		cache_data_identifier |= 1;
+	}
+	result = libpff_local_descriptor_nodes_cache_get_value(
+	          local_descriptor_nodes_cache,
+	          local_descriptors->descriptor_identifier,
+	          cache_data_identifier,
+	          (intptr_t **) &local_descriptor_node,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve local descriptor node: %" PRIu64 " from cache.",
+		 function,
+		 data_identifier );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( libpff_local_descriptor_nodes_cache_release_value(
+		     local_descriptor_nodes_cache,
+		     local_descriptors->descriptor_identifier,
+		     cache_data_identifier,
+		     (intptr_t *) local_descriptor_node,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release local descriptor node: %" PRIu64 " in cache.",
+			 function,
+			 data_identifier );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Caches a local descriptor node that was read in advance in the local descriptor nodes cache of the IO handle
+ * If cached the cache takes over management of the local descriptor node and it is set to NULL,
+ * otherwise the caller retains management of the local descriptor node
+ * Returns 1 if cached, 0 if not or -1 on error
+ */
+int libpff_local_descriptors_cache_local_descriptor_node(
+     libpff_local_descriptors_t *local_descriptors,
+     uint64_t data_identifier,
+     libpff_local_descriptor_node_t **local_descriptor_node,
+     libcerror_error_t **error )
+{
+	libpff_local_descriptor_nodes_cache_t *local_descriptor_nodes_cache = NULL;
+	static char *function                                               = "libpff_local_descriptors_cache_local_descriptor_node";
+	uint64_t cache_data_identifier                                      = 0;
+	int result                                                          = 0;
+
+	if( local_descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid local descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	if( local_descriptors->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid local descriptors - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( local_descriptor_node == NULL )
+	 || ( *local_descriptor_node == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid local descriptor node.",
+		 function );
+
+		return( -1 );
+	}
+	local_descriptor_nodes_cache = local_descriptors->io_handle->local_descriptor_nodes_cache;
+
+	if( local_descriptor_nodes_cache == NULL )
+	{
+		return( 0 );
+	}
+	cache_data_identifier = data_identifier & LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK;
+
+	if( local_descriptors->recovered != 0 )
+	{
+		cache_data_identifier |= 1;
+	}
+	result = libpff_local_descriptor_nodes_cache_set_value(
+	          local_descriptor_nodes_cache,
+	          local_descriptors->descriptor_identifier,
+	          cache_data_identifier,
+	          (intptr_t *) *local_descriptor_node,
+	          sizeof( libpff_local_descriptor_node_t ) + ( *local_descriptor_node )->entries_data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set local descriptor node in cache.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		/* The value is pinned by set value and only needs to remain cached
+		 */
+		if( libpff_local_descriptor_nodes_cache_release_value(
+		     local_descriptor_nodes_cache,
+		     local_descriptors->descriptor_identifier,
+		     cache_data_identifier,
+		     (intptr_t *) *local_descriptor_node,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release local descriptor node: %" PRIu64 " in cache.",
+			 function,
+			 data_identifier );
+
+			*local_descriptor_node = NULL;
+
+			return( -1 );
+		}
+		*local_descriptor_node = NULL;
+	}
+	return( result );
+}
+
 /* Reads the local descriptor node tree node
  * Returns 1 if successful or -1 on error
  */
@@ -577,7 +859,7 @@ int libpff_local_descriptors_read_tree_node(
 		 "%s: missing local descriptor node.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 	if( local_descriptors->io_handle->file_type != LIBPFF_FILE_TYPE_32BIT )
 	{
@@ -602,7 +884,7 @@ int libpff_local_descriptors_read_tree_node(
 			 "%s: unable to resize number of sub nodes.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 		for( entry_index = 0;
 		     entry_index < local_descriptor_node->number_of_entries;
@@ -625,7 +907,7 @@ int libpff_local_descriptors_read_tree_node(
 					 function,
 					 entry_index );
 
-					return( -1 );
+					goto on_error;
 				}
 				/* Check if the local descriptor sub node identifier exists
 				 */
@@ -647,7 +929,7 @@ int libpff_local_descriptors_read_tree_node(
 					 function,
 					 local_descriptor_sub_node_identifier );
 
-					return( -1 );
+					goto on_error;
 				}
 				if( offset_index_value == NULL )
 				{
@@ -658,7 +940,7 @@ int libpff_local_descriptors_read_tree_node(
 					 "%s: missing offset index value.",
 					 function );
 
-					return( -1 );
+					goto on_error;
 				}
 #if defined( HAVE_DEBUG_OUTPUT )
 				if( libcnotify_verbose != 0 )
@@ -708,7 +990,7 @@ int libpff_local_descriptors_read_tree_node(
 				 function,
 				 entry_index );
 
-				return( -1 );
+				goto on_error;
 			}
 			if( local_descriptor_node->level == LIBPFF_LOCAL_DESCRIPTOR_NODE_LEVEL_LEAF )
 			{
@@ -725,13 +1007,43 @@ int libpff_local_descriptors_read_tree_node(
 					 function,
 					 entry_index );
 
-					return( -1 );
+					goto on_error;
 				}
 			}
 			node_offset += local_descriptor_node->entry_size;
 		}
 	}
+	if( libpff_local_descriptors_release_local_descriptor_node(
+	     local_descriptors,
+	     data_identifier,
+	     &local_descriptor_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release local descriptor node.",
+		 function );
+
+		/* The release failed hence the node must not be released again
+		 */
+		local_descriptor_node = NULL;
+
+		goto on_error;
+	}
 	return( 1 );
+
+on_error:
+	if( local_descriptor_node != NULL )
+	{
+		libpff_local_descriptors_release_local_descriptor_node(
+		 local_descriptors,
+		 data_identifier,
+		 &local_descriptor_node,
+		 NULL );
+	}
+	return( -1 );
 }
 
 /* Reads the local descriptor value
@@ -774,15 +1086,13 @@ int libpff_local_descriptors_read_local_descriptor_value(
 
 		return( -1 );
 	}
-	if( ( local_descriptors->io_handle->file_type != LIBPFF_FILE_TYPE_32BIT )
-	 && ( local_descriptors->io_handle->file_type != LIBPFF_FILE_TYPE_64BIT )
-	 && ( local_descriptors->io_handle->file_type != LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
+	if( local_descriptors->io_handle->format_functions == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported file type.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid local descriptors - invalid IO handle - missing format functions.",
 		 function );
 
 		return( -1 );
@@ -823,7 +1133,7 @@ int libpff_local_descriptors_read_local_descriptor_value(
 		 "%s: missing local descriptor node.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 	if( libpff_local_descriptor_node_get_entry_identifier(
 	     local_descriptor_node,
@@ -840,7 +1150,7 @@ int libpff_local_descriptors_read_local_descriptor_value(
 		 function,
 		 entry_index );
 
-		return( -1 );
+		goto on_error;
 	}
 	/* Ignore the upper 32-bit of local descriptor identifiers
 	 */
@@ -863,7 +1173,7 @@ int libpff_local_descriptors_read_local_descriptor_value(
 			 function,
 			 entry_index );
 
-			return( -1 );
+			goto on_error;
 		}
 		if( node_entry_data == NULL )
 		{
@@ -875,41 +1185,13 @@ int libpff_local_descriptors_read_local_descriptor_value(
 			 function,
 			 entry_index );
 
-			return( -1 );
-		}
-		if( local_descriptors->io_handle->file_type == LIBPFF_FILE_TYPE_32BIT )
-		{
-			node_entry_data += 4;
-
-			byte_stream_copy_to_uint32_little_endian(
-			 node_entry_data,
-			 local_descriptor_value->data_identifier );
-
-			node_entry_data += 4;
-
-			byte_stream_copy_to_uint32_little_endian(
-			 node_entry_data,
-			 local_descriptor_value->local_descriptors_identifier );
-
-			node_entry_data += 4;
+			goto on_error;
 		}
-		else if( ( local_descriptors->io_handle->file_type == LIBPFF_FILE_TYPE_64BIT )
-		      || ( local_descriptors->io_handle->file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
-		{
-			node_entry_data += 8;
-
-			byte_stream_copy_to_uint64_little_endian(
-			 node_entry_data,
-			 local_descriptor_value->data_identifier );
-
-			node_entry_data += 8;
-
-			byte_stream_copy_to_uint64_little_endian(
-			 node_entry_data,
-			 local_descriptor_value->local_descriptors_identifier );
+		local_descriptors->io_handle->format_functions->read_local_descriptor_leaf_entry(
+		 node_entry_data,
+		 &( local_descriptor_value->data_identifier ),
+		 &( local_descriptor_value->local_descriptors_identifier ) );
 
-			node_entry_data += 8;
-		}
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( libcnotify_verbose != 0 )
 		{
@@ -941,7 +1223,7 @@ int libpff_local_descriptors_read_local_descriptor_value(
 			 function,
 			 entry_index );
 
-			return( -1 );
+			goto on_error;
 		}
 /* TODO handle multiple recovered offset index values */
 		if( libpff_offsets_index_get_index_value_by_identifier(
@@ -961,7 +1243,7 @@ int libpff_local_descriptors_read_local_descriptor_value(
 			 function,
 			 local_descriptor_value->sub_node_identifier );
 
-			return( -1 );
+			goto on_error;
 		}
 		if( offset_index_value == NULL )
 		{
@@ -972,7 +1254,7 @@ int libpff_local_descriptors_read_local_descriptor_value(
 			 "%s: missing offset index value.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( libcnotify_verbose != 0 )
@@ -1001,7 +1283,7 @@ int libpff_local_descriptors_read_local_descriptor_value(
 			 "%s: unable to determine if sub nodes data range is set.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 		else if( result == 0 )
 		{
@@ -1020,11 +1302,39 @@ int libpff_local_descriptors_read_local_descriptor_value(
 				 "%s: unable to set sub nodes data range.",
 				 function );
 
-				return( -1 );
+				goto on_error;
 			}
 		}
 	}
+	if( libpff_local_descriptors_release_local_descriptor_node(
+	     local_descriptors,
+	     data_identifier,
+	     &local_descriptor_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release local descriptor node.",
+		 function );
+
+		local_descriptor_node = NULL;
+
+		goto on_error;
+	}
 	return( 1 );
+
+on_error:
+	if( local_descriptor_node != NULL )
+	{
+		libpff_local_descriptors_release_local_descriptor_node(
+		 local_descriptors,
+		 data_identifier,
+		 &local_descriptor_node,
+		 NULL );
+	}
+	return( -1 );
 }
 
 /* Reads the local descriptors node
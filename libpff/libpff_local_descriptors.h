@@ -61,10 +61,6 @@ struct libpff_local_descriptors
 	/* Value to indicate if the local descriptors were recovered
 	 */
 	uint8_t recovered;
-
-	/* The local descriptor nodes cache
-	 */
-	libfcache_cache_t *local_descriptor_nodes_cache;
 };
 
 int libpff_local_descriptors_initialize(
@@ -92,6 +88,23 @@ int libpff_local_descriptors_read_local_descriptor_node(
      libpff_local_descriptor_node_t **local_descriptor_node,
      libcerror_error_t **error );
 
+int libpff_local_descriptors_release_local_descriptor_node(
+     libpff_local_descriptors_t *local_descriptors,
+     uint64_t data_identifier,
+     libpff_local_descriptor_node_t **local_descriptor_node,
+     libcerror_error_t **error );
+
+int libpff_local_descriptors_has_cached_local_descriptor_node(
+     libpff_local_descriptors_t *local_descriptors,
+     uint64_t data_identifier,
+     libcerror_error_t **error );
+
+int libpff_local_descriptors_cache_local_descriptor_node(
+     libpff_local_descriptors_t *local_descriptors,
+     uint64_t data_identifier,
+     libpff_local_descriptor_node_t **local_descriptor_node,
+     libcerror_error_t **error );
+
 int libpff_local_descriptors_read_tree_node(
      libpff_local_descriptors_t *local_descriptors,
      libbfio_handle_t *file_io_handle,
@@ -267,6 +267,8 @@ enum LIBPFF_ENTRY_TYPES
 
 	LIBPFF_ENTRY_TYPE_MESSAGE_TRUST_SENDER					= 0x0e79,
 
+	LIBPFF_ENTRY_TYPE_RECORD_KEY						= 0x0ff9,
+
 	LIBPFF_ENTRY_TYPE_MESSAGE_BODY_PLAIN_TEXT				= 0x1000,
 
 	LIBPFF_ENTRY_TYPE_MESSAGE_BODY_COMPRESSED_RTF				= 0x1009,
@@ -39,6 +39,7 @@
 #include "libpff_item.h"
 #include "libpff_libuna.h"
 #include "libpff_record_entry.h"
+#include "libpff_rtf_decoder.h"
 #include "libpff_value_type.h"
 
 #define LIBPFF_MESSAGE_SUB_ITEM_ATTACHMENTS	0
@@ -3060,3 +3061,407 @@ on_error:
 	return( -1 );
 }
 
+/* Retrieves the body that is encapsulated in the compressed RTF message body
+ * The compressed RTF is de-encapsulated while it is being decompressed
+ * If message_body is NULL only the size is determined
+ * Size includes the end of string character
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libpff_message_get_rtf_encapsulated_body(
+     libpff_internal_item_t *internal_item,
+     uint8_t body_type,
+     uint8_t *message_body,
+     size_t *size,
+     libcerror_error_t **error )
+{
+	libpff_record_entry_t *record_entry = NULL;
+	libpff_rtf_decoder_t *rtf_decoder   = NULL;
+	uint8_t *value_data                 = NULL;
+	static char *function               = "libpff_message_get_rtf_encapsulated_body";
+	size_t value_data_size              = 0;
+	uint8_t encapsulated_body_type      = 0;
+	int result                          = 0;
+
+	if( internal_item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	result = libpff_item_values_get_record_entry_by_type(
+	          internal_item->item_values,
+	          internal_item->name_to_id_map_list,
+	          internal_item->io_handle,
+	          internal_item->file_io_handle,
+	          internal_item->offsets_index,
+	          0,
+		  LIBPFF_ENTRY_TYPE_MESSAGE_BODY_COMPRESSED_RTF,
+	          LIBPFF_VALUE_TYPE_BINARY_DATA,
+	          &record_entry,
+	          0,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve record entry.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( libpff_record_entry_get_value_data(
+		     record_entry,
+		     &value_data,
+		     &value_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve value data.",
+			 function );
+
+			goto on_error;
+		}
+		if( libpff_rtf_decoder_initialize(
+		     &rtf_decoder,
+		     internal_item->ascii_codepage,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create RTF decoder.",
+			 function );
+
+			goto on_error;
+		}
+		result = libpff_rtf_decoder_decode_compressed_data(
+		          rtf_decoder,
+		          value_data,
+		          value_data_size,
+		          message_body,
+		          *size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decode compressed RTF value data.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			if( libpff_rtf_decoder_get_body_type(
+			     rtf_decoder,
+			     &encapsulated_body_type,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve encapsulated body type.",
+				 function );
+
+				goto on_error;
+			}
+			if( encapsulated_body_type != body_type )
+			{
+				result = 0;
+			}
+		}
+		if( ( result != 0 )
+		 && ( message_body == NULL ) )
+		{
+			if( libpff_rtf_decoder_get_utf8_string_size(
+			     rtf_decoder,
+			     size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve encapsulated body size.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libpff_rtf_decoder_free(
+		     &rtf_decoder,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free RTF decoder.",
+			 function );
+
+			goto on_error;
+		}
+		if( libpff_record_entry_free(
+		     &record_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free record entry.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( result );
+
+on_error:
+	if( rtf_decoder != NULL )
+	{
+		libpff_rtf_decoder_free(
+		 &rtf_decoder,
+		 NULL );
+	}
+	if( record_entry != NULL )
+	{
+		libpff_record_entry_free(
+		 &record_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the HTML message body size from the compressed RTF message body
+ * Size includes the end of string character
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libpff_message_get_html_body_from_rtf_size(
+     libpff_item_t *message,
+     size_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_message_get_html_body_from_rtf_size";
+	int result            = 0;
+
+	if( message == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid message.",
+		 function );
+
+		return( -1 );
+	}
+	result = libpff_message_get_rtf_encapsulated_body(
+	          (libpff_internal_item_t *) message,
+	          LIBPFF_RTF_BODY_TYPE_HTML,
+	          NULL,
+	          size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve encapsulated HTML body size.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the HTML message body from the compressed RTF message body
+ * The HTML body is encapsulated in the RTF as described in [MS-OXRTFEX]
+ * The body is encoded in UTF-8
+ * Size should include the end of string character
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libpff_message_get_html_body_from_rtf(
+     libpff_item_t *message,
+     uint8_t *message_body,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_message_get_html_body_from_rtf";
+	int result            = 0;
+
+	if( message == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid message.",
+		 function );
+
+		return( -1 );
+	}
+	if( message_body == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid message body.",
+		 function );
+
+		return( -1 );
+	}
+	result = libpff_message_get_rtf_encapsulated_body(
+	          (libpff_internal_item_t *) message,
+	          LIBPFF_RTF_BODY_TYPE_HTML,
+	          message_body,
+	          &size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve encapsulated HTML body.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the plain text message body size from the compressed RTF message body
+ * Size includes the end of string character
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libpff_message_get_plain_text_body_from_rtf_size(
+     libpff_item_t *message,
+     size_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_message_get_plain_text_body_from_rtf_size";
+	int result            = 0;
+
+	if( message == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid message.",
+		 function );
+
+		return( -1 );
+	}
+	result = libpff_message_get_rtf_encapsulated_body(
+	          (libpff_internal_item_t *) message,
+	          LIBPFF_RTF_BODY_TYPE_PLAIN_TEXT,
+	          NULL,
+	          size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve encapsulated plain text body size.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the plain text message body from the compressed RTF message body
+ * The plain text body is encapsulated in the RTF as described in [MS-OXRTFEX]
+ * The body is encoded in UTF-8
+ * Size should include the end of string character
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libpff_message_get_plain_text_body_from_rtf(
+     libpff_item_t *message,
+     uint8_t *message_body,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_message_get_plain_text_body_from_rtf";
+	int result            = 0;
+
+	if( message == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid message.",
+		 function );
+
+		return( -1 );
+	}
+	if( message_body == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid message body.",
+		 function );
+
+		return( -1 );
+	}
+	result = libpff_message_get_rtf_encapsulated_body(
+	          (libpff_internal_item_t *) message,
+	          LIBPFF_RTF_BODY_TYPE_PLAIN_TEXT,
+	          message_body,
+	          &size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve encapsulated plain text body.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
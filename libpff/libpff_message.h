@@ -177,6 +177,39 @@ int libpff_message_get_html_body(
      size_t size,
      libcerror_error_t **error );
 
+int libpff_message_get_rtf_encapsulated_body(
+     libpff_internal_item_t *internal_item,
+     uint8_t body_type,
+     uint8_t *message_body,
+     size_t *size,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_message_get_html_body_from_rtf_size(
+     libpff_item_t *message,
+     size_t *size,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_message_get_html_body_from_rtf(
+     libpff_item_t *message,
+     uint8_t *message_body,
+     size_t size,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_message_get_plain_text_body_from_rtf_size(
+     libpff_item_t *message,
+     size_t *size,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_message_get_plain_text_body_from_rtf(
+     libpff_item_t *message,
+     uint8_t *message_body,
+     size_t size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -32,6 +32,7 @@
 #include "libpff_index_tree.h"
 #include "libpff_index_value.h"
 #include "libpff_offsets_index.h"
+#include "libpff_recovered_index.h"
 
 /* Creates an offsets index
  * Make sure the value offsets_index is referencing, is set to NULL
@@ -163,17 +164,17 @@ int libpff_offsets_index_free(
 				result = -1;
 			}
 		}
-		if( ( *offsets_index )->recovered_index_tree != NULL )
+		if( ( *offsets_index )->recovered_index != NULL )
 		{
-			if( libpff_index_tree_free(
-			     &( ( *offsets_index )->recovered_index_tree ),
+			if( libpff_recovered_index_free(
+			     &( ( *offsets_index )->recovered_index ),
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free recovered index tree.",
+				 "%s: unable to free recovered index.",
 				 function );
 
 				result = -1;
@@ -268,39 +269,16 @@ int libpff_offsets_index_set_root_node(
 	}
 	else
 	{
-		if( libpff_index_tree_initialize(
-		     &( offsets_index->recovered_index_tree ),
-		     offsets_index->io_handle,
-		     offsets_index->index_nodes_vector,
-		     offsets_index->index_nodes_cache,
+		if( libpff_recovered_index_initialize(
+		     &( offsets_index->recovered_index ),
 		     LIBPFF_INDEX_TYPE_OFFSET,
-		     0,
-		     0,
-		     recovered,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create index tree.",
-			 function );
-
-			goto on_error;
-		}
-		/* Point the root node data offset to LIBPFF_RECOVERED_OFFSETS_INDEX_TREE_ROOT_OFFSET
-		 * otherwise it will mess up the caching of the first index value
-		 */
-		if( libpff_index_tree_set_root_node(
-		     offsets_index->recovered_index_tree,
-		     LIBPFF_RECOVERED_OFFSETS_INDEX_TREE_ROOT_OFFSET,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set recovered index tree root node.",
+			 "%s: unable to create recovered index.",
 			 function );
 
 			goto on_error;
@@ -337,16 +315,81 @@ on_error:
 	}
 	else
 	{
-		if( offsets_index->recovered_index_tree != NULL )
+		if( offsets_index->recovered_index != NULL )
 		{
-			libpff_index_tree_free(
-			 &( offsets_index->recovered_index_tree ),
+			libpff_recovered_index_free(
+			 &( offsets_index->recovered_index ),
 			 NULL );
 		}
 	}
 	return( -1 );
 }
 
+/* Swaps the root node with that of another offsets index
+ * The index tree, the cached index values and the recovered index are swapped,
+ * the index nodes vector and cache are shared. This allows to replace the root
+ * node of an index that is referenced elsewhere, at a point where nothing can fail
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_offsets_index_swap_root_node(
+     libpff_offsets_index_t *offsets_index,
+     libpff_offsets_index_t *other_offsets_index,
+     libcerror_error_t **error )
+{
+	libfcache_cache_t *index_cache            = NULL;
+	libpff_index_tree_t *index_tree           = NULL;
+	libpff_recovered_index_t *recovered_index = NULL;
+	static char *function                     = "libpff_offsets_index_swap_root_node";
+
+	if( offsets_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offsets index.",
+		 function );
+
+		return( -1 );
+	}
+	if( other_offsets_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid other offsets index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offsets_index->index_nodes_vector != other_offsets_index->index_nodes_vector )
+	 || ( offsets_index->index_nodes_cache != other_offsets_index->index_nodes_cache ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid other offsets index - index nodes vector and cache are not shared.",
+		 function );
+
+		return( -1 );
+	}
+	index_tree                      = offsets_index->index_tree;
+	offsets_index->index_tree       = other_offsets_index->index_tree;
+	other_offsets_index->index_tree = index_tree;
+
+	recovered_index                      = offsets_index->recovered_index;
+	offsets_index->recovered_index       = other_offsets_index->recovered_index;
+	other_offsets_index->recovered_index = recovered_index;
+
+	index_cache                      = offsets_index->index_cache;
+	offsets_index->index_cache       = other_offsets_index->index_cache;
+	other_offsets_index->index_cache = index_cache;
+
+	return( 1 );
+}
+
 /* Retrieves an index value for a specific identifier
  * Returns 1 if successful, 0 if no index value was found or -1 on error
  */
@@ -400,10 +443,8 @@ int libpff_offsets_index_get_index_value_by_identifier(
 	}
 	else
 	{
-		if( libpff_index_tree_get_number_of_leaf_nodes_by_identifier(
-		     offsets_index->recovered_index_tree,
-		     file_io_handle,
-		     offsets_index->index_cache,
+		if( libpff_recovered_index_get_number_of_index_values_by_identifier(
+		     offsets_index->recovered_index,
 		     data_identifier & (uint64_t) LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK,
 		     &number_of_index_values,
 		     error ) != 1 )
@@ -442,10 +483,8 @@ int libpff_offsets_index_get_index_value_by_identifier(
 
 			return( -1 );
 		}
-		result = libpff_index_tree_get_value_by_identifier(
-			  offsets_index->recovered_index_tree,
-			  file_io_handle,
-			  offsets_index->index_cache,
+		result = libpff_recovered_index_get_index_value_by_identifier(
+			  offsets_index->recovered_index,
 			  data_identifier & (uint64_t) LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK,
 			  recovered_value_index,
 			  index_value,
@@ -467,3 +506,213 @@ int libpff_offsets_index_get_index_value_by_identifier(
 	return( result );
 }
 
+/* Retrieves the index values for specific identifiers
+ * The identifiers are looked up in ascending order so that the index nodes
+ * read for an identifier are reused from the index cache for the next one
+ * The index values are copied since a subsequent look up can evict
+ * a previously retrieved index value from the index cache
+ * Returns 1 if successful, 0 if an index value was not found or -1 on error
+ */
+int libpff_offsets_index_get_index_values_by_identifiers(
+     libpff_offsets_index_t *offsets_index,
+     libbfio_handle_t *file_io_handle,
+     const uint64_t *data_identifiers,
+     int number_of_data_identifiers,
+     uint8_t recovered,
+     const int *recovered_value_indexes,
+     libpff_index_value_t *index_values,
+     libcerror_error_t **error )
+{
+	int lookup_order[ LIBPFF_MAXIMUM_NUMBER_OF_BATCHED_INDEX_VALUES ];
+
+	libpff_index_value_t *index_value = NULL;
+	static char *function             = "libpff_offsets_index_get_index_values_by_identifiers";
+	int identifier_index              = 0;
+	int lookup_index                  = 0;
+	int order_index                   = 0;
+	int recovered_value_index         = 0;
+	int result                        = 0;
+
+	if( offsets_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offsets index.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_identifiers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data identifiers.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_data_identifiers <= 0 )
+	 || ( number_of_data_identifiers > LIBPFF_MAXIMUM_NUMBER_OF_BATCHED_INDEX_VALUES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of data identifiers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index values.",
+		 function );
+
+		return( -1 );
+	}
+	/* Sort the identifiers using an insertion sort since there are only a few
+	 */
+	for( identifier_index = 0;
+	     identifier_index < number_of_data_identifiers;
+	     identifier_index++ )
+	{
+		order_index = identifier_index;
+
+		while( ( order_index > 0 )
+		    && ( ( data_identifiers[ lookup_order[ order_index - 1 ] ] & (uint64_t) LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK )
+		       > ( data_identifiers[ identifier_index ] & (uint64_t) LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK ) ) )
+		{
+			lookup_order[ order_index ] = lookup_order[ order_index - 1 ];
+
+			order_index--;
+		}
+		lookup_order[ order_index ] = identifier_index;
+	}
+	for( lookup_index = 0;
+	     lookup_index < number_of_data_identifiers;
+	     lookup_index++ )
+	{
+		identifier_index = lookup_order[ lookup_index ];
+
+		if( recovered_value_indexes != NULL )
+		{
+			recovered_value_index = recovered_value_indexes[ identifier_index ];
+		}
+		index_value = NULL;
+
+		result = libpff_offsets_index_get_index_value_by_identifier(
+		          offsets_index,
+		          file_io_handle,
+		          data_identifiers[ identifier_index ],
+		          recovered,
+		          recovered_value_index,
+		          &index_value,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to find offsets index value identifier: %" PRIu64 ".",
+			 function,
+			 data_identifiers[ identifier_index ] );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+		if( index_value == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing offsets index value: %" PRIu64 ".",
+			 function,
+			 data_identifiers[ identifier_index ] );
+
+			return( -1 );
+		}
+		if( memory_copy(
+		     &( index_values[ identifier_index ] ),
+		     index_value,
+		     sizeof( libpff_index_value_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy offsets index value: %" PRIu64 ".",
+			 function,
+			 data_identifiers[ identifier_index ] );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Prefetches the upper levels of the offsets index
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_offsets_index_prefetch(
+     libpff_offsets_index_t *offsets_index,
+     libbfio_handle_t *file_io_handle,
+     int maximum_depth,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_offsets_index_prefetch";
+
+	if( offsets_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offsets index.",
+		 function );
+
+		return( -1 );
+	}
+	if( offsets_index->index_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid offsets index - missing index tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_index_tree_prefetch(
+	     offsets_index->index_tree,
+	     file_io_handle,
+	     offsets_index->index_cache,
+	     maximum_depth,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to prefetch index tree.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
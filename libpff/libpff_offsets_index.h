@@ -32,6 +32,7 @@
 #include "libpff_libfcache.h"
 #include "libpff_libfdata.h"
 #include "libpff_index_value.h"
+#include "libpff_recovered_index.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -57,9 +58,9 @@ struct libpff_offsets_index
 	 */
 	libpff_index_tree_t *index_tree;
 
-	/* The recovered index tree
+	/* The recovered index
 	 */
-	libpff_index_tree_t *recovered_index_tree;
+	libpff_recovered_index_t *recovered_index;
 
 	/* The index cache
 	 */
@@ -84,6 +85,11 @@ int libpff_offsets_index_set_root_node(
      uint8_t recovered,
      libcerror_error_t **error );
 
+int libpff_offsets_index_swap_root_node(
+     libpff_offsets_index_t *offsets_index,
+     libpff_offsets_index_t *other_offsets_index,
+     libcerror_error_t **error );
+
 int libpff_offsets_index_get_index_value_by_identifier(
      libpff_offsets_index_t *offsets_index,
      libbfio_handle_t *file_io_handle,
@@ -93,6 +99,22 @@ int libpff_offsets_index_get_index_value_by_identifier(
      libpff_index_value_t **index_value,
      libcerror_error_t **error );
 
+int libpff_offsets_index_get_index_values_by_identifiers(
+     libpff_offsets_index_t *offsets_index,
+     libbfio_handle_t *file_io_handle,
+     const uint64_t *data_identifiers,
+     int number_of_data_identifiers,
+     uint8_t recovered,
+     const int *recovered_value_indexes,
+     libpff_index_value_t *index_values,
+     libcerror_error_t **error );
+
+int libpff_offsets_index_prefetch(
+     libpff_offsets_index_t *offsets_index,
+     libbfio_handle_t *file_io_handle,
+     int maximum_depth,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
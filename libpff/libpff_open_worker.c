@@ -0,0 +1,670 @@
+/*
+ * Open worker functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libpff_definitions.h"
+#include "libpff_file_header.h"
+#include "libpff_index_tree.h"
+#include "libpff_index_value.h"
+#include "libpff_io_handle.h"
+#include "libpff_libbfio.h"
+#include "libpff_libcdata.h"
+#include "libpff_libcerror.h"
+#include "libpff_libcnotify.h"
+#include "libpff_libcthreads.h"
+#include "libpff_libfdata.h"
+#include "libpff_item_tree.h"
+#include "libpff_name_to_id_map.h"
+#include "libpff_offsets_index.h"
+#include "libpff_open_worker.h"
+#include "libpff_reader_context.h"
+
+/* Creates an open worker
+ * Make sure the value open_worker is referencing, is set to NULL
+ * The name to ID map is only read when name_to_id_map_list is set
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_open_worker_initialize(
+     libpff_open_worker_t **open_worker,
+     libpff_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libpff_file_header_t *file_header,
+     size_t index_node_size,
+     libcdata_list_t *name_to_id_map_list,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_open_worker_initialize";
+
+	if( open_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid open worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( *open_worker != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid open worker value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*open_worker = memory_allocate_structure(
+	                libpff_open_worker_t );
+
+	if( *open_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create open worker.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *open_worker,
+	     0,
+	     sizeof( libpff_open_worker_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear open worker.",
+		 function );
+
+		memory_free(
+		 *open_worker );
+
+		*open_worker = NULL;
+
+		return( -1 );
+	}
+	if( libpff_reader_context_initialize(
+	     &( ( *open_worker )->reader_context ),
+	     io_handle,
+	     file_io_handle,
+	     file_header,
+	     index_node_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create reader context.",
+		 function );
+
+		goto on_error;
+	}
+	( *open_worker )->name_to_id_map_list = name_to_id_map_list;
+
+	return( 1 );
+
+on_error:
+	if( *open_worker != NULL )
+	{
+		libpff_open_worker_free(
+		 open_worker,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees an open worker
+ * Waits for the worker thread to finish if it is still running
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_open_worker_free(
+     libpff_open_worker_t **open_worker,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_open_worker_free";
+	int result            = 1;
+
+	if( open_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid open worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( *open_worker != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *open_worker )->thread != NULL )
+		{
+			if( libcthreads_thread_join(
+			     &( ( *open_worker )->thread ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		if( ( *open_worker )->read_error != NULL )
+		{
+			libcerror_error_free(
+			 &( ( *open_worker )->read_error ) );
+		}
+		if( ( *open_worker )->index_values_array != NULL )
+		{
+			if( libcdata_array_free(
+			     &( ( *open_worker )->index_values_array ),
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_index_value_free,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free index values array.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *open_worker )->reader_context != NULL )
+		{
+			if( libpff_reader_context_free(
+			     &( ( *open_worker )->reader_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free reader context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *open_worker );
+
+		*open_worker = NULL;
+	}
+	return( result );
+}
+
+/* Sets the range of descriptors index root sub nodes the open worker reads
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_open_worker_set_descriptors_shard(
+     libpff_open_worker_t *open_worker,
+     int first_sub_node_index,
+     int number_of_sub_nodes,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_open_worker_set_descriptors_shard";
+
+	if( open_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid open worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( open_worker->index_values_array != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid open worker - index values array value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_sub_node_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid first sub node index value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_sub_nodes <= 0 )
+	 || ( number_of_sub_nodes > ( INT_MAX - first_sub_node_index ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of sub nodes value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( open_worker->index_values_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create index values array.",
+		 function );
+
+		return( -1 );
+	}
+	open_worker->first_sub_node_index = first_sub_node_index;
+	open_worker->number_of_sub_nodes  = number_of_sub_nodes;
+
+	return( 1 );
+}
+
+/* Reads the descriptor index values of the shard of the open worker
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_open_worker_read_descriptors_shard(
+     libpff_open_worker_t *open_worker,
+     libcerror_error_t **error )
+{
+	libfdata_tree_node_t *descriptor_index_tree_root_node = NULL;
+	libfdata_tree_node_t *descriptor_index_tree_sub_node  = NULL;
+	static char *function                                 = "libpff_open_worker_read_descriptors_shard";
+	int sub_node_index                                    = 0;
+
+	if( open_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid open worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( open_worker->reader_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid open worker - missing reader context.",
+		 function );
+
+		return( -1 );
+	}
+	if( open_worker->reader_context->descriptors_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid open worker - invalid reader context - missing descriptors index.",
+		 function );
+
+		return( -1 );
+	}
+	if( open_worker->index_values_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid open worker - missing index values array.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_index_tree_get_root_node(
+	     open_worker->reader_context->descriptors_index->index_tree,
+	     &descriptor_index_tree_root_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve descriptor index tree root node.",
+		 function );
+
+		return( -1 );
+	}
+	for( sub_node_index = open_worker->first_sub_node_index;
+	     sub_node_index < ( open_worker->first_sub_node_index + open_worker->number_of_sub_nodes );
+	     sub_node_index++ )
+	{
+		if( libfdata_tree_node_get_sub_node_by_index(
+		     descriptor_index_tree_root_node,
+		     (intptr_t *) open_worker->reader_context->file_io_handle,
+		     (libfdata_cache_t *) open_worker->reader_context->descriptors_index->index_cache,
+		     sub_node_index,
+		     &descriptor_index_tree_sub_node,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub node: %d from descriptor index tree root node.",
+			 function,
+			 sub_node_index );
+
+			return( -1 );
+		}
+		if( libpff_item_tree_read_index_values(
+		     open_worker->reader_context->file_io_handle,
+		     descriptor_index_tree_sub_node,
+		     open_worker->reader_context->descriptors_index->index_cache,
+		     open_worker->index_values_array,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read index values of descriptor index tree sub node: %d.",
+			 function,
+			 sub_node_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Reads the name to ID map and prefetches the upper levels of the offsets index
+ * or reads the shard of the descriptors index
+ * Prefetching is best effort and does not cause the read to fail
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_open_worker_read(
+     libpff_open_worker_t *open_worker,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_open_worker_read";
+
+	if( open_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid open worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( open_worker->reader_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid open worker - missing reader context.",
+		 function );
+
+		return( -1 );
+	}
+	if( open_worker->index_values_array != NULL )
+	{
+		if( libpff_open_worker_read_descriptors_shard(
+		     open_worker,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read descriptors shard.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( open_worker->name_to_id_map_list != NULL )
+	{
+		open_worker->name_to_id_map_result = libpff_name_to_id_map_read(
+		                                      open_worker->name_to_id_map_list,
+		                                      open_worker->reader_context->io_handle,
+		                                      open_worker->reader_context->file_io_handle,
+		                                      open_worker->reader_context->descriptors_index,
+		                                      open_worker->reader_context->offsets_index,
+		                                      error );
+
+		if( open_worker->name_to_id_map_result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read name to id map.",
+			 function );
+
+			return( -1 );
+		}
+		/* The prefetched index nodes are not shared with the file, reading them
+		 * warms the operating system page cache for the item reads that follow
+		 */
+		if( libpff_offsets_index_prefetch(
+		     open_worker->reader_context->offsets_index,
+		     open_worker->reader_context->file_io_handle,
+		     LIBPFF_OFFSETS_INDEX_PREFETCH_DEPTH,
+		     error ) != 1 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( ( libcnotify_verbose != 0 )
+			 && ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+#endif
+			libcerror_error_free(
+			 error );
+		}
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Callback function of the open worker thread
+ * The outcome of the read is stored in the open worker
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_open_worker_thread_function(
+     libpff_open_worker_t *open_worker )
+{
+	if( open_worker == NULL )
+	{
+		return( -1 );
+	}
+	open_worker->read_result = libpff_open_worker_read(
+	                            open_worker,
+	                            &( open_worker->read_error ) );
+
+	return( 1 );
+}
+
+/* Starts reading on a separate thread
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_open_worker_start(
+     libpff_open_worker_t *open_worker,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_open_worker_start";
+
+	if( open_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid open worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( open_worker->thread != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid open worker - thread value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_thread_create(
+	     &( open_worker->thread ),
+	     NULL,
+	     (int (*)(void *)) &libpff_open_worker_thread_function,
+	     (void *) open_worker,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Waits for the thread to finish and merges its read state into the file
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_open_worker_join(
+     libpff_open_worker_t *open_worker,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_open_worker_join";
+
+	if( open_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid open worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( open_worker->thread == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid open worker - missing thread.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_thread_join(
+	     &( open_worker->thread ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join thread.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_reader_context_merge_read_state(
+	     open_worker->reader_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to merge read state.",
+		 function );
+
+		return( -1 );
+	}
+	if( open_worker->read_result != 1 )
+	{
+		/* Hand the error of the thread to the caller
+		 */
+		if( ( error != NULL )
+		 && ( *error == NULL ) )
+		{
+			*error = open_worker->read_error;
+
+			open_worker->read_error = NULL;
+		}
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read on thread.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,135 @@
+/*
+ * Open worker functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPFF_OPEN_WORKER_H )
+#define _LIBPFF_OPEN_WORKER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libpff_file_header.h"
+#include "libpff_io_handle.h"
+#include "libpff_libbfio.h"
+#include "libpff_libcdata.h"
+#include "libpff_libcerror.h"
+#include "libpff_libcthreads.h"
+#include "libpff_reader_context.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libpff_open_worker libpff_open_worker_t;
+
+/* The open worker reads the name to ID map and prefetches the offsets index
+ * while the item tree is created, or reads a shard of the descriptors index.
+ * It reads using its own reader context, so nothing it reads is shared with
+ * the calling thread except the name to ID map list
+ */
+struct libpff_open_worker
+{
+	/* The reader context
+	 */
+	libpff_reader_context_t *reader_context;
+
+	/* The name to ID map list, owned by the file
+	 */
+	libcdata_list_t *name_to_id_map_list;
+
+	/* The result of reading the name to ID map
+	 */
+	int name_to_id_map_result;
+
+	/* The index of the first descriptors index root sub node of the shard
+	 */
+	int first_sub_node_index;
+
+	/* The number of descriptors index root sub nodes of the shard
+	 */
+	int number_of_sub_nodes;
+
+	/* The descriptor index values read from the shard
+	 */
+	libcdata_array_t *index_values_array;
+
+	/* The result of the read
+	 */
+	int read_result;
+
+	/* The error of the read
+	 */
+	libcerror_error_t *read_error;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The thread
+	 */
+	libcthreads_thread_t *thread;
+#endif
+};
+
+int libpff_open_worker_initialize(
+     libpff_open_worker_t **open_worker,
+     libpff_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libpff_file_header_t *file_header,
+     size_t index_node_size,
+     libcdata_list_t *name_to_id_map_list,
+     libcerror_error_t **error );
+
+int libpff_open_worker_free(
+     libpff_open_worker_t **open_worker,
+     libcerror_error_t **error );
+
+int libpff_open_worker_set_descriptors_shard(
+     libpff_open_worker_t *open_worker,
+     int first_sub_node_index,
+     int number_of_sub_nodes,
+     libcerror_error_t **error );
+
+int libpff_open_worker_read_descriptors_shard(
+     libpff_open_worker_t *open_worker,
+     libcerror_error_t **error );
+
+int libpff_open_worker_read(
+     libpff_open_worker_t *open_worker,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int libpff_open_worker_thread_function(
+     libpff_open_worker_t *open_worker );
+
+int libpff_open_worker_start(
+     libpff_open_worker_t *open_worker,
+     libcerror_error_t **error );
+
+int libpff_open_worker_join(
+     libpff_open_worker_t *open_worker,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPFF_OPEN_WORKER_H ) */
+
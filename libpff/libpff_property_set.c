@@ -0,0 +1,1420 @@
+/*
+ * Property set functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libpff_definitions.h"
+#include "libpff_libcdata.h"
+#include "libpff_libcerror.h"
+#include "libpff_libuna.h"
+#include "libpff_name_to_id_map.h"
+#include "libpff_property_set.h"
+#include "libpff_record_entry.h"
+#include "libpff_record_entry_identifier.h"
+#include "libpff_types.h"
+
+/* Creates a property set
+ * Make sure the value property_set is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_property_set_initialize(
+     libpff_property_set_t **property_set,
+     libcerror_error_t **error )
+{
+	libpff_internal_property_set_t *internal_property_set = NULL;
+	static char *function                                 = "libpff_property_set_initialize";
+
+	if( property_set == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid property set.",
+		 function );
+
+		return( -1 );
+	}
+	if( *property_set != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid property set value already set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_property_set = memory_allocate_structure(
+	                         libpff_internal_property_set_t );
+
+	if( internal_property_set == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create property set.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_property_set,
+	     0,
+	     sizeof( libpff_internal_property_set_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear property set.",
+		 function );
+
+		memory_free(
+		 internal_property_set );
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( internal_property_set->requests_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create requests array.",
+		 function );
+
+		goto on_error;
+	}
+	*property_set = (libpff_property_set_t *) internal_property_set;
+
+	return( 1 );
+
+on_error:
+	if( internal_property_set != NULL )
+	{
+		memory_free(
+		 internal_property_set );
+	}
+	return( -1 );
+}
+
+/* Frees a property set
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_property_set_free(
+     libpff_property_set_t **property_set,
+     libcerror_error_t **error )
+{
+	libpff_internal_property_set_t *internal_property_set = NULL;
+	static char *function                                 = "libpff_property_set_free";
+	int result                                            = 1;
+
+	if( property_set == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid property set.",
+		 function );
+
+		return( -1 );
+	}
+	if( *property_set != NULL )
+	{
+		internal_property_set = (libpff_internal_property_set_t *) *property_set;
+		*property_set         = NULL;
+
+		if( libcdata_array_free(
+		     &( internal_property_set->requests_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_property_set_request_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free requests array.",
+			 function );
+
+			result = -1;
+		}
+		if( internal_property_set->lookup_entries != NULL )
+		{
+			memory_free(
+			 internal_property_set->lookup_entries );
+		}
+		memory_free(
+		 internal_property_set );
+	}
+	return( result );
+}
+
+/* Frees a property set request
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_property_set_request_free(
+     libpff_property_set_request_t **request,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_property_set_request_free";
+
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid request.",
+		 function );
+
+		return( -1 );
+	}
+	if( *request != NULL )
+	{
+		if( ( *request )->utf8_string != NULL )
+		{
+			memory_free(
+			 ( *request )->utf8_string );
+		}
+		memory_free(
+		 *request );
+
+		*request = NULL;
+	}
+	return( 1 );
+}
+
+/* Appends a request to the property set
+ * Appending a request invalidates a previous preparation of the property set
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_internal_property_set_append_request(
+     libpff_internal_property_set_t *internal_property_set,
+     libpff_property_set_request_t *request,
+     int *request_index,
+     libcerror_error_t **error )
+{
+	static char *function  = "libpff_internal_property_set_append_request";
+	int safe_request_index = 0;
+
+	if( internal_property_set == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid property set.",
+		 function );
+
+		return( -1 );
+	}
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid request.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_append_entry(
+	     internal_property_set->requests_array,
+	     &safe_request_index,
+	     (intptr_t *) request,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append request to array.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_property_set->lookup_entries != NULL )
+	{
+		memory_free(
+		 internal_property_set->lookup_entries );
+
+		internal_property_set->lookup_entries = NULL;
+	}
+	internal_property_set->number_of_lookup_entries  = 0;
+	internal_property_set->io_handle                 = NULL;
+	internal_property_set->name_to_id_map_generation = 0;
+	internal_property_set->is_prepared               = 0;
+
+	if( request_index != NULL )
+	{
+		*request_index = safe_request_index;
+	}
+	return( 1 );
+}
+
+/* Appends a request for a property by its entry type
+ * The entry type is matched the same as by libpff_record_set_get_entry_by_type
+ * and the flags LIBPFF_ENTRY_VALUE_FLAG_MATCH_ANY_VALUE_TYPE and
+ * LIBPFF_ENTRY_VALUE_FLAG_IGNORE_NAME_TO_ID_MAP are supported
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_property_set_append_entry_type(
+     libpff_property_set_t *property_set,
+     uint32_t entry_type,
+     uint32_t value_type,
+     uint8_t flags,
+     int *request_index,
+     libcerror_error_t **error )
+{
+	libpff_property_set_request_t *request = NULL;
+	static char *function                  = "libpff_property_set_append_entry_type";
+
+	if( property_set == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid property set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( flags & ~( LIBPFF_ENTRY_VALUE_FLAG_MATCH_ANY_VALUE_TYPE | LIBPFF_ENTRY_VALUE_FLAG_IGNORE_NAME_TO_ID_MAP ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported flags: 0x%02" PRIx8 ".",
+		 function,
+		 flags );
+
+		return( -1 );
+	}
+	request = memory_allocate_structure(
+	           libpff_property_set_request_t );
+
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create request.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     request,
+	     0,
+	     sizeof( libpff_property_set_request_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear request.",
+		 function );
+
+		goto on_error;
+	}
+	request->type       = LIBPFF_PROPERTY_SET_REQUEST_TYPE_ENTRY_TYPE;
+	request->entry_type = entry_type;
+	request->value_type = value_type;
+	request->flags      = flags;
+
+	if( libpff_internal_property_set_append_request(
+	     (libpff_internal_property_set_t *) property_set,
+	     request,
+	     request_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append request.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( request != NULL )
+	{
+		memory_free(
+		 request );
+	}
+	return( -1 );
+}
+
+/* Appends a request for a named property by its property set GUID and number
+ * The GUID is stored in the same byte order as returned by libpff_name_to_id_map_entry_get_guid
+ * The flag LIBPFF_ENTRY_VALUE_FLAG_MATCH_ANY_VALUE_TYPE is supported
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_property_set_append_numeric_name(
+     libpff_property_set_t *property_set,
+     const uint8_t *guid,
+     size_t guid_size,
+     uint32_t number,
+     uint32_t value_type,
+     uint8_t flags,
+     int *request_index,
+     libcerror_error_t **error )
+{
+	libpff_property_set_request_t *request = NULL;
+	static char *function                  = "libpff_property_set_append_numeric_name";
+
+	if( property_set == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid property set.",
+		 function );
+
+		return( -1 );
+	}
+	if( guid == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid GUID.",
+		 function );
+
+		return( -1 );
+	}
+	if( guid_size < 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid GUID size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( flags & ~( LIBPFF_ENTRY_VALUE_FLAG_MATCH_ANY_VALUE_TYPE ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported flags: 0x%02" PRIx8 ".",
+		 function,
+		 flags );
+
+		return( -1 );
+	}
+	request = memory_allocate_structure(
+	           libpff_property_set_request_t );
+
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create request.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     request,
+	     0,
+	     sizeof( libpff_property_set_request_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear request.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     request->guid,
+	     guid,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy GUID.",
+		 function );
+
+		goto on_error;
+	}
+	request->type       = LIBPFF_PROPERTY_SET_REQUEST_TYPE_NUMERIC_NAME;
+	request->entry_type = number;
+	request->value_type = value_type;
+	request->flags      = flags;
+
+	if( libpff_internal_property_set_append_request(
+	     (libpff_internal_property_set_t *) property_set,
+	     request,
+	     request_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append request.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( request != NULL )
+	{
+		memory_free(
+		 request );
+	}
+	return( -1 );
+}
+
+/* Appends a request for a named property by its property set GUID and UTF-8 encoded name
+ * The GUID is stored in the same byte order as returned by libpff_name_to_id_map_entry_get_guid
+ * The flag LIBPFF_ENTRY_VALUE_FLAG_MATCH_ANY_VALUE_TYPE is supported
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_property_set_append_utf8_name(
+     libpff_property_set_t *property_set,
+     const uint8_t *guid,
+     size_t guid_size,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     uint32_t value_type,
+     uint8_t flags,
+     int *request_index,
+     libcerror_error_t **error )
+{
+	libpff_property_set_request_t *request = NULL;
+	static char *function                  = "libpff_property_set_append_utf8_name";
+
+	if( property_set == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid property set.",
+		 function );
+
+		return( -1 );
+	}
+	if( guid == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid GUID.",
+		 function );
+
+		return( -1 );
+	}
+	if( guid_size < 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid GUID size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( utf8_string_length == 0 )
+	 || ( utf8_string_length > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid UTF-8 string length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( flags & ~( LIBPFF_ENTRY_VALUE_FLAG_MATCH_ANY_VALUE_TYPE ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported flags: 0x%02" PRIx8 ".",
+		 function,
+		 flags );
+
+		return( -1 );
+	}
+	request = memory_allocate_structure(
+	           libpff_property_set_request_t );
+
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create request.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     request,
+	     0,
+	     sizeof( libpff_property_set_request_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear request.",
+		 function );
+
+		memory_free(
+		 request );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     request->guid,
+	     guid,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy GUID.",
+		 function );
+
+		goto on_error;
+	}
+	request->utf8_string_size = utf8_string_length + 1;
+
+	request->utf8_string = (uint8_t *) memory_allocate(
+	                                    sizeof( uint8_t ) * request->utf8_string_size );
+
+	if( request->utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create UTF-8 string.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     request->utf8_string,
+	     utf8_string,
+	     utf8_string_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy UTF-8 string.",
+		 function );
+
+		goto on_error;
+	}
+	request->utf8_string[ utf8_string_length ] = 0;
+
+	request->type       = LIBPFF_PROPERTY_SET_REQUEST_TYPE_STRING_NAME;
+	request->value_type = value_type;
+	request->flags      = flags;
+
+	if( libpff_internal_property_set_append_request(
+	     (libpff_internal_property_set_t *) property_set,
+	     request,
+	     request_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append request.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( request != NULL )
+	{
+		libpff_property_set_request_free(
+		 &request,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the number of requests
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_property_set_get_number_of_requests(
+     libpff_property_set_t *property_set,
+     int *number_of_requests,
+     libcerror_error_t **error )
+{
+	libpff_internal_property_set_t *internal_property_set = NULL;
+	static char *function                                 = "libpff_property_set_get_number_of_requests";
+
+	if( property_set == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid property set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_property_set = (libpff_internal_property_set_t *) property_set;
+
+	if( libcdata_array_get_number_of_entries(
+	     internal_property_set->requests_array,
+	     number_of_requests,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of requests.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Determines if the property set was prepared
+ * Returns 1 if prepared, 0 if not or -1 on error
+ */
+int libpff_property_set_is_prepared(
+     libpff_property_set_t *property_set,
+     libcerror_error_t **error )
+{
+	libpff_internal_property_set_t *internal_property_set = NULL;
+	static char *function                                 = "libpff_property_set_is_prepared";
+
+	if( property_set == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid property set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_property_set = (libpff_internal_property_set_t *) property_set;
+
+	return( (int) internal_property_set->is_prepared );
+}
+
+/* Determines if a named property request matches a name to ID map entry
+ * Returns 1 if match, 0 if not or -1 on error
+ */
+int libpff_property_set_request_matches_name_to_id_map_entry(
+     libpff_property_set_request_t *request,
+     libpff_internal_name_to_id_map_entry_t *name_to_id_map_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_property_set_request_matches_name_to_id_map_entry";
+	int result            = 0;
+
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid request.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_to_id_map_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name to id map entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_compare(
+	     request->guid,
+	     name_to_id_map_entry->guid,
+	     16 ) != 0 )
+	{
+		return( 0 );
+	}
+	if( request->type == LIBPFF_PROPERTY_SET_REQUEST_TYPE_NUMERIC_NAME )
+	{
+		if( name_to_id_map_entry->type != LIBPFF_NAME_TO_ID_MAP_ENTRY_TYPE_NUMERIC )
+		{
+			return( 0 );
+		}
+		if( name_to_id_map_entry->numeric_value != request->entry_type )
+		{
+			return( 0 );
+		}
+		return( 1 );
+	}
+	if( request->type != LIBPFF_PROPERTY_SET_REQUEST_TYPE_STRING_NAME )
+	{
+		return( 0 );
+	}
+	if( name_to_id_map_entry->type != LIBPFF_NAME_TO_ID_MAP_ENTRY_TYPE_STRING )
+	{
+		return( 0 );
+	}
+	if( name_to_id_map_entry->is_ascii_string == 0 )
+	{
+		result = libuna_utf8_string_compare_with_utf16_stream(
+		          request->utf8_string,
+		          request->utf8_string_size,
+		          name_to_id_map_entry->string_value,
+		          name_to_id_map_entry->value_size,
+		          LIBPFF_ENDIAN_LITTLE,
+		          error );
+	}
+	else
+	{
+		result = libuna_utf8_string_compare_with_byte_stream(
+		          request->utf8_string,
+		          request->utf8_string_size,
+		          name_to_id_map_entry->string_value,
+		          name_to_id_map_entry->value_size,
+		          LIBUNA_CODEPAGE_ASCII,
+		          error );
+	}
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to compare UTF-8 string with name to id map entry.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Prepares the property set against a name to ID map
+ * The named property requests are resolved to the entry type they are stored
+ * with once, after which all requests are looked up by entry type
+ * Named property requests that cannot be resolved never match a record entry
+ * The property set is bound to the IO handle of the file and the generation
+ * of its name to ID map, the IO handle can be NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_property_set_prepare(
+     libpff_property_set_t *property_set,
+     libpff_io_handle_t *io_handle,
+     libcdata_list_t *name_to_id_map_list,
+     libcerror_error_t **error )
+{
+	libcdata_list_element_t *list_element                          = NULL;
+	libpff_internal_name_to_id_map_entry_t *name_to_id_map_entry   = NULL;
+	libpff_internal_property_set_t *internal_property_set          = NULL;
+	libpff_property_set_lookup_entry_t *lookup_entries             = NULL;
+	libpff_property_set_lookup_entry_t lookup_entry;
+	libpff_property_set_request_t *request                         = NULL;
+	uint32_t *resolved_entry_types                                 = NULL;
+	static char *function                                          = "libpff_property_set_prepare";
+	uint32_t name_to_id_map_generation                             = 0;
+	int number_of_lookup_entries                                   = 0;
+	int number_of_requests                                         = 0;
+	int number_of_unresolved_requests                              = 0;
+	int request_index                                              = 0;
+	int result                                                     = 0;
+	int sort_index                                                 = 0;
+
+	if( property_set == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid property set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_property_set = (libpff_internal_property_set_t *) property_set;
+
+	if( libcdata_array_get_number_of_entries(
+	     internal_property_set->requests_array,
+	     &number_of_requests,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of requests.",
+		 function );
+
+		goto on_error;
+	}
+	if( (size_t) number_of_requests > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libpff_property_set_lookup_entry_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of requests value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_requests > 0 )
+	{
+		lookup_entries = (libpff_property_set_lookup_entry_t *) memory_allocate(
+		                                                         sizeof( libpff_property_set_lookup_entry_t ) * number_of_requests );
+
+		if( lookup_entries == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create lookup entries.",
+			 function );
+
+			goto on_error;
+		}
+		resolved_entry_types = (uint32_t *) memory_allocate(
+		                                     sizeof( uint32_t ) * number_of_requests );
+
+		if( resolved_entry_types == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create resolved entry types.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     resolved_entry_types,
+		     0,
+		     sizeof( uint32_t ) * number_of_requests ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear resolved entry types.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( request_index = 0;
+	     request_index < number_of_requests;
+	     request_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_property_set->requests_array,
+		     request_index,
+		     (intptr_t **) &request,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve request: %d.",
+			 function,
+			 request_index );
+
+			goto on_error;
+		}
+		if( request == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing request: %d.",
+			 function,
+			 request_index );
+
+			goto on_error;
+		}
+		if( request->type != LIBPFF_PROPERTY_SET_REQUEST_TYPE_ENTRY_TYPE )
+		{
+			number_of_unresolved_requests++;
+		}
+	}
+	/* Resolve all named property requests in a single pass over the name to ID map
+	 * the mapped entry types are 0x8000 or greater hence 0 indicates unresolved
+	 */
+	if( ( name_to_id_map_list != NULL )
+	 && ( number_of_unresolved_requests > 0 ) )
+	{
+		if( libcdata_list_get_first_element(
+		     name_to_id_map_list,
+		     &list_element,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve first element from name to id map list.",
+			 function );
+
+			goto on_error;
+		}
+		while( ( list_element != NULL )
+		    && ( number_of_unresolved_requests > 0 ) )
+		{
+			if( libcdata_list_element_get_value(
+			     list_element,
+			     (intptr_t **) &name_to_id_map_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve name to id map entry.",
+				 function );
+
+				goto on_error;
+			}
+			if( name_to_id_map_entry == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing name to id map entry.",
+				 function );
+
+				goto on_error;
+			}
+			for( request_index = 0;
+			     request_index < number_of_requests;
+			     request_index++ )
+			{
+				if( resolved_entry_types[ request_index ] != 0 )
+				{
+					continue;
+				}
+				if( libcdata_array_get_entry_by_index(
+				     internal_property_set->requests_array,
+				     request_index,
+				     (intptr_t **) &request,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve request: %d.",
+					 function,
+					 request_index );
+
+					goto on_error;
+				}
+				if( request->type == LIBPFF_PROPERTY_SET_REQUEST_TYPE_ENTRY_TYPE )
+				{
+					continue;
+				}
+				result = libpff_property_set_request_matches_name_to_id_map_entry(
+				          request,
+				          name_to_id_map_entry,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: unable to determine if request: %d matches name to id map entry.",
+					 function,
+					 request_index );
+
+					goto on_error;
+				}
+				else if( result != 0 )
+				{
+					resolved_entry_types[ request_index ] = name_to_id_map_entry->identifier;
+
+					number_of_unresolved_requests--;
+				}
+			}
+			if( libcdata_list_element_get_next_element(
+			     list_element,
+			     &list_element,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve next element.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	/* Build the lookup entries sorted by entry type, requests with the same
+	 * entry type are kept in order of the request index
+	 */
+	for( request_index = 0;
+	     request_index < number_of_requests;
+	     request_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_property_set->requests_array,
+		     request_index,
+		     (intptr_t **) &request,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve request: %d.",
+			 function,
+			 request_index );
+
+			goto on_error;
+		}
+		if( request->type == LIBPFF_PROPERTY_SET_REQUEST_TYPE_ENTRY_TYPE )
+		{
+			lookup_entry.entry_type            = request->entry_type;
+			lookup_entry.ignore_name_to_id_map = (uint8_t) ( ( request->flags & LIBPFF_ENTRY_VALUE_FLAG_IGNORE_NAME_TO_ID_MAP ) != 0 );
+		}
+		else if( resolved_entry_types[ request_index ] != 0 )
+		{
+			lookup_entry.entry_type            = resolved_entry_types[ request_index ];
+			lookup_entry.ignore_name_to_id_map = 1;
+		}
+		else
+		{
+			continue;
+		}
+		lookup_entry.request_index = request_index;
+
+		for( sort_index = number_of_lookup_entries;
+		     sort_index > 0;
+		     sort_index-- )
+		{
+			if( lookup_entries[ sort_index - 1 ].entry_type <= lookup_entry.entry_type )
+			{
+				break;
+			}
+			lookup_entries[ sort_index ] = lookup_entries[ sort_index - 1 ];
+		}
+		lookup_entries[ sort_index ] = lookup_entry;
+
+		number_of_lookup_entries++;
+	}
+	if( resolved_entry_types != NULL )
+	{
+		memory_free(
+		 resolved_entry_types );
+	}
+	if( internal_property_set->lookup_entries != NULL )
+	{
+		memory_free(
+		 internal_property_set->lookup_entries );
+	}
+	if( io_handle != NULL )
+	{
+		name_to_id_map_generation = io_handle->name_to_id_map_generation;
+	}
+	internal_property_set->lookup_entries            = lookup_entries;
+	internal_property_set->number_of_lookup_entries  = number_of_lookup_entries;
+	internal_property_set->io_handle                 = io_handle;
+	internal_property_set->name_to_id_map_generation = name_to_id_map_generation;
+	internal_property_set->is_prepared               = 1;
+
+	return( 1 );
+
+on_error:
+	if( resolved_entry_types != NULL )
+	{
+		memory_free(
+		 resolved_entry_types );
+	}
+	if( lookup_entries != NULL )
+	{
+		memory_free(
+		 lookup_entries );
+	}
+	return( -1 );
+}
+
+/* Matches a record entry against the requests of a prepared property set
+ * The record entry is stored at the index of every matching request of
+ * which the corresponding record entry is not yet set
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_property_set_match_record_entry(
+     libpff_property_set_t *property_set,
+     libpff_internal_record_entry_t *record_entry,
+     libpff_record_entry_t **record_entries,
+     int number_of_record_entries,
+     libcerror_error_t **error )
+{
+	libpff_internal_property_set_t *internal_property_set = NULL;
+	libpff_property_set_lookup_entry_t *lookup_entry      = NULL;
+	libpff_property_set_request_t *request                = NULL;
+	static char *function                                 = "libpff_property_set_match_record_entry";
+	uint32_t entry_type                                   = 0;
+	uint8_t match_ignore_name_to_id_map                   = 0;
+	int lookup_entry_index                                = 0;
+	int lookup_index                                      = 0;
+	int maximum_lookup_entry_index                        = 0;
+	int minimum_lookup_entry_index                        = 0;
+
+	if( property_set == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid property set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_property_set = (libpff_internal_property_set_t *) property_set;
+
+	if( internal_property_set->is_prepared == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid property set - not prepared.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record entries.",
+		 function );
+
+		return( -1 );
+	}
+	/* Skip tables entries that do not contain a MAPI identifier
+	 */
+	if( record_entry->identifier.format != LIBPFF_RECORD_ENTRY_IDENTIFIER_FORMAT_MAPI_PROPERTY )
+	{
+		return( 1 );
+	}
+	/* A record entry without a name to ID map entry is matched by its entry type
+	 * by all requests. A mapped record entry is matched by its entry type as stored
+	 * by named property requests and requests that ignore the name to ID map and
+	 * by its mapped numeric value by the other entry type requests
+	 */
+	for( lookup_index = 0;
+	     lookup_index < 2;
+	     lookup_index++ )
+	{
+		if( lookup_index == 0 )
+		{
+			entry_type = record_entry->identifier.entry_type;
+		}
+		else if( ( record_entry->name_to_id_map_entry != NULL )
+		      && ( record_entry->name_to_id_map_entry->type == LIBPFF_NAME_TO_ID_MAP_ENTRY_TYPE_NUMERIC ) )
+		{
+			entry_type = record_entry->name_to_id_map_entry->numeric_value;
+		}
+		else
+		{
+			break;
+		}
+		minimum_lookup_entry_index = 0;
+		maximum_lookup_entry_index = internal_property_set->number_of_lookup_entries;
+
+		/* Determine the first lookup entry with the entry type
+		 */
+		while( minimum_lookup_entry_index < maximum_lookup_entry_index )
+		{
+			lookup_entry_index = minimum_lookup_entry_index + ( ( maximum_lookup_entry_index - minimum_lookup_entry_index ) / 2 );
+
+			if( internal_property_set->lookup_entries[ lookup_entry_index ].entry_type < entry_type )
+			{
+				minimum_lookup_entry_index = lookup_entry_index + 1;
+			}
+			else
+			{
+				maximum_lookup_entry_index = lookup_entry_index;
+			}
+		}
+		for( lookup_entry_index = minimum_lookup_entry_index;
+		     lookup_entry_index < internal_property_set->number_of_lookup_entries;
+		     lookup_entry_index++ )
+		{
+			lookup_entry = &( internal_property_set->lookup_entries[ lookup_entry_index ] );
+
+			if( lookup_entry->entry_type != entry_type )
+			{
+				break;
+			}
+			if( record_entry->name_to_id_map_entry != NULL )
+			{
+				match_ignore_name_to_id_map = (uint8_t) ( lookup_index == 0 );
+
+				if( lookup_entry->ignore_name_to_id_map != match_ignore_name_to_id_map )
+				{
+					continue;
+				}
+			}
+			if( ( lookup_entry->request_index < 0 )
+			 || ( lookup_entry->request_index >= number_of_record_entries ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+				 "%s: invalid number of record entries value too small.",
+				 function );
+
+				return( -1 );
+			}
+			if( record_entries[ lookup_entry->request_index ] != NULL )
+			{
+				continue;
+			}
+			if( libcdata_array_get_entry_by_index(
+			     internal_property_set->requests_array,
+			     lookup_entry->request_index,
+			     (intptr_t **) &request,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve request: %d.",
+				 function,
+				 lookup_entry->request_index );
+
+				return( -1 );
+			}
+			if( request == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing request: %d.",
+				 function,
+				 lookup_entry->request_index );
+
+				return( -1 );
+			}
+			if( ( ( request->flags & LIBPFF_ENTRY_VALUE_FLAG_MATCH_ANY_VALUE_TYPE ) != 0 )
+			 || ( record_entry->identifier.value_type == request->value_type ) )
+			{
+				record_entries[ lookup_entry->request_index ] = (libpff_record_entry_t *) record_entry;
+			}
+		}
+	}
+	return( 1 );
+}
+
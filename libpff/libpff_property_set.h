@@ -0,0 +1,211 @@
+/*
+ * Property set functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPFF_PROPERTY_SET_H )
+#define _LIBPFF_PROPERTY_SET_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libpff_extern.h"
+#include "libpff_io_handle.h"
+#include "libpff_libcdata.h"
+#include "libpff_libcerror.h"
+#include "libpff_name_to_id_map.h"
+#include "libpff_record_entry.h"
+#include "libpff_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libpff_property_set_request libpff_property_set_request_t;
+
+struct libpff_property_set_request
+{
+	/* The request type
+	 */
+	uint8_t type;
+
+	/* The entry type or the number of a numeric name
+	 */
+	uint32_t entry_type;
+
+	/* The value type
+	 */
+	uint32_t value_type;
+
+	/* The flags
+	 */
+	uint8_t flags;
+
+	/* The GUID of a (named) property
+	 */
+	uint8_t guid[ 16 ];
+
+	/* The UTF-8 string of a string name
+	 */
+	uint8_t *utf8_string;
+
+	/* The UTF-8 string size, which includes the end of string character
+	 */
+	size_t utf8_string_size;
+};
+
+typedef struct libpff_property_set_lookup_entry libpff_property_set_lookup_entry_t;
+
+struct libpff_property_set_lookup_entry
+{
+	/* The (record) entry type as stored in the record set
+	 */
+	uint32_t entry_type;
+
+	/* The index of the corresponding request
+	 */
+	int request_index;
+
+	/* Value to indicate the entry type should only be matched against
+	 * the entry type as stored and not against a mapped numeric value
+	 */
+	uint8_t ignore_name_to_id_map;
+};
+
+typedef struct libpff_internal_property_set libpff_internal_property_set_t;
+
+/* A property set is prepared against the name to ID map of a file, after
+ * which the named properties are matched by their entry type as stored in
+ * the record set, the same as the other properties
+ */
+struct libpff_internal_property_set
+{
+	/* The requests array
+	 */
+	libcdata_array_t *requests_array;
+
+	/* The lookup entries, sorted by entry type
+	 */
+	libpff_property_set_lookup_entry_t *lookup_entries;
+
+	/* The number of lookup entries
+	 */
+	int number_of_lookup_entries;
+
+	/* The IO handle of the file the property set was prepared against
+	 * this is only used to identify the file and is not owned by the property set
+	 */
+	libpff_io_handle_t *io_handle;
+
+	/* The generation of the name to ID map the property set was prepared against
+	 */
+	uint32_t name_to_id_map_generation;
+
+	/* Value to indicate the property set was prepared
+	 */
+	uint8_t is_prepared;
+};
+
+LIBPFF_EXTERN \
+int libpff_property_set_initialize(
+     libpff_property_set_t **property_set,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_property_set_free(
+     libpff_property_set_t **property_set,
+     libcerror_error_t **error );
+
+int libpff_property_set_request_free(
+     libpff_property_set_request_t **request,
+     libcerror_error_t **error );
+
+int libpff_internal_property_set_append_request(
+     libpff_internal_property_set_t *internal_property_set,
+     libpff_property_set_request_t *request,
+     int *request_index,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_property_set_append_entry_type(
+     libpff_property_set_t *property_set,
+     uint32_t entry_type,
+     uint32_t value_type,
+     uint8_t flags,
+     int *request_index,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_property_set_append_numeric_name(
+     libpff_property_set_t *property_set,
+     const uint8_t *guid,
+     size_t guid_size,
+     uint32_t number,
+     uint32_t value_type,
+     uint8_t flags,
+     int *request_index,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_property_set_append_utf8_name(
+     libpff_property_set_t *property_set,
+     const uint8_t *guid,
+     size_t guid_size,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     uint32_t value_type,
+     uint8_t flags,
+     int *request_index,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_property_set_get_number_of_requests(
+     libpff_property_set_t *property_set,
+     int *number_of_requests,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_property_set_is_prepared(
+     libpff_property_set_t *property_set,
+     libcerror_error_t **error );
+
+int libpff_property_set_request_matches_name_to_id_map_entry(
+     libpff_property_set_request_t *request,
+     libpff_internal_name_to_id_map_entry_t *name_to_id_map_entry,
+     libcerror_error_t **error );
+
+int libpff_property_set_prepare(
+     libpff_property_set_t *property_set,
+     libpff_io_handle_t *io_handle,
+     libcdata_list_t *name_to_id_map_list,
+     libcerror_error_t **error );
+
+int libpff_property_set_match_record_entry(
+     libpff_property_set_t *property_set,
+     libpff_internal_record_entry_t *record_entry,
+     libpff_record_entry_t **record_entries,
+     int number_of_record_entries,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPFF_PROPERTY_SET_H ) */
+
@@ -0,0 +1,558 @@
+/*
+ * Reader context functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libpff_definitions.h"
+#include "libpff_descriptors_index.h"
+#include "libpff_file_header.h"
+#include "libpff_io_handle.h"
+#include "libpff_libbfio.h"
+#include "libpff_libcerror.h"
+#include "libpff_libfcache.h"
+#include "libpff_libfdata.h"
+#include "libpff_offsets_index.h"
+#include "libpff_reader_context.h"
+
+/* Creates a reader context
+ * Make sure the value reader_context is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_reader_context_initialize(
+     libpff_reader_context_t **reader_context,
+     libpff_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libpff_file_header_t *file_header,
+     size_t index_node_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_reader_context_initialize";
+	int result            = 0;
+	int segment_index     = 0;
+
+	if( reader_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *reader_context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid reader context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_header == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file header.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( index_node_size == 0 )
+	 || ( index_node_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid index node size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*reader_context = memory_allocate_structure(
+	                   libpff_reader_context_t );
+
+	if( *reader_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create reader context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *reader_context,
+	     0,
+	     sizeof( libpff_reader_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear reader context.",
+		 function );
+
+		memory_free(
+		 *reader_context );
+
+		*reader_context = NULL;
+
+		return( -1 );
+	}
+	/* The reader context gets a copy of the IO handle so that the read budget
+	 * accounting and the corruption flag are not updated concurrently.
+	 * The copy does not use the table cache of the file, which is not safe
+	 * for concurrent use, but shares the local descriptor nodes cache.
+	 */
+	if( libpff_io_handle_initialize(
+	     &( ( *reader_context )->io_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     ( *reader_context )->io_handle,
+	     io_handle,
+	     sizeof( libpff_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy IO handle.",
+		 function );
+
+		( *reader_context )->io_handle->table_cache                  = NULL;
+		( *reader_context )->io_handle->local_descriptor_nodes_cache = NULL;
+
+		goto on_error;
+	}
+	( *reader_context )->io_handle->table_cache                         = NULL;
+	( *reader_context )->io_handle->caller_io_handle                    = NULL;
+	( *reader_context )->io_handle->total_read_size                     = 0;
+	( *reader_context )->io_handle->total_number_of_read_blocks         = 0;
+	( *reader_context )->io_handle->total_number_of_decompressed_blocks = 0;
+
+	( *reader_context )->parent_io_handle              = io_handle;
+	( *reader_context )->initial_read_size             = io_handle->read_size;
+	( *reader_context )->initial_number_of_read_blocks = io_handle->number_of_read_blocks;
+
+	if( libbfio_handle_clone(
+	     &( ( *reader_context )->file_io_handle ),
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to clone file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	result = libbfio_handle_is_open(
+	          ( *reader_context )->file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to determine if file IO handle is open.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libbfio_handle_open(
+		     ( *reader_context )->file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		( *reader_context )->file_io_handle_opened = 1;
+	}
+	if( libfdata_vector_initialize(
+	     &( ( *reader_context )->index_nodes_vector ),
+	     (size64_t) index_node_size,
+	     (intptr_t *) ( *reader_context )->io_handle,
+	     NULL,
+	     NULL,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_vector_t *, libfdata_cache_t *, int, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &libpff_io_handle_read_index_node,
+	     NULL,
+	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create index nodes vector.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_vector_append_segment(
+	     ( *reader_context )->index_nodes_vector,
+	     &segment_index,
+	     0,
+	     0,
+	     io_handle->file_size,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to create append segment to nodes vector.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfcache_cache_initialize(
+	     &( ( *reader_context )->index_nodes_cache ),
+	     LIBPFF_MAXIMUM_CACHE_ENTRIES_INDEX_NODES,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create index nodes cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_descriptors_index_initialize(
+	     &( ( *reader_context )->descriptors_index ),
+	     ( *reader_context )->io_handle,
+	     ( *reader_context )->index_nodes_vector,
+	     ( *reader_context )->index_nodes_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create descriptors index.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_descriptors_index_set_root_node(
+	     ( *reader_context )->descriptors_index,
+	     file_header->descriptors_index_root_node_offset,
+	     file_header->descriptors_index_root_node_back_pointer,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set descriptors index root node.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_offsets_index_initialize(
+	     &( ( *reader_context )->offsets_index ),
+	     ( *reader_context )->io_handle,
+	     ( *reader_context )->index_nodes_vector,
+	     ( *reader_context )->index_nodes_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create offsets index.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_offsets_index_set_root_node(
+	     ( *reader_context )->offsets_index,
+	     file_header->offsets_index_root_node_offset,
+	     file_header->offsets_index_root_node_back_pointer,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set offsets index root node.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *reader_context != NULL )
+	{
+		libpff_reader_context_free(
+		 reader_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a reader context
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_reader_context_free(
+     libpff_reader_context_t **reader_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_reader_context_free";
+	int result            = 1;
+
+	if( reader_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *reader_context != NULL )
+	{
+		if( ( *reader_context )->offsets_index != NULL )
+		{
+			if( libpff_offsets_index_free(
+			     &( ( *reader_context )->offsets_index ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free offsets index.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *reader_context )->descriptors_index != NULL )
+		{
+			if( libpff_descriptors_index_free(
+			     &( ( *reader_context )->descriptors_index ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free descriptors index.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *reader_context )->index_nodes_cache != NULL )
+		{
+			if( libfcache_cache_free(
+			     &( ( *reader_context )->index_nodes_cache ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free index nodes cache.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *reader_context )->index_nodes_vector != NULL )
+		{
+			if( libfdata_vector_free(
+			     &( ( *reader_context )->index_nodes_vector ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free index nodes vector.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *reader_context )->file_io_handle_opened != 0 )
+		{
+			if( libbfio_handle_close(
+			     ( *reader_context )->file_io_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *reader_context )->file_io_handle != NULL )
+		{
+			if( libbfio_handle_free(
+			     &( ( *reader_context )->file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *reader_context )->io_handle != NULL )
+		{
+			/* The local descriptor nodes cache is owned by the IO handle of the file
+			 */
+			( *reader_context )->io_handle->local_descriptor_nodes_cache = NULL;
+
+			if( libpff_io_handle_free(
+			     &( ( *reader_context )->io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *reader_context );
+
+		*reader_context = NULL;
+	}
+	return( result );
+}
+
+/* Merges the read state of the reader context IO handle into the IO handle of the file
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_reader_context_merge_read_state(
+     libpff_reader_context_t *reader_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_reader_context_merge_read_state";
+
+	if( reader_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( reader_context->parent_io_handle == NULL )
+	 || ( reader_context->io_handle == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid reader context - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	reader_context->parent_io_handle->read_size             += reader_context->io_handle->read_size - reader_context->initial_read_size;
+	reader_context->parent_io_handle->number_of_read_blocks += reader_context->io_handle->number_of_read_blocks - reader_context->initial_number_of_read_blocks;
+	reader_context->parent_io_handle->flags                 |= reader_context->io_handle->flags & LIBPFF_IO_HANDLE_FLAG_IS_CORRUPTED;
+
+	reader_context->parent_io_handle->total_read_size                     += reader_context->io_handle->total_read_size;
+	reader_context->parent_io_handle->total_number_of_read_blocks         += reader_context->io_handle->total_number_of_read_blocks;
+	reader_context->parent_io_handle->total_number_of_decompressed_blocks += reader_context->io_handle->total_number_of_decompressed_blocks;
+
+	reader_context->initial_read_size             = reader_context->io_handle->read_size;
+	reader_context->initial_number_of_read_blocks = reader_context->io_handle->number_of_read_blocks;
+
+	reader_context->io_handle->total_read_size                     = 0;
+	reader_context->io_handle->total_number_of_read_blocks         = 0;
+	reader_context->io_handle->total_number_of_decompressed_blocks = 0;
+
+	return( 1 );
+}
+
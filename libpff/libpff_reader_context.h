@@ -0,0 +1,111 @@
+/*
+ * Reader context functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPFF_READER_CONTEXT_H )
+#define _LIBPFF_READER_CONTEXT_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libpff_descriptors_index.h"
+#include "libpff_file_header.h"
+#include "libpff_io_handle.h"
+#include "libpff_libbfio.h"
+#include "libpff_libcerror.h"
+#include "libpff_libfcache.h"
+#include "libpff_libfdata.h"
+#include "libpff_offsets_index.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libpff_reader_context libpff_reader_context_t;
+
+/* The reader context contains the state needed to read items independently
+ * of the file. It uses its own IO handle, file IO handle, index nodes vector
+ * and cache and indexes, so that it can be used on a separate thread
+ */
+struct libpff_reader_context
+{
+	/* The IO handle of the file
+	 */
+	libpff_io_handle_t *parent_io_handle;
+
+	/* The IO handle
+	 */
+	libpff_io_handle_t *io_handle;
+
+	/* The file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* Value to indicate if the file IO handle was opened by the reader context
+	 */
+	uint8_t file_io_handle_opened;
+
+	/* The index nodes vector
+	 */
+	libfdata_vector_t *index_nodes_vector;
+
+	/* The index nodes cache
+	 */
+	libfcache_cache_t *index_nodes_cache;
+
+	/* The descriptors index
+	 */
+	libpff_descriptors_index_t *descriptors_index;
+
+	/* The offsets index
+	 */
+	libpff_offsets_index_t *offsets_index;
+
+	/* The number of bytes read by the parent IO handle when the reader context was created
+	 */
+	size64_t initial_read_size;
+
+	/* The number of blocks read by the parent IO handle when the reader context was created
+	 */
+	uint32_t initial_number_of_read_blocks;
+};
+
+int libpff_reader_context_initialize(
+     libpff_reader_context_t **reader_context,
+     libpff_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libpff_file_header_t *file_header,
+     size_t index_node_size,
+     libcerror_error_t **error );
+
+int libpff_reader_context_free(
+     libpff_reader_context_t **reader_context,
+     libcerror_error_t **error );
+
+int libpff_reader_context_merge_read_state(
+     libpff_reader_context_t *reader_context,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPFF_READER_CONTEXT_H ) */
+
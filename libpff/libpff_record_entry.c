@@ -24,8 +24,10 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libpff_conversation_index.h"
 #include "libpff_definitions.h"
 #include "libpff_descriptor_data_stream.h"
+#include "libpff_entry_identifier.h"
 #include "libpff_libcerror.h"
 #include "libpff_libuna.h"
 #include "libpff_mapi.h"
@@ -146,6 +148,7 @@ int libpff_internal_record_entry_free(
      libcerror_error_t **error )
 {
 	static char *function = "libpff_internal_record_entry_free";
+	int result            = 1;
 
 	if( internal_record_entry == NULL )
 	{
@@ -160,6 +163,38 @@ int libpff_internal_record_entry_free(
 	}
 	if( *internal_record_entry != NULL )
 	{
+		if( ( *internal_record_entry )->value_data_cache != NULL )
+		{
+			if( libfcache_cache_free(
+			     &( ( *internal_record_entry )->value_data_cache ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free value data cache.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *internal_record_entry )->value_data_list != NULL )
+		{
+			if( libfdata_list_free(
+			     &( ( *internal_record_entry )->value_data_list ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free value data list.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( ( *internal_record_entry )->value_data != NULL )
 		{
 			memory_free(
@@ -170,7 +205,7 @@ int libpff_internal_record_entry_free(
 
 		*internal_record_entry = NULL;
 	}
-	return( 1 );
+	return( result );
 }
 
 /* Clones the record entry
@@ -289,6 +324,39 @@ int libpff_record_entry_clone(
 		}
 		internal_destination_record_entry->value_data_size = internal_source_record_entry->value_data_size;
 	}
+	else if( internal_source_record_entry->value_data_list != NULL )
+	{
+		if( libfdata_list_clone(
+		     &( internal_destination_record_entry->value_data_list ),
+		     internal_source_record_entry->value_data_list,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination value data list.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfcache_cache_clone(
+		     &( internal_destination_record_entry->value_data_cache ),
+		     internal_source_record_entry->value_data_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination value data cache.",
+			 function );
+
+			goto on_error;
+		}
+		internal_destination_record_entry->value_data_size = internal_source_record_entry->value_data_size;
+		internal_destination_record_entry->file_io_handle  = internal_source_record_entry->file_io_handle;
+	}
 	internal_destination_record_entry->name_to_id_map_entry = internal_source_record_entry->name_to_id_map_entry;
 	internal_destination_record_entry->flags                = internal_source_record_entry->flags;
 
@@ -526,6 +594,19 @@ int libpff_record_entry_get_value_data(
 
 		return( -1 );
 	}
+	if( libpff_internal_record_entry_read_value_data(
+	     internal_record_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read value data.",
+		 function );
+
+		return( -1 );
+	}
 	*value_data      = internal_record_entry->value_data;
 	*value_data_size = internal_record_entry->value_data_size;
 
@@ -826,17 +907,21 @@ on_error:
 	return( -1 );
 }
 
-/* Retrieves the data
+/* Sets the value data list in the record entry
+ * The value data is not read until it is accessed
+ * The record entry takes over the management of the value data list and cache
  * Returns 1 if successful or -1 on error
  */
-int libpff_record_entry_get_data(
+int libpff_record_entry_set_value_data_list(
      libpff_record_entry_t *record_entry,
-     uint8_t *data,
-     size_t data_size,
+     libbfio_handle_t *file_io_handle,
+     libfdata_list_t *value_data_list,
+     libfcache_cache_t *value_data_cache,
      libcerror_error_t **error )
 {
 	libpff_internal_record_entry_t *internal_record_entry = NULL;
-	static char *function                                 = "libpff_record_entry_get_data";
+	static char *function                                 = "libpff_record_entry_set_value_data_list";
+	size64_t value_data_size                              = 0;
 
 	if( record_entry == NULL )
 	{
@@ -851,79 +936,85 @@ int libpff_record_entry_get_data(
 	}
 	internal_record_entry = (libpff_internal_record_entry_t *) record_entry;
 
-	if( internal_record_entry->value_data == NULL )
+	if( ( internal_record_entry->value_data != NULL )
+	 || ( internal_record_entry->value_data_list != NULL ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid record entry - missing value data.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid record entry - value data already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( data == NULL )
+	if( value_data_list == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data.",
+		 "%s: invalid value data list.",
 		 function );
 
 		return( -1 );
 	}
-	if( data_size > (size_t) SSIZE_MAX )
+	if( value_data_cache == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid data size value exceeds maximum.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value data cache.",
 		 function );
 
 		return( -1 );
 	}
-	if( data_size < internal_record_entry->value_data_size )
+	if( libfdata_list_get_size(
+	     value_data_list,
+	     &value_data_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-		 "%s: invalid data value too small.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value data list size.",
 		 function );
 
 		return( -1 );
 	}
-	if( memory_copy(
-	     data,
-	     internal_record_entry->value_data,
-	     internal_record_entry->value_data_size ) == NULL )
+	if( value_data_size > (size64_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy value data.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid value data size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
+	internal_record_entry->value_data_list   = value_data_list;
+	internal_record_entry->value_data_cache  = value_data_cache;
+	internal_record_entry->value_data_size   = (size_t) value_data_size;
+	internal_record_entry->file_io_handle    = file_io_handle;
+	internal_record_entry->flags            |= LIBPFF_RECORD_ENTRY_FLAG_DEFERRED_VALUE_DATA;
+
 	return( 1 );
 }
 
-/* Retrieves the data as a boolean value
+/* Reads the deferred value data into the record entry
  * Returns 1 if successful or -1 on error
  */
-int libpff_record_entry_get_data_as_boolean(
-     libpff_record_entry_t *record_entry,
-     uint8_t *value_boolean,
+int libpff_internal_record_entry_read_value_data(
+     libpff_internal_record_entry_t *internal_record_entry,
      libcerror_error_t **error )
 {
-	libpff_internal_record_entry_t *internal_record_entry = NULL;
-	static char *function                                 = "libpff_record_entry_get_data_as_boolean";
+	static char *function  = "libpff_internal_record_entry_read_value_data";
+	size_t value_data_size = 0;
 
-	if( record_entry == NULL )
+	if( internal_record_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -934,67 +1025,105 @@ int libpff_record_entry_get_data_as_boolean(
 
 		return( -1 );
 	}
-	internal_record_entry = (libpff_internal_record_entry_t *) record_entry;
+	if( ( internal_record_entry->value_data != NULL )
+	 || ( internal_record_entry->value_data_list == NULL ) )
+	{
+		return( 1 );
+	}
+	value_data_size = internal_record_entry->value_data_size;
 
-	if( internal_record_entry->identifier.value_type != LIBPFF_VALUE_TYPE_BOOLEAN )
+	if( libpff_record_entry_set_value_data_from_list(
+	     (libpff_record_entry_t *) internal_record_entry,
+	     internal_record_entry->file_io_handle,
+	     internal_record_entry->value_data_list,
+	     internal_record_entry->value_data_cache,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported value type.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set value data from list.",
 		 function );
 
+		internal_record_entry->value_data_size = value_data_size;
+
 		return( -1 );
 	}
-	if( internal_record_entry->value_data == NULL )
+	return( 1 );
+}
+
+/* Retrieves a stream of the deferred value data
+ * The stream references the value data list and cache of the record entry
+ * and should not be used after the record entry has been freed
+ * Returns 1 if successful, 0 if the value data is not deferred or -1 on error
+ */
+int libpff_record_entry_get_value_data_stream(
+     libpff_record_entry_t *record_entry,
+     libfdata_stream_t **value_data_stream,
+     libcerror_error_t **error )
+{
+	libpff_internal_record_entry_t *internal_record_entry = NULL;
+	static char *function                                 = "libpff_record_entry_get_value_data_stream";
+
+	if( record_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid record entry - missing value data.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record entry.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_record_entry->value_data_size != 1 )
+	internal_record_entry = (libpff_internal_record_entry_t *) record_entry;
+
+	if( value_data_stream == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported value data size.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value data stream.",
 		 function );
 
 		return( -1 );
 	}
-	if( value_boolean == NULL )
+	if( internal_record_entry->value_data_list == NULL )
+	{
+		return( 0 );
+	}
+	if( libpff_descriptor_data_stream_initialize(
+	     value_data_stream,
+	     internal_record_entry->value_data_list,
+	     internal_record_entry->value_data_cache,
+	     LIBPFF_DESCRIPTOR_DATA_STREAM_DATA_HANDLE_FLAG_NON_MANAGED,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid value boolean.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create descriptor data stream.",
 		 function );
 
 		return( -1 );
 	}
-	*value_boolean = internal_record_entry->value_data[ 0 ];
-
 	return( 1 );
 }
 
-/* Retrieves the data as a 16-bit integer value
+/* Retrieves the data
  * Returns 1 if successful or -1 on error
  */
-int libpff_record_entry_get_data_as_16bit_integer(
+int libpff_record_entry_get_data(
      libpff_record_entry_t *record_entry,
-     uint16_t *value_16bit,
+     uint8_t *data,
+     size_t data_size,
      libcerror_error_t **error )
 {
 	libpff_internal_record_entry_t *internal_record_entry = NULL;
-	static char *function                                 = "libpff_record_entry_get_data_as_16bit_integer";
+	static char *function                                 = "libpff_record_entry_get_data";
 
 	if( record_entry == NULL )
 	{
@@ -1009,13 +1138,15 @@ int libpff_record_entry_get_data_as_16bit_integer(
 	}
 	internal_record_entry = (libpff_internal_record_entry_t *) record_entry;
 
-	if( internal_record_entry->identifier.value_type != LIBPFF_VALUE_TYPE_INTEGER_16BIT_SIGNED )
+	if( libpff_internal_record_entry_read_value_data(
+	     internal_record_entry,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported value type.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read value data.",
 		 function );
 
 		return( -1 );
@@ -1031,45 +1162,70 @@ int libpff_record_entry_get_data_as_16bit_integer(
 
 		return( -1 );
 	}
-	if( internal_record_entry->value_data_size != 2 )
+	if( data == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported value data size.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
 		 function );
 
 		return( -1 );
 	}
-	if( value_16bit == NULL )
+	if( data_size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid value 16-bit.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	byte_stream_copy_to_uint16_little_endian(
-	 internal_record_entry->value_data,
-	 *value_16bit );
+	if( data_size < internal_record_entry->value_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid data value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     data,
+	     internal_record_entry->value_data,
+	     internal_record_entry->value_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy value data.",
+		 function );
 
+		return( -1 );
+	}
 	return( 1 );
 }
 
-/* Retrieves the data as a 32-bit integer value
+/* Retrieves a pointer to the data
+ * The data is not copied and remains owned by the record entry, it is valid
+ * until the record entry, or the item or record set it belongs to, is freed
+ * The data is NULL if the record entry has no value data
  * Returns 1 if successful or -1 on error
  */
-int libpff_record_entry_get_data_as_32bit_integer(
+int libpff_record_entry_get_data_pointer(
      libpff_record_entry_t *record_entry,
-     uint32_t *value_32bit,
+     const uint8_t **data,
+     size_t *data_size,
      libcerror_error_t **error )
 {
 	libpff_internal_record_entry_t *internal_record_entry = NULL;
-	static char *function                                 = "libpff_record_entry_get_data_as_32bit_integer";
+	static char *function                                 = "libpff_record_entry_get_data_pointer";
 
 	if( record_entry == NULL )
 	{
@@ -1084,67 +1240,57 @@ int libpff_record_entry_get_data_as_32bit_integer(
 	}
 	internal_record_entry = (libpff_internal_record_entry_t *) record_entry;
 
-	if( internal_record_entry->identifier.value_type != LIBPFF_VALUE_TYPE_INTEGER_32BIT_SIGNED )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported value type.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_record_entry->value_data == NULL )
+	if( data == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid record entry - missing value data.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_record_entry->value_data_size != 4 )
+	if( data_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported value data size.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
 		 function );
 
 		return( -1 );
 	}
-	if( value_32bit == NULL )
+	if( libpff_internal_record_entry_read_value_data(
+	     internal_record_entry,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid value 32-bit.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read value data.",
 		 function );
 
 		return( -1 );
 	}
-	byte_stream_copy_to_uint32_little_endian(
-	 internal_record_entry->value_data,
-	 *value_32bit );
+	*data      = internal_record_entry->value_data;
+	*data_size = internal_record_entry->value_data_size;
 
 	return( 1 );
 }
 
-/* Retrieves the data as a 64-bit integer value
+/* Retrieves the data as a boolean value
  * Returns 1 if successful or -1 on error
  */
-int libpff_record_entry_get_data_as_64bit_integer(
+int libpff_record_entry_get_data_as_boolean(
      libpff_record_entry_t *record_entry,
-     uint64_t *value_64bit,
+     uint8_t *value_boolean,
      libcerror_error_t **error )
 {
 	libpff_internal_record_entry_t *internal_record_entry = NULL;
-	static char *function                                 = "libpff_record_entry_get_data_as_64bit_integer";
+	static char *function                                 = "libpff_record_entry_get_data_as_boolean";
 
 	if( record_entry == NULL )
 	{
@@ -1159,7 +1305,7 @@ int libpff_record_entry_get_data_as_64bit_integer(
 	}
 	internal_record_entry = (libpff_internal_record_entry_t *) record_entry;
 
-	if( internal_record_entry->identifier.value_type != LIBPFF_VALUE_TYPE_INTEGER_64BIT_SIGNED )
+	if( internal_record_entry->identifier.value_type != LIBPFF_VALUE_TYPE_BOOLEAN )
 	{
 		libcerror_error_set(
 		 error,
@@ -1181,7 +1327,230 @@ int libpff_record_entry_get_data_as_64bit_integer(
 
 		return( -1 );
 	}
-	if( internal_record_entry->value_data_size != 8 )
+	if( internal_record_entry->value_data_size != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported value data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_boolean == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value boolean.",
+		 function );
+
+		return( -1 );
+	}
+	*value_boolean = internal_record_entry->value_data[ 0 ];
+
+	return( 1 );
+}
+
+/* Retrieves the data as a 16-bit integer value
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_record_entry_get_data_as_16bit_integer(
+     libpff_record_entry_t *record_entry,
+     uint16_t *value_16bit,
+     libcerror_error_t **error )
+{
+	libpff_internal_record_entry_t *internal_record_entry = NULL;
+	static char *function                                 = "libpff_record_entry_get_data_as_16bit_integer";
+
+	if( record_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_record_entry = (libpff_internal_record_entry_t *) record_entry;
+
+	if( internal_record_entry->identifier.value_type != LIBPFF_VALUE_TYPE_INTEGER_16BIT_SIGNED )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported value type.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_record_entry->value_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid record entry - missing value data.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_record_entry->value_data_size != 2 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported value data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_16bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 16-bit.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint16_little_endian(
+	 internal_record_entry->value_data,
+	 *value_16bit );
+
+	return( 1 );
+}
+
+/* Retrieves the data as a 32-bit integer value
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_record_entry_get_data_as_32bit_integer(
+     libpff_record_entry_t *record_entry,
+     uint32_t *value_32bit,
+     libcerror_error_t **error )
+{
+	libpff_internal_record_entry_t *internal_record_entry = NULL;
+	static char *function                                 = "libpff_record_entry_get_data_as_32bit_integer";
+
+	if( record_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_record_entry = (libpff_internal_record_entry_t *) record_entry;
+
+	if( internal_record_entry->identifier.value_type != LIBPFF_VALUE_TYPE_INTEGER_32BIT_SIGNED )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported value type.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_record_entry->value_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid record entry - missing value data.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_record_entry->value_data_size != 4 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported value data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_32bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 32-bit.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 internal_record_entry->value_data,
+	 *value_32bit );
+
+	return( 1 );
+}
+
+/* Retrieves the data as a 64-bit integer value
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_record_entry_get_data_as_64bit_integer(
+     libpff_record_entry_t *record_entry,
+     uint64_t *value_64bit,
+     libcerror_error_t **error )
+{
+	libpff_internal_record_entry_t *internal_record_entry = NULL;
+	static char *function                                 = "libpff_record_entry_get_data_as_64bit_integer";
+
+	if( record_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_record_entry = (libpff_internal_record_entry_t *) record_entry;
+
+	if( internal_record_entry->identifier.value_type != LIBPFF_VALUE_TYPE_INTEGER_64BIT_SIGNED )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported value type.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_record_entry->value_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid record entry - missing value data.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_record_entry->value_data_size != 8 )
 	{
 		libcerror_error_set(
 		 error,
@@ -2461,6 +2830,407 @@ int libpff_record_entry_get_data_as_guid(
 	return( 1 );
 }
 
+/* Retrieves the binary value data
+ * Deferred value data is read on first access
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_internal_record_entry_get_binary_value_data(
+     libpff_internal_record_entry_t *internal_record_entry,
+     const uint8_t **value_data,
+     size_t *value_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_internal_record_entry_get_binary_value_data";
+
+	if( internal_record_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_record_entry->identifier.value_type != LIBPFF_VALUE_TYPE_BINARY_DATA )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid record entry - unsupported value type.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value data.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_internal_record_entry_read_value_data(
+	     internal_record_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read value data.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_record_entry->value_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid record entry - missing value data.",
+		 function );
+
+		return( -1 );
+	}
+	*value_data      = internal_record_entry->value_data;
+	*value_data_size = internal_record_entry->value_data_size;
+
+	return( 1 );
+}
+
+/* Retrieves the data as conversation index header block values
+ * The filetime contains the upper 48-bits of the FILETIME, the GUID data is in big-endian
+ * Returns 1 if successful, 0 if the data does not contain a header block or -1 on error
+ */
+int libpff_record_entry_get_data_as_conversation_index_header(
+     libpff_record_entry_t *record_entry,
+     uint64_t *filetime,
+     uint8_t *guid_data,
+     size_t guid_data_size,
+     libcerror_error_t **error )
+{
+	const uint8_t *value_data = NULL;
+	static char *function     = "libpff_record_entry_get_data_as_conversation_index_header";
+	size_t value_data_size    = 0;
+	int result                = 0;
+
+	if( record_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_internal_record_entry_get_binary_value_data(
+	     (libpff_internal_record_entry_t *) record_entry,
+	     &value_data,
+	     &value_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve binary value data.",
+		 function );
+
+		return( -1 );
+	}
+	result = libpff_conversation_index_get_header_values(
+	          value_data,
+	          value_data_size,
+	          filetime,
+	          guid_data,
+	          guid_data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve conversation index header values.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the data as the number of conversation index child blocks
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_record_entry_get_data_as_conversation_index_number_of_child_blocks(
+     libpff_record_entry_t *record_entry,
+     int *number_of_child_blocks,
+     libcerror_error_t **error )
+{
+	const uint8_t *value_data = NULL;
+	static char *function     = "libpff_record_entry_get_data_as_conversation_index_number_of_child_blocks";
+	size_t value_data_size    = 0;
+
+	if( record_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_internal_record_entry_get_binary_value_data(
+	     (libpff_internal_record_entry_t *) record_entry,
+	     &value_data,
+	     &value_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve binary value data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_conversation_index_get_number_of_child_blocks(
+	     value_data,
+	     value_data_size,
+	     number_of_child_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of conversation index child blocks.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the data as the values of a specific conversation index child block
+ * The time delta is relative to the filetime of the previous block, the filetime of
+ * the child block is that of the header block with the time deltas of the child blocks
+ * up to and including this one added
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_record_entry_get_data_as_conversation_index_child_block(
+     libpff_record_entry_t *record_entry,
+     int child_block_index,
+     uint64_t *time_delta,
+     uint8_t *random_number,
+     uint8_t *sequence_count,
+     libcerror_error_t **error )
+{
+	const uint8_t *value_data = NULL;
+	static char *function     = "libpff_record_entry_get_data_as_conversation_index_child_block";
+	size_t value_data_size    = 0;
+
+	if( record_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_internal_record_entry_get_binary_value_data(
+	     (libpff_internal_record_entry_t *) record_entry,
+	     &value_data,
+	     &value_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve binary value data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_conversation_index_get_child_block_values(
+	     value_data,
+	     value_data_size,
+	     child_block_index,
+	     time_delta,
+	     random_number,
+	     sequence_count,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve conversation index child block: %d values.",
+		 function,
+		 child_block_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the data as entry identifier header values
+ * Returns 1 if successful, 0 if the data does not contain an entry identifier or -1 on error
+ */
+int libpff_record_entry_get_data_as_entry_identifier(
+     libpff_record_entry_t *record_entry,
+     uint32_t *flags,
+     uint8_t *service_provider_identifier,
+     size_t service_provider_identifier_size,
+     libcerror_error_t **error )
+{
+	const uint8_t *value_data = NULL;
+	static char *function     = "libpff_record_entry_get_data_as_entry_identifier";
+	size_t value_data_size    = 0;
+	int result                = 0;
+
+	if( record_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_internal_record_entry_get_binary_value_data(
+	     (libpff_internal_record_entry_t *) record_entry,
+	     &value_data,
+	     &value_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve binary value data.",
+		 function );
+
+		return( -1 );
+	}
+	result = libpff_entry_identifier_get_header_values(
+	          value_data,
+	          value_data_size,
+	          flags,
+	          service_provider_identifier,
+	          service_provider_identifier_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry identifier header values.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the data as the item identifier of a message store entry identifier
+ * The record key is the 16-byte record key (PR_RECORD_KEY) of the message store of the file,
+ * entry identifiers of another message store are not considered message store entry identifiers
+ * The item identifier can be used with libpff_file_get_item_by_identifier
+ * Returns 1 if successful, 0 if the data is not a message store entry identifier of the store or -1 on error
+ */
+int libpff_record_entry_get_data_as_item_identifier(
+     libpff_record_entry_t *record_entry,
+     const uint8_t *record_key,
+     size_t record_key_size,
+     uint32_t *item_identifier,
+     libcerror_error_t **error )
+{
+	const uint8_t *value_data = NULL;
+	static char *function     = "libpff_record_entry_get_data_as_item_identifier";
+	size_t value_data_size    = 0;
+	int result                = 0;
+
+	if( record_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_internal_record_entry_get_binary_value_data(
+	     (libpff_internal_record_entry_t *) record_entry,
+	     &value_data,
+	     &value_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve binary value data.",
+		 function );
+
+		return( -1 );
+	}
+	result = libpff_entry_identifier_get_item_identifier(
+	          value_data,
+	          value_data_size,
+	          record_key,
+	          record_key_size,
+	          item_identifier,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve item identifier.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
 /* Copies the value data to an object identifier
  * Returns 1 if successful or -1 on error
  */
@@ -2922,6 +3692,19 @@ ssize_t libpff_record_entry_read_buffer(
 
 		return( -1 );
 	}
+	if( libpff_internal_record_entry_read_value_data(
+	     internal_record_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read value data.",
+		 function );
+
+		return( -1 );
+	}
 	if( ( internal_record_entry->value_data == NULL )
 	 || ( internal_record_entry->value_data_offset >= (off64_t) internal_record_entry->value_data_size ) )
 	{
@@ -58,6 +58,19 @@ struct libpff_internal_record_entry
 	 */
 	off64_t value_data_offset;
 
+	/* The value data list
+	 * Used when reading the value data is deferred until it is accessed
+	 */
+	libfdata_list_t *value_data_list;
+
+	/* The value data cache
+	 */
+	libfcache_cache_t *value_data_cache;
+
+	/* The file IO handle used to read deferred value data
+	 */
+	libbfio_handle_t *file_io_handle;
+
 	/* The name to id map entry
 	 */
 	libpff_internal_name_to_id_map_entry_t *name_to_id_map_entry;
@@ -139,6 +152,22 @@ int libpff_record_entry_set_value_data_from_stream(
      libfdata_stream_t *value_data_stream,
      libcerror_error_t **error );
 
+int libpff_record_entry_set_value_data_list(
+     libpff_record_entry_t *record_entry,
+     libbfio_handle_t *file_io_handle,
+     libfdata_list_t *value_data_list,
+     libfcache_cache_t *value_data_cache,
+     libcerror_error_t **error );
+
+int libpff_internal_record_entry_read_value_data(
+     libpff_internal_record_entry_t *internal_record_entry,
+     libcerror_error_t **error );
+
+int libpff_record_entry_get_value_data_stream(
+     libpff_record_entry_t *record_entry,
+     libfdata_stream_t **value_data_stream,
+     libcerror_error_t **error );
+
 LIBPFF_EXTERN \
 int libpff_record_entry_get_data(
      libpff_record_entry_t *record_entry,
@@ -146,6 +175,13 @@ int libpff_record_entry_get_data(
      size_t data_size,
      libcerror_error_t **error );
 
+LIBPFF_EXTERN \
+int libpff_record_entry_get_data_pointer(
+     libpff_record_entry_t *record_entry,
+     const uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error );
+
 LIBPFF_EXTERN \
 int libpff_record_entry_get_data_as_boolean(
      libpff_record_entry_t *record_entry,
@@ -267,6 +303,51 @@ int libpff_record_entry_get_data_as_guid(
      size_t guid_data_size,
      libcerror_error_t **error );
 
+int libpff_internal_record_entry_get_binary_value_data(
+     libpff_internal_record_entry_t *internal_record_entry,
+     const uint8_t **value_data,
+     size_t *value_data_size,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_record_entry_get_data_as_conversation_index_header(
+     libpff_record_entry_t *record_entry,
+     uint64_t *filetime,
+     uint8_t *guid_data,
+     size_t guid_data_size,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_record_entry_get_data_as_conversation_index_number_of_child_blocks(
+     libpff_record_entry_t *record_entry,
+     int *number_of_child_blocks,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_record_entry_get_data_as_conversation_index_child_block(
+     libpff_record_entry_t *record_entry,
+     int child_block_index,
+     uint64_t *time_delta,
+     uint8_t *random_number,
+     uint8_t *sequence_count,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_record_entry_get_data_as_entry_identifier(
+     libpff_record_entry_t *record_entry,
+     uint32_t *flags,
+     uint8_t *service_provider_identifier,
+     size_t service_provider_identifier_size,
+     libcerror_error_t **error );
+
+LIBPFF_EXTERN \
+int libpff_record_entry_get_data_as_item_identifier(
+     libpff_record_entry_t *record_entry,
+     const uint8_t *record_key,
+     size_t record_key_size,
+     uint32_t *item_identifier,
+     libcerror_error_t **error );
+
 int libpff_record_entry_copy_object_identifier(
      libpff_record_entry_t *record_entry,
      uint32_t *object_identifier,
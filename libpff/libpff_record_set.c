@@ -26,6 +26,7 @@
 #include "libpff_definitions.h"
 #include "libpff_libcerror.h"
 #include "libpff_libuna.h"
+#include "libpff_property_set.h"
 #include "libpff_record_entry.h"
 #include "libpff_record_set.h"
 #include "libpff_types.h"
@@ -1025,3 +1026,172 @@ int libpff_record_set_get_entry_by_utf16_name(
 	return( 0 );
 }
 
+/* Retrieves the record entries matching the requests of a prepared property set
+ * The record entries are stored in the order of the requests, the record entry
+ * of a request that has no matching record entry is set to NULL
+ * The record entries are matched in a single pass over the record set
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_record_set_get_entries_by_property_set(
+     libpff_record_set_t *record_set,
+     libpff_property_set_t *property_set,
+     libpff_record_entry_t **record_entries,
+     int number_of_record_entries,
+     libcerror_error_t **error )
+{
+	libpff_internal_record_entry_t *internal_record_entry = NULL;
+	libpff_internal_record_set_t *internal_record_set     = NULL;
+	static char *function                                 = "libpff_record_set_get_entries_by_property_set";
+	int entry_index                                       = 0;
+	int number_of_entries                                 = 0;
+	int number_of_requests                                = 0;
+	int result                                            = 0;
+
+	if( record_set == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_record_set = (libpff_internal_record_set_t *) record_set;
+
+	result = libpff_property_set_is_prepared(
+	          property_set,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if property set was prepared.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid property set - not prepared.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_property_set_get_number_of_requests(
+	     property_set,
+	     &number_of_requests,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of requests.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_record_entries < number_of_requests )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid number of record entries value too small.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_record_entries;
+	     entry_index++ )
+	{
+		record_entries[ entry_index ] = NULL;
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_record_set->entries_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_record_set->entries_array,
+		     entry_index,
+		     (intptr_t **) &internal_record_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve record entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( internal_record_entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing data record entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( libpff_property_set_match_record_entry(
+		     property_set,
+		     internal_record_entry,
+		     record_entries,
+		     number_of_record_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to match record entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
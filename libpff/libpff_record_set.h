@@ -114,6 +114,14 @@ int libpff_record_set_get_entry_by_utf16_name(
      uint8_t flags,
      libcerror_error_t **error );
 
+LIBPFF_EXTERN \
+int libpff_record_set_get_entries_by_property_set(
+     libpff_record_set_t *record_set,
+     libpff_property_set_t *property_set,
+     libpff_record_entry_t **record_entries,
+     int number_of_record_entries,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -20,13 +20,13 @@
  */
 
 #include <common.h>
-#include <byte_stream.h>
 #include <memory.h>
 #include <types.h>
 
 #include "libpff_data_block.h"
 #include "libpff_definitions.h"
 #include "libpff_descriptors_index.h"
+#include "libpff_format_functions.h"
 #include "libpff_index.h"
 #include "libpff_index_node.h"
 #include "libpff_index_tree.h"
@@ -41,9 +41,7 @@
 #include "libpff_local_descriptor_node.h"
 #include "libpff_offsets_index.h"
 #include "libpff_recover.h"
-
-#include "pff_block.h"
-#include "pff_index_node.h"
+#include "libpff_recovered_index.h"
 
 /* Scans for recoverable items
  * By default only the unallocated space is checked for recoverable items
@@ -56,27 +54,21 @@ int libpff_recover_items(
      libpff_offsets_index_t *offsets_index,
      libcdata_range_list_t *unallocated_data_block_list,
      libcdata_range_list_t *unallocated_page_block_list,
-     libcdata_list_t *recovered_item_list,
+     libcdata_array_t *recovered_item_array,
      uint8_t recovery_flags,
      libcerror_error_t **error )
 {
-	libfdata_tree_node_t *recovered_descriptor_index_leaf_node = NULL;
-	libpff_data_block_t *recovered_data_block                  = NULL;
-	libpff_index_t *recovered_descriptor_index                 = NULL;
-	libpff_index_t *recovered_offset_index                     = NULL;
-	libpff_index_value_t *descriptor_index_value               = NULL;
-	libpff_index_value_t *offset_index_value                   = NULL;
-	libpff_item_descriptor_t *item_descriptor                  = NULL;
-	libcdata_tree_node_t *item_tree_node                       = NULL;
-	static char *function                                      = "libpff_recover_items";
-	int data_identifier_value_index                            = 0;
-	int index_value_iterator                                   = 0;
-	int local_descriptors_identifier_value_index               = 0;
-	int number_of_index_values                                 = 0;
-	int number_of_recovered_descriptor_index_values            = 0;
-	int recovered_descriptor_index_value_iterator              = 0;
-	int recoverable                                            = 0;
-	int result                                                 = 0;
+	libpff_recovered_index_t *recoverable_descriptors_index = NULL;
+	libpff_index_value_t *descriptor_index_value            = NULL;
+	libpff_item_descriptor_t *item_descriptor               = NULL;
+	libcdata_tree_node_t *item_tree_node                    = NULL;
+	static char *function                                   = "libpff_recover_items";
+	uint8_t read_data                                       = 0;
+	uint8_t supported_recovery_flags                        = 0;
+	int entry_index                                         = 0;
+	int number_of_recovered_descriptor_index_values         = 0;
+	int recovered_descriptor_index_value_iterator           = 0;
+	int recoverable                                         = 0;
 
 	if( io_handle == NULL )
 	{
@@ -102,17 +94,36 @@ int libpff_recover_items(
 
 		return( -1 );
 	}
-	if( recovered_item_list == NULL )
+	if( recovered_item_array == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid recovered item list.",
+		 "%s: invalid recovered item array.",
+		 function );
+
+		return( -1 );
+	}
+	supported_recovery_flags = LIBPFF_RECOVERY_FLAG_IGNORE_ALLOCATION_DATA
+	                         | LIBPFF_RECOVERY_FLAG_SCAN_FOR_FRAGMENTS
+	                         | LIBPFF_RECOVERY_FLAG_DEFER_VALIDATION;
+
+	if( ( recovery_flags & ~( supported_recovery_flags ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported recovery flags.",
 		 function );
 
 		return( -1 );
 	}
+	if( ( recovery_flags & LIBPFF_RECOVERY_FLAG_DEFER_VALIDATION ) == 0 )
+	{
+		read_data = 1;
+	}
 	if( libpff_descriptors_index_set_root_node(
 	     descriptors_index,
 	     0,
@@ -183,7 +194,7 @@ int libpff_recover_items(
 	     offsets_index,
 	     unallocated_data_block_list,
 	     unallocated_page_block_list,
-	     recovery_flags,
+	     recovery_flags & ~( LIBPFF_RECOVERY_FLAG_DEFER_VALIDATION ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -195,13 +206,54 @@ int libpff_recover_items(
 
 		goto on_error;
 	}
-	/* For the recovered descriptor index nodes check
+	/* Sort the recovered index values so they can be looked up by identifier
+	 */
+	if( libpff_recovered_index_finalize(
+	     descriptors_index->recovered_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize recovered descriptors index.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_recovered_index_finalize(
+	     offsets_index->recovered_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize recovered offsets index.",
+		 function );
+
+		goto on_error;
+	}
+	/* For the recovered descriptor index values check
 	 * if the local descriptor and data offset index value still exists
+	 * the recoverable descriptor index values replace the recovered descriptors index
 	 */
-	if( libpff_index_tree_get_number_of_leaf_nodes(
-	     descriptors_index->recovered_index_tree,
-	     file_io_handle,
-	     (libfdata_cache_t *) descriptors_index->index_cache,
+	if( libpff_recovered_index_initialize(
+	     &recoverable_descriptors_index,
+	     LIBPFF_INDEX_TYPE_DESCRIPTOR,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create recoverable descriptors index.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_recovered_index_get_number_of_index_values(
+	     descriptors_index->recovered_index,
 	     &number_of_recovered_descriptor_index_values,
 	     error ) != 1 )
 	{
@@ -222,30 +274,10 @@ int libpff_recover_items(
 		{
 			goto on_error;
 		}
-		if( libpff_index_tree_get_leaf_node_by_index(
-		     descriptors_index->recovered_index_tree,
-		     file_io_handle,
-		     (libfdata_cache_t *) descriptors_index->index_cache,
+		if( libpff_recovered_index_get_index_value_by_index(
+		     descriptors_index->recovered_index,
 		     recovered_descriptor_index_value_iterator,
-		     &recovered_descriptor_index_leaf_node,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: unable to retrieve recovered descriptor leaf node: %d.",
-			 function,
-			 recovered_descriptor_index_value_iterator );
-
-			goto on_error;
-		}
-		if( libfdata_tree_node_get_node_value(
-		     recovered_descriptor_index_leaf_node,
-		     (intptr_t *) file_io_handle,
-		     (libfdata_cache_t *) descriptors_index->index_cache,
-		     (intptr_t **) &descriptor_index_value,
-		     0,
+		     &descriptor_index_value,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -282,391 +314,550 @@ int libpff_recover_items(
 			 descriptor_index_value->parent_identifier );
 		}
 #endif
-		recoverable = 1;
+		/* Create a new item descriptor
+		 */
+		if( libpff_item_descriptor_initialize(
+		     &item_descriptor,
+		     (uint32_t) descriptor_index_value->identifier,
+		     descriptor_index_value->data_identifier,
+		     descriptor_index_value->local_descriptors_identifier,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create item descriptor.",
+			 function );
 
-		/* Check if the data identifier is recoverable
+			goto on_error;
+		}
+		/* When validation is deferred the data block and local descriptors
+		 * are read when the recovered item is first opened
 		 */
-		if( recoverable != 0 )
+		recoverable = libpff_recover_validate_item_descriptor(
+		               io_handle,
+		               file_io_handle,
+		               offsets_index,
+		               item_descriptor,
+		               read_data,
+		               error );
+
+		if( recoverable == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to validate item descriptor: %" PRIu64 ".",
+			 function,
+			 descriptor_index_value->identifier );
+
+			goto on_error;
+		}
+		else if( recoverable == 0 )
 		{
-			if( libpff_index_tree_get_number_of_leaf_nodes_by_identifier(
-			     offsets_index->recovered_index_tree,
-			     file_io_handle,
-			     offsets_index->index_cache,
-			     descriptor_index_value->data_identifier & (uint64_t) LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK,
-			     &number_of_index_values,
+			if( libpff_item_descriptor_free(
+			     &item_descriptor,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve number of recovered offset index values for data identifier: %" PRIu64 ".",
-				 function,
-				 descriptor_index_value->data_identifier & (uint64_t) LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK );
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free item descriptor.",
+				 function );
 
 				goto on_error;
 			}
-/* TODO what if more than 1 identifier is recoverable ? now uses first come first serve */
-			result = 0;
+			continue;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: item descriptor: %" PRIu64 " is recoverable.\n",
+			 function,
+			 descriptor_index_value->identifier );
+		}
+#endif
+		if( libpff_recovered_index_append_index_value(
+		     recoverable_descriptors_index,
+		     descriptor_index_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append descriptor index value: %" PRIu64 " to recoverable descriptors index.",
+			 function,
+			 descriptor_index_value->identifier );
 
-			for( index_value_iterator = 0;
-			     index_value_iterator < number_of_index_values;
-			     index_value_iterator++ )
-			{
-				result = libpff_index_tree_get_value_by_identifier(
-					  offsets_index->recovered_index_tree,
-					  file_io_handle,
-					  offsets_index->index_cache,
-					  descriptor_index_value->data_identifier & (uint64_t) LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK,
-					  index_value_iterator,
-					  &offset_index_value,
-					  error );
+			goto on_error;
+		}
+		/* Create a new tree node with item tree values
+		 */
+		if( libcdata_tree_node_initialize(
+		     &item_tree_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create item tree node.",
+			 function );
 
-				if( result == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve recovered offset index value for data identifier: %" PRIu64 ".",
-					 function,
-					 descriptor_index_value->data_identifier & (uint64_t) LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK );
+			goto on_error;
+		}
+		if( libcdata_tree_node_set_value(
+		     item_tree_node,
+		     (intptr_t *) item_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set item descriptor in item tree node.",
+			 function );
 
-					goto on_error;
-				}
-				else if( result != 0 )
-				{
-					/* Check if the data block is readable
-					 */
-					if( libpff_data_block_initialize(
-					     &recovered_data_block,
-					     io_handle,
-					     (uint32_t) descriptor_index_value->identifier,
-					     offset_index_value->identifier,
-					     error ) != 1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-						 "%s: unable to create data block.",
-						 function );
+			goto on_error;
+		}
+		item_descriptor = NULL;
 
-						goto on_error;
-					}
-#if defined( HAVE_DEBUG_OUTPUT )
-					if( libcnotify_verbose != 0 )
-					{
-						libcnotify_printf(
-						 "%s: attempting to read data block at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-						 function,
-						 offset_index_value->file_offset,
-						 offset_index_value->file_offset );
-					}
-#endif
-					result = libpff_data_block_read_file_io_handle(
-					          recovered_data_block,
-					          file_io_handle,
-					          offset_index_value->file_offset,
-					          offset_index_value->data_size,
-					          io_handle->file_type,
-					          error );
-
-					if( result != 1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 "%s: unable to read data block.",
-						 function );
+		if( libcdata_array_append_entry(
+		     recovered_item_array,
+		     &entry_index,
+		     (intptr_t *) item_tree_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append tree node to recovered item array.",
+			 function );
+
+			goto on_error;
+		}
+		item_tree_node = NULL;
+	}
 #if defined( HAVE_DEBUG_OUTPUT )
-						if( ( libcnotify_verbose != 0 )
-						 && ( error != NULL )
-						 && ( *error != NULL ) )
-						{
-							libcnotify_print_error_backtrace(
-							 *error );
-						}
+	if( libbfio_handle_set_track_offsets_read(
+	     file_io_handle,
+	     0,
+	     error ) != 1 )
+	{
+                libcerror_error_set(
+                 error,
+                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+                 "%s: unable to set track offsets read in file IO handle.",
+                 function );
+
+                goto on_error;
+	}
 #endif
-						libcerror_error_free(
-						 error );
+	/* The recoverable descriptor index values were appended in order
+	 */
+	if( libpff_recovered_index_finalize(
+	     recoverable_descriptors_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize recoverable descriptors index.",
+		 function );
 
-/* TODO delete unreadable offset identifier in offsets_index->recovered_index_tree */
-					}
-					if( libpff_data_block_free(
-					     &recovered_data_block,
-					     error ) != 1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-						 "%s: unable to free recovered data block.",
-						 function );
+		goto on_error;
+	}
+	if( libpff_recovered_index_free(
+	     &( descriptors_index->recovered_index ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free recovered descriptors index.",
+		 function );
 
-						goto on_error;
-					}
-/* TODO validate the block data ? */
-					if( result == 1 )
-					{
-						break;
-					}
-				}
-			}
-			if( result == 0 )
-			{
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: recovered offset index value for data identifier: %" PRIu64 " not available.\n",
-					 function,
-					 descriptor_index_value->data_identifier & (uint64_t) LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK );
-				}
-#endif
-				recoverable = 0;
-			}
-			else
-			{
-				data_identifier_value_index = index_value_iterator;
-			}
-		}
-		/* Check if the local descriptors are also recoverable
-		 */
-		if( recoverable != 0 )
-		{
-			/* Allow desciptors to have a zero local descriptors value
-			 */
-			if( descriptor_index_value->local_descriptors_identifier > 0 )
-			{
-				if( libpff_index_tree_get_number_of_leaf_nodes_by_identifier(
-				     offsets_index->recovered_index_tree,
-				     file_io_handle,
-				     offsets_index->index_cache,
-				     descriptor_index_value->local_descriptors_identifier & (uint64_t) LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK,
-				     &number_of_index_values,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve number of recovered offset index values for local descriptors identifier: %" PRIu64 ".",
-					 function,
-					 descriptor_index_value->local_descriptors_identifier & (uint64_t) LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK );
+		goto on_error;
+	}
+	descriptors_index->recovered_index = recoverable_descriptors_index;
+	recoverable_descriptors_index      = NULL;
 
-					goto on_error;
-				}
-/* TODO what if more than 1 identifier is recoverable ? now uses first come first serve */
-				result = 0;
+	/* Sort the recovered items so they can be looked up by identifier
+	 */
+	if( libpff_item_tree_sort_nodes_by_identifier(
+	     recovered_item_array,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to sort recovered items.",
+		 function );
 
-				for( index_value_iterator = 0;
-				     index_value_iterator < number_of_index_values;
-				     index_value_iterator++ )
-				{
-					result = libpff_index_tree_get_value_by_identifier(
-						  offsets_index->recovered_index_tree,
-						  file_io_handle,
-						  offsets_index->index_cache,
-						  descriptor_index_value->local_descriptors_identifier & (uint64_t) LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK,
-						  index_value_iterator,
-						  &offset_index_value,
-						  error );
+		goto on_error;
+	}
+	/* TODO
+	 * link recovered descriptors to parent? and add to item hierarchy?
+	 * handle scanning without index data
+	 * what about 'encryption' ?
+	 */
+	return( 1 );
 
-					if( result == -1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-						 "%s: unable to retrieve recovered offset index value for local descriptors identifier: %" PRIu64 ".",
-						 function,
-						 descriptor_index_value->local_descriptors_identifier & (uint64_t) LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK );
+on_error:
+	if( item_tree_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 &item_tree_node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_descriptor_free,
+		 NULL );
+	}
+	if( item_descriptor != NULL )
+	{
+		libpff_item_descriptor_free(
+		 &item_descriptor,
+		 NULL );
+	}
+	if( recoverable_descriptors_index != NULL )
+	{
+		libpff_recovered_index_free(
+		 &recoverable_descriptors_index,
+		 NULL );
+	}
+	libcdata_array_empty(
+	 recovered_item_array,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_tree_node_free_recovered,
+	 NULL );
 
-						goto on_error;
-					}
-					else if( result != 0 )
-					{
-						/* Check if local descriptors are readable
-						 */
-						result = libpff_recover_local_descriptors(
-							  io_handle,
-							  file_io_handle,
-							  offsets_index,
-							  descriptor_index_value->local_descriptors_identifier,
-							  error );
-
-						if( result == -1 )
-						{
-							libcerror_error_set(
-							 error,
-							 LIBCERROR_ERROR_DOMAIN_IO,
-							 LIBCERROR_IO_ERROR_READ_FAILED,
-							 "%s: unable to read local descriptors with identifier: %" PRIu64 ".",
-							 function,
-							 descriptor_index_value->local_descriptors_identifier );
+	return( -1 );
+}
 
-							goto on_error;
-						}
-						else if( result != 0 )
-						{
-							break;
-						}
-					}
-				}
-				if( result == 0 )
-				{
-#if defined( HAVE_DEBUG_OUTPUT )
-					if( libcnotify_verbose != 0 )
-					{
-						libcnotify_printf(
-						 "%s: recovered offset index value for local descriptors identifier: %" PRIu64 " not available.\n",
-						 function,
-						 descriptor_index_value->local_descriptors_identifier & (uint64_t) LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK );
-					}
-#endif
-					recoverable = 0;
-				}
-				if( recoverable != 0 )
-				{
-					local_descriptors_identifier_value_index = index_value_iterator;
-				}
-			}
-		}
-		if( recoverable == 0 )
+/* Validates a recovered item descriptor
+ * Checks if recovered offset index values exist for the data and local descriptors identifiers,
+ * if read_data is set the corresponding data block and local descriptors are read as well
+ * Sets the recovered value indexes and the validation status of the item descriptor
+ * Returns 1 if the item descriptor is recoverable, 0 if not or -1 on error
+ */
+int libpff_recover_validate_item_descriptor(
+     libpff_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libpff_offsets_index_t *offsets_index,
+     libpff_item_descriptor_t *item_descriptor,
+     uint8_t read_data,
+     libcerror_error_t **error )
+{
+	libpff_data_block_t *recovered_data_block    = NULL;
+	libpff_index_value_t *offset_index_value     = NULL;
+	static char *function                        = "libpff_recover_validate_item_descriptor";
+	int data_identifier_value_index              = 0;
+	int index_value_iterator                     = 0;
+	int local_descriptors_identifier_value_index = 0;
+	int number_of_index_values                   = 0;
+	int result                                   = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offsets_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offsets index.",
+		 function );
+
+		return( -1 );
+	}
+	if( item_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	/* Check if the data identifier is recoverable
+	 */
+	if( libpff_recovered_index_get_number_of_index_values_by_identifier(
+	     offsets_index->recovered_index,
+	     item_descriptor->data_identifier & (uint64_t) LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK,
+	     &number_of_index_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of recovered offset index values for data identifier: %" PRIu64 ".",
+		 function,
+		 item_descriptor->data_identifier & (uint64_t) LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK );
+
+		goto on_error;
+	}
+/* TODO what if more than 1 identifier is recoverable ? now uses first come first serve */
+	result = 0;
+
+	for( index_value_iterator = 0;
+	     index_value_iterator < number_of_index_values;
+	     index_value_iterator++ )
+	{
+		result = libpff_recovered_index_get_index_value_by_identifier(
+			  offsets_index->recovered_index,
+			  item_descriptor->data_identifier & (uint64_t) LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK,
+			  index_value_iterator,
+			  &offset_index_value,
+			  error );
+
+		if( result == -1 )
 		{
-			if( libfdata_tree_node_set_deleted(
-			     recovered_descriptor_index_leaf_node,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set deleted in recovered index tree leaf node: %d.",
-				 function,
-				 recovered_descriptor_index_value_iterator );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve recovered offset index value for data identifier: %" PRIu64 ".",
+			 function,
+			 item_descriptor->data_identifier & (uint64_t) LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK );
 
-				goto on_error;
-			}
-			number_of_recovered_descriptor_index_values--;
-			recovered_descriptor_index_value_iterator--;
+			goto on_error;
 		}
-		else
+		else if( result != 0 )
 		{
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
+			if( read_data == 0 )
 			{
-				libcnotify_printf(
-				 "%s: item descriptor: %" PRIu64 " is recoverable.\n",
-				 function,
-				 descriptor_index_value->identifier );
+				break;
 			}
-#endif
-			/* Create a new item descriptor
+			/* Check if the data block is readable
 			 */
-			if( libpff_item_descriptor_initialize(
-			     &item_descriptor,
-			     (uint32_t) descriptor_index_value->identifier,
-			     descriptor_index_value->data_identifier,
-			     descriptor_index_value->local_descriptors_identifier,
-			     1,
+			if( libpff_data_block_initialize(
+			     &recovered_data_block,
+			     io_handle,
+			     item_descriptor->descriptor_identifier,
+			     offset_index_value->identifier,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create item descriptor.",
+				 "%s: unable to create data block.",
 				 function );
 
 				goto on_error;
 			}
-			if( item_descriptor == NULL )
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing item descriptor.",
-				 function );
-
-				goto on_error;
+				libcnotify_printf(
+				 "%s: attempting to read data block at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+				 function,
+				 offset_index_value->file_offset,
+				 offset_index_value->file_offset );
 			}
-/* TODO add to initialize function or create a separate function for setting these value in the item descriptor */
-			item_descriptor->recovered_data_identifier_value_index              = data_identifier_value_index;
-			item_descriptor->recovered_local_descriptors_identifier_value_index = local_descriptors_identifier_value_index;
+#endif
+			result = libpff_data_block_read_file_io_handle(
+			          recovered_data_block,
+			          file_io_handle,
+			          offset_index_value->file_offset,
+			          offset_index_value->data_size,
+			          io_handle->file_type,
+			          error );
 
-			/* Create a new tree node with item tree values
-			 */
-			if( libcdata_tree_node_initialize(
-			     &item_tree_node,
-			     error ) != 1 )
+			if( result != 1 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create item tree node.",
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read data block.",
 				 function );
 
-				goto on_error;
+				if( io_handle->read_limits_exceeded != 0 )
+				{
+					goto on_error;
+				}
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( ( libcnotify_verbose != 0 )
+				 && ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+#endif
+				libcerror_error_free(
+				 error );
+
+				result = 0;
+
+/* TODO delete unreadable offset identifier in offsets_index->recovered_index */
 			}
-			if( libcdata_tree_node_set_value(
-			     item_tree_node,
-			     (intptr_t *) item_descriptor,
+			if( libpff_data_block_free(
+			     &recovered_data_block,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set item descriptor in item tree node.",
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free recovered data block.",
 				 function );
 
 				goto on_error;
 			}
-			item_descriptor = NULL;
+/* TODO validate the block data ? */
+			if( result == 1 )
+			{
+				break;
+			}
+		}
+	}
+	if( result == 0 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: recovered offset index value for data identifier: %" PRIu64 " not available.\n",
+			 function,
+			 item_descriptor->data_identifier & (uint64_t) LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK );
+		}
+#endif
+		item_descriptor->validation_status = LIBPFF_VALIDATION_STATUS_INVALID;
 
-			if( libcdata_list_append_value(
-			     recovered_item_list,
-			     (intptr_t *) item_tree_node,
-			     error ) != 1 )
+		return( 0 );
+	}
+	data_identifier_value_index = index_value_iterator;
+
+	/* Check if the local descriptors are also recoverable
+	 * Allow desciptors to have a zero local descriptors value
+	 */
+	if( item_descriptor->local_descriptors_identifier > 0 )
+	{
+		if( libpff_recovered_index_get_number_of_index_values_by_identifier(
+		     offsets_index->recovered_index,
+		     item_descriptor->local_descriptors_identifier & (uint64_t) LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK,
+		     &number_of_index_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of recovered offset index values for local descriptors identifier: %" PRIu64 ".",
+			 function,
+			 item_descriptor->local_descriptors_identifier & (uint64_t) LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK );
+
+			goto on_error;
+		}
+/* TODO what if more than 1 identifier is recoverable ? now uses first come first serve */
+		result = 0;
+
+		for( index_value_iterator = 0;
+		     index_value_iterator < number_of_index_values;
+		     index_value_iterator++ )
+		{
+			result = libpff_recovered_index_get_index_value_by_identifier(
+				  offsets_index->recovered_index,
+				  item_descriptor->local_descriptors_identifier & (uint64_t) LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK,
+				  index_value_iterator,
+				  &offset_index_value,
+				  error );
+
+			if( result == -1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to append tree node to recovered item list.",
-				 function );
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve recovered offset index value for local descriptors identifier: %" PRIu64 ".",
+				 function,
+				 item_descriptor->local_descriptors_identifier & (uint64_t) LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK );
 
 				goto on_error;
 			}
-			item_tree_node = NULL;
+			else if( result != 0 )
+			{
+				if( read_data == 0 )
+				{
+					break;
+				}
+				/* Check if local descriptors are readable
+				 */
+				result = libpff_recover_local_descriptors(
+					  io_handle,
+					  file_io_handle,
+					  offsets_index,
+					  item_descriptor->local_descriptors_identifier,
+					  error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read local descriptors with identifier: %" PRIu64 ".",
+					 function,
+					 item_descriptor->local_descriptors_identifier );
+
+					goto on_error;
+				}
+				else if( result != 0 )
+				{
+					break;
+				}
+			}
 		}
-	}
+		if( result == 0 )
+		{
 #if defined( HAVE_DEBUG_OUTPUT )
-	if( libbfio_handle_set_track_offsets_read(
-	     file_io_handle,
-	     0,
-	     error ) != 1 )
-	{
-                libcerror_error_set(
-                 error,
-                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-                 "%s: unable to set track offsets read in file IO handle.",
-                 function );
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: recovered offset index value for local descriptors identifier: %" PRIu64 " not available.\n",
+				 function,
+				 item_descriptor->local_descriptors_identifier & (uint64_t) LIBPFF_OFFSET_INDEX_IDENTIFIER_MASK );
+			}
+#endif
+			item_descriptor->validation_status = LIBPFF_VALIDATION_STATUS_INVALID;
 
-                goto on_error;
+			return( 0 );
+		}
+		local_descriptors_identifier_value_index = index_value_iterator;
+	}
+	item_descriptor->recovered_data_identifier_value_index              = data_identifier_value_index;
+	item_descriptor->recovered_local_descriptors_identifier_value_index = local_descriptors_identifier_value_index;
+
+	if( read_data != 0 )
+	{
+		item_descriptor->validation_status = LIBPFF_VALIDATION_STATUS_VALID;
+	}
+	else
+	{
+		item_descriptor->validation_status = LIBPFF_VALIDATION_STATUS_PENDING;
 	}
-#endif
-	/* TODO
-	 * link recovered descriptors to parent? and add to item hierarchy?
-	 * handle scanning without index data
-	 * what about 'encryption' ?
-	 */
 	return( 1 );
 
 on_error:
@@ -676,36 +867,6 @@ on_error:
 		 &recovered_data_block,
 		 NULL );
 	}
-	if( item_tree_node != NULL )
-	{
-		libcdata_tree_node_free(
-		 &item_tree_node,
-		 (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_descriptor_free,
-		 NULL );
-	}
-	if( item_descriptor != NULL )
-	{
-		libpff_item_descriptor_free(
-		 &item_descriptor,
-		 NULL );
-	}
-	if( recovered_offset_index != NULL )
-	{
-		libpff_index_free(
-		 &recovered_offset_index,
-		 NULL );
-	}
-	if( recovered_descriptor_index != NULL )
-	{
-		libpff_index_free(
-		 &recovered_descriptor_index,
-		 NULL );
-	}
-	libcdata_list_empty(
-	 recovered_item_list,
-	 (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_tree_node_free_recovered,
-	 NULL );
-
 	return( -1 );
 }
 
@@ -722,13 +883,7 @@ int libpff_recover_index_nodes(
 	libpff_index_value_t *deleted_index_value     = NULL;
 	libpff_index_value_t *index_value             = NULL;
 	static char *function                         = "libpff_recover_index_nodes";
-	off64_t node_data_offset                      = 0;
-	size64_t node_data_size                       = 0;
-	uint32_t node_data_flags                      = 0;
 	int deleted_index_value_iterator              = 0;
-	int index_value_iterator                      = 0;
-	int node_data_file_index                      = 0;
-	int number_of_index_values                    = 0;
 	int number_of_deleted_index_values            = 0;
 	int result                                    = 0;
 
@@ -904,62 +1059,23 @@ int libpff_recover_index_nodes(
 		}
 		/* Check for duplicates
 		 */
-		if( libpff_index_tree_get_number_of_leaf_nodes_by_identifier(
-		     descriptors_index->recovered_index_tree,
-		     file_io_handle,
-		     descriptors_index->index_cache,
-		     deleted_index_value->identifier,
-		     &number_of_index_values,
-		     error ) != 1 )
+		result = libpff_recovered_index_has_index_value(
+			  descriptors_index->recovered_index,
+			  deleted_index_value,
+			  error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve number of recovered descriptor index values for identifier: %" PRIu64 ".",
+			 "%s: unable to determine if recovered descriptor index value: %" PRIu64 " exists.",
 			 function,
 			 deleted_index_value->identifier );
 
 			return( -1 );
 		}
-		result = 0;
-
-		for( index_value_iterator = 0;
-		     index_value_iterator < number_of_index_values;
-		     index_value_iterator++ )
-		{
-			result = libpff_index_tree_get_value_by_identifier(
-				  descriptors_index->recovered_index_tree,
-				  file_io_handle,
-				  descriptors_index->index_cache,
-				  deleted_index_value->identifier,
-				  index_value_iterator,
-				  &index_value,
-				  error );
-
-			if( result == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve recovered descriptor index value for identifier: %" PRIu64 ".",
-				 function,
-				 deleted_index_value->identifier );
-
-				return( -1 );
-			}
-			else if( result != 0 )
-			{
-/* TODO what about parent changes ? */
-				if( ( deleted_index_value->data_identifier == index_value->data_identifier )
-				 && ( deleted_index_value->local_descriptors_identifier == index_value->local_descriptors_identifier ) )
-				{
-					break;
-				}
-				result = 0;
-			}
-		}
 		if( result != 0 )
 		{
 #if defined( HAVE_DEBUG_OUTPUT )
@@ -985,38 +1101,16 @@ int libpff_recover_index_nodes(
 			 deleted_index_value->identifier );
 		}
 #endif
-		if( libfdata_tree_node_get_data_range(
-		     deleted_index_leaf_node,
-		     &node_data_file_index,
-		     &node_data_offset,
-		     &node_data_size,
-		     &node_data_flags,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve deleted descriptor leaf node: %d range.",
-			 function,
-			 deleted_index_value_iterator );
-
-			return( -1 );
-		}
-		if( libpff_index_tree_insert_value(
-		     descriptors_index->recovered_index_tree,
-		     file_io_handle,
-		     descriptors_index->index_cache,
-		     deleted_index_value->identifier,
-		     node_data_offset,
-		     node_data_size,
+		if( libpff_recovered_index_append_index_value(
+		     descriptors_index->recovered_index,
+		     deleted_index_value,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to insert descriptor index value: %" PRIu64 " to recovered index tree.",
+			 "%s: unable to append descriptor index value: %" PRIu64 " to recovered index.",
 			 function,
 			 deleted_index_value->identifier );
 
@@ -1185,61 +1279,23 @@ int libpff_recover_index_nodes(
 		}
 		/* Check for duplicates
 		 */
-		if( libpff_index_tree_get_number_of_leaf_nodes_by_identifier(
-		     offsets_index->recovered_index_tree,
-		     file_io_handle,
-		     offsets_index->index_cache,
-		     deleted_index_value->identifier,
-		     &number_of_index_values,
-		     error ) != 1 )
+		result = libpff_recovered_index_has_index_value(
+			  offsets_index->recovered_index,
+			  deleted_index_value,
+			  error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve number of recovered offset index values for identifier: %" PRIu64 ".",
+			 "%s: unable to determine if recovered offset index value: %" PRIu64 " exists.",
 			 function,
 			 deleted_index_value->identifier );
 
 			return( -1 );
 		}
-		result = 0;
-
-		for( index_value_iterator = 0;
-		     index_value_iterator < number_of_index_values;
-		     index_value_iterator++ )
-		{
-			result = libpff_index_tree_get_value_by_identifier(
-				  offsets_index->recovered_index_tree,
-				  file_io_handle,
-				  offsets_index->index_cache,
-				  deleted_index_value->identifier,
-				  index_value_iterator,
-				  &index_value,
-				  error );
-
-			if( result == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve recovered offset index value for identifier: %" PRIu64 ".",
-				 function,
-				 deleted_index_value->identifier );
-
-				return( -1 );
-			}
-			else if( result != 0 )
-			{
-				if( ( deleted_index_value->file_offset == index_value->file_offset )
-				 && ( deleted_index_value->data_size == index_value->data_size ) )
-				{
-					break;
-				}
-				result = 0;
-			}
-		}
 		if( result != 0 )
 		{
 #if defined( HAVE_DEBUG_OUTPUT )
@@ -1265,38 +1321,16 @@ int libpff_recover_index_nodes(
 			 deleted_index_value->identifier );
 		}
 #endif
-		if( libfdata_tree_node_get_data_range(
-		     deleted_index_leaf_node,
-		     &node_data_file_index,
-		     &node_data_offset,
-		     &node_data_size,
-		     &node_data_flags,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve deleted offset leaf node: %d range.",
-			 function,
-			 deleted_index_value_iterator );
-
-			return( -1 );
-		}
-		if( libpff_index_tree_insert_value(
-		     offsets_index->recovered_index_tree,
-		     file_io_handle,
-		     offsets_index->index_cache,
-		     deleted_index_value->identifier,
-		     node_data_offset,
-		     node_data_size,
+		if( libpff_recovered_index_append_index_value(
+		     offsets_index->recovered_index,
+		     deleted_index_value,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to insert offset index value: %" PRIu64 " to recovered index tree.",
+			 "%s: unable to append offset index value: %" PRIu64 " to recovered index.",
 			 function,
 			 deleted_index_value->identifier );
 
@@ -1320,39 +1354,39 @@ int libpff_recover_data_blocks(
      uint8_t recovery_flags,
      libcerror_error_t **error )
 {
-	libpff_index_value_t *index_value       = NULL;
-	uint8_t *block_buffer                   = NULL;
-	uint8_t *data_block_footer              = NULL;
-	intptr_t *value                         = NULL;
-	static char *function                   = "libpff_recover_data_blocks";
-	off64_t block_buffer_data_offset        = 0;
-	off64_t block_offset                    = 0;
-	off64_t data_block_offset               = 0;
-	off64_t page_block_offset               = 0;
-	size64_t block_size                     = 0;
-	size64_t data_block_size                = 0;
-	size64_t page_block_size                = 0;
-	size_t block_buffer_offset              = 0;
-	size_t block_buffer_size_available      = 0;
-	size_t data_block_data_offset           = 0;
-	size_t read_size                        = 0;
-	ssize_t read_count                      = 0;
-	uint64_t data_block_back_pointer        = 0;
-	uint32_t data_block_calculated_checksum = 0;
-	uint32_t data_block_stored_checksum     = 0;
-	uint32_t maximum_data_block_size        = 0;
-	uint16_t data_block_data_size           = 0;
-	uint16_t format_data_block_size         = 0;
-	uint16_t format_page_block_size         = 0;
-	uint16_t scan_block_size                = 0;
-	uint8_t supported_recovery_flags        = 0;
-	int index_value_iterator                = 0;
-	int number_of_index_values              = 0;
-	int number_of_unallocated_data_blocks   = 0;
-	int number_of_unallocated_page_blocks   = 0;
-	int result                              = 0;
-	int unallocated_data_block_index        = 0;
-	int unallocated_page_block_index        = 0;
+	libpff_index_value_t data_block_index_value;
+
+	const libpff_format_functions_t *format_functions = NULL;
+	uint8_t *block_buffer                             = NULL;
+	uint8_t *data_block_footer                        = NULL;
+	intptr_t *value                                   = NULL;
+	static char *function                             = "libpff_recover_data_blocks";
+	off64_t block_buffer_data_offset                  = 0;
+	off64_t block_offset                              = 0;
+	off64_t data_block_offset                         = 0;
+	off64_t page_block_offset                         = 0;
+	size64_t block_size                               = 0;
+	size64_t data_block_size                          = 0;
+	size64_t page_block_size                          = 0;
+	size_t block_buffer_offset                        = 0;
+	size_t block_buffer_size_available                = 0;
+	size_t data_block_data_offset                     = 0;
+	size_t read_size                                  = 0;
+	ssize_t read_count                                = 0;
+	uint64_t data_block_back_pointer                  = 0;
+	uint32_t data_block_calculated_checksum           = 0;
+	uint32_t data_block_stored_checksum               = 0;
+	uint32_t maximum_data_block_size                  = 0;
+	uint16_t data_block_data_size                     = 0;
+	uint16_t format_data_block_size                   = 0;
+	uint16_t format_page_block_size                   = 0;
+	uint16_t scan_block_size                          = 0;
+	uint8_t supported_recovery_flags                  = 0;
+	int number_of_unallocated_data_blocks             = 0;
+	int number_of_unallocated_page_blocks             = 0;
+	int result                                        = 0;
+	int unallocated_data_block_index                  = 0;
+	int unallocated_page_block_index                  = 0;
 
 	if( io_handle == NULL )
 	{
@@ -1378,6 +1412,33 @@ int libpff_recover_data_blocks(
 
 		return( -1 );
 	}
+	format_functions = io_handle->format_functions;
+
+	if( format_functions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing format functions.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &data_block_index_value,
+	     0,
+	     sizeof( libpff_index_value_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data block index value.",
+		 function );
+
+		return( -1 );
+	}
 	if( ( io_handle->file_type == LIBPFF_FILE_TYPE_32BIT )
 	 || ( io_handle->file_type == LIBPFF_FILE_TYPE_64BIT ) )
 	{
@@ -1676,6 +1737,22 @@ int libpff_recover_data_blocks(
 						 read_size );
 					}
 #endif
+					if( libpff_io_handle_check_read_limits(
+					     io_handle,
+					     read_size,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_ABORT_REQUESTED,
+						 "%s: unable to read data block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+						 function,
+						 block_buffer_data_offset,
+						 block_buffer_data_offset );
+
+						goto on_error;
+					}
 					read_count = libbfio_handle_read_buffer_at_offset(
 						      file_io_handle,
 						      &( block_buffer[ block_buffer_offset ] ),
@@ -1704,48 +1781,14 @@ int libpff_recover_data_blocks(
 					 */
 					data_block_footer = &( block_buffer[ block_buffer_offset ] );
 
-					if( io_handle->file_type == LIBPFF_FILE_TYPE_32BIT )
-					{
-						data_block_footer += format_data_block_size - sizeof( pff_block_footer_32bit_t );
-
-						byte_stream_copy_to_uint16_little_endian(
-						 ( (pff_block_footer_32bit_t *) data_block_footer )->data_size,
-						 data_block_data_size );
-						byte_stream_copy_to_uint32_little_endian(
-						 ( (pff_block_footer_32bit_t *) data_block_footer )->back_pointer,
-						 data_block_back_pointer );
-						byte_stream_copy_to_uint32_little_endian(
-						 ( (pff_block_footer_32bit_t *) data_block_footer )->checksum,
-						 data_block_stored_checksum );
-					}
-					else if( io_handle->file_type == LIBPFF_FILE_TYPE_64BIT )
-					{
-						data_block_footer += format_data_block_size - sizeof( pff_block_footer_64bit_t );
-
-						byte_stream_copy_to_uint16_little_endian(
-						 ( (pff_block_footer_64bit_t *) data_block_footer )->data_size,
-						 data_block_data_size );
-						byte_stream_copy_to_uint32_little_endian(
-						 ( (pff_block_footer_64bit_t *) data_block_footer )->checksum,
-						 data_block_stored_checksum );
-						byte_stream_copy_to_uint64_little_endian(
-						 ( (pff_block_footer_64bit_t *) data_block_footer )->back_pointer,
-						 data_block_back_pointer );
-					}
-					else if( io_handle->file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE )
-					{
-						data_block_footer += format_data_block_size - sizeof( pff_block_footer_64bit_4k_page_t );
-
-						byte_stream_copy_to_uint16_little_endian(
-						 ( (pff_block_footer_64bit_4k_page_t *) data_block_footer )->data_size,
-						 data_block_data_size );
-						byte_stream_copy_to_uint32_little_endian(
-						 ( (pff_block_footer_64bit_4k_page_t *) data_block_footer )->checksum,
-						 data_block_stored_checksum );
-						byte_stream_copy_to_uint64_little_endian(
-						 ( (pff_block_footer_64bit_4k_page_t *) data_block_footer )->back_pointer,
-						 data_block_back_pointer );
-					}
+					data_block_footer += format_data_block_size - format_functions->data_block_footer_size;
+
+					format_functions->read_data_block_footer(
+					 data_block_footer,
+					 &data_block_data_size,
+					 &data_block_stored_checksum,
+					 &data_block_back_pointer );
+
 					/* Check if back pointer itself is not empty but the upper 32-bit are
 					 */
 					if( ( data_block_back_pointer != 0 )
@@ -1757,61 +1800,27 @@ int libpff_recover_data_blocks(
 						{
 							/* Check for duplicates
 							 */
-							if( libpff_index_tree_get_number_of_leaf_nodes_by_identifier(
-							     offsets_index->recovered_index_tree,
-							     file_io_handle,
-							     offsets_index->index_cache,
-							     data_block_back_pointer,
-							     &number_of_index_values,
-							     error ) != 1 )
+							data_block_index_value.identifier  = data_block_back_pointer;
+							data_block_index_value.file_offset = (off64_t) ( block_buffer_data_offset + data_block_data_offset );
+							data_block_index_value.data_size   = (size32_t) data_block_data_size;
+
+							result = libpff_recovered_index_has_index_value(
+								  offsets_index->recovered_index,
+								  &data_block_index_value,
+								  error );
+
+							if( result == -1 )
 							{
 								libcerror_error_set(
 								 error,
 								 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 								 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-								 "%s: unable to retrieve number of recovered offset index values for identifier: %" PRIu64 ".",
+								 "%s: unable to determine if recovered offset index value: %" PRIu64 " exists.",
 								 function,
 								 data_block_back_pointer );
 
 								goto on_error;
 							}
-							result = 0;
-
-							for( index_value_iterator = 0;
-							     index_value_iterator < number_of_index_values;
-							     index_value_iterator++ )
-							{
-								result = libpff_index_tree_get_value_by_identifier(
-									  offsets_index->recovered_index_tree,
-									  file_io_handle,
-									  offsets_index->index_cache,
-									  data_block_back_pointer,
-									  index_value_iterator,
-									  &index_value,
-									  error );
-
-								if( result == -1 )
-								{
-									libcerror_error_set(
-									 error,
-									 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-									 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-									 "%s: unable to retrieve recovered offset index value for identifier: %" PRIu64 ".",
-									 function,
-									 data_block_back_pointer );
-
-									goto on_error;
-								}
-								else if( result != 0 )
-								{
-									if( ( (off64_t) ( block_buffer_data_offset + data_block_data_offset ) == index_value->file_offset )
-									 && ( (size32_t) data_block_data_size == index_value->data_size ) )
-									{
-										break;
-									}
-									result = 0;
-								}
-							}
 							if( result != 0 )
 							{
 #if defined( HAVE_DEBUG_OUTPUT )
@@ -1933,8 +1942,13 @@ int libpff_recover_index_values(
      uint8_t recovery_flags,
      libcerror_error_t **error )
 {
+	libpff_index_value_t recovered_index_value;
+
+	const libpff_format_functions_t *format_functions = NULL;
 	libpff_index_value_t *index_value                 = NULL;
 	libpff_index_node_t *index_node                   = NULL;
+	libpff_recovered_index_t *recovered_index         = NULL;
+	uint8_t *node_entries_data                        = NULL;
 	uint8_t *node_entry_data                          = NULL;
 	const char *index_string                          = NULL;
 	static char *function                             = "libpff_recover_index_values";
@@ -1942,11 +1956,13 @@ int libpff_recover_index_values(
 	uint64_t index_value_data_identifier              = 0;
 	uint64_t index_value_identifier                   = 0;
 	uint64_t index_value_local_descriptors_identifier = 0;
+	uint64_t safe_file_offset                         = 0;
         uint32_t maximum_data_block_data_size             = 0;
+	uint32_t index_value_parent_identifier            = 0;
 	uint16_t index_value_data_size                    = 0;
-	uint8_t entry_index                               = 0;
-	int index_value_iterator                          = 0;
-	int number_of_index_values                        = 0;
+	uint16_t index_value_reference_count              = 0;
+	uint16_t entry_index                              = 0;
+	uint8_t entry_size                                = 0;
 	int result                                        = 0;
 
 	if( io_handle == NULL )
@@ -1973,6 +1989,19 @@ int libpff_recover_index_values(
 
 		return( -1 );
 	}
+	format_functions = io_handle->format_functions;
+
+	if( format_functions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing format functions.",
+		 function );
+
+		return( -1 );
+	}
 	if( io_handle->file_type == LIBPFF_FILE_TYPE_32BIT )
 	{
 		maximum_data_block_data_size = 8192 - 12;
@@ -2001,11 +2030,19 @@ int libpff_recover_index_values(
 	}
 	if( libpff_index_node_read_file_io_handle(
 	     index_node,
+	     io_handle,
 	     file_io_handle,
 	     node_offset,
-	     io_handle->file_type,
 	     error ) != 1 )
 	{
+		if( io_handle->read_limits_exceeded != 0 )
+		{
+			libpff_index_node_free(
+			 &index_node,
+			 NULL );
+
+			return( -1 );
+		}
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( ( libcnotify_verbose != 0 )
 		 && ( error != NULL )
@@ -2062,51 +2099,52 @@ int libpff_recover_index_values(
 	{
 		/* Check if the index leaf entries are recoverable
 		 */
-		for( entry_index = 0;
-		     entry_index < index_node->maximum_number_of_entries;
-		     entry_index++ )
+		if( index_node->type == LIBPFF_INDEX_TYPE_DESCRIPTOR )
 		{
-			if( libpff_index_node_get_entry_data(
-			     index_node,
-			     entry_index,
-			     &node_entry_data,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve node entry: %" PRIu8 " data.",
-				 function,
-				 entry_index );
-
-				goto on_error;
-			}
-			if( node_entry_data == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing node entry: %" PRIu8 " data.",
-				 function,
-				 entry_index );
-
-				goto on_error;
-			}
-			if( io_handle->file_type == LIBPFF_FILE_TYPE_32BIT )
-			{
-				byte_stream_copy_to_uint32_little_endian(
-				 node_entry_data,
-				 index_value_identifier );
-			}
-			else if( ( io_handle->file_type == LIBPFF_FILE_TYPE_64BIT )
-			      || ( io_handle->file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
+			entry_size = format_functions->index_node_descriptor_entry_size;
+		}
+		else
+		{
+			entry_size = format_functions->index_node_entry_size;
+		}
+		if( libpff_index_node_get_entries_data(
+		     index_node,
+		     0,
+		     index_node->maximum_number_of_entries,
+		     entry_size,
+		     &node_entries_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve node entries data.",
+			 function );
+
+			goto on_error;
+		}
+		for( entry_index = 0;
+		     entry_index < index_node->maximum_number_of_entries;
+		     entry_index++ )
+		{
+			/* Entries without an identifier, data identifier or file offset
+			 * and data size are skipped by the format specific scan
+			 */
+			if( format_functions->scan_index_node_leaf_entries(
+			     node_entries_data,
+			     index_node->type,
+			     index_node->maximum_number_of_entries,
+			     &entry_index ) != 1 )
 			{
-				byte_stream_copy_to_uint64_little_endian(
-				 node_entry_data,
-				 index_value_identifier );
+				break;
 			}
+			node_entry_data = &( node_entries_data[ (size_t) entry_index * entry_size ] );
+
+			format_functions->read_node_entry_identifier(
+			 node_entry_data,
+			 &index_value_identifier );
+
 			/* Ignore the upper 32-bit of descriptor identifiers
 			 */
 			if( index_node->type == LIBPFF_INDEX_TYPE_DESCRIPTOR )
@@ -2117,124 +2155,40 @@ int libpff_recover_index_values(
 			if( libcnotify_verbose != 0 )
 			{
 				libcnotify_printf(
-				 "%s: analyzing %s index entry: %" PRIu8 " identifier: %" PRIu64 ".\n",
+				 "%s: analyzing %s index entry: %" PRIu16 " identifier: %" PRIu64 ".\n",
 				 function,
 				 index_string,
 				 entry_index,
 				 index_value_identifier );
 			}
 #endif
-			/* Ignore index values without an identifier
-			 */
-			if( index_value_identifier == 0 )
-			{
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: %s index entry: %" PRIu8 " indentifier: %" PRIu64 " has an empty identifier.\n",
-					 function,
-					 index_string,
-					 entry_index,
-					 index_value_identifier );
-				}
-#endif
-				continue;
-			}
-			if( index_node->type == LIBPFF_INDEX_TYPE_DESCRIPTOR )
-			{
-				if( io_handle->file_type == LIBPFF_FILE_TYPE_32BIT )
-				{
-					byte_stream_copy_to_uint32_little_endian(
-					 ( (pff_index_node_descriptor_entry_32bit_t *) node_entry_data )->data_identifier,
-					 index_value_data_identifier );
-					byte_stream_copy_to_uint32_little_endian(
-					 ( (pff_index_node_descriptor_entry_32bit_t *) node_entry_data )->local_descriptors_identifier,
-					 index_value_local_descriptors_identifier );
-				}
-				else if( ( io_handle->file_type == LIBPFF_FILE_TYPE_64BIT )
-				      || ( io_handle->file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
-				{
-					byte_stream_copy_to_uint64_little_endian(
-					 ( (pff_index_node_descriptor_entry_64bit_t *) node_entry_data )->data_identifier,
-					 index_value_data_identifier );
-					byte_stream_copy_to_uint64_little_endian(
-					 ( (pff_index_node_descriptor_entry_64bit_t *) node_entry_data )->local_descriptors_identifier,
-					 index_value_local_descriptors_identifier );
-				}
-			}
-			else if( index_node->type == LIBPFF_INDEX_TYPE_OFFSET )
-			{
-				if( io_handle->file_type == LIBPFF_FILE_TYPE_32BIT )
-				{
-					byte_stream_copy_to_uint32_little_endian(
-					 ( (pff_index_node_offset_entry_32bit_t *) node_entry_data )->file_offset,
-					 index_value_file_offset );
-					byte_stream_copy_to_uint16_little_endian(
-					 ( (pff_index_node_offset_entry_32bit_t *) node_entry_data )->data_size,
-					 index_value_data_size );
-				}
-				else if( ( io_handle->file_type == LIBPFF_FILE_TYPE_64BIT )
-				      || ( io_handle->file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
-				{
-					byte_stream_copy_to_uint64_little_endian(
-					 ( (pff_index_node_offset_entry_64bit_t *) node_entry_data )->file_offset,
-					 index_value_file_offset );
-					byte_stream_copy_to_uint16_little_endian(
-					 ( (pff_index_node_offset_entry_64bit_t *) node_entry_data )->data_size,
-					 index_value_data_size );
-				}
-			}
 			if( index_node->type == LIBPFF_INDEX_TYPE_DESCRIPTOR )
 			{
-				/* Ignore descriptor index values without a data identifier
-				 */
-				if( index_value_data_identifier == 0 )
-				{
-#if defined( HAVE_DEBUG_OUTPUT )
-					if( libcnotify_verbose != 0 )
-					{
-						libcnotify_printf(
-						 "%s: %s index entry: %" PRIu8 " identifier: %" PRIu64 " has an empty data identifier.\n",
-						 function,
-						 index_string,
-						 entry_index,
-						 index_value_identifier );
-					}
-#endif
-					continue;
-				}
+				format_functions->read_index_node_descriptor_entry(
+				 node_entry_data,
+				 &index_value_data_identifier,
+				 &index_value_local_descriptors_identifier,
+				 &index_value_parent_identifier );
 			}
 			else if( index_node->type == LIBPFF_INDEX_TYPE_OFFSET )
 			{
-				/* Ignore index values without a valid file offset
-				 */
-				if( index_value_file_offset <= 0 )
-				{
-#if defined( HAVE_DEBUG_OUTPUT )
-					if( libcnotify_verbose != 0 )
-					{
-						libcnotify_printf(
-						 "%s: %s index entry: %" PRIu8 " identifier: %" PRIu64 " has an invalid file offset: %" PRIi64 ".\n",
-						 function,
-						 index_string,
-						 entry_index,
-						 index_value_identifier,
-						 index_value_file_offset );
-					}
-#endif
-					continue;
-				}
+				format_functions->read_index_node_offset_entry(
+				 node_entry_data,
+				 &safe_file_offset,
+				 &index_value_data_size,
+				 &index_value_reference_count );
+
+				index_value_file_offset = (off64_t) safe_file_offset;
+
 				/* Ignore index values without a valid data size
 				 */
-				if( ( index_value_data_size == 0 )
-				 || ( (uint32_t) index_value_data_size > maximum_data_block_data_size ) )
+				if( (uint32_t) index_value_data_size > maximum_data_block_data_size )
 				{
 #if defined( HAVE_DEBUG_OUTPUT )
 					if( libcnotify_verbose != 0 )
 					{
 						libcnotify_printf(
-						 "%s: %s index entry: %" PRIu8 " identifier: %" PRIu64 " has an invalid data size: %" PRIu16 ".\n",
+						 "%s: %s index entry: %" PRIu16 " identifier: %" PRIu64 " has an invalid data size: %" PRIu16 ".\n",
 						 function,
 						 index_string,
 						 entry_index,
@@ -2320,104 +2274,58 @@ int libpff_recover_index_values(
 					}
 				}
 			}
-			/* Check for duplicates
-			 */
+			if( memory_set(
+			     &recovered_index_value,
+			     0,
+			     sizeof( libpff_index_value_t ) ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear recovered index value.",
+				 function );
+
+				goto on_error;
+			}
+			recovered_index_value.identifier = index_value_identifier;
+
 			if( index_node->type == LIBPFF_INDEX_TYPE_DESCRIPTOR )
 			{
-				result = libpff_index_tree_get_number_of_leaf_nodes_by_identifier(
-					  descriptors_index->recovered_index_tree,
-					  file_io_handle,
-					  descriptors_index->index_cache,
-					  index_value_identifier,
-					  &number_of_index_values,
-					  error );
+				recovered_index_value.data_identifier              = index_value_data_identifier;
+				recovered_index_value.local_descriptors_identifier = index_value_local_descriptors_identifier;
+				recovered_index_value.parent_identifier            = index_value_parent_identifier;
+
+				recovered_index = descriptors_index->recovered_index;
 			}
 			else if( index_node->type == LIBPFF_INDEX_TYPE_OFFSET )
 			{
-				result = libpff_index_tree_get_number_of_leaf_nodes_by_identifier(
-					  offsets_index->recovered_index_tree,
-					  file_io_handle,
-					  offsets_index->index_cache,
-					  index_value_identifier,
-					  &number_of_index_values,
-					  error );
+				recovered_index_value.file_offset     = index_value_file_offset;
+				recovered_index_value.data_size       = (size32_t) index_value_data_size;
+				recovered_index_value.reference_count = index_value_reference_count;
+
+				recovered_index = offsets_index->recovered_index;
 			}
-			if( result != 1 )
+			/* Check for duplicates
+			 */
+			result = libpff_recovered_index_has_index_value(
+				  recovered_index,
+				  &recovered_index_value,
+				  error );
+
+			if( result == -1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve number of recovered %s index values for identifier: %" PRIu64 ".",
+				 "%s: unable to determine if recovered %s index value: %" PRIu64 " exists.",
 				 function,
 				 index_string,
 				 index_value_identifier );
 
 				goto on_error;
 			}
-			result = 0;
-
-			for( index_value_iterator = 0;
-			     index_value_iterator < number_of_index_values;
-			     index_value_iterator++ )
-			{
-				if( index_node->type == LIBPFF_INDEX_TYPE_DESCRIPTOR )
-				{
-					result = libpff_index_tree_get_value_by_identifier(
-						  descriptors_index->recovered_index_tree,
-						  file_io_handle,
-						  descriptors_index->index_cache,
-						  index_value_identifier,
-						  index_value_iterator,
-						  &index_value,
-						  error );
-				}
-				else if( index_node->type == LIBPFF_INDEX_TYPE_OFFSET )
-				{
-					result = libpff_index_tree_get_value_by_identifier(
-						  offsets_index->recovered_index_tree,
-						  file_io_handle,
-						  offsets_index->index_cache,
-						  index_value_identifier,
-						  index_value_iterator,
-						  &index_value,
-						  error );
-				}
-				if( result == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve recovered %s index value for identifier: %" PRIu64 ".",
-					 function,
-					 index_string,
-					 index_value_identifier );
-
-					goto on_error;
-				}
-				else if( result != 0 )
-				{
-					if( index_node->type == LIBPFF_INDEX_TYPE_DESCRIPTOR )
-					{
-/* TODO what about parent changes ? */
-						if( ( index_value_data_identifier == index_value->data_identifier )
-						 && ( index_value_local_descriptors_identifier == index_value->local_descriptors_identifier ) )
-						{
-							break;
-						}
-					}
-					else if( index_node->type == LIBPFF_INDEX_TYPE_OFFSET )
-					{
-						if( ( index_value_file_offset == index_value->file_offset )
-						 && ( (size32_t) index_value_data_size == index_value->data_size ) )
-						{
-							break;
-						}
-					}
-					result = 0;
-				}
-			}
 			if( result != 0 )
 			{
 #if defined( HAVE_DEBUG_OUTPUT )
@@ -2461,7 +2369,7 @@ int libpff_recover_index_values(
 					if( libcnotify_verbose != 0 )
 					{
 						libcnotify_printf(
-						 "%s: %s index entry: %" PRIu8 " identifier: %" PRIu64 " refers to allocated range: 0x%08" PRIx64 " - 0x%08" PRIx64 " (%" PRIu64 ").\n",
+						 "%s: %s index entry: %" PRIu16 " identifier: %" PRIu64 " refers to allocated range: 0x%08" PRIx64 " - 0x%08" PRIx64 " (%" PRIu64 ").\n",
 						 function,
 						 index_string,
 						 entry_index,
@@ -2477,7 +2385,7 @@ int libpff_recover_index_values(
 				if( libcnotify_verbose != 0 )
 				{
 					libcnotify_printf(
-					 "%s: %s index entry: %" PRIu8 " identifier: %" PRIu64 " refers to unallocated range: 0x%08" PRIx64 " - 0x%08" PRIx64 " (%" PRIu64 ").\n",
+					 "%s: %s index entry: %" PRIu16 " identifier: %" PRIu64 " refers to unallocated range: 0x%08" PRIx64 " - 0x%08" PRIx64 " (%" PRIu64 ").\n",
 					 function,
 					 index_string,
 					 entry_index,
@@ -2494,49 +2402,29 @@ int libpff_recover_index_values(
 			if( libcnotify_verbose != 0 )
 			{
 				libcnotify_printf(
-				 "%s: %s index entry: %" PRIu8 " identifier: %" PRIu64 " is recoverable.\n",
+				 "%s: %s index entry: %" PRIu16 " identifier: %" PRIu64 " is recoverable.\n",
 				 function,
 				 index_string,
 				 entry_index,
 				 index_value_identifier );
 			}
 #endif
-			if( index_node->type == LIBPFF_INDEX_TYPE_DESCRIPTOR )
-			{
-				result = libpff_index_tree_insert_value(
-					  descriptors_index->recovered_index_tree,
-					  file_io_handle,
-					  descriptors_index->index_cache,
-					  index_value_identifier,
-					  node_offset,
-				          (size64_t) entry_index,
-					  error );
-			}
-			else if( index_node->type == LIBPFF_INDEX_TYPE_OFFSET )
-			{
-				result = libpff_index_tree_insert_value(
-					  offsets_index->recovered_index_tree,
-					  file_io_handle,
-					  offsets_index->index_cache,
-					  index_value_identifier,
-					  node_offset,
-				          (size64_t) entry_index,
-					  error );
-			}
-			if( result != 1 )
+			if( libpff_recovered_index_append_index_value(
+			     recovered_index,
+			     &recovered_index_value,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to insert %s index value: %" PRIu64 " to recovered index tree.",
+				 "%s: unable to append %s index value: %" PRIu64 " to recovered index.",
 				 function,
 				 index_string,
 				 index_value_identifier );
 
 				goto on_error;
 			}
-			node_offset += index_node->entry_size;
 		}
 	}
 	if( libpff_index_node_free(
@@ -2581,16 +2469,15 @@ int libpff_recover_local_descriptors(
      uint64_t local_descriptors_identifier,
      libcerror_error_t **error )
 {
-	libpff_index_value_t *offset_index_value                     = NULL;
-	libpff_local_descriptor_node_t *local_descriptor_node        = NULL;
-	uint8_t *node_entry_data                                     = NULL;
-	static char *function                                        = "libpff_recover_local_descriptors";
-	uint64_t local_descriptor_value_identifier                   = 0;
-	uint64_t local_descriptor_value_data_identifier              = 0;
-	uint64_t local_descriptor_value_local_descriptors_identifier = 0;
-	uint64_t local_descriptor_value_sub_node_identifier          = 0;
-	uint16_t entry_index                                         = 0;
-	int result                                                   = 1;
+	const libpff_format_functions_t *format_functions     = NULL;
+	libpff_index_value_t *offset_index_value              = NULL;
+	libpff_local_descriptor_node_t *local_descriptor_node = NULL;
+	uint8_t *node_entry_data                              = NULL;
+	static char *function                                 = "libpff_recover_local_descriptors";
+	uint64_t local_descriptor_value_identifier            = 0;
+	uint64_t local_descriptor_value_sub_node_identifier   = 0;
+	uint16_t entry_index                                  = 0;
+	int result                                            = 1;
 
 	if( io_handle == NULL )
 	{
@@ -2603,6 +2490,19 @@ int libpff_recover_local_descriptors(
 
 		return( -1 );
 	}
+	format_functions = io_handle->format_functions;
+
+	if( format_functions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing format functions.",
+		 function );
+
+		return( -1 );
+	}
 	if( libpff_offsets_index_get_index_value_by_identifier(
 	     offsets_index,
 	     file_io_handle,
@@ -2612,6 +2512,10 @@ int libpff_recover_local_descriptors(
 	     &offset_index_value,
 	     error ) != 1 )
 	{
+		if( io_handle->read_limits_exceeded != 0 )
+		{
+			return( -1 );
+		}
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( ( libcnotify_verbose != 0 )
 		 && ( error != NULL )
@@ -2672,6 +2576,14 @@ int libpff_recover_local_descriptors(
 	     offset_index_value->data_size,
 	     error ) != 1 )
 	{
+		if( io_handle->read_limits_exceeded != 0 )
+		{
+			libpff_local_descriptor_node_free(
+			 &local_descriptor_node,
+			 NULL );
+
+			return( -1 );
+		}
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( ( libcnotify_verbose != 0 )
 		 && ( error != NULL )
@@ -2690,151 +2602,110 @@ int libpff_recover_local_descriptors(
 
 		return( 0 );
 	}
-	for( entry_index = 0;
-	     entry_index < local_descriptor_node->number_of_entries;
-	     entry_index++ )
+	if( local_descriptor_node->level == LIBPFF_LOCAL_DESCRIPTOR_NODE_LEVEL_LEAF )
 	{
-		if( libpff_local_descriptor_node_get_entry_data(
-		     local_descriptor_node,
-		     entry_index,
-		     &node_entry_data,
-		     error ) != 1 )
+		if( ( local_descriptor_node->entries_data == NULL )
+		 || ( ( (size_t) local_descriptor_node->number_of_entries * format_functions->local_descriptor_leaf_entry_size ) > local_descriptor_node->entries_data_size ) )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve node entry: %" PRIu16 " data.",
-			 function,
-			 entry_index );
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid local descriptor node - entries data size value out of bounds.",
+			 function );
 
-			return( -1 );
-		}
-		if( node_entry_data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing node entry: %" PRIu16 " data.",
-			 function,
-			 entry_index );
+			libpff_local_descriptor_node_free(
+			 &local_descriptor_node,
+			 NULL );
 
 			return( -1 );
 		}
-		if( io_handle->file_type == LIBPFF_FILE_TYPE_32BIT )
-		{
-			byte_stream_copy_to_uint32_little_endian(
-			 node_entry_data,
-			 local_descriptor_value_identifier );
-
-			node_entry_data += 4;
-		}
-		else if( ( io_handle->file_type == LIBPFF_FILE_TYPE_64BIT )
-		      || ( io_handle->file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
-		{
-			byte_stream_copy_to_uint64_little_endian(
-			 node_entry_data,
-			 local_descriptor_value_identifier );
-
-			node_entry_data += 8;
-		}
-		/* Ignore the upper 32-bit of local descriptor identifiers
+		/* The leaf entries are checked with a single call since they
+		 * do not refer to other local descriptor nodes
 		 */
-		local_descriptor_value_identifier &= 0xffffffffUL;
+		result = format_functions->check_local_descriptor_leaf_entries(
+		          local_descriptor_node->entries_data,
+		          local_descriptor_node->number_of_entries );
 
-		/* Ignore local descriptor values without a data identifier
-		 */
-		if( local_descriptor_value_identifier == 0 )
-		{
 #if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: local descriptor entry: %" PRIu8 " identifier: %" PRIu64 " has an empty identifier.\n",
-				 function,
-				 entry_index,
-				 local_descriptor_value_identifier );
-			}
-#endif
-			result = 0;
-
-			break;
+		if( ( libcnotify_verbose != 0 )
+		 && ( result == 0 ) )
+		{
+			libcnotify_printf(
+			 "%s: local descriptor node contains an entry with an empty identifier or data identifier.\n",
+			 function );
 		}
-		if( local_descriptor_node->level == LIBPFF_LOCAL_DESCRIPTOR_NODE_LEVEL_LEAF )
+#endif
+	}
+	else
+	{
+		for( entry_index = 0;
+		     entry_index < local_descriptor_node->number_of_entries;
+		     entry_index++ )
 		{
-			if( io_handle->file_type == LIBPFF_FILE_TYPE_32BIT )
+			if( libpff_local_descriptor_node_get_entry_data(
+			     local_descriptor_node,
+			     entry_index,
+			     &node_entry_data,
+			     error ) != 1 )
 			{
-				byte_stream_copy_to_uint32_little_endian(
-				 node_entry_data,
-				 local_descriptor_value_data_identifier );
-
-				node_entry_data += 4;
-
-				byte_stream_copy_to_uint32_little_endian(
-				 node_entry_data,
-				 local_descriptor_value_local_descriptors_identifier );
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve node entry: %" PRIu16 " data.",
+				 function,
+				 entry_index );
 
-				node_entry_data += 4;
+				return( -1 );
 			}
-			else if( ( io_handle->file_type == LIBPFF_FILE_TYPE_64BIT )
-			      || ( io_handle->file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
+			if( node_entry_data == NULL )
 			{
-				byte_stream_copy_to_uint64_little_endian(
-				 node_entry_data,
-				 local_descriptor_value_data_identifier );
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing node entry: %" PRIu16 " data.",
+				 function,
+				 entry_index );
 
-				node_entry_data += 8;
+				return( -1 );
+			}
+			format_functions->read_node_entry_identifier(
+			 node_entry_data,
+			 &local_descriptor_value_identifier );
 
-				byte_stream_copy_to_uint64_little_endian(
-				 node_entry_data,
-				 local_descriptor_value_local_descriptors_identifier );
+			/* Ignore the upper 32-bit of local descriptor identifiers
+			 */
+			local_descriptor_value_identifier &= 0xffffffffUL;
 
-				node_entry_data += 8;
-			}
 			/* Ignore local descriptor values without a data identifier
 			 */
-			if( local_descriptor_value_data_identifier == 0 )
+			if( local_descriptor_value_identifier == 0 )
 			{
-#if defined( HAVE_DEBUG_OUTPUT )
+	#if defined( HAVE_DEBUG_OUTPUT )
 				if( libcnotify_verbose != 0 )
 				{
 					libcnotify_printf(
-					 "%s: local descriptor entry: %" PRIu8 " identifier: %" PRIu64 " has an empty data identifier.\n",
+					 "%s: local descriptor entry: %" PRIu8 " identifier: %" PRIu64 " has an empty identifier.\n",
 					 function,
 					 entry_index,
 					 local_descriptor_value_identifier );
 				}
-#endif
+	#endif
 				result = 0;
 
 				break;
 			}
-		}
-		else
-		{
-			if( io_handle->file_type == LIBPFF_FILE_TYPE_32BIT )
-			{
-				byte_stream_copy_to_uint32_little_endian(
-				 node_entry_data,
-				 local_descriptor_value_sub_node_identifier );
-
-				node_entry_data += 4;
-			}
-			else if( ( io_handle->file_type == LIBPFF_FILE_TYPE_64BIT )
-			      || ( io_handle->file_type == LIBPFF_FILE_TYPE_64BIT_4K_PAGE ) )
-			{
-				byte_stream_copy_to_uint64_little_endian(
-				 node_entry_data,
-				 local_descriptor_value_sub_node_identifier );
+			format_functions->read_local_descriptor_branch_entry(
+			 node_entry_data,
+			 &local_descriptor_value_sub_node_identifier );
 
-				node_entry_data += 8;
-			}
 			/* Ignore local descriptor values without a sub node identifier
 			 */
 			if( local_descriptor_value_sub_node_identifier == 0 )
 			{
-#if defined( HAVE_DEBUG_OUTPUT )
+	#if defined( HAVE_DEBUG_OUTPUT )
 				if( libcnotify_verbose != 0 )
 				{
 					libcnotify_printf(
@@ -2843,7 +2714,7 @@ int libpff_recover_local_descriptors(
 					 entry_index,
 					 local_descriptor_value_identifier );
 				}
-#endif
+	#endif
 				result = 0;
 
 				break;
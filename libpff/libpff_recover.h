@@ -28,6 +28,7 @@
 #include "libpff_descriptors_index.h"
 #include "libpff_libbfio.h"
 #include "libpff_io_handle.h"
+#include "libpff_item_descriptor.h"
 #include "libpff_offsets_index.h"
 
 #if defined( __cplusplus )
@@ -41,10 +42,18 @@ int libpff_recover_items(
      libpff_offsets_index_t *offsets_index,
      libcdata_range_list_t *unallocated_data_block_list,
      libcdata_range_list_t *unallocated_page_block_list,
-     libcdata_list_t *recovered_item_list,
+     libcdata_array_t *recovered_item_array,
      uint8_t recovery_flags,
      libcerror_error_t **error );
 
+int libpff_recover_validate_item_descriptor(
+     libpff_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libpff_offsets_index_t *offsets_index,
+     libpff_item_descriptor_t *item_descriptor,
+     uint8_t read_data,
+     libcerror_error_t **error );
+
 int libpff_recover_index_nodes(
      libpff_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
@@ -0,0 +1,1198 @@
+/*
+ * Recovered index functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libpff_definitions.h"
+#include "libpff_index_value.h"
+#include "libpff_libcerror.h"
+#include "libpff_libcthreads.h"
+#include "libpff_recovered_index.h"
+
+/* Creates a recovered index
+ * Make sure the value recovered_index is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_recovered_index_initialize(
+     libpff_recovered_index_t **recovered_index,
+     uint8_t index_type,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_recovered_index_initialize";
+
+	if( recovered_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid recovered index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *recovered_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid recovered index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( index_type != LIBPFF_INDEX_TYPE_DESCRIPTOR )
+	 && ( index_type != LIBPFF_INDEX_TYPE_OFFSET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported index type: 0x%02" PRIx8 ".",
+		 function,
+		 index_type );
+
+		return( -1 );
+	}
+	*recovered_index = memory_allocate_structure(
+	                    libpff_recovered_index_t );
+
+	if( *recovered_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create recovered index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *recovered_index,
+	     0,
+	     sizeof( libpff_recovered_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear recovered index.",
+		 function );
+
+		goto on_error;
+	}
+	( *recovered_index )->index_type = index_type;
+
+	return( 1 );
+
+on_error:
+	if( *recovered_index != NULL )
+	{
+		memory_free(
+		 *recovered_index );
+
+		*recovered_index = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a recovered index
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_recovered_index_free(
+     libpff_recovered_index_t **recovered_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_recovered_index_free";
+
+	if( recovered_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid recovered index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *recovered_index != NULL )
+	{
+		if( ( *recovered_index )->hash_chain != NULL )
+		{
+			memory_free(
+			 ( *recovered_index )->hash_chain );
+		}
+		if( ( *recovered_index )->hash_buckets != NULL )
+		{
+			memory_free(
+			 ( *recovered_index )->hash_buckets );
+		}
+		if( ( *recovered_index )->index_values != NULL )
+		{
+			memory_free(
+			 ( *recovered_index )->index_values );
+		}
+		memory_free(
+		 *recovered_index );
+
+		*recovered_index = NULL;
+	}
+	return( 1 );
+}
+
+/* Determines the hash bucket of an identifier
+ */
+#define libpff_recovered_index_get_hash_bucket( identifier, number_of_hash_buckets ) \
+	(int) ( ( ( (uint64_t) ( identifier ) * 0x9e3779b97f4a7c15ULL ) >> 32 ) & (uint64_t) ( ( number_of_hash_buckets ) - 1 ) )
+
+/* Resizes the hash buckets and rebuilds the hash chain of the appended index values
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_recovered_index_resize_hash(
+     libpff_recovered_index_t *recovered_index,
+     int number_of_hash_buckets,
+     libcerror_error_t **error )
+{
+	int *hash_buckets     = NULL;
+	static char *function = "libpff_recovered_index_resize_hash";
+	int bucket_index      = 0;
+	int value_index       = 0;
+
+	if( recovered_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid recovered index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_hash_buckets <= 0 )
+	 || ( (size_t) number_of_hash_buckets > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( int ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of hash buckets value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	hash_buckets = (int *) memory_allocate(
+	                        sizeof( int ) * number_of_hash_buckets );
+
+	if( hash_buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create hash buckets.",
+		 function );
+
+		return( -1 );
+	}
+	for( bucket_index = 0;
+	     bucket_index < number_of_hash_buckets;
+	     bucket_index++ )
+	{
+		hash_buckets[ bucket_index ] = -1;
+	}
+	for( value_index = 0;
+	     value_index < recovered_index->number_of_index_values;
+	     value_index++ )
+	{
+		bucket_index = libpff_recovered_index_get_hash_bucket(
+		                recovered_index->index_values[ value_index ].identifier,
+		                number_of_hash_buckets );
+
+		recovered_index->hash_chain[ value_index ] = hash_buckets[ bucket_index ];
+		hash_buckets[ bucket_index ]               = value_index;
+	}
+	if( recovered_index->hash_buckets != NULL )
+	{
+		memory_free(
+		 recovered_index->hash_buckets );
+	}
+	recovered_index->hash_buckets           = hash_buckets;
+	recovered_index->number_of_hash_buckets = number_of_hash_buckets;
+
+	return( 1 );
+}
+
+/* Appends a copy of an index value
+ * The index values can only be appended before the recovered index is finalized
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_recovered_index_append_index_value(
+     libpff_recovered_index_t *recovered_index,
+     const libpff_index_value_t *index_value,
+     libcerror_error_t **error )
+{
+	libpff_index_value_t *index_values   = NULL;
+	int *hash_chain                      = NULL;
+	static char *function                = "libpff_recovered_index_append_index_value";
+	int bucket_index                     = 0;
+	int number_of_allocated_index_values = 0;
+
+	if( recovered_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid recovered index.",
+		 function );
+
+		return( -1 );
+	}
+	if( recovered_index->is_sorted != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid recovered index - already finalized.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index value.",
+		 function );
+
+		return( -1 );
+	}
+	if( recovered_index->number_of_index_values >= recovered_index->number_of_allocated_index_values )
+	{
+		if( recovered_index->number_of_allocated_index_values == 0 )
+		{
+			number_of_allocated_index_values = LIBPFF_RECOVERED_INDEX_INITIAL_NUMBER_OF_VALUES;
+		}
+		else if( recovered_index->number_of_allocated_index_values <= ( INT_MAX / 2 ) )
+		{
+			number_of_allocated_index_values = recovered_index->number_of_allocated_index_values * 2;
+		}
+		if( ( number_of_allocated_index_values == 0 )
+		 || ( (size_t) number_of_allocated_index_values > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libpff_index_value_t ) ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of allocated index values value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		index_values = (libpff_index_value_t *) memory_reallocate(
+		                                         recovered_index->index_values,
+		                                         sizeof( libpff_index_value_t ) * number_of_allocated_index_values );
+
+		if( index_values == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize index values.",
+			 function );
+
+			return( -1 );
+		}
+		recovered_index->index_values = index_values;
+
+		hash_chain = (int *) memory_reallocate(
+		                      recovered_index->hash_chain,
+		                      sizeof( int ) * number_of_allocated_index_values );
+
+		if( hash_chain == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize hash chain.",
+			 function );
+
+			return( -1 );
+		}
+		recovered_index->hash_chain                       = hash_chain;
+		recovered_index->number_of_allocated_index_values = number_of_allocated_index_values;
+
+		/* Keep the number of hash buckets equal to the number of allocated index values
+		 */
+		if( libpff_recovered_index_resize_hash(
+		     recovered_index,
+		     number_of_allocated_index_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( memory_copy(
+	     &( recovered_index->index_values[ recovered_index->number_of_index_values ] ),
+	     index_value,
+	     sizeof( libpff_index_value_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy index value.",
+		 function );
+
+		return( -1 );
+	}
+	bucket_index = libpff_recovered_index_get_hash_bucket(
+	                index_value->identifier,
+	                recovered_index->number_of_hash_buckets );
+
+	recovered_index->hash_chain[ recovered_index->number_of_index_values ] = recovered_index->hash_buckets[ bucket_index ];
+	recovered_index->hash_buckets[ bucket_index ]                          = recovered_index->number_of_index_values;
+
+	recovered_index->number_of_index_values += 1;
+
+	return( 1 );
+}
+
+/* Determines if two index values of the recovered index type are equivalent
+ * Descriptor index values are equivalent if their identifier, data and local descriptors identifier match,
+ * offset index values if their identifier, file offset and data size match
+ */
+#define libpff_recovered_index_values_are_equivalent( index_type, first_index_value, second_index_value ) \
+	( ( ( first_index_value )->identifier == ( second_index_value )->identifier ) \
+	 && ( ( ( index_type ) == LIBPFF_INDEX_TYPE_DESCRIPTOR ) \
+	  ? ( ( ( first_index_value )->data_identifier == ( second_index_value )->data_identifier ) \
+	   && ( ( first_index_value )->local_descriptors_identifier == ( second_index_value )->local_descriptors_identifier ) ) \
+	  : ( ( ( first_index_value )->file_offset == ( second_index_value )->file_offset ) \
+	   && ( ( first_index_value )->data_size == ( second_index_value )->data_size ) ) ) )
+
+/* Determines if the recovered index contains an equivalent index value
+ * Returns 1 if an equivalent index value is present, 0 if not or -1 on error
+ */
+int libpff_recovered_index_has_index_value(
+     libpff_recovered_index_t *recovered_index,
+     const libpff_index_value_t *index_value,
+     libcerror_error_t **error )
+{
+	libpff_index_value_t *recovered_index_value = NULL;
+	static char *function                       = "libpff_recovered_index_has_index_value";
+	int number_of_index_values                  = 0;
+	int value_index                             = 0;
+
+	if( recovered_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid recovered index.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index value.",
+		 function );
+
+		return( -1 );
+	}
+	if( recovered_index->number_of_index_values == 0 )
+	{
+		return( 0 );
+	}
+	if( recovered_index->is_sorted == 0 )
+	{
+		value_index = recovered_index->hash_buckets[
+		               libpff_recovered_index_get_hash_bucket(
+		                index_value->identifier,
+		                recovered_index->number_of_hash_buckets ) ];
+
+		while( value_index != -1 )
+		{
+			recovered_index_value = &( recovered_index->index_values[ value_index ] );
+
+			if( libpff_recovered_index_values_are_equivalent(
+			     recovered_index->index_type,
+			     recovered_index_value,
+			     index_value ) )
+			{
+				return( 1 );
+			}
+			value_index = recovered_index->hash_chain[ value_index ];
+		}
+		return( 0 );
+	}
+	if( libpff_recovered_index_get_number_of_index_values_by_identifier(
+	     recovered_index,
+	     index_value->identifier,
+	     &number_of_index_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of index values for identifier: %" PRIu64 ".",
+		 function,
+		 index_value->identifier );
+
+		return( -1 );
+	}
+	for( value_index = 0;
+	     value_index < number_of_index_values;
+	     value_index++ )
+	{
+		if( libpff_recovered_index_get_index_value_by_identifier(
+		     recovered_index,
+		     index_value->identifier,
+		     value_index,
+		     &recovered_index_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve index value: %d for identifier: %" PRIu64 ".",
+			 function,
+			 value_index,
+			 index_value->identifier );
+
+			return( -1 );
+		}
+		if( libpff_recovered_index_values_are_equivalent(
+		     recovered_index->index_type,
+		     recovered_index_value,
+		     index_value ) )
+		{
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Sorts index values by identifier
+ * The sort is stable, index values with the same identifier keep the order
+ * in which they were appended, scratch_index_values must be able to hold
+ * number_of_index_values
+ */
+void libpff_recovered_index_sort_values(
+      libpff_index_value_t *index_values,
+      libpff_index_value_t *scratch_index_values,
+      int number_of_index_values )
+{
+	libpff_index_value_t *destination_index_values = NULL;
+	libpff_index_value_t *source_index_values      = NULL;
+	libpff_index_value_t *swap_index_values        = NULL;
+	int first_index                                = 0;
+	int first_end_index                            = 0;
+	int range_index                                = 0;
+	int second_end_index                           = 0;
+	int second_index                               = 0;
+	int value_index                                = 0;
+	int width                                      = 0;
+
+	if( ( index_values == NULL )
+	 || ( scratch_index_values == NULL )
+	 || ( number_of_index_values < 2 ) )
+	{
+		return;
+	}
+	/* The values are frequently appended in order
+	 */
+	for( value_index = 1;
+	     value_index < number_of_index_values;
+	     value_index++ )
+	{
+		if( index_values[ value_index - 1 ].identifier > index_values[ value_index ].identifier )
+		{
+			break;
+		}
+	}
+	if( value_index >= number_of_index_values )
+	{
+		return;
+	}
+	source_index_values      = index_values;
+	destination_index_values = scratch_index_values;
+
+	for( width = 1;
+	     width < number_of_index_values;
+	     width *= 2 )
+	{
+		for( range_index = 0;
+		     range_index < number_of_index_values;
+		     range_index += 2 * width )
+		{
+			first_index      = range_index;
+			first_end_index  = range_index + width;
+			second_index     = first_end_index;
+			second_end_index = first_end_index + width;
+
+			if( first_end_index > number_of_index_values )
+			{
+				first_end_index = number_of_index_values;
+			}
+			if( second_end_index > number_of_index_values )
+			{
+				second_end_index = number_of_index_values;
+			}
+			value_index = range_index;
+
+			while( ( first_index < first_end_index )
+			    && ( second_index < second_end_index ) )
+			{
+				if( source_index_values[ second_index ].identifier < source_index_values[ first_index ].identifier )
+				{
+					destination_index_values[ value_index++ ] = source_index_values[ second_index++ ];
+				}
+				else
+				{
+					destination_index_values[ value_index++ ] = source_index_values[ first_index++ ];
+				}
+			}
+			while( first_index < first_end_index )
+			{
+				destination_index_values[ value_index++ ] = source_index_values[ first_index++ ];
+			}
+			while( second_index < second_end_index )
+			{
+				destination_index_values[ value_index++ ] = source_index_values[ second_index++ ];
+			}
+		}
+		swap_index_values        = source_index_values;
+		source_index_values      = destination_index_values;
+		destination_index_values = swap_index_values;
+
+		if( width > ( INT_MAX / 2 ) )
+		{
+			break;
+		}
+	}
+	if( source_index_values != index_values )
+	{
+		memory_copy(
+		 index_values,
+		 source_index_values,
+		 sizeof( libpff_index_value_t ) * number_of_index_values );
+	}
+}
+
+/* Merges two adjacent sorted ranges of index values
+ * The first range contains number_of_first_index_values and is followed by the second range,
+ * scratch_index_values must be able to hold number_of_first_index_values
+ */
+void libpff_recovered_index_merge_values(
+      libpff_index_value_t *index_values,
+      libpff_index_value_t *scratch_index_values,
+      int number_of_first_index_values,
+      int number_of_index_values )
+{
+	int first_index  = 0;
+	int second_index = 0;
+	int value_index  = 0;
+
+	if( ( index_values == NULL )
+	 || ( scratch_index_values == NULL )
+	 || ( number_of_first_index_values <= 0 )
+	 || ( number_of_first_index_values >= number_of_index_values ) )
+	{
+		return;
+	}
+	/* The ranges are already in order
+	 */
+	if( index_values[ number_of_first_index_values - 1 ].identifier <= index_values[ number_of_first_index_values ].identifier )
+	{
+		return;
+	}
+	memory_copy(
+	 scratch_index_values,
+	 index_values,
+	 sizeof( libpff_index_value_t ) * number_of_first_index_values );
+
+	second_index = number_of_first_index_values;
+
+	while( ( first_index < number_of_first_index_values )
+	    && ( second_index < number_of_index_values ) )
+	{
+		if( index_values[ second_index ].identifier < scratch_index_values[ first_index ].identifier )
+		{
+			index_values[ value_index++ ] = index_values[ second_index++ ];
+		}
+		else
+		{
+			index_values[ value_index++ ] = scratch_index_values[ first_index++ ];
+		}
+	}
+	while( first_index < number_of_first_index_values )
+	{
+		index_values[ value_index++ ] = scratch_index_values[ first_index++ ];
+	}
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The recovered index sort run thread function
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_recovered_index_sort_run_thread_function(
+     libpff_recovered_index_sort_run_t *sort_run )
+{
+	if( sort_run == NULL )
+	{
+		return( -1 );
+	}
+	libpff_recovered_index_sort_values(
+	 sort_run->index_values,
+	 sort_run->scratch_index_values,
+	 sort_run->number_of_index_values );
+
+	return( 1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Finalizes the recovered index
+ * Sorts the index values by identifier so they can be looked up, the hash used
+ * to detect duplicates while appending is no longer needed and is freed.
+ * With multi-threading support large indexes are divided in runs that are sorted
+ * by separate threads, the calling thread sorts the first run, after which
+ * the sorted runs are merged
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_recovered_index_finalize(
+     libpff_recovered_index_t *recovered_index,
+     libcerror_error_t **error )
+{
+	libpff_recovered_index_sort_run_t sort_runs[ LIBPFF_RECOVERED_INDEX_MAXIMUM_NUMBER_OF_SORT_THREADS ];
+
+	libpff_index_value_t *scratch_index_values = NULL;
+	static char *function                      = "libpff_recovered_index_finalize";
+	int number_of_merged_index_values          = 0;
+	int number_of_index_values_per_run         = 0;
+	int number_of_sort_runs                    = 1;
+	int sort_run_index                         = 0;
+
+	if( recovered_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid recovered index.",
+		 function );
+
+		return( -1 );
+	}
+	if( recovered_index->is_sorted != 0 )
+	{
+		return( 1 );
+	}
+	if( recovered_index->number_of_index_values > 1 )
+	{
+		scratch_index_values = (libpff_index_value_t *) memory_allocate(
+		                                                 sizeof( libpff_index_value_t ) * recovered_index->number_of_index_values );
+
+		if( scratch_index_values == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create scratch index values.",
+			 function );
+
+			goto on_error;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		number_of_sort_runs = recovered_index->number_of_index_values / LIBPFF_RECOVERED_INDEX_MINIMUM_NUMBER_OF_VALUES_PER_SORT_THREAD;
+
+		if( number_of_sort_runs > LIBPFF_RECOVERED_INDEX_MAXIMUM_NUMBER_OF_SORT_THREADS )
+		{
+			number_of_sort_runs = LIBPFF_RECOVERED_INDEX_MAXIMUM_NUMBER_OF_SORT_THREADS;
+		}
+		else if( number_of_sort_runs < 1 )
+		{
+			number_of_sort_runs = 1;
+		}
+#endif
+		if( memory_set(
+		     sort_runs,
+		     0,
+		     sizeof( libpff_recovered_index_sort_run_t ) * LIBPFF_RECOVERED_INDEX_MAXIMUM_NUMBER_OF_SORT_THREADS ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear sort runs.",
+			 function );
+
+			goto on_error;
+		}
+		number_of_index_values_per_run = recovered_index->number_of_index_values / number_of_sort_runs;
+
+		for( sort_run_index = 0;
+		     sort_run_index < number_of_sort_runs;
+		     sort_run_index++ )
+		{
+			sort_runs[ sort_run_index ].index_values           = &( recovered_index->index_values[ sort_run_index * number_of_index_values_per_run ] );
+			sort_runs[ sort_run_index ].scratch_index_values   = &( scratch_index_values[ sort_run_index * number_of_index_values_per_run ] );
+			sort_runs[ sort_run_index ].number_of_index_values = number_of_index_values_per_run;
+		}
+		/* The last run contains the remainder
+		 */
+		sort_runs[ number_of_sort_runs - 1 ].number_of_index_values += recovered_index->number_of_index_values % number_of_sort_runs;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		for( sort_run_index = 1;
+		     sort_run_index < number_of_sort_runs;
+		     sort_run_index++ )
+		{
+			if( libcthreads_thread_create(
+			     &( sort_runs[ sort_run_index ].thread ),
+			     NULL,
+			     (int (*)(void *)) &libpff_recovered_index_sort_run_thread_function,
+			     (void *) &( sort_runs[ sort_run_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create sort run: %d thread.",
+				 function,
+				 sort_run_index );
+
+				goto on_error;
+			}
+		}
+#endif
+		libpff_recovered_index_sort_values(
+		 sort_runs[ 0 ].index_values,
+		 sort_runs[ 0 ].scratch_index_values,
+		 sort_runs[ 0 ].number_of_index_values );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		for( sort_run_index = 1;
+		     sort_run_index < number_of_sort_runs;
+		     sort_run_index++ )
+		{
+			if( libcthreads_thread_join(
+			     &( sort_runs[ sort_run_index ].thread ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join sort run: %d thread.",
+				 function,
+				 sort_run_index );
+
+				goto on_error;
+			}
+		}
+#endif
+		/* Merge the sorted runs into the first run, a stable merge keeps values
+		 * with the same identifier in the order they were appended
+		 */
+		number_of_merged_index_values = sort_runs[ 0 ].number_of_index_values;
+
+		for( sort_run_index = 1;
+		     sort_run_index < number_of_sort_runs;
+		     sort_run_index++ )
+		{
+			libpff_recovered_index_merge_values(
+			 recovered_index->index_values,
+			 scratch_index_values,
+			 number_of_merged_index_values,
+			 number_of_merged_index_values + sort_runs[ sort_run_index ].number_of_index_values );
+
+			number_of_merged_index_values += sort_runs[ sort_run_index ].number_of_index_values;
+		}
+		memory_free(
+		 scratch_index_values );
+
+		scratch_index_values = NULL;
+	}
+	if( recovered_index->hash_chain != NULL )
+	{
+		memory_free(
+		 recovered_index->hash_chain );
+
+		recovered_index->hash_chain = NULL;
+	}
+	if( recovered_index->hash_buckets != NULL )
+	{
+		memory_free(
+		 recovered_index->hash_buckets );
+
+		recovered_index->hash_buckets = NULL;
+	}
+	recovered_index->number_of_hash_buckets = 0;
+	recovered_index->is_sorted              = 1;
+
+	return( 1 );
+
+on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	for( sort_run_index = 1;
+	     sort_run_index < number_of_sort_runs;
+	     sort_run_index++ )
+	{
+		if( sort_runs[ sort_run_index ].thread != NULL )
+		{
+			libcthreads_thread_join(
+			 &( sort_runs[ sort_run_index ].thread ),
+			 NULL );
+		}
+	}
+#endif
+	if( scratch_index_values != NULL )
+	{
+		memory_free(
+		 scratch_index_values );
+	}
+	return( -1 );
+}
+
+/* Retrieves the number of index values
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_recovered_index_get_number_of_index_values(
+     libpff_recovered_index_t *recovered_index,
+     int *number_of_index_values,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_recovered_index_get_number_of_index_values";
+
+	if( recovered_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid recovered index.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_index_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of index values.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_index_values = recovered_index->number_of_index_values;
+
+	return( 1 );
+}
+
+/* Retrieves a specific index value
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_recovered_index_get_index_value_by_index(
+     libpff_recovered_index_t *recovered_index,
+     int value_index,
+     libpff_index_value_t **index_value,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_recovered_index_get_index_value_by_index";
+
+	if( recovered_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid recovered index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_index < 0 )
+	 || ( value_index >= recovered_index->number_of_index_values ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid value index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index value.",
+		 function );
+
+		return( -1 );
+	}
+	*index_value = &( recovered_index->index_values[ value_index ] );
+
+	return( 1 );
+}
+
+/* Retrieves the index of the first index value with a specific identifier
+ * Returns 1 if successful, 0 if no such value or -1 on error
+ */
+int libpff_recovered_index_get_first_value_index_by_identifier(
+     libpff_recovered_index_t *recovered_index,
+     uint64_t identifier,
+     int *value_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_recovered_index_get_first_value_index_by_identifier";
+	int lower_index       = 0;
+	int middle_index      = 0;
+	int upper_index       = 0;
+
+	if( recovered_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid recovered index.",
+		 function );
+
+		return( -1 );
+	}
+	if( recovered_index->is_sorted == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid recovered index - not finalized.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value index.",
+		 function );
+
+		return( -1 );
+	}
+	upper_index = recovered_index->number_of_index_values;
+
+	while( lower_index < upper_index )
+	{
+		middle_index = lower_index + ( ( upper_index - lower_index ) / 2 );
+
+		if( recovered_index->index_values[ middle_index ].identifier < identifier )
+		{
+			lower_index = middle_index + 1;
+		}
+		else
+		{
+			upper_index = middle_index;
+		}
+	}
+	if( ( lower_index >= recovered_index->number_of_index_values )
+	 || ( recovered_index->index_values[ lower_index ].identifier != identifier ) )
+	{
+		return( 0 );
+	}
+	*value_index = lower_index;
+
+	return( 1 );
+}
+
+/* Retrieves the number of index values with a specific identifier
+ * The recovered index must be finalized
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_recovered_index_get_number_of_index_values_by_identifier(
+     libpff_recovered_index_t *recovered_index,
+     uint64_t identifier,
+     int *number_of_index_values,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_recovered_index_get_number_of_index_values_by_identifier";
+	int result            = 0;
+	int value_index       = 0;
+	int last_value_index  = 0;
+
+	if( number_of_index_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of index values.",
+		 function );
+
+		return( -1 );
+	}
+	result = libpff_recovered_index_get_first_value_index_by_identifier(
+	          recovered_index,
+	          identifier,
+	          &value_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve first value index for identifier: %" PRIu64 ".",
+		 function,
+		 identifier );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		*number_of_index_values = 0;
+
+		return( 1 );
+	}
+	for( last_value_index = value_index + 1;
+	     last_value_index < recovered_index->number_of_index_values;
+	     last_value_index++ )
+	{
+		if( recovered_index->index_values[ last_value_index ].identifier != identifier )
+		{
+			break;
+		}
+	}
+	*number_of_index_values = last_value_index - value_index;
+
+	return( 1 );
+}
+
+/* Retrieves a specific index value with a specific identifier
+ * Index values with the same identifier are stored in the order they were appended
+ * The recovered index must be finalized
+ * Returns 1 if successful, 0 if no such value or -1 on error
+ */
+int libpff_recovered_index_get_index_value_by_identifier(
+     libpff_recovered_index_t *recovered_index,
+     uint64_t identifier,
+     int value_index,
+     libpff_index_value_t **index_value,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_recovered_index_get_index_value_by_identifier";
+	int first_value_index = 0;
+	int result            = 0;
+
+	if( value_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid value index value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index value.",
+		 function );
+
+		return( -1 );
+	}
+	result = libpff_recovered_index_get_first_value_index_by_identifier(
+	          recovered_index,
+	          identifier,
+	          &first_value_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve first value index for identifier: %" PRIu64 ".",
+		 function,
+		 identifier );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( ( value_index >= ( recovered_index->number_of_index_values - first_value_index ) )
+	 || ( recovered_index->index_values[ first_value_index + value_index ].identifier != identifier ) )
+	{
+		return( 0 );
+	}
+	*index_value = &( recovered_index->index_values[ first_value_index + value_index ] );
+
+	return( 1 );
+}
+
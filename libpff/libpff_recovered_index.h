@@ -0,0 +1,186 @@
+/*
+ * Recovered index functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#if !defined( _LIBPFF_RECOVERED_INDEX_H )
+#define _LIBPFF_RECOVERED_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libpff_index_value.h"
+#include "libpff_libcerror.h"
+#include "libpff_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libpff_recovered_index libpff_recovered_index_t;
+
+/* The recovered index contains the index values found while scanning for
+ * recoverable items. The values are appended in scan order and sorted by
+ * identifier once the scan is finalized
+ */
+struct libpff_recovered_index
+{
+	/* The index type
+	 */
+	uint8_t index_type;
+
+	/* The index values
+	 */
+	libpff_index_value_t *index_values;
+
+	/* The number of index values
+	 */
+	int number_of_index_values;
+
+	/* The number of allocated index values
+	 */
+	int number_of_allocated_index_values;
+
+	/* The hash buckets, contains the index of the last value appended with
+	 * an identifier that maps to the bucket or -1
+	 */
+	int *hash_buckets;
+
+	/* The number of hash buckets, a power of 2
+	 */
+	int number_of_hash_buckets;
+
+	/* The hash chain, contains the index of the previous value in
+	 * the same bucket or -1
+	 */
+	int *hash_chain;
+
+	/* Value to indicate the index values are sorted
+	 */
+	uint8_t is_sorted;
+};
+
+typedef struct libpff_recovered_index_sort_run libpff_recovered_index_sort_run_t;
+
+/* A sort run is a contiguous range of index values that is sorted separately
+ */
+struct libpff_recovered_index_sort_run
+{
+	/* The index values
+	 */
+	libpff_index_value_t *index_values;
+
+	/* The scratch index values
+	 */
+	libpff_index_value_t *scratch_index_values;
+
+	/* The number of index values
+	 */
+	int number_of_index_values;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The thread
+	 */
+	libcthreads_thread_t *thread;
+#endif
+};
+
+int libpff_recovered_index_initialize(
+     libpff_recovered_index_t **recovered_index,
+     uint8_t index_type,
+     libcerror_error_t **error );
+
+int libpff_recovered_index_free(
+     libpff_recovered_index_t **recovered_index,
+     libcerror_error_t **error );
+
+int libpff_recovered_index_resize_hash(
+     libpff_recovered_index_t *recovered_index,
+     int number_of_hash_buckets,
+     libcerror_error_t **error );
+
+int libpff_recovered_index_append_index_value(
+     libpff_recovered_index_t *recovered_index,
+     const libpff_index_value_t *index_value,
+     libcerror_error_t **error );
+
+int libpff_recovered_index_has_index_value(
+     libpff_recovered_index_t *recovered_index,
+     const libpff_index_value_t *index_value,
+     libcerror_error_t **error );
+
+void libpff_recovered_index_sort_values(
+      libpff_index_value_t *index_values,
+      libpff_index_value_t *scratch_index_values,
+      int number_of_index_values );
+
+void libpff_recovered_index_merge_values(
+      libpff_index_value_t *index_values,
+      libpff_index_value_t *scratch_index_values,
+      int number_of_first_index_values,
+      int number_of_index_values );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int libpff_recovered_index_sort_run_thread_function(
+     libpff_recovered_index_sort_run_t *sort_run );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+int libpff_recovered_index_finalize(
+     libpff_recovered_index_t *recovered_index,
+     libcerror_error_t **error );
+
+int libpff_recovered_index_get_number_of_index_values(
+     libpff_recovered_index_t *recovered_index,
+     int *number_of_index_values,
+     libcerror_error_t **error );
+
+int libpff_recovered_index_get_index_value_by_index(
+     libpff_recovered_index_t *recovered_index,
+     int value_index,
+     libpff_index_value_t **index_value,
+     libcerror_error_t **error );
+
+int libpff_recovered_index_get_first_value_index_by_identifier(
+     libpff_recovered_index_t *recovered_index,
+     uint64_t identifier,
+     int *value_index,
+     libcerror_error_t **error );
+
+int libpff_recovered_index_get_number_of_index_values_by_identifier(
+     libpff_recovered_index_t *recovered_index,
+     uint64_t identifier,
+     int *number_of_index_values,
+     libcerror_error_t **error );
+
+int libpff_recovered_index_get_index_value_by_identifier(
+     libpff_recovered_index_t *recovered_index,
+     uint64_t identifier,
+     int value_index,
+     libpff_index_value_t **index_value,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPFF_RECOVERED_INDEX_H ) */
+
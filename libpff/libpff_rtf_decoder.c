@@ -0,0 +1,1509 @@
+/*
+ * RTF decoder functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#include "libpff_definitions.h"
+#include "libpff_libcerror.h"
+#include "libpff_libcnotify.h"
+#include "libpff_libfmapi.h"
+#include "libpff_libuna.h"
+#include "libpff_rtf_decoder.h"
+
+#define LIBPFF_RTF_LZFU_SIGNATURE_COMPRESSED		0x75465a4cUL
+#define LIBPFF_RTF_LZFU_SIGNATURE_UNCOMPRESSED		0x414c454dUL
+
+#define LIBPFF_RTF_LZFU_DICTIONARY_SIZE			4096
+
+/* The LZFu dictionary is initialized with this RTF prefix
+ */
+static const char *libpff_rtf_lzfu_prebuffer = \
+	"{\\rtf1\\ansi\\mac\\deff0\\deftab720{\\fonttbl;}{\\f0\\fnil \\froman \\fswiss \\fmodern \\fscript \\fdecor MS Sans SerifSymbolArialTimes New RomanCourier{\\colortbl\\red0\\green0\\blue0\r\n\\par \\pard\\plain\\f0\\fs20\\b\\i\\u\\tab\\tx";
+
+#define LIBPFF_RTF_LZFU_PREBUFFER_SIZE			207
+
+/* The control words that start a destination that is not part of the encapsulated body
+ */
+static const char *libpff_rtf_skip_destinations[] = {
+	"colortbl",
+	"datastore",
+	"fldinst",
+	"fonttbl",
+	"footer",
+	"header",
+	"info",
+	"listoverridetable",
+	"listtable",
+	"object",
+	"pict",
+	"rsidtbl",
+	"stylesheet",
+	"themedata",
+	NULL };
+
+/* Creates a RTF decoder
+ * Make sure the value rtf_decoder is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_rtf_decoder_initialize(
+     libpff_rtf_decoder_t **rtf_decoder,
+     int ascii_codepage,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_rtf_decoder_initialize";
+
+	if( rtf_decoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid RTF decoder.",
+		 function );
+
+		return( -1 );
+	}
+	if( *rtf_decoder != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid RTF decoder value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*rtf_decoder = memory_allocate_structure(
+	                libpff_rtf_decoder_t );
+
+	if( *rtf_decoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create RTF decoder.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *rtf_decoder,
+	     0,
+	     sizeof( libpff_rtf_decoder_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear RTF decoder.",
+		 function );
+
+		goto on_error;
+	}
+	( *rtf_decoder )->ascii_codepage = ascii_codepage;
+
+	return( 1 );
+
+on_error:
+	if( *rtf_decoder != NULL )
+	{
+		memory_free(
+		 *rtf_decoder );
+
+		*rtf_decoder = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a RTF decoder
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_rtf_decoder_free(
+     libpff_rtf_decoder_t **rtf_decoder,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_rtf_decoder_free";
+
+	if( rtf_decoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid RTF decoder.",
+		 function );
+
+		return( -1 );
+	}
+	if( *rtf_decoder != NULL )
+	{
+		memory_free(
+		 *rtf_decoder );
+
+		*rtf_decoder = NULL;
+	}
+	return( 1 );
+}
+
+/* Decodes LZFu compressed RTF data and extracts the encapsulated HTML or plain text body
+ * The RTF data is de-encapsulated while it is being decompressed, so the decompressed
+ * RTF data is never stored, only the 4 KiB LZFu dictionary is needed
+ * If utf8_string is NULL only the UTF-8 string size is determined
+ * The UTF-8 string size includes the end of string character
+ * Returns 1 if successful, 0 if the RTF data does not contain an encapsulated body or -1 on error
+ */
+int libpff_rtf_decoder_decode_compressed_data(
+     libpff_rtf_decoder_t *rtf_decoder,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
+     libcerror_error_t **error )
+{
+	uint8_t dictionary[ LIBPFF_RTF_LZFU_DICTIONARY_SIZE ];
+
+	static char *function                 = "libpff_rtf_decoder_decode_compressed_data";
+	size_t compressed_data_offset         = 0;
+	size_t end_of_data_offset             = 0;
+	uint32_t compressed_size              = 0;
+	uint32_t signature                    = 0;
+	uint32_t uncompressed_data_offset     = 0;
+	uint32_t uncompressed_size            = 0;
+	uint16_t compression_value            = 0;
+	uint16_t dictionary_read_index        = 0;
+	uint16_t dictionary_write_index       = 0;
+	uint8_t byte_value                    = 0;
+	uint8_t flag_byte                     = 0;
+	uint8_t flag_bit_index                = 0;
+	uint8_t match_size                    = 0;
+	int result                            = 1;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	uint32_t calculated_checksum          = 0;
+	uint32_t stored_checksum              = 0;
+#endif
+
+	if( rtf_decoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid RTF decoder.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compressed_data_size < 16 )
+	 || ( compressed_data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid compressed data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( utf8_string != NULL )
+	 && ( ( utf8_string_size == 0 )
+	  ||  ( utf8_string_size > (size_t) SSIZE_MAX ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid UTF-8 string size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 &( compressed_data[ 0 ] ),
+	 compressed_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( compressed_data[ 4 ] ),
+	 uncompressed_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( compressed_data[ 8 ] ),
+	 signature );
+
+	if( ( signature != LIBPFF_RTF_LZFU_SIGNATURE_COMPRESSED )
+	 && ( signature != LIBPFF_RTF_LZFU_SIGNATURE_UNCOMPRESSED ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported compression signature: 0x%08" PRIx32 ".",
+		 function,
+		 signature );
+
+		return( -1 );
+	}
+	/* The compressed size does not include the compressed size value itself
+	 */
+	if( ( compressed_size < 12 )
+	 || ( (size_t) compressed_size > ( compressed_data_size - 4 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid compressed size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	compressed_data_offset = 16;
+	end_of_data_offset     = (size_t) compressed_size + 4;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( compressed_data[ 12 ] ),
+		 stored_checksum );
+
+		if( signature == LIBPFF_RTF_LZFU_SIGNATURE_COMPRESSED )
+		{
+			if( libfmapi_checksum_calculate_weak_crc32(
+			     &calculated_checksum,
+			     &( compressed_data[ compressed_data_offset ] ),
+			     end_of_data_offset - compressed_data_offset,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to calculate weak CRC-32.",
+				 function );
+
+				return( -1 );
+			}
+			if( stored_checksum != calculated_checksum )
+			{
+				libcnotify_printf(
+				 "%s: mismatch in checksum ( 0x%08" PRIx32 " != 0x%08" PRIx32 " ).\n",
+				 function,
+				 stored_checksum,
+				 calculated_checksum );
+			}
+		}
+	}
+#endif
+	rtf_decoder->codepage                      = rtf_decoder->ascii_codepage;
+	rtf_decoder->body_type                     = LIBPFF_RTF_BODY_TYPE_UNKNOWN;
+	rtf_decoder->token_state                   = LIBPFF_RTF_TOKEN_STATE_TEXT;
+	rtf_decoder->control_word_size             = 0;
+	rtf_decoder->is_ignorable_destination      = 0;
+	rtf_decoder->binary_data_size              = 0;
+	rtf_decoder->number_of_fallback_characters = 0;
+	rtf_decoder->high_surrogate                = 0;
+	rtf_decoder->group_depth                   = 0;
+	rtf_decoder->byte_stream_size              = 0;
+	rtf_decoder->utf8_string                   = utf8_string;
+	rtf_decoder->utf8_string_size              = utf8_string_size;
+	rtf_decoder->utf8_string_index             = 0;
+
+	if( signature == LIBPFF_RTF_LZFU_SIGNATURE_UNCOMPRESSED )
+	{
+		while( ( result == 1 )
+		    && ( compressed_data_offset < end_of_data_offset )
+		    && ( uncompressed_data_offset < uncompressed_size ) )
+		{
+			result = libpff_rtf_decoder_append_byte(
+			          rtf_decoder,
+			          compressed_data[ compressed_data_offset++ ],
+			          error );
+
+			uncompressed_data_offset++;
+		}
+	}
+	else
+	{
+		if( memory_copy(
+		     dictionary,
+		     libpff_rtf_lzfu_prebuffer,
+		     LIBPFF_RTF_LZFU_PREBUFFER_SIZE ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy prebuffer to dictionary.",
+			 function );
+
+			return( -1 );
+		}
+		dictionary_write_index = LIBPFF_RTF_LZFU_PREBUFFER_SIZE;
+
+		while( ( result == 1 )
+		    && ( compressed_data_offset < end_of_data_offset )
+		    && ( uncompressed_data_offset < uncompressed_size ) )
+		{
+			flag_byte = compressed_data[ compressed_data_offset++ ];
+
+			for( flag_bit_index = 0;
+			     flag_bit_index < 8;
+			     flag_bit_index++ )
+			{
+				if( ( result != 1 )
+				 || ( compressed_data_offset >= end_of_data_offset )
+				 || ( uncompressed_data_offset >= uncompressed_size ) )
+				{
+					break;
+				}
+				if( ( flag_byte & 0x01 ) == 0 )
+				{
+					byte_value = compressed_data[ compressed_data_offset++ ];
+
+					dictionary[ dictionary_write_index ] = byte_value;
+
+					dictionary_write_index = ( dictionary_write_index + 1 ) % LIBPFF_RTF_LZFU_DICTIONARY_SIZE;
+
+					result = libpff_rtf_decoder_append_byte(
+					          rtf_decoder,
+					          byte_value,
+					          error );
+
+					uncompressed_data_offset++;
+				}
+				else
+				{
+					if( ( compressed_data_offset + 1 ) >= end_of_data_offset )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+						 "%s: compressed data too small.",
+						 function );
+
+						return( -1 );
+					}
+					byte_stream_copy_to_uint16_big_endian(
+					 &( compressed_data[ compressed_data_offset ] ),
+					 compression_value );
+
+					compressed_data_offset += 2;
+
+					dictionary_read_index = compression_value >> 4;
+					match_size            = (uint8_t) ( compression_value & 0x0f ) + 2;
+
+					/* A reference to the current write position marks the end of the compressed data
+					 */
+					if( dictionary_read_index == dictionary_write_index )
+					{
+						end_of_data_offset = compressed_data_offset;
+
+						break;
+					}
+					while( ( match_size > 0 )
+					    && ( result == 1 )
+					    && ( uncompressed_data_offset < uncompressed_size ) )
+					{
+						byte_value = dictionary[ dictionary_read_index ];
+
+						dictionary[ dictionary_write_index ] = byte_value;
+
+						dictionary_read_index  = ( dictionary_read_index + 1 ) % LIBPFF_RTF_LZFU_DICTIONARY_SIZE;
+						dictionary_write_index = ( dictionary_write_index + 1 ) % LIBPFF_RTF_LZFU_DICTIONARY_SIZE;
+
+						result = libpff_rtf_decoder_append_byte(
+						          rtf_decoder,
+						          byte_value,
+						          error );
+
+						uncompressed_data_offset++;
+						match_size--;
+					}
+				}
+				flag_byte >>= 1;
+			}
+		}
+	}
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append byte: %" PRIu32 " to RTF decoder.",
+		 function,
+		 uncompressed_data_offset );
+
+		return( -1 );
+	}
+	if( rtf_decoder->body_type == LIBPFF_RTF_BODY_TYPE_UNKNOWN )
+	{
+		return( 0 );
+	}
+	if( libpff_rtf_decoder_flush_byte_stream(
+	     rtf_decoder,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to flush byte stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string != NULL )
+	{
+		if( rtf_decoder->utf8_string_index >= utf8_string_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+			 "%s: UTF-8 string too small.",
+			 function );
+
+			return( -1 );
+		}
+		utf8_string[ rtf_decoder->utf8_string_index ] = 0;
+	}
+	rtf_decoder->utf8_string_index += 1;
+
+	rtf_decoder->utf8_string      = NULL;
+	rtf_decoder->utf8_string_size = 0;
+
+	return( 1 );
+}
+
+/* Appends a byte of RTF data
+ * Returns 1 if successful, 0 if no more data is needed or -1 on error
+ */
+int libpff_rtf_decoder_append_byte(
+     libpff_rtf_decoder_t *rtf_decoder,
+     uint8_t byte_value,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_rtf_decoder_append_byte";
+	int append_byte       = 0;
+	int group_index       = 0;
+	int result            = 1;
+
+	if( rtf_decoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid RTF decoder.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		append_byte = 0;
+
+		switch( rtf_decoder->token_state )
+		{
+			case LIBPFF_RTF_TOKEN_STATE_TEXT:
+				if( byte_value == (uint8_t) '\\' )
+				{
+					rtf_decoder->token_state       = LIBPFF_RTF_TOKEN_STATE_CONTROL;
+					rtf_decoder->control_word_size = 0;
+				}
+				else if( byte_value == (uint8_t) '{' )
+				{
+					/* The encapsulated body type is defined in the RTF header
+					 * before the first nested group
+					 */
+					if( ( rtf_decoder->group_depth > 0 )
+					 && ( rtf_decoder->body_type == LIBPFF_RTF_BODY_TYPE_UNKNOWN ) )
+					{
+						return( 0 );
+					}
+					if( rtf_decoder->group_depth >= LIBPFF_MAXIMUM_RTF_GROUP_DEPTH )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+						 "%s: invalid group depth value out of bounds.",
+						 function );
+
+						return( -1 );
+					}
+					if( libpff_rtf_decoder_flush_byte_stream(
+					     rtf_decoder,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+						 "%s: unable to flush byte stream.",
+						 function );
+
+						return( -1 );
+					}
+					group_index = rtf_decoder->group_depth;
+
+					if( group_index == 0 )
+					{
+						rtf_decoder->group_flags[ group_index ]        = 0;
+						rtf_decoder->group_unicode_skip[ group_index ] = 1;
+					}
+					else
+					{
+						rtf_decoder->group_flags[ group_index ]        = rtf_decoder->group_flags[ group_index - 1 ];
+						rtf_decoder->group_unicode_skip[ group_index ] = rtf_decoder->group_unicode_skip[ group_index - 1 ];
+					}
+					rtf_decoder->group_depth                  += 1;
+					rtf_decoder->is_ignorable_destination      = 0;
+					rtf_decoder->number_of_fallback_characters = 0;
+				}
+				else if( byte_value == (uint8_t) '}' )
+				{
+					if( libpff_rtf_decoder_flush_byte_stream(
+					     rtf_decoder,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+						 "%s: unable to flush byte stream.",
+						 function );
+
+						return( -1 );
+					}
+					if( rtf_decoder->group_depth > 0 )
+					{
+						rtf_decoder->group_depth -= 1;
+					}
+					rtf_decoder->number_of_fallback_characters = 0;
+
+					if( rtf_decoder->group_depth == 0 )
+					{
+						rtf_decoder->token_state = LIBPFF_RTF_TOKEN_STATE_END;
+
+						result = 0;
+					}
+				}
+				else if( ( byte_value != (uint8_t) '\r' )
+				      && ( byte_value != (uint8_t) '\n' )
+				      && ( byte_value != 0 ) )
+				{
+					result = libpff_rtf_decoder_append_text_byte(
+					          rtf_decoder,
+					          byte_value,
+					          error );
+				}
+				break;
+
+			case LIBPFF_RTF_TOKEN_STATE_CONTROL:
+				if( ( ( byte_value >= (uint8_t) 'a' )
+				  &&  ( byte_value <= (uint8_t) 'z' ) )
+				 || ( ( byte_value >= (uint8_t) 'A' )
+				  &&  ( byte_value <= (uint8_t) 'Z' ) ) )
+				{
+					rtf_decoder->control_word[ 0 ]     = byte_value;
+					rtf_decoder->control_word_size     = 1;
+					rtf_decoder->parameter             = 0;
+					rtf_decoder->has_parameter         = 0;
+					rtf_decoder->parameter_is_negative = 0;
+					rtf_decoder->token_state           = LIBPFF_RTF_TOKEN_STATE_CONTROL_WORD;
+				}
+				else if( byte_value == (uint8_t) '\'' )
+				{
+					rtf_decoder->token_state = LIBPFF_RTF_TOKEN_STATE_HEXADECIMAL_HIGH;
+				}
+				else if( ( byte_value == (uint8_t) '\\' )
+				      || ( byte_value == (uint8_t) '{' )
+				      || ( byte_value == (uint8_t) '}' ) )
+				{
+					rtf_decoder->token_state = LIBPFF_RTF_TOKEN_STATE_TEXT;
+
+					result = libpff_rtf_decoder_append_text_byte(
+					          rtf_decoder,
+					          byte_value,
+					          error );
+				}
+				else
+				{
+					/* Control symbols are handled as single character control words
+					 */
+					rtf_decoder->control_word[ 0 ]     = byte_value;
+					rtf_decoder->control_word_size     = 1;
+					rtf_decoder->parameter             = 0;
+					rtf_decoder->has_parameter         = 0;
+					rtf_decoder->parameter_is_negative = 0;
+					rtf_decoder->token_state           = LIBPFF_RTF_TOKEN_STATE_TEXT;
+
+					result = libpff_rtf_decoder_append_control_word(
+					          rtf_decoder,
+					          error );
+				}
+				break;
+
+			case LIBPFF_RTF_TOKEN_STATE_CONTROL_WORD:
+				if( ( ( byte_value >= (uint8_t) 'a' )
+				  &&  ( byte_value <= (uint8_t) 'z' ) )
+				 || ( ( byte_value >= (uint8_t) 'A' )
+				  &&  ( byte_value <= (uint8_t) 'Z' ) ) )
+				{
+					/* Control words longer than the buffer are truncated and will not match
+					 */
+					if( rtf_decoder->control_word_size < sizeof( rtf_decoder->control_word ) )
+					{
+						rtf_decoder->control_word[ rtf_decoder->control_word_size ] = byte_value;
+					}
+					rtf_decoder->control_word_size += 1;
+				}
+				else if( ( byte_value == (uint8_t) '-' )
+				      || ( ( byte_value >= (uint8_t) '0' )
+				       &&  ( byte_value <= (uint8_t) '9' ) ) )
+				{
+					if( byte_value == (uint8_t) '-' )
+					{
+						rtf_decoder->parameter_is_negative = 1;
+					}
+					else
+					{
+						rtf_decoder->parameter = (int32_t) ( byte_value - (uint8_t) '0' );
+					}
+					rtf_decoder->has_parameter = 1;
+					rtf_decoder->token_state   = LIBPFF_RTF_TOKEN_STATE_PARAMETER;
+				}
+				else
+				{
+					/* A space delimiter is part of the control word
+					 */
+					append_byte = (int) ( byte_value != (uint8_t) ' ' );
+
+					rtf_decoder->token_state = LIBPFF_RTF_TOKEN_STATE_TEXT;
+
+					result = libpff_rtf_decoder_append_control_word(
+					          rtf_decoder,
+					          error );
+				}
+				break;
+
+			case LIBPFF_RTF_TOKEN_STATE_PARAMETER:
+				if( ( byte_value >= (uint8_t) '0' )
+				 && ( byte_value <= (uint8_t) '9' ) )
+				{
+					if( rtf_decoder->parameter < 100000000L )
+					{
+						rtf_decoder->parameter *= 10;
+						rtf_decoder->parameter += (int32_t) ( byte_value - (uint8_t) '0' );
+					}
+				}
+				else
+				{
+					append_byte = (int) ( byte_value != (uint8_t) ' ' );
+
+					if( rtf_decoder->parameter_is_negative != 0 )
+					{
+						rtf_decoder->parameter = -( rtf_decoder->parameter );
+					}
+					rtf_decoder->token_state = LIBPFF_RTF_TOKEN_STATE_TEXT;
+
+					result = libpff_rtf_decoder_append_control_word(
+					          rtf_decoder,
+					          error );
+				}
+				break;
+
+			case LIBPFF_RTF_TOKEN_STATE_HEXADECIMAL_HIGH:
+			case LIBPFF_RTF_TOKEN_STATE_HEXADECIMAL_LOW:
+				if( ( byte_value >= (uint8_t) '0' )
+				 && ( byte_value <= (uint8_t) '9' ) )
+				{
+					byte_value -= (uint8_t) '0';
+				}
+				else if( ( byte_value >= (uint8_t) 'a' )
+				      && ( byte_value <= (uint8_t) 'f' ) )
+				{
+					byte_value -= (uint8_t) 'a' - 10;
+				}
+				else if( ( byte_value >= (uint8_t) 'A' )
+				      && ( byte_value <= (uint8_t) 'F' ) )
+				{
+					byte_value -= (uint8_t) 'A' - 10;
+				}
+				else
+				{
+					/* Ignore an invalid hexadecimal value
+					 */
+					append_byte = 1;
+
+					rtf_decoder->token_state = LIBPFF_RTF_TOKEN_STATE_TEXT;
+
+					break;
+				}
+				if( rtf_decoder->token_state == LIBPFF_RTF_TOKEN_STATE_HEXADECIMAL_HIGH )
+				{
+					rtf_decoder->hexadecimal_value = byte_value << 4;
+					rtf_decoder->token_state       = LIBPFF_RTF_TOKEN_STATE_HEXADECIMAL_LOW;
+				}
+				else
+				{
+					rtf_decoder->hexadecimal_value |= byte_value;
+					rtf_decoder->token_state        = LIBPFF_RTF_TOKEN_STATE_TEXT;
+
+					result = libpff_rtf_decoder_append_text_byte(
+					          rtf_decoder,
+					          rtf_decoder->hexadecimal_value,
+					          error );
+				}
+				break;
+
+			case LIBPFF_RTF_TOKEN_STATE_BINARY_DATA:
+				rtf_decoder->binary_data_size -= 1;
+
+				if( rtf_decoder->binary_data_size == 0 )
+				{
+					rtf_decoder->token_state = LIBPFF_RTF_TOKEN_STATE_TEXT;
+				}
+				break;
+
+			case LIBPFF_RTF_TOKEN_STATE_END:
+				result = 0;
+
+				break;
+
+			default:
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported token state: %" PRIu8 ".",
+				 function,
+				 rtf_decoder->token_state );
+
+				return( -1 );
+		}
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append RTF token.",
+			 function );
+
+			return( -1 );
+		}
+		/* A body that is not encapsulated was detected
+		 */
+		if( ( result == 0 )
+		 && ( rtf_decoder->token_state != LIBPFF_RTF_TOKEN_STATE_END ) )
+		{
+			return( 0 );
+		}
+	}
+	while( append_byte != 0 );
+
+	return( result );
+}
+
+/* Appends the current control word or control symbol
+ * Returns 1 if successful, 0 if no more data is needed or -1 on error
+ */
+int libpff_rtf_decoder_append_control_word(
+     libpff_rtf_decoder_t *rtf_decoder,
+     libcerror_error_t **error )
+{
+	static char *function                        = "libpff_rtf_decoder_append_control_word";
+	libuna_unicode_character_t unicode_character = 0;
+	size_t control_word_size                     = 0;
+	uint8_t *control_word                        = NULL;
+	uint8_t is_ignorable_destination             = 0;
+	uint8_t is_line_break                        = 0;
+	int destination_index                        = 0;
+	int group_index                              = 0;
+
+	if( rtf_decoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid RTF decoder.",
+		 function );
+
+		return( -1 );
+	}
+	control_word      = rtf_decoder->control_word;
+	control_word_size = rtf_decoder->control_word_size;
+
+	if( control_word_size > sizeof( rtf_decoder->control_word ) )
+	{
+		return( 1 );
+	}
+	/* The binary data must be skipped regardless of the group
+	 */
+	if( ( control_word_size == 3 )
+	 && ( memory_compare(
+	       control_word,
+	       "bin",
+	       3 ) == 0 ) )
+	{
+		if( rtf_decoder->parameter > 0 )
+		{
+			rtf_decoder->binary_data_size = (uint32_t) rtf_decoder->parameter;
+			rtf_decoder->token_state      = LIBPFF_RTF_TOKEN_STATE_BINARY_DATA;
+		}
+		return( 1 );
+	}
+	if( rtf_decoder->group_depth == 0 )
+	{
+		return( 1 );
+	}
+	group_index = rtf_decoder->group_depth - 1;
+
+	if( ( rtf_decoder->group_flags[ group_index ] & LIBPFF_RTF_GROUP_FLAG_SKIP ) != 0 )
+	{
+		return( 1 );
+	}
+	if( ( control_word_size == 1 )
+	 && ( control_word[ 0 ] == (uint8_t) '*' ) )
+	{
+		rtf_decoder->is_ignorable_destination = 1;
+
+		return( 1 );
+	}
+	is_ignorable_destination = rtf_decoder->is_ignorable_destination;
+
+	rtf_decoder->is_ignorable_destination = 0;
+
+	if( is_ignorable_destination != 0 )
+	{
+		/* The HTML tags are stored in \*\htmltag destinations, all other
+		 * ignorable destinations are not part of the encapsulated body
+		 */
+		if( ( control_word_size == 7 )
+		 && ( memory_compare(
+		       control_word,
+		       "htmltag",
+		       7 ) == 0 ) )
+		{
+			rtf_decoder->group_flags[ group_index ] &= ~( LIBPFF_RTF_GROUP_FLAG_HTMLRTF );
+			rtf_decoder->group_flags[ group_index ] |= LIBPFF_RTF_GROUP_FLAG_HTMLTAG;
+		}
+		else
+		{
+			rtf_decoder->group_flags[ group_index ] |= LIBPFF_RTF_GROUP_FLAG_SKIP;
+		}
+		return( 1 );
+	}
+	for( destination_index = 0;
+	     libpff_rtf_skip_destinations[ destination_index ] != NULL;
+	     destination_index++ )
+	{
+		if( ( control_word_size == narrow_string_length( libpff_rtf_skip_destinations[ destination_index ] ) )
+		 && ( memory_compare(
+		       control_word,
+		       libpff_rtf_skip_destinations[ destination_index ],
+		       control_word_size ) == 0 ) )
+		{
+			rtf_decoder->group_flags[ group_index ] |= LIBPFF_RTF_GROUP_FLAG_SKIP;
+
+			return( 1 );
+		}
+	}
+	if( rtf_decoder->body_type == LIBPFF_RTF_BODY_TYPE_UNKNOWN )
+	{
+		if( group_index == 0 )
+		{
+			if( ( control_word_size == 8 )
+			 && ( memory_compare(
+			       control_word,
+			       "fromhtml",
+			       8 ) == 0 ) )
+			{
+				rtf_decoder->body_type = LIBPFF_RTF_BODY_TYPE_HTML;
+			}
+			else if( ( control_word_size == 8 )
+			      && ( memory_compare(
+			            control_word,
+			            "fromtext",
+			            8 ) == 0 ) )
+			{
+				rtf_decoder->body_type = LIBPFF_RTF_BODY_TYPE_PLAIN_TEXT;
+			}
+			else if( ( control_word_size == 7 )
+			      && ( memory_compare(
+			            control_word,
+			            "ansicpg",
+			            7 ) == 0 ) )
+			{
+				if( rtf_decoder->parameter > 0 )
+				{
+					rtf_decoder->codepage = (int) rtf_decoder->parameter;
+				}
+			}
+		}
+		return( 1 );
+	}
+	if( ( control_word_size == 7 )
+	 && ( memory_compare(
+	       control_word,
+	       "htmlrtf",
+	       7 ) == 0 ) )
+	{
+		if( ( rtf_decoder->has_parameter != 0 )
+		 && ( rtf_decoder->parameter == 0 ) )
+		{
+			rtf_decoder->group_flags[ group_index ] &= ~( LIBPFF_RTF_GROUP_FLAG_HTMLRTF );
+		}
+		else
+		{
+			rtf_decoder->group_flags[ group_index ] |= LIBPFF_RTF_GROUP_FLAG_HTMLRTF;
+		}
+		return( 1 );
+	}
+	if( ( control_word_size == 2 )
+	 && ( memory_compare(
+	       control_word,
+	       "uc",
+	       2 ) == 0 ) )
+	{
+		if( ( rtf_decoder->parameter >= 0 )
+		 && ( rtf_decoder->parameter <= 255 ) )
+		{
+			rtf_decoder->group_unicode_skip[ group_index ] = (uint8_t) rtf_decoder->parameter;
+		}
+		return( 1 );
+	}
+	/* Control words and symbols count as a single fallback character
+	 */
+	if( rtf_decoder->number_of_fallback_characters > 0 )
+	{
+		rtf_decoder->number_of_fallback_characters -= 1;
+
+		return( 1 );
+	}
+	if( ( control_word_size == 1 )
+	 && ( control_word[ 0 ] == (uint8_t) 'u' ) )
+	{
+		/* The fallback characters that follow \u are skipped
+		 */
+		rtf_decoder->number_of_fallback_characters = rtf_decoder->group_unicode_skip[ group_index ];
+
+		if( ( rtf_decoder->group_flags[ group_index ] & LIBPFF_RTF_GROUP_FLAG_HTMLRTF ) != 0 )
+		{
+			return( 1 );
+		}
+		/* The \u parameter is a signed 16-bit value
+		 */
+		if( rtf_decoder->parameter < 0 )
+		{
+			unicode_character = (libuna_unicode_character_t) ( rtf_decoder->parameter + 65536 );
+		}
+		else
+		{
+			unicode_character = (libuna_unicode_character_t) rtf_decoder->parameter;
+		}
+		if( ( unicode_character >= 0x0000d800UL )
+		 && ( unicode_character <= 0x0000dbffUL ) )
+		{
+			rtf_decoder->high_surrogate = unicode_character;
+
+			return( 1 );
+		}
+		if( ( unicode_character >= 0x0000dc00UL )
+		 && ( unicode_character <= 0x0000dfffUL ) )
+		{
+			if( rtf_decoder->high_surrogate == 0 )
+			{
+				unicode_character = 0x0000fffdUL;
+			}
+			else
+			{
+				unicode_character = ( ( ( rtf_decoder->high_surrogate - 0x0000d800UL ) << 10 )
+				                  | ( unicode_character - 0x0000dc00UL ) )
+				                  + 0x00010000UL;
+			}
+		}
+		rtf_decoder->high_surrogate = 0;
+
+		return( libpff_rtf_decoder_append_unicode_character(
+		         rtf_decoder,
+		         unicode_character,
+		         error ) );
+	}
+	if( ( rtf_decoder->group_flags[ group_index ] & LIBPFF_RTF_GROUP_FLAG_HTMLRTF ) != 0 )
+	{
+		return( 1 );
+	}
+	if( ( control_word_size == 1 )
+	 && ( ( control_word[ 0 ] < (uint8_t) 'A' )
+	  ||  ( control_word[ 0 ] > (uint8_t) 'z' )
+	  || ( ( control_word[ 0 ] > (uint8_t) 'Z' )
+	   &&  ( control_word[ 0 ] < (uint8_t) 'a' ) ) ) )
+	{
+		switch( control_word[ 0 ] )
+		{
+			case (uint8_t) '~':
+				unicode_character = 0x000000a0UL;
+				break;
+
+			case (uint8_t) '_':
+				unicode_character = 0x00002011UL;
+				break;
+
+			case (uint8_t) '\t':
+				unicode_character = (libuna_unicode_character_t) '\t';
+				break;
+
+			case (uint8_t) '\r':
+			case (uint8_t) '\n':
+				is_line_break = 1;
+				break;
+
+			default:
+				break;
+		}
+	}
+	else if( ( ( control_word_size == 3 )
+	       &&  ( memory_compare(
+	              control_word,
+	              "par",
+	              3 ) == 0 ) )
+	      || ( ( control_word_size == 4 )
+	       &&  ( memory_compare(
+	              control_word,
+	              "line",
+	              4 ) == 0 ) ) )
+	{
+		is_line_break = 1;
+	}
+	else if( ( control_word_size == 3 )
+	      && ( memory_compare(
+	            control_word,
+	            "tab",
+	            3 ) == 0 ) )
+	{
+		unicode_character = (libuna_unicode_character_t) '\t';
+	}
+	else if( ( control_word_size == 6 )
+	      && ( memory_compare(
+	            control_word,
+	            "lquote",
+	            6 ) == 0 ) )
+	{
+		unicode_character = 0x00002018UL;
+	}
+	else if( ( control_word_size == 6 )
+	      && ( memory_compare(
+	            control_word,
+	            "rquote",
+	            6 ) == 0 ) )
+	{
+		unicode_character = 0x00002019UL;
+	}
+	else if( ( control_word_size == 9 )
+	      && ( memory_compare(
+	            control_word,
+	            "ldblquote",
+	            9 ) == 0 ) )
+	{
+		unicode_character = 0x0000201cUL;
+	}
+	else if( ( control_word_size == 9 )
+	      && ( memory_compare(
+	            control_word,
+	            "rdblquote",
+	            9 ) == 0 ) )
+	{
+		unicode_character = 0x0000201dUL;
+	}
+	else if( ( control_word_size == 6 )
+	      && ( memory_compare(
+	            control_word,
+	            "bullet",
+	            6 ) == 0 ) )
+	{
+		unicode_character = 0x00002022UL;
+	}
+	else if( ( control_word_size == 6 )
+	      && ( memory_compare(
+	            control_word,
+	            "endash",
+	            6 ) == 0 ) )
+	{
+		unicode_character = 0x00002013UL;
+	}
+	else if( ( control_word_size == 6 )
+	      && ( memory_compare(
+	            control_word,
+	            "emdash",
+	            6 ) == 0 ) )
+	{
+		unicode_character = 0x00002014UL;
+	}
+	if( is_line_break != 0 )
+	{
+		if( libpff_rtf_decoder_append_unicode_character(
+		     rtf_decoder,
+		     (libuna_unicode_character_t) '\r',
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append line break.",
+			 function );
+
+			return( -1 );
+		}
+		unicode_character = (libuna_unicode_character_t) '\n';
+	}
+	if( unicode_character != 0 )
+	{
+		if( libpff_rtf_decoder_append_unicode_character(
+		     rtf_decoder,
+		     unicode_character,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append Unicode character.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Appends a codepage encoded text byte
+ * Returns 1 if successful, 0 if no more data is needed or -1 on error
+ */
+int libpff_rtf_decoder_append_text_byte(
+     libpff_rtf_decoder_t *rtf_decoder,
+     uint8_t byte_value,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_rtf_decoder_append_text_byte";
+	int group_index       = 0;
+
+	if( rtf_decoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid RTF decoder.",
+		 function );
+
+		return( -1 );
+	}
+	if( rtf_decoder->group_depth == 0 )
+	{
+		return( 1 );
+	}
+	group_index = rtf_decoder->group_depth - 1;
+
+	if( ( rtf_decoder->group_flags[ group_index ] & LIBPFF_RTF_GROUP_FLAG_SKIP ) != 0 )
+	{
+		return( 1 );
+	}
+	/* Text before the encapsulated body type is defined indicates
+	 * the RTF data does not contain an encapsulated body
+	 */
+	if( rtf_decoder->body_type == LIBPFF_RTF_BODY_TYPE_UNKNOWN )
+	{
+		return( 0 );
+	}
+	if( rtf_decoder->number_of_fallback_characters > 0 )
+	{
+		rtf_decoder->number_of_fallback_characters -= 1;
+
+		return( 1 );
+	}
+	if( ( rtf_decoder->group_flags[ group_index ] & LIBPFF_RTF_GROUP_FLAG_HTMLRTF ) != 0 )
+	{
+		return( 1 );
+	}
+	rtf_decoder->byte_stream[ rtf_decoder->byte_stream_size ] = byte_value;
+
+	rtf_decoder->byte_stream_size += 1;
+
+	/* Wait for the trail byte of a double byte character
+	 */
+	if( ( rtf_decoder->byte_stream_size == 1 )
+	 && ( byte_value >= 0x81 )
+	 && ( ( rtf_decoder->codepage == LIBUNA_CODEPAGE_WINDOWS_932 )
+	  ||  ( rtf_decoder->codepage == LIBUNA_CODEPAGE_WINDOWS_936 )
+	  ||  ( rtf_decoder->codepage == LIBUNA_CODEPAGE_WINDOWS_949 )
+	  ||  ( rtf_decoder->codepage == LIBUNA_CODEPAGE_WINDOWS_950 ) ) )
+	{
+		return( 1 );
+	}
+	if( libpff_rtf_decoder_flush_byte_stream(
+	     rtf_decoder,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to flush byte stream.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Appends an Unicode character
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_rtf_decoder_append_unicode_character(
+     libpff_rtf_decoder_t *rtf_decoder,
+     libuna_unicode_character_t unicode_character,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_rtf_decoder_append_unicode_character";
+	int result            = 0;
+
+	if( rtf_decoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid RTF decoder.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_rtf_decoder_flush_byte_stream(
+	     rtf_decoder,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to flush byte stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( rtf_decoder->utf8_string == NULL )
+	{
+		result = libuna_unicode_character_size_to_utf8(
+		          unicode_character,
+		          &( rtf_decoder->utf8_string_index ),
+		          error );
+	}
+	else
+	{
+		/* Reserve space for the end of string character
+		 */
+		result = libuna_unicode_character_copy_to_utf8(
+		          unicode_character,
+		          rtf_decoder->utf8_string,
+		          rtf_decoder->utf8_string_size - 1,
+		          &( rtf_decoder->utf8_string_index ),
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_OUTPUT_FAILED,
+		 "%s: unable to copy Unicode character to UTF-8.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Flushes the pending codepage encoded bytes
+ * Bytes that cannot be converted are replaced by U+FFFD
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_rtf_decoder_flush_byte_stream(
+     libpff_rtf_decoder_t *rtf_decoder,
+     libcerror_error_t **error )
+{
+	static char *function                        = "libpff_rtf_decoder_flush_byte_stream";
+	libuna_unicode_character_t unicode_character = 0;
+	size_t byte_stream_index                     = 0;
+	size_t byte_stream_size                      = 0;
+	size_t previous_byte_stream_index            = 0;
+
+	if( rtf_decoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid RTF decoder.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_size = rtf_decoder->byte_stream_size;
+
+	/* Clear the byte stream size first since appending an Unicode character flushes the byte stream
+	 */
+	rtf_decoder->byte_stream_size = 0;
+
+	while( byte_stream_index < byte_stream_size )
+	{
+		previous_byte_stream_index = byte_stream_index;
+
+		if( libuna_unicode_character_copy_from_byte_stream(
+		     &unicode_character,
+		     rtf_decoder->byte_stream,
+		     byte_stream_size,
+		     &byte_stream_index,
+		     rtf_decoder->codepage,
+		     NULL ) != 1 )
+		{
+			unicode_character = 0x0000fffdUL;
+			byte_stream_index = previous_byte_stream_index + 1;
+		}
+		if( libpff_rtf_decoder_append_unicode_character(
+		     rtf_decoder,
+		     unicode_character,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append Unicode character.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the encapsulated body type
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_rtf_decoder_get_body_type(
+     libpff_rtf_decoder_t *rtf_decoder,
+     uint8_t *body_type,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_rtf_decoder_get_body_type";
+
+	if( rtf_decoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid RTF decoder.",
+		 function );
+
+		return( -1 );
+	}
+	if( body_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid body type.",
+		 function );
+
+		return( -1 );
+	}
+	*body_type = rtf_decoder->body_type;
+
+	return( 1 );
+}
+
+/* Retrieves the size of the UTF-8 string of the last decoded data
+ * The size includes the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_rtf_decoder_get_utf8_string_size(
+     libpff_rtf_decoder_t *rtf_decoder,
+     size_t *utf8_string_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_rtf_decoder_get_utf8_string_size";
+
+	if( rtf_decoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid RTF decoder.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string size.",
+		 function );
+
+		return( -1 );
+	}
+	*utf8_string_size = rtf_decoder->utf8_string_index;
+
+	return( 1 );
+}
+
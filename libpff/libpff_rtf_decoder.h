@@ -0,0 +1,184 @@
+/*
+ * RTF decoder functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPFF_RTF_DECODER_H )
+#define _LIBPFF_RTF_DECODER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libpff_definitions.h"
+#include "libpff_libcerror.h"
+#include "libpff_libuna.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libpff_rtf_decoder libpff_rtf_decoder_t;
+
+struct libpff_rtf_decoder
+{
+	/* The (default) ASCII codepage
+	 */
+	int ascii_codepage;
+
+	/* The codepage of the RTF text
+	 */
+	int codepage;
+
+	/* The encapsulated body type
+	 */
+	uint8_t body_type;
+
+	/* The token state
+	 */
+	uint8_t token_state;
+
+	/* The control word
+	 */
+	uint8_t control_word[ 32 ];
+
+	/* The control word size
+	 */
+	size_t control_word_size;
+
+	/* The control word parameter
+	 */
+	int32_t parameter;
+
+	/* Value to indicate the control word has a parameter
+	 */
+	uint8_t has_parameter;
+
+	/* Value to indicate the control word parameter is negative
+	 */
+	uint8_t parameter_is_negative;
+
+	/* Value to indicate the next control word is an ignorable destination
+	 */
+	uint8_t is_ignorable_destination;
+
+	/* The hexadecimal value
+	 */
+	uint8_t hexadecimal_value;
+
+	/* The number of binary data bytes to skip
+	 */
+	uint32_t binary_data_size;
+
+	/* The number of fallback characters to skip
+	 */
+	uint32_t number_of_fallback_characters;
+
+	/* The pending high surrogate of an UTF-16 surrogate pair
+	 */
+	libuna_unicode_character_t high_surrogate;
+
+	/* The group depth
+	 */
+	int group_depth;
+
+	/* The group flags
+	 */
+	uint8_t group_flags[ LIBPFF_MAXIMUM_RTF_GROUP_DEPTH ];
+
+	/* The number of fallback characters per group as set by \uc
+	 */
+	uint8_t group_unicode_skip[ LIBPFF_MAXIMUM_RTF_GROUP_DEPTH ];
+
+	/* The pending codepage encoded bytes
+	 */
+	uint8_t byte_stream[ 2 ];
+
+	/* The pending codepage encoded bytes size
+	 */
+	size_t byte_stream_size;
+
+	/* The UTF-8 string
+	 */
+	uint8_t *utf8_string;
+
+	/* The UTF-8 string size
+	 */
+	size_t utf8_string_size;
+
+	/* The UTF-8 string index
+	 */
+	size_t utf8_string_index;
+};
+
+int libpff_rtf_decoder_initialize(
+     libpff_rtf_decoder_t **rtf_decoder,
+     int ascii_codepage,
+     libcerror_error_t **error );
+
+int libpff_rtf_decoder_free(
+     libpff_rtf_decoder_t **rtf_decoder,
+     libcerror_error_t **error );
+
+int libpff_rtf_decoder_decode_compressed_data(
+     libpff_rtf_decoder_t *rtf_decoder,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
+     libcerror_error_t **error );
+
+int libpff_rtf_decoder_append_byte(
+     libpff_rtf_decoder_t *rtf_decoder,
+     uint8_t byte_value,
+     libcerror_error_t **error );
+
+int libpff_rtf_decoder_append_control_word(
+     libpff_rtf_decoder_t *rtf_decoder,
+     libcerror_error_t **error );
+
+int libpff_rtf_decoder_append_text_byte(
+     libpff_rtf_decoder_t *rtf_decoder,
+     uint8_t byte_value,
+     libcerror_error_t **error );
+
+int libpff_rtf_decoder_append_unicode_character(
+     libpff_rtf_decoder_t *rtf_decoder,
+     libuna_unicode_character_t unicode_character,
+     libcerror_error_t **error );
+
+int libpff_rtf_decoder_flush_byte_stream(
+     libpff_rtf_decoder_t *rtf_decoder,
+     libcerror_error_t **error );
+
+int libpff_rtf_decoder_get_body_type(
+     libpff_rtf_decoder_t *rtf_decoder,
+     uint8_t *body_type,
+     libcerror_error_t **error );
+
+int libpff_rtf_decoder_get_utf8_string_size(
+     libpff_rtf_decoder_t *rtf_decoder,
+     size_t *utf8_string_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPFF_RTF_DECODER_H ) */
+
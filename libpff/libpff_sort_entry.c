@@ -0,0 +1,604 @@
+/*
+ * Sort entry functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libpff_definitions.h"
+#include "libpff_libcdata.h"
+#include "libpff_libcerror.h"
+#include "libpff_mapi.h"
+#include "libpff_record_entry.h"
+#include "libpff_sort_entry.h"
+
+/* Sets the key of a sort entry from the value of a record entry
+ * Integer, boolean, floating-point and time values are supported
+ * Returns 1 if successful, 0 if the value type is not supported or -1 on error
+ */
+int libpff_sort_entry_set_key_from_record_entry(
+     libpff_sort_entry_t *sort_entry,
+     libpff_record_entry_t *record_entry,
+     libcerror_error_t **error )
+{
+	libpff_internal_record_entry_t *internal_record_entry = NULL;
+	static char *function                                 = "libpff_sort_entry_set_key_from_record_entry";
+	size_t required_value_data_size                       = 0;
+	uint64_t value_64bit                                  = 0;
+	uint32_t value_32bit                                  = 0;
+	uint16_t value_16bit                                  = 0;
+
+	union
+	{
+		double floating_point;
+		float floating_point_32bit;
+		uint64_t integer;
+		uint32_t integer_32bit;
+	} value;
+
+	if( sort_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sort entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_record_entry = (libpff_internal_record_entry_t *) record_entry;
+
+	if( internal_record_entry->identifier.format != LIBPFF_RECORD_ENTRY_IDENTIFIER_FORMAT_MAPI_PROPERTY )
+	{
+		return( 0 );
+	}
+	switch( internal_record_entry->identifier.value_type )
+	{
+		case LIBPFF_VALUE_TYPE_BOOLEAN:
+			required_value_data_size = 1;
+			break;
+
+		case LIBPFF_VALUE_TYPE_INTEGER_16BIT_SIGNED:
+			required_value_data_size = 2;
+			break;
+
+		case LIBPFF_VALUE_TYPE_INTEGER_32BIT_SIGNED:
+		case LIBPFF_VALUE_TYPE_FLOAT_32BIT:
+			required_value_data_size = 4;
+			break;
+
+		case LIBPFF_VALUE_TYPE_DOUBLE_64BIT:
+		case LIBPFF_VALUE_TYPE_CURRENCY:
+		case LIBPFF_VALUE_TYPE_FLOATINGTIME:
+		case LIBPFF_VALUE_TYPE_INTEGER_64BIT_SIGNED:
+		case LIBPFF_VALUE_TYPE_FILETIME:
+			required_value_data_size = 8;
+			break;
+
+		default:
+			return( 0 );
+	}
+	sort_entry->has_key = 0;
+
+	/* Entries without value data have no key and are sorted last
+	 */
+	if( internal_record_entry->value_data == NULL )
+	{
+		return( 1 );
+	}
+	if( internal_record_entry->value_data_size < required_value_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid record entry - value data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	switch( internal_record_entry->identifier.value_type )
+	{
+		case LIBPFF_VALUE_TYPE_BOOLEAN:
+			value_64bit = ( internal_record_entry->value_data[ 0 ] != 0 ) ? 1 : 0;
+			break;
+
+		case LIBPFF_VALUE_TYPE_INTEGER_16BIT_SIGNED:
+			byte_stream_copy_to_uint16_little_endian(
+			 internal_record_entry->value_data,
+			 value_16bit );
+
+			value_64bit = (uint64_t) (int64_t) (int16_t) value_16bit;
+			value_64bit ^= (uint64_t) 0x8000000000000000UL;
+			break;
+
+		case LIBPFF_VALUE_TYPE_INTEGER_32BIT_SIGNED:
+			byte_stream_copy_to_uint32_little_endian(
+			 internal_record_entry->value_data,
+			 value_32bit );
+
+			value_64bit = (uint64_t) (int64_t) (int32_t) value_32bit;
+			value_64bit ^= (uint64_t) 0x8000000000000000UL;
+			break;
+
+		case LIBPFF_VALUE_TYPE_CURRENCY:
+		case LIBPFF_VALUE_TYPE_INTEGER_64BIT_SIGNED:
+			byte_stream_copy_to_uint64_little_endian(
+			 internal_record_entry->value_data,
+			 value_64bit );
+
+			value_64bit ^= (uint64_t) 0x8000000000000000UL;
+			break;
+
+		case LIBPFF_VALUE_TYPE_FILETIME:
+			byte_stream_copy_to_uint64_little_endian(
+			 internal_record_entry->value_data,
+			 value_64bit );
+			break;
+
+		case LIBPFF_VALUE_TYPE_FLOAT_32BIT:
+		case LIBPFF_VALUE_TYPE_DOUBLE_64BIT:
+		case LIBPFF_VALUE_TYPE_FLOATINGTIME:
+			if( internal_record_entry->identifier.value_type == LIBPFF_VALUE_TYPE_FLOAT_32BIT )
+			{
+				byte_stream_copy_to_uint32_little_endian(
+				 internal_record_entry->value_data,
+				 value.integer_32bit );
+
+				value.floating_point = (double) value.floating_point_32bit;
+			}
+			else
+			{
+				byte_stream_copy_to_uint64_little_endian(
+				 internal_record_entry->value_data,
+				 value.integer );
+			}
+			value_64bit = value.integer;
+
+			/* Map the IEEE 754 representation so that it compares as an unsigned integer
+			 */
+			if( ( value_64bit & (uint64_t) 0x8000000000000000UL ) != 0 )
+			{
+				value_64bit = ~value_64bit;
+			}
+			else
+			{
+				value_64bit |= (uint64_t) 0x8000000000000000UL;
+			}
+			break;
+	}
+	sort_entry->key     = value_64bit;
+	sort_entry->has_key = 1;
+
+	return( 1 );
+}
+
+/* Compares two sort entries
+ * Entries without a key are sorted last and entries with equal keys are sorted by row index
+ * Returns LIBCDATA_COMPARE_LESS, LIBCDATA_COMPARE_EQUAL, LIBCDATA_COMPARE_GREATER if successful or -1 on error
+ */
+int libpff_sort_entry_compare(
+     const libpff_sort_entry_t *first_sort_entry,
+     const libpff_sort_entry_t *second_sort_entry,
+     int sort_order,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_sort_entry_compare";
+
+	if( first_sort_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid first sort entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( second_sort_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid second sort entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( sort_order != LIBPFF_SORT_ORDER_ASCENDING )
+	 && ( sort_order != LIBPFF_SORT_ORDER_DESCENDING ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported sort order.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_sort_entry->has_key != second_sort_entry->has_key )
+	{
+		if( first_sort_entry->has_key != 0 )
+		{
+			return( LIBCDATA_COMPARE_LESS );
+		}
+		return( LIBCDATA_COMPARE_GREATER );
+	}
+	if( ( first_sort_entry->has_key != 0 )
+	 && ( first_sort_entry->key != second_sort_entry->key ) )
+	{
+		if( ( first_sort_entry->key < second_sort_entry->key )
+		 == ( sort_order == LIBPFF_SORT_ORDER_ASCENDING ) )
+		{
+			return( LIBCDATA_COMPARE_LESS );
+		}
+		return( LIBCDATA_COMPARE_GREATER );
+	}
+	if( first_sort_entry->row_index < second_sort_entry->row_index )
+	{
+		return( LIBCDATA_COMPARE_LESS );
+	}
+	else if( first_sort_entry->row_index > second_sort_entry->row_index )
+	{
+		return( LIBCDATA_COMPARE_GREATER );
+	}
+	return( LIBCDATA_COMPARE_EQUAL );
+}
+
+/* Moves a sort entry down the heap until it is ordered
+ * The sort entries form a heap that has the entry that is sorted last as its root
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_sort_entries_sift_down(
+     libpff_sort_entry_t *sort_entries,
+     int number_of_sort_entries,
+     int sort_entry_index,
+     int sort_order,
+     libcerror_error_t **error )
+{
+	libpff_sort_entry_t sort_entry;
+
+	static char *function   = "libpff_sort_entries_sift_down";
+	int child_index         = 0;
+	int compare_result      = 0;
+
+	if( sort_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sort entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( sort_entry_index < 0 )
+	 || ( sort_entry_index >= number_of_sort_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sort entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	sort_entry = sort_entries[ sort_entry_index ];
+
+	while( sort_entry_index < ( number_of_sort_entries / 2 ) )
+	{
+		child_index = ( 2 * sort_entry_index ) + 1;
+
+		if( ( child_index + 1 ) < number_of_sort_entries )
+		{
+			compare_result = libpff_sort_entry_compare(
+			                  &( sort_entries[ child_index ] ),
+			                  &( sort_entries[ child_index + 1 ] ),
+			                  sort_order,
+			                  error );
+
+			if( compare_result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to compare sort entries.",
+				 function );
+
+				return( -1 );
+			}
+			else if( compare_result == LIBCDATA_COMPARE_LESS )
+			{
+				child_index += 1;
+			}
+		}
+		compare_result = libpff_sort_entry_compare(
+		                  &sort_entry,
+		                  &( sort_entries[ child_index ] ),
+		                  sort_order,
+		                  error );
+
+		if( compare_result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to compare sort entries.",
+			 function );
+
+			return( -1 );
+		}
+		else if( compare_result != LIBCDATA_COMPARE_LESS )
+		{
+			break;
+		}
+		sort_entries[ sort_entry_index ] = sort_entries[ child_index ];
+
+		sort_entry_index = child_index;
+	}
+	sort_entries[ sort_entry_index ] = sort_entry;
+
+	return( 1 );
+}
+
+/* Selects a sort entry into the sort entries if it is one of the first maximum number of sort entries in sort order
+ * The sort entries are kept as a heap, use libpff_sort_entries_sort to order them
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_sort_entries_select(
+     libpff_sort_entry_t *sort_entries,
+     int maximum_number_of_sort_entries,
+     int *number_of_sort_entries,
+     const libpff_sort_entry_t *sort_entry,
+     int sort_order,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_sort_entries_select";
+	int compare_result    = 0;
+	int parent_index      = 0;
+	int sort_entry_index  = 0;
+
+	if( sort_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sort entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_sort_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of sort entries value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_sort_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of sort entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( *number_of_sort_entries < 0 )
+	 || ( *number_of_sort_entries > maximum_number_of_sort_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of sort entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( sort_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sort entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *number_of_sort_entries < maximum_number_of_sort_entries )
+	{
+		/* Add the sort entry as a leaf and move it up the heap
+		 */
+		sort_entry_index = *number_of_sort_entries;
+
+		while( sort_entry_index > 0 )
+		{
+			parent_index = ( sort_entry_index - 1 ) / 2;
+
+			compare_result = libpff_sort_entry_compare(
+			                  &( sort_entries[ parent_index ] ),
+			                  sort_entry,
+			                  sort_order,
+			                  error );
+
+			if( compare_result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to compare sort entries.",
+				 function );
+
+				return( -1 );
+			}
+			else if( compare_result != LIBCDATA_COMPARE_LESS )
+			{
+				break;
+			}
+			sort_entries[ sort_entry_index ] = sort_entries[ parent_index ];
+
+			sort_entry_index = parent_index;
+		}
+		sort_entries[ sort_entry_index ] = *sort_entry;
+
+		*number_of_sort_entries += 1;
+
+		return( 1 );
+	}
+	/* Replace the root, that is sorted last, if the sort entry is sorted before it
+	 */
+	compare_result = libpff_sort_entry_compare(
+	                  sort_entry,
+	                  &( sort_entries[ 0 ] ),
+	                  sort_order,
+	                  error );
+
+	if( compare_result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to compare sort entries.",
+		 function );
+
+		return( -1 );
+	}
+	else if( compare_result == LIBCDATA_COMPARE_LESS )
+	{
+		sort_entries[ 0 ] = *sort_entry;
+
+		if( libpff_sort_entries_sift_down(
+		     sort_entries,
+		     *number_of_sort_entries,
+		     0,
+		     sort_order,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to sift down sort entry.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sorts the sort entries selected by libpff_sort_entries_select in sort order
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_sort_entries_sort(
+     libpff_sort_entry_t *sort_entries,
+     int number_of_sort_entries,
+     int sort_order,
+     libcerror_error_t **error )
+{
+	libpff_sort_entry_t sort_entry;
+
+	static char *function = "libpff_sort_entries_sort";
+	int sort_entry_index  = 0;
+
+	if( sort_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sort entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_sort_entries < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of sort entries value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	/* Repeatedly move the root, that is sorted last, behind the remaining heap
+	 */
+	for( sort_entry_index = number_of_sort_entries - 1;
+	     sort_entry_index > 0;
+	     sort_entry_index-- )
+	{
+		sort_entry                       = sort_entries[ 0 ];
+		sort_entries[ 0 ]                = sort_entries[ sort_entry_index ];
+		sort_entries[ sort_entry_index ] = sort_entry;
+
+		if( libpff_sort_entries_sift_down(
+		     sort_entries,
+		     sort_entry_index,
+		     0,
+		     sort_order,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to sift down sort entry.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
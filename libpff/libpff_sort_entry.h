@@ -0,0 +1,94 @@
+/*
+ * Sort entry functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPFF_SORT_ENTRY_H )
+#define _LIBPFF_SORT_ENTRY_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libpff_libcerror.h"
+#include "libpff_record_entry.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libpff_sort_entry libpff_sort_entry_t;
+
+struct libpff_sort_entry
+{
+	/* The sort key
+	 * The key is mapped so that keys of every supported value type compare as unsigned integers
+	 */
+	uint64_t key;
+
+	/* Value to indicate the entry has a key
+	 */
+	uint8_t has_key;
+
+	/* The (table) row index
+	 */
+	int row_index;
+
+	/* The identifier
+	 */
+	uint32_t identifier;
+};
+
+int libpff_sort_entry_set_key_from_record_entry(
+     libpff_sort_entry_t *sort_entry,
+     libpff_record_entry_t *record_entry,
+     libcerror_error_t **error );
+
+int libpff_sort_entry_compare(
+     const libpff_sort_entry_t *first_sort_entry,
+     const libpff_sort_entry_t *second_sort_entry,
+     int sort_order,
+     libcerror_error_t **error );
+
+int libpff_sort_entries_sift_down(
+     libpff_sort_entry_t *sort_entries,
+     int number_of_sort_entries,
+     int sort_entry_index,
+     int sort_order,
+     libcerror_error_t **error );
+
+int libpff_sort_entries_select(
+     libpff_sort_entry_t *sort_entries,
+     int maximum_number_of_sort_entries,
+     int *number_of_sort_entries,
+     const libpff_sort_entry_t *sort_entry,
+     int sort_order,
+     libcerror_error_t **error );
+
+int libpff_sort_entries_sort(
+     libpff_sort_entry_t *sort_entries,
+     int number_of_sort_entries,
+     int sort_order,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPFF_SORT_ENTRY_H ) */
+
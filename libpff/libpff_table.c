@@ -41,7 +41,9 @@
 #include "libpff_libfguid.h"
 #include "libpff_libfmapi.h"
 #include "libpff_libuna.h"
+#include "libpff_local_descriptor_node.h"
 #include "libpff_local_descriptor_value.h"
+#include "libpff_local_descriptors.h"
 #include "libpff_local_descriptors_tree.h"
 #include "libpff_mapi.h"
 #include "libpff_name_to_id_map.h"
@@ -503,6 +505,132 @@ on_error:
 	return( -1 );
 }
 
+/* Retrieves the size of the value data of the record entries in the table
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_table_get_value_data_size(
+     libpff_table_t *table,
+     size_t *value_data_size,
+     libcerror_error_t **error )
+{
+	libpff_internal_record_entry_t *internal_record_entry = NULL;
+	libpff_internal_record_set_t *internal_record_set     = NULL;
+	static char *function                                 = "libpff_table_get_value_data_size";
+	size_t safe_value_data_size                           = 0;
+	int number_of_entries                                 = 0;
+	int number_of_sets                                    = 0;
+	int entry_index                                       = 0;
+	int set_index                                         = 0;
+
+	if( table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     table->record_sets_array,
+	     &number_of_sets,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of record sets array entries.",
+		 function );
+
+		return( -1 );
+	}
+	for( set_index = 0;
+	     set_index < number_of_sets;
+	     set_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     table->record_sets_array,
+		     set_index,
+		     (intptr_t **) &internal_record_set,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve record set: %d.",
+			 function,
+			 set_index );
+
+			return( -1 );
+		}
+		if( internal_record_set == NULL )
+		{
+			continue;
+		}
+		if( libcdata_array_get_number_of_entries(
+		     internal_record_set->entries_array,
+		     &number_of_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of entries of record set: %d.",
+			 function,
+			 set_index );
+
+			return( -1 );
+		}
+		for( entry_index = 0;
+		     entry_index < number_of_entries;
+		     entry_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     internal_record_set->entries_array,
+			     entry_index,
+			     (intptr_t **) &internal_record_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve record entry: %d of set: %d.",
+				 function,
+				 entry_index,
+				 set_index );
+
+				return( -1 );
+			}
+			safe_value_data_size += sizeof( libpff_internal_record_entry_t );
+
+			if( internal_record_entry != NULL )
+			{
+				safe_value_data_size += internal_record_entry->value_data_size;
+			}
+		}
+	}
+	*value_data_size = safe_value_data_size;
+
+	return( 1 );
+}
+
 /* Resizes the record entries
  * Returns 1 if successful or -1 on error
  */
@@ -2064,6 +2192,7 @@ int libpff_table_read(
 {
 	libpff_data_block_t *data_block               = NULL;
 	static char *function                         = "libpff_table_read";
+	int result                                    = 0;
 
 #if defined( HAVE_DEBUG_OUTPUT )
 	libpff_table_block_index_t *table_block_index = NULL;
@@ -2131,6 +2260,32 @@ int libpff_table_read(
 
 		return( -1 );
 	}
+	/* The first data block and the local descriptors root node are read together,
+	 * recovered tables are read separately since they can have multiple recovered
+	 * offsets index values
+	 */
+	if( ( table->recovered == 0 )
+	 && ( table->local_descriptors_identifier > 0 ) )
+	{
+		result = libpff_table_read_first_data_blocks(
+		          table,
+		          io_handle,
+		          file_io_handle,
+		          offsets_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read first data blocks.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	if( table->local_descriptors_identifier > 0 )
 	{
 		if( libpff_local_descriptors_tree_read(
@@ -2175,29 +2330,32 @@ int libpff_table_read(
 			return( -1 );
 		}
 	}
-	if( libpff_table_read_descriptor_data_list(
-	     table,
-	     io_handle,
-	     file_io_handle,
-	     offsets_index,
-	     table->descriptor_identifier,
-	     table->data_identifier,
-	     table->recovered,
-	     table->recovered_data_identifier_value_index,
-	     &( table->descriptor_data_list ),
-	     &( table->descriptor_data_cache ),
-	     error ) != 1 )
+	if( result == 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read descriptor: %" PRIu32 " data: %" PRIu64 " list.",
-		 function,
-		 table->descriptor_identifier,
-		 table->data_identifier );
+		if( libpff_table_read_descriptor_data_list(
+		     table,
+		     io_handle,
+		     file_io_handle,
+		     offsets_index,
+		     table->descriptor_identifier,
+		     table->data_identifier,
+		     table->recovered,
+		     table->recovered_data_identifier_value_index,
+		     &( table->descriptor_data_list ),
+		     &( table->descriptor_data_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read descriptor: %" PRIu32 " data: %" PRIu64 " list.",
+			 function,
+			 table->descriptor_identifier,
+			 table->data_identifier );
 
-		return( -1 );
+			return( -1 );
+		}
 	}
 	/* Retrieve the first table data block
 	 */
@@ -2460,12 +2618,9 @@ int libpff_table_read_descriptor_data_list(
      libfcache_cache_t **descriptor_data_cache,
      libcerror_error_t **error )
 {
-	libpff_data_array_t *data_array          = NULL;
 	libpff_data_block_t *data_block          = NULL;
 	libpff_index_value_t *offset_index_value = NULL;
 	static char *function                    = "libpff_table_read_descriptor_data_list";
-	uint32_t total_data_size                 = 0;
-	int element_index                        = 0;
 
 	if( table == NULL )
 	{
@@ -2644,226 +2799,834 @@ int libpff_table_read_descriptor_data_list(
 
 		goto on_error;
 	}
-	/* Check if the data block contains a data array
-	 * The data array should have the internal flag set in the (data) offset index identifier
-	 * The data array starts with 0x01 followed by either 0x01 or 0x02
+	if( libpff_table_read_descriptor_data_list_from_data_block(
+	     table,
+	     io_handle,
+	     file_io_handle,
+	     offsets_index,
+	     descriptor_identifier,
+	     data_identifier,
+	     recovered,
+	     offset_index_value,
+	     &data_block,
+	     descriptor_data_list,
+	     descriptor_data_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read descriptor data list from data block.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( data_block != NULL )
+	{
+		libpff_data_block_free(
+		 &data_block,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the data list of a descriptor from its first data block
+ * The data block is set to NULL when it is taken over by the data list or freed,
+ * otherwise the caller retains management of the data block
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_table_read_descriptor_data_list_from_data_block(
+     libpff_table_t *table,
+     libpff_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libpff_offsets_index_t *offsets_index,
+     uint32_t descriptor_identifier,
+     uint64_t data_identifier,
+     uint8_t recovered,
+     libpff_index_value_t *offset_index_value,
+     libpff_data_block_t **data_block,
+     libfdata_list_t **descriptor_data_list,
+     libfcache_cache_t **descriptor_data_cache,
+     libcerror_error_t **error )
+{
+	libpff_data_array_t *data_array = NULL;
+	static char *function           = "libpff_table_read_descriptor_data_list_from_data_block";
+	uint32_t total_data_size        = 0;
+	int element_index               = 0;
+
+	if( table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset_index_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset index value.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data block.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing data block.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( *data_block )->data == NULL )
+	 || ( ( *data_block )->uncompressed_data_size < 2 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data block - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( descriptor_data_list == NULL )
+	 || ( *descriptor_data_list != NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid descriptor data list.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( descriptor_data_cache == NULL )
+	 || ( *descriptor_data_cache != NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid descriptor data cache.",
+		 function );
+
+		return( -1 );
+	}
+	/* Check if the data block contains a data array
+	 * The data array should have the internal flag set in the (data) offset index identifier
+	 * The data array starts with 0x01 followed by either 0x01 or 0x02
+	 */
+	if( ( ( data_identifier & (uint64_t) LIBPFF_OFFSET_INDEX_IDENTIFIER_FLAG_INTERNAL ) != 0 )
+	 && ( ( ( *data_block )->data[ 0 ] == 0x01 )
+	  &&  ( ( ( *data_block )->data[ 1 ] == 0x01 )
+	   ||   ( ( *data_block )->data[ 1 ] == 0x02 ) ) ) )
+	{
+		if( libpff_data_array_initialize(
+		     &data_array,
+		     io_handle,
+		     descriptor_identifier,
+		     data_identifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create data array.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfdata_list_initialize(
+		     descriptor_data_list,
+		     (intptr_t *) data_array,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_data_array_free,
+		     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libpff_data_array_clone,
+		     (int (*)(intptr_t *, intptr_t *, libfdata_list_element_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &libpff_data_array_read_element_data,
+		     NULL,
+		     LIBFDATA_DATA_HANDLE_FLAG_MANAGED,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create descriptor data list.",
+			 function );
+
+			goto on_error;
+		}
+		/* The data_array is now managed by the list */
+
+		if( libpff_data_array_read_entries(
+		     data_array,
+		     io_handle,
+		     file_io_handle,
+		     offsets_index,
+		     *descriptor_data_list,
+		     recovered,
+		     ( *data_block )->data,
+		     (size_t) offset_index_value->data_size,
+		     &total_data_size,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data array entries.",
+			 function );
+
+			data_array = NULL;
+
+			goto on_error;
+		}
+		if( libpff_data_block_free(
+		     data_block,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free data block.",
+			 function );
+
+			data_array = NULL;
+
+			goto on_error;
+		}
+		if( libfcache_cache_initialize(
+		     descriptor_data_cache,
+		     LIBPFF_MAXIMUM_CACHE_ENTRIES_DATA_ARRAY,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create descriptor data cache.",
+			 function );
+
+			data_array = NULL;
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		if( libpff_data_block_decrypt_data(
+		     *data_block,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+			 "%s: unable to decrypt data block data.",
+			 function );
+
+			goto on_error;
+		}
+/* TODO change data block not be a data handle ? pass a descriptor instead ? */
+		if( libfdata_list_initialize(
+		     descriptor_data_list,
+		     (intptr_t *) *data_block,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_data_block_free,
+		     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libpff_data_block_clone,
+		     (int (*)(intptr_t *, intptr_t *, libfdata_list_element_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &libpff_data_block_read_element_data,
+		     NULL,
+		     LIBFDATA_DATA_HANDLE_FLAG_MANAGED,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create descriptor data list.",
+			 function );
+
+			goto on_error;
+		}
+		/* The data_block is now managed by the list */
+
+		if( libfdata_list_append_element_with_mapped_size(
+		     *descriptor_data_list,
+		     &element_index,
+		     0,
+		     offset_index_value->file_offset,
+		     (size64_t) offset_index_value->data_size,
+		     0,
+		     (size_t) ( *data_block )->uncompressed_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to append data list element.",
+			 function );
+
+			*data_block = NULL;
+
+			goto on_error;
+		}
+		if( libfcache_cache_initialize(
+		     descriptor_data_cache,
+		     LIBPFF_MAXIMUM_CACHE_ENTRIES_DATA_BLOCK,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create descriptor data cache.",
+			 function );
+
+			*data_block = NULL;
+
+			goto on_error;
+		}
+		/* The data block is managed by the list and should not be managed by the cache as well
+		 */
+		if( libfdata_list_set_element_value_by_index(
+		     *descriptor_data_list,
+		     (intptr_t *) file_io_handle,
+		     (libfdata_cache_t *) *descriptor_data_cache,
+		     0,
+		     (intptr_t *) *data_block,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_data_block_free,
+		     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_NON_MANAGED,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set data list element: 0.",
+			 function );
+
+			*data_block = NULL;
+
+			goto on_error;
+		}
+		*data_block = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( *descriptor_data_cache != NULL )
+	{
+		libfcache_cache_free(
+		 descriptor_data_cache,
+		 NULL );
+	}
+	if( *descriptor_data_list != NULL )
+	{
+		libfdata_list_free(
+		 descriptor_data_list,
+		 NULL );
+	}
+	if( data_array != NULL )
+	{
+		libpff_data_array_free(
+		 &data_array,
+		 NULL );
+	}
+	if( *data_block != NULL )
+	{
+		libpff_data_block_free(
+		 data_block,
+		 NULL );
+	}
+	return( -1 );
+}
+
+
+/* Reads the first data block of the table and the root node of its local descriptors together
+ * The offsets index values of both blocks are retrieved in a single look up and if the blocks
+ * are near each other in the file they are read with a single read
+ * The local descriptor node is stored in the local descriptor nodes cache of the IO handle,
+ * where it is retrieved from when the local descriptors are read
+ * Returns 1 if successful, 0 if the blocks could not be read together or -1 on error
+ */
+int libpff_table_read_first_data_blocks(
+     libpff_table_t *table,
+     libpff_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libpff_offsets_index_t *offsets_index,
+     libcerror_error_t **error )
+{
+	libpff_index_value_t index_values[ 2 ];
+	uint64_t data_identifiers[ 2 ];
+
+	libpff_data_block_t *data_block                       = NULL;
+	libpff_local_descriptor_node_t *local_descriptor_node = NULL;
+	libpff_local_descriptors_t *local_descriptors         = NULL;
+	uint8_t *read_buffer                                  = NULL;
+	static char *function                                 = "libpff_table_read_first_data_blocks";
+	size_t data_block_stored_size                         = 0;
+	size_t local_descriptor_node_stored_size              = 0;
+	size_t read_size                                      = 0;
+	ssize_t read_count                                    = 0;
+	off64_t data_block_end_offset                         = 0;
+	off64_t local_descriptor_node_end_offset              = 0;
+	off64_t read_end_offset                               = 0;
+	off64_t read_offset                                   = 0;
+	uint8_t read_local_descriptor_node                    = 0;
+	int index_value_index                                 = 0;
+	int result                                            = 0;
+
+	if( table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table.",
+		 function );
+
+		return( -1 );
+	}
+	if( table->recovered != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid table - unsupported recovered table.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	data_identifiers[ 0 ] = table->data_identifier;
+	data_identifiers[ 1 ] = table->local_descriptors_identifier;
+
+	result = libpff_offsets_index_get_index_values_by_identifiers(
+	          offsets_index,
+	          file_io_handle,
+	          data_identifiers,
+	          2,
+	          0,
+	          NULL,
+	          index_values,
+	          error );
+
+	if( result != 1 )
+	{
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve offsets index values.",
+			 function );
+		}
+		return( result );
+	}
+	/* Invalid offsets index values are left to the regular read functions to report
+	 */
+	for( index_value_index = 0;
+	     index_value_index < 2;
+	     index_value_index++ )
+	{
+		if( ( index_values[ index_value_index ].file_offset <= 0 )
+		 || ( index_values[ index_value_index ].data_size == 0 )
+		 || ( index_values[ index_value_index ].data_size > (size32_t) SSIZE_MAX ) )
+		{
+			return( 0 );
+		}
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: data identifier: %" PRIu64 " at offset: %" PRIi64 " of size: %" PRIu32 "\n",
+		 function,
+		 index_values[ 0 ].identifier,
+		 index_values[ 0 ].file_offset,
+		 index_values[ 0 ].data_size );
+
+		libcnotify_printf(
+		 "%s: local descriptors identifier: %" PRIu64 " at offset: %" PRIi64 " of size: %" PRIu32 "\n",
+		 function,
+		 index_values[ 1 ].identifier,
+		 index_values[ 1 ].file_offset,
+		 index_values[ 1 ].data_size );
+	}
+#endif
+	if( libpff_data_block_get_stored_size(
+	     index_values[ 0 ].data_size,
+	     io_handle->file_type,
+	     &data_block_stored_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine stored size of data block.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_data_block_get_stored_size(
+	     index_values[ 1 ].data_size,
+	     io_handle->file_type,
+	     &local_descriptor_node_stored_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine stored size of local descriptor node.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_local_descriptors_initialize(
+	     &local_descriptors,
+	     io_handle,
+	     offsets_index,
+	     table->descriptor_identifier,
+	     index_values[ 1 ].file_offset,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create local descriptors.",
+		 function );
+
+		goto on_error;
+	}
+	/* Without a local descriptor nodes cache the local descriptor node cannot be retained
+	 */
+	if( io_handle->local_descriptor_nodes_cache != NULL )
+	{
+		result = libpff_local_descriptors_has_cached_local_descriptor_node(
+		          local_descriptors,
+		          table->local_descriptors_identifier,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if local descriptor node is cached.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			read_local_descriptor_node = 1;
+		}
+	}
+	if( libpff_data_block_initialize(
+	     &data_block,
+	     io_handle,
+	     table->descriptor_identifier,
+	     table->data_identifier,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create data block.",
+		 function );
+
+		goto on_error;
+	}
+	data_block_end_offset            = index_values[ 0 ].file_offset + (off64_t) data_block_stored_size;
+	local_descriptor_node_end_offset = index_values[ 1 ].file_offset + (off64_t) local_descriptor_node_stored_size;
+
+	/* Blocks that overlap are not read together
 	 */
-	if( ( ( data_identifier & (uint64_t) LIBPFF_OFFSET_INDEX_IDENTIFIER_FLAG_INTERNAL ) != 0 )
-	 && ( ( data_block->data[ 0 ] == 0x01 )
-	  &&  ( ( data_block->data[ 1 ] == 0x01 )
-	   ||   ( data_block->data[ 1 ] == 0x02 ) ) ) )
+	if( read_local_descriptor_node != 0 )
 	{
-		if( libpff_data_array_initialize(
-		     &data_array,
-		     io_handle,
-		     descriptor_identifier,
-		     data_identifier,
-		     error ) != 1 )
+		if( ( local_descriptor_node_end_offset <= index_values[ 0 ].file_offset )
+		 && ( ( index_values[ 0 ].file_offset - local_descriptor_node_end_offset ) <= LIBPFF_MAXIMUM_COALESCED_READ_GAP_SIZE ) )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create data array.",
-			 function );
-
-			goto on_error;
+			read_offset     = index_values[ 1 ].file_offset;
+			read_end_offset = data_block_end_offset;
 		}
-		if( libfdata_list_initialize(
-		     descriptor_data_list,
-		     (intptr_t *) data_array,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_data_array_free,
-		     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libpff_data_array_clone,
-		     (int (*)(intptr_t *, intptr_t *, libfdata_list_element_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &libpff_data_array_read_element_data,
-		     NULL,
-		     LIBFDATA_DATA_HANDLE_FLAG_MANAGED,
-		     error ) != 1 )
+		else if( ( data_block_end_offset <= index_values[ 1 ].file_offset )
+		      && ( ( index_values[ 1 ].file_offset - data_block_end_offset ) <= LIBPFF_MAXIMUM_COALESCED_READ_GAP_SIZE ) )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create descriptor data list.",
-			 function );
-
-			goto on_error;
+			read_offset     = index_values[ 0 ].file_offset;
+			read_end_offset = local_descriptor_node_end_offset;
 		}
-		/* The data_array is now managed by the list */
+		read_size = (size_t) ( read_end_offset - read_offset );
+	}
+	if( read_size > 0 )
+	{
+		read_buffer = (uint8_t *) memory_allocate(
+		                           sizeof( uint8_t ) * read_size );
 
-		if( libpff_data_array_read_entries(
-		     data_array,
-		     io_handle,
-		     file_io_handle,
-		     offsets_index,
-		     *descriptor_data_list,
-		     recovered,
-		     data_block->data,
-		     (size_t) offset_index_value->data_size,
-		     &total_data_size,
-		     0,
-		     error ) != 1 )
+		if( read_buffer == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read data array entries.",
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create read buffer.",
 			 function );
 
-			data_array = NULL;
-
 			goto on_error;
 		}
-		if( libpff_data_block_free(
-		     &data_block,
-		     error ) != 1 )
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: reading data block and local descriptor node at offset: %" PRIi64 " (0x%08" PRIx64 ") of size: %" PRIzd "\n",
+			 function,
+			 read_offset,
+			 read_offset,
+			 read_size );
+		}
+#endif
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              file_io_handle,
+		              read_buffer,
+		              read_size,
+		              read_offset,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free data block.",
-			 function );
-
-			data_array = NULL;
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 read_offset,
+			 read_offset );
 
 			goto on_error;
 		}
-		if( libfcache_cache_initialize(
-		     descriptor_data_cache,
-		     LIBPFF_MAXIMUM_CACHE_ENTRIES_DATA_ARRAY,
+		if( libpff_data_block_read_data(
+		     data_block,
+		     &( read_buffer[ index_values[ 0 ].file_offset - read_offset ] ),
+		     data_block_stored_size,
+		     index_values[ 0 ].data_size,
+		     io_handle->file_type,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create descriptor data cache.",
-			 function );
-
-			data_array = NULL;
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data block at offset: %" PRIi64 ".",
+			 function,
+			 index_values[ 0 ].file_offset );
 
 			goto on_error;
 		}
 	}
 	else
 	{
-		if( libpff_data_block_decrypt_data(
+		if( libpff_data_block_read_file_io_handle(
 		     data_block,
-		     0,
+		     file_io_handle,
+		     index_values[ 0 ].file_offset,
+		     index_values[ 0 ].data_size,
+		     io_handle->file_type,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-			 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
-			 "%s: unable to decrypt data block data.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data block at offset: %" PRIi64 ".",
+			 function,
+			 index_values[ 0 ].file_offset );
 
 			goto on_error;
 		}
-/* TODO change data block not be a data handle ? pass a descriptor instead ? */
-		if( libfdata_list_initialize(
-		     descriptor_data_list,
-		     (intptr_t *) data_block,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_data_block_free,
-		     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libpff_data_block_clone,
-		     (int (*)(intptr_t *, intptr_t *, libfdata_list_element_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &libpff_data_block_read_element_data,
-		     NULL,
-		     LIBFDATA_DATA_HANDLE_FLAG_MANAGED,
+	}
+	if( read_local_descriptor_node != 0 )
+	{
+		if( libpff_local_descriptor_node_initialize(
+		     &local_descriptor_node,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create descriptor data list.",
+			 "%s: unable to create local descriptor node.",
 			 function );
 
 			goto on_error;
 		}
-		/* The data_block is now managed by the list */
-
-		if( libfdata_list_append_element_with_mapped_size(
-		     *descriptor_data_list,
-		     &element_index,
-		     0,
-		     offset_index_value->file_offset,
-		     (size64_t) offset_index_value->data_size,
-		     0,
-		     (size_t) data_block->uncompressed_data_size,
-		     error ) != 1 )
+		if( read_size > 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to append data list element.",
-			 function );
-
-			data_block = NULL;
-
-			goto on_error;
+			result = libpff_local_descriptor_node_read_stored_data(
+			          local_descriptor_node,
+			          io_handle,
+			          table->descriptor_identifier,
+			          table->local_descriptors_identifier,
+			          &( read_buffer[ index_values[ 1 ].file_offset - read_offset ] ),
+			          local_descriptor_node_stored_size,
+			          index_values[ 1 ].data_size,
+			          error );
 		}
-		if( libfcache_cache_initialize(
-		     descriptor_data_cache,
-		     LIBPFF_MAXIMUM_CACHE_ENTRIES_DATA_BLOCK,
-		     error ) != 1 )
+		else
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create descriptor data cache.",
-			 function );
-
-			data_block = NULL;
-
-			goto on_error;
+			result = libpff_local_descriptor_node_read_file_io_handle(
+			          local_descriptor_node,
+			          io_handle,
+			          file_io_handle,
+			          table->descriptor_identifier,
+			          table->local_descriptors_identifier,
+			          index_values[ 1 ].file_offset,
+			          index_values[ 1 ].data_size,
+			          error );
 		}
-		/* The data block is managed by the list and should not be managed by the cache as well
+		/* A local descriptor node that cannot be read is left to the local descriptors to report
 		 */
-		if( libfdata_list_set_element_value_by_index(
-		     *descriptor_data_list,
-		     (intptr_t *) file_io_handle,
-		     (libfdata_cache_t *) *descriptor_data_cache,
-		     0,
-		     (intptr_t *) data_block,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libpff_data_block_free,
-		     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_NON_MANAGED,
-		     error ) != 1 )
+		if( result != 1 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set data list element: 0.",
-			 function );
+			libcerror_error_free(
+			 error );
+		}
+		else
+		{
+			result = libpff_local_descriptors_cache_local_descriptor_node(
+			          local_descriptors,
+			          table->local_descriptors_identifier,
+			          &local_descriptor_node,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to cache local descriptor node.",
+				 function );
 
-			data_block = NULL;
+				goto on_error;
+			}
+		}
+		if( local_descriptor_node != NULL )
+		{
+			if( libpff_local_descriptor_node_free(
+			     &local_descriptor_node,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free local descriptor node.",
+				 function );
 
-			goto on_error;
+				goto on_error;
+			}
 		}
 	}
-	return( 1 );
+	if( read_buffer != NULL )
+	{
+		memory_free(
+		 read_buffer );
 
-on_error:
-	if( *descriptor_data_cache != NULL )
+		read_buffer = NULL;
+	}
+	if( libpff_local_descriptors_free(
+	     &local_descriptors,
+	     error ) != 1 )
 	{
-		libfcache_cache_free(
-		 descriptor_data_cache,
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free local descriptors.",
+		 function );
+
+		goto on_error;
 	}
-	if( *descriptor_data_list != NULL )
+	if( libpff_table_read_descriptor_data_list_from_data_block(
+	     table,
+	     io_handle,
+	     file_io_handle,
+	     offsets_index,
+	     table->descriptor_identifier,
+	     table->data_identifier,
+	     0,
+	     &( index_values[ 0 ] ),
+	     &data_block,
+	     &( table->descriptor_data_list ),
+	     &( table->descriptor_data_cache ),
+	     error ) != 1 )
 	{
-		libfdata_list_free(
-		 descriptor_data_list,
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read descriptor: %" PRIu32 " data: %" PRIu64 " list.",
+		 function,
+		 table->descriptor_identifier,
+		 table->data_identifier );
+
+		goto on_error;
 	}
-	if( data_array != NULL )
+	return( 1 );
+
+on_error:
+	if( local_descriptor_node != NULL )
 	{
-		libpff_data_array_free(
-		 &data_array,
+		libpff_local_descriptor_node_free(
+		 &local_descriptor_node,
 		 NULL );
 	}
 	if( data_block != NULL )
@@ -2872,6 +3635,17 @@ on_error:
 		 &data_block,
 		 NULL );
 	}
+	if( read_buffer != NULL )
+	{
+		memory_free(
+		 read_buffer );
+	}
+	if( local_descriptors != NULL )
+	{
+		libpff_local_descriptors_free(
+		 &local_descriptors,
+		 NULL );
+	}
 	return( -1 );
 }
 
@@ -9607,9 +10381,29 @@ int libpff_table_read_entry_value(
 		}
 	}
 /* TODO is this check necessary do entry values get read more than once ? */
-	if( record_entry->value_data == NULL )
+	if( ( record_entry->value_data == NULL )
+	 && ( record_entry->value_data_list == NULL ) )
 	{
-		if( value_data_list != NULL )
+		/* Attachment data can be large, hence it is read on demand
+		 */
+		if( ( value_data_list != NULL )
+		 && ( record_entry_type == LIBPFF_ENTRY_TYPE_ATTACHMENT_DATA_OBJECT )
+		 && ( record_entry_value_type == LIBPFF_VALUE_TYPE_BINARY_DATA ) )
+		{
+			result = libpff_record_entry_set_value_data_list(
+			          (libpff_record_entry_t *) record_entry,
+			          file_io_handle,
+			          value_data_list,
+			          value_data_cache,
+			          error );
+
+			if( result == 1 )
+			{
+				value_data_list  = NULL;
+				value_data_cache = NULL;
+			}
+		}
+		else if( value_data_list != NULL )
 		{
 			result = libpff_record_entry_set_value_data_from_list(
 			          (libpff_record_entry_t *) record_entry,
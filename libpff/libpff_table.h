@@ -148,6 +148,11 @@ int libpff_table_clone(
      libpff_table_t *source_table,
      libcerror_error_t **error );
 
+int libpff_table_get_value_data_size(
+     libpff_table_t *table,
+     size_t *value_data_size,
+     libcerror_error_t **error );
+
 int libpff_table_resize_record_entries(
      libpff_table_t *table,
      int number_of_sets,
@@ -292,6 +297,27 @@ int libpff_table_read_descriptor_data_list(
      libfcache_cache_t **descriptor_data_cache,
      libcerror_error_t **error );
 
+int libpff_table_read_descriptor_data_list_from_data_block(
+     libpff_table_t *table,
+     libpff_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libpff_offsets_index_t *offsets_index,
+     uint32_t descriptor_identifier,
+     uint64_t data_identifier,
+     uint8_t recovered,
+     libpff_index_value_t *offset_index_value,
+     libpff_data_block_t **data_block,
+     libfdata_list_t **descriptor_data_list,
+     libfcache_cache_t **descriptor_data_cache,
+     libcerror_error_t **error );
+
+int libpff_table_read_first_data_blocks(
+     libpff_table_t *table,
+     libpff_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libpff_offsets_index_t *offsets_index,
+     libcerror_error_t **error );
+
 int libpff_table_read_index_entries(
      libpff_table_t *table,
      libpff_data_block_t *data_block,
@@ -0,0 +1,811 @@
+/*
+ * Table cache functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libpff_libcerror.h"
+#include "libpff_libcthreads.h"
+#include "libpff_table_cache.h"
+
+/* Creates a table cache
+ * Make sure the value table_cache is referencing, is set to NULL
+ * The value clone function is used to hand out copies of the cached values
+ * so that a cached value is never modified once it is shared
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_table_cache_initialize(
+     libpff_table_cache_t **table_cache,
+     int maximum_number_of_entries,
+     size_t maximum_size,
+     int (*value_free_function)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     int (*value_clone_function)(
+            intptr_t **destination_value,
+            intptr_t *source_value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	static char *function      = "libpff_table_cache_initialize";
+	size_t entries_size        = 0;
+	int hash_bucket_index      = 0;
+	int number_of_hash_buckets = 0;
+
+	if( table_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *table_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid table cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_entries <= 0 )
+	 || ( (size_t) maximum_number_of_entries > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libpff_table_cache_entry_t ) ) )
+	 || ( maximum_number_of_entries > ( INT_MAX / 4 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_free_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value free function.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_clone_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value clone function.",
+		 function );
+
+		return( -1 );
+	}
+	*table_cache = memory_allocate_structure(
+	                libpff_table_cache_t );
+
+	if( *table_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create table cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *table_cache,
+	     0,
+	     sizeof( libpff_table_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear table cache.",
+		 function );
+
+		memory_free(
+		 *table_cache );
+
+		*table_cache = NULL;
+
+		return( -1 );
+	}
+	entries_size = sizeof( libpff_table_cache_entry_t ) * maximum_number_of_entries;
+
+	( *table_cache )->entries = (libpff_table_cache_entry_t *) memory_allocate(
+	                                                            entries_size );
+
+	if( ( *table_cache )->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *table_cache )->entries,
+	     0,
+	     entries_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		goto on_error;
+	}
+	/* Use at least twice as many hash buckets as entries to keep the chains short
+	 */
+	number_of_hash_buckets = 16;
+
+	while( ( number_of_hash_buckets / 2 ) < maximum_number_of_entries )
+	{
+		number_of_hash_buckets *= 2;
+	}
+	( *table_cache )->hash_buckets = (int *) memory_allocate(
+	                                          sizeof( int ) * number_of_hash_buckets );
+
+	if( ( *table_cache )->hash_buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create hash buckets.",
+		 function );
+
+		goto on_error;
+	}
+	for( hash_bucket_index = 0;
+	     hash_bucket_index < number_of_hash_buckets;
+	     hash_bucket_index++ )
+	{
+		( *table_cache )->hash_buckets[ hash_bucket_index ] = -1;
+	}
+	( *table_cache )->number_of_hash_buckets    = number_of_hash_buckets;
+	( *table_cache )->maximum_number_of_entries = maximum_number_of_entries;
+	( *table_cache )->maximum_size              = maximum_size;
+	( *table_cache )->value_free_function       = value_free_function;
+	( *table_cache )->value_clone_function      = value_clone_function;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *table_cache )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *table_cache != NULL )
+	{
+		if( ( *table_cache )->hash_buckets != NULL )
+		{
+			memory_free(
+			 ( *table_cache )->hash_buckets );
+		}
+		if( ( *table_cache )->entries != NULL )
+		{
+			memory_free(
+			 ( *table_cache )->entries );
+		}
+		memory_free(
+		 *table_cache );
+
+		*table_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a table cache
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_table_cache_free(
+     libpff_table_cache_t **table_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_table_cache_free";
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( table_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *table_cache != NULL )
+	{
+		for( entry_index = 0;
+		     entry_index < ( *table_cache )->number_of_entries;
+		     entry_index++ )
+		{
+			if( ( *table_cache )->value_free_function(
+			     &( ( *table_cache )->entries[ entry_index ].value ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free value: %d.",
+				 function,
+				 entry_index );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( ( *table_cache )->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 ( *table_cache )->hash_buckets );
+
+		memory_free(
+		 ( *table_cache )->entries );
+
+		memory_free(
+		 *table_cache );
+
+		*table_cache = NULL;
+	}
+	return( result );
+}
+
+/* Determines the hash bucket index of a descriptor identifier
+ * Returns the hash bucket index
+ */
+int libpff_table_cache_get_hash_bucket_index(
+     libpff_table_cache_t *table_cache,
+     uint32_t descriptor_identifier )
+{
+	uint32_t hash_value = 0;
+
+	/* The lower 5 bits of the descriptor identifier contain the node type
+	 * hence a multiplicative hash is used to spread the identifiers
+	 */
+	hash_value = descriptor_identifier * (uint32_t) 0x9e3779b1UL;
+	hash_value = hash_value ^ ( hash_value >> 16 );
+
+	return( (int) ( hash_value & (uint32_t) ( table_cache->number_of_hash_buckets - 1 ) ) );
+}
+
+/* Replaces the reference to an entry index in its hash bucket chain
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_table_cache_replace_entry_index(
+     libpff_table_cache_t *table_cache,
+     int entry_index,
+     int replacement_entry_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_table_cache_replace_entry_index";
+	int chain_entry_index = 0;
+	int hash_bucket_index = 0;
+
+	if( table_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_index < 0 )
+	 || ( entry_index >= table_cache->number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	hash_bucket_index = libpff_table_cache_get_hash_bucket_index(
+	                     table_cache,
+	                     table_cache->entries[ entry_index ].descriptor_identifier );
+
+	if( table_cache->hash_buckets[ hash_bucket_index ] == entry_index )
+	{
+		table_cache->hash_buckets[ hash_bucket_index ] = replacement_entry_index;
+
+		return( 1 );
+	}
+	chain_entry_index = table_cache->hash_buckets[ hash_bucket_index ];
+
+	while( chain_entry_index != -1 )
+	{
+		if( table_cache->entries[ chain_entry_index ].next_entry_index == entry_index )
+		{
+			table_cache->entries[ chain_entry_index ].next_entry_index = replacement_entry_index;
+
+			return( 1 );
+		}
+		chain_entry_index = table_cache->entries[ chain_entry_index ].next_entry_index;
+	}
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+	 "%s: missing entry: %d in hash bucket: %d.",
+	 function,
+	 entry_index,
+	 hash_bucket_index );
+
+	return( -1 );
+}
+
+/* Removes an entry from the table cache
+ * The last entry is moved into the slot of the removed entry
+ * The caller is expected to hold the read/write lock for writing
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_table_cache_remove_entry(
+     libpff_table_cache_t *table_cache,
+     int entry_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_table_cache_remove_entry";
+	int last_entry_index  = 0;
+	int result            = 1;
+
+	if( table_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_index < 0 )
+	 || ( entry_index >= table_cache->number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Unlink the entry from its hash bucket chain
+	 */
+	if( libpff_table_cache_replace_entry_index(
+	     table_cache,
+	     entry_index,
+	     table_cache->entries[ entry_index ].next_entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to unlink entry: %d.",
+		 function,
+		 entry_index );
+
+		return( -1 );
+	}
+	table_cache->size -= table_cache->entries[ entry_index ].value_size;
+
+	if( table_cache->value_free_function(
+	     &( table_cache->entries[ entry_index ].value ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free value: %d.",
+		 function,
+		 entry_index );
+
+		result = -1;
+	}
+	last_entry_index = table_cache->number_of_entries - 1;
+
+	if( entry_index != last_entry_index )
+	{
+		table_cache->entries[ entry_index ] = table_cache->entries[ last_entry_index ];
+
+		if( libpff_table_cache_replace_entry_index(
+		     table_cache,
+		     last_entry_index,
+		     entry_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to relink entry: %d.",
+			 function,
+			 last_entry_index );
+
+			result = -1;
+		}
+	}
+	table_cache->entries[ last_entry_index ].value            = NULL;
+	table_cache->entries[ last_entry_index ].value_size       = 0;
+	table_cache->entries[ last_entry_index ].next_entry_index = -1;
+
+	table_cache->number_of_entries -= 1;
+
+	return( result );
+}
+
+/* Retrieves a copy of a value from the table cache
+ * The copy is owned by the caller, the cached value itself is never handed out
+ * Returns 1 if successful, 0 if no such value or -1 on error
+ */
+int libpff_table_cache_get_value(
+     libpff_table_cache_t *table_cache,
+     uint32_t descriptor_identifier,
+     uint64_t data_identifier,
+     uint64_t local_descriptors_identifier,
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	libpff_table_cache_entry_t *entry = NULL;
+	static char *function             = "libpff_table_cache_get_value";
+	int entry_index                   = 0;
+	int hash_bucket_index             = 0;
+	int result                        = 0;
+
+	if( table_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	hash_bucket_index = libpff_table_cache_get_hash_bucket_index(
+	                     table_cache,
+	                     descriptor_identifier );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The access timestamp is updated on retrieval hence the lock is grabbed for writing
+	 */
+	if( libcthreads_read_write_lock_grab_for_write(
+	     table_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	entry_index = table_cache->hash_buckets[ hash_bucket_index ];
+
+	while( entry_index != -1 )
+	{
+		entry = &( table_cache->entries[ entry_index ] );
+
+		if( ( entry->descriptor_identifier == descriptor_identifier )
+		 && ( entry->data_identifier == data_identifier )
+		 && ( entry->local_descriptors_identifier == local_descriptors_identifier ) )
+		{
+			if( table_cache->value_clone_function(
+			     value,
+			     entry->value,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to clone value: %d.",
+				 function,
+				 entry_index );
+
+				goto on_error;
+			}
+			table_cache->current_timestamp += 1;
+
+			entry->timestamp = table_cache->current_timestamp;
+
+			result = 1;
+
+			break;
+		}
+		entry_index = entry->next_entry_index;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     table_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		if( *value != NULL )
+		{
+			table_cache->value_free_function(
+			 value,
+			 NULL );
+		}
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 table_cache->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Sets a value in the table cache
+ * The table cache takes over management of the value if successful
+ * The least recently used entries are removed until the value fits the cache
+ * Returns 1 if successful, 0 if the value is too large to be cached or -1 on error
+ */
+int libpff_table_cache_set_value(
+     libpff_table_cache_t *table_cache,
+     uint32_t descriptor_identifier,
+     uint64_t data_identifier,
+     uint64_t local_descriptors_identifier,
+     intptr_t *value,
+     size_t value_size,
+     libcerror_error_t **error )
+{
+	libpff_table_cache_entry_t *entry = NULL;
+	static char *function             = "libpff_table_cache_set_value";
+	int64_t oldest_timestamp          = 0;
+	int entry_index                   = 0;
+	int hash_bucket_index             = 0;
+	int oldest_entry_index            = 0;
+
+	if( table_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_size > table_cache->maximum_size )
+	{
+		return( 0 );
+	}
+	hash_bucket_index = libpff_table_cache_get_hash_bucket_index(
+	                     table_cache,
+	                     descriptor_identifier );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     table_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* Another reader could have cached the same table in the meantime
+	 */
+	entry_index = table_cache->hash_buckets[ hash_bucket_index ];
+
+	while( entry_index != -1 )
+	{
+		entry = &( table_cache->entries[ entry_index ] );
+
+		if( ( entry->descriptor_identifier == descriptor_identifier )
+		 && ( entry->data_identifier == data_identifier )
+		 && ( entry->local_descriptors_identifier == local_descriptors_identifier ) )
+		{
+			break;
+		}
+		entry_index = entry->next_entry_index;
+	}
+	if( entry_index != -1 )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_write(
+		     table_cache->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for writing.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		return( 0 );
+	}
+	while( ( table_cache->number_of_entries >= table_cache->maximum_number_of_entries )
+	    || ( ( table_cache->maximum_size - table_cache->size ) < value_size ) )
+	{
+		oldest_entry_index = 0;
+		oldest_timestamp   = table_cache->entries[ 0 ].timestamp;
+
+		for( entry_index = 1;
+		     entry_index < table_cache->number_of_entries;
+		     entry_index++ )
+		{
+			if( table_cache->entries[ entry_index ].timestamp < oldest_timestamp )
+			{
+				oldest_entry_index = entry_index;
+				oldest_timestamp   = table_cache->entries[ entry_index ].timestamp;
+			}
+		}
+		if( libpff_table_cache_remove_entry(
+		     table_cache,
+		     oldest_entry_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove entry: %d.",
+			 function,
+			 oldest_entry_index );
+
+			goto on_error;
+		}
+	}
+	table_cache->current_timestamp += 1;
+
+	entry = &( table_cache->entries[ table_cache->number_of_entries ] );
+
+	entry->descriptor_identifier        = descriptor_identifier;
+	entry->data_identifier              = data_identifier;
+	entry->local_descriptors_identifier = local_descriptors_identifier;
+	entry->value                        = value;
+	entry->value_size                   = value_size;
+	entry->timestamp                    = table_cache->current_timestamp;
+	entry->next_entry_index             = table_cache->hash_buckets[ hash_bucket_index ];
+
+	table_cache->hash_buckets[ hash_bucket_index ] = table_cache->number_of_entries;
+
+	table_cache->number_of_entries += 1;
+	table_cache->size              += value_size;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     table_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 table_cache->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
@@ -0,0 +1,179 @@
+/*
+ * Table cache functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPFF_TABLE_CACHE_H )
+#define _LIBPFF_TABLE_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libpff_libcerror.h"
+#include "libpff_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libpff_table_cache_entry libpff_table_cache_entry_t;
+
+struct libpff_table_cache_entry
+{
+	/* The descriptor identifier
+	 */
+	uint32_t descriptor_identifier;
+
+	/* The data identifier
+	 */
+	uint64_t data_identifier;
+
+	/* The local descriptors identifier
+	 */
+	uint64_t local_descriptors_identifier;
+
+	/* The (table) value
+	 */
+	intptr_t *value;
+
+	/* The (table) value size
+	 */
+	size_t value_size;
+
+	/* The access timestamp
+	 */
+	int64_t timestamp;
+
+	/* The index of the next entry in the same hash bucket or -1 if not set
+	 */
+	int next_entry_index;
+};
+
+typedef struct libpff_table_cache libpff_table_cache_t;
+
+struct libpff_table_cache
+{
+	/* The entries
+	 */
+	libpff_table_cache_entry_t *entries;
+
+	/* The maximum number of entries
+	 */
+	int maximum_number_of_entries;
+
+	/* The hash buckets, which contain the index of the first entry
+	 * in the bucket or -1 if the bucket is empty
+	 */
+	int *hash_buckets;
+
+	/* The number of hash buckets, which is a power of 2
+	 */
+	int number_of_hash_buckets;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The maximum size
+	 */
+	size_t maximum_size;
+
+	/* The size
+	 */
+	size_t size;
+
+	/* The current timestamp
+	 */
+	int64_t current_timestamp;
+
+	/* The value free function
+	 */
+	int (*value_free_function)(
+	       intptr_t **value,
+	       libcerror_error_t **error );
+
+	/* The value clone function
+	 */
+	int (*value_clone_function)(
+	       intptr_t **destination_value,
+	       intptr_t *source_value,
+	       libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+int libpff_table_cache_initialize(
+     libpff_table_cache_t **table_cache,
+     int maximum_number_of_entries,
+     size_t maximum_size,
+     int (*value_free_function)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     int (*value_clone_function)(
+            intptr_t **destination_value,
+            intptr_t *source_value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+int libpff_table_cache_free(
+     libpff_table_cache_t **table_cache,
+     libcerror_error_t **error );
+
+int libpff_table_cache_get_hash_bucket_index(
+     libpff_table_cache_t *table_cache,
+     uint32_t descriptor_identifier );
+
+int libpff_table_cache_replace_entry_index(
+     libpff_table_cache_t *table_cache,
+     int entry_index,
+     int replacement_entry_index,
+     libcerror_error_t **error );
+
+int libpff_table_cache_remove_entry(
+     libpff_table_cache_t *table_cache,
+     int entry_index,
+     libcerror_error_t **error );
+
+int libpff_table_cache_get_value(
+     libpff_table_cache_t *table_cache,
+     uint32_t descriptor_identifier,
+     uint64_t data_identifier,
+     uint64_t local_descriptors_identifier,
+     intptr_t **value,
+     libcerror_error_t **error );
+
+int libpff_table_cache_set_value(
+     libpff_table_cache_t *table_cache,
+     uint32_t descriptor_identifier,
+     uint64_t data_identifier,
+     uint64_t local_descriptors_identifier,
+     intptr_t *value,
+     size_t value_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPFF_TABLE_CACHE_H ) */
+
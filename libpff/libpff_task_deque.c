@@ -0,0 +1,593 @@
+/*
+ * Task deque functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libpff_definitions.h"
+#include "libpff_libcdata.h"
+#include "libpff_libcerror.h"
+#include "libpff_libcthreads.h"
+#include "libpff_task_deque.h"
+
+/* Creates a task deque
+ * Make sure the value task_deque is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_task_deque_initialize(
+     libpff_task_deque_t **task_deque,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_task_deque_initialize";
+	size_t tasks_size     = 0;
+
+	if( task_deque == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid task deque.",
+		 function );
+
+		return( -1 );
+	}
+	if( *task_deque != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid task deque value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*task_deque = memory_allocate_structure(
+	               libpff_task_deque_t );
+
+	if( *task_deque == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create task deque.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *task_deque,
+	     0,
+	     sizeof( libpff_task_deque_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear task deque.",
+		 function );
+
+		memory_free(
+		 *task_deque );
+
+		*task_deque = NULL;
+
+		return( -1 );
+	}
+	tasks_size = sizeof( libpff_task_deque_task_t ) * LIBPFF_TASK_DEQUE_INITIAL_NUMBER_OF_TASKS;
+
+	( *task_deque )->tasks = (libpff_task_deque_task_t *) memory_allocate(
+	                                                       tasks_size );
+
+	if( ( *task_deque )->tasks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create tasks.",
+		 function );
+
+		goto on_error;
+	}
+	( *task_deque )->maximum_number_of_tasks = LIBPFF_TASK_DEQUE_INITIAL_NUMBER_OF_TASKS;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *task_deque )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *task_deque != NULL )
+	{
+		if( ( *task_deque )->tasks != NULL )
+		{
+			memory_free(
+			 ( *task_deque )->tasks );
+		}
+		memory_free(
+		 *task_deque );
+
+		*task_deque = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a task deque
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_task_deque_free(
+     libpff_task_deque_t **task_deque,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_task_deque_free";
+	int result            = 1;
+
+	if( task_deque == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid task deque.",
+		 function );
+
+		return( -1 );
+	}
+	if( *task_deque != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *task_deque )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *task_deque )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		if( ( *task_deque )->tasks != NULL )
+		{
+			memory_free(
+			 ( *task_deque )->tasks );
+		}
+		memory_free(
+		 *task_deque );
+
+		*task_deque = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the number of tasks
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_task_deque_get_number_of_tasks(
+     libpff_task_deque_t *task_deque,
+     int *number_of_tasks,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_task_deque_get_number_of_tasks";
+
+	if( task_deque == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid task deque.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_tasks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of tasks.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     task_deque->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_tasks = task_deque->number_of_tasks;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     task_deque->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Pushes a task onto the bottom of the task deque
+ * The tasks are reallocated when the task deque is full
+ * Returns 1 if successful or -1 on error
+ */
+int libpff_task_deque_push_bottom(
+     libpff_task_deque_t *task_deque,
+     libcdata_tree_node_t *item_tree_node,
+     libcdata_tree_node_t *first_sub_node,
+     int first_sub_node_index,
+     int number_of_sub_nodes,
+     libcerror_error_t **error )
+{
+	libpff_task_deque_task_t *tasks = NULL;
+	libpff_task_deque_task_t *task  = NULL;
+	static char *function           = "libpff_task_deque_push_bottom";
+	size_t tasks_size               = 0;
+	int maximum_number_of_tasks     = 0;
+	int task_index                  = 0;
+
+	if( task_deque == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid task deque.",
+		 function );
+
+		return( -1 );
+	}
+	if( item_tree_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item tree node.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_sub_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid first sub node.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_sub_node_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid first sub node index value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_sub_nodes <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of sub nodes value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     task_deque->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( task_deque->number_of_tasks >= task_deque->maximum_number_of_tasks )
+	{
+		if( task_deque->maximum_number_of_tasks > (int) ( ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libpff_task_deque_task_t ) ) / 2 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid task deque - maximum number of tasks value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		maximum_number_of_tasks = task_deque->maximum_number_of_tasks * 2;
+
+		tasks_size = sizeof( libpff_task_deque_task_t ) * maximum_number_of_tasks;
+
+		tasks = (libpff_task_deque_task_t *) memory_allocate(
+		                                      tasks_size );
+
+		if( tasks == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create tasks.",
+			 function );
+
+			goto on_error;
+		}
+		/* Copy the tasks in order so that the top task is at index 0
+		 */
+		for( task_index = 0;
+		     task_index < task_deque->number_of_tasks;
+		     task_index++ )
+		{
+			tasks[ task_index ] = task_deque->tasks[ ( task_deque->top_task_index + task_index ) % task_deque->maximum_number_of_tasks ];
+		}
+		memory_free(
+		 task_deque->tasks );
+
+		task_deque->tasks                   = tasks;
+		task_deque->maximum_number_of_tasks = maximum_number_of_tasks;
+		task_deque->top_task_index          = 0;
+	}
+	task_index = ( task_deque->top_task_index + task_deque->number_of_tasks ) % task_deque->maximum_number_of_tasks;
+
+	task = &( task_deque->tasks[ task_index ] );
+
+	task->item_tree_node       = item_tree_node;
+	task->first_sub_node       = first_sub_node;
+	task->first_sub_node_index = first_sub_node_index;
+	task->number_of_sub_nodes  = number_of_sub_nodes;
+
+	task_deque->number_of_tasks += 1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     task_deque->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 task_deque->mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Pops the most recently pushed task from the bottom of the task deque
+ * Returns 1 if successful, 0 if the task deque is empty or -1 on error
+ */
+int libpff_task_deque_pop_bottom(
+     libpff_task_deque_t *task_deque,
+     libpff_task_deque_task_t *task,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_task_deque_pop_bottom";
+	int result            = 0;
+	int task_index        = 0;
+
+	if( task_deque == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid task deque.",
+		 function );
+
+		return( -1 );
+	}
+	if( task == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid task.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     task_deque->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( task_deque->number_of_tasks > 0 )
+	{
+		task_deque->number_of_tasks -= 1;
+
+		task_index = ( task_deque->top_task_index + task_deque->number_of_tasks ) % task_deque->maximum_number_of_tasks;
+
+		*task = task_deque->tasks[ task_index ];
+
+		result = 1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     task_deque->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Steals the least recently pushed task from the top of the task deque
+ * Returns 1 if successful, 0 if the task deque is empty or -1 on error
+ */
+int libpff_task_deque_steal_top(
+     libpff_task_deque_t *task_deque,
+     libpff_task_deque_task_t *task,
+     libcerror_error_t **error )
+{
+	static char *function = "libpff_task_deque_steal_top";
+	int result            = 0;
+
+	if( task_deque == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid task deque.",
+		 function );
+
+		return( -1 );
+	}
+	if( task == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid task.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     task_deque->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( task_deque->number_of_tasks > 0 )
+	{
+		*task = task_deque->tasks[ task_deque->top_task_index ];
+
+		task_deque->top_task_index   = ( task_deque->top_task_index + 1 ) % task_deque->maximum_number_of_tasks;
+		task_deque->number_of_tasks -= 1;
+
+		result = 1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     task_deque->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
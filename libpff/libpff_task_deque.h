@@ -0,0 +1,125 @@
+/*
+ * Task deque functions
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBPFF_TASK_DEQUE_H )
+#define _LIBPFF_TASK_DEQUE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libpff_libcdata.h"
+#include "libpff_libcerror.h"
+#include "libpff_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libpff_task_deque_task libpff_task_deque_task_t;
+
+/* A task is a range of sub nodes of an item tree node
+ */
+struct libpff_task_deque_task
+{
+	/* The item tree node
+	 */
+	libcdata_tree_node_t *item_tree_node;
+
+	/* The first sub node, stored so that the sub nodes do not need to be looked up by index
+	 */
+	libcdata_tree_node_t *first_sub_node;
+
+	/* The index of the first sub node
+	 */
+	int first_sub_node_index;
+
+	/* The number of sub nodes
+	 */
+	int number_of_sub_nodes;
+};
+
+typedef struct libpff_task_deque libpff_task_deque_t;
+
+/* The task deque is a circular buffer of tasks. The owner pushes and pops
+ * tasks at the bottom, other workers steal the oldest tasks from the top
+ */
+struct libpff_task_deque
+{
+	/* The tasks
+	 */
+	libpff_task_deque_task_t *tasks;
+
+	/* The maximum number of tasks
+	 */
+	int maximum_number_of_tasks;
+
+	/* The index of the top task
+	 */
+	int top_task_index;
+
+	/* The number of tasks
+	 */
+	int number_of_tasks;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libpff_task_deque_initialize(
+     libpff_task_deque_t **task_deque,
+     libcerror_error_t **error );
+
+int libpff_task_deque_free(
+     libpff_task_deque_t **task_deque,
+     libcerror_error_t **error );
+
+int libpff_task_deque_get_number_of_tasks(
+     libpff_task_deque_t *task_deque,
+     int *number_of_tasks,
+     libcerror_error_t **error );
+
+int libpff_task_deque_push_bottom(
+     libpff_task_deque_t *task_deque,
+     libcdata_tree_node_t *item_tree_node,
+     libcdata_tree_node_t *first_sub_node,
+     int first_sub_node_index,
+     int number_of_sub_nodes,
+     libcerror_error_t **error );
+
+int libpff_task_deque_pop_bottom(
+     libpff_task_deque_t *task_deque,
+     libpff_task_deque_task_t *task,
+     libcerror_error_t **error );
+
+int libpff_task_deque_steal_top(
+     libpff_task_deque_t *task_deque,
+     libpff_task_deque_task_t *task,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBPFF_TASK_DEQUE_H ) */
+
@@ -34,18 +34,22 @@
 /* The following type definitions hide internal data structures
  */
 #if defined( HAVE_DEBUG_OUTPUT ) && !defined( WINAPI )
+typedef struct libpff_allocation_statistics {}	libpff_allocation_statistics_t;
 typedef struct libpff_file {}			libpff_file_t;
 typedef struct libpff_item {}			libpff_item_t;
 typedef struct libpff_multi_value {}		libpff_multi_value_t;
 typedef struct libpff_name_to_id_map_entry {}	libpff_name_to_id_map_entry_t;
+typedef struct libpff_property_set {}		libpff_property_set_t;
 typedef struct libpff_record_entry {}		libpff_record_entry_t;
 typedef struct libpff_record_set {}		libpff_record_set_t;
 
 #else
+typedef intptr_t libpff_allocation_statistics_t;
 typedef intptr_t libpff_file_t;
 typedef intptr_t libpff_item_t;
 typedef intptr_t libpff_multi_value_t;
 typedef intptr_t libpff_name_to_id_map_entry_t;
+typedef intptr_t libpff_property_set_t;
 typedef intptr_t libpff_record_entry_t;
 typedef intptr_t libpff_record_set_t;
 
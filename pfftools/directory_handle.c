@@ -0,0 +1,1070 @@
+/*
+ * Directory handle
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "directory_handle.h"
+#include "pfftools_libcerror.h"
+#include "pfftools_libcfile.h"
+#include "pfftools_libcpath.h"
+
+/* Creates a directory handle
+ * Make sure the value directory_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int directory_handle_initialize(
+     directory_handle_t **directory_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "directory_handle_initialize";
+
+	if( directory_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *directory_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid directory handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*directory_handle = memory_allocate_structure(
+	                     directory_handle_t );
+
+	if( *directory_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create directory handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *directory_handle,
+	     0,
+	     sizeof( directory_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear directory handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( DIRECTORY_HANDLE_HAVE_DESCRIPTOR )
+	( *directory_handle )->descriptor = -1;
+#endif
+
+	return( 1 );
+
+on_error:
+	if( *directory_handle != NULL )
+	{
+		memory_free(
+		 *directory_handle );
+
+		*directory_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a directory handle
+ * Returns 1 if successful or -1 on error
+ */
+int directory_handle_free(
+     directory_handle_t **directory_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "directory_handle_free";
+	int name_index        = 0;
+	int result            = 1;
+
+	if( directory_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *directory_handle != NULL )
+	{
+#if defined( DIRECTORY_HANDLE_HAVE_DESCRIPTOR )
+		if( ( *directory_handle )->descriptor != -1 )
+		{
+			if( close(
+			     ( *directory_handle )->descriptor ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close directory descriptor.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		if( ( *directory_handle )->names != NULL )
+		{
+			for( name_index = 0;
+			     name_index < ( *directory_handle )->number_of_names;
+			     name_index++ )
+			{
+				memory_free(
+				 ( *directory_handle )->names[ name_index ] );
+			}
+			memory_free(
+			 ( *directory_handle )->names );
+		}
+		if( ( *directory_handle )->path != NULL )
+		{
+			memory_free(
+			 ( *directory_handle )->path );
+		}
+		memory_free(
+		 *directory_handle );
+
+		*directory_handle = NULL;
+	}
+	return( result );
+}
+
+/* Opens a directory handle
+ * Returns 1 if successful or -1 on error
+ */
+int directory_handle_open(
+     directory_handle_t *directory_handle,
+     const system_character_t *path,
+     size_t path_length,
+     libcerror_error_t **error )
+{
+	static char *function = "directory_handle_open";
+
+	if( directory_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_handle->path != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid directory handle - path value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( path_length == 0 )
+	 || ( path_length > (size_t) ( ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( system_character_t ) ) - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid path length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	directory_handle->path = system_string_allocate(
+	                          path_length + 1 );
+
+	if( directory_handle->path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create path.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     directory_handle->path,
+	     path,
+	     path_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy path.",
+		 function );
+
+		goto on_error;
+	}
+	directory_handle->path[ path_length ] = 0;
+
+	directory_handle->path_size = path_length + 1;
+
+#if defined( DIRECTORY_HANDLE_HAVE_DESCRIPTOR )
+	directory_handle->descriptor = open(
+	                                directory_handle->path,
+	                                O_RDONLY | O_DIRECTORY );
+
+	if( directory_handle->descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open directory: %" PRIs_SYSTEM ".",
+		 function,
+		 directory_handle->path );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( directory_handle->path != NULL )
+	{
+		memory_free(
+		 directory_handle->path );
+
+		directory_handle->path = NULL;
+	}
+	directory_handle->path_size = 0;
+
+	return( -1 );
+}
+
+/* Opens a directory handle of a sub directory relative to its parent
+ * Returns 1 if successful or -1 on error
+ */
+int directory_handle_open_sub_directory(
+     directory_handle_t *directory_handle,
+     directory_handle_t *parent_directory_handle,
+     const system_character_t *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	static char *function = "directory_handle_open_sub_directory";
+	int result            = 0;
+
+	if( directory_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_handle->path != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid directory handle - path value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( parent_directory_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parent directory handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( parent_directory_handle->path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid parent directory handle - missing path.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name == NULL )
+	 || ( name_length == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libcpath_path_join_wide(
+	          &( directory_handle->path ),
+	          &( directory_handle->path_size ),
+	          parent_directory_handle->path,
+	          parent_directory_handle->path_size - 1,
+	          name,
+	          name_length,
+	          error );
+#else
+	result = libcpath_path_join(
+	          &( directory_handle->path ),
+	          &( directory_handle->path_size ),
+	          parent_directory_handle->path,
+	          parent_directory_handle->path_size - 1,
+	          name,
+	          name_length,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create path.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( DIRECTORY_HANDLE_HAVE_DESCRIPTOR )
+	/* The joined path ends with a terminated copy of the name
+	 */
+	directory_handle->descriptor = openat(
+	                                parent_directory_handle->descriptor,
+	                                &( directory_handle->path[ directory_handle->path_size - ( name_length + 1 ) ] ),
+	                                O_RDONLY | O_DIRECTORY );
+
+	if( directory_handle->descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open directory: %" PRIs_SYSTEM ".",
+		 function,
+		 directory_handle->path );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( directory_handle->path != NULL )
+	{
+		memory_free(
+		 directory_handle->path );
+
+		directory_handle->path = NULL;
+	}
+	directory_handle->path_size = 0;
+
+	return( -1 );
+}
+
+/* Retrieves the index of a name in the sorted names of the created entries
+ * If the name was not found name_index is set to the index it should be inserted at
+ * Returns 1 if successful, 0 if not found or -1 on error
+ */
+int directory_handle_get_name_index(
+     directory_handle_t *directory_handle,
+     const system_character_t *name,
+     size_t name_length,
+     int *name_index,
+     libcerror_error_t **error )
+{
+	system_character_t *entry_name = NULL;
+	static char *function          = "directory_handle_get_name_index";
+	size_t entry_name_length       = 0;
+	int compare_result             = 0;
+	int lower_index                = 0;
+	int middle_index               = 0;
+	int upper_index                = 0;
+
+	if( directory_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name index.",
+		 function );
+
+		return( -1 );
+	}
+	upper_index = directory_handle->number_of_names;
+
+	while( lower_index < upper_index )
+	{
+		middle_index = lower_index + ( ( upper_index - lower_index ) / 2 );
+
+		entry_name        = directory_handle->names[ middle_index ];
+		entry_name_length = system_string_length(
+		                     entry_name );
+
+		if( entry_name_length < name_length )
+		{
+			compare_result = system_string_compare(
+			                  entry_name,
+			                  name,
+			                  entry_name_length );
+
+			if( compare_result == 0 )
+			{
+				compare_result = -1;
+			}
+		}
+		else
+		{
+			compare_result = system_string_compare(
+			                  entry_name,
+			                  name,
+			                  name_length );
+
+			if( ( compare_result == 0 )
+			 && ( entry_name_length > name_length ) )
+			{
+				compare_result = 1;
+			}
+		}
+		if( compare_result == 0 )
+		{
+			*name_index = middle_index;
+
+			return( 1 );
+		}
+		else if( compare_result < 0 )
+		{
+			lower_index = middle_index + 1;
+		}
+		else
+		{
+			upper_index = middle_index;
+		}
+	}
+	*name_index = lower_index;
+
+	return( 0 );
+}
+
+/* Appends a name to the sorted names of the created entries
+ * entry_name is set to the terminated copy of the name stored in the directory handle
+ * Returns 1 if successful, 0 if the name was already present or -1 on error
+ */
+int directory_handle_append_name(
+     directory_handle_t *directory_handle,
+     const system_character_t *name,
+     size_t name_length,
+     system_character_t **entry_name,
+     libcerror_error_t **error )
+{
+	system_character_t **names       = NULL;
+	system_character_t *name_copy    = NULL;
+	static char *function            = "directory_handle_append_name";
+	int number_of_allocated_names    = 0;
+	int name_index                   = 0;
+	int names_index                  = 0;
+	int result                       = 0;
+
+	if( directory_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name_length == 0 )
+	 || ( name_length > (size_t) ( ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( system_character_t ) ) - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid name length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry name.",
+		 function );
+
+		return( -1 );
+	}
+	result = directory_handle_get_name_index(
+	          directory_handle,
+	          name,
+	          name_length,
+	          &name_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve name index.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		*entry_name = directory_handle->names[ name_index ];
+
+		return( 0 );
+	}
+	if( directory_handle->number_of_names >= directory_handle->number_of_allocated_names )
+	{
+		if( directory_handle->number_of_allocated_names >= ( INT_MAX / 2 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid directory handle - number of allocated names value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		number_of_allocated_names = directory_handle->number_of_allocated_names * 2;
+
+		if( number_of_allocated_names == 0 )
+		{
+			number_of_allocated_names = 16;
+		}
+		names = (system_character_t **) memory_reallocate(
+		                                 directory_handle->names,
+		                                 sizeof( system_character_t * ) * number_of_allocated_names );
+
+		if( names == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize names.",
+			 function );
+
+			return( -1 );
+		}
+		directory_handle->names                     = names;
+		directory_handle->number_of_allocated_names = number_of_allocated_names;
+	}
+	name_copy = system_string_allocate(
+	             name_length + 1 );
+
+	if( name_copy == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create name.",
+		 function );
+
+		return( -1 );
+	}
+	if( system_string_copy(
+	     name_copy,
+	     name,
+	     name_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy name.",
+		 function );
+
+		memory_free(
+		 name_copy );
+
+		return( -1 );
+	}
+	name_copy[ name_length ] = 0;
+
+	for( names_index = directory_handle->number_of_names;
+	     names_index > name_index;
+	     names_index-- )
+	{
+		directory_handle->names[ names_index ] = directory_handle->names[ names_index - 1 ];
+	}
+	directory_handle->names[ name_index ] = name_copy;
+
+	directory_handle->number_of_names += 1;
+
+	*entry_name = name_copy;
+
+	return( 1 );
+}
+
+/* Makes a directory in the directory
+ * Returns 1 if successful, 0 if the entry already exists or -1 on error
+ */
+int directory_handle_make_directory(
+     directory_handle_t *directory_handle,
+     const system_character_t *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	system_character_t *entry_name = NULL;
+	static char *function          = "directory_handle_make_directory";
+	int result                     = 0;
+
+#if !defined( DIRECTORY_HANDLE_HAVE_DESCRIPTOR )
+	system_character_t *path       = NULL;
+	size_t path_size               = 0;
+#endif
+
+	result = directory_handle_append_name(
+	          directory_handle,
+	          name,
+	          name_length,
+	          &entry_name,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append name.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+#if defined( DIRECTORY_HANDLE_HAVE_DESCRIPTOR )
+	if( mkdirat(
+	     directory_handle->descriptor,
+	     entry_name,
+	     0755 ) != 0 )
+	{
+		if( errno == EEXIST )
+		{
+			return( 0 );
+		}
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to make directory: %" PRIs_SYSTEM " in: %" PRIs_SYSTEM ".",
+		 function,
+		 entry_name,
+		 directory_handle->path );
+
+		return( -1 );
+	}
+	return( 1 );
+#else
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libcpath_path_join_wide(
+	          &path,
+	          &path_size,
+	          directory_handle->path,
+	          directory_handle->path_size - 1,
+	          entry_name,
+	          name_length,
+	          error );
+#else
+	result = libcpath_path_join(
+	          &path,
+	          &path_size,
+	          directory_handle->path,
+	          directory_handle->path_size - 1,
+	          entry_name,
+	          name_length,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create path.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libcfile_file_exists_wide(
+	          path,
+	          error );
+#else
+	result = libcfile_file_exists(
+	          path,
+	          error );
+#endif
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine if %" PRIs_SYSTEM " exists.",
+		 function,
+		 path );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libcpath_path_make_directory_wide(
+		          path,
+		          error );
+#else
+		result = libcpath_path_make_directory(
+		          path,
+		          error );
+#endif
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to make directory: %" PRIs_SYSTEM ".",
+			 function,
+			 path );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		result = 0;
+	}
+	memory_free(
+	 path );
+
+	return( result );
+
+on_error:
+	if( path != NULL )
+	{
+		memory_free(
+		 path );
+	}
+	return( -1 );
+#endif
+}
+
+/* Opens a new file in the directory as a binary write stream
+ * Returns 1 if successful, 0 if the entry already exists or -1 on error
+ */
+int directory_handle_open_file_stream(
+     directory_handle_t *directory_handle,
+     const system_character_t *name,
+     size_t name_length,
+     FILE **file_stream,
+     libcerror_error_t **error )
+{
+	system_character_t *entry_name = NULL;
+	static char *function          = "directory_handle_open_file_stream";
+	int result                     = 0;
+
+#if defined( DIRECTORY_HANDLE_HAVE_DESCRIPTOR )
+	int file_descriptor            = -1;
+#else
+	system_character_t *path       = NULL;
+	size_t path_size               = 0;
+#endif
+
+	if( file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file stream.",
+		 function );
+
+		return( -1 );
+	}
+	result = directory_handle_append_name(
+	          directory_handle,
+	          name,
+	          name_length,
+	          &entry_name,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append name.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+#if defined( DIRECTORY_HANDLE_HAVE_DESCRIPTOR )
+	/* O_EXCL makes the existence check part of the create
+	 */
+	file_descriptor = openat(
+	                   directory_handle->descriptor,
+	                   entry_name,
+	                   O_WRONLY | O_CREAT | O_EXCL,
+	                   0644 );
+
+	if( file_descriptor == -1 )
+	{
+		if( errno == EEXIST )
+		{
+			return( 0 );
+		}
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to create file: %" PRIs_SYSTEM " in: %" PRIs_SYSTEM ".",
+		 function,
+		 entry_name,
+		 directory_handle->path );
+
+		return( -1 );
+	}
+	*file_stream = fdopen(
+	                file_descriptor,
+	                FILE_STREAM_BINARY_OPEN_WRITE );
+
+	if( *file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file stream: %" PRIs_SYSTEM " in: %" PRIs_SYSTEM ".",
+		 function,
+		 entry_name,
+		 directory_handle->path );
+
+		close(
+		 file_descriptor );
+
+		return( -1 );
+	}
+	return( 1 );
+#else
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libcpath_path_join_wide(
+	          &path,
+	          &path_size,
+	          directory_handle->path,
+	          directory_handle->path_size - 1,
+	          entry_name,
+	          name_length,
+	          error );
+#else
+	result = libcpath_path_join(
+	          &path,
+	          &path_size,
+	          directory_handle->path,
+	          directory_handle->path_size - 1,
+	          entry_name,
+	          name_length,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create path.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libcfile_file_exists_wide(
+	          path,
+	          error );
+#else
+	result = libcfile_file_exists(
+	          path,
+	          error );
+#endif
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine if %" PRIs_SYSTEM " exists.",
+		 function,
+		 path );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		*file_stream = file_stream_open_wide(
+		                path,
+		                _SYSTEM_STRING( FILE_STREAM_BINARY_OPEN_WRITE ) );
+#else
+		*file_stream = file_stream_open(
+		                path,
+		                FILE_STREAM_BINARY_OPEN_WRITE );
+#endif
+		if( *file_stream == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file stream: %" PRIs_SYSTEM ".",
+			 function,
+			 path );
+
+			goto on_error;
+		}
+		result = 1;
+	}
+	else
+	{
+		result = 0;
+	}
+	memory_free(
+	 path );
+
+	return( result );
+
+on_error:
+	if( path != NULL )
+	{
+		memory_free(
+		 path );
+	}
+	return( -1 );
+#endif
+}
+
@@ -0,0 +1,126 @@
+/*
+ * Directory handle
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _DIRECTORY_HANDLE_H )
+#define _DIRECTORY_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "pfftools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* Entries are created relative to an open directory descriptor
+ * if the system supports it, otherwise by path
+ */
+#if defined( HAVE_OPENAT ) && defined( HAVE_MKDIRAT ) && defined( HAVE_FDOPEN ) && !defined( WINAPI ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#define DIRECTORY_HANDLE_HAVE_DESCRIPTOR	1
+#endif
+
+typedef struct directory_handle directory_handle_t;
+
+struct directory_handle
+{
+	/* The path
+	 */
+	system_character_t *path;
+
+	/* The path size
+	 */
+	size_t path_size;
+
+#if defined( DIRECTORY_HANDLE_HAVE_DESCRIPTOR )
+	/* The directory descriptor
+	 */
+	int descriptor;
+#endif
+
+	/* The names of the entries created in the directory, sorted
+	 */
+	system_character_t **names;
+
+	/* The number of names
+	 */
+	int number_of_names;
+
+	/* The number of allocated names
+	 */
+	int number_of_allocated_names;
+};
+
+int directory_handle_initialize(
+     directory_handle_t **directory_handle,
+     libcerror_error_t **error );
+
+int directory_handle_free(
+     directory_handle_t **directory_handle,
+     libcerror_error_t **error );
+
+int directory_handle_open(
+     directory_handle_t *directory_handle,
+     const system_character_t *path,
+     size_t path_length,
+     libcerror_error_t **error );
+
+int directory_handle_open_sub_directory(
+     directory_handle_t *directory_handle,
+     directory_handle_t *parent_directory_handle,
+     const system_character_t *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+int directory_handle_get_name_index(
+     directory_handle_t *directory_handle,
+     const system_character_t *name,
+     size_t name_length,
+     int *name_index,
+     libcerror_error_t **error );
+
+int directory_handle_append_name(
+     directory_handle_t *directory_handle,
+     const system_character_t *name,
+     size_t name_length,
+     system_character_t **entry_name,
+     libcerror_error_t **error );
+
+int directory_handle_make_directory(
+     directory_handle_t *directory_handle,
+     const system_character_t *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+int directory_handle_open_file_stream(
+     directory_handle_t *directory_handle,
+     const system_character_t *name,
+     size_t name_length,
+     FILE **file_stream,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _DIRECTORY_HANDLE_H ) */
+
@@ -28,6 +28,7 @@
 #include <types.h>
 #include <wide_string.h>
 
+#include "directory_handle.h"
 #include "export_handle.h"
 #include "item_file.h"
 #include "mapi_property_definition.h"
@@ -42,6 +43,7 @@
 #include "pfftools_libfguid.h"
 #include "pfftools_libfmapi.h"
 #include "pfftools_libpff.h"
+#include "profile_handle.h"
 
 #define EXPORT_HANDLE_BUFFER_SIZE		8192
 #define EXPORT_HANDLE_NOTIFY_STREAM		stdout
@@ -133,6 +135,7 @@ int export_handle_free(
      libcerror_error_t **error )
 {
 	static char *function = "export_handle_free";
+	int result            = 1;
 
 	if( export_handle == NULL )
 	{
@@ -167,12 +170,31 @@ int export_handle_free(
 			memory_free(
 			 ( *export_handle )->recovered_export_path );
 		}
+		if( ( *export_handle )->directory_handles != NULL )
+		{
+			if( export_handle_close_directory_handles(
+			     *export_handle,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to close directory handles.",
+				 function );
+
+				result = -1;
+			}
+			memory_free(
+			 ( *export_handle )->directory_handles );
+		}
 		memory_free(
 		 *export_handle );
 
 		*export_handle = NULL;
 	}
-	return( 1 );
+	return( result );
 }
 
 /* Signals the export handle to abort its current activity
@@ -914,6 +936,275 @@ int export_handle_create_recovered_export_path(
 	return( 1 );
 }
 
+/* Closes the directory handles beyond the first number of directory handles
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_close_directory_handles(
+     export_handle_t *export_handle,
+     int number_of_directory_handles,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_close_directory_handles";
+	int result            = 1;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_directory_handles < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of directory handles value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	while( export_handle->number_of_directory_handles > number_of_directory_handles )
+	{
+		export_handle->number_of_directory_handles -= 1;
+
+		if( directory_handle_free(
+		     &( export_handle->directory_handles[ export_handle->number_of_directory_handles ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free directory handle: %d.",
+			 function,
+			 export_handle->number_of_directory_handles );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Retrieves the directory handle of an export path
+ * The directory handles of the directories on the current export path are kept open,
+ * so that a directory is opened relative to its deepest open parent directory
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_get_directory_handle(
+     export_handle_t *export_handle,
+     const system_character_t *path,
+     size_t path_length,
+     directory_handle_t **directory_handle,
+     libcerror_error_t **error )
+{
+	directory_handle_t **directory_handles      = NULL;
+	directory_handle_t *parent_directory_handle = NULL;
+	directory_handle_t *sub_directory_handle    = NULL;
+	static char *function                       = "export_handle_get_directory_handle";
+	size_t name_length                          = 0;
+	size_t parent_path_length                   = 0;
+	size_t path_index                           = 0;
+	int directory_handle_index                  = 0;
+	int number_of_allocated_directory_handles   = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* Find the deepest open directory that is the path or one of its parents
+	 */
+	for( directory_handle_index = export_handle->number_of_directory_handles - 1;
+	     directory_handle_index >= 0;
+	     directory_handle_index-- )
+	{
+		parent_directory_handle = export_handle->directory_handles[ directory_handle_index ];
+		parent_path_length      = parent_directory_handle->path_size - 1;
+
+		if( ( parent_path_length <= path_length )
+		 && ( system_string_compare(
+		       parent_directory_handle->path,
+		       path,
+		       parent_path_length ) == 0 ) )
+		{
+			if( ( parent_path_length == path_length )
+			 || ( path[ parent_path_length ] == (system_character_t) LIBCPATH_SEPARATOR ) )
+			{
+				break;
+			}
+		}
+	}
+	if( export_handle_close_directory_handles(
+	     export_handle,
+	     directory_handle_index + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to close directory handles.",
+		 function );
+
+		goto on_error;
+	}
+	if( directory_handle_index < 0 )
+	{
+		parent_directory_handle = NULL;
+		path_index              = 0;
+	}
+	else
+	{
+		path_index = parent_path_length;
+	}
+	while( ( parent_directory_handle == NULL )
+	    || ( path_index < path_length ) )
+	{
+		if( ( parent_directory_handle != NULL )
+		 && ( path[ path_index ] == (system_character_t) LIBCPATH_SEPARATOR ) )
+		{
+			path_index++;
+
+			continue;
+		}
+		if( export_handle->number_of_directory_handles >= export_handle->number_of_allocated_directory_handles )
+		{
+			number_of_allocated_directory_handles = export_handle->number_of_allocated_directory_handles + 16;
+
+			directory_handles = (directory_handle_t **) memory_reallocate(
+			                                             export_handle->directory_handles,
+			                                             sizeof( directory_handle_t * ) * number_of_allocated_directory_handles );
+
+			if( directory_handles == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize directory handles.",
+				 function );
+
+				goto on_error;
+			}
+			export_handle->directory_handles                     = directory_handles;
+			export_handle->number_of_allocated_directory_handles = number_of_allocated_directory_handles;
+		}
+		if( directory_handle_initialize(
+		     &sub_directory_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create directory handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( parent_directory_handle == NULL )
+		{
+			if( directory_handle_open(
+			     sub_directory_handle,
+			     path,
+			     path_length,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open directory handle.",
+				 function );
+
+				goto on_error;
+			}
+			path_index = path_length;
+		}
+		else
+		{
+			for( name_length = 0;
+			     ( path_index + name_length ) < path_length;
+			     name_length++ )
+			{
+				if( path[ path_index + name_length ] == (system_character_t) LIBCPATH_SEPARATOR )
+				{
+					break;
+				}
+			}
+			if( directory_handle_open_sub_directory(
+			     sub_directory_handle,
+			     parent_directory_handle,
+			     &( path[ path_index ] ),
+			     name_length,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open sub directory handle.",
+				 function );
+
+				goto on_error;
+			}
+			path_index += name_length;
+		}
+		export_handle->directory_handles[ export_handle->number_of_directory_handles ] = sub_directory_handle;
+
+		export_handle->number_of_directory_handles += 1;
+
+		parent_directory_handle = sub_directory_handle;
+		sub_directory_handle    = NULL;
+	}
+	*directory_handle = parent_directory_handle;
+
+	return( 1 );
+
+on_error:
+	if( sub_directory_handle != NULL )
+	{
+		directory_handle_free(
+		 &sub_directory_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* Creates the default item directory path
  * Returns 1 if successful or -1 on error
  */
@@ -931,10 +1222,11 @@ int export_handle_create_default_item_directory(
 {
 	system_character_t item_directory_name[ 64 ];
 
-	static char *function             = "export_handle_create_default_item_directory";
-	size_t item_directory_name_length = 0;
-	int print_count                   = 0;
-	int result                        = 0;
+	directory_handle_t *directory_handle = NULL;
+	static char *function                = "export_handle_create_default_item_directory";
+	size_t item_directory_name_length    = 0;
+	int print_count                      = 0;
+	int result                           = 0;
 
 	if( export_handle == NULL )
 	{
@@ -1045,54 +1337,47 @@ int export_handle_create_default_item_directory(
 
 		goto on_error;
 	}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libcfile_file_exists_wide(
-	          *item_directory_path,
-	          error );
-#else
-	result = libcfile_file_exists(
-	          *item_directory_path,
-	          error );
-#endif
-	if( result == -1 )
+	if( export_handle_get_directory_handle(
+	     export_handle,
+	     export_path,
+	     export_path_length,
+	     &directory_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_GENERIC,
-		 "%s: unable to determine if %" PRIs_SYSTEM " exists.",
-		 function,
-		 *item_directory_path );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve directory handle.",
+		 function );
 
 		goto on_error;
 	}
-	else if( result != 0 )
+	result = directory_handle_make_directory(
+	          directory_handle,
+	          item_directory_name,
+	          item_directory_name_length,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_GENERIC,
-		 "%s: %" PRIs_SYSTEM " already exists.",
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to make directory: %" PRIs_SYSTEM ".",
 		 function,
 		 *item_directory_path );
 
 		goto on_error;
 	}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	if( libcpath_path_make_directory_wide(
-	     *item_directory_path,
-	     error ) != 1 )
-#else
-	if( libcpath_path_make_directory(
-	     *item_directory_path,
-	     error ) != 1 )
-#endif
+	else if( result == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to make directory: %" PRIs_SYSTEM ".",
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: %" PRIs_SYSTEM " already exists.",
 		 function,
 		 *item_directory_path );
 
@@ -1138,10 +1423,9 @@ int export_handle_create_item_file(
      item_file_t **item_file,
      libcerror_error_t **error )
 {
-	system_character_t *item_file_path = NULL;
-	static char *function              = "export_handle_create_item_file";
-	size_t item_file_path_size         = 0;
-	int result                         = 0;
+	directory_handle_t *directory_handle = NULL;
+	static char *function                = "export_handle_create_item_file";
+	int result                           = 0;
 
 	if( export_handle == NULL )
 	{
@@ -1165,67 +1449,25 @@ int export_handle_create_item_file(
 
 		return( -1 );
 	}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libcpath_path_join_wide(
-	          &item_file_path,
-	          &item_file_path_size,
-	          path,
-	          path_length,
-	          filename,
-	          filename_length,
-	          error );
-#else
-	result = libcpath_path_join(
-	          &item_file_path,
-	          &item_file_path_size,
-	          path,
-	          path_length,
-	          filename,
-	          filename_length,
-	          error );
-#endif
-	if( result != 1 )
+	if( export_handle_get_directory_handle(
+	     export_handle,
+	     path,
+	     path_length,
+	     &directory_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create item file path.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve directory handle.",
 		 function );
 
 		goto on_error;
 	}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libcfile_file_exists_wide(
-	          item_file_path,
-	          error );
-#else
-	result = libcfile_file_exists(
-	          item_file_path,
-	          error );
-#endif
-	if( result == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_GENERIC,
-		 "%s: unable to determine if %" PRIs_SYSTEM " exists.",
-		 function,
-		 item_file_path );
-
-		goto on_error;
-	}
-	else if( result != 0 )
-	{
-		memory_free(
-		 item_file_path );
-
-		return( 0 );
-	}
-	if( item_file_initialize(
-	     item_file,
-	     error ) != 1 )
+	if( item_file_initialize(
+	     item_file,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -1236,26 +1478,49 @@ int export_handle_create_item_file(
 
 		goto on_error;
 	}
-	if( item_file_open(
-	     *item_file,
-	     item_file_path,
-	     error ) != 1 )
+	if( export_handle->profile_handle != NULL )
+	{
+		( *item_file )->output_size = &( export_handle->profile_handle->output_size );
+	}
+	/* The file is created exclusively, the existence check does not need a separate stat
+	 */
+	result = item_file_open_in_directory(
+	          *item_file,
+	          directory_handle,
+	          filename,
+	          filename_length,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open: %" PRIs_SYSTEM ".",
+		 "%s: unable to open: %" PRIs_SYSTEM " in: %" PRIs_SYSTEM ".",
 		 function,
-		 item_file_path );
+		 filename,
+		 path );
 
 		goto on_error;
 	}
-	memory_free(
-	 item_file_path );
-
-	item_file_path = NULL;
+	else if( result == 0 )
+	{
+		if( item_file_free(
+		     item_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free item file.",
+			 function );
 
+			goto on_error;
+		}
+		return( 0 );
+	}
 	return( 1 );
 
 on_error:
@@ -1265,11 +1530,6 @@ on_error:
 		 item_file,
 		 NULL );
 	}
-	if( item_file_path != NULL )
-	{
-		memory_free(
-		 item_file_path );
-	}
 	return( -1 );
 }
 
@@ -1286,13 +1546,17 @@ int export_handle_export_item(
      log_handle_t *log_handle,
      libcerror_error_t **error )
 {
+	profile_measurement_t profile_measurement;
+
 	system_character_t *entry_value_string = NULL;
 	system_character_t *item_path          = NULL;
 	static char *function                  = "export_handle_export_item";
 	char *item_type_string                 = NULL;
 	size_t entry_value_string_size         = 0;
 	size_t item_path_size                  = 0;
+	uint32_t identifier                    = 0;
 	uint8_t item_type                      = 0;
+	int is_profiled                        = 0;
 	int result                             = 0;
 
 	if( export_handle == NULL )
@@ -1341,6 +1605,24 @@ int export_handle_export_item(
 
 		return( 1 );
 	}
+	if( export_handle->profile_handle != NULL )
+	{
+		if( profile_handle_start_measurement(
+		     export_handle->profile_handle,
+		     &profile_measurement,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to start profile measurement.",
+			 function );
+
+			goto on_error;
+		}
+		is_profiled = 1;
+	}
 	switch( item_type )
 	{
 		case LIBPFF_ITEM_TYPE_ACTIVITY:
@@ -1799,9 +2081,57 @@ int export_handle_export_item(
 			}
 		}
 	}
+	if( is_profiled != 0 )
+	{
+		if( libpff_item_get_identifier(
+		     item,
+		     &identifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve identifier.",
+			 function );
+
+			goto on_error;
+		}
+		is_profiled = 0;
+
+		if( profile_handle_stop_measurement(
+		     export_handle->profile_handle,
+		     &profile_measurement,
+		     identifier,
+		     item_type,
+		     export_path,
+		     export_path_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to stop profile measurement.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	return( 1 );
 
 on_error:
+	if( is_profiled != 0 )
+	{
+		profile_handle_stop_measurement(
+		 export_handle->profile_handle,
+		 &profile_measurement,
+		 identifier,
+		 item_type,
+		 export_path,
+		 export_path_length,
+		 NULL );
+	}
 	if( entry_value_string != NULL )
 	{
 		memory_free(
@@ -2334,105 +2664,56 @@ on_error:
 	return( -1 );
 }
 
-/* Writes a specific record set value to the item file
- * Returns 1 if successful or -1 on error
+/* Retrieves the (mapped) entry type and value type of a record entry
+ * Named properties are identified by their numeric mapped entry type
+ * Returns 1 if successful, 0 if not available or -1 on error
  */
-void export_handle_write_record_set_value_to_item_file(
-      item_file_t *item_file,
-      const system_character_t *description,
-      libpff_record_set_t *record_set,
-      uint32_t entry_type,
-      uint32_t value_type,
-      uint32_t format_flags,
-      int (*write_to_item_file_function)(
-             item_file_t *item_file,
-             libpff_record_entry_t *record_entry,
-             libcerror_error_t **error ) )
+int export_handle_record_entry_get_type(
+     libpff_record_entry_t *record_entry,
+     uint32_t *entry_type,
+     uint32_t *value_type,
+     libcerror_error_t **error )
 {
-	libcerror_error_t *error = NULL;
-	static char *function    = "export_handle_write_record_set_value_to_item_file";
+	libpff_name_to_id_map_entry_t *name_to_id_map_entry = NULL;
+	static char *function                               = "export_handle_record_entry_get_type";
+	uint8_t name_to_id_map_entry_type                   = 0;
+	int result                                          = 0;
 
-	if( item_file_write_record_set_value(
-	     item_file,
-	     description,
-	     record_set,
-	     entry_type,
-	     value_type,
-	     format_flags,
-	     write_to_item_file_function,
-	     &error ) != 1 )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write record set value: 0x%04" PRIx32 " 0x%04" PRIx32 ".",
-		 function,
-		 entry_type,
-		 value_type );
+	result = libpff_record_entry_get_entry_type(
+	          record_entry,
+	          entry_type,
+	          error );
 
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( error != NULL )
+	if( result != 1 )
+	{
+		if( result == -1 )
 		{
-			libcnotify_print_error_backtrace(
-			 error );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry type.",
+			 function );
 		}
-#endif
-		libcerror_error_free(
-		 &error );
-	}
-}
-
-/* Exports the item values
- * Returns 1 if successful or -1 on error
- */
-int export_handle_export_item_values(
-     export_handle_t *export_handle,
-     libpff_item_t *item,
-     const system_character_t *item_values_filename,
-     size_t item_values_filename_length,
-     const system_character_t *export_path,
-     size_t export_path_length,
-     log_handle_t *log_handle,
-     libcerror_error_t **error )
-{
-	libpff_record_set_t *record_set = NULL;
-	item_file_t *item_file          = NULL;
-	static char *function           = "export_handle_export_item_values";
-	uint32_t number_of_entries      = 0;
-	int number_of_record_sets       = 0;
-	int record_set_index            = 0;
-	int result                      = 0;
-
-	if( export_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid export handle.",
-		 function );
-
-		return( -1 );
+		return( result );
 	}
-	if( item_values_filename == NULL )
+	if( libpff_record_entry_get_value_type(
+	     record_entry,
+	     value_type,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid item value filename.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value type.",
 		 function );
 
 		return( -1 );
 	}
-	result = export_handle_create_item_file(
-	          export_handle,
-	          export_path,
-	          export_path_length,
-                  item_values_filename,
-                  item_values_filename_length,
-	          &item_file,
+	result = libpff_record_entry_get_name_to_id_map_entry(
+	          record_entry,
+	          &name_to_id_map_entry,
 	          error );
 
 	if( result == -1 )
@@ -2440,100 +2721,469 @@ int export_handle_export_item_values(
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create item file.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve name to identifier map entry.",
 		 function );
 
 		return( -1 );
 	}
 	else if( result == 0 )
 	{
-		log_handle_printf(
-		 log_handle,
-		 "Skipping item values file: %" PRIs_SYSTEM " it already exists.\n",
-		 item_values_filename );
-
 		return( 1 );
 	}
-	if( libpff_item_get_number_of_record_sets(
-	     item,
-	     &number_of_record_sets,
+	if( libpff_name_to_id_map_entry_get_type(
+	     name_to_id_map_entry,
+	     &name_to_id_map_entry_type,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of record sets.",
+		 "%s: unable to retrieve name to identifier map entry type.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-/* TODO deprecate? */
-	if( libpff_item_get_number_of_entries(
-	     item,
-	     &number_of_entries,
+	/* Mapped properties are identified by their mapped entry type
+	 */
+	if( name_to_id_map_entry_type != LIBPFF_NAME_TO_ID_MAP_ENTRY_TYPE_NUMERIC )
+	{
+		return( 0 );
+	}
+	if( libpff_name_to_id_map_entry_get_number(
+	     name_to_id_map_entry,
+	     entry_type,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of entries.",
+		 "%s: unable to retrieve name to identifier map entry number.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( item_file_write_value_integer_32bit_as_decimal(
-	     item_file,
-	     _SYSTEM_STRING( "Number of sets:\t\t\t" ),
-	     (uint32_t) number_of_record_sets,
-	     error ) != 1 )
+	return( 1 );
+}
+
+/* Writes the record set values defined by the property definitions to an item file
+ * The record set is read in a single pass and the values are written in the order of the definitions
+ * Values that cannot be written are skipped
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_write_record_set_values_to_item_file(
+     item_file_t *item_file,
+     libpff_record_set_t *record_set,
+     mapi_property_definitions_t *property_definitions,
+     int number_of_property_definitions,
+     libcerror_error_t **error )
+{
+	libcerror_error_t *write_error                   = NULL;
+	libpff_record_entry_t **record_entries           = NULL;
+	libpff_record_entry_t *record_entry              = NULL;
+	mapi_property_definitions_t *property_definition = NULL;
+	int *sorted_definition_indexes                   = NULL;
+	static char *function                            = "export_handle_write_record_set_values_to_item_file";
+	uint32_t entry_type                              = 0;
+	uint32_t value_type                              = 0;
+	int definition_index                             = 0;
+	int entry_index                                  = 0;
+	int lower_index                                  = 0;
+	int number_of_entries                            = 0;
+	int result                                       = 0;
+	int sorted_index                                 = 0;
+	int upper_index                                  = 0;
+
+	if( property_definitions == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write 32-bit integer value.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid property definitions.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( item_file_write_value_integer_32bit_as_decimal(
-	     item_file,
-	     _SYSTEM_STRING( "Number of entries per set:\t" ),
-	     number_of_entries,
-	     error ) != 1 )
+	if( number_of_property_definitions <= 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write 32-bit integer value.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of property definitions value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	record_entries = (libpff_record_entry_t **) memory_allocate(
+	                                             sizeof( libpff_record_entry_t * ) * number_of_property_definitions );
+
+	if( record_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create record entries.",
 		 function );
 
 		goto on_error;
 	}
-	if( item_file_write_new_line(
-	     item_file,
-	     error ) != 1 )
+	if( memory_set(
+	     record_entries,
+	     0,
+	     sizeof( libpff_record_entry_t * ) * number_of_property_definitions ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write new line.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear record entries.",
 		 function );
 
 		goto on_error;
 	}
-	for( record_set_index = 0;
-	     record_set_index < number_of_record_sets;
-	     record_set_index++ )
+	sorted_definition_indexes = (int *) memory_allocate(
+	                                     sizeof( int ) * number_of_property_definitions );
+
+	if( sorted_definition_indexes == NULL )
 	{
-		if( libpff_item_get_record_set_by_index(
-		     item,
-		     record_set_index,
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sorted definition indexes.",
+		 function );
+
+		goto on_error;
+	}
+	/* Sort the definitions by entry type, the number of definitions is small
+	 * hence an insertion sort is used
+	 */
+	for( definition_index = 0;
+	     definition_index < number_of_property_definitions;
+	     definition_index++ )
+	{
+		entry_type   = property_definitions[ definition_index ].entry_type;
+		sorted_index = definition_index;
+
+		while( ( sorted_index > 0 )
+		    && ( property_definitions[ sorted_definition_indexes[ sorted_index - 1 ] ].entry_type > entry_type ) )
+		{
+			sorted_definition_indexes[ sorted_index ] = sorted_definition_indexes[ sorted_index - 1 ];
+
+			sorted_index--;
+		}
+		sorted_definition_indexes[ sorted_index ] = definition_index;
+	}
+	if( libpff_record_set_get_number_of_entries(
+	     record_set,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		goto on_error;
+	}
+	/* Dispatch each record entry to the definitions with a matching entry type
+	 * the first matching record entry is used, as by libpff_record_set_get_entry_by_type
+	 */
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libpff_record_set_get_entry_by_index(
+		     record_set,
+		     entry_index,
+		     &record_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve record entry: %d.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+		result = export_handle_record_entry_get_type(
+		          record_entry,
+		          &entry_type,
+		          &value_type,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve type of record entry: %d.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			lower_index = 0;
+			upper_index = number_of_property_definitions;
+
+			while( lower_index < upper_index )
+			{
+				sorted_index = lower_index + ( ( upper_index - lower_index ) / 2 );
+
+				if( property_definitions[ sorted_definition_indexes[ sorted_index ] ].entry_type < entry_type )
+				{
+					lower_index = sorted_index + 1;
+				}
+				else
+				{
+					upper_index = sorted_index;
+				}
+			}
+			for( sorted_index = lower_index;
+			     sorted_index < number_of_property_definitions;
+			     sorted_index++ )
+			{
+				definition_index    = sorted_definition_indexes[ sorted_index ];
+				property_definition = &( property_definitions[ definition_index ] );
+
+				if( property_definition->entry_type != entry_type )
+				{
+					break;
+				}
+				if( ( record_entries[ definition_index ] == NULL )
+				 && ( ( property_definition->value_type == LIBPFF_VALUE_TYPE_UNSPECIFIED )
+				  || ( property_definition->value_type == value_type ) ) )
+				{
+					record_entries[ definition_index ] = record_entry;
+				}
+			}
+		}
+		record_entry = NULL;
+	}
+	for( definition_index = 0;
+	     definition_index < number_of_property_definitions;
+	     definition_index++ )
+	{
+		if( record_entries[ definition_index ] == NULL )
+		{
+			continue;
+		}
+		property_definition = &( property_definitions[ definition_index ] );
+
+		if( item_file_write_record_entry(
+		     item_file,
+		     property_definition->description,
+		     record_entries[ definition_index ],
+		     property_definition->format_flags,
+		     property_definition->write_to_item_file_function,
+		     &write_error ) != 1 )
+		{
+			libcerror_error_set(
+			 &write_error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write record set value: 0x%04" PRIx32 " 0x%04" PRIx32 ".",
+			 function,
+			 property_definition->entry_type,
+			 property_definition->value_type );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( write_error != NULL )
+			{
+				libcnotify_print_error_backtrace(
+				 write_error );
+			}
+#endif
+			libcerror_error_free(
+			 &write_error );
+		}
+	}
+	memory_free(
+	 sorted_definition_indexes );
+
+	memory_free(
+	 record_entries );
+
+	return( 1 );
+
+on_error:
+	if( sorted_definition_indexes != NULL )
+	{
+		memory_free(
+		 sorted_definition_indexes );
+	}
+	if( record_entries != NULL )
+	{
+		memory_free(
+		 record_entries );
+	}
+	return( -1 );
+}
+
+/* Exports the item values
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_export_item_values(
+     export_handle_t *export_handle,
+     libpff_item_t *item,
+     const system_character_t *item_values_filename,
+     size_t item_values_filename_length,
+     const system_character_t *export_path,
+     size_t export_path_length,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	libpff_record_set_t *record_set = NULL;
+	item_file_t *item_file          = NULL;
+	static char *function           = "export_handle_export_item_values";
+	uint32_t number_of_entries      = 0;
+	int number_of_record_sets       = 0;
+	int record_set_index            = 0;
+	int result                      = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( item_values_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item value filename.",
+		 function );
+
+		return( -1 );
+	}
+	result = export_handle_create_item_file(
+	          export_handle,
+	          export_path,
+	          export_path_length,
+                  item_values_filename,
+                  item_values_filename_length,
+	          &item_file,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create item file.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		log_handle_printf(
+		 log_handle,
+		 "Skipping item values file: %" PRIs_SYSTEM " it already exists.\n",
+		 item_values_filename );
+
+		return( 1 );
+	}
+	if( libpff_item_get_number_of_record_sets(
+	     item,
+	     &number_of_record_sets,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of record sets.",
+		 function );
+
+		goto on_error;
+	}
+/* TODO deprecate? */
+	if( libpff_item_get_number_of_entries(
+	     item,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( item_file_write_value_integer_32bit_as_decimal(
+	     item_file,
+	     _SYSTEM_STRING( "Number of sets:\t\t\t" ),
+	     (uint32_t) number_of_record_sets,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write 32-bit integer value.",
+		 function );
+
+		goto on_error;
+	}
+	if( item_file_write_value_integer_32bit_as_decimal(
+	     item_file,
+	     _SYSTEM_STRING( "Number of entries per set:\t" ),
+	     number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write 32-bit integer value.",
+		 function );
+
+		goto on_error;
+	}
+	if( item_file_write_new_line(
+	     item_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write new line.",
+		 function );
+
+		goto on_error;
+	}
+	for( record_set_index = 0;
+	     record_set_index < number_of_record_sets;
+	     record_set_index++ )
+	{
+		if( libpff_item_get_record_set_by_index(
+		     item,
+		     record_set_index,
 		     &record_set,
 		     error ) != 1 )
 		{
@@ -3462,10 +4112,8 @@ int export_handle_export_item_value_to_item_file(
      int number_of_property_definitions,
      libcerror_error_t **error )
 {
-	libpff_record_set_t *record_set                  = NULL;
-	mapi_property_definitions_t *property_definition = NULL;
-	static char *function                            = "export_handle_export_item_values_to_item_file";
-	int property_definition_index                    = 0;
+	libpff_record_set_t *record_set = NULL;
+	static char *function           = "export_handle_export_item_values_to_item_file";
 
 	if( export_handle == NULL )
 	{
@@ -3508,20 +4156,22 @@ int export_handle_export_item_value_to_item_file(
 
 		goto on_error;
 	}
-	for( property_definition_index = 0;
-	     property_definition_index < number_of_property_definitions;
-	     property_definition_index++ )
+	if( export_handle_write_record_set_values_to_item_file(
+	     item_file,
+	     record_set,
+	     property_definitions,
+	     number_of_property_definitions,
+	     error ) != 1 )
 	{
-		property_definition = &( property_definitions[ property_definition_index ] );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write record set: %d values.",
+		 function,
+		 record_set_index );
 
-		export_handle_write_record_set_value_to_item_file(
-		 item_file,
-		 property_definition->description,
-		 record_set,
-		 property_definition->entry_type,
-		 property_definition->value_type,
-		 property_definition->format_flags,
-		 property_definition->write_to_item_file_function );
+		goto on_error;
 	}
 	if( libpff_record_set_free(
 	     &record_set,
@@ -6098,9 +6748,7 @@ int export_handle_export_message_conversation_index_to_item_file(
 {
 	libpff_record_entry_t *record_entry = NULL;
 	libpff_record_set_t *record_set     = NULL;
-	uint8_t *data                       = NULL;
 	static char *function               = "export_handle_export_message_conversation_index_to_item_file";
-	size_t data_size                    = 0;
 	int result                          = 0;
 
 	if( export_handle == NULL )
@@ -6152,54 +6800,10 @@ int export_handle_export_message_conversation_index_to_item_file(
 	}
 	else if( result != 0 )
 	{
-		if( libpff_record_entry_get_data_size(
-		     record_entry,
-		     &data_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value data size.",
-			 function );
-
-			goto on_error;
-		}
-		data = (uint8_t *) memory_allocate(
-		                    sizeof( uint8_t ) * data_size );
-
-		if( data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create data.",
-			 function );
-
-			goto on_error;
-		}
-		if( libpff_record_entry_get_data(
-		     record_entry,
-		     data,
-		     data_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value data.",
-			 function );
-
-			goto on_error;
-		}
-		if( export_handle_export_message_conversation_index_data_to_item_file(
+		if( export_handle_export_message_conversation_index_record_entry_to_item_file(
 		     export_handle,
 		     item_file,
-		     data,
-		     data_size,
+		     record_entry,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -6211,10 +6815,6 @@ int export_handle_export_message_conversation_index_to_item_file(
 
 			goto on_error;
 		}
-		memory_free(
-		 data );
-
-		data = NULL;
 	}
 	if( libpff_record_entry_free(
 	     &record_entry,
@@ -6245,11 +6845,6 @@ int export_handle_export_message_conversation_index_to_item_file(
 	return( 1 );
 
 on_error:
-	if( data != NULL )
-	{
-		memory_free(
-		 data );
-	}
 	if( record_entry != NULL )
 	{
 		libpff_record_entry_free(
@@ -6265,116 +6860,273 @@ on_error:
 	return( -1 );
 }
 
-/* Exports the Outlook message conversation index to an item file
- * Returns 1 if successful or -1 on error
- */
-int export_handle_export_message_conversation_index_data_to_item_file(
-     export_handle_t *export_handle,
-     item_file_t *item_file,
-     const uint8_t *data,
-     size_t data_size,
-     libcerror_error_t **error )
-{
-	uint8_t filetime_buffer[ 8 ];
+/* Exports the Outlook message conversation index record entry to an item file
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_export_message_conversation_index_record_entry_to_item_file(
+     export_handle_t *export_handle,
+     item_file_t *item_file,
+     libpff_record_entry_t *record_entry,
+     libcerror_error_t **error )
+{
+	uint8_t guid_data[ 16 ];
+
+	libfdatetime_filetime_t *filetime = NULL;
+	libfguid_identifier_t *guid       = NULL;
+	static char *function             = "export_handle_export_message_conversation_index_record_entry_to_item_file";
+	uint64_t time_delta               = 0;
+	uint64_t value_64bit              = 0;
+	uint8_t random_number             = 0;
+	uint8_t sequence_count            = 0;
+	int child_block_index             = 0;
+	int number_of_child_blocks        = 0;
+	int result                        = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( item_file_write_value_description(
+	     item_file,
+	     _SYSTEM_STRING( "Conversation index:" ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write value description.",
+		 function );
+
+		goto on_error;
+	}
+	result = libpff_record_entry_get_data_as_conversation_index_header(
+	          record_entry,
+	          &value_64bit,
+	          guid_data,
+	          16,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve conversation index header block.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( libfdatetime_filetime_initialize(
+		     &filetime,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create filetime.",
+			 function );
+
+			goto on_error;
+		}
+		if( item_file_write_value_description(
+		     item_file,
+		     _SYSTEM_STRING( "Header block:" ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write value description.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfdatetime_filetime_copy_from_64bit(
+		     filetime,
+		     value_64bit,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_GENERIC,
+			 "%s: unable to create filetime.",
+			 function );
+
+			goto on_error;
+		}
+		if( item_file_write_value_filetime(
+		     item_file,
+		     _SYSTEM_STRING( "\tFiletime:\t" ),
+		     filetime,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write value filetime.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfguid_identifier_initialize(
+		     &guid,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create GUID.",
+			 function );
+
+			goto on_error;
+		}
+		/* Currently it is assumed that the GUID is in big-endian
+		 */
+		if( libfguid_identifier_copy_from_byte_stream(
+		     guid,
+		     guid_data,
+		     16,
+		     LIBFGUID_ENDIAN_BIG,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy byte stream to GUID.",
+			 function );
+
+			goto on_error;
+		}
+		if( item_file_write_string(
+		     item_file,
+		     _SYSTEM_STRING( "\tGUID:\t\t" ),
+		     8,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write string.",
+			 function );
+
+			goto on_error;
+		}
+		if( item_file_write_guid(
+		     item_file,
+		     guid,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write GUID.",
+			 function );
 
-	libfdatetime_filetime_t *delta_filetime = NULL;
-	libfdatetime_filetime_t *filetime       = NULL;
-	libfguid_identifier_t *guid             = NULL;
-	static char *function                   = "export_handle_export_message_conversation_index_data_to_item_file";
-	uint64_t value_64bit                    = 0;
-	uint32_t data_offset                    = 0;
-	int list_index                          = 0;
+			goto on_error;
+		}
+		if( item_file_write_new_line(
+		     item_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write new line.",
+			 function );
 
-	if( export_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid export handle.",
-		 function );
+			goto on_error;
+		}
+		if( libfguid_identifier_free(
+		     &guid,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free GUID.",
+			 function );
 
-		return( -1 );
-	}
-	if( item_file_write_value_description(
-	     item_file,
-	     _SYSTEM_STRING( "Conversation index:" ),
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write value description.",
-		 function );
+			goto on_error;
+		}
+		if( libpff_record_entry_get_data_as_conversation_index_number_of_child_blocks(
+		     record_entry,
+		     &number_of_child_blocks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of conversation index child blocks.",
+			 function );
 
-		goto on_error;
-	}
-	if( data_size >= 22 )
-	{
-		/* According to MSDN the first byte is reserved
-		 * and should always be 0x01 however it makes
-		 * more sense that it's the most significant
-		 * part of the current system filetime data
-		 */
-		if( data[ 0 ] == 0x01 )
+			goto on_error;
+		}
+		for( child_block_index = 0;
+		     child_block_index < number_of_child_blocks;
+		     child_block_index++ )
 		{
-			if( libfdatetime_filetime_initialize(
-			     &filetime,
+			if( libpff_record_entry_get_data_as_conversation_index_child_block(
+			     record_entry,
+			     child_block_index,
+			     &time_delta,
+			     &random_number,
+			     &sequence_count,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create filetime.",
-				 function );
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve conversation index child block: %d.",
+				 function,
+				 child_block_index );
 
 				goto on_error;
 			}
-			if( libfdatetime_filetime_initialize(
-			     &delta_filetime,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create delta filetime.",
-				 function );
+			/* The filetime of a child block is relative to that of the previous block
+			 */
+			value_64bit += time_delta;
 
-				goto on_error;
-			}
-			if( item_file_write_value_description(
+			if( item_file_write_value_integer_32bit_as_decimal(
 			     item_file,
-			     _SYSTEM_STRING( "Header block:" ),
+			     _SYSTEM_STRING( "Child block: " ),
+			     (uint32_t) ( child_block_index + 1 ),
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_IO,
 				 LIBCERROR_IO_ERROR_WRITE_FAILED,
-				 "%s: unable to write value description.",
+				 "%s: unable to write 32-bit integer value.",
 				 function );
 
 				goto on_error;
 			}
-			/* The current system file data is in big-endian
-			 */
-			filetime_buffer[ 0 ] = 0;
-			filetime_buffer[ 1 ] = 0;
-			filetime_buffer[ 2 ] = data[ 5 ];
-			filetime_buffer[ 3 ] = data[ 4 ];
-			filetime_buffer[ 4 ] = data[ 3 ];
-			filetime_buffer[ 5 ] = data[ 2 ];
-			filetime_buffer[ 6 ] = data[ 1 ];
-			filetime_buffer[ 7 ] = data[ 0 ];
-
-			if( libfdatetime_filetime_copy_from_byte_stream(
+			if( libfdatetime_filetime_copy_from_64bit(
 			     filetime,
-			     filetime_buffer,
-			     8,
-			     LIBFDATETIME_ENDIAN_LITTLE,
+			     value_64bit,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
@@ -6401,256 +7153,62 @@ int export_handle_export_message_conversation_index_data_to_item_file(
 
 				goto on_error;
 			}
-			if( libfguid_identifier_initialize(
-			     &guid,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create GUID.",
-				 function );
-
-				goto on_error;
-			}
-			/* Currently it is assumed that the GUID is in big-endian
-			 */
-			if( libfguid_identifier_copy_from_byte_stream(
-			     guid,
-			     &( data[ 6 ] ),
-			     16,
-			     LIBFGUID_ENDIAN_BIG,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
-				 "%s: unable to copy byte stream to GUID.",
-				 function );
-
-				goto on_error;
-			}
-			if( item_file_write_string(
-			     item_file,
-			     _SYSTEM_STRING( "\tGUID:\t\t" ),
-			     8,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_WRITE_FAILED,
-				 "%s: unable to write string.",
-				 function );
-
-				goto on_error;
-			}
-			if( item_file_write_guid(
-			     item_file,
-			     guid,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_WRITE_FAILED,
-				 "%s: unable to write GUID.",
-				 function );
-
-				goto on_error;
-			}
-			if( item_file_write_new_line(
+			if( item_file_write_value_integer_32bit_as_decimal(
 			     item_file,
+			     _SYSTEM_STRING( "\tRandom number:\t" ),
+			     (uint32_t) random_number,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_IO,
 				 LIBCERROR_IO_ERROR_WRITE_FAILED,
-				 "%s: unable to write new line.",
-				 function );
-
-				goto on_error;
-			}
-			if( libfguid_identifier_free(
-			     &guid,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free GUID.",
+				 "%s: unable to write 32-bit integer value.",
 				 function );
 
 				goto on_error;
 			}
-			list_index = 1;
-
-			for( data_offset = 22;
-			     data_offset < data_size;
-			     data_offset += 5 )
-			{
-				if( item_file_write_value_integer_32bit_as_decimal(
-				     item_file,
-				     _SYSTEM_STRING( "Child block: " ),
-				     (uint32_t) list_index,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_WRITE_FAILED,
-					 "%s: unable to write 32-bit integer value.",
-					 function );
-
-					goto on_error;
-				}
-				/* Use a 64-bit value to be able to shift the bits in the right position
-				 * current system time delta is in big-endian
-				 */
-				byte_stream_copy_to_uint32_little_endian(
-				 &( data[ data_offset ] ),
-				 value_64bit );
-
-				/* Make sure only 31-bits are set and the rest is cleared
-				 */
-				value_64bit &= 0x07fffffffUL;
-
-				/* Check if the highest bit is set
-				 */
-				if( ( data[ data_offset ] & 0x80 ) == 0 )
-				{
-					/* Discard the highest 15-bits and the lowest 18-bits
-					 */
-					value_64bit <<= 18;
-				}
-				else
-				{
-					/* Discard the highest 10-bits and the lowest 23-bits
-					 */
-					value_64bit <<= 23;
-				}
-				if( libfdatetime_filetime_copy_from_64bit(
-				     delta_filetime,
-				     value_64bit,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_CONVERSION,
-					 LIBCERROR_CONVERSION_ERROR_GENERIC,
-					 "%s: unable to create delta filetime.",
-					 function );
-
-					goto on_error;
-				}
-				/* The next child block uses the previous filetime as its base
-				 * not the filetime in the header block as MSDN states
-				 * so the filetime is updated
-				 */
-				if( libfdatetime_filetime_add(
-				     filetime,
-				     delta_filetime,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-					 "%s: unable to create filetime.",
-					 function );
-
-					goto on_error;
-				}
-				if( item_file_write_value_filetime(
-				     item_file,
-				     _SYSTEM_STRING( "\tFiletime:\t" ),
-				     filetime,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_WRITE_FAILED,
-					 "%s: unable to write value filetime.",
-					 function );
-
-					goto on_error;
-				}
-				if( item_file_write_value_integer_32bit_as_decimal(
-				     item_file,
-				     _SYSTEM_STRING( "\tRandom number:\t" ),
-				     (uint32_t) ( ( data[ data_offset + 4 ] & 0xf0 ) >> 4 ),
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_WRITE_FAILED,
-					 "%s: unable to write 32-bit integer value.",
-					 function );
-
-					goto on_error;
-				}
-				if( item_file_write_value_integer_32bit_as_decimal(
-				     item_file,
-				     _SYSTEM_STRING( "\tSequence count:\t" ),
-				     (uint32_t) ( data[ data_offset + 4 ] & 0x0f ),
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_WRITE_FAILED,
-					 "%s: unable to write 32-bit integer value.",
-					 function );
-
-					goto on_error;
-				}
-				list_index++;
-			}
-			if( item_file_write_new_line(
+			if( item_file_write_value_integer_32bit_as_decimal(
 			     item_file,
+			     _SYSTEM_STRING( "\tSequence count:\t" ),
+			     (uint32_t) sequence_count,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_IO,
 				 LIBCERROR_IO_ERROR_WRITE_FAILED,
-				 "%s: unable to write new line.",
+				 "%s: unable to write 32-bit integer value.",
 				 function );
 
 				goto on_error;
 			}
-			if( libfdatetime_filetime_free(
-			     &delta_filetime,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free delta filetime.",
-				 function );
+		}
+		if( item_file_write_new_line(
+		     item_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write new line.",
+			 function );
 
-				goto on_error;
-			}
-			if( libfdatetime_filetime_free(
-			     &filetime,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free filetime.",
-				 function );
+			goto on_error;
+		}
+		if( libfdatetime_filetime_free(
+		     &filetime,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free filetime.",
+			 function );
 
-				goto on_error;
-			}
+			goto on_error;
 		}
 	}
 	if( item_file_write_new_line(
@@ -6675,12 +7233,6 @@ on_error:
 		 &guid,
 		 NULL );
 	}
-	if( delta_filetime != NULL )
-	{
-		libfdatetime_filetime_free(
-		 &delta_filetime,
-		 NULL );
-	}
 	if( filetime != NULL )
 	{
 		libfdatetime_filetime_free(
@@ -6951,6 +7503,7 @@ int export_handle_export_attachments(
 	libpff_item_t *attachment            = NULL;
 	libpff_item_t *attachments           = NULL;
 	system_character_t *attachments_path = NULL;
+	directory_handle_t *directory_handle = NULL;
 	static char *function                = "export_handle_export_attachments";
 	size_t attachments_path_size         = 0;
 	int attachment_index                 = 0;
@@ -7027,54 +7580,47 @@ int export_handle_export_attachments(
 
 			goto on_error;
 		}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		result = libcfile_file_exists_wide(
-			  attachments_path,
-		          error );
-#else
-		result = libcfile_file_exists(
-			  attachments_path,
-		          error );
-#endif
-		if( result == -1 )
+		if( export_handle_get_directory_handle(
+		     export_handle,
+		     export_path,
+		     export_path_length,
+		     &directory_handle,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_GENERIC,
-			 "%s: unable to determine if %" PRIs_SYSTEM " exists.",
-			 function,
-			 attachments_path );
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve directory handle.",
+			 function );
 
 			goto on_error;
 		}
-		else if( result != 0 )
+		result = directory_handle_make_directory(
+		          directory_handle,
+		          _SYSTEM_STRING( "Attachments" ),
+		          11,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_GENERIC,
-			 "%s: %" PRIs_SYSTEM " already exists.",
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to make directory: %" PRIs_SYSTEM ".",
 			 function,
 			 attachments_path );
 
 			goto on_error;
 		}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		if( libcpath_path_make_directory_wide(
-		     attachments_path,
-		     error ) != 1 )
-#else
-		if( libcpath_path_make_directory(
-		     attachments_path,
-		     error ) != 1 )
-#endif
+		else if( result == 0 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to make directory: %" PRIs_SYSTEM ".",
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 "%s: %" PRIs_SYSTEM " already exists.",
 			 function,
 			 attachments_path );
 
@@ -7619,14 +8165,13 @@ int export_handle_export_attachment_data(
      libcerror_error_t **error )
 {
 	system_character_t *attachment_filename = NULL;
-	system_character_t *target_path         = NULL;
+	directory_handle_t *directory_handle    = NULL;
 	FILE *attachment_file_stream            = NULL;
 	uint8_t *attachment_data                = NULL;
 	static char *function                   = "export_handle_export_attachment_data";
 	size64_t attachment_data_size           = 0;
 	size_t attachment_filename_size         = 0;
 	size_t read_size                        = 0;
-	size_t target_path_size                 = 0;
 	size_t write_count                      = 0;
 	ssize_t read_count                      = 0;
 	int result                              = 0;
@@ -7664,66 +8209,54 @@ int export_handle_export_attachment_data(
 
 		goto on_error;
 	}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libcpath_path_join_wide(
-	          &target_path,
-	          &target_path_size,
-	          export_path,
-	          export_path_length,
-	          attachment_filename,
-	          attachment_filename_size - 1,
-	          error );
-#else
-	result = libcpath_path_join(
-	          &target_path,
-	          &target_path_size,
-	          export_path,
-	          export_path_length,
-	          attachment_filename,
-	          attachment_filename_size - 1,
-	          error );
-#endif
-	if( result != 1 )
+	if( export_handle_get_directory_handle(
+	     export_handle,
+	     export_path,
+	     export_path_length,
+	     &directory_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create target path.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve directory handle.",
 		 function );
 
 		goto on_error;
 	}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libcfile_file_exists_wide(
-		  target_path,
-	          error );
-#else
-	result = libcfile_file_exists(
-		  target_path,
+	/* Create the attachment file
+	 */
+	result = directory_handle_open_file_stream(
+	          directory_handle,
+	          attachment_filename,
+	          attachment_filename_size - 1,
+	          &attachment_file_stream,
 	          error );
-#endif
+
 	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_GENERIC,
-		 "%s: unable to determine if %" PRIs_SYSTEM " exists.",
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open: %" PRIs_SYSTEM " in: %" PRIs_SYSTEM ".",
 		 function,
-		 target_path );
+		 attachment_filename,
+		 export_path );
 
 		goto on_error;
 	}
-	else if( result != 0 )
+	else if( result == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_GENERIC,
-		 "%s: %" PRIs_SYSTEM " already exists.",
+		 "%s: %" PRIs_SYSTEM " already exists in: %" PRIs_SYSTEM ".",
 		 function,
-		 target_path );
+		 attachment_filename,
+		 export_path );
 
 		goto on_error;
 	}
@@ -7732,46 +8265,6 @@ int export_handle_export_attachment_data(
 
 	attachment_filename = NULL;
 
-	if( target_path == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing target path.",
-		 function );
-
-		goto on_error;
-	}
-	/* Create the attachment file
-	 */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	attachment_file_stream = file_stream_open_wide(
-				  target_path,
-				  _SYSTEM_STRING( FILE_STREAM_BINARY_OPEN_WRITE ) );
-#else
-	attachment_file_stream = file_stream_open(
-				  target_path,
-				  FILE_STREAM_BINARY_OPEN_WRITE );
-#endif
-
-	if( attachment_file_stream == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open: %" PRIs_SYSTEM ".",
-		 function,
-		 target_path );
-
-		goto on_error;
-	}
-	memory_free(
-	 target_path );
-
-	target_path = NULL;
-
 	result = libpff_attachment_get_data_size(
 		  attachment,
 		  &attachment_data_size,
@@ -7905,11 +8398,6 @@ on_error:
 		file_stream_close(
 		 attachment_file_stream );
 	}
-	if( target_path != NULL )
-	{
-		memory_free(
-		 target_path );
-	}
 	if( attachment_filename != NULL )
 	{
 		memory_free(
@@ -7933,6 +8421,7 @@ int export_handle_export_attachment_item(
 	libpff_item_t *attached_item            = NULL;
 	system_character_t *attachment_filename = NULL;
 	system_character_t *target_path         = NULL;
+	directory_handle_t *directory_handle    = NULL;
 	static char *function                   = "export_handle_export_attachment_item";
 	size_t attachment_filename_size         = 0;
 	size_t target_path_size                 = 0;
@@ -8020,64 +8509,57 @@ int export_handle_export_attachment_item(
 
 		goto on_error;
 	}
-	memory_free(
-	 attachment_filename );
-
-	attachment_filename = NULL;
-
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libcfile_file_exists_wide(
-		  target_path,
-	          error );
-#else
-	result = libcfile_file_exists(
-		  target_path,
-	          error );
-#endif
-	if( result == -1 )
+	if( export_handle_get_directory_handle(
+	     export_handle,
+	     export_path,
+	     export_path_length,
+	     &directory_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_GENERIC,
-		 "%s: unable to determine if %" PRIs_SYSTEM " exists.",
-		 function,
-		 target_path );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve directory handle.",
+		 function );
 
 		goto on_error;
 	}
-	else if( result != 0 )
+	result = directory_handle_make_directory(
+	          directory_handle,
+	          attachment_filename,
+	          attachment_filename_size - 1,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_GENERIC,
-		 "%s: %" PRIs_SYSTEM " already exists.",
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to make directory: %" PRIs_SYSTEM ".",
 		 function,
 		 target_path );
 
-		return( -1 );
+		goto on_error;
 	}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	if( libcpath_path_make_directory_wide(
-	     target_path,
-	     error ) != 1 )
-#else
-	if( libcpath_path_make_directory(
-	     target_path,
-	     error ) != 1 )
-#endif
+	else if( result == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to make directory: %" PRIs_SYSTEM ".",
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: %" PRIs_SYSTEM " already exists.",
 		 function,
 		 target_path );
 
 		goto on_error;
 	}
+	memory_free(
+	 attachment_filename );
+
+	attachment_filename = NULL;
+
 	log_handle_printf(
 	 log_handle,
 	 "Created directory: %" PRIs_SYSTEM ".\n",
@@ -8511,11 +8993,9 @@ int export_handle_export_recipients_to_item_file(
 		{ _SYSTEM_STRING( "Address type:\t\t" ), LIBPFF_ENTRY_TYPE_ADDRESS_TYPE, LIBPFF_VALUE_TYPE_STRING, 0, NULL },
 		{ _SYSTEM_STRING( "Recipient type:\t\t" ), LIBPFF_ENTRY_TYPE_RECIPIENT_TYPE, LIBPFF_VALUE_TYPE_INTEGER_32BIT_SIGNED, 0, &export_handle_export_recipient_type_to_item_file } };
 
-	libpff_record_set_t *record_set                  = NULL;
-	mapi_property_definitions_t *property_definition = NULL;
-	static char *function                            = "export_handle_export_recipients_to_item_file";
-	int property_definition_index                    = 0;
-	int recipient_index                              = 0;
+	libpff_record_set_t *record_set = NULL;
+	static char *function           = "export_handle_export_recipients_to_item_file";
+	int recipient_index             = 0;
 
 	if( export_handle == NULL )
 	{
@@ -8575,23 +9055,22 @@ int export_handle_export_recipients_to_item_file(
 
 			goto on_error;
 		}
-/* TODO merge with export_handle_export_item_value_to_item_file ?
- * allow description to be NULL ?
- */
-		for( property_definition_index = 0;
-		     property_definition_index < 5;
-		     property_definition_index++ )
+		if( export_handle_write_record_set_values_to_item_file(
+		     item_file,
+		     record_set,
+		     (mapi_property_definitions_t *) &property_definitions,
+		     5,
+		     error ) != 1 )
 		{
-			property_definition = &( property_definitions[ property_definition_index ] );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write record set: %d values.",
+			 function,
+			 recipient_index );
 
-			export_handle_write_record_set_value_to_item_file(
-			 item_file,
-			 property_definition->description,
-			 record_set,
-			 property_definition->entry_type,
-			 property_definition->value_type,
-			 property_definition->format_flags,
-			 property_definition->write_to_item_file_function );
+			goto on_error;
 		}
 		if( item_file_write_new_line(
 		     item_file,
@@ -13356,14 +13835,15 @@ int export_handle_export_folder(
      log_handle_t *log_handle,
      libcerror_error_t **error )
 {
-	system_character_t *folder_name = NULL;
-	system_character_t *target_path = NULL;
-	static char *function           = "export_handle_export_folder";
-	size_t folder_name_size         = 0;
-	size_t target_path_size         = 0;
-	uint32_t identifier             = 0;
-	int print_count                 = 0;
-	int result                      = 0;
+	system_character_t *folder_name      = NULL;
+	system_character_t *target_path      = NULL;
+	directory_handle_t *directory_handle = NULL;
+	static char *function                = "export_handle_export_folder";
+	size_t folder_name_size              = 0;
+	size_t target_path_size              = 0;
+	uint32_t identifier                  = 0;
+	int print_count                      = 0;
+	int result                           = 0;
 
 	if( export_handle == NULL )
 	{
@@ -13481,28 +13961,41 @@ int export_handle_export_folder(
 
 		goto on_error;
 	}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libcfile_file_exists_wide(
-	          target_path,
-	          error );
-#else
-	result = libcfile_file_exists(
-	          target_path,
+	if( export_handle_get_directory_handle(
+	     export_handle,
+	     export_path,
+	     export_path_length,
+	     &directory_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve directory handle.",
+		 function );
+
+		goto on_error;
+	}
+	result = directory_handle_make_directory(
+	          directory_handle,
+	          folder_name,
+	          folder_name_size - 1,
 	          error );
-#endif
+
 	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_GENERIC,
-		 "%s: unable to determine if %" PRIs_SYSTEM " exists.",
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to make directory: %" PRIs_SYSTEM ".",
 		 function,
 		 target_path );
 
 		goto on_error;
 	}
-	else if( result != 0 )
+	else if( result == 0 )
 	{
 		memory_free(
 		 target_path );
@@ -13565,32 +14058,30 @@ int export_handle_export_folder(
 
 			goto on_error;
 		}
+		result = directory_handle_make_directory(
+		          directory_handle,
+		          folder_name,
+		          folder_name_size - 1,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to make directory: %" PRIs_SYSTEM ".",
+			 function,
+			 target_path );
+
+			goto on_error;
+		}
 	}
 	memory_free(
 	 folder_name );
 
 	folder_name = NULL;
 
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	if( libcpath_path_make_directory_wide(
-	     target_path,
-	     error ) != 1 )
-#else
-	if( libcpath_path_make_directory(
-	     target_path,
-	     error ) != 1 )
-#endif
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to make directory: %" PRIs_SYSTEM ".",
-		 function,
-		 target_path );
-
-		goto on_error;
-	}
 	log_handle_printf(
 	 log_handle,
 	 "Created directory: %" PRIs_SYSTEM ".\n",
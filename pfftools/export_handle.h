@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "directory_handle.h"
 #include "item_file.h"
 #include "log_handle.h"
 #include "mapi_property_definition.h"
@@ -32,6 +33,7 @@
 #include "pfftools_libfdatetime.h"
 #include "pfftools_libfguid.h"
 #include "pfftools_libpff.h"
+#include "profile_handle.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -107,6 +109,18 @@ struct export_handle
 	 */
 	size_t recovered_export_path_size;
 
+	/* The directory handles of the directories on the current export path
+	 */
+	directory_handle_t **directory_handles;
+
+	/* The number of directory handles
+	 */
+	int number_of_directory_handles;
+
+	/* The number of allocated directory handles
+	 */
+	int number_of_allocated_directory_handles;
+
 	/* The number of items
 	 */
 	int number_of_items;
@@ -131,6 +145,10 @@ struct export_handle
 	 */
 	int number_of_exported_recovered_items;
 
+	/* The profile handle, NULL if the export is not profiled
+	 */
+	profile_handle_t *profile_handle;
+
 	/* Value to indicate if status information
 	 * should be printed to the notify stream
 	 */
@@ -199,6 +217,18 @@ int export_handle_create_recovered_export_path(
      export_handle_t *export_handle,
      libcerror_error_t **error );
 
+int export_handle_close_directory_handles(
+     export_handle_t *export_handle,
+     int number_of_directory_handles,
+     libcerror_error_t **error );
+
+int export_handle_get_directory_handle(
+     export_handle_t *export_handle,
+     const system_character_t *path,
+     size_t path_length,
+     directory_handle_t **directory_handle,
+     libcerror_error_t **error );
+
 /* Item generic export functions
  */
 int export_handle_create_default_item_directory(
@@ -247,17 +277,18 @@ int export_handle_export_record_entry_to_item_file(
      item_file_t *item_file,
      libcerror_error_t **error );
 
-void export_handle_write_record_set_value_to_item_file(
-      item_file_t *item_file,
-      const system_character_t *description,
-      libpff_record_set_t *record_set,
-      uint32_t entry_type,
-      uint32_t value_type,
-      uint32_t format_flags,
-      int (*write_to_item_file_function)(
-             item_file_t *item_file,
-             libpff_record_entry_t *record_entry,
-             libcerror_error_t **error ) );
+int export_handle_record_entry_get_type(
+     libpff_record_entry_t *record_entry,
+     uint32_t *entry_type,
+     uint32_t *value_type,
+     libcerror_error_t **error );
+
+int export_handle_write_record_set_values_to_item_file(
+     item_file_t *item_file,
+     libpff_record_set_t *record_set,
+     mapi_property_definitions_t *property_definitions,
+     int number_of_property_definitions,
+     libcerror_error_t **error );
 
 int export_handle_export_item_values(
      export_handle_t *export_handle,
@@ -461,11 +492,10 @@ int export_handle_export_message_conversation_index_to_item_file(
      libpff_item_t *message,
      libcerror_error_t **error );
 
-int export_handle_export_message_conversation_index_data_to_item_file(
+int export_handle_export_message_conversation_index_record_entry_to_item_file(
      export_handle_t *export_handle,
      item_file_t *item_file,
-     const uint8_t *data,
-     size_t data_size,
+     libpff_record_entry_t *record_entry,
      libcerror_error_t **error );
 
 int export_handle_export_message_transport_headers(
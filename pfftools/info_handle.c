@@ -1019,3 +1019,574 @@ int info_handle_unallocated_blocks_fprint(
 	return( 1 );
 }
 
+/* Prints the allocation statistics to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_allocation_statistics_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error )
+{
+	libpff_allocation_statistics_t *allocation_statistics = NULL;
+	static char *function                                 = "info_handle_allocation_statistics_fprint";
+	size64_t allocated_size                               = 0;
+	size64_t largest_unallocated_extent_size              = 0;
+	size64_t unallocated_size                             = 0;
+	size32_t allocation_unit_size                         = 0;
+	uint64_t number_of_allocated_extents                  = 0;
+	uint64_t number_of_extents                            = 0;
+	uint64_t number_of_unallocated_extents                = 0;
+	uint64_t number_of_unallocated_extents_in_bucket      = 0;
+	int histogram_bucket_index                            = 0;
+	int number_of_histogram_buckets                       = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_file_get_allocation_statistics(
+	     info_handle->input_file,
+	     INFO_HANDLE_NUMBER_OF_THREADS,
+	     &allocation_statistics,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve allocation statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_allocation_statistics_get_allocation_unit_size(
+	     allocation_statistics,
+	     &allocation_unit_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve allocation unit size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_allocation_statistics_get_allocated_size(
+	     allocation_statistics,
+	     &allocated_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve allocated size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_allocation_statistics_get_unallocated_size(
+	     allocation_statistics,
+	     &unallocated_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve unallocated size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_allocation_statistics_get_number_of_allocated_extents(
+	     allocation_statistics,
+	     &number_of_allocated_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of allocated extents.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_allocation_statistics_get_number_of_unallocated_extents(
+	     allocation_statistics,
+	     &number_of_unallocated_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of unallocated extents.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_allocation_statistics_get_largest_unallocated_extent_size(
+	     allocation_statistics,
+	     &largest_unallocated_extent_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve largest unallocated extent size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libpff_allocation_statistics_get_number_of_histogram_buckets(
+	     allocation_statistics,
+	     &number_of_histogram_buckets,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of histogram buckets.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "Allocation statistics:\n" );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tAllocation unit size:\t\t\t%" PRIu32 " bytes\n",
+	 allocation_unit_size );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tAllocated size:\t\t\t\t%" PRIu64 " bytes in %" PRIu64 " extents\n",
+	 allocated_size,
+	 number_of_allocated_extents );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tUnallocated size:\t\t\t%" PRIu64 " bytes in %" PRIu64 " extents\n",
+	 unallocated_size,
+	 number_of_unallocated_extents );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tLargest unallocated extent size:\t%" PRIu64 " bytes\n",
+	 largest_unallocated_extent_size );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\n" );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "Extent sizes:\tallocated\tunallocated\n" );
+
+	for( histogram_bucket_index = 0;
+	     histogram_bucket_index < number_of_histogram_buckets;
+	     histogram_bucket_index++ )
+	{
+		if( libpff_allocation_statistics_get_allocated_extents_histogram_value(
+		     allocation_statistics,
+		     histogram_bucket_index,
+		     &number_of_extents,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve allocated extents histogram value: %d.",
+			 function,
+			 histogram_bucket_index );
+
+			goto on_error;
+		}
+		if( libpff_allocation_statistics_get_unallocated_extents_histogram_value(
+		     allocation_statistics,
+		     histogram_bucket_index,
+		     &number_of_unallocated_extents_in_bucket,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve unallocated extents histogram value: %d.",
+			 function,
+			 histogram_bucket_index );
+
+			goto on_error;
+		}
+		if( ( number_of_extents == 0 )
+		 && ( number_of_unallocated_extents_in_bucket == 0 ) )
+		{
+			continue;
+		}
+		fprintf(
+		 info_handle->notify_stream,
+		 "\t>= %" PRIu64 " bytes:\t%" PRIu64 "\t\t%" PRIu64 "\n",
+		 (uint64_t) allocation_unit_size << histogram_bucket_index,
+		 number_of_extents,
+		 number_of_unallocated_extents_in_bucket );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\n" );
+
+	if( libpff_allocation_statistics_free(
+	     &allocation_statistics,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free allocation statistics.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( allocation_statistics != NULL )
+	{
+		libpff_allocation_statistics_free(
+		 &allocation_statistics,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Prints the block locality of a folder and its sub folders to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_folder_block_locality_fprint(
+     info_handle_t *info_handle,
+     libpff_item_t *folder,
+     int indentation_level,
+     libcerror_error_t **error )
+{
+	libpff_item_t *sub_folder = NULL;
+	uint8_t *name             = NULL;
+	static char *function     = "info_handle_folder_block_locality_fprint";
+	size64_t blocks_size      = 0;
+	size64_t seek_distance    = 0;
+	size64_t span_size        = 0;
+	size_t name_size          = 0;
+	uint32_t identifier       = 0;
+	int indentation_iterator  = 0;
+	int number_of_blocks      = 0;
+	int number_of_sub_folders = 0;
+	int result                = 0;
+	int sub_folder_index      = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libpff_item_get_identifier(
+	     folder,
+	     &identifier,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve identifier.",
+		 function );
+
+		goto on_error;
+	}
+	result = libpff_folder_get_utf8_name_size(
+	          folder,
+	          &name_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve name size.",
+		 function );
+
+		goto on_error;
+	}
+	else if( ( result != 0 )
+	      && ( name_size > 0 ) )
+	{
+		name = (uint8_t *) memory_allocate(
+		                    sizeof( uint8_t ) * name_size );
+
+		if( name == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create name.",
+			 function );
+
+			goto on_error;
+		}
+		if( libpff_folder_get_utf8_name(
+		     folder,
+		     name,
+		     name_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve name.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libpff_folder_get_block_locality(
+	     folder,
+	     &number_of_blocks,
+	     &blocks_size,
+	     &span_size,
+	     &seek_distance,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block locality.",
+		 function );
+
+		goto on_error;
+	}
+	for( indentation_iterator = 0;
+	     indentation_iterator < indentation_level;
+	     indentation_iterator++ )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "\t" );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "%" PRIu32 " %s: %d blocks of %" PRIu64 " bytes spanning %" PRIu64 " bytes, seek distance: %" PRIu64 " bytes\n",
+	 identifier,
+	 ( name != NULL ) ? (char *) name : "",
+	 number_of_blocks,
+	 blocks_size,
+	 span_size,
+	 seek_distance );
+
+	if( name != NULL )
+	{
+		memory_free(
+		 name );
+
+		name = NULL;
+	}
+	if( libpff_folder_get_number_of_sub_folders(
+	     folder,
+	     &number_of_sub_folders,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub folders.",
+		 function );
+
+		goto on_error;
+	}
+	for( sub_folder_index = 0;
+	     sub_folder_index < number_of_sub_folders;
+	     sub_folder_index++ )
+	{
+		if( libpff_folder_get_sub_folder(
+		     folder,
+		     sub_folder_index,
+		     &sub_folder,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub folder: %d.",
+			 function,
+			 sub_folder_index );
+
+			goto on_error;
+		}
+		if( info_handle_folder_block_locality_fprint(
+		     info_handle,
+		     sub_folder,
+		     indentation_level + 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_OUTPUT,
+			 LIBCERROR_OUTPUT_ERROR_GENERIC,
+			 "%s: unable to print sub folder: %d block locality.",
+			 function,
+			 sub_folder_index );
+
+			goto on_error;
+		}
+		if( libpff_item_free(
+		     &sub_folder,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free sub folder: %d.",
+			 function,
+			 sub_folder_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( sub_folder != NULL )
+	{
+		libpff_item_free(
+		 &sub_folder,
+		 NULL );
+	}
+	if( name != NULL )
+	{
+		memory_free(
+		 name );
+	}
+	return( -1 );
+}
+
+/* Prints the block locality of the folders to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_folders_block_locality_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error )
+{
+	libpff_item_t *root_folder = NULL;
+	static char *function      = "info_handle_folders_block_locality_fprint";
+	int result                 = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = libpff_file_get_root_folder(
+	          info_handle->input_file,
+	          &root_folder,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve root folder.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "Folder block locality:\n" );
+
+	if( result == 0 )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "\tN/A\n" );
+	}
+	else
+	{
+		if( info_handle_folder_block_locality_fprint(
+		     info_handle,
+		     root_folder,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_OUTPUT,
+			 LIBCERROR_OUTPUT_ERROR_GENERIC,
+			 "%s: unable to print root folder block locality.",
+			 function );
+
+			goto on_error;
+		}
+		if( libpff_item_free(
+		     &root_folder,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free root folder.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\n" );
+
+	return( 1 );
+
+on_error:
+	if( root_folder != NULL )
+	{
+		libpff_item_free(
+		 &root_folder,
+		 NULL );
+	}
+	return( -1 );
+}
+
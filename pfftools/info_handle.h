@@ -33,6 +33,14 @@
 extern "C" {
 #endif
 
+/* The number of threads used to read the allocation statistics
+ */
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+#define INFO_HANDLE_NUMBER_OF_THREADS	4
+#else
+#define INFO_HANDLE_NUMBER_OF_THREADS	1
+#endif
+
 typedef struct info_handle info_handle_t;
 
 struct info_handle
@@ -98,6 +106,20 @@ int info_handle_unallocated_blocks_fprint(
      info_handle_t *info_handle,
      libcerror_error_t **error );
 
+int info_handle_allocation_statistics_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error );
+
+int info_handle_folder_block_locality_fprint(
+     info_handle_t *info_handle,
+     libpff_item_t *folder,
+     int indentation_level,
+     libcerror_error_t **error );
+
+int info_handle_folders_block_locality_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -27,9 +27,9 @@
 #include <types.h>
 #include <wide_string.h>
 
+#include "directory_handle.h"
 #include "item_file.h"
 #include "pfftools_libcerror.h"
-#include "pfftools_libcfile.h"
 #include "pfftools_libfdatetime.h"
 #include "pfftools_libfguid.h"
 #include "pfftools_libfvalue.h"
@@ -95,19 +95,6 @@ int item_file_initialize(
 
 		goto on_error;
 	}
-	if( libcfile_file_initialize(
-	     &( ( *item_file )->file_handle ),
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file handle.",
-		 function );
-
-		goto on_error;
-	}
 	return( 1 );
 
 on_error:
@@ -144,18 +131,20 @@ int item_file_free(
 	}
 	if( *item_file != NULL )
 	{
-		if( libcfile_file_free(
-		     &( ( *item_file )->file_handle ),
-		     error ) != 1 )
+		if( ( *item_file )->file_stream != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free file handle.",
-			 function );
+			if( file_stream_close(
+			     ( *item_file )->file_stream ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close file stream.",
+				 function );
 
-			result = -1;
+				result = -1;
+			}
 		}
 		memory_free(
 		 *item_file );
@@ -186,25 +175,33 @@ int item_file_open(
 
 		return( -1 );
 	}
+	if( item_file->file_stream != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid item file - file stream value already set.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	if( libcfile_file_open_wide(
-	     item_file->file_handle,
-	     filename,
-	     LIBCFILE_OPEN_WRITE,
-	     error ) != 1 )
+	item_file->file_stream = file_stream_open_wide(
+	                         filename,
+	                         _SYSTEM_STRING( FILE_STREAM_BINARY_OPEN_WRITE ) );
 #else
-	if( libcfile_file_open(
-	     item_file->file_handle,
-	     filename,
-	     LIBCFILE_OPEN_WRITE,
-	     error ) != 1 )
+	item_file->file_stream = file_stream_open(
+	                         filename,
+	                         FILE_STREAM_BINARY_OPEN_WRITE );
 #endif
+	if( item_file->file_stream == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open file handle.",
+		 "%s: unable to open file stream.",
 		 function );
 
 		return( -1 );
@@ -212,6 +209,62 @@ int item_file_open(
 	return( 1 );
 }
 
+/* Opens a new item file in a directory
+ * Returns 1 if successful, 0 if the file already exists or -1 on error
+ */
+int item_file_open_in_directory(
+     item_file_t *item_file,
+     directory_handle_t *directory_handle,
+     const system_character_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	static char *function = "item_file_open_in_directory";
+	int result            = 0;
+
+	if( item_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item file.",
+		 function );
+
+		return( -1 );
+	}
+	if( item_file->file_stream != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid item file - file stream value already set.",
+		 function );
+
+		return( -1 );
+	}
+	result = directory_handle_open_file_stream(
+	          directory_handle,
+	          filename,
+	          filename_length,
+	          &( item_file->file_stream ),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file stream.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
 /* Closes the item file
  * Returns the 0 if succesful or -1 on error
  */
@@ -232,19 +285,33 @@ int item_file_close(
 
 		return( -1 );
 	}
-	if( libcfile_file_close(
-	     item_file->file_handle,
-	     error ) != 0 )
+	if( item_file->file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid item file - missing file stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_stream_close(
+	     item_file->file_stream ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-		 "%s: unable to close file handle.",
+		 "%s: unable to close file stream.",
 		 function );
 
+		item_file->file_stream = NULL;
+
 		return( -1 );
 	}
+	item_file->file_stream = NULL;
+
 	return( 0 );
 }
 
@@ -258,7 +325,7 @@ int item_file_write_buffer(
      libcerror_error_t **error )
 {
 	static char *function = "item_file_write_buffer";
-	ssize_t write_count   = 0;
+	size_t write_count    = 0;
 
 	if( item_file == NULL )
 	{
@@ -293,23 +360,37 @@ int item_file_write_buffer(
 
 		return( -1 );
 	}
-	write_count = libcfile_file_write_buffer(
-		       item_file->file_handle,
+	if( item_file->file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid item file - missing file stream.",
+		 function );
+
+		return( -1 );
+	}
+	write_count = file_stream_write(
+		       item_file->file_stream,
 		       buffer,
-		       buffer_size,
-		       error );
+		       buffer_size );
 
-	if( write_count != (ssize_t) buffer_size )
+	if( write_count != buffer_size )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write buffer to file handle.",
+		 "%s: unable to write buffer to file stream.",
 		 function );
 
 		return( -1 );
 	}
+	if( item_file->output_size != NULL )
+	{
+		*( item_file->output_size ) += (size64_t) write_count;
+	}
 	return( 1 );
 }
 
@@ -2062,6 +2143,82 @@ on_error:
 	return( -1 );
 }
 
+/* Writes a record entry with its description to the item file
+ * Returns 1 if successful or -1 on error
+ */
+int item_file_write_record_entry(
+     item_file_t *item_file,
+     const system_character_t *description,
+     libpff_record_entry_t *record_entry,
+     uint32_t format_flags,
+     int (*write_to_item_file_function)(
+            item_file_t *item_file,
+            libpff_record_entry_t *record_entry,
+            libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	static char *function     = "item_file_write_record_entry";
+	size_t description_length = 0;
+	int result                = 0;
+
+	if( description == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid description.",
+		 function );
+
+		return( -1 );
+	}
+	description_length = system_string_length(
+	                      description );
+
+	if( item_file_write_string(
+	     item_file,
+	     description,
+	     description_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write description string.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_to_item_file_function == NULL )
+	{
+		result = item_file_write_record_entry_value(
+		          item_file,
+		          record_entry,
+		          format_flags,
+		          error );
+	}
+	else
+	{
+		result = write_to_item_file_function(
+		          item_file,
+		          record_entry,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write record entry value.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Writes a specific record set value to the item file
  * Returns 1 if successful, 0 if no such value or -1 on error
  */
@@ -2080,7 +2237,6 @@ int item_file_write_record_set_value(
 {
 	libpff_record_entry_t *record_entry = NULL;
 	static char *function               = "item_file_write_record_set_value";
-	size_t description_length           = 0;
 	uint8_t flags                       = 0;
 	int result                          = 0;
 
@@ -2120,46 +2276,19 @@ int item_file_write_record_set_value(
 	}
 	else if( result != 0 )
 	{
-		description_length = system_string_length(
-		                      description );
-		
-		if( item_file_write_string(
+		if( item_file_write_record_entry(
 		     item_file,
 		     description,
-		     description_length,
+		     record_entry,
+		     format_flags,
+		     write_to_item_file_function,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write description string.",
-			 function );
-
-			goto on_error;
-		}
-		if( write_to_item_file_function == NULL )
-		{
-			result = item_file_write_record_entry_value(
-			          item_file,
-			          record_entry,
-			          format_flags,
-			          error );
-		}
-		else
-		{
-			result = write_to_item_file_function(
-			          item_file,
-			          record_entry,
-			          error );
-		}
-		if( result != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write record entry value.",
+			 "%s: unable to write record entry.",
 			 function );
 
 			goto on_error;
@@ -26,8 +26,8 @@
 #include <file_stream.h>
 #include <types.h>
 
+#include "directory_handle.h"
 #include "pfftools_libcerror.h"
-#include "pfftools_libcfile.h"
 #include "pfftools_libfdatetime.h"
 #include "pfftools_libfguid.h"
 #include "pfftools_libpff.h"
@@ -46,9 +46,13 @@ typedef struct item_file item_file_t;
 
 struct item_file
 {
-	/* The file handle
+	/* The file stream
 	 */
-	libcfile_file_t *file_handle;
+	FILE *file_stream;
+
+	/* The number of bytes written, shared between item files, NULL if not counted
+	 */
+	size64_t *output_size;
 };
 
 int item_file_initialize(
@@ -64,6 +68,13 @@ int item_file_open(
      const system_character_t *filename,
      libcerror_error_t **error );
 
+int item_file_open_in_directory(
+     item_file_t *item_file,
+     directory_handle_t *directory_handle,
+     const system_character_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
 int item_file_close(
      item_file_t *item_file,
      libcerror_error_t **error );
@@ -151,6 +162,17 @@ int item_file_write_record_entry_value(
      uint32_t format_flags,
      libcerror_error_t **error );
 
+int item_file_write_record_entry(
+     item_file_t *item_file,
+     const system_character_t *description,
+     libpff_record_entry_t *record_entry,
+     uint32_t format_flags,
+     int (*write_to_item_file_function)(
+            item_file_t *item_file,
+            libpff_record_entry_t *record_entry,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
 int item_file_write_record_set_value(
      item_file_t *item_file,
      const system_character_t *description,
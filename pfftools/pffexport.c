@@ -46,6 +46,7 @@
 #include "pfftools_output.h"
 #include "pfftools_signal.h"
 #include "pfftools_unused.h"
+#include "profile_handle.h"
 
 export_handle_t *pffexport_export_handle = NULL;
 libpff_file_t *pffexport_file            = NULL;
@@ -64,7 +65,7 @@ void usage_fprint(
 	                 "and PST).\n\n" );
 
 	fprintf( stream, "Usage: pffexport [ -c codepage ] [ -f format ] [ -l logfile ] [ -m mode ]\n"
-	                 "                 [ -t target ] [ -dhqvV ] source\n\n" );
+	                 "                 [ -p profile ] [ -t target ] [ -dhqvV ] source\n\n" );
 
 	fprintf( stream, "\tsource: the source file\n\n" );
 
@@ -83,6 +84,8 @@ void usage_fprint(
 	                 "\t        items. 'debug' exports all the (allocated) items, also those\n"
 	                 "\t        outside the the root folder. 'items' exports the (allocated)\n"
 	                 "\t        items. 'recovered' exports the orphan and recovered items.\n" );
+	fprintf( stream, "\t-p:     writes a profile of the export to the profile file, the profile\n"
+	                 "\t        contains the slowest items and statistics per item type\n" );
 	fprintf( stream, "\t-q:     quiet shows minimal status information\n" );
 	fprintf( stream, "\t-t:     specify the basename of the target directory to export to\n"
 	                 "\t        (default is the source filename) pffexport will add the\n"
@@ -162,12 +165,14 @@ int main( int argc, char * const argv[] )
 {
 	libcerror_error_t *error                           = NULL;
 	log_handle_t *log_handle                           = NULL;
+	profile_handle_t *profile_handle                   = NULL;
 	system_character_t *log_filename                   = NULL;
 	system_character_t *option_ascii_codepage          = NULL;
 	system_character_t *option_export_mode             = NULL;
 	system_character_t *option_preferred_export_format = NULL;
 	system_character_t *option_target_path             = NULL;
 	system_character_t *path_separator                 = NULL;
+	system_character_t *profile_filename               = NULL;
 	system_character_t *source                         = NULL;
 	char *program                                      = "pffexport";
 	system_integer_t option                            = 0;
@@ -210,7 +215,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = pfftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "c:df:hl:m:qt:vV" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "c:df:hl:m:p:qt:vV" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -257,6 +262,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'p':
+				profile_filename = optarg;
+
+				break;
+
 			case (system_integer_t) 'q':
 				print_status_information = 0;
 
@@ -496,6 +506,33 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( profile_filename != NULL )
+	{
+		if( profile_handle_initialize(
+		     &profile_handle,
+		     PROFILE_HANDLE_DEFAULT_NUMBER_OF_TOP_ITEMS,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create profile handle.\n" );
+
+			goto on_error;
+		}
+		if( profile_handle_open(
+		     profile_handle,
+		     profile_filename,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open profile file: %" PRIs_SYSTEM ".\n",
+			 profile_filename );
+
+			goto on_error;
+		}
+		pffexport_export_handle->profile_handle = profile_handle;
+	}
 	if( libpff_file_initialize(
 	     &pffexport_file,
 	     &error ) != 1 )
@@ -552,6 +589,20 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( profile_handle != NULL )
+	{
+		if( profile_handle_set_file(
+		     profile_handle,
+		     pffexport_file,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set file in profile handle.\n" );
+
+			goto on_error;
+		}
+	}
 	if( export_handle_export_file(
 	     pffexport_export_handle,
 	     pffexport_file,
@@ -564,6 +615,41 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( profile_handle != NULL )
+	{
+		pffexport_export_handle->profile_handle = NULL;
+
+		if( profile_handle_write_report(
+		     profile_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to write profile.\n" );
+
+			goto on_error;
+		}
+		if( profile_handle_close(
+		     profile_handle,
+		     &error ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to close profile file.\n" );
+
+			goto on_error;
+		}
+		if( profile_handle_free(
+		     &profile_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free profile handle.\n" );
+
+			goto on_error;
+		}
+	}
 	if( libpff_file_close(
 	     pffexport_file,
 	     &error ) != 0 )
@@ -654,6 +740,24 @@ on_error:
 		 &pffexport_file,
 		 NULL );
 	}
+	if( profile_handle != NULL )
+	{
+		if( pffexport_export_handle != NULL )
+		{
+			pffexport_export_handle->profile_handle = NULL;
+		}
+		/* A profile of an aborted or failed export helps to find the item that caused it
+		 */
+		profile_handle_write_report(
+		 profile_handle,
+		 NULL );
+		profile_handle_close(
+		 profile_handle,
+		 NULL );
+		profile_handle_free(
+		 &profile_handle,
+		 NULL );
+	}
 	if( log_handle != NULL )
 	{
 		log_handle_close(
@@ -325,6 +325,26 @@ int main( int argc, char * const argv[] )
 
 			goto on_error;
 		}
+		if( info_handle_allocation_statistics_fprint(
+		     pffinfo_info_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to print file allocation statistics.\n" );
+
+			goto on_error;
+		}
+		if( info_handle_folders_block_locality_fprint(
+		     pffinfo_info_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to print folder block locality.\n" );
+
+			goto on_error;
+		}
 	}
 /* TODO
 	if( pfftools_signal_detach(
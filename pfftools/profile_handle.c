@@ -0,0 +1,1139 @@
+/*
+ * Profile handle
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if !defined( WINAPI )
+#include <time.h>
+#endif
+
+#include "pfftools_libcerror.h"
+#include "pfftools_libpff.h"
+#include "profile_handle.h"
+
+/* Creates a profile handle
+ * Make sure the value profile_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int profile_handle_initialize(
+     profile_handle_t **profile_handle,
+     int maximum_number_of_top_items,
+     libcerror_error_t **error )
+{
+	static char *function = "profile_handle_initialize";
+
+	if( profile_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid profile handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *profile_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid profile handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_top_items <= 0 )
+	 || ( (size_t) maximum_number_of_top_items > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( profile_item_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of top items value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*profile_handle = memory_allocate_structure(
+	                   profile_handle_t );
+
+	if( *profile_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create profile handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *profile_handle,
+	     0,
+	     sizeof( profile_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear profile handle.",
+		 function );
+
+		memory_free(
+		 *profile_handle );
+
+		*profile_handle = NULL;
+
+		return( -1 );
+	}
+	( *profile_handle )->top_items = (profile_item_t *) memory_allocate(
+	                                                     sizeof( profile_item_t ) * maximum_number_of_top_items );
+
+	if( ( *profile_handle )->top_items == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create top items.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *profile_handle )->top_items,
+	     0,
+	     sizeof( profile_item_t ) * maximum_number_of_top_items ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear top items.",
+		 function );
+
+		goto on_error;
+	}
+	( *profile_handle )->maximum_number_of_top_items = maximum_number_of_top_items;
+
+	return( 1 );
+
+on_error:
+	if( *profile_handle != NULL )
+	{
+		if( ( *profile_handle )->top_items != NULL )
+		{
+			memory_free(
+			 ( *profile_handle )->top_items );
+		}
+		memory_free(
+		 *profile_handle );
+
+		*profile_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a profile handle
+ * Returns 1 if successful or -1 on error
+ */
+int profile_handle_free(
+     profile_handle_t **profile_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "profile_handle_free";
+	int top_item_index    = 0;
+
+	if( profile_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid profile handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *profile_handle != NULL )
+	{
+		for( top_item_index = 0;
+		     top_item_index < ( *profile_handle )->number_of_top_items;
+		     top_item_index++ )
+		{
+			if( ( *profile_handle )->top_items[ top_item_index ].path != NULL )
+			{
+				memory_free(
+				 ( *profile_handle )->top_items[ top_item_index ].path );
+			}
+		}
+		memory_free(
+		 ( *profile_handle )->top_items );
+
+		memory_free(
+		 *profile_handle );
+
+		*profile_handle = NULL;
+	}
+	return( 1 );
+}
+
+/* Opens the profile handle
+ * Returns 1 if successful or -1 on error
+ */
+int profile_handle_open(
+     profile_handle_t *profile_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "profile_handle_open";
+
+	if( profile_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid profile handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( profile_handle->profile_stream != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid profile handle - profile stream value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	profile_handle->profile_stream = file_stream_open_wide(
+	                                  filename,
+	                                  _SYSTEM_STRING( FILE_STREAM_OPEN_WRITE ) );
+#else
+	profile_handle->profile_stream = file_stream_open(
+	                                  filename,
+	                                  FILE_STREAM_OPEN_WRITE );
+#endif
+	if( profile_handle->profile_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Closes the profile handle
+ * Returns the 0 if succesful or -1 on error
+ */
+int profile_handle_close(
+     profile_handle_t *profile_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "profile_handle_close";
+
+	if( profile_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid profile handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( profile_handle->profile_stream != NULL )
+	{
+		if( file_stream_close(
+		     profile_handle->profile_stream ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close profile stream.",
+			 function );
+
+			profile_handle->profile_stream = NULL;
+
+			return( -1 );
+		}
+		profile_handle->profile_stream = NULL;
+	}
+	return( 0 );
+}
+
+/* Sets the file of which the read statistics are measured
+ * Returns 1 if successful or -1 on error
+ */
+int profile_handle_set_file(
+     profile_handle_t *profile_handle,
+     libpff_file_t *file,
+     libcerror_error_t **error )
+{
+	static char *function = "profile_handle_set_file";
+
+	if( profile_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid profile handle.",
+		 function );
+
+		return( -1 );
+	}
+	profile_handle->file = file;
+
+	return( 1 );
+}
+
+/* Retrieves the current time of a monotonic clock in microseconds
+ * Falls back to the system time if no monotonic clock is available
+ * Returns 1 if successful or -1 on error
+ */
+int profile_handle_get_current_time(
+     int64_t *current_time,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+#elif defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	struct timespec time_structure;
+#else
+	time_t timestamp      = 0;
+#endif
+
+	static char *function = "profile_handle_get_current_time";
+
+	if( current_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid current time.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( frequency.QuadPart <= 0 )
+	 || ( QueryPerformanceCounter(
+	       &counter ) == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		return( -1 );
+	}
+	/* Split the conversion to prevent the counter from overflowing
+	 */
+	*current_time = ( ( counter.QuadPart / frequency.QuadPart ) * 1000000 )
+	              + ( ( ( counter.QuadPart % frequency.QuadPart ) * 1000000 ) / frequency.QuadPart );
+
+#elif defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_structure ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		return( -1 );
+	}
+	*current_time = ( (int64_t) time_structure.tv_sec * 1000000 )
+	              + ( (int64_t) time_structure.tv_nsec / 1000 );
+#else
+	timestamp = time(
+	             NULL );
+
+	if( timestamp == (time_t) -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		return( -1 );
+	}
+	*current_time = (int64_t) timestamp * 1000000;
+#endif
+	return( 1 );
+}
+
+/* Retrieves the current values
+ * The read values are only available if the file is set
+ * Returns 1 if successful or -1 on error
+ */
+int profile_handle_get_values(
+     profile_handle_t *profile_handle,
+     profile_values_t *values,
+     libcerror_error_t **error )
+{
+	static char *function = "profile_handle_get_values";
+
+	if( profile_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid profile handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid values.",
+		 function );
+
+		return( -1 );
+	}
+	if( profile_handle_get_current_time(
+	     &( values->elapsed_time ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		return( -1 );
+	}
+	values->read_size                     = 0;
+	values->number_of_read_blocks         = 0;
+	values->number_of_decompressed_blocks = 0;
+	values->output_size                   = profile_handle->output_size;
+
+	if( profile_handle->file != NULL )
+	{
+		if( libpff_file_get_read_statistics(
+		     profile_handle->file,
+		     &( values->read_size ),
+		     &( values->number_of_read_blocks ),
+		     &( values->number_of_decompressed_blocks ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve read statistics.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Starts a measurement
+ * The measurement becomes the current measurement until it is stopped
+ * Returns 1 if successful or -1 on error
+ */
+int profile_handle_start_measurement(
+     profile_handle_t *profile_handle,
+     profile_measurement_t *measurement,
+     libcerror_error_t **error )
+{
+	static char *function = "profile_handle_start_measurement";
+
+	if( profile_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid profile handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( measurement == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid measurement.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     measurement,
+	     0,
+	     sizeof( profile_measurement_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear measurement.",
+		 function );
+
+		return( -1 );
+	}
+	if( profile_handle_get_values(
+	     profile_handle,
+	     &( measurement->start_values ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start values.",
+		 function );
+
+		return( -1 );
+	}
+	measurement->parent_measurement     = profile_handle->current_measurement;
+	profile_handle->current_measurement = measurement;
+
+	return( 1 );
+}
+
+/* Stops a measurement and adds the item to the profile
+ * The values of the measurement are added to those of nested values of the enclosing measurement
+ * Returns 1 if successful or -1 on error
+ */
+int profile_handle_stop_measurement(
+     profile_handle_t *profile_handle,
+     profile_measurement_t *measurement,
+     uint32_t identifier,
+     uint8_t item_type,
+     const system_character_t *path,
+     size_t path_length,
+     libcerror_error_t **error )
+{
+	profile_values_t item_values;
+	profile_values_t stop_values;
+
+	static char *function = "profile_handle_stop_measurement";
+
+	if( profile_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid profile handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( measurement == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid measurement.",
+		 function );
+
+		return( -1 );
+	}
+	if( profile_handle->current_measurement != measurement )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid measurement value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The measurement is always removed so that an error does not leave
+	 * a reference to it behind
+	 */
+	profile_handle->current_measurement = measurement->parent_measurement;
+
+	if( profile_handle_get_values(
+	     profile_handle,
+	     &stop_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve stop values.",
+		 function );
+
+		return( -1 );
+	}
+	stop_values.elapsed_time                  -= measurement->start_values.elapsed_time;
+	stop_values.read_size                     -= measurement->start_values.read_size;
+	stop_values.number_of_read_blocks         -= measurement->start_values.number_of_read_blocks;
+	stop_values.number_of_decompressed_blocks -= measurement->start_values.number_of_decompressed_blocks;
+	stop_values.output_size                   -= measurement->start_values.output_size;
+
+	if( measurement->parent_measurement != NULL )
+	{
+		measurement->parent_measurement->nested_values.elapsed_time                  += stop_values.elapsed_time;
+		measurement->parent_measurement->nested_values.read_size                     += stop_values.read_size;
+		measurement->parent_measurement->nested_values.number_of_read_blocks         += stop_values.number_of_read_blocks;
+		measurement->parent_measurement->nested_values.number_of_decompressed_blocks += stop_values.number_of_decompressed_blocks;
+		measurement->parent_measurement->nested_values.output_size                   += stop_values.output_size;
+	}
+	item_values.elapsed_time = 0;
+
+	if( stop_values.elapsed_time > measurement->nested_values.elapsed_time )
+	{
+		item_values.elapsed_time = stop_values.elapsed_time - measurement->nested_values.elapsed_time;
+	}
+	item_values.read_size = 0;
+
+	if( stop_values.read_size > measurement->nested_values.read_size )
+	{
+		item_values.read_size = stop_values.read_size - measurement->nested_values.read_size;
+	}
+	item_values.number_of_read_blocks = 0;
+
+	if( stop_values.number_of_read_blocks > measurement->nested_values.number_of_read_blocks )
+	{
+		item_values.number_of_read_blocks = stop_values.number_of_read_blocks - measurement->nested_values.number_of_read_blocks;
+	}
+	item_values.number_of_decompressed_blocks = 0;
+
+	if( stop_values.number_of_decompressed_blocks > measurement->nested_values.number_of_decompressed_blocks )
+	{
+		item_values.number_of_decompressed_blocks = stop_values.number_of_decompressed_blocks - measurement->nested_values.number_of_decompressed_blocks;
+	}
+	item_values.output_size = 0;
+
+	if( stop_values.output_size > measurement->nested_values.output_size )
+	{
+		item_values.output_size = stop_values.output_size - measurement->nested_values.output_size;
+	}
+	if( profile_handle_add_item(
+	     profile_handle,
+	     identifier,
+	     item_type,
+	     path,
+	     path_length,
+	     &item_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to add item.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Adds an item to the profile
+ * Returns 1 if successful or -1 on error
+ */
+int profile_handle_add_item(
+     profile_handle_t *profile_handle,
+     uint32_t identifier,
+     uint8_t item_type,
+     const system_character_t *path,
+     size_t path_length,
+     const profile_values_t *values,
+     libcerror_error_t **error )
+{
+	profile_item_t top_item;
+
+	profile_item_type_statistics_t *item_type_statistics = NULL;
+	system_character_t *item_path                        = NULL;
+	static char *function                                = "profile_handle_add_item";
+	int64_t elapsed_time_in_milliseconds                 = 0;
+	int time_bucket_index                                = 0;
+	int top_item_index                                   = 0;
+
+	if( profile_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid profile handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( path == NULL )
+	 && ( path_length != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_length > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE - 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid path length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid values.",
+		 function );
+
+		return( -1 );
+	}
+	if( item_type >= PROFILE_HANDLE_NUMBER_OF_ITEM_TYPES )
+	{
+		item_type = LIBPFF_ITEM_TYPE_UNKNOWN;
+	}
+	item_type_statistics = &( profile_handle->item_type_statistics[ item_type ] );
+
+	item_type_statistics->number_of_items                            += 1;
+	item_type_statistics->total_values.elapsed_time                  += values->elapsed_time;
+	item_type_statistics->total_values.read_size                     += values->read_size;
+	item_type_statistics->total_values.number_of_read_blocks         += values->number_of_read_blocks;
+	item_type_statistics->total_values.number_of_decompressed_blocks += values->number_of_decompressed_blocks;
+	item_type_statistics->total_values.output_size                   += values->output_size;
+
+	if( values->elapsed_time > item_type_statistics->maximum_elapsed_time )
+	{
+		item_type_statistics->maximum_elapsed_time = values->elapsed_time;
+	}
+	elapsed_time_in_milliseconds = values->elapsed_time / 1000;
+
+	while( ( elapsed_time_in_milliseconds > 0 )
+	    && ( time_bucket_index < ( PROFILE_HANDLE_NUMBER_OF_TIME_BUCKETS - 1 ) ) )
+	{
+		elapsed_time_in_milliseconds >>= 1;
+
+		time_bucket_index++;
+	}
+	item_type_statistics->time_histogram[ time_bucket_index ] += 1;
+
+	/* Only items slower than the fastest of the slowest items are retained
+	 */
+	top_item_index = profile_handle->number_of_top_items;
+
+	if( top_item_index >= profile_handle->maximum_number_of_top_items )
+	{
+		top_item_index = profile_handle->maximum_number_of_top_items - 1;
+
+		if( values->elapsed_time <= profile_handle->top_items[ top_item_index ].values.elapsed_time )
+		{
+			return( 1 );
+		}
+	}
+	item_path = system_string_allocate(
+	             path_length + 1 );
+
+	if( item_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create item path.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_length > 0 )
+	{
+		if( system_string_copy(
+		     item_path,
+		     path,
+		     path_length ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy item path.",
+			 function );
+
+			memory_free(
+			 item_path );
+
+			return( -1 );
+		}
+	}
+	item_path[ path_length ] = 0;
+
+	if( top_item_index < profile_handle->number_of_top_items )
+	{
+		memory_free(
+		 profile_handle->top_items[ top_item_index ].path );
+	}
+	else
+	{
+		profile_handle->number_of_top_items += 1;
+	}
+	top_item.identifier = identifier;
+	top_item.item_type  = item_type;
+	top_item.path       = item_path;
+	top_item.values     = *values;
+
+	while( top_item_index > 0 )
+	{
+		if( values->elapsed_time <= profile_handle->top_items[ top_item_index - 1 ].values.elapsed_time )
+		{
+			break;
+		}
+		profile_handle->top_items[ top_item_index ] = profile_handle->top_items[ top_item_index - 1 ];
+
+		top_item_index--;
+	}
+	profile_handle->top_items[ top_item_index ] = top_item;
+
+	return( 1 );
+}
+
+/* Retrieves a string representation of an item type
+ * Returns the string
+ */
+const char *profile_handle_get_item_type_string(
+             uint8_t item_type )
+{
+	switch( item_type )
+	{
+		case LIBPFF_ITEM_TYPE_ACTIVITY:
+			return( "activity" );
+
+		case LIBPFF_ITEM_TYPE_APPOINTMENT:
+			return( "appointment" );
+
+		case LIBPFF_ITEM_TYPE_ATTACHMENT:
+			return( "attachment" );
+
+		case LIBPFF_ITEM_TYPE_ATTACHMENTS:
+			return( "attachments" );
+
+		case LIBPFF_ITEM_TYPE_COMMON:
+			return( "common" );
+
+		case LIBPFF_ITEM_TYPE_CONFIGURATION:
+			return( "configuration" );
+
+		case LIBPFF_ITEM_TYPE_CONFLICT_MESSAGE:
+			return( "conflict message" );
+
+		case LIBPFF_ITEM_TYPE_CONTACT:
+			return( "contact" );
+
+		case LIBPFF_ITEM_TYPE_DISTRIBUTION_LIST:
+			return( "distribution list" );
+
+		case LIBPFF_ITEM_TYPE_DOCUMENT:
+			return( "document" );
+
+		case LIBPFF_ITEM_TYPE_EMAIL:
+			return( "email" );
+
+		case LIBPFF_ITEM_TYPE_EMAIL_SMIME:
+			return( "email (S/MIME)" );
+
+		case LIBPFF_ITEM_TYPE_FAX:
+			return( "fax" );
+
+		case LIBPFF_ITEM_TYPE_FOLDER:
+			return( "folder" );
+
+		case LIBPFF_ITEM_TYPE_MEETING:
+			return( "meeting" );
+
+		case LIBPFF_ITEM_TYPE_MMS:
+			return( "MMS" );
+
+		case LIBPFF_ITEM_TYPE_NOTE:
+			return( "note" );
+
+		case LIBPFF_ITEM_TYPE_POSTING_NOTE:
+			return( "posting note" );
+
+		case LIBPFF_ITEM_TYPE_RECIPIENTS:
+			return( "recipients" );
+
+		case LIBPFF_ITEM_TYPE_RSS_FEED:
+			return( "RSS feed" );
+
+		case LIBPFF_ITEM_TYPE_SHARING:
+			return( "sharing" );
+
+		case LIBPFF_ITEM_TYPE_SMS:
+			return( "SMS" );
+
+		case LIBPFF_ITEM_TYPE_SUB_ASSOCIATED_CONTENTS:
+			return( "sub associated contents" );
+
+		case LIBPFF_ITEM_TYPE_SUB_FOLDERS:
+			return( "sub folders" );
+
+		case LIBPFF_ITEM_TYPE_SUB_MESSAGES:
+			return( "sub messages" );
+
+		case LIBPFF_ITEM_TYPE_TASK:
+			return( "task" );
+
+		case LIBPFF_ITEM_TYPE_TASK_REQUEST:
+			return( "task request" );
+
+		case LIBPFF_ITEM_TYPE_VOICEMAIL:
+			return( "voicemail" );
+
+		default:
+			break;
+	}
+	return( "unknown" );
+}
+
+/* Writes the profile report to the profile stream
+ * The report contains the slowest items followed by the statistics per item type
+ * Returns 1 if successful or -1 on error
+ */
+int profile_handle_write_report(
+     profile_handle_t *profile_handle,
+     libcerror_error_t **error )
+{
+	profile_item_t *top_item                             = NULL;
+	profile_item_type_statistics_t *item_type_statistics = NULL;
+	static char *function                                = "profile_handle_write_report";
+	int time_bucket_index                                = 0;
+	int top_item_index                                   = 0;
+	uint8_t item_type                                    = 0;
+
+	if( profile_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid profile handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( profile_handle->profile_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid profile handle - missing profile stream.",
+		 function );
+
+		return( -1 );
+	}
+	/* The time and sizes are those of the item itself, excluding sub folders and attached items
+	 */
+	fprintf(
+	 profile_handle->profile_stream,
+	 "Slowest items:\n" );
+
+	fprintf(
+	 profile_handle->profile_stream,
+	 "Rank\tTime (ms)\tBytes read\tBlocks read\tBlocks decompressed\tBytes written\tIdentifier\tType\tPath\n" );
+
+	for( top_item_index = 0;
+	     top_item_index < profile_handle->number_of_top_items;
+	     top_item_index++ )
+	{
+		top_item = &( profile_handle->top_items[ top_item_index ] );
+
+		fprintf(
+		 profile_handle->profile_stream,
+		 "%d\t%" PRIi64 ".%03" PRIi64 "\t%" PRIu64 "\t%" PRIu64 "\t%" PRIu64 "\t%" PRIu64 "\t%" PRIu32 "\t%s\t%" PRIs_SYSTEM "\n",
+		 top_item_index + 1,
+		 top_item->values.elapsed_time / 1000,
+		 top_item->values.elapsed_time % 1000,
+		 top_item->values.read_size,
+		 top_item->values.number_of_read_blocks,
+		 top_item->values.number_of_decompressed_blocks,
+		 top_item->values.output_size,
+		 top_item->identifier,
+		 profile_handle_get_item_type_string(
+		  top_item->item_type ),
+		 top_item->path );
+	}
+	fprintf(
+	 profile_handle->profile_stream,
+	 "\n" );
+
+	for( item_type = 0;
+	     item_type < PROFILE_HANDLE_NUMBER_OF_ITEM_TYPES;
+	     item_type++ )
+	{
+		item_type_statistics = &( profile_handle->item_type_statistics[ item_type ] );
+
+		if( item_type_statistics->number_of_items == 0 )
+		{
+			continue;
+		}
+		fprintf(
+		 profile_handle->profile_stream,
+		 "Item type: %s\n",
+		 profile_handle_get_item_type_string(
+		  item_type ) );
+
+		fprintf(
+		 profile_handle->profile_stream,
+		 "\tNumber of items\t\t: %" PRIu64 "\n",
+		 item_type_statistics->number_of_items );
+
+		fprintf(
+		 profile_handle->profile_stream,
+		 "\tTotal time\t\t: %" PRIi64 ".%03" PRIi64 " ms\n",
+		 item_type_statistics->total_values.elapsed_time / 1000,
+		 item_type_statistics->total_values.elapsed_time % 1000 );
+
+		fprintf(
+		 profile_handle->profile_stream,
+		 "\tMaximum time\t\t: %" PRIi64 ".%03" PRIi64 " ms\n",
+		 item_type_statistics->maximum_elapsed_time / 1000,
+		 item_type_statistics->maximum_elapsed_time % 1000 );
+
+		fprintf(
+		 profile_handle->profile_stream,
+		 "\tBytes read\t\t: %" PRIu64 "\n",
+		 item_type_statistics->total_values.read_size );
+
+		fprintf(
+		 profile_handle->profile_stream,
+		 "\tBlocks read\t\t: %" PRIu64 "\n",
+		 item_type_statistics->total_values.number_of_read_blocks );
+
+		fprintf(
+		 profile_handle->profile_stream,
+		 "\tBlocks decompressed\t: %" PRIu64 "\n",
+		 item_type_statistics->total_values.number_of_decompressed_blocks );
+
+		fprintf(
+		 profile_handle->profile_stream,
+		 "\tBytes written\t\t: %" PRIu64 "\n",
+		 item_type_statistics->total_values.output_size );
+
+		fprintf(
+		 profile_handle->profile_stream,
+		 "\tTime histogram:\n" );
+
+		for( time_bucket_index = 0;
+		     time_bucket_index < PROFILE_HANDLE_NUMBER_OF_TIME_BUCKETS;
+		     time_bucket_index++ )
+		{
+			if( item_type_statistics->time_histogram[ time_bucket_index ] == 0 )
+			{
+				continue;
+			}
+			if( time_bucket_index == 0 )
+			{
+				fprintf(
+				 profile_handle->profile_stream,
+				 "\t\t< 1 ms\t\t: %" PRIu64 "\n",
+				 item_type_statistics->time_histogram[ time_bucket_index ] );
+			}
+			else if( time_bucket_index == ( PROFILE_HANDLE_NUMBER_OF_TIME_BUCKETS - 1 ) )
+			{
+				fprintf(
+				 profile_handle->profile_stream,
+				 "\t\t>= %d ms\t: %" PRIu64 "\n",
+				 1 << ( time_bucket_index - 1 ),
+				 item_type_statistics->time_histogram[ time_bucket_index ] );
+			}
+			else
+			{
+				fprintf(
+				 profile_handle->profile_stream,
+				 "\t\t%d - %d ms\t: %" PRIu64 "\n",
+				 1 << ( time_bucket_index - 1 ),
+				 1 << time_bucket_index,
+				 item_type_statistics->time_histogram[ time_bucket_index ] );
+			}
+		}
+		fprintf(
+		 profile_handle->profile_stream,
+		 "\n" );
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,243 @@
+/*
+ * Profile handle
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _PROFILE_HANDLE_H )
+#define _PROFILE_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "pfftools_libcerror.h"
+#include "pfftools_libpff.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The default number of slowest items in the report
+ */
+#define PROFILE_HANDLE_DEFAULT_NUMBER_OF_TOP_ITEMS		32
+
+/* The number of item types, LIBPFF_ITEM_TYPE_UNKNOWN is the last item type
+ */
+#define PROFILE_HANDLE_NUMBER_OF_ITEM_TYPES			( LIBPFF_ITEM_TYPE_UNKNOWN + 1 )
+
+/* The number of elapsed time histogram buckets
+ * The first bucket contains the items that took less than 1 millisecond,
+ * bucket N those that took 2^(N-1) up to 2^N milliseconds and the last bucket
+ * those that took longer
+ */
+#define PROFILE_HANDLE_NUMBER_OF_TIME_BUCKETS			16
+
+typedef struct profile_values profile_values_t;
+
+struct profile_values
+{
+	/* The elapsed time in microseconds
+	 */
+	int64_t elapsed_time;
+
+	/* The number of bytes read
+	 */
+	size64_t read_size;
+
+	/* The number of blocks read
+	 */
+	uint64_t number_of_read_blocks;
+
+	/* The number of blocks decompressed
+	 */
+	uint64_t number_of_decompressed_blocks;
+
+	/* The number of bytes written
+	 */
+	size64_t output_size;
+};
+
+typedef struct profile_measurement profile_measurement_t;
+
+/* A measurement covers the export of a single item, the values of the
+ * measurements of nested items, such as sub folders and attached items,
+ * are subtracted from those of the item itself
+ */
+struct profile_measurement
+{
+	/* The enclosing measurement
+	 */
+	profile_measurement_t *parent_measurement;
+
+	/* The values at the start of the measurement
+	 */
+	profile_values_t start_values;
+
+	/* The values of the nested measurements
+	 */
+	profile_values_t nested_values;
+};
+
+typedef struct profile_item profile_item_t;
+
+struct profile_item
+{
+	/* The (descriptor) identifier
+	 */
+	uint32_t identifier;
+
+	/* The item type
+	 */
+	uint8_t item_type;
+
+	/* The export path
+	 */
+	system_character_t *path;
+
+	/* The values
+	 */
+	profile_values_t values;
+};
+
+typedef struct profile_item_type_statistics profile_item_type_statistics_t;
+
+struct profile_item_type_statistics
+{
+	/* The number of items
+	 */
+	uint64_t number_of_items;
+
+	/* The total values
+	 */
+	profile_values_t total_values;
+
+	/* The maximum elapsed time in microseconds
+	 */
+	int64_t maximum_elapsed_time;
+
+	/* The elapsed time histogram
+	 */
+	uint64_t time_histogram[ PROFILE_HANDLE_NUMBER_OF_TIME_BUCKETS ];
+};
+
+typedef struct profile_handle profile_handle_t;
+
+struct profile_handle
+{
+	/* The profile stream
+	 */
+	FILE *profile_stream;
+
+	/* The file
+	 */
+	libpff_file_t *file;
+
+	/* The current measurement
+	 */
+	profile_measurement_t *current_measurement;
+
+	/* The number of bytes written by the item files
+	 */
+	size64_t output_size;
+
+	/* The slowest items, sorted by elapsed time
+	 */
+	profile_item_t *top_items;
+
+	/* The number of slowest items
+	 */
+	int number_of_top_items;
+
+	/* The maximum number of slowest items
+	 */
+	int maximum_number_of_top_items;
+
+	/* The statistics per item type
+	 */
+	profile_item_type_statistics_t item_type_statistics[ PROFILE_HANDLE_NUMBER_OF_ITEM_TYPES ];
+};
+
+int profile_handle_initialize(
+     profile_handle_t **profile_handle,
+     int maximum_number_of_top_items,
+     libcerror_error_t **error );
+
+int profile_handle_free(
+     profile_handle_t **profile_handle,
+     libcerror_error_t **error );
+
+int profile_handle_open(
+     profile_handle_t *profile_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int profile_handle_close(
+     profile_handle_t *profile_handle,
+     libcerror_error_t **error );
+
+int profile_handle_set_file(
+     profile_handle_t *profile_handle,
+     libpff_file_t *file,
+     libcerror_error_t **error );
+
+int profile_handle_get_current_time(
+     int64_t *current_time,
+     libcerror_error_t **error );
+
+int profile_handle_get_values(
+     profile_handle_t *profile_handle,
+     profile_values_t *values,
+     libcerror_error_t **error );
+
+int profile_handle_start_measurement(
+     profile_handle_t *profile_handle,
+     profile_measurement_t *measurement,
+     libcerror_error_t **error );
+
+int profile_handle_stop_measurement(
+     profile_handle_t *profile_handle,
+     profile_measurement_t *measurement,
+     uint32_t identifier,
+     uint8_t item_type,
+     const system_character_t *path,
+     size_t path_length,
+     libcerror_error_t **error );
+
+int profile_handle_add_item(
+     profile_handle_t *profile_handle,
+     uint32_t identifier,
+     uint8_t item_type,
+     const system_character_t *path,
+     size_t path_length,
+     const profile_values_t *values,
+     libcerror_error_t **error );
+
+const char *profile_handle_get_item_type_string(
+             uint8_t item_type );
+
+int profile_handle_write_report(
+     profile_handle_t *profile_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _PROFILE_HANDLE_H ) */
+
@@ -34,11 +34,13 @@
 #include "pypff_file_object_io_handle.h"
 #include "pypff_folder.h"
 #include "pypff_item.h"
+#include "pypff_item_reference.h"
 #include "pypff_items.h"
 #include "pypff_libbfio.h"
 #include "pypff_libcerror.h"
 #include "pypff_libpff.h"
 #include "pypff_message.h"
+#include "pypff_property_set.h"
 #include "pypff_python.h"
 #include "pypff_record_entries.h"
 #include "pypff_record_entry.h"
@@ -93,6 +95,13 @@ PyMethodDef pypff_module_methods[] = {
 	  "\n"
 	  "Opens a file using a file-like object." },
 
+	{ "clear_file_cache",
+	  (PyCFunction) pypff_item_reference_clear_file_cache,
+	  METH_NOARGS,
+	  "clear_file_cache() -> None\n"
+	  "\n"
+	  "Clears the files kept open by this process to retrieve referenced items." },
+
 	/* Sentinel */
 	{ NULL, NULL, 0, NULL }
 };
@@ -670,6 +679,23 @@ PyMODINIT_FUNC initpypff(
 	 "item",
 	 (PyObject *) &pypff_item_type_object );
 
+	/* Setup the item_reference type object
+	 */
+	pypff_item_reference_type_object.tp_new = PyType_GenericNew;
+
+	if( PyType_Ready(
+	     &pypff_item_reference_type_object ) < 0 )
+	{
+		goto on_error;
+	}
+	Py_IncRef(
+	 (PyObject *) &pypff_item_reference_type_object );
+
+	PyModule_AddObject(
+	 module,
+	 "item_reference",
+	 (PyObject *) &pypff_item_reference_type_object );
+
 	/* Setup the items type object
 	 */
 	pypff_items_type_object.tp_new = PyType_GenericNew;
@@ -704,6 +730,23 @@ PyMODINIT_FUNC initpypff(
 	 "message",
 	 (PyObject *) &pypff_message_type_object );
 
+	/* Setup the property_set type object
+	 */
+	pypff_property_set_type_object.tp_new = PyType_GenericNew;
+
+	if( PyType_Ready(
+	     &pypff_property_set_type_object ) < 0 )
+	{
+		goto on_error;
+	}
+	Py_IncRef(
+	 (PyObject *) &pypff_property_set_type_object );
+
+	PyModule_AddObject(
+	 module,
+	 "property_set",
+	 (PyObject *) &pypff_property_set_type_object );
+
 	/* Setup the record_entries type object
 	 */
 	pypff_record_entries_type_object.tp_new = PyType_GenericNew;
@@ -35,12 +35,14 @@
 #include "pypff_folder.h"
 #include "pypff_integer.h"
 #include "pypff_item.h"
+#include "pypff_item_reference.h"
 #include "pypff_items.h"
 #include "pypff_libbfio.h"
 #include "pypff_libcerror.h"
 #include "pypff_libclocale.h"
 #include "pypff_libpff.h"
 #include "pypff_message.h"
+#include "pypff_property_set.h"
 #include "pypff_python.h"
 #include "pypff_unused.h"
 
@@ -163,6 +165,34 @@ PyMethodDef pypff_file_object_methods[] = {
 	  "\n"
 	  "Retrieves the orphan item specified by the index." },
 
+	{ "get_number_of_recovered_items",
+	  (PyCFunction) pypff_file_get_number_of_recovered_items,
+	  METH_NOARGS,
+	  "get_number_of_recovered_items() -> Integer or None\n"
+	  "\n"
+	  "Retrieves the number of recovered items." },
+
+	{ "get_recovered_item",
+	  (PyCFunction) pypff_file_get_recovered_item,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "get_recovered_item(recovered_item_index) -> Object or None\n"
+	  "\n"
+	  "Retrieves the recovered item specified by the index." },
+
+	{ "get_item_by_identifier",
+	  (PyCFunction) pypff_file_get_item_by_identifier,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "get_item_by_identifier(identifier) -> Object or None\n"
+	  "\n"
+	  "Retrieves the item specified by the (descriptor) identifier." },
+
+	{ "prepare_property_set",
+	  (PyCFunction) pypff_file_prepare_property_set,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "prepare_property_set(property_set) -> None\n"
+	  "\n"
+	  "Prepares a property set against the name to ID map of the file." },
+
 	/* Sentinel */
 	{ NULL, NULL, 0, NULL }
 };
@@ -229,6 +259,18 @@ PyGetSetDef pypff_file_object_get_set_definitions[] = {
 	  "The orphan items.",
 	  NULL },
 
+	{ "number_of_recovered_items",
+	  (getter) pypff_file_get_number_of_recovered_items,
+	  (setter) 0,
+	  "The number of recovered items.",
+	  NULL },
+
+	{ "recovered_items",
+	  (getter) pypff_file_get_recovered_items,
+	  (setter) 0,
+	  "The recovered items.",
+	  NULL },
+
 	/* Sentinel */
 	{ NULL, NULL, NULL, NULL, NULL }
 };
@@ -348,6 +390,7 @@ int pypff_file_init(
 	}
 	pypff_file->file           = NULL;
 	pypff_file->file_io_handle = NULL;
+	pypff_file->filename       = NULL;
 
 	if( libpff_file_initialize(
 	     &( pypff_file->file ),
@@ -416,6 +459,11 @@ void pypff_file_free(
 			return;
 		}
 	}
+	if( pypff_file->filename != NULL )
+	{
+		Py_DecRef(
+		 pypff_file->filename );
+	}
 	if( pypff_file->file != NULL )
 	{
 		Py_BEGIN_ALLOW_THREADS
@@ -625,6 +673,13 @@ PyObject *pypff_file_open(
 
 			return( NULL );
 		}
+		/* Keep the filename so items can be referenced by path
+		 */
+		pypff_file->filename = string_object;
+
+		Py_IncRef(
+		 pypff_file->filename );
+
 		Py_IncRef(
 		 Py_None );
 
@@ -684,6 +739,11 @@ PyObject *pypff_file_open(
 
 			return( NULL );
 		}
+		pypff_file->filename = string_object;
+
+		Py_IncRef(
+		 pypff_file->filename );
+
 		Py_IncRef(
 		 Py_None );
 
@@ -903,6 +963,13 @@ PyObject *pypff_file_close(
 			return( NULL );
 		}
 	}
+	if( pypff_file->filename != NULL )
+	{
+		Py_DecRef(
+		 pypff_file->filename );
+
+		pypff_file->filename = NULL;
+	}
 	Py_IncRef(
 	 Py_None );
 
@@ -1819,6 +1886,208 @@ on_error:
 	return( NULL );
 }
 
+/* Retrieves a specific item by identifier
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pypff_file_get_item_object_by_identifier(
+           PyObject *pypff_file,
+           uint32_t item_identifier )
+{
+	PyObject *item_object     = NULL;
+	PyTypeObject *type_object = NULL;
+	libcerror_error_t *error  = NULL;
+	libpff_item_t *item       = NULL;
+	static char *function     = "pypff_file_get_item_object_by_identifier";
+	int result                = 0;
+
+	if( pypff_file == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid file.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libpff_file_get_item_by_identifier(
+	          ( (pypff_file_t *) pypff_file )->file,
+	          item_identifier,
+	          &item,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result == -1 )
+	{
+		pypff_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve item: %" PRIu32 ".",
+		 function,
+		 item_identifier );
+
+		libcerror_error_free(
+		 &error );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		Py_IncRef(
+		 Py_None );
+
+		return( Py_None );
+	}
+	type_object = pypff_file_get_item_type_object(
+	               item );
+
+	if( type_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_IOError,
+		 "%s: unable to retrieve item type object.",
+		 function );
+
+		goto on_error;
+	}
+	item_object = pypff_item_new(
+	               type_object,
+	               item,
+	               (PyObject *) pypff_file );
+
+	if( item_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create item object.",
+		 function );
+
+		goto on_error;
+	}
+	return( item_object );
+
+on_error:
+	if( item != NULL )
+	{
+		libpff_item_free(
+		 &item,
+		 NULL );
+	}
+	return( NULL );
+}
+
+/* Retrieves a specific item by identifier
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pypff_file_get_item_by_identifier(
+           pypff_file_t *pypff_file,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	PyObject *item_object         = NULL;
+	static char *keyword_list[]   = { "identifier", NULL };
+	unsigned long item_identifier = 0;
+
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "k",
+	     keyword_list,
+	     &item_identifier ) == 0 )
+	{
+		return( NULL );
+	}
+	item_object = pypff_file_get_item_object_by_identifier(
+	               (PyObject *) pypff_file,
+	               (uint32_t) item_identifier );
+
+	return( item_object );
+}
+
+/* Prepares a property set against the name to ID map of the file
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pypff_file_prepare_property_set(
+           pypff_file_t *pypff_file,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	PyObject *property_set_object = NULL;
+	libcerror_error_t *error      = NULL;
+	static char *function         = "pypff_file_prepare_property_set";
+	static char *keyword_list[]   = { "property_set", NULL };
+	int result                    = 0;
+
+	if( pypff_file == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid file.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "O",
+	     keyword_list,
+	     &property_set_object ) == 0 )
+	{
+		return( NULL );
+	}
+	result = PyObject_IsInstance(
+	          property_set_object,
+	          (PyObject *) &pypff_property_set_type_object );
+
+	if( result == -1 )
+	{
+		pypff_error_fetch_and_raise(
+		 PyExc_RuntimeError,
+		 "%s: unable to determine if object is of type property set.",
+		 function );
+
+		return( NULL );
+	}
+	else if( result == 0 )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: unsupported property set object type.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libpff_file_prepare_property_set(
+	          pypff_file->file,
+	          ( (pypff_property_set_t *) property_set_object )->property_set,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pypff_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to prepare property set.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	Py_IncRef(
+	 Py_None );
+
+	return( Py_None );
+}
+
 /* Retrieves the number of orphan items
  * Returns a Python object if successful or NULL on error
  */
@@ -1948,6 +2217,9 @@ PyObject *pypff_file_get_orphan_item_by_index(
 
 		goto on_error;
 	}
+	( (pypff_item_t *) orphan_item_object )->reference_flags = PYPFF_ITEM_REFERENCE_FLAG_IS_ORPHAN;
+	( (pypff_item_t *) orphan_item_object )->reference_index = orphan_item_index;
+
 	return( orphan_item_object );
 
 on_error:
@@ -2052,3 +2324,240 @@ PyObject *pypff_file_get_orphan_items(
 	return( sequence_object );
 }
 
+
+/* Retrieves the number of recovered items
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pypff_file_get_number_of_recovered_items(
+           pypff_file_t *pypff_file,
+           PyObject *arguments PYPFF_ATTRIBUTE_UNUSED )
+{
+	PyObject *integer_object      = NULL;
+	libcerror_error_t *error      = NULL;
+	static char *function         = "pypff_file_get_number_of_recovered_items";
+	int number_of_recovered_items = 0;
+	int result                    = 0;
+
+	PYPFF_UNREFERENCED_PARAMETER( arguments )
+
+	if( pypff_file == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid file.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libpff_file_get_number_of_recovered_items(
+	          pypff_file->file,
+	          &number_of_recovered_items,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pypff_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve number of recovered items.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+#if PY_MAJOR_VERSION >= 3
+	integer_object = PyLong_FromLong(
+	                  (long) number_of_recovered_items );
+#else
+	integer_object = PyInt_FromLong(
+	                  (long) number_of_recovered_items );
+#endif
+	return( integer_object );
+}
+
+/* Retrieves a specific recovered item by index
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pypff_file_get_recovered_item_by_index(
+           PyObject *pypff_file,
+           int recovered_item_index )
+{
+	PyObject *recovered_item_object = NULL;
+	PyTypeObject *type_object       = NULL;
+	libcerror_error_t *error        = NULL;
+	libpff_item_t *recovered_item   = NULL;
+	static char *function           = "pypff_file_get_recovered_item_by_index";
+	int result                      = 0;
+
+	if( pypff_file == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid file.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libpff_file_get_recovered_item_by_index(
+	          ( (pypff_file_t *) pypff_file )->file,
+	          recovered_item_index,
+	          &recovered_item,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pypff_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve recovered item: %d.",
+		 function,
+		 recovered_item_index );
+
+		libcerror_error_free(
+		 &error );
+
+		goto on_error;
+	}
+	type_object = pypff_file_get_item_type_object(
+	               recovered_item );
+
+	if( type_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_IOError,
+		 "%s: unable to retrieve item type object.",
+		 function );
+
+		goto on_error;
+	}
+	recovered_item_object = pypff_item_new(
+	                         type_object,
+	                         recovered_item,
+	                         (PyObject *) pypff_file );
+
+	if( recovered_item_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create item object.",
+		 function );
+
+		goto on_error;
+	}
+	( (pypff_item_t *) recovered_item_object )->reference_flags = PYPFF_ITEM_REFERENCE_FLAG_IS_RECOVERED;
+	( (pypff_item_t *) recovered_item_object )->reference_index = recovered_item_index;
+
+	return( recovered_item_object );
+
+on_error:
+	if( recovered_item != NULL )
+	{
+		libpff_item_free(
+		 &recovered_item,
+		 NULL );
+	}
+	return( NULL );
+}
+
+/* Retrieves a specific recovered item
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pypff_file_get_recovered_item(
+           pypff_file_t *pypff_file,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	PyObject *recovered_item_object = NULL;
+	static char *keyword_list[]     = { "recovered_item_index", NULL };
+	int recovered_item_index        = 0;
+
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "i",
+	     keyword_list,
+	     &recovered_item_index ) == 0 )
+	{
+		return( NULL );
+	}
+	recovered_item_object = pypff_file_get_recovered_item_by_index(
+	                         (PyObject *) pypff_file,
+	                         recovered_item_index );
+
+	return( recovered_item_object );
+}
+
+/* Retrieves a sequence and iterator object for the recovered items
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pypff_file_get_recovered_items(
+           pypff_file_t *pypff_file,
+           PyObject *arguments PYPFF_ATTRIBUTE_UNUSED )
+{
+	PyObject *sequence_object     = NULL;
+	libcerror_error_t *error      = NULL;
+	static char *function         = "pypff_file_get_recovered_items";
+	int number_of_recovered_items = 0;
+	int result                    = 0;
+
+	PYPFF_UNREFERENCED_PARAMETER( arguments )
+
+	if( pypff_file == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid file.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libpff_file_get_number_of_recovered_items(
+	          pypff_file->file,
+	          &number_of_recovered_items,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pypff_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve number of recovered items.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	sequence_object = pypff_items_new(
+	                   (PyObject *) pypff_file,
+	                   &pypff_file_get_recovered_item_by_index,
+	                   number_of_recovered_items );
+
+	if( sequence_object == NULL )
+	{
+		pypff_error_raise(
+		 error,
+		 PyExc_MemoryError,
+		 "%s: unable to create sequence object.",
+		 function );
+
+		return( NULL );
+	}
+	return( sequence_object );
+}
+
@@ -48,6 +48,10 @@ struct pypff_file
 	/* The libbfio file IO handle
 	 */
 	libbfio_handle_t *file_io_handle;
+
+	/* The filename if the file was opened by name
+	 */
+	PyObject *filename;
 };
 
 extern PyMethodDef pypff_file_object_methods[];
@@ -123,6 +127,20 @@ PyObject *pypff_file_get_root_folder(
            pypff_file_t *pypff_file,
            PyObject *arguments );
 
+PyObject *pypff_file_get_item_object_by_identifier(
+           PyObject *pypff_file,
+           uint32_t item_identifier );
+
+PyObject *pypff_file_get_item_by_identifier(
+           pypff_file_t *pypff_file,
+           PyObject *arguments,
+           PyObject *keywords );
+
+PyObject *pypff_file_prepare_property_set(
+           pypff_file_t *pypff_file,
+           PyObject *arguments,
+           PyObject *keywords );
+
 PyObject *pypff_file_get_number_of_orphan_items(
            pypff_file_t *pypff_file,
            PyObject *arguments );
@@ -140,6 +158,23 @@ PyObject *pypff_file_get_orphan_items(
            pypff_file_t *pypff_file,
            PyObject *arguments );
 
+PyObject *pypff_file_get_number_of_recovered_items(
+           pypff_file_t *pypff_file,
+           PyObject *arguments );
+
+PyObject *pypff_file_get_recovered_item_by_index(
+           PyObject *pypff_file,
+           int recovered_item_index );
+
+PyObject *pypff_file_get_recovered_item(
+           pypff_file_t *pypff_file,
+           PyObject *arguments,
+           PyObject *keywords );
+
+PyObject *pypff_file_get_recovered_items(
+           pypff_file_t *pypff_file,
+           PyObject *arguments );
+
 #if defined( __cplusplus )
 }
 #endif
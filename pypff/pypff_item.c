@@ -26,14 +26,19 @@
 #include <stdlib.h>
 #endif
 
+#include "pypff_attachment.h"
 #include "pypff_error.h"
+#include "pypff_file.h"
 #include "pypff_folder.h"
 #include "pypff_item.h"
+#include "pypff_item_reference.h"
 #include "pypff_items.h"
 #include "pypff_libcerror.h"
 #include "pypff_libpff.h"
 #include "pypff_message.h"
+#include "pypff_property_set.h"
 #include "pypff_python.h"
+#include "pypff_record_entry.h"
 #include "pypff_record_set.h"
 #include "pypff_record_sets.h"
 #include "pypff_unused.h"
@@ -47,6 +52,13 @@ PyMethodDef pypff_item_object_methods[] = {
 	  "\n"
 	  "Retrieves the identifier." },
 
+	{ "get_reference",
+	  (PyCFunction) pypff_item_get_reference,
+	  METH_NOARGS,
+	  "get_reference() -> Object\n"
+	  "\n"
+	  "Retrieves a reference to the item that can be passed to another process." },
+
 	{ "get_number_of_record_sets",
 	  (PyCFunction) pypff_item_get_number_of_record_sets,
 	  METH_NOARGS,
@@ -61,6 +73,15 @@ PyMethodDef pypff_item_object_methods[] = {
 	  "\n"
 	  "Retrieves the record set specified by the index." },
 
+	{ "get_entries_by_property_set",
+	  (PyCFunction) pypff_item_get_entries_by_property_set,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "get_entries_by_property_set(property_set, record_set_index=0) -> List\n"
+	  "\n"
+	  "Retrieves the record entries of the record set specified by the index that\n"
+	  "match the requests of a prepared property set, in the order of the requests.\n"
+	  "Requests without a matching record entry are None." },
+
 	{ "get_number_of_entries",
 	  (PyCFunction) pypff_item_get_number_of_entries,
 	  METH_NOARGS,
@@ -94,6 +115,12 @@ PyGetSetDef pypff_item_object_get_set_definitions[] = {
 	  "The identifier.",
 	  NULL },
 
+	{ "reference",
+	  (getter) pypff_item_get_reference,
+	  (setter) 0,
+	  "The reference.",
+	  NULL },
+
 	{ "number_of_record_sets",
 	  (getter) pypff_item_get_number_of_record_sets,
 	  (setter) 0,
@@ -302,7 +329,9 @@ int pypff_item_init(
 	}
 	/* Make sure libpff item is set to NULL
 	 */
-	pypff_item->item = NULL;
+	pypff_item->item            = NULL;
+	pypff_item->reference_flags = 0;
+	pypff_item->reference_index = -1;
 
 	return( 0 );
 }
@@ -443,6 +472,119 @@ PyObject *pypff_item_get_identifier(
 	return( integer_object );
 }
 
+/* Retrieves a reference
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pypff_item_get_reference(
+           pypff_item_t *pypff_item,
+           PyObject *arguments PYPFF_ATTRIBUTE_UNUSED )
+{
+	PyObject *file_object     = NULL;
+	libcerror_error_t *error  = NULL;
+	pypff_item_t *parent_item = NULL;
+	static char *function     = "pypff_item_get_reference";
+	uint32_t identifier       = 0;
+	int result                = 0;
+
+	PYPFF_UNREFERENCED_PARAMETER( arguments )
+
+	if( pypff_item == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid item.",
+		 function );
+
+		return( NULL );
+	}
+	/* Only items in the item tree, orphan items and recovered items
+	 * can be retrieved again from the file
+	 */
+	result = PyObject_TypeCheck(
+	          (PyObject *) pypff_item,
+	          &pypff_attachment_type_object );
+
+	file_object = pypff_item->parent_object;
+
+	while( ( result == 0 )
+	    && ( file_object != NULL )
+	    && ( PyObject_TypeCheck(
+	          file_object,
+	          &pypff_item_type_object ) != 0 ) )
+	{
+		parent_item = (pypff_item_t *) file_object;
+
+		if( parent_item->reference_flags != 0 )
+		{
+			result = 1;
+		}
+		else
+		{
+			result = PyObject_TypeCheck(
+			          file_object,
+			          &pypff_attachment_type_object );
+		}
+		file_object = parent_item->parent_object;
+	}
+	if( result != 0 )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: unsupported item - only items in the item tree, orphan or recovered items can be referenced.",
+		 function );
+
+		return( NULL );
+	}
+	if( ( file_object == NULL )
+	 || ( PyObject_TypeCheck(
+	       file_object,
+	       &pypff_file_type_object ) == 0 ) )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid item - missing file object.",
+		 function );
+
+		return( NULL );
+	}
+	if( ( (pypff_file_t *) file_object )->filename == NULL )
+	{
+		PyErr_Format(
+		 PyExc_IOError,
+		 "%s: unsupported file - only files opened by name can be referenced.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libpff_item_get_identifier(
+	          pypff_item->item,
+	          &identifier,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pypff_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve identifier.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	return( pypff_item_reference_new(
+	         ( (pypff_file_t *) file_object )->filename,
+	         identifier,
+	         pypff_item->reference_index,
+	         pypff_item->reference_flags ) );
+}
+
 /* Retrieves the number of record sets
  * Returns a Python object if successful or NULL on error
  */
@@ -687,6 +829,198 @@ PyObject *pypff_item_get_record_sets(
 	return( sequence_object );
 }
 
+/* Retrieves the record entries of a specific record set that match a prepared property set
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pypff_item_get_entries_by_property_set(
+           pypff_item_t *pypff_item,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	libpff_record_entry_t **record_entries = NULL;
+	PyObject *list_object                  = NULL;
+	PyObject *property_set_object          = NULL;
+	PyObject *record_entry_object          = NULL;
+	libcerror_error_t *error               = NULL;
+	static char *function                  = "pypff_item_get_entries_by_property_set";
+	static char *keyword_list[]            = { "property_set", "record_set_index", NULL };
+	int number_of_requests                 = 0;
+	int record_set_index                   = 0;
+	int request_index                      = 0;
+	int result                             = 0;
+
+	if( pypff_item == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid item.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "O|i",
+	     keyword_list,
+	     &property_set_object,
+	     &record_set_index ) == 0 )
+	{
+		return( NULL );
+	}
+	result = PyObject_IsInstance(
+	          property_set_object,
+	          (PyObject *) &pypff_property_set_type_object );
+
+	if( result == -1 )
+	{
+		pypff_error_fetch_and_raise(
+		 PyExc_RuntimeError,
+		 "%s: unable to determine if object is of type property set.",
+		 function );
+
+		return( NULL );
+	}
+	else if( result == 0 )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: unsupported property set object type.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libpff_property_set_get_number_of_requests(
+	          ( (pypff_property_set_t *) property_set_object )->property_set,
+	          &number_of_requests,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pypff_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve number of requests.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		goto on_error;
+	}
+	list_object = PyList_New(
+	               (Py_ssize_t) number_of_requests );
+
+	if( list_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create list object.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_requests == 0 )
+	{
+		return( list_object );
+	}
+	record_entries = (libpff_record_entry_t **) PyMem_Malloc(
+	                  sizeof( libpff_record_entry_t * ) * number_of_requests );
+
+	if( record_entries == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create record entries.",
+		 function );
+
+		goto on_error;
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libpff_item_get_entries_by_property_set(
+	          pypff_item->item,
+	          record_set_index,
+	          ( (pypff_property_set_t *) property_set_object )->property_set,
+	          record_entries,
+	          number_of_requests,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pypff_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve entries by property set from record set: %d.",
+		 function,
+		 record_set_index );
+
+		libcerror_error_free(
+		 &error );
+
+		goto on_error;
+	}
+	for( request_index = 0;
+	     request_index < number_of_requests;
+	     request_index++ )
+	{
+		if( record_entries[ request_index ] == NULL )
+		{
+			Py_IncRef(
+			 Py_None );
+
+			record_entry_object = Py_None;
+		}
+		else
+		{
+			record_entry_object = pypff_record_entry_new(
+			                       &pypff_record_entry_type_object,
+			                       record_entries[ request_index ],
+			                       (PyObject *) pypff_item );
+
+			if( record_entry_object == NULL )
+			{
+				PyErr_Format(
+				 PyExc_MemoryError,
+				 "%s: unable to create record entry object: %d.",
+				 function,
+				 request_index );
+
+				goto on_error;
+			}
+		}
+		/* PyList_SetItem steals the reference to the record entry object
+		 */
+		PyList_SetItem(
+		 list_object,
+		 (Py_ssize_t) request_index,
+		 record_entry_object );
+	}
+	PyMem_Free(
+	 record_entries );
+
+	return( list_object );
+
+on_error:
+	if( record_entries != NULL )
+	{
+		PyMem_Free(
+		 record_entries );
+	}
+	if( list_object != NULL )
+	{
+		Py_DecRef(
+		 list_object );
+	}
+	return( NULL );
+}
+
 /* Retrieves the number of entries
  * Returns a Python object if successful or NULL on error
  */
@@ -51,6 +51,14 @@ struct pypff_item
 	/* The parent object
 	 */
 	PyObject *parent_object;
+
+	/* The reference flags
+	 */
+	uint8_t reference_flags;
+
+	/* The orphan or recovered item index
+	 */
+	int reference_index;
 };
 
 extern PyMethodDef pypff_item_object_methods[];
@@ -71,6 +79,10 @@ PyObject *pypff_item_get_identifier(
            pypff_item_t *pypff_item,
            PyObject *arguments );
 
+PyObject *pypff_item_get_reference(
+           pypff_item_t *pypff_item,
+           PyObject *arguments );
+
 PyObject *pypff_item_get_number_of_record_sets(
            pypff_item_t *pypff_item,
            PyObject *arguments );
@@ -88,6 +100,11 @@ PyObject *pypff_item_get_record_sets(
            pypff_item_t *pypff_item,
            PyObject *arguments );
 
+PyObject *pypff_item_get_entries_by_property_set(
+           pypff_item_t *pypff_item,
+           PyObject *arguments,
+           PyObject *keywords );
+
 PyObject *pypff_item_get_number_of_entries(
            pypff_item_t *pypff_item,
            PyObject *arguments );
@@ -0,0 +1,916 @@
+/*
+ * Python object definition of the item reference
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( HAVE_WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( WINAPI )
+#include <process.h>
+
+#elif defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "pypff.h"
+#include "pypff_error.h"
+#include "pypff_file.h"
+#include "pypff_item.h"
+#include "pypff_item_reference.h"
+#include "pypff_libcerror.h"
+#include "pypff_libpff.h"
+#include "pypff_python.h"
+#include "pypff_unused.h"
+
+/* The files opened to retrieve referenced items, by filename
+ */
+static PyObject *pypff_item_reference_file_objects = NULL;
+
+/* The identifier of the process that opened the files
+ */
+static long pypff_item_reference_process_identifier = 0;
+
+PyMethodDef pypff_item_reference_object_methods[] = {
+
+	{ "__reduce__",
+	  (PyCFunction) pypff_item_reference_reduce,
+	  METH_NOARGS,
+	  "__reduce__() -> Tuple\n"
+	  "\n"
+	  "Retrieves the state of the item reference for pickling.\n"
+	  "\n"
+	  "References to recovered items cannot be pickled, since the items are not recovered when the file is opened again." },
+
+	{ "get_filename",
+	  (PyCFunction) pypff_item_reference_get_filename,
+	  METH_NOARGS,
+	  "get_filename() -> Unicode string or binary string\n"
+	  "\n"
+	  "Retrieves the filename." },
+
+	{ "get_identifier",
+	  (PyCFunction) pypff_item_reference_get_identifier,
+	  METH_NOARGS,
+	  "get_identifier() -> Integer\n"
+	  "\n"
+	  "Retrieves the (descriptor) identifier." },
+
+	{ "get_item_index",
+	  (PyCFunction) pypff_item_reference_get_item_index,
+	  METH_NOARGS,
+	  "get_item_index() -> Integer or None\n"
+	  "\n"
+	  "Retrieves the orphan or recovered item index." },
+
+	{ "is_orphan",
+	  (PyCFunction) pypff_item_reference_is_orphan,
+	  METH_NOARGS,
+	  "is_orphan() -> Boolean\n"
+	  "\n"
+	  "Determines if the referenced item is an orphan item." },
+
+	{ "is_recovered",
+	  (PyCFunction) pypff_item_reference_is_recovered,
+	  METH_NOARGS,
+	  "is_recovered() -> Boolean\n"
+	  "\n"
+	  "Determines if the referenced item is a recovered item." },
+
+	{ "get_item",
+	  (PyCFunction) pypff_item_reference_get_item,
+	  METH_NOARGS,
+	  "get_item() -> Object or None\n"
+	  "\n"
+	  "Retrieves the referenced item.\n"
+	  "\n"
+	  "The file is opened once per process and kept open for subsequent references.\n"
+	  "Recovered items cannot be retrieved, since the items are not recovered when the file is opened." },
+
+	/* Sentinel */
+	{ NULL, NULL, 0, NULL }
+};
+
+PyGetSetDef pypff_item_reference_object_get_set_definitions[] = {
+
+	{ "filename",
+	  (getter) pypff_item_reference_get_filename,
+	  (setter) 0,
+	  "The filename.",
+	  NULL },
+
+	{ "identifier",
+	  (getter) pypff_item_reference_get_identifier,
+	  (setter) 0,
+	  "The (descriptor) identifier.",
+	  NULL },
+
+	{ "item_index",
+	  (getter) pypff_item_reference_get_item_index,
+	  (setter) 0,
+	  "The orphan or recovered item index.",
+	  NULL },
+
+	/* Sentinel */
+	{ NULL, NULL, NULL, NULL, NULL }
+};
+
+PyTypeObject pypff_item_reference_type_object = {
+	PyVarObject_HEAD_INIT( NULL, 0 )
+
+	/* tp_name */
+	"pypff.item_reference",
+	/* tp_basicsize */
+	sizeof( pypff_item_reference_t ),
+	/* tp_itemsize */
+	0,
+	/* tp_dealloc */
+	(destructor) pypff_item_reference_free,
+	/* tp_print */
+	0,
+	/* tp_getattr */
+	0,
+	/* tp_setattr */
+	0,
+	/* tp_compare */
+	0,
+	/* tp_repr */
+	0,
+	/* tp_as_number */
+	0,
+	/* tp_as_sequence */
+	0,
+	/* tp_as_mapping */
+	0,
+	/* tp_hash */
+	0,
+	/* tp_call */
+	0,
+	/* tp_str */
+	0,
+	/* tp_getattro */
+	0,
+	/* tp_setattro */
+	0,
+	/* tp_as_buffer */
+	0,
+	/* tp_flags */
+	Py_TPFLAGS_DEFAULT,
+	/* tp_doc */
+	"pypff item reference object (picklable reference to an item in a file)",
+	/* tp_traverse */
+	0,
+	/* tp_clear */
+	0,
+	/* tp_richcompare */
+	0,
+	/* tp_weaklistoffset */
+	0,
+	/* tp_iter */
+	0,
+	/* tp_iternext */
+	0,
+	/* tp_methods */
+	pypff_item_reference_object_methods,
+	/* tp_members */
+	0,
+	/* tp_getset */
+	pypff_item_reference_object_get_set_definitions,
+	/* tp_base */
+	0,
+	/* tp_dict */
+	0,
+	/* tp_descr_get */
+	0,
+	/* tp_descr_set */
+	0,
+	/* tp_dictoffset */
+	0,
+	/* tp_init */
+	(initproc) pypff_item_reference_init,
+	/* tp_alloc */
+	0,
+	/* tp_new */
+	0,
+	/* tp_free */
+	0,
+	/* tp_is_gc */
+	0,
+	/* tp_bases */
+	NULL,
+	/* tp_mro */
+	NULL,
+	/* tp_cache */
+	NULL,
+	/* tp_subclasses */
+	NULL,
+	/* tp_weaklist */
+	NULL,
+	/* tp_del */
+	0
+};
+
+/* Creates a new item reference object
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pypff_item_reference_new(
+           PyObject *filename,
+           uint32_t identifier,
+           int item_index,
+           uint8_t flags )
+{
+	pypff_item_reference_t *pypff_item_reference = NULL;
+	static char *function                        = "pypff_item_reference_new";
+
+	if( filename == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid filename.",
+		 function );
+
+		return( NULL );
+	}
+	pypff_item_reference = PyObject_New(
+	                        struct pypff_item_reference,
+	                        &pypff_item_reference_type_object );
+
+	if( pypff_item_reference == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to initialize item reference.",
+		 function );
+
+		return( NULL );
+	}
+	pypff_item_reference->filename   = filename;
+	pypff_item_reference->identifier = identifier;
+	pypff_item_reference->item_index = item_index;
+	pypff_item_reference->flags      = flags;
+
+	Py_IncRef(
+	 pypff_item_reference->filename );
+
+	return( (PyObject *) pypff_item_reference );
+}
+
+/* Initializes an item reference object
+ * Returns 0 if successful or -1 on error
+ */
+int pypff_item_reference_init(
+     pypff_item_reference_t *pypff_item_reference,
+     PyObject *arguments,
+     PyObject *keywords )
+{
+	PyObject *filename            = NULL;
+	PyObject *is_orphan_object    = NULL;
+	PyObject *is_recovered_object = NULL;
+	static char *function         = "pypff_item_reference_init";
+	static char *keyword_list[]   = { "filename", "identifier", "item_index", "is_orphan", "is_recovered", NULL };
+	unsigned long identifier      = 0;
+	uint8_t flags                 = 0;
+	int item_index                = -1;
+	int result                    = 0;
+
+	if( pypff_item_reference == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid item reference.",
+		 function );
+
+		return( -1 );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "Ok|iOO",
+	     keyword_list,
+	     &filename,
+	     &identifier,
+	     &item_index,
+	     &is_orphan_object,
+	     &is_recovered_object ) == 0 )
+	{
+		return( -1 );
+	}
+#if PY_MAJOR_VERSION >= 3
+	result = PyBytes_Check(
+	          filename );
+#else
+	result = PyString_Check(
+	          filename );
+#endif
+	if( ( result == 0 )
+	 && ( PyUnicode_Check(
+	       filename ) == 0 ) )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: unsupported filename object type.",
+		 function );
+
+		return( -1 );
+	}
+	if( identifier > (unsigned long) UINT32_MAX )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid identifier value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( is_orphan_object != NULL )
+	{
+		result = PyObject_IsTrue(
+		          is_orphan_object );
+
+		if( result == -1 )
+		{
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			flags |= PYPFF_ITEM_REFERENCE_FLAG_IS_ORPHAN;
+		}
+	}
+	if( is_recovered_object != NULL )
+	{
+		result = PyObject_IsTrue(
+		          is_recovered_object );
+
+		if( result == -1 )
+		{
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			flags |= PYPFF_ITEM_REFERENCE_FLAG_IS_RECOVERED;
+		}
+	}
+	if( flags == ( PYPFF_ITEM_REFERENCE_FLAG_IS_ORPHAN | PYPFF_ITEM_REFERENCE_FLAG_IS_RECOVERED ) )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: an item cannot be both orphan and recovered.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( flags != 0 )
+	 && ( item_index < 0 ) )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid item index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( pypff_item_reference->filename != NULL )
+	{
+		Py_DecRef(
+		 pypff_item_reference->filename );
+	}
+	pypff_item_reference->filename   = filename;
+	pypff_item_reference->identifier = (uint32_t) identifier;
+	pypff_item_reference->item_index = ( flags != 0 ) ? item_index : -1;
+	pypff_item_reference->flags      = flags;
+
+	Py_IncRef(
+	 pypff_item_reference->filename );
+
+	return( 0 );
+}
+
+/* Frees an item reference object
+ */
+void pypff_item_reference_free(
+      pypff_item_reference_t *pypff_item_reference )
+{
+	struct _typeobject *ob_type = NULL;
+	static char *function       = "pypff_item_reference_free";
+
+	if( pypff_item_reference == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid item reference.",
+		 function );
+
+		return;
+	}
+	ob_type = Py_TYPE(
+	           pypff_item_reference );
+
+	if( ob_type == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: missing ob_type.",
+		 function );
+
+		return;
+	}
+	if( ob_type->tp_free == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid ob_type - missing tp_free.",
+		 function );
+
+		return;
+	}
+	if( pypff_item_reference->filename != NULL )
+	{
+		Py_DecRef(
+		 pypff_item_reference->filename );
+	}
+	ob_type->tp_free(
+	 (PyObject*) pypff_item_reference );
+}
+
+/* Retrieves the state of the item reference for pickling
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pypff_item_reference_reduce(
+           pypff_item_reference_t *pypff_item_reference,
+           PyObject *arguments PYPFF_ATTRIBUTE_UNUSED )
+{
+	static char *function = "pypff_item_reference_reduce";
+
+	PYPFF_UNREFERENCED_PARAMETER( arguments )
+
+	if( pypff_item_reference == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid item reference.",
+		 function );
+
+		return( NULL );
+	}
+	if( pypff_item_reference->filename == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid item reference - missing filename.",
+		 function );
+
+		return( NULL );
+	}
+	/* The recovered item index is only valid for the file object the items
+	 * were recovered in, the file opened to resolve the reference is not recovered
+	 */
+	if( ( pypff_item_reference->flags & PYPFF_ITEM_REFERENCE_FLAG_IS_RECOVERED ) != 0 )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: unsupported item reference - references to recovered items cannot be pickled.",
+		 function );
+
+		return( NULL );
+	}
+	/* The N format passes the Boolean objects without an additional reference
+	 */
+	return( Py_BuildValue(
+	         "O(OkiNN)",
+	         (PyObject *) Py_TYPE( pypff_item_reference ),
+	         pypff_item_reference->filename,
+	         (unsigned long) pypff_item_reference->identifier,
+	         pypff_item_reference->item_index,
+	         PyBool_FromLong(
+	          (long) ( pypff_item_reference->flags & PYPFF_ITEM_REFERENCE_FLAG_IS_ORPHAN ) ),
+	         PyBool_FromLong(
+	          (long) ( pypff_item_reference->flags & PYPFF_ITEM_REFERENCE_FLAG_IS_RECOVERED ) ) ) );
+}
+
+/* Retrieves the filename
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pypff_item_reference_get_filename(
+           pypff_item_reference_t *pypff_item_reference,
+           PyObject *arguments PYPFF_ATTRIBUTE_UNUSED )
+{
+	static char *function = "pypff_item_reference_get_filename";
+
+	PYPFF_UNREFERENCED_PARAMETER( arguments )
+
+	if( pypff_item_reference == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid item reference.",
+		 function );
+
+		return( NULL );
+	}
+	if( pypff_item_reference->filename == NULL )
+	{
+		Py_IncRef(
+		 Py_None );
+
+		return( Py_None );
+	}
+	Py_IncRef(
+	 pypff_item_reference->filename );
+
+	return( pypff_item_reference->filename );
+}
+
+/* Retrieves the (descriptor) identifier
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pypff_item_reference_get_identifier(
+           pypff_item_reference_t *pypff_item_reference,
+           PyObject *arguments PYPFF_ATTRIBUTE_UNUSED )
+{
+	static char *function = "pypff_item_reference_get_identifier";
+
+	PYPFF_UNREFERENCED_PARAMETER( arguments )
+
+	if( pypff_item_reference == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid item reference.",
+		 function );
+
+		return( NULL );
+	}
+	return( PyLong_FromUnsignedLong(
+	         (unsigned long) pypff_item_reference->identifier ) );
+}
+
+/* Retrieves the orphan or recovered item index
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pypff_item_reference_get_item_index(
+           pypff_item_reference_t *pypff_item_reference,
+           PyObject *arguments PYPFF_ATTRIBUTE_UNUSED )
+{
+	PyObject *integer_object = NULL;
+	static char *function    = "pypff_item_reference_get_item_index";
+
+	PYPFF_UNREFERENCED_PARAMETER( arguments )
+
+	if( pypff_item_reference == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid item reference.",
+		 function );
+
+		return( NULL );
+	}
+	if( pypff_item_reference->flags == 0 )
+	{
+		Py_IncRef(
+		 Py_None );
+
+		return( Py_None );
+	}
+#if PY_MAJOR_VERSION >= 3
+	integer_object = PyLong_FromLong(
+	                  (long) pypff_item_reference->item_index );
+#else
+	integer_object = PyInt_FromLong(
+	                  (long) pypff_item_reference->item_index );
+#endif
+	return( integer_object );
+}
+
+/* Determines if the referenced item is an orphan item
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pypff_item_reference_is_orphan(
+           pypff_item_reference_t *pypff_item_reference,
+           PyObject *arguments PYPFF_ATTRIBUTE_UNUSED )
+{
+	static char *function = "pypff_item_reference_is_orphan";
+
+	PYPFF_UNREFERENCED_PARAMETER( arguments )
+
+	if( pypff_item_reference == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid item reference.",
+		 function );
+
+		return( NULL );
+	}
+	if( ( pypff_item_reference->flags & PYPFF_ITEM_REFERENCE_FLAG_IS_ORPHAN ) != 0 )
+	{
+		Py_IncRef(
+		 (PyObject *) Py_True );
+
+		return( Py_True );
+	}
+	Py_IncRef(
+	 (PyObject *) Py_False );
+
+	return( Py_False );
+}
+
+/* Determines if the referenced item is a recovered item
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pypff_item_reference_is_recovered(
+           pypff_item_reference_t *pypff_item_reference,
+           PyObject *arguments PYPFF_ATTRIBUTE_UNUSED )
+{
+	static char *function = "pypff_item_reference_is_recovered";
+
+	PYPFF_UNREFERENCED_PARAMETER( arguments )
+
+	if( pypff_item_reference == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid item reference.",
+		 function );
+
+		return( NULL );
+	}
+	if( ( pypff_item_reference->flags & PYPFF_ITEM_REFERENCE_FLAG_IS_RECOVERED ) != 0 )
+	{
+		Py_IncRef(
+		 (PyObject *) Py_True );
+
+		return( Py_True );
+	}
+	Py_IncRef(
+	 (PyObject *) Py_False );
+
+	return( Py_False );
+}
+
+/* Retrieves the referenced item
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pypff_item_reference_get_item(
+           pypff_item_reference_t *pypff_item_reference,
+           PyObject *arguments PYPFF_ATTRIBUTE_UNUSED )
+{
+	PyObject *file_object    = NULL;
+	PyObject *item_object    = NULL;
+	libcerror_error_t *error = NULL;
+	static char *function    = "pypff_item_reference_get_item";
+	uint32_t identifier      = 0;
+	int result               = 0;
+
+	PYPFF_UNREFERENCED_PARAMETER( arguments )
+
+	if( pypff_item_reference == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid item reference.",
+		 function );
+
+		return( NULL );
+	}
+	if( pypff_item_reference->filename == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid item reference - missing filename.",
+		 function );
+
+		return( NULL );
+	}
+	if( ( pypff_item_reference->flags & PYPFF_ITEM_REFERENCE_FLAG_IS_RECOVERED ) != 0 )
+	{
+		PyErr_Format(
+		 PyExc_IOError,
+		 "%s: unsupported item reference - recovered items cannot be retrieved from a file that is opened again.",
+		 function );
+
+		return( NULL );
+	}
+	file_object = pypff_item_reference_get_file_object(
+	               pypff_item_reference->filename );
+
+	if( file_object == NULL )
+	{
+		return( NULL );
+	}
+	if( ( pypff_item_reference->flags & PYPFF_ITEM_REFERENCE_FLAG_IS_ORPHAN ) != 0 )
+	{
+		item_object = pypff_file_get_orphan_item_by_index(
+		               file_object,
+		               pypff_item_reference->item_index );
+	}
+	else
+	{
+		item_object = pypff_file_get_item_object_by_identifier(
+		               file_object,
+		               pypff_item_reference->identifier );
+	}
+	/* The item keeps its own reference to the file object
+	 */
+	Py_DecRef(
+	 file_object );
+
+	if( ( item_object == NULL )
+	 || ( item_object == Py_None ) )
+	{
+		return( item_object );
+	}
+	/* Orphan items are retrieved by index, make sure
+	 * the index still refers to the same item
+	 */
+	if( pypff_item_reference->flags != 0 )
+	{
+		Py_BEGIN_ALLOW_THREADS
+
+		result = libpff_item_get_identifier(
+		          ( (pypff_item_t *) item_object )->item,
+		          &identifier,
+		          &error );
+
+		Py_END_ALLOW_THREADS
+
+		if( result != 1 )
+		{
+			pypff_error_raise(
+			 error,
+			 PyExc_IOError,
+			 "%s: unable to retrieve identifier.",
+			 function );
+
+			libcerror_error_free(
+			 &error );
+
+			goto on_error;
+		}
+		if( identifier != pypff_item_reference->identifier )
+		{
+			PyErr_Format(
+			 PyExc_IOError,
+			 "%s: mismatch in identifier of item: %d.",
+			 function,
+			 pypff_item_reference->item_index );
+
+			goto on_error;
+		}
+	}
+	return( item_object );
+
+on_error:
+	Py_DecRef(
+	 item_object );
+
+	return( NULL );
+}
+
+/* Retrieves the file object of a specific filename from the per process file cache
+ * The file is opened when it is not in the cache
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pypff_item_reference_get_file_object(
+           PyObject *filename )
+{
+	PyObject *argument_tuple = NULL;
+	PyObject *file_object    = NULL;
+	static char *function    = "pypff_item_reference_get_file_object";
+	long process_identifier  = 0;
+
+	if( filename == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid filename.",
+		 function );
+
+		return( NULL );
+	}
+#if defined( WINAPI )
+	process_identifier = (long) _getpid();
+#else
+	process_identifier = (long) getpid();
+#endif
+
+	/* A forked process inherits the cache, but the file offsets of the
+	 * inherited descriptors are shared with the parent hence the files
+	 * are opened again
+	 */
+	if( ( pypff_item_reference_file_objects != NULL )
+	 && ( pypff_item_reference_process_identifier != process_identifier ) )
+	{
+		Py_DecRef(
+		 pypff_item_reference_file_objects );
+
+		pypff_item_reference_file_objects = NULL;
+	}
+	if( pypff_item_reference_file_objects == NULL )
+	{
+		pypff_item_reference_file_objects = PyDict_New();
+
+		if( pypff_item_reference_file_objects == NULL )
+		{
+			PyErr_Format(
+			 PyExc_MemoryError,
+			 "%s: unable to create file cache.",
+			 function );
+
+			return( NULL );
+		}
+		pypff_item_reference_process_identifier = process_identifier;
+	}
+	file_object = PyDict_GetItem(
+	               pypff_item_reference_file_objects,
+	               filename );
+
+	if( file_object != NULL )
+	{
+		Py_IncRef(
+		 file_object );
+
+		return( file_object );
+	}
+	argument_tuple = PyTuple_Pack(
+	                  1,
+	                  filename );
+
+	if( argument_tuple == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create argument tuple.",
+		 function );
+
+		return( NULL );
+	}
+	file_object = pypff_open_new_file(
+	               NULL,
+	               argument_tuple,
+	               NULL );
+
+	Py_DecRef(
+	 argument_tuple );
+
+	if( file_object == NULL )
+	{
+		return( NULL );
+	}
+	if( PyDict_SetItem(
+	     pypff_item_reference_file_objects,
+	     filename,
+	     file_object ) != 0 )
+	{
+		Py_DecRef(
+		 file_object );
+
+		return( NULL );
+	}
+	return( file_object );
+}
+
+/* Clears the per process file cache
+ * Files are closed when no item refers to them anymore
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pypff_item_reference_clear_file_cache(
+           PyObject *self PYPFF_ATTRIBUTE_UNUSED,
+           PyObject *arguments PYPFF_ATTRIBUTE_UNUSED )
+{
+	PYPFF_UNREFERENCED_PARAMETER( self )
+	PYPFF_UNREFERENCED_PARAMETER( arguments )
+
+	if( pypff_item_reference_file_objects != NULL )
+	{
+		Py_DecRef(
+		 pypff_item_reference_file_objects );
+
+		pypff_item_reference_file_objects = NULL;
+	}
+	Py_IncRef(
+	 Py_None );
+
+	return( Py_None );
+}
+
@@ -0,0 +1,122 @@
+/*
+ * Python object definition of the item reference
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _PYPFF_ITEM_REFERENCE_H )
+#define _PYPFF_ITEM_REFERENCE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "pypff_python.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+enum PYPFF_ITEM_REFERENCE_FLAGS
+{
+	PYPFF_ITEM_REFERENCE_FLAG_IS_ORPHAN	= 0x01,
+	PYPFF_ITEM_REFERENCE_FLAG_IS_RECOVERED	= 0x02
+};
+
+typedef struct pypff_item_reference pypff_item_reference_t;
+
+struct pypff_item_reference
+{
+	/* Python object initialization
+	 */
+	PyObject_HEAD
+
+	/* The filename
+	 */
+	PyObject *filename;
+
+	/* The (descriptor) identifier
+	 */
+	uint32_t identifier;
+
+	/* The orphan or recovered item index
+	 */
+	int item_index;
+
+	/* The flags
+	 */
+	uint8_t flags;
+};
+
+extern PyMethodDef pypff_item_reference_object_methods[];
+extern PyTypeObject pypff_item_reference_type_object;
+
+PyObject *pypff_item_reference_new(
+           PyObject *filename,
+           uint32_t identifier,
+           int item_index,
+           uint8_t flags );
+
+int pypff_item_reference_init(
+     pypff_item_reference_t *pypff_item_reference,
+     PyObject *arguments,
+     PyObject *keywords );
+
+void pypff_item_reference_free(
+      pypff_item_reference_t *pypff_item_reference );
+
+PyObject *pypff_item_reference_reduce(
+           pypff_item_reference_t *pypff_item_reference,
+           PyObject *arguments );
+
+PyObject *pypff_item_reference_get_filename(
+           pypff_item_reference_t *pypff_item_reference,
+           PyObject *arguments );
+
+PyObject *pypff_item_reference_get_identifier(
+           pypff_item_reference_t *pypff_item_reference,
+           PyObject *arguments );
+
+PyObject *pypff_item_reference_get_item_index(
+           pypff_item_reference_t *pypff_item_reference,
+           PyObject *arguments );
+
+PyObject *pypff_item_reference_is_orphan(
+           pypff_item_reference_t *pypff_item_reference,
+           PyObject *arguments );
+
+PyObject *pypff_item_reference_is_recovered(
+           pypff_item_reference_t *pypff_item_reference,
+           PyObject *arguments );
+
+PyObject *pypff_item_reference_get_item(
+           pypff_item_reference_t *pypff_item_reference,
+           PyObject *arguments );
+
+PyObject *pypff_item_reference_get_file_object(
+           PyObject *filename );
+
+PyObject *pypff_item_reference_clear_file_cache(
+           PyObject *self,
+           PyObject *arguments );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _PYPFF_ITEM_REFERENCE_H ) */
+
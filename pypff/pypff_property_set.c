@@ -0,0 +1,914 @@
+/*
+ * Python object definition of the libpff property set
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( HAVE_WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "pypff_error.h"
+#include "pypff_integer.h"
+#include "pypff_libcerror.h"
+#include "pypff_libpff.h"
+#include "pypff_property_set.h"
+#include "pypff_python.h"
+#include "pypff_unused.h"
+
+PyMethodDef pypff_property_set_object_methods[] = {
+
+	{ "append_entry_type",
+	  (PyCFunction) pypff_property_set_append_entry_type,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "append_entry_type(entry_type, value_type=None) -> Integer\n"
+	  "\n"
+	  "Appends a request for a property by its entry type and returns the request index.\n"
+	  "\n"
+	  "If no value type is specified any value type matches." },
+
+	{ "append_numeric_name",
+	  (PyCFunction) pypff_property_set_append_numeric_name,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "append_numeric_name(guid, number, value_type=None) -> Integer\n"
+	  "\n"
+	  "Appends a request for a named property by its property set GUID and number\n"
+	  "and returns the request index.\n"
+	  "\n"
+	  "The GUID is a binary string of 16 bytes. If no value type is specified any\n"
+	  "value type matches." },
+
+	{ "append_string_name",
+	  (PyCFunction) pypff_property_set_append_string_name,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "append_string_name(guid, name, value_type=None) -> Integer\n"
+	  "\n"
+	  "Appends a request for a named property by its property set GUID and name\n"
+	  "and returns the request index.\n"
+	  "\n"
+	  "The GUID is a binary string of 16 bytes. If no value type is specified any\n"
+	  "value type matches." },
+
+	{ "get_number_of_requests",
+	  (PyCFunction) pypff_property_set_get_number_of_requests,
+	  METH_NOARGS,
+	  "get_number_of_requests() -> Integer\n"
+	  "\n"
+	  "Retrieves the number of requests." },
+
+	{ "is_prepared",
+	  (PyCFunction) pypff_property_set_is_prepared,
+	  METH_NOARGS,
+	  "is_prepared() -> Boolean\n"
+	  "\n"
+	  "Determines if the property set was prepared against a file." },
+
+	/* Sentinel */
+	{ NULL, NULL, 0, NULL }
+};
+
+PyGetSetDef pypff_property_set_object_get_set_definitions[] = {
+
+	{ "number_of_requests",
+	  (getter) pypff_property_set_get_number_of_requests,
+	  (setter) 0,
+	  "The number of requests.",
+	  NULL },
+
+	/* Sentinel */
+	{ NULL, NULL, NULL, NULL, NULL }
+};
+
+PyTypeObject pypff_property_set_type_object = {
+	PyVarObject_HEAD_INIT( NULL, 0 )
+
+	/* tp_name */
+	"pypff.property_set",
+	/* tp_basicsize */
+	sizeof( pypff_property_set_t ),
+	/* tp_itemsize */
+	0,
+	/* tp_dealloc */
+	(destructor) pypff_property_set_free,
+	/* tp_print */
+	0,
+	/* tp_getattr */
+	0,
+	/* tp_setattr */
+	0,
+	/* tp_compare */
+	0,
+	/* tp_repr */
+	0,
+	/* tp_as_number */
+	0,
+	/* tp_as_sequence */
+	0,
+	/* tp_as_mapping */
+	0,
+	/* tp_hash */
+	0,
+	/* tp_call */
+	0,
+	/* tp_str */
+	0,
+	/* tp_getattro */
+	0,
+	/* tp_setattro */
+	0,
+	/* tp_as_buffer */
+	0,
+	/* tp_flags */
+	Py_TPFLAGS_DEFAULT,
+	/* tp_doc */
+	"pypff property set object (wraps libpff_property_set_t)",
+	/* tp_traverse */
+	0,
+	/* tp_clear */
+	0,
+	/* tp_richcompare */
+	0,
+	/* tp_weaklistoffset */
+	0,
+	/* tp_iter */
+	0,
+	/* tp_iternext */
+	0,
+	/* tp_methods */
+	pypff_property_set_object_methods,
+	/* tp_members */
+	0,
+	/* tp_getset */
+	pypff_property_set_object_get_set_definitions,
+	/* tp_base */
+	0,
+	/* tp_dict */
+	0,
+	/* tp_descr_get */
+	0,
+	/* tp_descr_set */
+	0,
+	/* tp_dictoffset */
+	0,
+	/* tp_init */
+	(initproc) pypff_property_set_init,
+	/* tp_alloc */
+	0,
+	/* tp_new */
+	0,
+	/* tp_free */
+	0,
+	/* tp_is_gc */
+	0,
+	/* tp_bases */
+	NULL,
+	/* tp_mro */
+	NULL,
+	/* tp_cache */
+	NULL,
+	/* tp_subclasses */
+	NULL,
+	/* tp_weaklist */
+	NULL,
+	/* tp_del */
+	0
+};
+
+/* Initializes a property set object
+ * Returns 0 if successful or -1 on error
+ */
+int pypff_property_set_init(
+     pypff_property_set_t *pypff_property_set )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "pypff_property_set_init";
+
+	if( pypff_property_set == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid property set.",
+		 function );
+
+		return( -1 );
+	}
+	pypff_property_set->property_set = NULL;
+
+	if( libpff_property_set_initialize(
+	     &( pypff_property_set->property_set ),
+	     &error ) != 1 )
+	{
+		pypff_error_raise(
+		 error,
+		 PyExc_MemoryError,
+		 "%s: unable to initialize property set.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/* Frees a property set object
+ */
+void pypff_property_set_free(
+      pypff_property_set_t *pypff_property_set )
+{
+	struct _typeobject *ob_type = NULL;
+	libcerror_error_t *error    = NULL;
+	static char *function       = "pypff_property_set_free";
+	int result                  = 0;
+
+	if( pypff_property_set == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid property set.",
+		 function );
+
+		return;
+	}
+	ob_type = Py_TYPE(
+	           pypff_property_set );
+
+	if( ob_type == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: missing ob_type.",
+		 function );
+
+		return;
+	}
+	if( ob_type->tp_free == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid ob_type - missing tp_free.",
+		 function );
+
+		return;
+	}
+	if( pypff_property_set->property_set != NULL )
+	{
+		Py_BEGIN_ALLOW_THREADS
+
+		result = libpff_property_set_free(
+		          &( pypff_property_set->property_set ),
+		          &error );
+
+		Py_END_ALLOW_THREADS
+
+		if( result != 1 )
+		{
+			pypff_error_raise(
+			 error,
+			 PyExc_MemoryError,
+			 "%s: unable to free libpff property set.",
+			 function );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	ob_type->tp_free(
+	 (PyObject*) pypff_property_set );
+}
+
+/* Copies a value type from a Python object
+ * If the value type object is None the flags are set to match any value type
+ * Returns 1 if successful or -1 on error
+ */
+int pypff_property_set_copy_value_type_from_object(
+     PyObject *value_type_object,
+     uint32_t *value_type,
+     uint8_t *flags )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "pypff_property_set_copy_value_type_from_object";
+	uint64_t value_64bit     = 0;
+
+	if( value_type == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid value type.",
+		 function );
+
+		return( -1 );
+	}
+	if( flags == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_type_object == NULL )
+	 || ( value_type_object == Py_None ) )
+	{
+		*value_type = 0;
+		*flags      = LIBPFF_ENTRY_VALUE_FLAG_MATCH_ANY_VALUE_TYPE;
+
+		return( 1 );
+	}
+	if( pypff_integer_unsigned_copy_to_64bit(
+	     value_type_object,
+	     &value_64bit,
+	     &error ) != 1 )
+	{
+		pypff_error_raise(
+		 error,
+		 PyExc_ValueError,
+		 "%s: unable to convert value type.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( -1 );
+	}
+	if( value_64bit > (uint64_t) UINT32_MAX )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid value type value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*value_type = (uint32_t) value_64bit;
+	*flags      = 0;
+
+	return( 1 );
+}
+
+/* Copies a GUID from a Python binary string object
+ * Returns 1 if successful or -1 on error
+ */
+int pypff_property_set_copy_guid_from_object(
+     PyObject *guid_object,
+     uint8_t *guid,
+     size_t guid_size )
+{
+	char *guid_data       = NULL;
+	static char *function = "pypff_property_set_copy_guid_from_object";
+	Py_ssize_t data_size  = 0;
+	int result            = 0;
+
+	if( guid == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid GUID.",
+		 function );
+
+		return( -1 );
+	}
+	if( guid_size < 16 )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid GUID size value too small.",
+		 function );
+
+		return( -1 );
+	}
+#if PY_MAJOR_VERSION >= 3
+	result = PyBytes_Check(
+	          guid_object );
+#else
+	result = PyString_Check(
+	          guid_object );
+#endif
+	if( result == 0 )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: unsupported GUID object type.",
+		 function );
+
+		return( -1 );
+	}
+#if PY_MAJOR_VERSION >= 3
+	result = PyBytes_AsStringAndSize(
+	          guid_object,
+	          &guid_data,
+	          &data_size );
+#else
+	result = PyString_AsStringAndSize(
+	          guid_object,
+	          &guid_data,
+	          &data_size );
+#endif
+	if( result == -1 )
+	{
+		return( -1 );
+	}
+	if( data_size != 16 )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid GUID size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     guid,
+	     guid_data,
+	     16 ) == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to copy GUID.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Appends a request for a property by its entry type
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pypff_property_set_append_entry_type(
+           pypff_property_set_t *pypff_property_set,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	PyObject *integer_object    = NULL;
+	PyObject *value_type_object = NULL;
+	libcerror_error_t *error    = NULL;
+	static char *function       = "pypff_property_set_append_entry_type";
+	static char *keyword_list[] = { "entry_type", "value_type", NULL };
+	unsigned long entry_type    = 0;
+	uint32_t value_type         = 0;
+	uint8_t flags               = 0;
+	int request_index           = 0;
+	int result                  = 0;
+
+	if( pypff_property_set == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid property set.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "k|O",
+	     keyword_list,
+	     &entry_type,
+	     &value_type_object ) == 0 )
+	{
+		return( NULL );
+	}
+	if( entry_type > (unsigned long) UINT32_MAX )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid entry type value out of bounds.",
+		 function );
+
+		return( NULL );
+	}
+	if( pypff_property_set_copy_value_type_from_object(
+	     value_type_object,
+	     &value_type,
+	     &flags ) != 1 )
+	{
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libpff_property_set_append_entry_type(
+	          pypff_property_set->property_set,
+	          (uint32_t) entry_type,
+	          value_type,
+	          flags,
+	          &request_index,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pypff_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to append entry type request.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+#if PY_MAJOR_VERSION >= 3
+	integer_object = PyLong_FromLong(
+	                  (long) request_index );
+#else
+	integer_object = PyInt_FromLong(
+	                  (long) request_index );
+#endif
+	return( integer_object );
+}
+
+/* Appends a request for a named property by its property set GUID and number
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pypff_property_set_append_numeric_name(
+           pypff_property_set_t *pypff_property_set,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	uint8_t guid[ 16 ];
+
+	PyObject *guid_object       = NULL;
+	PyObject *integer_object    = NULL;
+	PyObject *value_type_object = NULL;
+	libcerror_error_t *error    = NULL;
+	static char *function       = "pypff_property_set_append_numeric_name";
+	static char *keyword_list[] = { "guid", "number", "value_type", NULL };
+	unsigned long number        = 0;
+	uint32_t value_type         = 0;
+	uint8_t flags               = 0;
+	int request_index           = 0;
+	int result                  = 0;
+
+	if( pypff_property_set == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid property set.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "Ok|O",
+	     keyword_list,
+	     &guid_object,
+	     &number,
+	     &value_type_object ) == 0 )
+	{
+		return( NULL );
+	}
+	if( number > (unsigned long) UINT32_MAX )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid number value out of bounds.",
+		 function );
+
+		return( NULL );
+	}
+	if( pypff_property_set_copy_guid_from_object(
+	     guid_object,
+	     guid,
+	     16 ) != 1 )
+	{
+		return( NULL );
+	}
+	if( pypff_property_set_copy_value_type_from_object(
+	     value_type_object,
+	     &value_type,
+	     &flags ) != 1 )
+	{
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libpff_property_set_append_numeric_name(
+	          pypff_property_set->property_set,
+	          guid,
+	          16,
+	          (uint32_t) number,
+	          value_type,
+	          flags,
+	          &request_index,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pypff_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to append numeric name request.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+#if PY_MAJOR_VERSION >= 3
+	integer_object = PyLong_FromLong(
+	                  (long) request_index );
+#else
+	integer_object = PyInt_FromLong(
+	                  (long) request_index );
+#endif
+	return( integer_object );
+}
+
+/* Appends a request for a named property by its property set GUID and name
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pypff_property_set_append_string_name(
+           pypff_property_set_t *pypff_property_set,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	uint8_t guid[ 16 ];
+
+	PyObject *guid_object        = NULL;
+	PyObject *integer_object     = NULL;
+	PyObject *string_object      = NULL;
+	PyObject *utf8_string_object = NULL;
+	PyObject *value_type_object  = NULL;
+	libcerror_error_t *error     = NULL;
+	char *utf8_string            = NULL;
+	static char *function        = "pypff_property_set_append_string_name";
+	static char *keyword_list[]  = { "guid", "name", "value_type", NULL };
+	Py_ssize_t utf8_string_size  = 0;
+	uint32_t value_type          = 0;
+	uint8_t flags                = 0;
+	int request_index            = 0;
+	int result                   = 0;
+
+	if( pypff_property_set == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid property set.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "OO|O",
+	     keyword_list,
+	     &guid_object,
+	     &string_object,
+	     &value_type_object ) == 0 )
+	{
+		return( NULL );
+	}
+	if( pypff_property_set_copy_guid_from_object(
+	     guid_object,
+	     guid,
+	     16 ) != 1 )
+	{
+		return( NULL );
+	}
+	if( pypff_property_set_copy_value_type_from_object(
+	     value_type_object,
+	     &value_type,
+	     &flags ) != 1 )
+	{
+		return( NULL );
+	}
+	PyErr_Clear();
+
+	result = PyObject_IsInstance(
+	          string_object,
+	          (PyObject *) &PyUnicode_Type );
+
+	if( result == -1 )
+	{
+		pypff_error_fetch_and_raise(
+		 PyExc_RuntimeError,
+		 "%s: unable to determine if string object is of type unicode.",
+		 function );
+
+		return( NULL );
+	}
+	else if( result == 0 )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: unsupported string object type.",
+		 function );
+
+		return( NULL );
+	}
+	PyErr_Clear();
+
+	utf8_string_object = PyUnicode_AsUTF8String(
+	                      string_object );
+
+	if( utf8_string_object == NULL )
+	{
+		pypff_error_fetch_and_raise(
+		 PyExc_RuntimeError,
+		 "%s: unable to convert unicode string to UTF-8.",
+		 function );
+
+		return( NULL );
+	}
+#if PY_MAJOR_VERSION >= 3
+	result = PyBytes_AsStringAndSize(
+	          utf8_string_object,
+	          &utf8_string,
+	          &utf8_string_size );
+#else
+	result = PyString_AsStringAndSize(
+	          utf8_string_object,
+	          &utf8_string,
+	          &utf8_string_size );
+#endif
+	if( result == -1 )
+	{
+		Py_DecRef(
+		 utf8_string_object );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libpff_property_set_append_utf8_name(
+	          pypff_property_set->property_set,
+	          guid,
+	          16,
+	          (uint8_t *) utf8_string,
+	          (size_t) utf8_string_size,
+	          value_type,
+	          flags,
+	          &request_index,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	Py_DecRef(
+	 utf8_string_object );
+
+	if( result != 1 )
+	{
+		pypff_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to append string name request.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+#if PY_MAJOR_VERSION >= 3
+	integer_object = PyLong_FromLong(
+	                  (long) request_index );
+#else
+	integer_object = PyInt_FromLong(
+	                  (long) request_index );
+#endif
+	return( integer_object );
+}
+
+/* Retrieves the number of requests
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pypff_property_set_get_number_of_requests(
+           pypff_property_set_t *pypff_property_set,
+           PyObject *arguments PYPFF_ATTRIBUTE_UNUSED )
+{
+	PyObject *integer_object = NULL;
+	libcerror_error_t *error = NULL;
+	static char *function    = "pypff_property_set_get_number_of_requests";
+	int number_of_requests   = 0;
+	int result               = 0;
+
+	PYPFF_UNREFERENCED_PARAMETER( arguments )
+
+	if( pypff_property_set == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid property set.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libpff_property_set_get_number_of_requests(
+	          pypff_property_set->property_set,
+	          &number_of_requests,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pypff_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve number of requests.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+#if PY_MAJOR_VERSION >= 3
+	integer_object = PyLong_FromLong(
+	                  (long) number_of_requests );
+#else
+	integer_object = PyInt_FromLong(
+	                  (long) number_of_requests );
+#endif
+	return( integer_object );
+}
+
+/* Determines if the property set was prepared
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pypff_property_set_is_prepared(
+           pypff_property_set_t *pypff_property_set,
+           PyObject *arguments PYPFF_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "pypff_property_set_is_prepared";
+	int result               = 0;
+
+	PYPFF_UNREFERENCED_PARAMETER( arguments )
+
+	if( pypff_property_set == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid property set.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libpff_property_set_is_prepared(
+	          pypff_property_set->property_set,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result == -1 )
+	{
+		pypff_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to determine if property set was prepared.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	if( result != 0 )
+	{
+		Py_IncRef(
+		 (PyObject *) Py_True );
+
+		return( Py_True );
+	}
+	Py_IncRef(
+	 (PyObject *) Py_False );
+
+	return( Py_False );
+}
+
@@ -0,0 +1,95 @@
+/*
+ * Python object definition of the libpff property set
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _PYPFF_PROPERTY_SET_H )
+#define _PYPFF_PROPERTY_SET_H
+
+#include <common.h>
+#include <types.h>
+
+#include "pypff_libpff.h"
+#include "pypff_python.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct pypff_property_set pypff_property_set_t;
+
+struct pypff_property_set
+{
+	/* Python object initialization
+	 */
+	PyObject_HEAD
+
+	/* The libpff property set
+	 */
+	libpff_property_set_t *property_set;
+};
+
+extern PyMethodDef pypff_property_set_object_methods[];
+extern PyTypeObject pypff_property_set_type_object;
+
+int pypff_property_set_init(
+     pypff_property_set_t *pypff_property_set );
+
+void pypff_property_set_free(
+      pypff_property_set_t *pypff_property_set );
+
+int pypff_property_set_copy_value_type_from_object(
+     PyObject *value_type_object,
+     uint32_t *value_type,
+     uint8_t *flags );
+
+int pypff_property_set_copy_guid_from_object(
+     PyObject *guid_object,
+     uint8_t *guid,
+     size_t guid_size );
+
+PyObject *pypff_property_set_append_entry_type(
+           pypff_property_set_t *pypff_property_set,
+           PyObject *arguments,
+           PyObject *keywords );
+
+PyObject *pypff_property_set_append_numeric_name(
+           pypff_property_set_t *pypff_property_set,
+           PyObject *arguments,
+           PyObject *keywords );
+
+PyObject *pypff_property_set_append_string_name(
+           pypff_property_set_t *pypff_property_set,
+           PyObject *arguments,
+           PyObject *keywords );
+
+PyObject *pypff_property_set_get_number_of_requests(
+           pypff_property_set_t *pypff_property_set,
+           PyObject *arguments );
+
+PyObject *pypff_property_set_is_prepared(
+           pypff_property_set_t *pypff_property_set,
+           PyObject *arguments );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _PYPFF_PROPERTY_SET_H ) */
+
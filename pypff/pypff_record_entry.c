@@ -547,7 +547,7 @@ PyObject *pypff_record_entry_get_data(
 {
 	PyObject *bytes_object   = NULL;
 	libcerror_error_t *error = NULL;
-	char *data               = NULL;
+	const uint8_t *data      = NULL;
 	static char *function    = "pypff_record_entry_get_data";
 	size_t data_size         = 0;
 	int result               = 0;
@@ -563,29 +563,33 @@ PyObject *pypff_record_entry_get_data(
 
 		return( NULL );
 	}
+	/* The data is owned by the record entry, which is kept alive by the
+	 * Python object, hence it does not need to be copied into a temporary buffer
+	 */
 	Py_BEGIN_ALLOW_THREADS
 
-	result = libpff_record_entry_get_data_size(
+	result = libpff_record_entry_get_data_pointer(
 	          pypff_record_entry->record_entry,
+	          &data,
 	          &data_size,
 	          &error );
 
 	Py_END_ALLOW_THREADS
 
-	if( result == -1 )
+	if( result != 1 )
 	{
 		pypff_error_raise(
 		 error,
 		 PyExc_IOError,
-		 "%s: unable to retrieve data size.",
+		 "%s: unable to retrieve data.",
 		 function );
 
 		libcerror_error_free(
 		 &error );
 
-		goto on_error;
+		return( NULL );
 	}
-	else if( ( result == 0 )
+	else if( ( data == NULL )
 	      || ( data_size == 0 ) )
 	{
 		Py_IncRef(
@@ -593,50 +597,15 @@ PyObject *pypff_record_entry_get_data(
 
 		return( Py_None );
 	}
-	data = (char *) PyMem_Malloc(
-	                 sizeof( char ) * data_size );
-
-	if( data == NULL )
-	{
-		PyErr_Format(
-		 PyExc_MemoryError,
-		 "%s: unable to create data.",
-		 function );
-
-		goto on_error;
-	}
-	Py_BEGIN_ALLOW_THREADS
-
-	result = libpff_record_entry_get_data(
-	          pypff_record_entry->record_entry,
-	          (uint8_t *) data,
-	          data_size,
-	          &error );
-
-	Py_END_ALLOW_THREADS
-
-	if( result != 1 )
-	{
-		pypff_error_raise(
-		 error,
-		 PyExc_IOError,
-		 "%s: unable to retrieve data.",
-		 function );
-
-		libcerror_error_free(
-		 &error );
-
-		goto on_error;
-	}
 	/* This is a binary string so include the full size
 	 */
 #if PY_MAJOR_VERSION >= 3
 	bytes_object = PyBytes_FromStringAndSize(
-	                data,
+	                (char *) data,
 	                (Py_ssize_t) data_size );
 #else
 	bytes_object = PyString_FromStringAndSize(
-	                data,
+	                (char *) data,
 	                (Py_ssize_t) data_size );
 #endif
 	if( bytes_object == NULL )
@@ -646,20 +615,9 @@ PyObject *pypff_record_entry_get_data(
 		 "%s: unable to convert data into Bytes object.",
 		 function );
 
-		goto on_error;
+		return( NULL );
 	}
-	PyMem_Free(
-	 data );
-
 	return( bytes_object );
-
-on_error:
-	if( data != NULL )
-	{
-		PyMem_Free(
-		 data );
-	}
-	return( NULL );
 }
 
 /* Retrieves the data as a boolean value
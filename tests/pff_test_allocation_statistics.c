@@ -0,0 +1,980 @@
+/*
+ * Library allocation statistics functions test program
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "pff_test_libcerror.h"
+#include "pff_test_libpff.h"
+#include "pff_test_macros.h"
+#include "pff_test_unused.h"
+
+#include "../libpff/libpff_allocation_statistics.h"
+
+/* An allocation bitmap with the runs (in allocation units):
+ * allocated 68, unallocated 24, allocated 5, unallocated 1, allocated 1,
+ * unallocated 1, allocated 1, unallocated 1, allocated 1, unallocated 24
+ * and allocated 1
+ */
+uint8_t pff_test_allocation_statistics_bitmap_data1[ 16 ] = {
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0, 0x00, 0x00, 0x0f, 0xaa, 0x00, 0x00, 0x01 };
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+/* Compares the values of allocation statistics
+ * Returns 1 if equal, 0 if not
+ */
+int pff_test_allocation_statistics_compare(
+     libpff_internal_allocation_statistics_t *first_allocation_statistics,
+     libpff_internal_allocation_statistics_t *second_allocation_statistics )
+{
+	int histogram_bucket_index = 0;
+
+	if( ( first_allocation_statistics->allocated_size != second_allocation_statistics->allocated_size )
+	 || ( first_allocation_statistics->unallocated_size != second_allocation_statistics->unallocated_size )
+	 || ( first_allocation_statistics->number_of_allocated_extents != second_allocation_statistics->number_of_allocated_extents )
+	 || ( first_allocation_statistics->number_of_unallocated_extents != second_allocation_statistics->number_of_unallocated_extents )
+	 || ( first_allocation_statistics->largest_unallocated_extent_size != second_allocation_statistics->largest_unallocated_extent_size ) )
+	{
+		return( 0 );
+	}
+	for( histogram_bucket_index = 0;
+	     histogram_bucket_index < LIBPFF_ALLOCATION_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS;
+	     histogram_bucket_index++ )
+	{
+		if( ( first_allocation_statistics->allocated_extents_histogram[ histogram_bucket_index ] != second_allocation_statistics->allocated_extents_histogram[ histogram_bucket_index ] )
+		 || ( first_allocation_statistics->unallocated_extents_histogram[ histogram_bucket_index ] != second_allocation_statistics->unallocated_extents_histogram[ histogram_bucket_index ] ) )
+		{
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
+
+/* Tests the libpff_allocation_statistics_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_allocation_statistics_initialize(
+     void )
+{
+	libcerror_error_t *error                              = NULL;
+	libpff_allocation_statistics_t *allocation_statistics = NULL;
+	int result                                            = 0;
+
+	/* Test regular cases
+	 */
+	result = libpff_allocation_statistics_initialize(
+	          &allocation_statistics,
+	          64,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "allocation_statistics",
+	 allocation_statistics );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_allocation_statistics_free(
+	          &allocation_statistics,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "allocation_statistics",
+	 allocation_statistics );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_allocation_statistics_initialize(
+	          NULL,
+	          64,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	allocation_statistics = (libpff_allocation_statistics_t *) 0x12345678UL;
+
+	result = libpff_allocation_statistics_initialize(
+	          &allocation_statistics,
+	          64,
+	          &error );
+
+	allocation_statistics = NULL;
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_allocation_statistics_initialize(
+	          &allocation_statistics,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( allocation_statistics != NULL )
+	{
+		libpff_allocation_statistics_free(
+		 &allocation_statistics,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+/* Tests the libpff_allocation_statistics_free function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_allocation_statistics_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libpff_allocation_statistics_free(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+/* Tests the libpff_allocation_statistics_get_number_of_leading_zero_bits function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_allocation_statistics_get_number_of_leading_zero_bits(
+     void )
+{
+	int number_of_bits = 0;
+
+	number_of_bits = libpff_allocation_statistics_get_number_of_leading_zero_bits(
+	                  0x8000000000000000ULL );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_bits",
+	 number_of_bits,
+	 0 );
+
+	number_of_bits = libpff_allocation_statistics_get_number_of_leading_zero_bits(
+	                  0x0000000100000000ULL );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_bits",
+	 number_of_bits,
+	 31 );
+
+	number_of_bits = libpff_allocation_statistics_get_number_of_leading_zero_bits(
+	                  1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_bits",
+	 number_of_bits,
+	 63 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libpff_allocation_statistics_read_bitmap function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_allocation_statistics_read_bitmap(
+     void )
+{
+	libcerror_error_t *error                              = NULL;
+	libpff_allocation_statistics_t *allocation_statistics = NULL;
+	libpff_internal_allocation_statistics_t *statistics   = NULL;
+	int result                                            = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_allocation_statistics_initialize(
+	          &allocation_statistics,
+	          64,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "allocation_statistics",
+	 allocation_statistics );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	statistics = (libpff_internal_allocation_statistics_t *) allocation_statistics;
+
+	/* Test regular cases
+	 */
+	result = libpff_allocation_statistics_read_bitmap(
+	          statistics,
+	          pff_test_allocation_statistics_bitmap_data1,
+	          16,
+	          128,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_allocation_statistics_finalize(
+	          statistics,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics->allocated_size",
+	 (uint64_t) statistics->allocated_size,
+	 (uint64_t) 77 * 64 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics->unallocated_size",
+	 (uint64_t) statistics->unallocated_size,
+	 (uint64_t) 51 * 64 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics->number_of_allocated_extents",
+	 statistics->number_of_allocated_extents,
+	 (uint64_t) 6 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics->number_of_unallocated_extents",
+	 statistics->number_of_unallocated_extents,
+	 (uint64_t) 5 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics->largest_unallocated_extent_size",
+	 (uint64_t) statistics->largest_unallocated_extent_size,
+	 (uint64_t) 24 * 64 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics->allocated_extents_histogram[ 0 ]",
+	 statistics->allocated_extents_histogram[ 0 ],
+	 (uint64_t) 4 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics->allocated_extents_histogram[ 2 ]",
+	 statistics->allocated_extents_histogram[ 2 ],
+	 (uint64_t) 1 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics->allocated_extents_histogram[ 6 ]",
+	 statistics->allocated_extents_histogram[ 6 ],
+	 (uint64_t) 1 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics->unallocated_extents_histogram[ 0 ]",
+	 statistics->unallocated_extents_histogram[ 0 ],
+	 (uint64_t) 3 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics->unallocated_extents_histogram[ 4 ]",
+	 statistics->unallocated_extents_histogram[ 4 ],
+	 (uint64_t) 2 );
+
+	/* Clean up
+	 */
+	result = libpff_allocation_statistics_free(
+	          &allocation_statistics,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a bitmap that is limited by the number of units
+	 */
+	result = libpff_allocation_statistics_initialize(
+	          &allocation_statistics,
+	          64,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	statistics = (libpff_internal_allocation_statistics_t *) allocation_statistics;
+
+	result = libpff_allocation_statistics_read_bitmap(
+	          statistics,
+	          pff_test_allocation_statistics_bitmap_data1,
+	          16,
+	          100,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_allocation_statistics_finalize(
+	          statistics,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics->allocated_size",
+	 (uint64_t) statistics->allocated_size,
+	 (uint64_t) 74 * 64 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics->unallocated_size",
+	 (uint64_t) statistics->unallocated_size,
+	 (uint64_t) 26 * 64 );
+
+	/* Test error cases
+	 */
+	result = libpff_allocation_statistics_read_bitmap(
+	          NULL,
+	          pff_test_allocation_statistics_bitmap_data1,
+	          16,
+	          128,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_allocation_statistics_read_bitmap(
+	          statistics,
+	          NULL,
+	          16,
+	          128,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_allocation_statistics_free(
+	          &allocation_statistics,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( allocation_statistics != NULL )
+	{
+		libpff_allocation_statistics_free(
+		 &allocation_statistics,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_allocation_statistics_merge function
+ * The statistics of a bitmap read in segments must match those of
+ * the bitmap read at once
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_allocation_statistics_merge(
+     void )
+{
+	libcerror_error_t *error                            = NULL;
+	libpff_allocation_statistics_t *expected_statistics = NULL;
+	libpff_allocation_statistics_t *merged_statistics   = NULL;
+	libpff_allocation_statistics_t *segment_statistics  = NULL;
+	int result                                          = 0;
+	int segment_index                                   = 0;
+	int split_offset                                    = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_allocation_statistics_initialize(
+	          &expected_statistics,
+	          64,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libpff_allocation_statistics_read_bitmap(
+	          (libpff_internal_allocation_statistics_t *) expected_statistics,
+	          pff_test_allocation_statistics_bitmap_data1,
+	          16,
+	          128,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libpff_allocation_statistics_finalize(
+	          (libpff_internal_allocation_statistics_t *) expected_statistics,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test regular cases
+	 */
+	for( split_offset = 1;
+	     split_offset < 16;
+	     split_offset++ )
+	{
+		result = libpff_allocation_statistics_initialize(
+		          &merged_statistics,
+		          64,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		/* Read the bitmap in 3 segments: [0, split_offset), [split_offset, 15) and [15, 16)
+		 */
+		for( segment_index = 0;
+		     segment_index < 3;
+		     segment_index++ )
+		{
+			result = libpff_allocation_statistics_initialize(
+			          &segment_statistics,
+			          64,
+			          &error );
+
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			if( segment_index == 0 )
+			{
+				result = libpff_allocation_statistics_read_bitmap(
+				          (libpff_internal_allocation_statistics_t *) segment_statistics,
+				          pff_test_allocation_statistics_bitmap_data1,
+				          (size_t) split_offset,
+				          128,
+				          &error );
+			}
+			else if( segment_index == 1 )
+			{
+				result = libpff_allocation_statistics_read_bitmap(
+				          (libpff_internal_allocation_statistics_t *) segment_statistics,
+				          &( pff_test_allocation_statistics_bitmap_data1[ split_offset ] ),
+				          (size_t) ( 15 - split_offset ),
+				          128,
+				          &error );
+			}
+			else
+			{
+				result = libpff_allocation_statistics_read_bitmap(
+				          (libpff_internal_allocation_statistics_t *) segment_statistics,
+				          &( pff_test_allocation_statistics_bitmap_data1[ 15 ] ),
+				          1,
+				          128,
+				          &error );
+			}
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			result = libpff_allocation_statistics_merge(
+			          (libpff_internal_allocation_statistics_t *) merged_statistics,
+			          (libpff_internal_allocation_statistics_t *) segment_statistics,
+			          &error );
+
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = libpff_allocation_statistics_free(
+			          &segment_statistics,
+			          &error );
+
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+		}
+		result = libpff_allocation_statistics_finalize(
+		          (libpff_internal_allocation_statistics_t *) merged_statistics,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = pff_test_allocation_statistics_compare(
+		          (libpff_internal_allocation_statistics_t *) expected_statistics,
+		          (libpff_internal_allocation_statistics_t *) merged_statistics );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = libpff_allocation_statistics_free(
+		          &merged_statistics,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	/* Test error cases
+	 */
+	result = libpff_allocation_statistics_merge(
+	          NULL,
+	          (libpff_internal_allocation_statistics_t *) expected_statistics,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_allocation_statistics_merge(
+	          (libpff_internal_allocation_statistics_t *) expected_statistics,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_allocation_statistics_free(
+	          &expected_statistics,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( segment_statistics != NULL )
+	{
+		libpff_allocation_statistics_free(
+		 &segment_statistics,
+		 NULL );
+	}
+	if( merged_statistics != NULL )
+	{
+		libpff_allocation_statistics_free(
+		 &merged_statistics,
+		 NULL );
+	}
+	if( expected_statistics != NULL )
+	{
+		libpff_allocation_statistics_free(
+		 &expected_statistics,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_allocation_statistics_get_unallocated_extents_histogram_value function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_allocation_statistics_get_unallocated_extents_histogram_value(
+     void )
+{
+	libcerror_error_t *error                              = NULL;
+	libpff_allocation_statistics_t *allocation_statistics = NULL;
+	uint64_t number_of_extents                            = 0;
+	int result                                            = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_allocation_statistics_initialize(
+	          &allocation_statistics,
+	          64,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libpff_allocation_statistics_read_bitmap(
+	          (libpff_internal_allocation_statistics_t *) allocation_statistics,
+	          pff_test_allocation_statistics_bitmap_data1,
+	          16,
+	          128,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libpff_allocation_statistics_finalize(
+	          (libpff_internal_allocation_statistics_t *) allocation_statistics,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test regular cases
+	 */
+	result = libpff_allocation_statistics_get_unallocated_extents_histogram_value(
+	          allocation_statistics,
+	          4,
+	          &number_of_extents,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_extents",
+	 number_of_extents,
+	 (uint64_t) 2 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_allocation_statistics_get_unallocated_extents_histogram_value(
+	          NULL,
+	          4,
+	          &number_of_extents,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_allocation_statistics_get_unallocated_extents_histogram_value(
+	          allocation_statistics,
+	          LIBPFF_ALLOCATION_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS,
+	          &number_of_extents,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_allocation_statistics_get_unallocated_extents_histogram_value(
+	          allocation_statistics,
+	          4,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_allocation_statistics_free(
+	          &allocation_statistics,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( allocation_statistics != NULL )
+	{
+		libpff_allocation_statistics_free(
+		 &allocation_statistics,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PFF_TEST_UNREFERENCED_PARAMETER( argc )
+	PFF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+	PFF_TEST_RUN(
+	 "libpff_allocation_statistics_initialize",
+	 pff_test_allocation_statistics_initialize );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+	PFF_TEST_RUN(
+	 "libpff_allocation_statistics_free",
+	 pff_test_allocation_statistics_free );
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+	PFF_TEST_RUN(
+	 "libpff_allocation_statistics_get_number_of_leading_zero_bits",
+	 pff_test_allocation_statistics_get_number_of_leading_zero_bits );
+
+	PFF_TEST_RUN(
+	 "libpff_allocation_statistics_read_bitmap",
+	 pff_test_allocation_statistics_read_bitmap );
+
+	PFF_TEST_RUN(
+	 "libpff_allocation_statistics_merge",
+	 pff_test_allocation_statistics_merge );
+
+	PFF_TEST_RUN(
+	 "libpff_allocation_statistics_get_unallocated_extents_histogram_value",
+	 pff_test_allocation_statistics_get_unallocated_extents_histogram_value );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -37,6 +38,8 @@
 #include "pff_test_unused.h"
 
 #include "../libpff/libpff_allocation_table.h"
+#include "../libpff/libpff_definitions.h"
+#include "../libpff/libpff_io_handle.h"
 
 uint8_t pff_test_allocation_table_data_32bit[ 512 ] = {
 	0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
@@ -369,6 +372,228 @@ uint8_t pff_test_allocation_table_data_64bit_4k_page[ 4096 ] = {
 
 #if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
 
+/* Tests the libpff_allocation_table_read_header_data function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_allocation_table_read_header_data(
+     void )
+{
+	uint8_t data[ 512 ];
+
+	libcerror_error_t *error      = NULL;
+	const uint8_t *table_data     = NULL;
+	size_t table_data_size        = 0;
+	off64_t back_pointer_offset   = 0;
+	uint8_t allocation_table_type = 0;
+	int result                    = 0;
+
+	/* Test regular cases
+	 */
+	result = libpff_allocation_table_read_header_data(
+	          pff_test_allocation_table_data_32bit,
+	          512,
+	          LIBPFF_FILE_TYPE_32BIT,
+	          &allocation_table_type,
+	          &back_pointer_offset,
+	          &table_data,
+	          &table_data_size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "allocation_table_type",
+	 allocation_table_type,
+	 LIBPFF_ALLOCATION_TABLE_TYPE_DATA );
+
+	PFF_TEST_ASSERT_EQUAL_INT64(
+	 "back_pointer_offset",
+	 (int64_t) back_pointer_offset,
+	 (int64_t) 0x4400 );
+
+	PFF_TEST_ASSERT_EQUAL_SIZE(
+	 "table_data_size",
+	 table_data_size,
+	 (size_t) 496 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "table_data",
+	 (int) ( table_data == &( pff_test_allocation_table_data_32bit[ 4 ] ) ),
+	 1 );
+
+	result = libpff_allocation_table_read_header_data(
+	          pff_test_allocation_table_data_64bit,
+	          512,
+	          LIBPFF_FILE_TYPE_64BIT,
+	          &allocation_table_type,
+	          &back_pointer_offset,
+	          &table_data,
+	          &table_data_size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "allocation_table_type",
+	 allocation_table_type,
+	 LIBPFF_ALLOCATION_TABLE_TYPE_DATA );
+
+	PFF_TEST_ASSERT_EQUAL_INT64(
+	 "back_pointer_offset",
+	 (int64_t) back_pointer_offset,
+	 (int64_t) 0x4400 );
+
+	PFF_TEST_ASSERT_EQUAL_SIZE(
+	 "table_data_size",
+	 table_data_size,
+	 (size_t) 496 );
+
+	/* Test error cases
+	 */
+	result = libpff_allocation_table_read_header_data(
+	          NULL,
+	          512,
+	          LIBPFF_FILE_TYPE_32BIT,
+	          &allocation_table_type,
+	          &back_pointer_offset,
+	          &table_data,
+	          &table_data_size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_allocation_table_read_header_data(
+	          pff_test_allocation_table_data_32bit,
+	          511,
+	          LIBPFF_FILE_TYPE_32BIT,
+	          &allocation_table_type,
+	          &back_pointer_offset,
+	          &table_data,
+	          &table_data_size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_allocation_table_read_header_data(
+	          pff_test_allocation_table_data_32bit,
+	          512,
+	          0xff,
+	          &allocation_table_type,
+	          &back_pointer_offset,
+	          &table_data,
+	          &table_data_size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_allocation_table_read_header_data(
+	          pff_test_allocation_table_data_32bit,
+	          512,
+	          LIBPFF_FILE_TYPE_32BIT,
+	          NULL,
+	          &back_pointer_offset,
+	          &table_data,
+	          &table_data_size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the checksum does not match
+	 */
+	memory_copy(
+	 data,
+	 pff_test_allocation_table_data_32bit,
+	 512 );
+
+	data[ 4 ] ^= 0xff;
+
+	result = libpff_allocation_table_read_header_data(
+	          data,
+	          512,
+	          LIBPFF_FILE_TYPE_32BIT,
+	          &allocation_table_type,
+	          &back_pointer_offset,
+	          &table_data,
+	          &table_data_size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* Tests the libpff_allocation_table_read_data function
  * Returns 1 if successful or 0 if not
  */
@@ -592,10 +817,30 @@ int pff_test_allocation_table_read_file_io_handle(
 	libbfio_handle_t *file_io_handle              = NULL;
 	libcdata_range_list_t *unallocated_block_list = NULL;
 	libcerror_error_t *error                      = NULL;
+	libpff_io_handle_t *io_handle                 = NULL;
 	int result                                    = 0;
 
 	/* Initialize test
 	 */
+	result = libpff_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->file_type = LIBPFF_FILE_TYPE_32BIT;
+
 	result = libcdata_range_list_initialize(
 	          &unallocated_block_list,
 	          &error );
@@ -638,9 +883,9 @@ int pff_test_allocation_table_read_file_io_handle(
 	 */
 	result = libpff_allocation_table_read_file_io_handle(
 	          unallocated_block_list,
+	          io_handle,
 	          file_io_handle,
 	          0,
-	          LIBPFF_FILE_TYPE_32BIT,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -656,9 +901,9 @@ int pff_test_allocation_table_read_file_io_handle(
 	 */
 	result = libpff_allocation_table_read_file_io_handle(
 	          NULL,
+	          io_handle,
 	          file_io_handle,
 	          0,
-	          LIBPFF_FILE_TYPE_32BIT,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -676,8 +921,27 @@ int pff_test_allocation_table_read_file_io_handle(
 	result = libpff_allocation_table_read_file_io_handle(
 	          unallocated_block_list,
 	          NULL,
+	          file_io_handle,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_allocation_table_read_file_io_handle(
+	          unallocated_block_list,
+	          io_handle,
+	          NULL,
 	          0,
-	          LIBPFF_FILE_TYPE_32BIT,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -694,9 +958,9 @@ int pff_test_allocation_table_read_file_io_handle(
 
 	result = libpff_allocation_table_read_file_io_handle(
 	          unallocated_block_list,
+	          io_handle,
 	          file_io_handle,
 	          -1,
-	          LIBPFF_FILE_TYPE_32BIT,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -711,11 +975,67 @@ int pff_test_allocation_table_read_file_io_handle(
 	libcerror_error_free(
 	 &error );
 
+	io_handle->file_type = 0xff;
+
 	result = libpff_allocation_table_read_file_io_handle(
 	          unallocated_block_list,
+	          io_handle,
+	          file_io_handle,
+	          0,
+	          &error );
+
+	io_handle->file_type = LIBPFF_FILE_TYPE_32BIT;
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the read budget is exhausted
+	 */
+	result = libpff_io_handle_set_read_budget(
+	          io_handle,
+	          0,
+	          1,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_allocation_table_read_file_io_handle(
+	          unallocated_block_list,
+	          io_handle,
+	          file_io_handle,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_allocation_table_read_file_io_handle(
+	          unallocated_block_list,
+	          io_handle,
 	          file_io_handle,
 	          0,
-	          0xff,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -730,6 +1050,26 @@ int pff_test_allocation_table_read_file_io_handle(
 	libcerror_error_free(
 	 &error );
 
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "io_handle->read_limits_exceeded",
+	 io_handle->read_limits_exceeded,
+	 1 );
+
+	result = libpff_io_handle_set_read_budget(
+	          io_handle,
+	          0,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 #if defined( HAVE_PFF_TEST_MEMORY )
 
 	/* Test libpff_allocation_table_read_file_io_handle with malloc failing
@@ -738,9 +1078,9 @@ int pff_test_allocation_table_read_file_io_handle(
 
 	result = libpff_allocation_table_read_file_io_handle(
 	          unallocated_block_list,
+	          io_handle,
 	          file_io_handle,
 	          0,
-	          LIBPFF_FILE_TYPE_32BIT,
 	          &error );
 
 	if( pff_test_malloc_attempts_before_fail != -1 )
@@ -780,6 +1120,23 @@ int pff_test_allocation_table_read_file_io_handle(
 
 	/* Clean up
 	 */
+	result = libpff_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	result = libcdata_range_list_free(
 	          &unallocated_block_list,
 	          NULL,
@@ -812,6 +1169,12 @@ on_error:
 		 &file_io_handle,
 		 NULL );
 	}
+	if( io_handle != NULL )
+	{
+		libpff_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
 	if( unallocated_block_list != NULL )
 	{
 		libcdata_range_list_free(
@@ -841,6 +1204,10 @@ int main(
 
 #if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
 
+	PFF_TEST_RUN(
+	 "libpff_allocation_table_read_header_data",
+	 pff_test_allocation_table_read_header_data );
+
 	PFF_TEST_RUN(
 	 "libpff_allocation_table_read_data",
 	 pff_test_allocation_table_read_data );
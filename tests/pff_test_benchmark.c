@@ -0,0 +1,1145 @@
+/*
+ * Library kernels benchmark program
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if !defined( WINAPI )
+#include <time.h>
+#endif
+
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#include <x86intrin.h>
+
+#define PFF_TEST_BENCHMARK_HAVE_CYCLE_COUNTER	1
+#endif
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#include "pff_test_getopt.h"
+#include "pff_test_libcerror.h"
+#include "pff_test_libfmapi.h"
+#include "pff_test_libpff.h"
+#include "pff_test_unused.h"
+
+#include "../libpff/libpff_data_block.h"
+#include "../libpff/libpff_deflate.h"
+#include "../libpff/libpff_definitions.h"
+#include "../libpff/libpff_encryption.h"
+#include "../libpff/libpff_index_node.h"
+#include "../libpff/libpff_io_handle.h"
+#include "../libpff/libpff_mapi_value.h"
+#include "../libpff/libpff_table.h"
+#include "../libpff/libpff_table_block_index.h"
+
+#define PFF_TEST_BENCHMARK_MAXIMUM_DATA_SIZE	65536
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+typedef struct pff_test_benchmark_context pff_test_benchmark_context_t;
+
+struct pff_test_benchmark_context
+{
+	/* The input data
+	 */
+	uint8_t *input_data;
+
+	/* The input data size
+	 */
+	size_t input_data_size;
+
+	/* The output data
+	 */
+	uint8_t *output_data;
+
+	/* The output data size
+	 */
+	size_t output_data_size;
+
+	/* The IO handle
+	 */
+	libpff_io_handle_t *io_handle;
+
+	/* The data block
+	 */
+	libpff_data_block_t *data_block;
+
+	/* The index node
+	 */
+	libpff_index_node_t *index_node;
+
+	/* The table
+	 */
+	libpff_table_t *table;
+};
+
+typedef struct pff_test_benchmark_definition pff_test_benchmark_definition_t;
+
+struct pff_test_benchmark_definition
+{
+	/* The name
+	 */
+	const char *name;
+
+	/* The name of the input file in the data directory
+	 */
+	const system_character_t *filename;
+
+	/* The parameter passed to the kernel
+	 */
+	int parameter;
+
+	/* The function that runs a single operation of the kernel
+	 */
+	int (*run_function)(
+	       pff_test_benchmark_context_t *context,
+	       int parameter,
+	       libcerror_error_t **error );
+};
+
+/* Reads a file from the data directory
+ * Returns 1 if successful or -1 on error
+ */
+int pff_test_benchmark_read_data_file(
+     const system_character_t *directory,
+     const system_character_t *filename,
+     uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	system_character_t path[ 1024 ];
+
+	FILE *file_stream       = NULL;
+	static char *function   = "pff_test_benchmark_read_data_file";
+	size_t directory_length = 0;
+	size_t filename_length  = 0;
+	size_t read_count       = 0;
+
+	if( directory == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	directory_length = system_string_length(
+	                    directory );
+
+	filename_length = system_string_length(
+	                   filename );
+
+	if( ( directory_length + filename_length + 2 ) > 1024 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid path length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( system_string_copy(
+	     path,
+	     directory,
+	     directory_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy directory.",
+		 function );
+
+		return( -1 );
+	}
+	path[ directory_length ] = (system_character_t) '/';
+
+	if( system_string_copy(
+	     &( path[ directory_length + 1 ] ),
+	     filename,
+	     filename_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy filename.",
+		 function );
+
+		return( -1 );
+	}
+	path[ directory_length + filename_length + 1 ] = 0;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	file_stream = file_stream_open_wide(
+	               path,
+	               _SYSTEM_STRING( "rb" ) );
+#else
+	file_stream = file_stream_open(
+	               path,
+	               "rb" );
+#endif
+	if( file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file: %" PRIs_SYSTEM ".",
+		 function,
+		 path );
+
+		return( -1 );
+	}
+	*data = (uint8_t *) memory_allocate(
+	                     sizeof( uint8_t ) * PFF_TEST_BENCHMARK_MAXIMUM_DATA_SIZE );
+
+	if( *data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = file_stream_read(
+	              file_stream,
+	              *data,
+	              PFF_TEST_BENCHMARK_MAXIMUM_DATA_SIZE );
+
+	if( ( read_count == 0 )
+	 || ( read_count >= PFF_TEST_BENCHMARK_MAXIMUM_DATA_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file: %" PRIs_SYSTEM " or unsupported file size.",
+		 function,
+		 path );
+
+		goto on_error;
+	}
+	*data_size = read_count;
+
+	file_stream_close(
+	 file_stream );
+
+	return( 1 );
+
+on_error:
+	if( *data != NULL )
+	{
+		memory_free(
+		 *data );
+
+		*data = NULL;
+	}
+	file_stream_close(
+	 file_stream );
+
+	return( -1 );
+}
+
+/* Retrieves a monotonic time stamp in nanoseconds
+ */
+uint64_t pff_test_benchmark_get_time(
+          void )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+	QueryPerformanceCounter(
+	 &counter );
+
+	QueryPerformanceFrequency(
+	 &frequency );
+
+	return( (uint64_t) ( ( (double) counter.QuadPart * 1000000000.0 ) / (double) frequency.QuadPart ) );
+#else
+	struct timespec time_specification;
+
+	clock_gettime(
+	 CLOCK_MONOTONIC,
+	 &time_specification );
+
+	return( ( (uint64_t) time_specification.tv_sec * 1000000000UL ) + (uint64_t) time_specification.tv_nsec );
+#endif
+}
+
+/* Retrieves the processor cycle counter or 0 if not supported
+ */
+uint64_t pff_test_benchmark_get_cycles(
+          void )
+{
+#if defined( PFF_TEST_BENCHMARK_HAVE_CYCLE_COUNTER )
+	return( (uint64_t) __rdtsc() );
+#else
+	return( 0 );
+#endif
+}
+
+/* Runs libpff_encryption_decrypt
+ * The data is decrypted in place, the cost does not depend on the content
+ * Returns 1 if successful or -1 on error
+ */
+int pff_test_benchmark_run_encryption_decrypt(
+     pff_test_benchmark_context_t *context,
+     int parameter,
+     libcerror_error_t **error )
+{
+	ssize_t process_count = 0;
+
+	process_count = libpff_encryption_decrypt(
+	                 (uint8_t) parameter,
+	                 0x2a3fc61e,
+	                 context->output_data,
+	                 context->input_data_size,
+	                 error );
+
+	if( process_count != (ssize_t) context->input_data_size )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Runs libpff_deflate_decompress_zlib
+ * Returns 1 if successful or -1 on error
+ */
+int pff_test_benchmark_run_deflate_decompress(
+     pff_test_benchmark_context_t *context,
+     int parameter PFF_TEST_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	size_t uncompressed_data_size = PFF_TEST_BENCHMARK_MAXIMUM_DATA_SIZE;
+
+	PFF_TEST_UNREFERENCED_PARAMETER( parameter )
+
+	return( libpff_deflate_decompress_zlib(
+	         context->input_data,
+	         context->input_data_size,
+	         context->output_data,
+	         &uncompressed_data_size,
+	         error ) );
+}
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+
+/* Runs the zlib uncompress function as reference for libpff_deflate_decompress_zlib
+ * Returns 1 if successful or -1 on error
+ */
+int pff_test_benchmark_run_zlib_uncompress(
+     pff_test_benchmark_context_t *context,
+     int parameter PFF_TEST_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	static char *function         = "pff_test_benchmark_run_zlib_uncompress";
+	uLongf uncompressed_data_size = PFF_TEST_BENCHMARK_MAXIMUM_DATA_SIZE;
+
+	PFF_TEST_UNREFERENCED_PARAMETER( parameter )
+
+	if( uncompress(
+	     (Bytef *) context->output_data,
+	     &uncompressed_data_size,
+	     (Bytef *) context->input_data,
+	     (uLong) context->input_data_size ) != Z_OK )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+		 "%s: unable to decompress data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL ) */
+
+/* Runs libfmapi_checksum_calculate_weak_crc32
+ * Returns 1 if successful or -1 on error
+ */
+int pff_test_benchmark_run_weak_crc32(
+     pff_test_benchmark_context_t *context,
+     int parameter PFF_TEST_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	uint32_t checksum = 0;
+
+	PFF_TEST_UNREFERENCED_PARAMETER( parameter )
+
+	return( libfmapi_checksum_calculate_weak_crc32(
+	         &checksum,
+	         context->input_data,
+	         context->input_data_size,
+	         0,
+	         error ) );
+}
+
+/* Runs libpff_index_node_read_data
+ * Returns 1 if successful or -1 on error
+ */
+int pff_test_benchmark_run_index_node_read_data(
+     pff_test_benchmark_context_t *context,
+     int parameter,
+     libcerror_error_t **error )
+{
+	return( libpff_index_node_read_data(
+	         context->index_node,
+	         context->input_data,
+	         context->input_data_size,
+	         (uint8_t) parameter,
+	         error ) );
+}
+
+/* Runs libpff_table_read_index_entries
+ * The table block index is recreated per operation since reading appends to it
+ * Returns 1 if successful or -1 on error
+ */
+int pff_test_benchmark_run_table_read_index_entries(
+     pff_test_benchmark_context_t *context,
+     int parameter PFF_TEST_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	libpff_table_block_index_t *table_block_index = NULL;
+	int result                                    = 0;
+
+	PFF_TEST_UNREFERENCED_PARAMETER( parameter )
+
+	if( libpff_table_block_index_initialize(
+	     &table_block_index,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	result = libpff_table_read_index_entries(
+	          context->table,
+	          context->data_block,
+	          table_block_index,
+	          0,
+	          error );
+
+	if( libpff_table_block_index_free(
+	     &table_block_index,
+	     error ) != 1 )
+	{
+		result = -1;
+	}
+	return( result );
+}
+
+/* Runs libpff_mapi_value_get_data_as_utf8_string
+ * Returns 1 if successful or -1 on error
+ */
+int pff_test_benchmark_run_string_conversion(
+     pff_test_benchmark_context_t *context,
+     int parameter,
+     libcerror_error_t **error )
+{
+	size_t utf8_string_size = 0;
+
+	if( libpff_mapi_value_get_data_as_utf8_string_size(
+	     (uint32_t) parameter,
+	     context->input_data,
+	     context->input_data_size,
+	     LIBPFF_CODEPAGE_WINDOWS_1252,
+	     &utf8_string_size,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	return( libpff_mapi_value_get_data_as_utf8_string(
+	         (uint32_t) parameter,
+	         context->input_data,
+	         context->input_data_size,
+	         LIBPFF_CODEPAGE_WINDOWS_1252,
+	         context->output_data,
+	         utf8_string_size,
+	         error ) );
+}
+
+/* The benchmarks
+ */
+pff_test_benchmark_definition_t pff_test_benchmarks[] = {
+	{ "libpff_encryption_decrypt_compressible", _SYSTEM_STRING( "encryption.1" ), LIBPFF_ENCRYPTION_TYPE_COMPRESSIBLE, &pff_test_benchmark_run_encryption_decrypt },
+	{ "libpff_encryption_decrypt_high", _SYSTEM_STRING( "encryption.1" ), LIBPFF_ENCRYPTION_TYPE_HIGH, &pff_test_benchmark_run_encryption_decrypt },
+	{ "libpff_deflate_decompress_zlib", _SYSTEM_STRING( "deflate.1" ), 0, &pff_test_benchmark_run_deflate_decompress },
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+	{ "zlib_uncompress", _SYSTEM_STRING( "deflate.1" ), 0, &pff_test_benchmark_run_zlib_uncompress },
+#endif
+	{ "libfmapi_checksum_calculate_weak_crc32", _SYSTEM_STRING( "data_block.3" ), 0, &pff_test_benchmark_run_weak_crc32 },
+	{ "libpff_index_node_read_data_32bit", _SYSTEM_STRING( "index_node.1" ), LIBPFF_FILE_TYPE_32BIT, &pff_test_benchmark_run_index_node_read_data },
+	{ "libpff_index_node_read_data_64bit", _SYSTEM_STRING( "index_node.2" ), LIBPFF_FILE_TYPE_64BIT, &pff_test_benchmark_run_index_node_read_data },
+	{ "libpff_index_node_read_data_64bit_4k_page", _SYSTEM_STRING( "index_node.3" ), LIBPFF_FILE_TYPE_64BIT_4K_PAGE, &pff_test_benchmark_run_index_node_read_data },
+	{ "libpff_table_read_index_entries", _SYSTEM_STRING( "table.1" ), 0, &pff_test_benchmark_run_table_read_index_entries },
+	{ "libpff_mapi_value_get_data_as_utf8_string_ascii", _SYSTEM_STRING( "deflate.1" ), LIBPFF_VALUE_TYPE_STRING_ASCII, &pff_test_benchmark_run_string_conversion },
+	{ "libpff_mapi_value_get_data_as_utf8_string_unicode", _SYSTEM_STRING( "deflate.1" ), LIBPFF_VALUE_TYPE_STRING_UNICODE, &pff_test_benchmark_run_string_conversion },
+
+	/* Sentinel */
+	{ NULL, NULL, 0, NULL }
+};
+
+/* Prepares the context of a specific benchmark
+ * Returns 1 if successful or -1 on error
+ */
+int pff_test_benchmark_context_prepare(
+     pff_test_benchmark_context_t *context,
+     pff_test_benchmark_definition_t *benchmark,
+     libcerror_error_t **error )
+{
+	static char *function         = "pff_test_benchmark_context_prepare";
+	size_t text_index             = 0;
+	size_t uncompressed_data_size = PFF_TEST_BENCHMARK_MAXIMUM_DATA_SIZE;
+
+	if( ( benchmark->run_function == &pff_test_benchmark_run_encryption_decrypt )
+	 || ( benchmark->run_function == &pff_test_benchmark_run_deflate_decompress ) )
+	{
+		if( memory_copy(
+		     context->output_data,
+		     context->input_data,
+		     context->input_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy input data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( benchmark->run_function == &pff_test_benchmark_run_table_read_index_entries )
+	{
+		context->data_block->data                   = context->input_data;
+		context->data_block->uncompressed_data_size = (uint32_t) context->input_data_size;
+	}
+	else if( benchmark->run_function == &pff_test_benchmark_run_string_conversion )
+	{
+		/* The strings are the text in the deflate compressed data
+		 */
+		if( libpff_deflate_decompress_zlib(
+		     context->input_data,
+		     context->input_data_size,
+		     context->output_data,
+		     &uncompressed_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress text.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( benchmark->parameter == LIBPFF_VALUE_TYPE_STRING_UNICODE )
+		 && ( ( uncompressed_data_size * 2 ) > PFF_TEST_BENCHMARK_MAXIMUM_DATA_SIZE ) )
+		{
+			uncompressed_data_size = PFF_TEST_BENCHMARK_MAXIMUM_DATA_SIZE / 2;
+		}
+		for( text_index = 0;
+		     text_index < uncompressed_data_size;
+		     text_index++ )
+		{
+			if( benchmark->parameter == LIBPFF_VALUE_TYPE_STRING_UNICODE )
+			{
+				context->input_data[ text_index * 2 ]         = context->output_data[ text_index ];
+				context->input_data[ ( text_index * 2 ) + 1 ] = 0;
+			}
+			else
+			{
+				context->input_data[ text_index ] = context->output_data[ text_index ];
+			}
+		}
+		context->input_data_size = uncompressed_data_size;
+
+		if( benchmark->parameter == LIBPFF_VALUE_TYPE_STRING_UNICODE )
+		{
+			context->input_data_size *= 2;
+		}
+	}
+	return( 1 );
+}
+
+/* Compares two 64-bit unsigned integers for sorting
+ */
+int pff_test_benchmark_compare_uint64(
+     const void *first_value,
+     const void *second_value )
+{
+	uint64_t first_value_64bit  = *( (const uint64_t *) first_value );
+	uint64_t second_value_64bit = *( (const uint64_t *) second_value );
+
+	if( first_value_64bit < second_value_64bit )
+	{
+		return( -1 );
+	}
+	else if( first_value_64bit > second_value_64bit )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Runs a specific benchmark
+ * The number of iterations is doubled until a run lasts at least the minimum time,
+ * after which the measured runs are repeated and the median is reported
+ * Returns 1 if successful or -1 on error
+ */
+int pff_test_benchmark_run(
+     pff_test_benchmark_context_t *context,
+     pff_test_benchmark_definition_t *benchmark,
+     uint64_t minimum_run_time,
+     int number_of_runs,
+     int output_json,
+     int is_first_benchmark,
+     libcerror_error_t **error )
+{
+	uint64_t run_cycles[ 64 ];
+	uint64_t run_times[ 64 ];
+
+	double cycles_per_byte        = 0.0;
+	double nanoseconds_median     = 0.0;
+	double nanoseconds_minimum    = 0.0;
+	double operations_per_second  = 0.0;
+	uint64_t iteration            = 0;
+	uint64_t number_of_iterations = 1;
+	uint64_t start_cycles         = 0;
+	uint64_t start_time           = 0;
+	int run_index                 = 0;
+
+	/* Calibrate the number of iterations, this also warms up the caches
+	 */
+	do
+	{
+		start_time = pff_test_benchmark_get_time();
+
+		for( iteration = 0;
+		     iteration < number_of_iterations;
+		     iteration++ )
+		{
+			if( benchmark->run_function(
+			     context,
+			     benchmark->parameter,
+			     error ) != 1 )
+			{
+				return( -1 );
+			}
+		}
+		if( ( pff_test_benchmark_get_time() - start_time ) >= minimum_run_time )
+		{
+			break;
+		}
+		number_of_iterations *= 2;
+	}
+	while( number_of_iterations < ( (uint64_t) 1 << 40 ) );
+
+	for( run_index = 0;
+	     run_index < number_of_runs;
+	     run_index++ )
+	{
+		start_cycles = pff_test_benchmark_get_cycles();
+		start_time   = pff_test_benchmark_get_time();
+
+		for( iteration = 0;
+		     iteration < number_of_iterations;
+		     iteration++ )
+		{
+			if( benchmark->run_function(
+			     context,
+			     benchmark->parameter,
+			     error ) != 1 )
+			{
+				return( -1 );
+			}
+		}
+		run_times[ run_index ]  = pff_test_benchmark_get_time() - start_time;
+		run_cycles[ run_index ] = pff_test_benchmark_get_cycles() - start_cycles;
+	}
+	qsort(
+	 run_times,
+	 (size_t) number_of_runs,
+	 sizeof( uint64_t ),
+	 &pff_test_benchmark_compare_uint64 );
+
+	qsort(
+	 run_cycles,
+	 (size_t) number_of_runs,
+	 sizeof( uint64_t ),
+	 &pff_test_benchmark_compare_uint64 );
+
+	nanoseconds_minimum   = (double) run_times[ 0 ] / (double) number_of_iterations;
+	nanoseconds_median    = (double) run_times[ number_of_runs / 2 ] / (double) number_of_iterations;
+	operations_per_second = ( nanoseconds_median > 0.0 ) ? ( 1000000000.0 / nanoseconds_median ) : 0.0;
+	cycles_per_byte       = (double) run_cycles[ number_of_runs / 2 ] / ( (double) number_of_iterations * (double) context->input_data_size );
+
+	if( output_json != 0 )
+	{
+		fprintf(
+		 stdout,
+		 "%s\n    { \"name\": \"%s\", \"bytes_per_operation\": %" PRIzd ", \"iterations\": %" PRIu64 ", \"runs\": %d, "
+		 "\"nanoseconds_per_operation_median\": %.2f, \"nanoseconds_per_operation_minimum\": %.2f, "
+		 "\"operations_per_second\": %.2f, \"megabytes_per_second\": %.2f, ",
+		 ( is_first_benchmark != 0 ) ? "" : ",",
+		 benchmark->name,
+		 context->input_data_size,
+		 number_of_iterations,
+		 number_of_runs,
+		 nanoseconds_median,
+		 nanoseconds_minimum,
+		 operations_per_second,
+		 ( operations_per_second * (double) context->input_data_size ) / 1000000.0 );
+
+#if defined( PFF_TEST_BENCHMARK_HAVE_CYCLE_COUNTER )
+		fprintf(
+		 stdout,
+		 "\"cycles_per_byte\": %.3f }",
+		 cycles_per_byte );
+#else
+		fprintf(
+		 stdout,
+		 "\"cycles_per_byte\": null }" );
+#endif
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "%-50s %6" PRIzd " %12.2f %14.2f %10.2f",
+		 benchmark->name,
+		 context->input_data_size,
+		 nanoseconds_median,
+		 operations_per_second,
+		 ( operations_per_second * (double) context->input_data_size ) / 1000000.0 );
+
+#if defined( PFF_TEST_BENCHMARK_HAVE_CYCLE_COUNTER )
+		fprintf(
+		 stdout,
+		 " %12.3f\n",
+		 cycles_per_byte );
+#else
+		fprintf(
+		 stdout,
+		 " %12s\n",
+		 "n/a" );
+#endif
+	}
+	return( 1 );
+}
+
+/* Parses a decimal number from a system string
+ * Returns the number or -1 if not a valid number
+ */
+int pff_test_benchmark_parse_number(
+     const system_character_t *string )
+{
+	int value = 0;
+
+	if( ( string == NULL )
+	 || ( *string == 0 ) )
+	{
+		return( -1 );
+	}
+	while( *string != 0 )
+	{
+		if( ( *string < (system_character_t) '0' )
+		 || ( *string > (system_character_t) '9' )
+		 || ( value > 100000000 ) )
+		{
+			return( -1 );
+		}
+		value = ( value * 10 ) + (int) ( *string - (system_character_t) '0' );
+
+		string++;
+	}
+	return( value );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc,
+     wchar_t * const argv[] )
+#else
+int main(
+     int argc,
+     char * const argv[] )
+#endif
+{
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+	pff_test_benchmark_context_t context;
+
+	libcerror_error_t *error                   = NULL;
+	pff_test_benchmark_definition_t *benchmark = NULL;
+	system_character_t *data_directory         = _SYSTEM_STRING( "data" );
+	system_integer_t option                    = 0;
+	int benchmark_index                        = 0;
+	int minimum_run_time                       = 100;
+	int number_of_runs                         = 5;
+	int output_json                            = 0;
+
+	while( ( option = pff_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "d:jr:t:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) 'd':
+				data_directory = optarg;
+
+				break;
+
+			case (system_integer_t) 'j':
+				output_json = 1;
+
+				break;
+
+			case (system_integer_t) 'r':
+				number_of_runs = pff_test_benchmark_parse_number(
+				                  optarg );
+
+				if( ( number_of_runs < 1 )
+				 || ( number_of_runs > 64 ) )
+				{
+					fprintf(
+					 stderr,
+					 "Unsupported number of runs, should be 1 - 64.\n" );
+
+					return( EXIT_FAILURE );
+				}
+				break;
+
+			case (system_integer_t) 't':
+				minimum_run_time = pff_test_benchmark_parse_number(
+				                    optarg );
+
+				if( minimum_run_time < 1 )
+				{
+					fprintf(
+					 stderr,
+					 "Unsupported minimum run time in milliseconds.\n" );
+
+					return( EXIT_FAILURE );
+				}
+				break;
+
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Usage: pff_test_benchmark [ -d directory ] [ -r runs ] [ -t milliseconds ] [ -j ]\n\n"
+				 "\t-d: directory containing the test data, default is data\n"
+				 "\t-j: output the results as JSON\n"
+				 "\t-r: number of measured runs, the median is reported, default is 5\n"
+				 "\t-t: minimum duration of a run in milliseconds, default is 100\n" );
+
+				return( EXIT_FAILURE );
+		}
+	}
+	if( memory_set(
+	     &context,
+	     0,
+	     sizeof( pff_test_benchmark_context_t ) ) == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to clear context.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	context.output_data = (uint8_t *) memory_allocate(
+	                                   sizeof( uint8_t ) * PFF_TEST_BENCHMARK_MAXIMUM_DATA_SIZE );
+
+	if( context.output_data == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create output data.\n" );
+
+		goto on_error;
+	}
+	context.output_data_size = PFF_TEST_BENCHMARK_MAXIMUM_DATA_SIZE;
+
+	if( libpff_io_handle_initialize(
+	     &( context.io_handle ),
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create IO handle.\n" );
+
+		goto on_error;
+	}
+	if( libpff_data_block_initialize(
+	     &( context.data_block ),
+	     context.io_handle,
+	     0,
+	     0,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create data block.\n" );
+
+		goto on_error;
+	}
+	if( libpff_index_node_initialize(
+	     &( context.index_node ),
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create index node.\n" );
+
+		goto on_error;
+	}
+	if( libpff_table_initialize(
+	     &( context.table ),
+	     0,
+	     0,
+	     0,
+	     0,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create table.\n" );
+
+		goto on_error;
+	}
+	if( output_json != 0 )
+	{
+		fprintf(
+		 stdout,
+		 "{\n  \"minimum_run_time_milliseconds\": %d,\n  \"runs\": %d,\n  \"benchmarks\": [",
+		 minimum_run_time,
+		 number_of_runs );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "%-50s %6s %12s %14s %10s %12s\n",
+		 "Benchmark",
+		 "Bytes",
+		 "ns/op",
+		 "ops/s",
+		 "MB/s",
+		 "cycles/byte" );
+	}
+	for( benchmark_index = 0;
+	     pff_test_benchmarks[ benchmark_index ].name != NULL;
+	     benchmark_index++ )
+	{
+		benchmark = &( pff_test_benchmarks[ benchmark_index ] );
+
+		if( pff_test_benchmark_read_data_file(
+		     data_directory,
+		     benchmark->filename,
+		     &( context.input_data ),
+		     &( context.input_data_size ),
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read data of benchmark: %s.\n",
+			 benchmark->name );
+
+			goto on_error;
+		}
+		if( pff_test_benchmark_context_prepare(
+		     &context,
+		     benchmark,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to prepare benchmark: %s.\n",
+			 benchmark->name );
+
+			goto on_error;
+		}
+		if( pff_test_benchmark_run(
+		     &context,
+		     benchmark,
+		     (uint64_t) minimum_run_time * 1000000,
+		     number_of_runs,
+		     output_json,
+		     benchmark_index == 0,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to run benchmark: %s.\n",
+			 benchmark->name );
+
+			goto on_error;
+		}
+		context.data_block->data = NULL;
+
+		memory_free(
+		 context.input_data );
+
+		context.input_data = NULL;
+	}
+	if( output_json != 0 )
+	{
+		fprintf(
+		 stdout,
+		 "\n  ]\n}\n" );
+	}
+	libpff_table_free(
+	 &( context.table ),
+	 NULL );
+	libpff_index_node_free(
+	 &( context.index_node ),
+	 NULL );
+	libpff_data_block_free(
+	 &( context.data_block ),
+	 NULL );
+	libpff_io_handle_free(
+	 &( context.io_handle ),
+	 NULL );
+	memory_free(
+	 context.output_data );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( context.table != NULL )
+	{
+		libpff_table_free(
+		 &( context.table ),
+		 NULL );
+	}
+	if( context.index_node != NULL )
+	{
+		libpff_index_node_free(
+		 &( context.index_node ),
+		 NULL );
+	}
+	if( context.data_block != NULL )
+	{
+		context.data_block->data = NULL;
+
+		libpff_data_block_free(
+		 &( context.data_block ),
+		 NULL );
+	}
+	if( context.io_handle != NULL )
+	{
+		libpff_io_handle_free(
+		 &( context.io_handle ),
+		 NULL );
+	}
+	if( context.input_data != NULL )
+	{
+		memory_free(
+		 context.input_data );
+	}
+	if( context.output_data != NULL )
+	{
+		memory_free(
+		 context.output_data );
+	}
+	return( EXIT_FAILURE );
+
+#else
+	PFF_TEST_UNREFERENCED_PARAMETER( argc )
+	PFF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	fprintf(
+	 stderr,
+	 "Benchmarks require the internal library functions.\n" );
+
+	return( EXIT_SUCCESS );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+}
+
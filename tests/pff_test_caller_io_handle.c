@@ -0,0 +1,1578 @@
+/*
+ * Library caller_io_handle type test program
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "pff_test_libcerror.h"
+#include "pff_test_libpff.h"
+#include "pff_test_macros.h"
+#include "pff_test_memory.h"
+#include "pff_test_unused.h"
+
+#include "../libpff/libpff_caller_io_handle.h"
+#include "../libpff/libpff_libbfio.h"
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+/* Tests the libpff_caller_io_handle_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_caller_io_handle_initialize(
+     void )
+{
+	libcerror_error_t *error                    = NULL;
+	libpff_caller_io_handle_t *caller_io_handle = NULL;
+	int result                                  = 0;
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+	int number_of_malloc_fail_tests             = 1;
+	int number_of_memset_fail_tests             = 1;
+	int test_number                             = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libpff_caller_io_handle_initialize(
+	          &caller_io_handle,
+	          4096,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "caller_io_handle",
+	 caller_io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_caller_io_handle_free(
+	          &caller_io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "caller_io_handle",
+	 caller_io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_caller_io_handle_initialize(
+	          NULL,
+	          4096,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	caller_io_handle = (libpff_caller_io_handle_t *) 0x12345678UL;
+
+	result = libpff_caller_io_handle_initialize(
+	          &caller_io_handle,
+	          4096,
+	          &error );
+
+	caller_io_handle = NULL;
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libpff_caller_io_handle_initialize with malloc failing
+		 */
+		pff_test_malloc_attempts_before_fail = test_number;
+
+		result = libpff_caller_io_handle_initialize(
+		          &caller_io_handle,
+		          4096,
+		          &error );
+
+		if( pff_test_malloc_attempts_before_fail != -1 )
+		{
+			pff_test_malloc_attempts_before_fail = -1;
+
+			if( caller_io_handle != NULL )
+			{
+				libpff_caller_io_handle_free(
+				 &caller_io_handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "caller_io_handle",
+			 caller_io_handle );
+
+			PFF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libpff_caller_io_handle_initialize with memset failing
+		 */
+		pff_test_memset_attempts_before_fail = test_number;
+
+		result = libpff_caller_io_handle_initialize(
+		          &caller_io_handle,
+		          4096,
+		          &error );
+
+		if( pff_test_memset_attempts_before_fail != -1 )
+		{
+			pff_test_memset_attempts_before_fail = -1;
+
+			if( caller_io_handle != NULL )
+			{
+				libpff_caller_io_handle_free(
+				 &caller_io_handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "caller_io_handle",
+			 caller_io_handle );
+
+			PFF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_PFF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( caller_io_handle != NULL )
+	{
+		libpff_caller_io_handle_free(
+		 &caller_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_caller_io_handle_free function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_caller_io_handle_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libpff_caller_io_handle_free(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_caller_io_handle_read function with supplied and pending data
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_caller_io_handle_read(
+     void )
+{
+	uint8_t buffer[ 32 ];
+	uint8_t data[ 16 ];
+
+	libcerror_error_t *error                    = NULL;
+	libpff_caller_io_handle_t *caller_io_handle = NULL;
+	size64_t pending_read_size                  = 0;
+	ssize_t read_count                          = 0;
+	off64_t offset                              = 0;
+	off64_t pending_read_offset                 = 0;
+	size_t data_index                           = 0;
+	int result                                  = 0;
+
+	for( data_index = 0;
+	     data_index < 16;
+	     data_index++ )
+	{
+		data[ data_index ] = (uint8_t) data_index;
+	}
+	/* Initialize test
+	 */
+	result = libpff_caller_io_handle_initialize(
+	          &caller_io_handle,
+	          32,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "caller_io_handle",
+	 caller_io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_caller_io_handle_open(
+	          caller_io_handle,
+	          LIBBFIO_ACCESS_FLAG_READ,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_caller_io_handle_supply_data(
+	          caller_io_handle,
+	          0,
+	          data,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	read_count = libpff_caller_io_handle_read(
+	              caller_io_handle,
+	              buffer,
+	              8,
+	              &error );
+
+	PFF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 8 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 7 ]",
+	 buffer[ 7 ],
+	 7 );
+
+	result = libpff_caller_io_handle_get_pending_read(
+	          caller_io_handle,
+	          &pending_read_offset,
+	          &pending_read_size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a read that extends beyond the supplied data
+	 */
+	read_count = libpff_caller_io_handle_read(
+	              caller_io_handle,
+	              buffer,
+	              16,
+	              &error );
+
+	PFF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_caller_io_handle_get_pending_read(
+	          caller_io_handle,
+	          &pending_read_offset,
+	          &pending_read_size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_INT64(
+	 "pending_read_offset",
+	 (int64_t) pending_read_offset,
+	 (int64_t) 16 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "pending_read_size",
+	 (uint64_t) pending_read_size,
+	 (uint64_t) 8 );
+
+	/* Supply the pending data and retry the read
+	 */
+	result = libpff_caller_io_handle_supply_data(
+	          caller_io_handle,
+	          16,
+	          data,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_caller_io_handle_get_pending_read(
+	          caller_io_handle,
+	          &pending_read_offset,
+	          &pending_read_size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libpff_caller_io_handle_read(
+	              caller_io_handle,
+	              buffer,
+	              16,
+	              &error );
+
+	PFF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 16 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0 ]",
+	 buffer[ 0 ],
+	 8 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 8 ]",
+	 buffer[ 8 ],
+	 0 );
+
+	/* Test a read at the end of the data
+	 */
+	read_count = libpff_caller_io_handle_read(
+	              caller_io_handle,
+	              buffer,
+	              16,
+	              &error );
+
+	PFF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 8 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libpff_caller_io_handle_seek_offset(
+	          caller_io_handle,
+	          0,
+	          SEEK_END,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 32 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libpff_caller_io_handle_read(
+	              caller_io_handle,
+	              buffer,
+	              16,
+	              &error );
+
+	PFF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	read_count = libpff_caller_io_handle_read(
+	              NULL,
+	              buffer,
+	              16,
+	              &error );
+
+	PFF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_caller_io_handle_supply_data(
+	          caller_io_handle,
+	          24,
+	          data,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_caller_io_handle_close(
+	          caller_io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_caller_io_handle_free(
+	          &caller_io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "caller_io_handle",
+	 caller_io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( caller_io_handle != NULL )
+	{
+		libpff_caller_io_handle_free(
+		 &caller_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_caller_io_handle_supply_data function with overlapping and adjacent data
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_caller_io_handle_supply_data(
+     void )
+{
+	uint8_t buffer[ 32 ];
+	uint8_t data[ 32 ];
+
+	libcerror_error_t *error                    = NULL;
+	libpff_caller_io_handle_t *caller_io_handle = NULL;
+	libpff_caller_io_segment_t *segment         = NULL;
+	size64_t pending_read_size                  = 0;
+	ssize_t read_count                          = 0;
+	off64_t offset                              = 0;
+	off64_t pending_read_offset                 = 0;
+	size_t data_index                           = 0;
+	int number_of_segments                      = 0;
+	int result                                  = 0;
+
+	for( data_index = 0;
+	     data_index < 32;
+	     data_index++ )
+	{
+		data[ data_index ] = (uint8_t) data_index;
+	}
+	/* Initialize test
+	 */
+	result = libpff_caller_io_handle_initialize(
+	          &caller_io_handle,
+	          32,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "caller_io_handle",
+	 caller_io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_caller_io_handle_open(
+	          caller_io_handle,
+	          LIBBFIO_ACCESS_FLAG_READ,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test supplying data out of order
+	 */
+	result = libpff_caller_io_handle_supply_data(
+	          caller_io_handle,
+	          16,
+	          &( data[ 16 ] ),
+	          8,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_caller_io_handle_supply_data(
+	          caller_io_handle,
+	          0,
+	          data,
+	          8,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_get_number_of_entries(
+	          caller_io_handle->segments_array,
+	          &number_of_segments,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_segments",
+	 number_of_segments,
+	 2 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test supplying data that overlaps both segments
+	 */
+	result = libpff_caller_io_handle_supply_data(
+	          caller_io_handle,
+	          4,
+	          &( data[ 4 ] ),
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_get_number_of_entries(
+	          caller_io_handle->segments_array,
+	          &number_of_segments,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_segments",
+	 number_of_segments,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_caller_io_handle_get_segment_at_offset(
+	          caller_io_handle,
+	          10,
+	          &segment,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "segment",
+	 segment );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_INT64(
+	 "segment->offset",
+	 (int64_t) segment->offset,
+	 (int64_t) 0 );
+
+	PFF_TEST_ASSERT_EQUAL_SIZE(
+	 "segment->data_size",
+	 segment->data_size,
+	 (size_t) 24 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "segment->data[ 23 ]",
+	 segment->data[ 23 ],
+	 23 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "caller_io_handle->supplied_data_size",
+	 (uint64_t) caller_io_handle->supplied_data_size,
+	 (uint64_t) 24 );
+
+	result = libpff_caller_io_handle_get_segment_at_offset(
+	          caller_io_handle,
+	          24,
+	          &segment,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test supplying data that lies within a segment
+	 */
+	result = libpff_caller_io_handle_supply_data(
+	          caller_io_handle,
+	          2,
+	          &( data[ 2 ] ),
+	          4,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a pending read that is covered by adjacent segments
+	 */
+	offset = libpff_caller_io_handle_seek_offset(
+	          caller_io_handle,
+	          20,
+	          SEEK_SET,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 20 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libpff_caller_io_handle_read(
+	              caller_io_handle,
+	              buffer,
+	              12,
+	              &error );
+
+	PFF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_caller_io_handle_get_pending_read(
+	          caller_io_handle,
+	          &pending_read_offset,
+	          &pending_read_size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_INT64(
+	 "pending_read_offset",
+	 (int64_t) pending_read_offset,
+	 (int64_t) 24 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "pending_read_size",
+	 (uint64_t) pending_read_size,
+	 (uint64_t) 8 );
+
+	result = libpff_caller_io_handle_supply_data(
+	          caller_io_handle,
+	          28,
+	          &( data[ 28 ] ),
+	          4,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_caller_io_handle_get_pending_read(
+	          caller_io_handle,
+	          &pending_read_offset,
+	          &pending_read_size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_caller_io_handle_supply_data(
+	          caller_io_handle,
+	          24,
+	          &( data[ 24 ] ),
+	          4,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_caller_io_handle_get_pending_read(
+	          caller_io_handle,
+	          &pending_read_offset,
+	          &pending_read_size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_get_number_of_entries(
+	          caller_io_handle->segments_array,
+	          &number_of_segments,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_segments",
+	 number_of_segments,
+	 3 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libpff_caller_io_handle_read(
+	              caller_io_handle,
+	              buffer,
+	              12,
+	              &error );
+
+	PFF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 12 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0 ]",
+	 buffer[ 0 ],
+	 20 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 11 ]",
+	 buffer[ 11 ],
+	 31 );
+
+	/* Test clearing the pending read
+	 */
+	caller_io_handle->has_pending_read = 1;
+
+	result = libpff_caller_io_handle_clear_pending_read(
+	          caller_io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "caller_io_handle->has_pending_read",
+	 caller_io_handle->has_pending_read,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libpff_caller_io_handle_supply_data(
+	          caller_io_handle,
+	          0,
+	          NULL,
+	          8,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_caller_io_handle_clear_pending_read(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_caller_io_handle_close(
+	          caller_io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_caller_io_handle_free(
+	          &caller_io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "caller_io_handle",
+	 caller_io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( caller_io_handle != NULL )
+	{
+		libpff_caller_io_handle_free(
+		 &caller_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_caller_io_handle_release_data function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_caller_io_handle_release_data(
+     void )
+{
+	uint8_t data[ 32 ];
+
+	libcerror_error_t *error                    = NULL;
+	libpff_caller_io_handle_t *caller_io_handle = NULL;
+	libpff_caller_io_segment_t *segment         = NULL;
+	size64_t supplied_data_size                 = 0;
+	size_t data_index                           = 0;
+	int number_of_segments                      = 0;
+	int result                                  = 0;
+
+	for( data_index = 0;
+	     data_index < 32;
+	     data_index++ )
+	{
+		data[ data_index ] = (uint8_t) data_index;
+	}
+	/* Initialize test
+	 */
+	result = libpff_caller_io_handle_initialize(
+	          &caller_io_handle,
+	          32,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "caller_io_handle",
+	 caller_io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_caller_io_handle_supply_data(
+	          caller_io_handle,
+	          0,
+	          data,
+	          8,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_caller_io_handle_supply_data(
+	          caller_io_handle,
+	          12,
+	          &( data[ 12 ] ),
+	          12,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_caller_io_handle_get_supplied_data_size(
+	          caller_io_handle,
+	          &supplied_data_size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "supplied_data_size",
+	 (uint64_t) supplied_data_size,
+	 (uint64_t) 20 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test releasing data that overlaps the end of one segment and the start of the next
+	 */
+	result = libpff_caller_io_handle_release_data(
+	          caller_io_handle,
+	          4,
+	          12,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_get_number_of_entries(
+	          caller_io_handle->segments_array,
+	          &number_of_segments,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_segments",
+	 number_of_segments,
+	 2 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "caller_io_handle->supplied_data_size",
+	 (uint64_t) caller_io_handle->supplied_data_size,
+	 (uint64_t) 12 );
+
+	/* Test releasing data that lies within a segment
+	 */
+	result = libpff_caller_io_handle_release_data(
+	          caller_io_handle,
+	          18,
+	          2,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_get_number_of_entries(
+	          caller_io_handle->segments_array,
+	          &number_of_segments,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_segments",
+	 number_of_segments,
+	 3 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "caller_io_handle->supplied_data_size",
+	 (uint64_t) caller_io_handle->supplied_data_size,
+	 (uint64_t) 10 );
+
+	result = libpff_caller_io_handle_get_segment_at_offset(
+	          caller_io_handle,
+	          21,
+	          &segment,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "segment",
+	 segment );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_INT64(
+	 "segment->offset",
+	 (int64_t) segment->offset,
+	 (int64_t) 20 );
+
+	PFF_TEST_ASSERT_EQUAL_SIZE(
+	 "segment->data_size",
+	 segment->data_size,
+	 (size_t) 4 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "segment->data[ 0 ]",
+	 segment->data[ 0 ],
+	 20 );
+
+	result = libpff_caller_io_handle_get_segment_at_offset(
+	          caller_io_handle,
+	          18,
+	          &segment,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test releasing data that was not supplied
+	 */
+	result = libpff_caller_io_handle_release_data(
+	          caller_io_handle,
+	          26,
+	          2,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test releasing all data
+	 */
+	result = libpff_caller_io_handle_release_data(
+	          caller_io_handle,
+	          0,
+	          32,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_get_number_of_entries(
+	          caller_io_handle->segments_array,
+	          &number_of_segments,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_segments",
+	 number_of_segments,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "caller_io_handle->supplied_data_size",
+	 (uint64_t) caller_io_handle->supplied_data_size,
+	 (uint64_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libpff_caller_io_handle_release_data(
+	          NULL,
+	          0,
+	          8,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_caller_io_handle_release_data(
+	          caller_io_handle,
+	          32,
+	          8,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_caller_io_handle_release_data(
+	          caller_io_handle,
+	          0,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_caller_io_handle_get_supplied_data_size(
+	          NULL,
+	          &supplied_data_size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_caller_io_handle_get_supplied_data_size(
+	          caller_io_handle,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_caller_io_handle_free(
+	          &caller_io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "caller_io_handle",
+	 caller_io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( caller_io_handle != NULL )
+	{
+		libpff_caller_io_handle_free(
+		 &caller_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PFF_TEST_UNREFERENCED_PARAMETER( argc )
+	PFF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+	PFF_TEST_RUN(
+	 "libpff_caller_io_handle_initialize",
+	 pff_test_caller_io_handle_initialize );
+
+	PFF_TEST_RUN(
+	 "libpff_caller_io_handle_free",
+	 pff_test_caller_io_handle_free );
+
+	PFF_TEST_RUN(
+	 "libpff_caller_io_handle_read",
+	 pff_test_caller_io_handle_read );
+
+	PFF_TEST_RUN(
+	 "libpff_caller_io_handle_supply_data",
+	 pff_test_caller_io_handle_supply_data );
+
+	PFF_TEST_RUN(
+	 "libpff_caller_io_handle_release_data",
+	 pff_test_caller_io_handle_release_data );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
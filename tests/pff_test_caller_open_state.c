@@ -0,0 +1,566 @@
+/*
+ * Library caller_open_state type test program
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "pff_test_libcerror.h"
+#include "pff_test_libpff.h"
+#include "pff_test_macros.h"
+#include "pff_test_memory.h"
+#include "pff_test_unused.h"
+
+#include "../libpff/libpff_caller_open_state.h"
+#include "../libpff/libpff_definitions.h"
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+/* Tests the libpff_caller_open_state_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_caller_open_state_initialize(
+     void )
+{
+	libcerror_error_t *error                      = NULL;
+	libpff_caller_open_state_t *caller_open_state = NULL;
+	int result                                    = 0;
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+	int number_of_malloc_fail_tests               = 1;
+	int number_of_memset_fail_tests               = 1;
+	int test_number                               = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libpff_caller_open_state_initialize(
+	          &caller_open_state,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "caller_open_state",
+	 caller_open_state );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "caller_open_state->stage",
+	 caller_open_state->stage,
+	 LIBPFF_CALLER_OPEN_STAGE_FILE_HEADER );
+
+	result = libpff_caller_open_state_free(
+	          &caller_open_state,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "caller_open_state",
+	 caller_open_state );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_caller_open_state_initialize(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	caller_open_state = (libpff_caller_open_state_t *) 0x12345678UL;
+
+	result = libpff_caller_open_state_initialize(
+	          &caller_open_state,
+	          &error );
+
+	caller_open_state = NULL;
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libpff_caller_open_state_initialize with malloc failing
+		 */
+		pff_test_malloc_attempts_before_fail = test_number;
+
+		result = libpff_caller_open_state_initialize(
+		          &caller_open_state,
+		          &error );
+
+		if( pff_test_malloc_attempts_before_fail != -1 )
+		{
+			pff_test_malloc_attempts_before_fail = -1;
+
+			if( caller_open_state != NULL )
+			{
+				libpff_caller_open_state_free(
+				 &caller_open_state,
+				 NULL );
+			}
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "caller_open_state",
+			 caller_open_state );
+
+			PFF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libpff_caller_open_state_initialize with memset failing
+		 */
+		pff_test_memset_attempts_before_fail = test_number;
+
+		result = libpff_caller_open_state_initialize(
+		          &caller_open_state,
+		          &error );
+
+		if( pff_test_memset_attempts_before_fail != -1 )
+		{
+			pff_test_memset_attempts_before_fail = -1;
+
+			if( caller_open_state != NULL )
+			{
+				libpff_caller_open_state_free(
+				 &caller_open_state,
+				 NULL );
+			}
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "caller_open_state",
+			 caller_open_state );
+
+			PFF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_PFF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( caller_open_state != NULL )
+	{
+		libpff_caller_open_state_free(
+		 &caller_open_state,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_caller_open_state_free function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_caller_open_state_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libpff_caller_open_state_free(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_caller_open_state_push_index_node and libpff_caller_open_state_pop_index_node functions
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_caller_open_state_push_pop_index_node(
+     void )
+{
+	libcerror_error_t *error                      = NULL;
+	libpff_caller_open_state_t *caller_open_state = NULL;
+	off64_t offset                                = 0;
+	int level                                     = 0;
+	int node_index                                = 0;
+	int result                                    = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_caller_open_state_initialize(
+	          &caller_open_state,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "caller_open_state",
+	 caller_open_state );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libpff_caller_open_state_pop_index_node(
+	          caller_open_state,
+	          &offset,
+	          &level,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Push more index nodes than fit in the initial allocation
+	 */
+	for( node_index = 0;
+	     node_index < 200;
+	     node_index++ )
+	{
+		result = libpff_caller_open_state_push_index_node(
+		          caller_open_state,
+		          (off64_t) node_index * 512,
+		          node_index % 3,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "caller_open_state->number_of_index_nodes",
+	 caller_open_state->number_of_index_nodes,
+	 200 );
+
+	/* The index nodes are popped in reverse order
+	 */
+	for( node_index = 199;
+	     node_index >= 0;
+	     node_index-- )
+	{
+		result = libpff_caller_open_state_pop_index_node(
+		          caller_open_state,
+		          &offset,
+		          &level,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		PFF_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 (int64_t) offset,
+		 (int64_t) node_index * 512 );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "level",
+		 level,
+		 node_index % 3 );
+	}
+	result = libpff_caller_open_state_pop_index_node(
+	          caller_open_state,
+	          &offset,
+	          &level,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_caller_open_state_push_index_node(
+	          NULL,
+	          0,
+	          -1,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_caller_open_state_push_index_node(
+	          caller_open_state,
+	          -1,
+	          -1,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_caller_open_state_pop_index_node(
+	          NULL,
+	          &offset,
+	          &level,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_caller_open_state_pop_index_node(
+	          caller_open_state,
+	          NULL,
+	          &level,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_caller_open_state_pop_index_node(
+	          caller_open_state,
+	          &offset,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_caller_open_state_free(
+	          &caller_open_state,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "caller_open_state",
+	 caller_open_state );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( caller_open_state != NULL )
+	{
+		libpff_caller_open_state_free(
+		 &caller_open_state,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PFF_TEST_UNREFERENCED_PARAMETER( argc )
+	PFF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+	PFF_TEST_RUN(
+	 "libpff_caller_open_state_initialize",
+	 pff_test_caller_open_state_initialize );
+
+	PFF_TEST_RUN(
+	 "libpff_caller_open_state_free",
+	 pff_test_caller_open_state_free );
+
+	PFF_TEST_RUN(
+	 "libpff_caller_open_state_push_index_node",
+	 pff_test_caller_open_state_push_pop_index_node );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,604 @@
+/*
+ * Library conversation index functions test program
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "pff_test_libcerror.h"
+#include "pff_test_libpff.h"
+#include "pff_test_macros.h"
+#include "pff_test_unused.h"
+
+#include "../libpff/libpff_conversation_index.h"
+
+/* A header block followed by 2 child blocks and 2 bytes of trailing data
+ */
+uint8_t pff_test_conversation_index_data1[ 34 ] = {
+	0x01, 0xd7, 0x12, 0x34, 0x56, 0x78, 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99,
+	0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff, 0x00, 0x00, 0x00, 0x01, 0x25, 0x80, 0x00, 0x00, 0x02, 0x13,
+	0x00, 0x00 };
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+/* Tests the libpff_conversation_index_get_header_values function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_conversation_index_get_header_values(
+     void )
+{
+	uint8_t guid_data[ 16 ];
+
+	libcerror_error_t *error = NULL;
+	uint64_t filetime        = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libpff_conversation_index_get_header_values(
+	          pff_test_conversation_index_data1,
+	          34,
+	          &filetime,
+	          guid_data,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "filetime",
+	 filetime,
+	 (uint64_t) 0x01d7123456780000UL );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          guid_data,
+	          &( pff_test_conversation_index_data1[ 6 ] ),
+	          16 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test data without a header block
+	 */
+	result = libpff_conversation_index_get_header_values(
+	          pff_test_conversation_index_data1,
+	          21,
+	          &filetime,
+	          guid_data,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_conversation_index_get_header_values(
+	          &( pff_test_conversation_index_data1[ 1 ] ),
+	          33,
+	          &filetime,
+	          guid_data,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_conversation_index_get_header_values(
+	          NULL,
+	          34,
+	          &filetime,
+	          guid_data,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_conversation_index_get_header_values(
+	          pff_test_conversation_index_data1,
+	          (size_t) SSIZE_MAX + 1,
+	          &filetime,
+	          guid_data,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_conversation_index_get_header_values(
+	          pff_test_conversation_index_data1,
+	          34,
+	          NULL,
+	          guid_data,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_conversation_index_get_header_values(
+	          pff_test_conversation_index_data1,
+	          34,
+	          &filetime,
+	          NULL,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_conversation_index_get_header_values(
+	          pff_test_conversation_index_data1,
+	          34,
+	          &filetime,
+	          guid_data,
+	          15,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_conversation_index_get_number_of_child_blocks function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_conversation_index_get_number_of_child_blocks(
+     void )
+{
+	libcerror_error_t *error   = NULL;
+	int number_of_child_blocks = 0;
+	int result                 = 0;
+
+	/* Test regular cases
+	 */
+	result = libpff_conversation_index_get_number_of_child_blocks(
+	          pff_test_conversation_index_data1,
+	          34,
+	          &number_of_child_blocks,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_child_blocks",
+	 number_of_child_blocks,
+	 2 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_conversation_index_get_number_of_child_blocks(
+	          pff_test_conversation_index_data1,
+	          21,
+	          &number_of_child_blocks,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_child_blocks",
+	 number_of_child_blocks,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_conversation_index_get_number_of_child_blocks(
+	          NULL,
+	          34,
+	          &number_of_child_blocks,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_conversation_index_get_number_of_child_blocks(
+	          pff_test_conversation_index_data1,
+	          34,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_conversation_index_get_child_block_values function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_conversation_index_get_child_block_values(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	uint64_t time_delta      = 0;
+	uint8_t random_number    = 0;
+	uint8_t sequence_count   = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libpff_conversation_index_get_child_block_values(
+	          pff_test_conversation_index_data1,
+	          34,
+	          0,
+	          &time_delta,
+	          &random_number,
+	          &sequence_count,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "time_delta",
+	 time_delta,
+	 (uint64_t) 0x0000000000040000UL );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "random_number",
+	 random_number,
+	 2 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "sequence_count",
+	 sequence_count,
+	 5 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_conversation_index_get_child_block_values(
+	          pff_test_conversation_index_data1,
+	          34,
+	          1,
+	          &time_delta,
+	          &random_number,
+	          &sequence_count,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "time_delta",
+	 time_delta,
+	 (uint64_t) 0x0000000001000000UL );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "random_number",
+	 random_number,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "sequence_count",
+	 sequence_count,
+	 3 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_conversation_index_get_child_block_values(
+	          NULL,
+	          34,
+	          0,
+	          &time_delta,
+	          &random_number,
+	          &sequence_count,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_conversation_index_get_child_block_values(
+	          pff_test_conversation_index_data1,
+	          34,
+	          -1,
+	          &time_delta,
+	          &random_number,
+	          &sequence_count,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_conversation_index_get_child_block_values(
+	          pff_test_conversation_index_data1,
+	          34,
+	          2,
+	          &time_delta,
+	          &random_number,
+	          &sequence_count,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_conversation_index_get_child_block_values(
+	          pff_test_conversation_index_data1,
+	          34,
+	          0,
+	          NULL,
+	          &random_number,
+	          &sequence_count,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_conversation_index_get_child_block_values(
+	          pff_test_conversation_index_data1,
+	          34,
+	          0,
+	          &time_delta,
+	          NULL,
+	          &sequence_count,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_conversation_index_get_child_block_values(
+	          pff_test_conversation_index_data1,
+	          34,
+	          0,
+	          &time_delta,
+	          &random_number,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PFF_TEST_UNREFERENCED_PARAMETER( argc )
+	PFF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+	PFF_TEST_RUN(
+	 "libpff_conversation_index_get_header_values",
+	 pff_test_conversation_index_get_header_values );
+
+	PFF_TEST_RUN(
+	 "libpff_conversation_index_get_number_of_child_blocks",
+	 pff_test_conversation_index_get_number_of_child_blocks );
+
+	PFF_TEST_RUN(
+	 "libpff_conversation_index_get_child_block_values",
+	 pff_test_conversation_index_get_child_block_values );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+}
+
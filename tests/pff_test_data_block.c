@@ -1585,6 +1585,358 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libpff_data_block_get_stored_size function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_data_block_get_stored_size(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	size_t stored_size       = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libpff_data_block_get_stored_size(
+	          1384,
+	          LIBPFF_FILE_TYPE_32BIT,
+	          &stored_size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_SIZE(
+	 "stored_size",
+	 stored_size,
+	 (size_t) 1408 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_data_block_get_stored_size(
+	          0,
+	          LIBPFF_FILE_TYPE_32BIT,
+	          &stored_size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_SIZE(
+	 "stored_size",
+	 stored_size,
+	 (size_t) 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_data_block_get_stored_size(
+	          1384,
+	          0xff,
+	          &stored_size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_data_block_get_stored_size(
+	          8192,
+	          LIBPFF_FILE_TYPE_32BIT,
+	          &stored_size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_data_block_get_stored_size(
+	          1384,
+	          LIBPFF_FILE_TYPE_32BIT,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_data_block_read_data function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_data_block_read_data(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libpff_data_block_t *data_block = NULL;
+	libpff_io_handle_t *io_handle   = NULL;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_data_block_initialize(
+	          &data_block,
+	          io_handle,
+	          0,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "data_block",
+	 data_block );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libpff_data_block_read_data(
+	          data_block,
+	          pff_test_data_block_data_32bit,
+	          1408,
+	          1384,
+	          LIBPFF_FILE_TYPE_32BIT,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_data_block_read_data(
+	          NULL,
+	          pff_test_data_block_data_32bit,
+	          1408,
+	          1384,
+	          LIBPFF_FILE_TYPE_32BIT,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test data value already set
+	 */
+	result = libpff_data_block_read_data(
+	          data_block,
+	          pff_test_data_block_data_32bit,
+	          1408,
+	          1384,
+	          LIBPFF_FILE_TYPE_32BIT,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_data_block_free(
+	          &data_block,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "data_block",
+	 data_block );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test stored data too small
+	 */
+	result = libpff_data_block_initialize(
+	          &data_block,
+	          io_handle,
+	          0,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "data_block",
+	 data_block );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_data_block_read_data(
+	          data_block,
+	          pff_test_data_block_data_32bit,
+	          1384,
+	          1384,
+	          LIBPFF_FILE_TYPE_32BIT,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_data_block_free(
+	          &data_block,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "data_block",
+	 data_block );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_block != NULL )
+	{
+		libpff_data_block_free(
+		 &data_block,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libpff_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* Tests the libpff_data_block_read_file_io_handle function
  * Returns 1 if successful or 0 if not
  */
@@ -2065,6 +2417,14 @@ int main(
 	 "libpff_data_block_read_footer_data",
 	 pff_test_data_block_read_footer_data );
 
+	PFF_TEST_RUN(
+	 "libpff_data_block_get_stored_size",
+	 pff_test_data_block_get_stored_size );
+
+	PFF_TEST_RUN(
+	 "libpff_data_block_read_data",
+	 pff_test_data_block_read_data );
+
 	PFF_TEST_RUN(
 	 "libpff_data_block_read_file_io_handle",
 	 pff_test_data_block_read_file_io_handle );
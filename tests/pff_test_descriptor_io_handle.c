@@ -0,0 +1,718 @@
+/*
+ * Library descriptor_io_handle type test program
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "pff_test_libcerror.h"
+#include "pff_test_libpff.h"
+#include "pff_test_macros.h"
+#include "pff_test_memory.h"
+#include "pff_test_unused.h"
+
+#include "../libpff/libpff_definitions.h"
+#include "../libpff/libpff_descriptor_io_handle.h"
+#include "../libpff/libpff_libbfio.h"
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) && defined( LIBPFF_HAVE_DESCRIPTOR_IO_HANDLE )
+
+/* Tests the libpff_descriptor_io_handle_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_descriptor_io_handle_initialize(
+     void )
+{
+	libcerror_error_t *error                            = NULL;
+	libpff_descriptor_io_handle_t *descriptor_io_handle = NULL;
+	int result                                          = 0;
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+	int number_of_malloc_fail_tests                     = 1;
+	int number_of_memset_fail_tests                     = 1;
+	int test_number                                     = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libpff_descriptor_io_handle_initialize(
+	          &descriptor_io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "descriptor_io_handle",
+	 descriptor_io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "descriptor_io_handle->descriptor",
+	 descriptor_io_handle->descriptor,
+	 -1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "descriptor_io_handle->access_hint_flags",
+	 (int) descriptor_io_handle->access_hint_flags,
+	 (int) LIBPFF_ACCESS_HINT_FLAG_ADVISE );
+
+	result = libpff_descriptor_io_handle_free(
+	          &descriptor_io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "descriptor_io_handle",
+	 descriptor_io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_descriptor_io_handle_initialize(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	descriptor_io_handle = (libpff_descriptor_io_handle_t *) 0x12345678UL;
+
+	result = libpff_descriptor_io_handle_initialize(
+	          &descriptor_io_handle,
+	          &error );
+
+	descriptor_io_handle = NULL;
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libpff_descriptor_io_handle_initialize with malloc failing
+		 */
+		pff_test_malloc_attempts_before_fail = test_number;
+
+		result = libpff_descriptor_io_handle_initialize(
+		          &descriptor_io_handle,
+		          &error );
+
+		if( pff_test_malloc_attempts_before_fail != -1 )
+		{
+			pff_test_malloc_attempts_before_fail = -1;
+
+			if( descriptor_io_handle != NULL )
+			{
+				libpff_descriptor_io_handle_free(
+				 &descriptor_io_handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "descriptor_io_handle",
+			 descriptor_io_handle );
+
+			PFF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libpff_descriptor_io_handle_initialize with memset failing
+		 */
+		pff_test_memset_attempts_before_fail = test_number;
+
+		result = libpff_descriptor_io_handle_initialize(
+		          &descriptor_io_handle,
+		          &error );
+
+		if( pff_test_memset_attempts_before_fail != -1 )
+		{
+			pff_test_memset_attempts_before_fail = -1;
+
+			if( descriptor_io_handle != NULL )
+			{
+				libpff_descriptor_io_handle_free(
+				 &descriptor_io_handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "descriptor_io_handle",
+			 descriptor_io_handle );
+
+			PFF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_PFF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( descriptor_io_handle != NULL )
+	{
+		libpff_descriptor_io_handle_free(
+		 &descriptor_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_descriptor_io_handle_free function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_descriptor_io_handle_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libpff_descriptor_io_handle_free(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_descriptor_io_handle_set_access_pattern function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_descriptor_io_handle_set_access_pattern(
+     void )
+{
+	libcerror_error_t *error                            = NULL;
+	libpff_descriptor_io_handle_t *descriptor_io_handle = NULL;
+	int access_pattern                                  = 0;
+	int result                                          = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_descriptor_io_handle_initialize(
+	          &descriptor_io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "descriptor_io_handle",
+	 descriptor_io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libpff_descriptor_io_handle_set_access_pattern(
+	          descriptor_io_handle,
+	          LIBPFF_ACCESS_PATTERN_SCAN,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_descriptor_io_handle_get_access_pattern(
+	          descriptor_io_handle,
+	          &access_pattern,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "access_pattern",
+	 access_pattern,
+	 LIBPFF_ACCESS_PATTERN_SCAN );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_descriptor_io_handle_set_access_pattern(
+	          descriptor_io_handle,
+	          LIBPFF_ACCESS_PATTERN_RANDOM,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_descriptor_io_handle_get_access_pattern(
+	          descriptor_io_handle,
+	          &access_pattern,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "access_pattern",
+	 access_pattern,
+	 LIBPFF_ACCESS_PATTERN_RANDOM );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_descriptor_io_handle_set_access_pattern(
+	          NULL,
+	          LIBPFF_ACCESS_PATTERN_SCAN,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_descriptor_io_handle_set_access_pattern(
+	          descriptor_io_handle,
+	          -1,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_descriptor_io_handle_set_access_hint_flags(
+	          descriptor_io_handle,
+	          0xff,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_descriptor_io_handle_get_access_pattern(
+	          descriptor_io_handle,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_descriptor_io_handle_free(
+	          &descriptor_io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "descriptor_io_handle",
+	 descriptor_io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( descriptor_io_handle != NULL )
+	{
+		libpff_descriptor_io_handle_free(
+		 &descriptor_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_descriptor_io_handle_open function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_descriptor_io_handle_open(
+     void )
+{
+	libcerror_error_t *error                            = NULL;
+	libpff_descriptor_io_handle_t *descriptor_io_handle = NULL;
+	int result                                          = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_descriptor_io_handle_initialize(
+	          &descriptor_io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "descriptor_io_handle",
+	 descriptor_io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_descriptor_io_handle_open(
+	          NULL,
+	          LIBBFIO_ACCESS_FLAG_READ,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test open without a name
+	 */
+	result = libpff_descriptor_io_handle_open(
+	          descriptor_io_handle,
+	          LIBBFIO_ACCESS_FLAG_READ,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_descriptor_io_handle_set_name(
+	          descriptor_io_handle,
+	          NULL,
+	          1,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_descriptor_io_handle_set_name(
+	          descriptor_io_handle,
+	          "pff_test_missing_file.pst",
+	          26,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open with write access
+	 */
+	result = libpff_descriptor_io_handle_open(
+	          descriptor_io_handle,
+	          LIBBFIO_ACCESS_FLAG_READ | LIBBFIO_ACCESS_FLAG_WRITE,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test open of a file that does not exist
+	 */
+	result = libpff_descriptor_io_handle_open(
+	          descriptor_io_handle,
+	          LIBBFIO_ACCESS_FLAG_READ,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_descriptor_io_handle_is_open(
+	          descriptor_io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libpff_descriptor_io_handle_free(
+	          &descriptor_io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "descriptor_io_handle",
+	 descriptor_io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( descriptor_io_handle != NULL )
+	{
+		libpff_descriptor_io_handle_free(
+		 &descriptor_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) && defined( LIBPFF_HAVE_DESCRIPTOR_IO_HANDLE ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PFF_TEST_UNREFERENCED_PARAMETER( argc )
+	PFF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) && defined( LIBPFF_HAVE_DESCRIPTOR_IO_HANDLE )
+
+	PFF_TEST_RUN(
+	 "libpff_descriptor_io_handle_initialize",
+	 pff_test_descriptor_io_handle_initialize );
+
+	PFF_TEST_RUN(
+	 "libpff_descriptor_io_handle_free",
+	 pff_test_descriptor_io_handle_free );
+
+	PFF_TEST_RUN(
+	 "libpff_descriptor_io_handle_set_access_pattern",
+	 pff_test_descriptor_io_handle_set_access_pattern );
+
+	PFF_TEST_RUN(
+	 "libpff_descriptor_io_handle_open",
+	 pff_test_descriptor_io_handle_open );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) && defined( LIBPFF_HAVE_DESCRIPTOR_IO_HANDLE ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,447 @@
+/*
+ * Library entry identifier functions test program
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "pff_test_libcerror.h"
+#include "pff_test_libpff.h"
+#include "pff_test_macros.h"
+#include "pff_test_unused.h"
+
+#include "../libpff/libpff_entry_identifier.h"
+
+/* A message store entry identifier
+ */
+uint8_t pff_test_entry_identifier_data1[ 24 ] = {
+	0x00, 0x00, 0x00, 0x00, 0x5d, 0x6d, 0x2f, 0x9d, 0x8c, 0x3e, 0x4b, 0x48, 0x8f, 0x5e, 0x0d, 0x9c,
+	0x1a, 0x25, 0xe7, 0x83, 0x24, 0x00, 0x20, 0x00 };
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+/* Tests the libpff_entry_identifier_get_header_values function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_entry_identifier_get_header_values(
+     void )
+{
+	uint8_t service_provider_identifier[ 16 ];
+
+	libcerror_error_t *error = NULL;
+	uint32_t flags           = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libpff_entry_identifier_get_header_values(
+	          pff_test_entry_identifier_data1,
+	          24,
+	          &flags,
+	          service_provider_identifier,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT32(
+	 "flags",
+	 flags,
+	 (uint32_t) 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          service_provider_identifier,
+	          &( pff_test_entry_identifier_data1[ 4 ] ),
+	          16 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test data that is too small to contain an entry identifier
+	 */
+	result = libpff_entry_identifier_get_header_values(
+	          pff_test_entry_identifier_data1,
+	          19,
+	          &flags,
+	          service_provider_identifier,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_entry_identifier_get_header_values(
+	          NULL,
+	          24,
+	          &flags,
+	          service_provider_identifier,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_entry_identifier_get_header_values(
+	          pff_test_entry_identifier_data1,
+	          (size_t) SSIZE_MAX + 1,
+	          &flags,
+	          service_provider_identifier,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_entry_identifier_get_header_values(
+	          pff_test_entry_identifier_data1,
+	          24,
+	          NULL,
+	          service_provider_identifier,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_entry_identifier_get_header_values(
+	          pff_test_entry_identifier_data1,
+	          24,
+	          &flags,
+	          NULL,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_entry_identifier_get_header_values(
+	          pff_test_entry_identifier_data1,
+	          24,
+	          &flags,
+	          service_provider_identifier,
+	          15,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_entry_identifier_get_item_identifier function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_entry_identifier_get_item_identifier(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	uint32_t item_identifier = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libpff_entry_identifier_get_item_identifier(
+	          pff_test_entry_identifier_data1,
+	          24,
+	          &( pff_test_entry_identifier_data1[ 4 ] ),
+	          16,
+	          &item_identifier,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT32(
+	 "item_identifier",
+	 item_identifier,
+	 (uint32_t) 0x00200024UL );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test data that is not a message store entry identifier
+	 */
+	result = libpff_entry_identifier_get_item_identifier(
+	          pff_test_entry_identifier_data1,
+	          20,
+	          &( pff_test_entry_identifier_data1[ 4 ] ),
+	          16,
+	          &item_identifier,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test an entry identifier of another message store
+	 */
+	result = libpff_entry_identifier_get_item_identifier(
+	          pff_test_entry_identifier_data1,
+	          24,
+	          pff_test_entry_identifier_data1,
+	          16,
+	          &item_identifier,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_entry_identifier_get_item_identifier(
+	          NULL,
+	          24,
+	          &( pff_test_entry_identifier_data1[ 4 ] ),
+	          16,
+	          &item_identifier,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_entry_identifier_get_item_identifier(
+	          pff_test_entry_identifier_data1,
+	          (size_t) SSIZE_MAX + 1,
+	          &( pff_test_entry_identifier_data1[ 4 ] ),
+	          16,
+	          &item_identifier,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_entry_identifier_get_item_identifier(
+	          pff_test_entry_identifier_data1,
+	          24,
+	          NULL,
+	          16,
+	          &item_identifier,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_entry_identifier_get_item_identifier(
+	          pff_test_entry_identifier_data1,
+	          24,
+	          &( pff_test_entry_identifier_data1[ 4 ] ),
+	          20,
+	          &item_identifier,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_entry_identifier_get_item_identifier(
+	          pff_test_entry_identifier_data1,
+	          24,
+	          &( pff_test_entry_identifier_data1[ 4 ] ),
+	          16,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PFF_TEST_UNREFERENCED_PARAMETER( argc )
+	PFF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+	PFF_TEST_RUN(
+	 "libpff_entry_identifier_get_header_values",
+	 pff_test_entry_identifier_get_header_values );
+
+	PFF_TEST_RUN(
+	 "libpff_entry_identifier_get_item_identifier",
+	 pff_test_entry_identifier_get_item_identifier );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+}
+
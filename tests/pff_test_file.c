@@ -33,12 +33,18 @@
 #include "pff_test_functions.h"
 #include "pff_test_getopt.h"
 #include "pff_test_libbfio.h"
+#include "pff_test_libcdata.h"
 #include "pff_test_libcerror.h"
 #include "pff_test_libpff.h"
 #include "pff_test_macros.h"
 #include "pff_test_memory.h"
+#include "pff_test_unused.h"
 
+#include "../libpff/libpff_definitions.h"
 #include "../libpff/libpff_file.h"
+#include "../libpff/libpff_item.h"
+#include "../libpff/libpff_item_descriptor.h"
+#include "../libpff/libpff_item_tree.h"
 
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER ) && SIZEOF_WCHAR_T != 2 && SIZEOF_WCHAR_T != 4
 #error Unsupported size of wchar_t
@@ -1180,34 +1186,1934 @@ on_error:
 	return( 0 );
 }
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Tests the libpff_file_open and libpff_file_close functions with a parallel open
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_file_open_close_parallel(
+     const system_character_t *source )
+{
+	libcerror_error_t *error = NULL;
+	libpff_file_t *file      = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_file_initialize(
+	          &file,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "file",
+	 file );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_file_set_parallel_open(
+	          file,
+	          1,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open and close
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libpff_file_open_wide(
+	          file,
+	          source,
+	          LIBPFF_OPEN_READ,
+	          &error );
+#else
+	result = libpff_file_open(
+	          file,
+	          source,
+	          LIBPFF_OPEN_READ,
+	          &error );
+#endif
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_file_close(
+	          file,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libpff_file_free(
+	          &file,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "file",
+	 file );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file != NULL )
+	{
+		libpff_file_free(
+		 &file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Supplies the data of the pending read of a file in caller driven mode
+ * Returns 1 if successful, 0 if no read is pending or -1 on error
+ */
+int pff_test_file_supply_pending_read(
+     libpff_file_t *file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	uint8_t *data         = NULL;
+	static char *function = "pff_test_file_supply_pending_read";
+	size64_t size         = 0;
+	ssize_t read_count    = 0;
+	off64_t offset        = 0;
+	int result            = 0;
+
+	result = libpff_file_get_pending_read(
+	          file,
+	          &offset,
+	          &size,
+	          error );
+
+	if( result != 1 )
+	{
+		return( result );
+	}
+	if( ( size == 0 )
+	 || ( size > (size64_t) ( 64 * 1024 * 1024 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid pending read size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * (size_t) size );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              file_io_handle,
+	              data,
+	              (size_t) size,
+	              offset,
+	              error );
+
+	if( read_count != (ssize_t) size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read pending data at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		goto on_error;
+	}
+	if( libpff_file_supply_data(
+	     file,
+	     offset,
+	     data,
+	     (size_t) size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to supply data.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 data );
+
+	return( 1 );
+
+on_error:
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( -1 );
+}
+
+/* Tests the libpff_file_open_caller_driven function
+ * The file is only read through libpff_file_supply_data
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_file_open_caller_driven(
+     const system_character_t *source )
+{
+	uint8_t caller_data[ 64 ];
+	uint8_t expected_data[ 64 ];
+
+	libbfio_handle_t *file_io_handle        = NULL;
+	libcerror_error_t *error                = NULL;
+	libpff_file_t *caller_file              = NULL;
+	libpff_file_t *file                     = NULL;
+	libpff_item_t *caller_message_store     = NULL;
+	libpff_item_t *message_store            = NULL;
+	libpff_record_entry_t *caller_entry     = NULL;
+	libpff_record_entry_t *record_entry     = NULL;
+	libpff_record_set_t *caller_record_set  = NULL;
+	libpff_record_set_t *record_set         = NULL;
+	size64_t file_size                      = 0;
+	size_t string_length                    = 0;
+	ssize_t caller_read_count               = 0;
+	ssize_t read_count                      = 0;
+	int number_of_entries                   = 0;
+	int number_of_record_sets               = 0;
+	int number_of_retries                   = 0;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libbfio_file_initialize(
+	          &file_io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	string_length = system_string_length(
+	                 source );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libbfio_file_set_name_wide(
+	          file_io_handle,
+	          source,
+	          string_length,
+	          &error );
+#else
+	result = libbfio_file_set_name(
+	          file_io_handle,
+	          source,
+	          string_length,
+	          &error );
+#endif
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_open(
+	          file_io_handle,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_get_size(
+	          file_io_handle,
+	          &file_size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The reference file is opened regularly
+	 */
+	result = libpff_file_initialize(
+	          &file,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_file_open_file_io_handle(
+	          file,
+	          file_io_handle,
+	          LIBPFF_OPEN_READ,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_file_initialize(
+	          &caller_file,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open in caller driven mode
+	 */
+	for( number_of_retries = 0;
+	     number_of_retries < 65536;
+	     number_of_retries++ )
+	{
+		result = libpff_file_open_caller_driven(
+		          caller_file,
+		          file_size,
+		          LIBPFF_OPEN_READ,
+		          &error );
+
+		if( result != 0 )
+		{
+			break;
+		}
+		result = pff_test_file_supply_pending_read(
+		          caller_file,
+		          file_io_handle,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_GREATER_THAN_INT(
+	 "number_of_retries",
+	 number_of_retries,
+	 0 );
+
+	/* Test resolving an item in caller driven mode
+	 */
+	for( number_of_retries = 0;
+	     number_of_retries < 65536;
+	     number_of_retries++ )
+	{
+		result = libpff_file_get_message_store(
+		          caller_file,
+		          &caller_message_store,
+		          &error );
+
+		if( result != -1 )
+		{
+			break;
+		}
+		libcerror_error_free(
+		 &error );
+
+		result = pff_test_file_supply_pending_read(
+		          caller_file,
+		          file_io_handle,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	PFF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( result == 0 )
+	{
+		goto on_done;
+	}
+	for( number_of_retries = 0;
+	     number_of_retries < 65536;
+	     number_of_retries++ )
+	{
+		result = libpff_item_get_number_of_record_sets(
+		          caller_message_store,
+		          &number_of_record_sets,
+		          &error );
+
+		if( result != -1 )
+		{
+			break;
+		}
+		libcerror_error_free(
+		 &error );
+
+		result = pff_test_file_supply_pending_read(
+		          caller_file,
+		          file_io_handle,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( number_of_record_sets == 0 )
+	{
+		goto on_done;
+	}
+	result = libpff_item_get_record_set_by_index(
+	          caller_message_store,
+	          0,
+	          &caller_record_set,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_record_set_get_number_of_entries(
+	          caller_record_set,
+	          &number_of_entries,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( number_of_entries == 0 )
+	{
+		goto on_done;
+	}
+	result = libpff_record_set_get_entry_by_index(
+	          caller_record_set,
+	          0,
+	          &caller_entry,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test reading a value data stream in caller driven mode
+	 */
+	caller_read_count = libpff_record_entry_read_buffer(
+	                     caller_entry,
+	                     caller_data,
+	                     64,
+	                     &error );
+
+	PFF_TEST_ASSERT_NOT_EQUAL_SSIZE(
+	 "caller_read_count",
+	 caller_read_count,
+	 (ssize_t) -1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Compare with the same value read from the regularly opened file
+	 */
+	result = libpff_file_get_message_store(
+	          file,
+	          &message_store,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_item_get_record_set_by_index(
+	          message_store,
+	          0,
+	          &record_set,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_record_set_get_entry_by_index(
+	          record_set,
+	          0,
+	          &record_entry,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libpff_record_entry_read_buffer(
+	              record_entry,
+	              expected_data,
+	              64,
+	              &error );
+
+	PFF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 caller_read_count );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          caller_data,
+	          expected_data,
+	          (size_t) read_count );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+on_done:
+	/* Clean up
+	 */
+	if( record_entry != NULL )
+	{
+		result = libpff_record_entry_free(
+		          &record_entry,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	if( record_set != NULL )
+	{
+		result = libpff_record_set_free(
+		          &record_set,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	if( message_store != NULL )
+	{
+		result = libpff_item_free(
+		          &message_store,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	if( caller_entry != NULL )
+	{
+		result = libpff_record_entry_free(
+		          &caller_entry,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	if( caller_record_set != NULL )
+	{
+		result = libpff_record_set_free(
+		          &caller_record_set,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	if( caller_message_store != NULL )
+	{
+		result = libpff_item_free(
+		          &caller_message_store,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libpff_file_free(
+	          &caller_file,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_file_free(
+	          &file,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( record_entry != NULL )
+	{
+		libpff_record_entry_free(
+		 &record_entry,
+		 NULL );
+	}
+	if( record_set != NULL )
+	{
+		libpff_record_set_free(
+		 &record_set,
+		 NULL );
+	}
+	if( message_store != NULL )
+	{
+		libpff_item_free(
+		 &message_store,
+		 NULL );
+	}
+	if( caller_entry != NULL )
+	{
+		libpff_record_entry_free(
+		 &caller_entry,
+		 NULL );
+	}
+	if( caller_record_set != NULL )
+	{
+		libpff_record_set_free(
+		 &caller_record_set,
+		 NULL );
+	}
+	if( caller_message_store != NULL )
+	{
+		libpff_item_free(
+		 &caller_message_store,
+		 NULL );
+	}
+	if( caller_file != NULL )
+	{
+		libpff_file_free(
+		 &caller_file,
+		 NULL );
+	}
+	if( file != NULL )
+	{
+		libpff_file_free(
+		 &file,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* Tests the libpff_file_signal_abort function
  * Returns 1 if successful or 0 if not
  */
-int pff_test_file_signal_abort(
+int pff_test_file_signal_abort(
+     libpff_file_t *file )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libpff_file_signal_abort(
+	          file,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_file_signal_abort(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_file_set_parallel_open function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_file_set_parallel_open(
+     libpff_file_t *file )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libpff_file_set_parallel_open(
+	          file,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	result = libpff_file_set_parallel_open(
+	          file,
+	          1,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_file_set_parallel_open(
+	          file,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	/* Test error cases
+	 */
+	result = libpff_file_set_parallel_open(
+	          NULL,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	result = libpff_file_set_parallel_open(
+	          file,
+	          1,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#endif /* !defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_file_set_access_hint_flags function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_file_set_access_hint_flags(
+     libpff_file_t *file )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libpff_file_set_access_hint_flags(
+	          file,
+	          LIBPFF_ACCESS_HINT_FLAG_ADVISE | LIBPFF_ACCESS_HINT_FLAG_DROP_SCANNED_DATA | LIBPFF_ACCESS_HINT_FLAG_DIRECT_SCAN,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_file_set_access_hint_flags(
+	          file,
+	          LIBPFF_ACCESS_HINT_FLAG_ADVISE,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_file_set_access_hint_flags(
+	          file,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_file_set_access_hint_flags(
+	          NULL,
+	          LIBPFF_ACCESS_HINT_FLAG_ADVISE,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_file_set_access_hint_flags(
+	          file,
+	          0xff,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Retrieves the number of sub items of the root folder
+ * Returns 1 if successful or -1 on error
+ */
+int pff_test_file_get_number_of_root_folder_sub_items(
+     libpff_file_t *file,
+     int *number_of_sub_items,
+     libcerror_error_t **error )
+{
+	libpff_item_t *root_folder = NULL;
+	int result                 = 0;
+
+	if( libpff_file_get_root_folder(
+	     file,
+	     &root_folder,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	result = libpff_item_get_number_of_sub_items(
+	          root_folder,
+	          number_of_sub_items,
+	          error );
+
+	if( libpff_item_free(
+	     &root_folder,
+	     error ) != 1 )
+	{
+		result = -1;
+	}
+	return( result );
+}
+
+/* Tests the libpff_file_refresh function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_file_refresh(
+     libpff_file_t *file )
+{
+	libcerror_error_t *error              = NULL;
+	libpff_item_t *root_folder            = NULL;
+	int expected_number_of_sub_items      = 0;
+	int result                            = 0;
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+	libpff_internal_file_t *internal_file = NULL;
+	int number_of_sub_items               = 0;
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+	int number_of_malloc_fail_tests       = 32;
+	int test_number                       = 0;
+#endif
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+	/* Initialize test
+	 */
+	result = libpff_file_get_root_folder(
+	          file,
+	          &root_folder,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_item_get_number_of_sub_items(
+	          root_folder,
+	          &expected_number_of_sub_items,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_item_free(
+	          &root_folder,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libpff_file_refresh(
+	          file,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+	internal_file = (libpff_internal_file_t *) file;
+
+	/* Test refresh of a changed file, the file size stored in the file header
+	 * is changed to make the file appear changed while the indexes are not
+	 */
+	internal_file->file_header->file_size -= 1;
+
+	result = libpff_file_refresh(
+	          file,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "internal_file->descriptors_index_layout",
+	 internal_file->descriptors_index_layout );
+
+	result = pff_test_file_get_number_of_root_folder_sub_items(
+	          file,
+	          &number_of_sub_items,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_sub_items",
+	 number_of_sub_items,
+	 expected_number_of_sub_items );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test refresh of a changed file when the descriptors index layout
+	 * is determined again
+	 */
+	result = libpff_index_layout_free(
+	          &( internal_file->descriptors_index_layout ),
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	internal_file->file_header->file_size -= 1;
+
+	result = libpff_file_refresh(
+	          file,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = pff_test_file_get_number_of_root_folder_sub_items(
+	          file,
+	          &number_of_sub_items,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_sub_items",
+	 number_of_sub_items,
+	 expected_number_of_sub_items );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libpff_file_refresh with malloc failing, on error
+		 * the file should be left unchanged
+		 */
+		internal_file->file_header->file_size -= 1;
+
+		pff_test_malloc_attempts_before_fail = test_number;
+
+		result = libpff_file_refresh(
+		          file,
+		          &error );
+
+		if( pff_test_malloc_attempts_before_fail != -1 )
+		{
+			pff_test_malloc_attempts_before_fail = -1;
+		}
+		if( result == -1 )
+		{
+			PFF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+
+			result = libpff_file_refresh(
+			          file,
+			          &error );
+
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		result = pff_test_file_get_number_of_root_folder_sub_items(
+		          file,
+		          &number_of_sub_items,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "number_of_sub_items",
+		 number_of_sub_items,
+		 expected_number_of_sub_items );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+#endif /* defined( HAVE_PFF_TEST_MEMORY ) */
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+	/* Test error cases
+	 */
+	result = libpff_file_refresh(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( root_folder != NULL )
+	{
+		libpff_item_free(
+		 &root_folder,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_file_is_corrupted function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_file_is_corrupted(
+     libpff_file_t *file )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libpff_file_is_corrupted(
+	          file,
+	          &error );
+
+	PFF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_file_is_corrupted(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_file_recover_items function with an exhausted read budget
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_file_recover_items_read_budget(
+     libpff_file_t *file )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error case where recovery stops once the read budget is used up
+	 */
+	result = libpff_file_set_read_budget(
+	          file,
+	          1,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_file_recover_items(
+	          file,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_file_set_read_budget(
+	          file,
+	          0,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	libpff_file_set_read_budget(
+	 file,
+	 0,
+	 0,
+	 NULL );
+
+	return( 0 );
+}
+
+/* Tests the libpff_file_get_size function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_file_get_size(
+     libpff_file_t *file )
+{
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	int result               = 0;
+	int size_is_set          = 0;
+
+	/* Test regular cases
+	 */
+	result = libpff_file_get_size(
+	          file,
+	          &size,
+	          &error );
+
+	PFF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	size_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libpff_file_get_size(
+	          NULL,
+	          &size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( size_is_set != 0 )
+	{
+		result = libpff_file_get_size(
+		          file,
+		          NULL,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		PFF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_file_get_read_statistics function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_file_get_read_statistics(
+     libpff_file_t *file )
+{
+	libcerror_error_t *error               = NULL;
+	size64_t read_size                     = 0;
+	uint64_t number_of_decompressed_blocks = 0;
+	uint64_t number_of_read_blocks         = 0;
+	int result                             = 0;
+
+	/* Test regular cases
+	 */
+	result = libpff_file_get_read_statistics(
+	          file,
+	          &read_size,
+	          &number_of_read_blocks,
+	          &number_of_decompressed_blocks,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "number_of_read_blocks",
+	 (int64_t) number_of_read_blocks,
+	 (int64_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libpff_file_get_read_statistics(
+	          NULL,
+	          &read_size,
+	          &number_of_read_blocks,
+	          &number_of_decompressed_blocks,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_file_get_read_statistics(
+	          file,
+	          NULL,
+	          &number_of_read_blocks,
+	          &number_of_decompressed_blocks,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_file_get_read_statistics(
+	          file,
+	          &read_size,
+	          NULL,
+	          &number_of_decompressed_blocks,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_file_get_read_statistics(
+	          file,
+	          &read_size,
+	          &number_of_read_blocks,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_file_get_content_type function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_file_get_content_type(
+     libpff_file_t *file )
+{
+	libcerror_error_t *error = NULL;
+	uint8_t content_type     = 0;
+	int content_type_is_set  = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libpff_file_get_content_type(
+	          file,
+	          &content_type,
+	          &error );
+
+	PFF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	content_type_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libpff_file_get_content_type(
+	          NULL,
+	          &content_type,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( content_type_is_set != 0 )
+	{
+		result = libpff_file_get_content_type(
+		          file,
+		          NULL,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		PFF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_file_get_type function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_file_get_type(
+     libpff_file_t *file )
+{
+	libcerror_error_t *error = NULL;
+	uint8_t type             = 0;
+	int result               = 0;
+	int type_is_set          = 0;
+
+	/* Test regular cases
+	 */
+	result = libpff_file_get_type(
+	          file,
+	          &type,
+	          &error );
+
+	PFF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	type_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libpff_file_get_type(
+	          NULL,
+	          &type,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( type_is_set != 0 )
+	{
+		result = libpff_file_get_type(
+		          file,
+		          NULL,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		PFF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_file_get_encryption_type function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_file_get_encryption_type(
      libpff_file_t *file )
 {
-	libcerror_error_t *error = NULL;
-	int result               = 0;
+	libcerror_error_t *error   = NULL;
+	uint8_t encryption_type    = 0;
+	int encryption_type_is_set = 0;
+	int result                 = 0;
 
 	/* Test regular cases
 	 */
-	result = libpff_file_signal_abort(
+	result = libpff_file_get_encryption_type(
 	          file,
+	          &encryption_type,
 	          &error );
 
-	PFF_TEST_ASSERT_EQUAL_INT(
+	PFF_TEST_ASSERT_NOT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
 	PFF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
+	encryption_type_is_set = result;
+
 	/* Test error cases
 	 */
-	result = libpff_file_signal_abort(
+	result = libpff_file_get_encryption_type(
 	          NULL,
+	          &encryption_type,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -1222,6 +3128,25 @@ int pff_test_file_signal_abort(
 	libcerror_error_free(
 	 &error );
 
+	if( encryption_type_is_set != 0 )
+	{
+		result = libpff_file_get_encryption_type(
+		          file,
+		          NULL,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		PFF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
 	return( 1 );
 
 on_error:
@@ -1233,19 +3158,22 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libpff_file_is_corrupted function
+/* Tests the libpff_file_get_ascii_codepage function
  * Returns 1 if successful or 0 if not
  */
-int pff_test_file_is_corrupted(
+int pff_test_file_get_ascii_codepage(
      libpff_file_t *file )
 {
-	libcerror_error_t *error = NULL;
-	int result               = 0;
+	libcerror_error_t *error  = NULL;
+	int ascii_codepage        = 0;
+	int ascii_codepage_is_set = 0;
+	int result                = 0;
 
 	/* Test regular cases
 	 */
-	result = libpff_file_is_corrupted(
+	result = libpff_file_get_ascii_codepage(
 	          file,
+	          &ascii_codepage,
 	          &error );
 
 	PFF_TEST_ASSERT_NOT_EQUAL_INT(
@@ -1257,24 +3185,184 @@ int pff_test_file_is_corrupted(
 	 "error",
 	 error );
 
-	/* Test error cases
+	ascii_codepage_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libpff_file_get_ascii_codepage(
+	          NULL,
+	          &ascii_codepage,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( ascii_codepage_is_set != 0 )
+	{
+		result = libpff_file_get_ascii_codepage(
+		          file,
+		          NULL,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		PFF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_file_set_ascii_codepage function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_file_set_ascii_codepage(
+     libpff_file_t *file )
+{
+	int supported_codepages[ 15 ] = {
+		LIBPFF_CODEPAGE_ASCII,
+		LIBPFF_CODEPAGE_WINDOWS_874,
+		LIBPFF_CODEPAGE_WINDOWS_932,
+		LIBPFF_CODEPAGE_WINDOWS_936,
+		LIBPFF_CODEPAGE_WINDOWS_949,
+		LIBPFF_CODEPAGE_WINDOWS_950,
+		LIBPFF_CODEPAGE_WINDOWS_1250,
+		LIBPFF_CODEPAGE_WINDOWS_1251,
+		LIBPFF_CODEPAGE_WINDOWS_1252,
+		LIBPFF_CODEPAGE_WINDOWS_1253,
+		LIBPFF_CODEPAGE_WINDOWS_1254,
+		LIBPFF_CODEPAGE_WINDOWS_1255,
+		LIBPFF_CODEPAGE_WINDOWS_1256,
+		LIBPFF_CODEPAGE_WINDOWS_1257,
+		LIBPFF_CODEPAGE_WINDOWS_1258 };
+
+	int unsupported_codepages[ 17 ] = {
+		LIBPFF_CODEPAGE_ISO_8859_1,
+		LIBPFF_CODEPAGE_ISO_8859_2,
+		LIBPFF_CODEPAGE_ISO_8859_3,
+		LIBPFF_CODEPAGE_ISO_8859_4,
+		LIBPFF_CODEPAGE_ISO_8859_5,
+		LIBPFF_CODEPAGE_ISO_8859_6,
+		LIBPFF_CODEPAGE_ISO_8859_7,
+		LIBPFF_CODEPAGE_ISO_8859_8,
+		LIBPFF_CODEPAGE_ISO_8859_9,
+		LIBPFF_CODEPAGE_ISO_8859_10,
+		LIBPFF_CODEPAGE_ISO_8859_11,
+		LIBPFF_CODEPAGE_ISO_8859_13,
+		LIBPFF_CODEPAGE_ISO_8859_14,
+		LIBPFF_CODEPAGE_ISO_8859_15,
+		LIBPFF_CODEPAGE_ISO_8859_16,
+		LIBPFF_CODEPAGE_KOI8_R,
+		LIBPFF_CODEPAGE_KOI8_U };
+
+	libcerror_error_t *error = NULL;
+	int codepage             = 0;
+	int index                = 0;
+	int result               = 0;
+
+	/* Test set ASCII codepage
+	 */
+	for( index = 0;
+	     index < 15;
+	     index++ )
+	{
+		codepage = supported_codepages[ index ];
+
+		result = libpff_file_set_ascii_codepage(
+		          file,
+		          codepage,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libpff_file_set_ascii_codepage(
+	          NULL,
+	          LIBPFF_CODEPAGE_ASCII,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	for( index = 0;
+	     index < 17;
+	     index++ )
+	{
+		codepage = unsupported_codepages[ index ];
+
+		result = libpff_file_set_ascii_codepage(
+		          file,
+		          codepage,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		PFF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	/* Clean up
 	 */
-	result = libpff_file_is_corrupted(
-	          NULL,
+	result = libpff_file_set_ascii_codepage(
+	          file,
+	          LIBPFF_CODEPAGE_WINDOWS_1252,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	PFF_TEST_ASSERT_IS_NOT_NULL(
+	PFF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
 	return( 1 );
 
 on_error:
@@ -1286,40 +3374,54 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libpff_file_get_size function
+/* Tests the libpff_file_get_root_item function
  * Returns 1 if successful or 0 if not
  */
-int pff_test_file_get_size(
+int pff_test_file_get_root_item(
      libpff_file_t *file )
 {
 	libcerror_error_t *error = NULL;
-	size64_t size            = 0;
+	libpff_item_t *root_item = NULL;
 	int result               = 0;
-	int size_is_set          = 0;
 
 	/* Test regular cases
 	 */
-	result = libpff_file_get_size(
+	result = libpff_file_get_root_item(
 	          file,
-	          &size,
+	          &root_item,
 	          &error );
 
-	PFF_TEST_ASSERT_NOT_EQUAL_INT(
+	PFF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	PFF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	size_is_set = result;
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "root_item",
+	 root_item );
+
+	result = libpff_item_free(
+	          &root_item,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	/* Test error cases
 	 */
-	result = libpff_file_get_size(
+	result = libpff_file_get_root_item(
 	          NULL,
-	          &size,
+	          &root_item,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -1327,6 +3429,10 @@ int pff_test_file_get_size(
 	 result,
 	 -1 );
 
+	PFF_TEST_ASSERT_IS_NULL(
+	 "root_item",
+	 root_item );
+
 	PFF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
@@ -1334,25 +3440,27 @@ int pff_test_file_get_size(
 	libcerror_error_free(
 	 &error );
 
-	if( size_is_set != 0 )
-	{
-		result = libpff_file_get_size(
-		          file,
-		          NULL,
-		          &error );
+	result = libpff_file_get_root_item(
+	          file,
+	          NULL,
+	          &error );
 
-		PFF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		PFF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	PFF_TEST_ASSERT_IS_NULL(
+	 "root_item",
+	 root_item );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
 
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -1361,25 +3469,31 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( root_item != NULL )
+	{
+		libpff_item_free(
+		 &root_item,
+		 NULL );
+	}
 	return( 0 );
 }
 
-/* Tests the libpff_file_get_content_type function
+/* Tests the libpff_file_get_message_store function
  * Returns 1 if successful or 0 if not
  */
-int pff_test_file_get_content_type(
+int pff_test_file_get_message_store(
      libpff_file_t *file )
 {
-	libcerror_error_t *error = NULL;
-	uint8_t content_type     = 0;
-	int content_type_is_set  = 0;
-	int result               = 0;
+	libcerror_error_t *error     = NULL;
+	libpff_item_t *message_store = NULL;
+	int message_store_is_set     = 0;
+	int result                   = 0;
 
 	/* Test regular cases
 	 */
-	result = libpff_file_get_content_type(
+	result = libpff_file_get_message_store(
 	          file,
-	          &content_type,
+	          &message_store,
 	          &error );
 
 	PFF_TEST_ASSERT_NOT_EQUAL_INT(
@@ -1391,13 +3505,32 @@ int pff_test_file_get_content_type(
 	 "error",
 	 error );
 
-	content_type_is_set = result;
+	message_store_is_set = result;
+
+	if( message_store_is_set != 0 )
+	{
+		PFF_TEST_ASSERT_IS_NOT_NULL(
+		 "message_store",
+		 message_store );
+
+		result = libpff_item_free(
+		          &message_store,
+		          &error );
 
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
 	/* Test error cases
 	 */
-	result = libpff_file_get_content_type(
+	result = libpff_file_get_message_store(
 	          NULL,
-	          &content_type,
+	          &message_store,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -1405,6 +3538,10 @@ int pff_test_file_get_content_type(
 	 result,
 	 -1 );
 
+	PFF_TEST_ASSERT_IS_NULL(
+	 "message_store",
+	 message_store );
+
 	PFF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
@@ -1412,9 +3549,9 @@ int pff_test_file_get_content_type(
 	libcerror_error_free(
 	 &error );
 
-	if( content_type_is_set != 0 )
+	if( message_store_is_set != 0 )
 	{
-		result = libpff_file_get_content_type(
+		result = libpff_file_get_message_store(
 		          file,
 		          NULL,
 		          &error );
@@ -1424,6 +3561,10 @@ int pff_test_file_get_content_type(
 		 result,
 		 -1 );
 
+		PFF_TEST_ASSERT_IS_NULL(
+		 "message_store",
+		 message_store );
+
 		PFF_TEST_ASSERT_IS_NOT_NULL(
 		 "error",
 		 error );
@@ -1439,25 +3580,31 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( message_store != NULL )
+	{
+		libpff_item_free(
+		 &message_store,
+		 NULL );
+	}
 	return( 0 );
 }
 
-/* Tests the libpff_file_get_type function
+/* Tests the libpff_file_get_name_to_id_map function
  * Returns 1 if successful or 0 if not
  */
-int pff_test_file_get_type(
+int pff_test_file_get_name_to_id_map(
      libpff_file_t *file )
 {
-	libcerror_error_t *error = NULL;
-	uint8_t type             = 0;
-	int result               = 0;
-	int type_is_set          = 0;
+	libcerror_error_t *error      = NULL;
+	libpff_item_t *name_to_id_map = NULL;
+	int name_to_id_map_is_set     = 0;
+	int result                    = 0;
 
 	/* Test regular cases
 	 */
-	result = libpff_file_get_type(
+	result = libpff_file_get_name_to_id_map(
 	          file,
-	          &type,
+	          &name_to_id_map,
 	          &error );
 
 	PFF_TEST_ASSERT_NOT_EQUAL_INT(
@@ -1469,13 +3616,32 @@ int pff_test_file_get_type(
 	 "error",
 	 error );
 
-	type_is_set = result;
+	name_to_id_map_is_set = result;
+
+	if( name_to_id_map_is_set != 0 )
+	{
+		PFF_TEST_ASSERT_IS_NOT_NULL(
+		 "name_to_id_map",
+		 name_to_id_map );
+
+		result = libpff_item_free(
+		          &name_to_id_map,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
 
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
 	/* Test error cases
 	 */
-	result = libpff_file_get_type(
+	result = libpff_file_get_name_to_id_map(
 	          NULL,
-	          &type,
+	          &name_to_id_map,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -1483,6 +3649,10 @@ int pff_test_file_get_type(
 	 result,
 	 -1 );
 
+	PFF_TEST_ASSERT_IS_NULL(
+	 "name_to_id_map",
+	 name_to_id_map );
+
 	PFF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
@@ -1490,9 +3660,9 @@ int pff_test_file_get_type(
 	libcerror_error_free(
 	 &error );
 
-	if( type_is_set != 0 )
+	if( name_to_id_map_is_set != 0 )
 	{
-		result = libpff_file_get_type(
+		result = libpff_file_get_name_to_id_map(
 		          file,
 		          NULL,
 		          &error );
@@ -1502,6 +3672,10 @@ int pff_test_file_get_type(
 		 result,
 		 -1 );
 
+		PFF_TEST_ASSERT_IS_NULL(
+		 "name_to_id_map",
+		 name_to_id_map );
+
 		PFF_TEST_ASSERT_IS_NOT_NULL(
 		 "error",
 		 error );
@@ -1517,25 +3691,31 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( name_to_id_map != NULL )
+	{
+		libpff_item_free(
+		 &name_to_id_map,
+		 NULL );
+	}
 	return( 0 );
 }
 
-/* Tests the libpff_file_get_encryption_type function
+/* Tests the libpff_file_get_root_folder function
  * Returns 1 if successful or 0 if not
  */
-int pff_test_file_get_encryption_type(
+int pff_test_file_get_root_folder(
      libpff_file_t *file )
 {
 	libcerror_error_t *error   = NULL;
-	uint8_t encryption_type    = 0;
-	int encryption_type_is_set = 0;
+	libpff_item_t *root_folder = NULL;
 	int result                 = 0;
+	int root_folder_is_set     = 0;
 
 	/* Test regular cases
 	 */
-	result = libpff_file_get_encryption_type(
+	result = libpff_file_get_root_folder(
 	          file,
-	          &encryption_type,
+	          &root_folder,
 	          &error );
 
 	PFF_TEST_ASSERT_NOT_EQUAL_INT(
@@ -1547,13 +3727,32 @@ int pff_test_file_get_encryption_type(
 	 "error",
 	 error );
 
-	encryption_type_is_set = result;
+	root_folder_is_set = result;
+
+	if( root_folder_is_set != 0 )
+	{
+		PFF_TEST_ASSERT_IS_NOT_NULL(
+		 "root_folder",
+		 root_folder );
+
+		result = libpff_item_free(
+		          &root_folder,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
 
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
 	/* Test error cases
 	 */
-	result = libpff_file_get_encryption_type(
+	result = libpff_file_get_root_folder(
 	          NULL,
-	          &encryption_type,
+	          &root_folder,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -1561,6 +3760,10 @@ int pff_test_file_get_encryption_type(
 	 result,
 	 -1 );
 
+	PFF_TEST_ASSERT_IS_NULL(
+	 "root_folder",
+	 root_folder );
+
 	PFF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
@@ -1568,9 +3771,9 @@ int pff_test_file_get_encryption_type(
 	libcerror_error_free(
 	 &error );
 
-	if( encryption_type_is_set != 0 )
+	if( root_folder_is_set != 0 )
 	{
-		result = libpff_file_get_encryption_type(
+		result = libpff_file_get_root_folder(
 		          file,
 		          NULL,
 		          &error );
@@ -1580,6 +3783,10 @@ int pff_test_file_get_encryption_type(
 		 result,
 		 -1 );
 
+		PFF_TEST_ASSERT_IS_NULL(
+		 "root_folder",
+		 root_folder );
+
 		PFF_TEST_ASSERT_IS_NOT_NULL(
 		 "error",
 		 error );
@@ -1595,25 +3802,58 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( root_folder != NULL )
+	{
+		libpff_item_free(
+		 &root_folder,
+		 NULL );
+	}
 	return( 0 );
 }
 
-/* Tests the libpff_file_get_ascii_codepage function
+/* Callback function of the libpff_file_parallel_visit_items tests
+ * The callback data optionally points to the number of items, the visit is stopped when it is 0
+ * Returns 1 to continue, 0 to stop or -1 on error
+ */
+int pff_test_file_parallel_visit_items_callback_function(
+     libpff_item_t *item,
+     void *callback_data,
+     libcerror_error_t **error PFF_TEST_ATTRIBUTE_UNUSED )
+{
+	int *number_of_items = (int *) callback_data;
+
+	PFF_TEST_UNREFERENCED_PARAMETER( error )
+
+	if( item == NULL )
+	{
+		return( -1 );
+	}
+	if( number_of_items != NULL )
+	{
+		if( *number_of_items == 0 )
+		{
+			return( 0 );
+		}
+		*number_of_items += 1;
+	}
+	return( 1 );
+}
+
+/* Tests the libpff_file_parallel_visit_items function
  * Returns 1 if successful or 0 if not
  */
-int pff_test_file_get_ascii_codepage(
+int pff_test_file_parallel_visit_items(
      libpff_file_t *file )
 {
-	libcerror_error_t *error  = NULL;
-	int ascii_codepage        = 0;
-	int ascii_codepage_is_set = 0;
-	int result                = 0;
+	libcerror_error_t *error = NULL;
+	libpff_item_t *root_item = NULL;
+	int number_of_items      = 0;
+	int result               = 0;
+	int root_folder_is_set   = 0;
 
-	/* Test regular cases
-	 */
-	result = libpff_file_get_ascii_codepage(
+	result = libpff_file_get_root_folder(
 	          file,
-	          &ascii_codepage,
+	          &root_item,
 	          &error );
 
 	PFF_TEST_ASSERT_NOT_EQUAL_INT(
@@ -1625,131 +3865,124 @@ int pff_test_file_get_ascii_codepage(
 	 "error",
 	 error );
 
-	ascii_codepage_is_set = result;
+	root_folder_is_set = result;
 
-	/* Test error cases
+	if( root_item != NULL )
+	{
+		result = libpff_item_free(
+		          &root_item,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
 	 */
-	result = libpff_file_get_ascii_codepage(
-	          NULL,
-	          &ascii_codepage,
+	number_of_items = 1;
+
+	result = libpff_file_parallel_visit_items(
+	          file,
+	          0,
+	          &pff_test_file_parallel_visit_items_callback_function,
+	          &number_of_items,
+	          1,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	PFF_TEST_ASSERT_IS_NOT_NULL(
+	PFF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	if( ascii_codepage_is_set != 0 )
+	if( root_folder_is_set != 0 )
 	{
-		result = libpff_file_get_ascii_codepage(
+		PFF_TEST_ASSERT_GREATER_THAN_INT(
+		 "number_of_items",
+		 number_of_items,
+		 1 );
+
+		/* Test stopping the visit from the callback function
+		 */
+		number_of_items = 0;
+
+		result = libpff_file_parallel_visit_items(
 		          file,
-		          NULL,
+		          0,
+		          &pff_test_file_parallel_visit_items_callback_function,
+		          &number_of_items,
+		          1,
 		          &error );
 
 		PFF_TEST_ASSERT_EQUAL_INT(
 		 "result",
 		 result,
-		 -1 );
+		 0 );
 
-		PFF_TEST_ASSERT_IS_NOT_NULL(
+		PFF_TEST_ASSERT_IS_NULL(
 		 "error",
 		 error );
-
-		libcerror_error_free(
-		 &error );
 	}
-	return( 1 );
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The callback function is called concurrently, so the number of items
+	 * is not checked when multiple threads are used
+	 */
+	result = libpff_file_parallel_visit_items(
+	          file,
+	          LIBPFF_VISIT_FLAG_SKIP_OTHER_ITEMS,
+	          &pff_test_file_parallel_visit_items_callback_function,
+	          NULL,
+	          4,
+	          &error );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
+	PFF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-/* Tests the libpff_file_set_ascii_codepage function
- * Returns 1 if successful or 0 if not
- */
-int pff_test_file_set_ascii_codepage(
-     libpff_file_t *file )
-{
-	int supported_codepages[ 15 ] = {
-		LIBPFF_CODEPAGE_ASCII,
-		LIBPFF_CODEPAGE_WINDOWS_874,
-		LIBPFF_CODEPAGE_WINDOWS_932,
-		LIBPFF_CODEPAGE_WINDOWS_936,
-		LIBPFF_CODEPAGE_WINDOWS_949,
-		LIBPFF_CODEPAGE_WINDOWS_950,
-		LIBPFF_CODEPAGE_WINDOWS_1250,
-		LIBPFF_CODEPAGE_WINDOWS_1251,
-		LIBPFF_CODEPAGE_WINDOWS_1252,
-		LIBPFF_CODEPAGE_WINDOWS_1253,
-		LIBPFF_CODEPAGE_WINDOWS_1254,
-		LIBPFF_CODEPAGE_WINDOWS_1255,
-		LIBPFF_CODEPAGE_WINDOWS_1256,
-		LIBPFF_CODEPAGE_WINDOWS_1257,
-		LIBPFF_CODEPAGE_WINDOWS_1258 };
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	int unsupported_codepages[ 17 ] = {
-		LIBPFF_CODEPAGE_ISO_8859_1,
-		LIBPFF_CODEPAGE_ISO_8859_2,
-		LIBPFF_CODEPAGE_ISO_8859_3,
-		LIBPFF_CODEPAGE_ISO_8859_4,
-		LIBPFF_CODEPAGE_ISO_8859_5,
-		LIBPFF_CODEPAGE_ISO_8859_6,
-		LIBPFF_CODEPAGE_ISO_8859_7,
-		LIBPFF_CODEPAGE_ISO_8859_8,
-		LIBPFF_CODEPAGE_ISO_8859_9,
-		LIBPFF_CODEPAGE_ISO_8859_10,
-		LIBPFF_CODEPAGE_ISO_8859_11,
-		LIBPFF_CODEPAGE_ISO_8859_13,
-		LIBPFF_CODEPAGE_ISO_8859_14,
-		LIBPFF_CODEPAGE_ISO_8859_15,
-		LIBPFF_CODEPAGE_ISO_8859_16,
-		LIBPFF_CODEPAGE_KOI8_R,
-		LIBPFF_CODEPAGE_KOI8_U };
+#else
+	result = libpff_file_parallel_visit_items(
+	          file,
+	          0,
+	          &pff_test_file_parallel_visit_items_callback_function,
+	          &number_of_items,
+	          2,
+	          &error );
 
-	libcerror_error_t *error = NULL;
-	int codepage             = 0;
-	int index                = 0;
-	int result               = 0;
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-	/* Test set ASCII codepage
-	 */
-	for( index = 0;
-	     index < 15;
-	     index++ )
-	{
-		codepage = supported_codepages[ index ];
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-		result = libpff_file_set_ascii_codepage(
-		          file,
-		          codepage,
-		          &error );
+	libcerror_error_free(
+	 &error );
 
-		PFF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 1 );
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
-		PFF_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
-	}
 	/* Test error cases
 	 */
-	result = libpff_file_set_ascii_codepage(
+	result = libpff_file_parallel_visit_items(
 	          NULL,
-	          LIBPFF_CODEPAGE_ASCII,
+	          0,
+	          &pff_test_file_parallel_visit_items_callback_function,
+	          &number_of_items,
+	          1,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -1764,45 +3997,66 @@ int pff_test_file_set_ascii_codepage(
 	libcerror_error_free(
 	 &error );
 
-	for( index = 0;
-	     index < 17;
-	     index++ )
-	{
-		codepage = unsupported_codepages[ index ];
+	result = libpff_file_parallel_visit_items(
+	          file,
+	          0xff,
+	          &pff_test_file_parallel_visit_items_callback_function,
+	          &number_of_items,
+	          1,
+	          &error );
 
-		result = libpff_file_set_ascii_codepage(
-		          file,
-		          codepage,
-		          &error );
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		PFF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-		PFF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	libcerror_error_free(
+	 &error );
 
-		libcerror_error_free(
-		 &error );
-	}
-	/* Clean up
-	 */
-	result = libpff_file_set_ascii_codepage(
+	result = libpff_file_parallel_visit_items(
 	          file,
-	          LIBPFF_CODEPAGE_WINDOWS_1252,
+	          0,
+	          NULL,
+	          &number_of_items,
+	          1,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
-	PFF_TEST_ASSERT_IS_NULL(
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_file_parallel_visit_items(
+	          file,
+	          0,
+	          &pff_test_file_parallel_visit_items_callback_function,
+	          &number_of_items,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
+	libcerror_error_free(
+	 &error );
+
 	return( 1 );
 
 on_error:
@@ -1811,41 +4065,30 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( root_item != NULL )
+	{
+		libpff_item_free(
+		 &root_item,
+		 NULL );
+	}
 	return( 0 );
 }
 
-/* Tests the libpff_file_get_root_item function
+/* Tests the libpff_file_get_number_of_orphan_items function
  * Returns 1 if successful or 0 if not
  */
-int pff_test_file_get_root_item(
+int pff_test_file_get_number_of_orphan_items(
      libpff_file_t *file )
 {
-	libcerror_error_t *error = NULL;
-	libpff_item_t *root_item = NULL;
-	int result               = 0;
+	libcerror_error_t *error   = NULL;
+	int number_of_orphan_items = 0;
+	int result                 = 0;
 
 	/* Test regular cases
 	 */
-	result = libpff_file_get_root_item(
+	result = libpff_file_get_number_of_orphan_items(
 	          file,
-	          &root_item,
-	          &error );
-
-	PFF_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 1 );
-
-	PFF_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
-
-	PFF_TEST_ASSERT_IS_NOT_NULL(
-	 "root_item",
-	 root_item );
-
-	result = libpff_item_free(
-	          &root_item,
+	          &number_of_orphan_items,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -1859,9 +4102,9 @@ int pff_test_file_get_root_item(
 
 	/* Test error cases
 	 */
-	result = libpff_file_get_root_item(
+	result = libpff_file_get_number_of_orphan_items(
 	          NULL,
-	          &root_item,
+	          &number_of_orphan_items,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -1869,10 +4112,6 @@ int pff_test_file_get_root_item(
 	 result,
 	 -1 );
 
-	PFF_TEST_ASSERT_IS_NULL(
-	 "root_item",
-	 root_item );
-
 	PFF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
@@ -1880,7 +4119,7 @@ int pff_test_file_get_root_item(
 	libcerror_error_free(
 	 &error );
 
-	result = libpff_file_get_root_item(
+	result = libpff_file_get_number_of_orphan_items(
 	          file,
 	          NULL,
 	          &error );
@@ -1890,10 +4129,6 @@ int pff_test_file_get_root_item(
 	 result,
 	 -1 );
 
-	PFF_TEST_ASSERT_IS_NULL(
-	 "root_item",
-	 root_item );
-
 	PFF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
@@ -1909,52 +4144,61 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( root_item != NULL )
-	{
-		libpff_item_free(
-		 &root_item,
-		 NULL );
-	}
 	return( 0 );
 }
 
-/* Tests the libpff_file_get_message_store function
+/* Tests the libpff_file_get_orphan_item_by_index function
  * Returns 1 if successful or 0 if not
  */
-int pff_test_file_get_message_store(
+int pff_test_file_get_orphan_item_by_index(
      libpff_file_t *file )
 {
-	libcerror_error_t *error     = NULL;
-	libpff_item_t *message_store = NULL;
-	int message_store_is_set     = 0;
-	int result                   = 0;
+	libcerror_error_t *error   = NULL;
+	libpff_item_t *orphan_item = NULL;
+	int number_of_orphan_items = 0;
+	int result                 = 0;
 
-	/* Test regular cases
+	/* Initialize test
 	 */
-	result = libpff_file_get_message_store(
+	result = libpff_file_get_number_of_orphan_items(
 	          file,
-	          &message_store,
+	          &number_of_orphan_items,
 	          &error );
 
-	PFF_TEST_ASSERT_NOT_EQUAL_INT(
+	PFF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	PFF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	message_store_is_set = result;
-
-	if( message_store_is_set != 0 )
+	/* Test regular cases
+	 */
+	if( number_of_orphan_items > 0 )
 	{
+		result = libpff_file_get_orphan_item_by_index(
+		          file,
+		          0,
+		          &orphan_item,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
 		PFF_TEST_ASSERT_IS_NOT_NULL(
-		 "message_store",
-		 message_store );
+		 "orphan_item",
+		 orphan_item );
 
 		result = libpff_item_free(
-		          &message_store,
+		          &orphan_item,
 		          &error );
 
 		PFF_TEST_ASSERT_EQUAL_INT(
@@ -1968,9 +4212,10 @@ int pff_test_file_get_message_store(
 	}
 	/* Test error cases
 	 */
-	result = libpff_file_get_message_store(
+	result = libpff_file_get_orphan_item_by_index(
 	          NULL,
-	          &message_store,
+	          0,
+	          &orphan_item,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -1979,8 +4224,8 @@ int pff_test_file_get_message_store(
 	 -1 );
 
 	PFF_TEST_ASSERT_IS_NULL(
-	 "message_store",
-	 message_store );
+	 "orphan_item",
+	 orphan_item );
 
 	PFF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1989,29 +4234,50 @@ int pff_test_file_get_message_store(
 	libcerror_error_free(
 	 &error );
 
-	if( message_store_is_set != 0 )
-	{
-		result = libpff_file_get_message_store(
-		          file,
-		          NULL,
-		          &error );
+	result = libpff_file_get_orphan_item_by_index(
+	          file,
+	          -1,
+	          &orphan_item,
+	          &error );
 
-		PFF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		PFF_TEST_ASSERT_IS_NULL(
-		 "message_store",
-		 message_store );
+	PFF_TEST_ASSERT_IS_NULL(
+	 "orphan_item",
+	 orphan_item );
 
-		PFF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_file_get_orphan_item_by_index(
+	          file,
+	          0,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "orphan_item",
+	 orphan_item );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
 
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -2020,68 +4286,46 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( message_store != NULL )
+	if( orphan_item != NULL )
 	{
 		libpff_item_free(
-		 &message_store,
+		 &orphan_item,
 		 NULL );
 	}
 	return( 0 );
 }
 
-/* Tests the libpff_file_get_name_to_id_map function
+/* Tests the libpff_file_get_number_of_recovered_items function
  * Returns 1 if successful or 0 if not
  */
-int pff_test_file_get_name_to_id_map(
+int pff_test_file_get_number_of_recovered_items(
      libpff_file_t *file )
 {
 	libcerror_error_t *error      = NULL;
-	libpff_item_t *name_to_id_map = NULL;
-	int name_to_id_map_is_set     = 0;
+	int number_of_recovered_items = 0;
 	int result                    = 0;
 
 	/* Test regular cases
 	 */
-	result = libpff_file_get_name_to_id_map(
+	result = libpff_file_get_number_of_recovered_items(
 	          file,
-	          &name_to_id_map,
+	          &number_of_recovered_items,
 	          &error );
 
-	PFF_TEST_ASSERT_NOT_EQUAL_INT(
+	PFF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	PFF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	name_to_id_map_is_set = result;
-
-	if( name_to_id_map_is_set != 0 )
-	{
-		PFF_TEST_ASSERT_IS_NOT_NULL(
-		 "name_to_id_map",
-		 name_to_id_map );
-
-		result = libpff_item_free(
-		          &name_to_id_map,
-		          &error );
-
-		PFF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 1 );
-
-		PFF_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
-	}
 	/* Test error cases
 	 */
-	result = libpff_file_get_name_to_id_map(
+	result = libpff_file_get_number_of_recovered_items(
 	          NULL,
-	          &name_to_id_map,
+	          &number_of_recovered_items,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -2089,10 +4333,6 @@ int pff_test_file_get_name_to_id_map(
 	 result,
 	 -1 );
 
-	PFF_TEST_ASSERT_IS_NULL(
-	 "name_to_id_map",
-	 name_to_id_map );
-
 	PFF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
@@ -2100,29 +4340,23 @@ int pff_test_file_get_name_to_id_map(
 	libcerror_error_free(
 	 &error );
 
-	if( name_to_id_map_is_set != 0 )
-	{
-		result = libpff_file_get_name_to_id_map(
-		          file,
-		          NULL,
-		          &error );
+	result = libpff_file_get_number_of_recovered_items(
+	          file,
+	          NULL,
+	          &error );
 
-		PFF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		PFF_TEST_ASSERT_IS_NULL(
-		 "name_to_id_map",
-		 name_to_id_map );
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-		PFF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	libcerror_error_free(
+	 &error );
 
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -2131,52 +4365,61 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( name_to_id_map != NULL )
-	{
-		libpff_item_free(
-		 &name_to_id_map,
-		 NULL );
-	}
 	return( 0 );
 }
 
-/* Tests the libpff_file_get_root_folder function
+/* Tests the libpff_file_get_recovered_item_by_index function
  * Returns 1 if successful or 0 if not
  */
-int pff_test_file_get_root_folder(
+int pff_test_file_get_recovered_item_by_index(
      libpff_file_t *file )
 {
-	libcerror_error_t *error   = NULL;
-	libpff_item_t *root_folder = NULL;
-	int result                 = 0;
-	int root_folder_is_set     = 0;
+	libcerror_error_t *error      = NULL;
+	libpff_item_t *recovered_item = NULL;
+	int number_of_recovered_items = 0;
+	int result                    = 0;
 
-	/* Test regular cases
+	/* Initialize test
 	 */
-	result = libpff_file_get_root_folder(
+	result = libpff_file_get_number_of_recovered_items(
 	          file,
-	          &root_folder,
+	          &number_of_recovered_items,
 	          &error );
 
-	PFF_TEST_ASSERT_NOT_EQUAL_INT(
+	PFF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	PFF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	root_folder_is_set = result;
-
-	if( root_folder_is_set != 0 )
+	/* Test regular cases
+	 */
+	if( number_of_recovered_items > 0 )
 	{
+		result = libpff_file_get_recovered_item_by_index(
+		          file,
+		          0,
+		          &recovered_item,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
 		PFF_TEST_ASSERT_IS_NOT_NULL(
-		 "root_folder",
-		 root_folder );
+		 "recovered_item",
+		 recovered_item );
 
 		result = libpff_item_free(
-		          &root_folder,
+		          &recovered_item,
 		          &error );
 
 		PFF_TEST_ASSERT_EQUAL_INT(
@@ -2190,9 +4433,10 @@ int pff_test_file_get_root_folder(
 	}
 	/* Test error cases
 	 */
-	result = libpff_file_get_root_folder(
+	result = libpff_file_get_recovered_item_by_index(
 	          NULL,
-	          &root_folder,
+	          0,
+	          &recovered_item,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -2201,8 +4445,8 @@ int pff_test_file_get_root_folder(
 	 -1 );
 
 	PFF_TEST_ASSERT_IS_NULL(
-	 "root_folder",
-	 root_folder );
+	 "recovered_item",
+	 recovered_item );
 
 	PFF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2211,83 +4455,20 @@ int pff_test_file_get_root_folder(
 	libcerror_error_free(
 	 &error );
 
-	if( root_folder_is_set != 0 )
-	{
-		result = libpff_file_get_root_folder(
-		          file,
-		          NULL,
-		          &error );
-
-		PFF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
-
-		PFF_TEST_ASSERT_IS_NULL(
-		 "root_folder",
-		 root_folder );
-
-		PFF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
-	}
-	return( 1 );
-
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	if( root_folder != NULL )
-	{
-		libpff_item_free(
-		 &root_folder,
-		 NULL );
-	}
-	return( 0 );
-}
-
-/* Tests the libpff_file_get_number_of_orphan_items function
- * Returns 1 if successful or 0 if not
- */
-int pff_test_file_get_number_of_orphan_items(
-     libpff_file_t *file )
-{
-	libcerror_error_t *error   = NULL;
-	int number_of_orphan_items = 0;
-	int result                 = 0;
-
-	/* Test regular cases
-	 */
-	result = libpff_file_get_number_of_orphan_items(
+	result = libpff_file_get_recovered_item_by_index(
 	          file,
-	          &number_of_orphan_items,
+	          -1,
+	          &recovered_item,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
 	PFF_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
-
-	/* Test error cases
-	 */
-	result = libpff_file_get_number_of_orphan_items(
-	          NULL,
-	          &number_of_orphan_items,
-	          &error );
-
-	PFF_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
+	 "recovered_item",
+	 recovered_item );
 
 	PFF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2296,8 +4477,9 @@ int pff_test_file_get_number_of_orphan_items(
 	libcerror_error_free(
 	 &error );
 
-	result = libpff_file_get_number_of_orphan_items(
+	result = libpff_file_get_recovered_item_by_index(
 	          file,
+	          0,
 	          NULL,
 	          &error );
 
@@ -2306,6 +4488,10 @@ int pff_test_file_get_number_of_orphan_items(
 	 result,
 	 -1 );
 
+	PFF_TEST_ASSERT_IS_NULL(
+	 "recovered_item",
+	 recovered_item );
+
 	PFF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
@@ -2321,25 +4507,31 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( recovered_item != NULL )
+	{
+		libpff_item_free(
+		 &recovered_item,
+		 NULL );
+	}
 	return( 0 );
 }
 
-/* Tests the libpff_file_get_orphan_item_by_index function
+/* Tests the libpff_file_get_recovered_item_validation_status function
  * Returns 1 if successful or 0 if not
  */
-int pff_test_file_get_orphan_item_by_index(
+int pff_test_file_get_recovered_item_validation_status(
      libpff_file_t *file )
 {
-	libcerror_error_t *error   = NULL;
-	libpff_item_t *orphan_item = NULL;
-	int number_of_orphan_items = 0;
-	int result                 = 0;
+	libcerror_error_t *error      = NULL;
+	uint8_t validation_status     = 0;
+	int number_of_recovered_items = 0;
+	int result                    = 0;
 
 	/* Initialize test
 	 */
-	result = libpff_file_get_number_of_orphan_items(
+	result = libpff_file_get_number_of_recovered_items(
 	          file,
-	          &number_of_orphan_items,
+	          &number_of_recovered_items,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -2353,12 +4545,12 @@ int pff_test_file_get_orphan_item_by_index(
 
 	/* Test regular cases
 	 */
-	if( number_of_orphan_items > 0 )
+	if( number_of_recovered_items > 0 )
 	{
-		result = libpff_file_get_orphan_item_by_index(
+		result = libpff_file_get_recovered_item_validation_status(
 		          file,
 		          0,
-		          &orphan_item,
+		          &validation_status,
 		          &error );
 
 		PFF_TEST_ASSERT_EQUAL_INT(
@@ -2370,12 +4562,24 @@ int pff_test_file_get_orphan_item_by_index(
 		 "error",
 		 error );
 
-		PFF_TEST_ASSERT_IS_NOT_NULL(
-		 "orphan_item",
-		 orphan_item );
+		result = libpff_file_validate_recovered_item(
+		          file,
+		          0,
+		          &error );
 
-		result = libpff_item_free(
-		          &orphan_item,
+		PFF_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libpff_file_get_recovered_item_validation_status(
+		          file,
+		          0,
+		          &validation_status,
 		          &error );
 
 		PFF_TEST_ASSERT_EQUAL_INT(
@@ -2386,13 +4590,18 @@ int pff_test_file_get_orphan_item_by_index(
 		PFF_TEST_ASSERT_IS_NULL(
 		 "error",
 		 error );
+
+		PFF_TEST_ASSERT_NOT_EQUAL_INT(
+		 "validation_status",
+		 (int) validation_status,
+		 LIBPFF_VALIDATION_STATUS_PENDING );
 	}
 	/* Test error cases
 	 */
-	result = libpff_file_get_orphan_item_by_index(
+	result = libpff_file_get_recovered_item_validation_status(
 	          NULL,
 	          0,
-	          &orphan_item,
+	          &validation_status,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -2400,10 +4609,6 @@ int pff_test_file_get_orphan_item_by_index(
 	 result,
 	 -1 );
 
-	PFF_TEST_ASSERT_IS_NULL(
-	 "orphan_item",
-	 orphan_item );
-
 	PFF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
@@ -2411,10 +4616,10 @@ int pff_test_file_get_orphan_item_by_index(
 	libcerror_error_free(
 	 &error );
 
-	result = libpff_file_get_orphan_item_by_index(
+	result = libpff_file_get_recovered_item_validation_status(
 	          file,
 	          -1,
-	          &orphan_item,
+	          &validation_status,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -2422,10 +4627,6 @@ int pff_test_file_get_orphan_item_by_index(
 	 result,
 	 -1 );
 
-	PFF_TEST_ASSERT_IS_NULL(
-	 "orphan_item",
-	 orphan_item );
-
 	PFF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
@@ -2433,7 +4634,7 @@ int pff_test_file_get_orphan_item_by_index(
 	libcerror_error_free(
 	 &error );
 
-	result = libpff_file_get_orphan_item_by_index(
+	result = libpff_file_get_recovered_item_validation_status(
 	          file,
 	          0,
 	          NULL,
@@ -2444,9 +4645,22 @@ int pff_test_file_get_orphan_item_by_index(
 	 result,
 	 -1 );
 
-	PFF_TEST_ASSERT_IS_NULL(
-	 "orphan_item",
-	 orphan_item );
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_file_validate_recovered_item(
+	          NULL,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	PFF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2463,30 +4677,106 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( orphan_item != NULL )
+	return( 0 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+/* Appends a recovered item with a specific validation status to the file
+ * Returns 1 if successful or -1 on error
+ */
+int pff_test_file_append_recovered_item(
+     libpff_internal_file_t *internal_file,
+     uint32_t item_identifier,
+     uint8_t validation_status,
+     libcdata_tree_node_t **item_tree_node,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *safe_item_tree_node = NULL;
+	libpff_item_descriptor_t *item_descriptor = NULL;
+	int entry_index                           = 0;
+
+	if( item_tree_node == NULL )
 	{
-		libpff_item_free(
-		 &orphan_item,
+		return( -1 );
+	}
+	if( libpff_item_descriptor_initialize(
+	     &item_descriptor,
+	     item_identifier,
+	     0,
+	     0,
+	     1,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	item_descriptor->validation_status = validation_status;
+
+	if( libcdata_tree_node_initialize(
+	     &safe_item_tree_node,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libcdata_tree_node_set_value(
+	     safe_item_tree_node,
+	     (intptr_t *) item_descriptor,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	item_descriptor = NULL;
+
+	if( libcdata_array_append_entry(
+	     internal_file->recovered_item_array,
+	     &entry_index,
+	     (intptr_t *) safe_item_tree_node,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	*item_tree_node = safe_item_tree_node;
+
+	return( 1 );
+
+on_error:
+	if( safe_item_tree_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 &safe_item_tree_node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_descriptor_free,
+		 NULL );
+	}
+	if( item_descriptor != NULL )
+	{
+		libpff_item_descriptor_free(
+		 &item_descriptor,
 		 NULL );
 	}
-	return( 0 );
+	return( -1 );
 }
 
-/* Tests the libpff_file_get_number_of_recovered_items function
+/* Tests the libpff_file_get_recovered_item_by_identifier function with versions that fail validation
  * Returns 1 if successful or 0 if not
  */
-int pff_test_file_get_number_of_recovered_items(
-     libpff_file_t *file )
+int pff_test_file_get_recovered_item_by_identifier_skip_invalid(
+     void )
 {
-	libcerror_error_t *error      = NULL;
-	int number_of_recovered_items = 0;
-	int result                    = 0;
+	uint8_t data[ 512 ];
 
-	/* Test regular cases
+	libbfio_handle_t *file_io_handle            = NULL;
+	libcdata_tree_node_t *invalid_tree_node     = NULL;
+	libcdata_tree_node_t *valid_tree_node       = NULL;
+	libcerror_error_t *error                    = NULL;
+	libpff_file_t *file                         = NULL;
+	libpff_internal_file_t *internal_file       = NULL;
+	libpff_item_t *recovered_item               = NULL;
+	int result                                  = 0;
+
+	/* Initialize test
 	 */
-	result = libpff_file_get_number_of_recovered_items(
-	          file,
-	          &number_of_recovered_items,
+	result = libpff_file_initialize(
+	          &file,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -2494,73 +4784,91 @@ int pff_test_file_get_number_of_recovered_items(
 	 result,
 	 1 );
 
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "file",
+	 file );
+
 	PFF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	result = libpff_file_get_number_of_recovered_items(
-	          NULL,
-	          &number_of_recovered_items,
+	internal_file = (libpff_internal_file_t *) file;
+
+	result = pff_test_open_file_io_handle(
+	          &file_io_handle,
+	          data,
+	          512,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	internal_file->file_io_handle = file_io_handle;
 
-	result = libpff_file_get_number_of_recovered_items(
-	          file,
-	          NULL,
+	result = libcdata_array_initialize(
+	          &( internal_file->recovered_item_array ),
+	          0,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	PFF_TEST_ASSERT_IS_NOT_NULL(
+	PFF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	/* The first version of item 10 failed validation, the second is valid
+	 * and item 20 only has a version that failed validation
+	 */
+	result = pff_test_file_append_recovered_item(
+	          internal_file,
+	          10,
+	          LIBPFF_VALIDATION_STATUS_INVALID,
+	          &invalid_tree_node,
+	          &error );
 
-	return( 1 );
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-/* Tests the libpff_file_get_recovered_item_by_index function
- * Returns 1 if successful or 0 if not
- */
-int pff_test_file_get_recovered_item_by_index(
-     libpff_file_t *file )
-{
-	libcerror_error_t *error      = NULL;
-	libpff_item_t *recovered_item = NULL;
-	int number_of_recovered_items = 0;
-	int result                    = 0;
+	result = pff_test_file_append_recovered_item(
+	          internal_file,
+	          10,
+	          LIBPFF_VALIDATION_STATUS_VALID,
+	          &valid_tree_node,
+	          &error );
 
-	/* Initialize test
-	 */
-	result = libpff_file_get_number_of_recovered_items(
-	          file,
-	          &number_of_recovered_items,
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = pff_test_file_append_recovered_item(
+	          internal_file,
+	          20,
+	          LIBPFF_VALIDATION_STATUS_INVALID,
+	          &invalid_tree_node,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -2574,107 +4882,128 @@ int pff_test_file_get_recovered_item_by_index(
 
 	/* Test regular cases
 	 */
-	if( number_of_recovered_items > 0 )
-	{
-		result = libpff_file_get_recovered_item_by_index(
-		          file,
-		          0,
-		          &recovered_item,
-		          &error );
+	result = libpff_file_get_recovered_item_by_identifier(
+	          file,
+	          10,
+	          &recovered_item,
+	          &error );
 
-		PFF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 1 );
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		PFF_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "recovered_item",
+	 recovered_item );
 
-		PFF_TEST_ASSERT_IS_NOT_NULL(
-		 "recovered_item",
-		 recovered_item );
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		result = libpff_item_free(
-		          &recovered_item,
-		          &error );
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "item_tree_node",
+	 (int) ( ( (libpff_internal_item_t *) recovered_item )->item_tree_node == valid_tree_node ),
+	 1 );
 
-		PFF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 1 );
+	result = libpff_item_free(
+	          &recovered_item,
+	          &error );
 
-		PFF_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
-	}
-	/* Test error cases
-	 */
-	result = libpff_file_get_recovered_item_by_index(
-	          NULL,
-	          0,
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_file_get_recovered_item_by_identifier(
+	          file,
+	          20,
 	          &recovered_item,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 0 );
 
 	PFF_TEST_ASSERT_IS_NULL(
 	 "recovered_item",
 	 recovered_item );
 
-	PFF_TEST_ASSERT_IS_NOT_NULL(
+	PFF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	result = libpff_file_get_recovered_item_by_index(
+	result = libpff_file_get_recovered_item_by_identifier(
 	          file,
-	          -1,
+	          30,
 	          &recovered_item,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 0 );
 
 	PFF_TEST_ASSERT_IS_NULL(
 	 "recovered_item",
 	 recovered_item );
 
-	PFF_TEST_ASSERT_IS_NOT_NULL(
+	PFF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	/* Clean up
+	 */
+	internal_file->file_io_handle = NULL;
 
-	result = libpff_file_get_recovered_item_by_index(
-	          file,
-	          0,
-	          NULL,
+	result = libcdata_array_free(
+	          &( internal_file->recovered_item_array ),
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_tree_node_free_recovered,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	PFF_TEST_ASSERT_IS_NULL(
-	 "recovered_item",
-	 recovered_item );
+	 "error",
+	 error );
 
-	PFF_TEST_ASSERT_IS_NOT_NULL(
+	result = libpff_file_free(
+	          &file,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "file",
+	 file );
+
+	PFF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	result = pff_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	return( 1 );
 
@@ -2690,9 +5019,32 @@ on_error:
 		 &recovered_item,
 		 NULL );
 	}
+	if( file != NULL )
+	{
+		internal_file->file_io_handle = NULL;
+
+		if( internal_file->recovered_item_array != NULL )
+		{
+			libcdata_array_free(
+			 &( internal_file->recovered_item_array ),
+			 (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_tree_node_free_recovered,
+			 NULL );
+		}
+		libpff_file_free(
+		 &file,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		pff_test_close_file_io_handle(
+		 &file_io_handle,
+		 NULL );
+	}
 	return( 0 );
 }
 
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -2750,6 +5102,14 @@ int main(
 	 "libpff_file_free",
 	 pff_test_file_free );
 
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+	PFF_TEST_RUN(
+	 "libpff_file_get_recovered_item_by_identifier_skip_invalid",
+	 pff_test_file_get_recovered_item_by_identifier_skip_invalid );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
 #if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
 	if( source != NULL )
 	{
@@ -2838,6 +5198,20 @@ int main(
 		 pff_test_file_open_close,
 		 source );
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+		PFF_TEST_RUN_WITH_ARGS(
+		 "libpff_file_open_close_parallel",
+		 pff_test_file_open_close_parallel,
+		 source );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+		PFF_TEST_RUN_WITH_ARGS(
+		 "libpff_file_open_caller_driven",
+		 pff_test_file_open_caller_driven,
+		 source );
+
 		/* Initialize file for tests
 		 */
 		result = pff_test_file_open_source(
@@ -2863,6 +5237,16 @@ int main(
 		 pff_test_file_signal_abort,
 		 file );
 
+		PFF_TEST_RUN_WITH_ARGS(
+		 "libpff_file_set_parallel_open",
+		 pff_test_file_set_parallel_open,
+		 file );
+
+		PFF_TEST_RUN_WITH_ARGS(
+		 "libpff_file_set_access_hint_flags",
+		 pff_test_file_set_access_hint_flags,
+		 file );
+
 #if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
 
 		/* TODO: add tests for libpff_internal_file_open_read */
@@ -2871,6 +5255,11 @@ int main(
 
 #endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
 
+		PFF_TEST_RUN_WITH_ARGS(
+		 "libpff_file_refresh",
+		 pff_test_file_refresh,
+		 file );
+
 		PFF_TEST_RUN_WITH_ARGS(
 		 "libpff_file_is_corrupted",
 		 pff_test_file_is_corrupted,
@@ -2878,11 +5267,21 @@ int main(
 
 		/* TODO: add tests for libpff_file_recover_items */
 
+		PFF_TEST_RUN_WITH_ARGS(
+		 "libpff_file_recover_items",
+		 pff_test_file_recover_items_read_budget,
+		 file );
+
 		PFF_TEST_RUN_WITH_ARGS(
 		 "libpff_file_get_size",
 		 pff_test_file_get_size,
 		 file );
 
+		PFF_TEST_RUN_WITH_ARGS(
+		 "libpff_file_get_read_statistics",
+		 pff_test_file_get_read_statistics,
+		 file );
+
 		PFF_TEST_RUN_WITH_ARGS(
 		 "libpff_file_get_content_type",
 		 pff_test_file_get_content_type,
@@ -2934,6 +5333,11 @@ int main(
 
 		/* TODO: add tests for libpff_file_get_item_by_identifier */
 
+		PFF_TEST_RUN_WITH_ARGS(
+		 "libpff_file_parallel_visit_items",
+		 pff_test_file_parallel_visit_items,
+		 file );
+
 		PFF_TEST_RUN_WITH_ARGS(
 		 "libpff_file_get_number_of_orphan_items",
 		 pff_test_file_get_number_of_orphan_items,
@@ -2968,6 +5372,11 @@ int main(
 		 "libpff_file_get_recovered_item_by_index",
 		 pff_test_file_get_recovered_item_by_index,
 		 file );
+
+		PFF_TEST_RUN_WITH_ARGS(
+		 "libpff_file_get_recovered_item_validation_status",
+		 pff_test_file_get_recovered_item_validation_status,
+		 file );
 */
 
 		/* Clean up
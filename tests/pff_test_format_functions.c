@@ -0,0 +1,448 @@
+/*
+ * Library format functions test program
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "pff_test_libcerror.h"
+#include "pff_test_libpff.h"
+#include "pff_test_macros.h"
+#include "pff_test_memory.h"
+#include "pff_test_unused.h"
+
+#include "../libpff/libpff_io_handle.h"
+#include "../libpff/libpff_definitions.h"
+#include "../libpff/libpff_format_functions.h"
+
+uint8_t pff_test_format_functions_descriptor_entry_32bit[ 16 ] = {
+	0x21, 0x00, 0x00, 0x00, 0x48, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x22, 0x01, 0x00, 0x00 };
+
+uint8_t pff_test_format_functions_descriptor_entry_64bit[ 32 ] = {
+	0x21, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x22, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+uint8_t pff_test_format_functions_branch_entries_32bit[ 24 ] = {
+	0x21, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00, 0x00,
+	0x61, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x46, 0x00, 0x00 };
+
+uint8_t pff_test_format_functions_descriptor_entries_32bit[ 48 ] = {
+	0x21, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x22, 0x01, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x48, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x22, 0x01, 0x00, 0x00,
+	0x41, 0x00, 0x00, 0x00, 0x48, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x22, 0x01, 0x00, 0x00 };
+
+uint8_t pff_test_format_functions_local_descriptor_leaf_entries_32bit[ 24 ] = {
+	0x21, 0x00, 0x00, 0x00, 0x48, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+/* Tests the libpff_format_functions_get function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_format_functions_get(
+     void )
+{
+	const libpff_format_functions_t *format_functions = NULL;
+	libcerror_error_t *error                          = NULL;
+	int result                                        = 0;
+
+	/* Test regular cases
+	 */
+	result = libpff_format_functions_get(
+	          LIBPFF_FILE_TYPE_32BIT,
+	          &format_functions,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "format_functions",
+	 format_functions );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_SIZE(
+	 "format_functions->index_node_size",
+	 format_functions->index_node_size,
+	 (size_t) 512 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "format_functions->index_node_descriptor_entry_size",
+	 format_functions->index_node_descriptor_entry_size,
+	 16 );
+
+	result = libpff_format_functions_get(
+	          LIBPFF_FILE_TYPE_64BIT,
+	          &format_functions,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_SIZE(
+	 "format_functions->index_node_size",
+	 format_functions->index_node_size,
+	 (size_t) 512 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "format_functions->index_node_descriptor_entry_size",
+	 format_functions->index_node_descriptor_entry_size,
+	 32 );
+
+	result = libpff_format_functions_get(
+	          LIBPFF_FILE_TYPE_64BIT_4K_PAGE,
+	          &format_functions,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_SIZE(
+	 "format_functions->index_node_size",
+	 format_functions->index_node_size,
+	 (size_t) 4096 );
+
+	/* Test error cases
+	 */
+	result = libpff_format_functions_get(
+	          0xff,
+	          &format_functions,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_format_functions_get(
+	          LIBPFF_FILE_TYPE_32BIT,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the read index node descriptor entry functions
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_format_functions_read_index_node_descriptor_entry(
+     void )
+{
+	uint64_t data_identifier              = 0;
+	uint64_t identifier                   = 0;
+	uint64_t local_descriptors_identifier = 0;
+	uint32_t parent_identifier            = 0;
+
+	/* Test regular cases
+	 */
+	libpff_format_functions_32bit.read_node_entry_identifier(
+	 pff_test_format_functions_descriptor_entry_32bit,
+	 &identifier );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "identifier",
+	 identifier,
+	 (uint64_t) 0x21 );
+
+	libpff_format_functions_32bit.read_index_node_descriptor_entry(
+	 pff_test_format_functions_descriptor_entry_32bit,
+	 &data_identifier,
+	 &local_descriptors_identifier,
+	 &parent_identifier );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "data_identifier",
+	 data_identifier,
+	 (uint64_t) 0x48 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "local_descriptors_identifier",
+	 local_descriptors_identifier,
+	 (uint64_t) 0 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT32(
+	 "parent_identifier",
+	 parent_identifier,
+	 (uint32_t) 0x122 );
+
+	identifier        = 0;
+	data_identifier   = 0;
+	parent_identifier = 0;
+
+	libpff_format_functions_64bit.read_node_entry_identifier(
+	 pff_test_format_functions_descriptor_entry_64bit,
+	 &identifier );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "identifier",
+	 identifier,
+	 (uint64_t) 0x21 );
+
+	libpff_format_functions_64bit.read_index_node_descriptor_entry(
+	 pff_test_format_functions_descriptor_entry_64bit,
+	 &data_identifier,
+	 &local_descriptors_identifier,
+	 &parent_identifier );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "data_identifier",
+	 data_identifier,
+	 (uint64_t) 0x48 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT32(
+	 "parent_identifier",
+	 parent_identifier,
+	 (uint32_t) 0x122 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the read index node branch entries functions
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_format_functions_read_index_node_branch_entries(
+     void )
+{
+	uint64_t back_pointers[ 2 ] = { 0, 0 };
+	uint64_t file_offsets[ 2 ]  = { 0, 0 };
+
+	/* Test regular cases
+	 */
+	libpff_format_functions_32bit.read_index_node_branch_entries(
+	 pff_test_format_functions_branch_entries_32bit,
+	 2,
+	 back_pointers,
+	 file_offsets );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "back_pointers[ 0 ]",
+	 back_pointers[ 0 ],
+	 (uint64_t) 0x05 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "file_offsets[ 0 ]",
+	 file_offsets[ 0 ],
+	 (uint64_t) 0x4400 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "back_pointers[ 1 ]",
+	 back_pointers[ 1 ],
+	 (uint64_t) 0x06 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "file_offsets[ 1 ]",
+	 file_offsets[ 1 ],
+	 (uint64_t) 0x4600 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the scan index node leaf entries functions
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_format_functions_scan_index_node_leaf_entries(
+     void )
+{
+	uint16_t entry_index = 0;
+	int result           = 0;
+
+	/* Test regular cases
+	 */
+	result = libpff_format_functions_32bit.scan_index_node_leaf_entries(
+	          pff_test_format_functions_descriptor_entries_32bit,
+	          LIBPFF_INDEX_TYPE_DESCRIPTOR,
+	          3,
+	          &entry_index );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT16(
+	 "entry_index",
+	 entry_index,
+	 (uint16_t) 2 );
+
+	entry_index = 0;
+
+	result = libpff_format_functions_32bit.scan_index_node_leaf_entries(
+	          pff_test_format_functions_descriptor_entries_32bit,
+	          LIBPFF_INDEX_TYPE_DESCRIPTOR,
+	          2,
+	          &entry_index );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT16(
+	 "entry_index",
+	 entry_index,
+	 (uint16_t) 2 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the check local descriptor leaf entries functions
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_format_functions_check_local_descriptor_leaf_entries(
+     void )
+{
+	int result = 0;
+
+	/* Test regular cases
+	 */
+	result = libpff_format_functions_32bit.check_local_descriptor_leaf_entries(
+	          pff_test_format_functions_local_descriptor_leaf_entries_32bit,
+	          1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libpff_format_functions_32bit.check_local_descriptor_leaf_entries(
+	          pff_test_format_functions_local_descriptor_leaf_entries_32bit,
+	          2 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PFF_TEST_UNREFERENCED_PARAMETER( argc )
+	PFF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+	PFF_TEST_RUN(
+	 "libpff_format_functions_get",
+	 pff_test_format_functions_get );
+
+	PFF_TEST_RUN(
+	 "libpff_format_functions_read_index_node_descriptor_entry",
+	 pff_test_format_functions_read_index_node_descriptor_entry );
+
+	PFF_TEST_RUN(
+	 "libpff_format_functions_read_index_node_branch_entries",
+	 pff_test_format_functions_read_index_node_branch_entries );
+
+	PFF_TEST_RUN(
+	 "libpff_format_functions_scan_index_node_leaf_entries",
+	 pff_test_format_functions_scan_index_node_leaf_entries );
+
+	PFF_TEST_RUN(
+	 "libpff_format_functions_check_local_descriptor_leaf_entries",
+	 pff_test_format_functions_check_local_descriptor_leaf_entries );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+}
+
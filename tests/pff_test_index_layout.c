@@ -0,0 +1,1346 @@
+/*
+ * Library index_layout type test program
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "pff_test_functions.h"
+#include "pff_test_libbfio.h"
+#include "pff_test_libcerror.h"
+#include "pff_test_libfcache.h"
+#include "pff_test_libfdata.h"
+#include "pff_test_libpff.h"
+#include "pff_test_macros.h"
+#include "pff_test_memory.h"
+#include "pff_test_unused.h"
+
+#include "../libpff/libpff_definitions.h"
+#include "../libpff/libpff_index_layout.h"
+#include "../libpff/libpff_io_handle.h"
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+/* The test data consists of 5 index node pages of 512 bytes:
+ * 0    : descriptors index root node, with the sub nodes at offset 512 and 1024
+ * 512  : descriptors index leaf node, with descriptors 0x21 and 0x122
+ * 1024 : descriptors index leaf node, with descriptors 0x8022 and 0x8042
+ * 1536 : rewritten root node, with the sub nodes at offset 512 and 2048
+ * 2048 : rewritten leaf node, with descriptors 0x8022 (moved) and 0x8062 (added)
+ */
+uint8_t pff_test_index_layout_data[ 2560 ];
+
+/* Writes a 32-bit index node page in the test data
+ * The entries consist of 4 values per entry: a branch entry contains
+ * the identifier, back pointer, file offset and 0, a leaf entry contains
+ * the identifier, data identifier, local descriptors identifier and parent identifier
+ */
+void pff_test_index_layout_write_node(
+      uint8_t *node_data,
+      uint8_t level,
+      const uint32_t *entries,
+      uint8_t number_of_entries,
+      uint32_t back_pointer )
+{
+	uint8_t *entry_data = NULL;
+	uint8_t entry_index = 0;
+	uint8_t entry_size  = 12;
+
+	if( level == LIBPFF_INDEX_NODE_LEVEL_LEAF )
+	{
+		entry_size = 16;
+	}
+	memory_set(
+	 node_data,
+	 0,
+	 512 );
+
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		entry_data = &( node_data[ entry_index * entry_size ] );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 entry_data,
+		 entries[ ( entry_index * 4 ) ] );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 &( entry_data[ 4 ] ),
+		 entries[ ( entry_index * 4 ) + 1 ] );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 &( entry_data[ 8 ] ),
+		 entries[ ( entry_index * 4 ) + 2 ] );
+
+		if( level == LIBPFF_INDEX_NODE_LEVEL_LEAF )
+		{
+			byte_stream_copy_from_uint32_little_endian(
+			 &( entry_data[ 12 ] ),
+			 entries[ ( entry_index * 4 ) + 3 ] );
+		}
+	}
+	node_data[ 496 ] = number_of_entries;
+	node_data[ 497 ] = (uint8_t) ( 496 / entry_size );
+	node_data[ 498 ] = entry_size;
+	node_data[ 499 ] = level;
+	node_data[ 500 ] = LIBPFF_INDEX_TYPE_DESCRIPTOR;
+	node_data[ 501 ] = LIBPFF_INDEX_TYPE_DESCRIPTOR;
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( node_data[ 504 ] ),
+	 back_pointer );
+}
+
+/* Initializes the test data
+ */
+void pff_test_index_layout_initialize_data(
+      void )
+{
+	uint32_t root_node_entries[ 8 ] = {
+		0x00000021UL, 0x00000010UL, 512, 0,
+		0x00008022UL, 0x00000020UL, 1024, 0 };
+
+	uint32_t leaf_node1_entries[ 8 ] = {
+		0x00000021UL, 0x00000100UL, 0, 0x00000021UL,
+		0x00000122UL, 0x00000200UL, 0, 0x00000021UL };
+
+	uint32_t leaf_node2_entries[ 8 ] = {
+		0x00008022UL, 0x00000300UL, 0, 0x00000122UL,
+		0x00008042UL, 0x00000400UL, 0, 0x00000122UL };
+
+	uint32_t rewritten_root_node_entries[ 8 ] = {
+		0x00000021UL, 0x00000010UL, 512, 0,
+		0x00008022UL, 0x00000050UL, 2048, 0 };
+
+	uint32_t rewritten_leaf_node_entries[ 8 ] = {
+		0x00008022UL, 0x00000310UL, 0, 0x00000021UL,
+		0x00008062UL, 0x00000500UL, 0, 0x00000122UL };
+
+	pff_test_index_layout_write_node(
+	 &( pff_test_index_layout_data[ 0 ] ),
+	 1,
+	 root_node_entries,
+	 2,
+	 0x00000040UL );
+
+	pff_test_index_layout_write_node(
+	 &( pff_test_index_layout_data[ 512 ] ),
+	 LIBPFF_INDEX_NODE_LEVEL_LEAF,
+	 leaf_node1_entries,
+	 2,
+	 0x00000010UL );
+
+	pff_test_index_layout_write_node(
+	 &( pff_test_index_layout_data[ 1024 ] ),
+	 LIBPFF_INDEX_NODE_LEVEL_LEAF,
+	 leaf_node2_entries,
+	 2,
+	 0x00000020UL );
+
+	pff_test_index_layout_write_node(
+	 &( pff_test_index_layout_data[ 1536 ] ),
+	 1,
+	 rewritten_root_node_entries,
+	 2,
+	 0x00000060UL );
+
+	pff_test_index_layout_write_node(
+	 &( pff_test_index_layout_data[ 2048 ] ),
+	 LIBPFF_INDEX_NODE_LEVEL_LEAF,
+	 rewritten_leaf_node_entries,
+	 2,
+	 0x00000050UL );
+}
+
+/* Tests the libpff_index_layout_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_index_layout_initialize(
+     void )
+{
+	libcerror_error_t *error            = NULL;
+	libpff_index_layout_t *index_layout = NULL;
+	int result                          = 0;
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+	int number_of_malloc_fail_tests     = 1;
+	int number_of_memset_fail_tests     = 1;
+	int test_number                     = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libpff_index_layout_initialize(
+	          &index_layout,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "index_layout",
+	 index_layout );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_index_layout_free(
+	          &index_layout,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "index_layout",
+	 index_layout );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_index_layout_initialize(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	index_layout = (libpff_index_layout_t *) 0x12345678UL;
+
+	result = libpff_index_layout_initialize(
+	          &index_layout,
+	          &error );
+
+	index_layout = NULL;
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libpff_index_layout_initialize with malloc failing
+		 */
+		pff_test_malloc_attempts_before_fail = test_number;
+
+		result = libpff_index_layout_initialize(
+		          &index_layout,
+		          &error );
+
+		if( pff_test_malloc_attempts_before_fail != -1 )
+		{
+			pff_test_malloc_attempts_before_fail = -1;
+
+			if( index_layout != NULL )
+			{
+				libpff_index_layout_free(
+				 &index_layout,
+				 NULL );
+			}
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "index_layout",
+			 index_layout );
+
+			PFF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libpff_index_layout_initialize with memset failing
+		 */
+		pff_test_memset_attempts_before_fail = test_number;
+
+		result = libpff_index_layout_initialize(
+		          &index_layout,
+		          &error );
+
+		if( pff_test_memset_attempts_before_fail != -1 )
+		{
+			pff_test_memset_attempts_before_fail = -1;
+
+			if( index_layout != NULL )
+			{
+				libpff_index_layout_free(
+				 &index_layout,
+				 NULL );
+			}
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "index_layout",
+			 index_layout );
+
+			PFF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_PFF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( index_layout != NULL )
+	{
+		libpff_index_layout_free(
+		 &index_layout,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_index_layout_free function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_index_layout_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libpff_index_layout_free(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_index_layout_resize_array function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_index_layout_resize_array(
+     void )
+{
+	libcerror_error_t *error      = NULL;
+	uint32_t *identifiers         = NULL;
+	int maximum_number_of_entries = 0;
+	int result                    = 0;
+
+	/* Test regular cases
+	 */
+	result = libpff_index_layout_resize_array(
+	          (void **) &identifiers,
+	          &maximum_number_of_entries,
+	          0,
+	          sizeof( uint32_t ),
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "identifiers",
+	 identifiers );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "maximum_number_of_entries",
+	 maximum_number_of_entries,
+	 64 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the array is not resized when it can hold another entry
+	 */
+	result = libpff_index_layout_resize_array(
+	          (void **) &identifiers,
+	          &maximum_number_of_entries,
+	          63,
+	          sizeof( uint32_t ),
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "maximum_number_of_entries",
+	 maximum_number_of_entries,
+	 64 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_index_layout_resize_array(
+	          (void **) &identifiers,
+	          &maximum_number_of_entries,
+	          64,
+	          sizeof( uint32_t ),
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "maximum_number_of_entries",
+	 maximum_number_of_entries,
+	 128 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_index_layout_resize_array(
+	          NULL,
+	          &maximum_number_of_entries,
+	          0,
+	          sizeof( uint32_t ),
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_index_layout_resize_array(
+	          (void **) &identifiers,
+	          NULL,
+	          0,
+	          sizeof( uint32_t ),
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_index_layout_resize_array(
+	          (void **) &identifiers,
+	          &maximum_number_of_entries,
+	          129,
+	          sizeof( uint32_t ),
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_index_layout_resize_array(
+	          (void **) &identifiers,
+	          &maximum_number_of_entries,
+	          0,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	memory_free(
+	 identifiers );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( identifiers != NULL )
+	{
+		memory_free(
+		 identifiers );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_index_layout_sort_identifiers function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_index_layout_sort_identifiers(
+     void )
+{
+	uint32_t expected_identifiers[ 7 ] = { 0x21, 0x21, 0x122, 0x8022, 0x8042, 0x8062, 0x200003 };
+	uint32_t identifiers[ 7 ]          = { 0x8062, 0x21, 0x200003, 0x8022, 0x122, 0x21, 0x8042 };
+	libcerror_error_t *error           = NULL;
+	int identifier_index               = 0;
+	int result                         = 0;
+
+	/* Test regular cases
+	 */
+	result = libpff_index_layout_sort_identifiers(
+	          identifiers,
+	          7,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( identifier_index = 0;
+	     identifier_index < 7;
+	     identifier_index++ )
+	{
+		PFF_TEST_ASSERT_EQUAL_UINT32(
+		 "identifiers[ identifier_index ]",
+		 identifiers[ identifier_index ],
+		 expected_identifiers[ identifier_index ] );
+	}
+	result = libpff_index_layout_sort_identifiers(
+	          identifiers,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_index_layout_sort_identifiers(
+	          NULL,
+	          7,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_index_layout_sort_identifiers(
+	          identifiers,
+	          -1,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_index_layout_read function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_index_layout_read(
+     libpff_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libfdata_vector_t *index_node_vector,
+     libfcache_cache_t *index_node_cache )
+{
+	libcerror_error_t *error                     = NULL;
+	libpff_index_layout_t *index_layout          = NULL;
+	libpff_index_layout_t *previous_index_layout = NULL;
+	int node_index                               = 0;
+	int result                                   = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_index_layout_initialize(
+	          &previous_index_layout,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_index_layout_initialize(
+	          &index_layout,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libpff_index_layout_read(
+	          previous_index_layout,
+	          NULL,
+	          io_handle,
+	          file_io_handle,
+	          index_node_vector,
+	          index_node_cache,
+	          0,
+	          0x00000040UL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "previous_index_layout->number_of_nodes",
+	 previous_index_layout->number_of_nodes,
+	 3 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "previous_index_layout->nodes[ 0 ].number_of_sub_tree_nodes",
+	 previous_index_layout->nodes[ 0 ].number_of_sub_tree_nodes,
+	 3 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "previous_index_layout->number_of_identifiers",
+	 previous_index_layout->number_of_identifiers,
+	 4 );
+
+	/* Without a previous layout all the values are considered changed
+	 */
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "previous_index_layout->number_of_changed_values",
+	 previous_index_layout->number_of_changed_values,
+	 4 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "previous_index_layout->number_of_removed_identifiers",
+	 previous_index_layout->number_of_removed_identifiers,
+	 0 );
+
+	result = libpff_index_layout_get_node_index(
+	          previous_index_layout,
+	          1024,
+	          0x00000020UL,
+	          &node_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "node_index",
+	 node_index,
+	 2 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A node with the same offset but a different back pointer was rewritten
+	 */
+	result = libpff_index_layout_get_node_index(
+	          previous_index_layout,
+	          1024,
+	          0x00000050UL,
+	          &node_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_index_layout_clear_changes(
+	          previous_index_layout,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "previous_index_layout->number_of_changed_values",
+	 previous_index_layout->number_of_changed_values,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that only the rewritten nodes are read
+	 */
+	result = libpff_index_layout_read(
+	          index_layout,
+	          previous_index_layout,
+	          io_handle,
+	          file_io_handle,
+	          index_node_vector,
+	          index_node_cache,
+	          1536,
+	          0x00000060UL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "index_layout->number_of_nodes",
+	 index_layout->number_of_nodes,
+	 3 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "index_layout->number_of_identifiers",
+	 index_layout->number_of_identifiers,
+	 4 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "previous_index_layout->nodes[ 0 ].is_present",
+	 previous_index_layout->nodes[ 0 ].is_present,
+	 0 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "previous_index_layout->nodes[ 1 ].is_present",
+	 previous_index_layout->nodes[ 1 ].is_present,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "previous_index_layout->nodes[ 2 ].is_present",
+	 previous_index_layout->nodes[ 2 ].is_present,
+	 0 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "index_layout->number_of_changed_values",
+	 index_layout->number_of_changed_values,
+	 2 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT32(
+	 "index_layout->changed_values[ 0 ].identifier",
+	 index_layout->changed_values[ 0 ].identifier,
+	 0x00008022UL );
+
+	PFF_TEST_ASSERT_EQUAL_UINT32(
+	 "index_layout->changed_values[ 0 ].parent_identifier",
+	 index_layout->changed_values[ 0 ].parent_identifier,
+	 0x00000021UL );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "index_layout->changed_values[ 0 ].data_identifier",
+	 index_layout->changed_values[ 0 ].data_identifier,
+	 (uint64_t) 0x00000310UL );
+
+	PFF_TEST_ASSERT_EQUAL_UINT32(
+	 "index_layout->changed_values[ 1 ].identifier",
+	 index_layout->changed_values[ 1 ].identifier,
+	 0x00008062UL );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "index_layout->number_of_removed_identifiers",
+	 index_layout->number_of_removed_identifiers,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT32(
+	 "index_layout->removed_identifiers[ 0 ]",
+	 index_layout->removed_identifiers[ 0 ],
+	 0x00008042UL );
+
+	/* Test error cases
+	 */
+	result = libpff_index_layout_read(
+	          NULL,
+	          NULL,
+	          io_handle,
+	          file_io_handle,
+	          index_node_vector,
+	          index_node_cache,
+	          0,
+	          0x00000040UL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* The nodes of the index layout are already set
+	 */
+	result = libpff_index_layout_read(
+	          index_layout,
+	          NULL,
+	          io_handle,
+	          file_io_handle,
+	          index_node_vector,
+	          index_node_cache,
+	          0,
+	          0x00000040UL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_index_layout_free(
+	          &index_layout,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a branch node with a mismatching back pointer is an error
+	 */
+	result = libpff_index_layout_initialize(
+	          &index_layout,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_index_layout_read(
+	          index_layout,
+	          NULL,
+	          io_handle,
+	          file_io_handle,
+	          index_node_vector,
+	          index_node_cache,
+	          0,
+	          0x00000041UL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_index_layout_free(
+	          &index_layout,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_index_layout_free(
+	          &previous_index_layout,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( index_layout != NULL )
+	{
+		libpff_index_layout_free(
+		 &index_layout,
+		 NULL );
+	}
+	if( previous_index_layout != NULL )
+	{
+		libpff_index_layout_free(
+		 &previous_index_layout,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+#if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
+
+	libbfio_handle_t *file_io_handle     = NULL;
+	libcerror_error_t *error             = NULL;
+	libfcache_cache_t *index_node_cache  = NULL;
+	libfdata_vector_t *index_node_vector = NULL;
+	libpff_io_handle_t *io_handle        = NULL;
+	int result                           = 0;
+	int segment_index                    = 0;
+
+#endif /* !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 ) */
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+	PFF_TEST_UNREFERENCED_PARAMETER( argc )
+	PFF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+	PFF_TEST_RUN(
+	 "libpff_index_layout_initialize",
+	 pff_test_index_layout_initialize );
+
+	PFF_TEST_RUN(
+	 "libpff_index_layout_free",
+	 pff_test_index_layout_free );
+
+	PFF_TEST_RUN(
+	 "libpff_index_layout_resize_array",
+	 pff_test_index_layout_resize_array );
+
+	PFF_TEST_RUN(
+	 "libpff_index_layout_sort_identifiers",
+	 pff_test_index_layout_sort_identifiers );
+
+#if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
+
+	/* Initialize test
+	 */
+	pff_test_index_layout_initialize_data();
+
+	result = libpff_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_io_handle_set_file_type(
+	          io_handle,
+	          LIBPFF_FILE_TYPE_32BIT,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_vector_initialize(
+	          &index_node_vector,
+	          512,
+	          (intptr_t *) io_handle,
+	          NULL,
+	          NULL,
+	          (int (*)(intptr_t *, intptr_t *, libfdata_vector_t *, libfdata_cache_t *, int, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &libpff_io_handle_read_index_node,
+	          NULL,
+	          LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "index_node_vector",
+	 index_node_vector );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_vector_append_segment(
+	          index_node_vector,
+	          &segment_index,
+	          0,
+	          0,
+	          2560,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfcache_cache_initialize(
+	          &index_node_cache,
+	          4,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "index_node_cache",
+	 index_node_cache );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = pff_test_open_file_io_handle(
+	          &file_io_handle,
+	          pff_test_index_layout_data,
+	          2560,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_RUN_WITH_ARGS(
+	 "libpff_index_layout_read",
+	 pff_test_index_layout_read,
+	 io_handle,
+	 file_io_handle,
+	 index_node_vector,
+	 index_node_cache );
+
+	/* Clean up
+	 */
+	result = pff_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfcache_cache_free(
+	          &index_node_cache,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfdata_vector_free(
+	          &index_node_vector,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#endif /* !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 ) */
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+on_error:
+#if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		pff_test_close_file_io_handle(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( index_node_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &index_node_cache,
+		 NULL );
+	}
+	if( index_node_vector != NULL )
+	{
+		libfdata_vector_free(
+		 &index_node_vector,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libpff_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+#endif /* !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 ) */
+
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+}
+
@@ -37,6 +37,7 @@
 #include "pff_test_unused.h"
 
 #include "../libpff/libpff_index_node.h"
+#include "../libpff/libpff_io_handle.h"
 
 uint8_t pff_test_index_node_data_32bit[ 512 ] = {
 	0x21, 0x00, 0x00, 0x00, 0x97, 0x06, 0x00, 0x00, 0x00, 0x9c, 0x00, 0x00, 0x22, 0x80, 0x00, 0x00,
@@ -798,6 +799,197 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libpff_index_node_get_entries_data function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_index_node_get_entries_data(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libpff_index_node_t *index_node = NULL;
+	uint8_t *entries_data           = NULL;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_index_node_initialize(
+	          &index_node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "index_node",
+	 index_node );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_index_node_read_data(
+	          index_node,
+	          pff_test_index_node_data_32bit,
+	          512,
+	          LIBPFF_FILE_TYPE_32BIT,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	index_node->entries_data = pff_test_index_node_data_32bit;
+
+	/* Test regular cases
+	 */
+	result = libpff_index_node_get_entries_data(
+	          index_node,
+	          0,
+	          index_node->number_of_entries,
+	          index_node->entry_size,
+	          &entries_data,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "entries_data",
+	 entries_data );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_index_node_get_entries_data(
+	          NULL,
+	          0,
+	          index_node->number_of_entries,
+	          index_node->entry_size,
+	          &entries_data,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_index_node_get_entries_data(
+	          index_node,
+	          0,
+	          index_node->number_of_entries,
+	          0,
+	          &entries_data,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_index_node_get_entries_data(
+	          index_node,
+	          1,
+	          index_node->maximum_number_of_entries,
+	          index_node->entry_size,
+	          &entries_data,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_index_node_get_entries_data(
+	          index_node,
+	          0,
+	          index_node->number_of_entries,
+	          index_node->entry_size,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	index_node->entries_data = NULL;
+
+	/* Clean up
+	 */
+	result = libpff_index_node_free(
+	          &index_node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "index_node",
+	 index_node );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( index_node != NULL )
+	{
+		libpff_index_node_free(
+		 &index_node,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* Tests the libpff_index_node_read_data function
  * Returns 1 if successful or 0 if not
  */
@@ -1231,10 +1423,28 @@ int pff_test_index_node_read_file_io_handle(
 	libbfio_handle_t *file_io_handle = NULL;
 	libcerror_error_t *error         = NULL;
 	libpff_index_node_t *index_node  = NULL;
+	libpff_io_handle_t *io_handle    = NULL;
 	int result                       = 0;
 
 	/* Initialize test
 	 */
+	result = libpff_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	result = libpff_index_node_initialize(
 	          &index_node,
 	          &error );
@@ -1275,11 +1485,13 @@ int pff_test_index_node_read_file_io_handle(
 
 	/* Test regular cases
 	 */
+	io_handle->file_type = LIBPFF_FILE_TYPE_32BIT;
+
 	result = libpff_index_node_read_file_io_handle(
 	          index_node,
+	          io_handle,
 	          file_io_handle,
 	          0,
-	          LIBPFF_FILE_TYPE_32BIT,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -1295,9 +1507,9 @@ int pff_test_index_node_read_file_io_handle(
 	 */
 	result = libpff_index_node_read_file_io_handle(
 	          NULL,
+	          io_handle,
 	          file_io_handle,
 	          0,
-	          LIBPFF_FILE_TYPE_32BIT,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -1315,8 +1527,27 @@ int pff_test_index_node_read_file_io_handle(
 	result = libpff_index_node_read_file_io_handle(
 	          index_node,
 	          NULL,
+	          file_io_handle,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_index_node_read_file_io_handle(
+	          index_node,
+	          io_handle,
+	          NULL,
 	          0,
-	          LIBPFF_FILE_TYPE_32BIT,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -1333,9 +1564,9 @@ int pff_test_index_node_read_file_io_handle(
 
 	result = libpff_index_node_read_file_io_handle(
 	          index_node,
+	          io_handle,
 	          file_io_handle,
 	          -1,
-	          LIBPFF_FILE_TYPE_32BIT,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -1350,11 +1581,13 @@ int pff_test_index_node_read_file_io_handle(
 	libcerror_error_free(
 	 &error );
 
+	io_handle->file_type = 0xff;
+
 	result = libpff_index_node_read_file_io_handle(
 	          index_node,
+	          io_handle,
 	          file_io_handle,
 	          0,
-	          0xff,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -1445,6 +1678,62 @@ int pff_test_index_node_read_file_io_handle(
 
 	/* Test error cases
 	 */
+	io_handle->file_type = LIBPFF_FILE_TYPE_64BIT;
+
+	result = libpff_io_handle_set_read_budget(
+	          io_handle,
+	          256,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_index_node_read_file_io_handle(
+	          index_node,
+	          io_handle,
+	          file_io_handle,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "io_handle->read_limits_exceeded",
+	 io_handle->read_limits_exceeded,
+	 1 );
+
+	result = libpff_io_handle_set_read_budget(
+	          io_handle,
+	          0,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 #if defined( HAVE_PFF_TEST_MEMORY )
 
 	/* Test libpff_index_node_read_file_io_handle with malloc failing
@@ -1453,9 +1742,9 @@ int pff_test_index_node_read_file_io_handle(
 
 	result = libpff_index_node_read_file_io_handle(
 	          index_node,
+	          io_handle,
 	          file_io_handle,
 	          0,
-	          LIBPFF_FILE_TYPE_64BIT,
 	          &error );
 
 	if( pff_test_malloc_attempts_before_fail != -1 )
@@ -1482,9 +1771,9 @@ int pff_test_index_node_read_file_io_handle(
 	 */
 	result = libpff_index_node_read_file_io_handle(
 	          index_node,
+	          io_handle,
 	          file_io_handle,
 	          0,
-	          LIBPFF_FILE_TYPE_64BIT,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -1572,11 +1861,13 @@ int pff_test_index_node_read_file_io_handle(
 
 	/* Test regular cases
 	 */
+	io_handle->file_type = LIBPFF_FILE_TYPE_64BIT_4K_PAGE;
+
 	result = libpff_index_node_read_file_io_handle(
 	          index_node,
+	          io_handle,
 	          file_io_handle,
 	          0,
-	          LIBPFF_FILE_TYPE_64BIT_4K_PAGE,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -1622,6 +1913,23 @@ int pff_test_index_node_read_file_io_handle(
 	 "error",
 	 error );
 
+	result = libpff_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	return( 1 );
 
 on_error:
@@ -1642,6 +1950,12 @@ on_error:
 		 &index_node,
 		 NULL );
 	}
+	if( io_handle != NULL )
+	{
+		libpff_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
 	return( 0 );
 }
 
@@ -1790,6 +2104,10 @@ int main(
 	 "libpff_index_node_get_entry_data",
 	 pff_test_index_node_get_entry_data );
 
+	PFF_TEST_RUN(
+	 "libpff_index_node_get_entries_data",
+	 pff_test_index_node_get_entries_data );
+
 	PFF_TEST_RUN(
 	 "libpff_index_node_read_data",
 	 pff_test_index_node_read_data );
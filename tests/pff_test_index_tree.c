@@ -1486,7 +1486,19 @@ int main(
 	 "error",
 	 error );
 
-	io_handle->file_type = LIBPFF_FILE_TYPE_32BIT;
+	result = libpff_io_handle_set_file_type(
+	          io_handle,
+	          LIBPFF_FILE_TYPE_32BIT,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	result = libfdata_vector_initialize(
 	          &index_node_vector,
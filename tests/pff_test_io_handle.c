@@ -301,6 +301,8 @@ int pff_test_io_handle_clear(
 
 	/* Test regular cases
 	 */
+	io_handle->name_to_id_map_generation = 3;
+
 	result = libpff_io_handle_clear(
 	          io_handle,
 	          &error );
@@ -314,6 +316,13 @@ int pff_test_io_handle_clear(
 	 "error",
 	 error );
 
+	/* The generation of the name to ID map is retained
+	 */
+	PFF_TEST_ASSERT_EQUAL_UINT32(
+	 "io_handle->name_to_id_map_generation",
+	 io_handle->name_to_id_map_generation,
+	 (uint32_t) 3 );
+
 	/* Test error cases
 	 */
 	result = libpff_io_handle_clear(
@@ -398,6 +407,348 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libpff_io_handle_set_file_type function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_io_handle_set_file_type(
+     void )
+{
+	libcerror_error_t *error      = NULL;
+	libpff_io_handle_t *io_handle = NULL;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libpff_io_handle_set_file_type(
+	          io_handle,
+	          LIBPFF_FILE_TYPE_64BIT_4K_PAGE,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "io_handle->file_type",
+	 io_handle->file_type,
+	 LIBPFF_FILE_TYPE_64BIT_4K_PAGE );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle->format_functions",
+	 io_handle->format_functions );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "io_handle->format_functions->file_type",
+	 io_handle->format_functions->file_type,
+	 LIBPFF_FILE_TYPE_64BIT_4K_PAGE );
+
+	/* Test error cases
+	 */
+	result = libpff_io_handle_set_file_type(
+	          NULL,
+	          LIBPFF_FILE_TYPE_32BIT,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_io_handle_set_file_type(
+	          io_handle,
+	          0xff,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_handle != NULL )
+	{
+		libpff_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_io_handle_check_read_limits function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_io_handle_check_read_limits(
+     void )
+{
+	libcerror_error_t *error      = NULL;
+	libpff_io_handle_t *io_handle = NULL;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libpff_io_handle_check_read_limits(
+	          io_handle,
+	          512,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_io_handle_set_read_budget(
+	          io_handle,
+	          1024,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_io_handle_check_read_limits(
+	          io_handle,
+	          1024,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_io_handle_set_read_budget(
+	          io_handle,
+	          0,
+	          1,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_io_handle_check_read_limits(
+	          io_handle,
+	          512,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_io_handle_check_read_limits(
+	          NULL,
+	          512,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test exceeding the maximum number of read blocks
+	 */
+	result = libpff_io_handle_check_read_limits(
+	          io_handle,
+	          512,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test exceeding the maximum read size
+	 */
+	result = libpff_io_handle_set_read_budget(
+	          io_handle,
+	          1024,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_io_handle_check_read_limits(
+	          io_handle,
+	          2048,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_handle != NULL )
+	{
+		libpff_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
 
 /* The main program
@@ -429,6 +780,14 @@ int main(
 	 "libpff_io_handle_clear",
 	 pff_test_io_handle_clear );
 
+	PFF_TEST_RUN(
+	 "libpff_io_handle_set_file_type",
+	 pff_test_io_handle_set_file_type );
+
+	PFF_TEST_RUN(
+	 "libpff_io_handle_check_read_limits",
+	 pff_test_io_handle_check_read_limits );
+
 	/* TODO: add tests for libpff_io_handle_read_unallocated_data_blocks */
 
 	/* TODO: add tests for libpff_io_handle_read_unallocated_page_blocks */
@@ -37,6 +37,7 @@
 #include "../libpff/libpff_io_handle.h"
 #include "../libpff/libpff_item.h"
 #include "../libpff/libpff_item_descriptor.h"
+#include "../libpff/libpff_property_set.h"
 
 #if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
 
@@ -1023,6 +1024,261 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libpff_item_get_entries_by_property_set function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_item_get_entries_by_property_set(
+     libpff_item_t *item )
+{
+	libpff_record_entry_t *record_entries[ 1 ] = { NULL };
+
+	libcerror_error_t *error              = NULL;
+	libpff_internal_item_t *internal_item = NULL;
+	libpff_io_handle_t *other_io_handle   = NULL;
+	libpff_property_set_t *property_set   = NULL;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	internal_item = (libpff_internal_item_t *) item;
+
+	result = libpff_io_handle_initialize(
+	          &other_io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_property_set_initialize(
+	          &property_set,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_property_set_append_entry_type(
+	          property_set,
+	          0x0037,
+	          0,
+	          0,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error case where the property set was not prepared
+	 */
+	result = libpff_item_get_entries_by_property_set(
+	          item,
+	          0,
+	          property_set,
+	          record_entries,
+	          1,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the property set was prepared against another file
+	 */
+	result = libpff_property_set_prepare(
+	          property_set,
+	          other_io_handle,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_item_get_entries_by_property_set(
+	          item,
+	          0,
+	          property_set,
+	          record_entries,
+	          1,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the name to ID map of the file changed
+	 * after the property set was prepared
+	 */
+	result = libpff_property_set_prepare(
+	          property_set,
+	          internal_item->io_handle,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	internal_item->io_handle->name_to_id_map_generation += 1;
+
+	result = libpff_item_get_entries_by_property_set(
+	          item,
+	          0,
+	          property_set,
+	          record_entries,
+	          1,
+	          &error );
+
+	internal_item->io_handle->name_to_id_map_generation -= 1;
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error cases
+	 */
+	result = libpff_item_get_entries_by_property_set(
+	          NULL,
+	          0,
+	          property_set,
+	          record_entries,
+	          1,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_item_get_entries_by_property_set(
+	          item,
+	          0,
+	          NULL,
+	          record_entries,
+	          1,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_property_set_free(
+	          &property_set,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_io_handle_free(
+	          &other_io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( property_set != NULL )
+	{
+		libpff_property_set_free(
+		 &property_set,
+		 NULL );
+	}
+	if( other_io_handle != NULL )
+	{
+		libpff_io_handle_free(
+		 &other_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* Tests the libpff_internal_item_get_entry_value_32bit_integer function
  * Returns 1 if successful or 0 if not
  */
@@ -1260,6 +1516,11 @@ int main(
 	 pff_test_item_get_identifier,
 	 item );
 
+	PFF_TEST_RUN_WITH_ARGS(
+	 "libpff_item_get_entries_by_property_set",
+	 pff_test_item_get_entries_by_property_set,
+	 item );
+
 	/* TODO: add tests for libpff_item_get_number_of_items */
 
 	/* TODO: add tests for libpff_item_get_item_by_index */
@@ -35,6 +35,8 @@
 #include "pff_test_memory.h"
 #include "pff_test_unused.h"
 
+#include "../libpff/libpff_index_value.h"
+#include "../libpff/libpff_item_descriptor.h"
 #include "../libpff/libpff_item_tree.h"
 
 #if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
@@ -45,9 +47,9 @@
 int pff_test_item_tree_initialize(
      void )
 {
-	libcerror_error_t *error        = NULL;
-	libpff_item_tree_t *item_tree   = NULL;
-	int result                      = 0;
+	libcerror_error_t *error      = NULL;
+	libpff_item_tree_t *item_tree = NULL;
+	int result                    = 0;
 
 #if defined( HAVE_PFF_TEST_MEMORY )
 	int number_of_malloc_fail_tests = 1;
@@ -439,7 +441,7 @@ int pff_test_item_tree_create_node(
      void )
 {
 	libbfio_handle_t *file_io_handle                 = NULL;
-	libcdata_list_t *orphan_node_list                = NULL;
+	libcdata_array_t *orphan_node_array              = NULL;
 	libcdata_tree_node_t *root_folder_item_tree_node = NULL;
 	libcerror_error_t *error                         = NULL;
 	libfcache_cache_t *index_tree_cache              = NULL;
@@ -455,7 +457,7 @@ int pff_test_item_tree_create_node(
 	          descriptor_index_tree,
 	          descriptor_index_tree_node,
 	          index_tree_cache,
-	          orphan_node_list,
+	          orphan_node_array,
 	          &root_folder_item_tree_node,
 	          0,
 	          &error );
@@ -483,6 +485,698 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libpff_item_tree_sort_nodes_by_identifier and libpff_item_tree_get_node_index_by_identifier functions
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_item_tree_sort_nodes_by_identifier(
+     void )
+{
+	uint32_t descriptor_identifiers[ 6 ]      = { 45, 12, 45, 3, 12, 7 };
+	uint32_t expected_identifiers[ 6 ]        = { 3, 7, 12, 12, 45, 45 };
+	uint64_t expected_data_identifiers[ 6 ]   = { 3, 5, 1, 4, 0, 2 };
+	libcdata_array_t *item_tree_node_array    = NULL;
+	libcdata_tree_node_t *item_tree_node      = NULL;
+	libcerror_error_t *error                  = NULL;
+	libpff_item_descriptor_t *item_descriptor = NULL;
+	int entry_index                           = 0;
+	int item_tree_node_index                  = 0;
+	int result                                = 0;
+
+	/* Initialize test
+	 */
+	result = libcdata_array_initialize(
+	          &item_tree_node_array,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The data identifier is used to check that the sort is stable
+	 */
+	for( entry_index = 0;
+	     entry_index < 6;
+	     entry_index++ )
+	{
+		result = libpff_item_descriptor_initialize(
+		          &item_descriptor,
+		          descriptor_identifiers[ entry_index ],
+		          (uint64_t) entry_index,
+		          0,
+		          1,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcdata_tree_node_initialize(
+		          &item_tree_node,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcdata_tree_node_set_value(
+		          item_tree_node,
+		          (intptr_t *) item_descriptor,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		item_descriptor = NULL;
+
+		result = libcdata_array_append_entry(
+		          item_tree_node_array,
+		          &item_tree_node_index,
+		          (intptr_t *) item_tree_node,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		item_tree_node = NULL;
+	}
+	/* Test regular cases
+	 */
+	result = libpff_item_tree_sort_nodes_by_identifier(
+	          item_tree_node_array,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( entry_index = 0;
+	     entry_index < 6;
+	     entry_index++ )
+	{
+		result = libcdata_array_get_entry_by_index(
+		          item_tree_node_array,
+		          entry_index,
+		          (intptr_t **) &item_tree_node,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcdata_tree_node_get_value(
+		          item_tree_node,
+		          (intptr_t **) &item_descriptor,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NOT_NULL(
+		 "item_descriptor",
+		 item_descriptor );
+
+		PFF_TEST_ASSERT_EQUAL_UINT32(
+		 "item_descriptor->descriptor_identifier",
+		 item_descriptor->descriptor_identifier,
+		 expected_identifiers[ entry_index ] );
+
+		PFF_TEST_ASSERT_EQUAL_UINT64(
+		 "item_descriptor->data_identifier",
+		 item_descriptor->data_identifier,
+		 expected_data_identifiers[ entry_index ] );
+	}
+	item_tree_node  = NULL;
+	item_descriptor = NULL;
+
+	result = libpff_item_tree_get_node_index_by_identifier(
+	          item_tree_node_array,
+	          12,
+	          &item_tree_node_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "item_tree_node_index",
+	 item_tree_node_index,
+	 2 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_item_tree_get_node_index_by_identifier(
+	          item_tree_node_array,
+	          45,
+	          &item_tree_node_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "item_tree_node_index",
+	 item_tree_node_index,
+	 4 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_item_tree_get_node_index_by_identifier(
+	          item_tree_node_array,
+	          10,
+	          &item_tree_node_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_item_tree_get_node_index_by_identifier(
+	          item_tree_node_array,
+	          99,
+	          &item_tree_node_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_item_tree_sort_nodes_by_identifier(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_item_tree_get_node_index_by_identifier(
+	          item_tree_node_array,
+	          12,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libcdata_array_free(
+	          &item_tree_node_array,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_tree_node_free_recovered,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( item_descriptor != NULL )
+	{
+		libpff_item_descriptor_free(
+		 &item_descriptor,
+		 NULL );
+	}
+	if( item_tree_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 &item_tree_node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_descriptor_free,
+		 NULL );
+	}
+	if( item_tree_node_array != NULL )
+	{
+		libcdata_array_free(
+		 &item_tree_node_array,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_tree_node_free_recovered,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_item_tree_create_from_index_values function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_item_tree_create_from_index_values(
+     void )
+{
+	uint32_t identifiers[ 7 ]                        = { 0x122, 0x8082, 0x8022, 0x200, 0x300, 0x400, 0x500 };
+	uint32_t parent_identifiers[ 7 ]                 = { 0x122, 0x8022, 0x122, 0x999, 0x400, 0x300, 0x200 };
+	uint32_t expected_orphan_identifiers[ 4 ]        = { 0x200, 0x300, 0x400, 0x500 };
+	libcdata_array_t *index_values_array             = NULL;
+	libcdata_array_t *orphan_node_array              = NULL;
+	libcdata_tree_node_t *item_tree_node             = NULL;
+	libcdata_tree_node_t *root_folder_item_tree_node = NULL;
+	libcerror_error_t *error                         = NULL;
+	libpff_index_value_t *index_value                = NULL;
+	libpff_item_descriptor_t *item_descriptor        = NULL;
+	libpff_item_tree_t *item_tree                    = NULL;
+	int entry_index                                  = 0;
+	int number_of_entries                            = 0;
+	int result                                       = 0;
+	int value_index                                  = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_item_tree_initialize(
+	          &item_tree,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_initialize(
+	          &orphan_node_array,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_initialize(
+	          &index_values_array,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The values contain a child before its parent, an item with a missing parent,
+	 * a parent loop and a child of an orphan
+	 */
+	for( value_index = 0;
+	     value_index < 7;
+	     value_index++ )
+	{
+		result = libpff_index_value_initialize(
+		          &index_value,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		index_value->identifier        = identifiers[ value_index ];
+		index_value->data_identifier   = (uint64_t) value_index + 1;
+		index_value->parent_identifier = parent_identifiers[ value_index ];
+
+		result = libcdata_array_append_entry(
+		          index_values_array,
+		          &entry_index,
+		          (intptr_t *) index_value,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		index_value = NULL;
+	}
+	/* Test regular cases
+	 */
+	result = libpff_item_tree_create_from_index_values(
+	          item_tree,
+	          index_values_array,
+	          orphan_node_array,
+	          &root_folder_item_tree_node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "root_folder_item_tree_node",
+	 root_folder_item_tree_node );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_item_tree_get_tree_node_by_identifier(
+	          item_tree->root_node,
+	          0x8082,
+	          &item_tree_node,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_tree_node_get_parent_node(
+	          item_tree_node,
+	          &item_tree_node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_tree_node_get_parent_node(
+	          item_tree_node,
+	          &item_tree_node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "item_tree_node",
+	 ( item_tree_node == root_folder_item_tree_node ),
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_get_number_of_entries(
+	          orphan_node_array,
+	          &number_of_entries,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 4 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( entry_index = 0;
+	     entry_index < 4;
+	     entry_index++ )
+	{
+		result = libcdata_array_get_entry_by_index(
+		          orphan_node_array,
+		          entry_index,
+		          (intptr_t **) &item_tree_node,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcdata_tree_node_get_number_of_sub_nodes(
+		          item_tree_node,
+		          &number_of_entries,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "number_of_entries",
+		 number_of_entries,
+		 0 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libcdata_tree_node_get_value(
+		          item_tree_node,
+		          (intptr_t **) &item_descriptor,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NOT_NULL(
+		 "item_descriptor",
+		 item_descriptor );
+
+		PFF_TEST_ASSERT_EQUAL_UINT32(
+		 "item_descriptor->descriptor_identifier",
+		 item_descriptor->descriptor_identifier,
+		 expected_orphan_identifiers[ entry_index ] );
+	}
+	item_tree_node  = NULL;
+	item_descriptor = NULL;
+
+	/* Test error cases
+	 */
+	result = libpff_item_tree_create_from_index_values(
+	          NULL,
+	          index_values_array,
+	          orphan_node_array,
+	          &root_folder_item_tree_node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_item_tree_create_from_index_values(
+	          item_tree,
+	          index_values_array,
+	          orphan_node_array,
+	          &root_folder_item_tree_node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libcdata_array_free(
+	          &index_values_array,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libpff_index_value_free,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_free(
+	          &orphan_node_array,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_tree_node_free_recovered,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_item_tree_free(
+	          &item_tree,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( index_value != NULL )
+	{
+		libpff_index_value_free(
+		 &index_value,
+		 NULL );
+	}
+	if( index_values_array != NULL )
+	{
+		libcdata_array_free(
+		 &index_values_array,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libpff_index_value_free,
+		 NULL );
+	}
+	if( orphan_node_array != NULL )
+	{
+		libcdata_array_free(
+		 &orphan_node_array,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_tree_node_free_recovered,
+		 NULL );
+	}
+	if( item_tree != NULL )
+	{
+		libpff_item_tree_free(
+		 &item_tree,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
 
 /* The main program
@@ -534,6 +1228,14 @@ int main(
 
 	/* TODO: add tests for libpff_item_tree_get_node_by_identifier */
 
+	PFF_TEST_RUN(
+	 "libpff_item_tree_sort_nodes_by_identifier",
+	 pff_test_item_tree_sort_nodes_by_identifier );
+
+	PFF_TEST_RUN(
+	 "libpff_item_tree_create_from_index_values",
+	 pff_test_item_tree_create_from_index_values );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
@@ -0,0 +1,1362 @@
+/*
+ * Library item_tree_update type test program
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "pff_test_libcdata.h"
+#include "pff_test_libcerror.h"
+#include "pff_test_libpff.h"
+#include "pff_test_macros.h"
+#include "pff_test_memory.h"
+#include "pff_test_unused.h"
+
+#include "../libpff/libpff_definitions.h"
+#include "../libpff/libpff_index_layout.h"
+#include "../libpff/libpff_item_descriptor.h"
+#include "../libpff/libpff_item_tree.h"
+#include "../libpff/libpff_item_tree_update.h"
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+/* Appends an item tree node to a parent item tree node
+ * Returns 1 if successful or -1 on error
+ */
+int pff_test_item_tree_update_append_node(
+     libcdata_tree_node_t *parent_item_tree_node,
+     uint32_t descriptor_identifier,
+     uint64_t data_identifier,
+     libcdata_tree_node_t **item_tree_node,
+     libcerror_error_t **error )
+{
+	libpff_item_descriptor_t *item_descriptor = NULL;
+
+	if( libpff_item_descriptor_initialize(
+	     &item_descriptor,
+	     descriptor_identifier,
+	     data_identifier,
+	     0,
+	     0,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libcdata_tree_node_initialize(
+	     item_tree_node,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libcdata_tree_node_set_value(
+	     *item_tree_node,
+	     (intptr_t *) item_descriptor,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	item_descriptor = NULL;
+
+	if( parent_item_tree_node != NULL )
+	{
+		if( libcdata_tree_node_append_node(
+		     parent_item_tree_node,
+		     *item_tree_node,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( *item_tree_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 item_tree_node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libpff_item_descriptor_free,
+		 NULL );
+	}
+	if( item_descriptor != NULL )
+	{
+		libpff_item_descriptor_free(
+		 &item_descriptor,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Creates the item tree used for testing:
+ * 0x21 (root folder)
+ *   0x122 (folder)
+ *     0x8022 (message)
+ *     0x8042 (message)
+ * Returns 1 if successful or -1 on error
+ */
+int pff_test_item_tree_update_create_item_tree(
+     libpff_item_tree_t **item_tree,
+     libcdata_tree_node_t **root_folder_item_tree_node,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *folder_item_tree_node = NULL;
+	libcdata_tree_node_t *item_tree_node        = NULL;
+
+	if( libpff_item_tree_initialize(
+	     item_tree,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( pff_test_item_tree_update_append_node(
+	     NULL,
+	     0,
+	     0,
+	     &( ( *item_tree )->root_node ),
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( pff_test_item_tree_update_append_node(
+	     ( *item_tree )->root_node,
+	     0x00000021UL,
+	     0x00000100UL,
+	     root_folder_item_tree_node,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( pff_test_item_tree_update_append_node(
+	     *root_folder_item_tree_node,
+	     0x00000122UL,
+	     0x00000200UL,
+	     &folder_item_tree_node,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( pff_test_item_tree_update_append_node(
+	     folder_item_tree_node,
+	     0x00008022UL,
+	     0x00000300UL,
+	     &item_tree_node,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	item_tree_node = NULL;
+
+	if( pff_test_item_tree_update_append_node(
+	     folder_item_tree_node,
+	     0x00008042UL,
+	     0x00000400UL,
+	     &item_tree_node,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *item_tree != NULL )
+	{
+		libpff_item_tree_free(
+		 item_tree,
+		 NULL );
+	}
+	*root_folder_item_tree_node = NULL;
+
+	return( -1 );
+}
+
+/* Retrieves the number of sub nodes of a specific item tree node
+ * Returns 1 if successful or -1 on error
+ */
+int pff_test_item_tree_update_get_number_of_sub_nodes(
+     libpff_item_tree_t *item_tree,
+     uint32_t descriptor_identifier,
+     int *number_of_sub_nodes,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *item_tree_node = NULL;
+
+	if( libpff_item_tree_get_tree_node_by_identifier(
+	     item_tree->root_node,
+	     descriptor_identifier,
+	     &item_tree_node,
+	     0,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	return( libcdata_tree_node_get_number_of_sub_nodes(
+	         item_tree_node,
+	         number_of_sub_nodes,
+	         error ) );
+}
+
+/* Tests the libpff_item_tree_update_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_item_tree_update_initialize(
+     void )
+{
+	libcerror_error_t *error                    = NULL;
+	libpff_item_tree_update_t *item_tree_update = NULL;
+	int result                                  = 0;
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+	int number_of_malloc_fail_tests             = 1;
+	int number_of_memset_fail_tests             = 1;
+	int test_number                             = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libpff_item_tree_update_initialize(
+	          &item_tree_update,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "item_tree_update",
+	 item_tree_update );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_item_tree_update_free(
+	          &item_tree_update,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "item_tree_update",
+	 item_tree_update );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_item_tree_update_initialize(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	item_tree_update = (libpff_item_tree_update_t *) 0x12345678UL;
+
+	result = libpff_item_tree_update_initialize(
+	          &item_tree_update,
+	          &error );
+
+	item_tree_update = NULL;
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libpff_item_tree_update_initialize with malloc failing
+		 */
+		pff_test_malloc_attempts_before_fail = test_number;
+
+		result = libpff_item_tree_update_initialize(
+		          &item_tree_update,
+		          &error );
+
+		if( pff_test_malloc_attempts_before_fail != -1 )
+		{
+			pff_test_malloc_attempts_before_fail = -1;
+
+			if( item_tree_update != NULL )
+			{
+				libpff_item_tree_update_free(
+				 &item_tree_update,
+				 NULL );
+			}
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "item_tree_update",
+			 item_tree_update );
+
+			PFF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libpff_item_tree_update_initialize with memset failing
+		 */
+		pff_test_memset_attempts_before_fail = test_number;
+
+		result = libpff_item_tree_update_initialize(
+		          &item_tree_update,
+		          &error );
+
+		if( pff_test_memset_attempts_before_fail != -1 )
+		{
+			pff_test_memset_attempts_before_fail = -1;
+
+			if( item_tree_update != NULL )
+			{
+				libpff_item_tree_update_free(
+				 &item_tree_update,
+				 NULL );
+			}
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "item_tree_update",
+			 item_tree_update );
+
+			PFF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_PFF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( item_tree_update != NULL )
+	{
+		libpff_item_tree_update_free(
+		 &item_tree_update,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_item_tree_update_free function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_item_tree_update_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libpff_item_tree_update_free(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_item_tree_update_prepare, libpff_item_tree_update_commit
+ * and libpff_item_tree_update_revert functions
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_item_tree_update_prepare(
+     void )
+{
+	libcdata_array_t *orphan_node_array              = NULL;
+	libcdata_tree_node_t *item_tree_node             = NULL;
+	libcdata_tree_node_t *root_folder_item_tree_node = NULL;
+	libcerror_error_t *error                         = NULL;
+	libpff_index_layout_t *index_layout              = NULL;
+	libpff_item_descriptor_t *item_descriptor        = NULL;
+	libpff_item_tree_t *item_tree                    = NULL;
+	libpff_item_tree_update_t *item_tree_update      = NULL;
+	int number_of_sub_nodes                          = 0;
+	int result                                       = 0;
+
+	/* Initialize test
+	 */
+	result = pff_test_item_tree_update_create_item_tree(
+	          &item_tree,
+	          &root_folder_item_tree_node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_initialize(
+	          &orphan_node_array,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Descriptor 0x8022 is moved to the root folder and changed,
+	 * descriptor 0x8042 is removed and descriptor 0x8062 is added
+	 */
+	result = libpff_index_layout_initialize(
+	          &index_layout,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_index_layout_append_changed_value(
+	          index_layout,
+	          0x00008022UL,
+	          0x00000021UL,
+	          0x00000310UL,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_index_layout_append_changed_value(
+	          index_layout,
+	          0x00008062UL,
+	          0x00000122UL,
+	          0x00000500UL,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_index_layout_append_removed_identifier(
+	          index_layout,
+	          0x00008042UL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libpff_item_tree_update_initialize(
+	          &item_tree_update,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_item_tree_update_prepare(
+	          item_tree_update,
+	          item_tree,
+	          root_folder_item_tree_node,
+	          orphan_node_array,
+	          index_layout,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The remove, set values, move and add operations
+	 */
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "item_tree_update->number_of_operations",
+	 item_tree_update->number_of_operations,
+	 4 );
+
+	/* Preparing the update does not change the item tree
+	 */
+	result = pff_test_item_tree_update_get_number_of_sub_nodes(
+	          item_tree,
+	          0x00000122UL,
+	          &number_of_sub_nodes,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_sub_nodes",
+	 number_of_sub_nodes,
+	 2 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_item_tree_update_commit(
+	          item_tree_update,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = pff_test_item_tree_update_get_number_of_sub_nodes(
+	          item_tree,
+	          0x00000021UL,
+	          &number_of_sub_nodes,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_sub_nodes",
+	 number_of_sub_nodes,
+	 2 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = pff_test_item_tree_update_get_number_of_sub_nodes(
+	          item_tree,
+	          0x00000122UL,
+	          &number_of_sub_nodes,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_sub_nodes",
+	 number_of_sub_nodes,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_item_tree_get_tree_node_by_identifier(
+	          root_folder_item_tree_node,
+	          0x00008042UL,
+	          &item_tree_node,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_item_tree_get_tree_node_by_identifier(
+	          root_folder_item_tree_node,
+	          0x00008022UL,
+	          &item_tree_node,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_tree_node_get_value(
+	          item_tree_node,
+	          (intptr_t **) &item_descriptor,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "item_descriptor",
+	 item_descriptor );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "item_descriptor->data_identifier",
+	 item_descriptor->data_identifier,
+	 (uint64_t) 0x00000310UL );
+
+	/* Test that reverting the update restores the item tree
+	 */
+	result = libpff_item_tree_update_revert(
+	          item_tree_update,
+	          item_tree_update->number_of_operations - 1,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "item_descriptor->data_identifier",
+	 item_descriptor->data_identifier,
+	 (uint64_t) 0x00000300UL );
+
+	result = pff_test_item_tree_update_get_number_of_sub_nodes(
+	          item_tree,
+	          0x00000021UL,
+	          &number_of_sub_nodes,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_sub_nodes",
+	 number_of_sub_nodes,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = pff_test_item_tree_update_get_number_of_sub_nodes(
+	          item_tree,
+	          0x00000122UL,
+	          &number_of_sub_nodes,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_sub_nodes",
+	 number_of_sub_nodes,
+	 2 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Commit the update again, it is freed after the item tree
+	 * to test that the removed item tree node is managed by the update
+	 */
+	result = libpff_item_tree_update_commit(
+	          item_tree_update,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_item_tree_update_prepare(
+	          NULL,
+	          item_tree,
+	          root_folder_item_tree_node,
+	          orphan_node_array,
+	          index_layout,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* The operations of the item tree update are already set
+	 */
+	result = libpff_item_tree_update_prepare(
+	          item_tree_update,
+	          item_tree,
+	          root_folder_item_tree_node,
+	          orphan_node_array,
+	          index_layout,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_item_tree_update_commit(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_item_tree_update_revert(
+	          NULL,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_item_tree_update_revert(
+	          item_tree_update,
+	          item_tree_update->number_of_operations,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_item_tree_free(
+	          &item_tree,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_item_tree_update_free(
+	          &item_tree_update,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_index_layout_free(
+	          &index_layout,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_free(
+	          &orphan_node_array,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( item_tree_update != NULL )
+	{
+		libpff_item_tree_update_free(
+		 &item_tree_update,
+		 NULL );
+	}
+	if( index_layout != NULL )
+	{
+		libpff_index_layout_free(
+		 &index_layout,
+		 NULL );
+	}
+	if( orphan_node_array != NULL )
+	{
+		libcdata_array_free(
+		 &orphan_node_array,
+		 NULL,
+		 NULL );
+	}
+	if( item_tree != NULL )
+	{
+		libpff_item_tree_free(
+		 &item_tree,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_item_tree_update_prepare function with changes that require
+ * the item tree to be created again
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_item_tree_update_prepare_fallback(
+     void )
+{
+	uint32_t removed_identifiers[ 3 ]                = { 0x00000122UL, 0x00000021UL, 0 };
+	uint32_t changed_identifiers[ 3 ]                = { 0x00008062UL, 0x00000021UL, 0x00008022UL };
+	uint32_t changed_parent_identifiers[ 3 ]         = { 0x00009999UL, 0x00000021UL, 0x00008022UL };
+	uint64_t changed_data_identifiers[ 3 ]           = { 0x00000500UL, 0x00000110UL, 0x00000300UL };
+	libcdata_array_t *orphan_node_array              = NULL;
+	libcdata_tree_node_t *root_folder_item_tree_node = NULL;
+	libcerror_error_t *error                         = NULL;
+	libpff_index_layout_t *index_layout              = NULL;
+	libpff_item_tree_t *item_tree                    = NULL;
+	libpff_item_tree_update_t *item_tree_update      = NULL;
+	int entry_index                                  = 0;
+	int result                                       = 0;
+	int test_index                                   = 0;
+
+	/* Initialize test
+	 */
+	result = pff_test_item_tree_update_create_item_tree(
+	          &item_tree,
+	          &root_folder_item_tree_node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_initialize(
+	          &orphan_node_array,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test the removal of an item with sub items, the removal of the root folder,
+	 * an added item without a parent, changed values of the root folder and
+	 * an item that becomes its own parent
+	 */
+	for( test_index = 0;
+	     test_index < 5;
+	     test_index++ )
+	{
+		result = libpff_index_layout_initialize(
+		          &index_layout,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( test_index < 2 )
+		{
+			result = libpff_index_layout_append_removed_identifier(
+			          index_layout,
+			          removed_identifiers[ test_index ],
+			          &error );
+		}
+		else
+		{
+			entry_index = test_index - 2;
+
+			result = libpff_index_layout_append_changed_value(
+			          index_layout,
+			          changed_identifiers[ entry_index ],
+			          changed_parent_identifiers[ entry_index ],
+			          changed_data_identifiers[ entry_index ],
+			          0,
+			          &error );
+		}
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libpff_item_tree_update_initialize(
+		          &item_tree_update,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libpff_item_tree_update_prepare(
+		          item_tree_update,
+		          item_tree,
+		          root_folder_item_tree_node,
+		          orphan_node_array,
+		          index_layout,
+		          &error );
+
+		if( test_index == 3 )
+		{
+			/* The root folder refers to itself as its parent hence only
+			 * changing its values does not require the item tree to be created again
+			 */
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libpff_item_tree_update_free(
+		          &item_tree_update,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libpff_index_layout_free(
+		          &index_layout,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test that orphan items require the item tree to be created again
+	 */
+	result = libpff_index_layout_initialize(
+	          &index_layout,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_array_append_entry(
+	          orphan_node_array,
+	          &entry_index,
+	          (intptr_t *) root_folder_item_tree_node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_item_tree_update_initialize(
+	          &item_tree_update,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_item_tree_update_prepare(
+	          item_tree_update,
+	          item_tree,
+	          root_folder_item_tree_node,
+	          orphan_node_array,
+	          index_layout,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libpff_item_tree_update_free(
+	          &item_tree_update,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_index_layout_free(
+	          &index_layout,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The item tree nodes in the orphan node array are managed by the item tree
+	 */
+	result = libcdata_array_free(
+	          &orphan_node_array,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_item_tree_free(
+	          &item_tree,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( item_tree_update != NULL )
+	{
+		libpff_item_tree_update_free(
+		 &item_tree_update,
+		 NULL );
+	}
+	if( index_layout != NULL )
+	{
+		libpff_index_layout_free(
+		 &index_layout,
+		 NULL );
+	}
+	if( orphan_node_array != NULL )
+	{
+		libcdata_array_free(
+		 &orphan_node_array,
+		 NULL,
+		 NULL );
+	}
+	if( item_tree != NULL )
+	{
+		libpff_item_tree_free(
+		 &item_tree,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PFF_TEST_UNREFERENCED_PARAMETER( argc )
+	PFF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+	PFF_TEST_RUN(
+	 "libpff_item_tree_update_initialize",
+	 pff_test_item_tree_update_initialize );
+
+	PFF_TEST_RUN(
+	 "libpff_item_tree_update_free",
+	 pff_test_item_tree_update_free );
+
+	PFF_TEST_RUN(
+	 "libpff_item_tree_update_prepare",
+	 pff_test_item_tree_update_prepare );
+
+	PFF_TEST_RUN(
+	 "libpff_item_tree_update_prepare_fallback",
+	 pff_test_item_tree_update_prepare_fallback );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+}
+
@@ -0,0 +1,546 @@
+/*
+ * Library item_visitor type test program
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "pff_test_libcerror.h"
+#include "pff_test_libpff.h"
+#include "pff_test_macros.h"
+#include "pff_test_memory.h"
+#include "pff_test_unused.h"
+
+#include "../libpff/libpff_definitions.h"
+#include "../libpff/libpff_io_handle.h"
+#include "../libpff/libpff_item_tree.h"
+#include "../libpff/libpff_item_visitor.h"
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+/* The item visitor callback function used by the tests
+ * Returns 1 if successful or -1 on error
+ */
+int pff_test_item_visitor_callback_function(
+     libpff_item_t *item PFF_TEST_ATTRIBUTE_UNUSED,
+     void *callback_data PFF_TEST_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error PFF_TEST_ATTRIBUTE_UNUSED )
+{
+	PFF_TEST_UNREFERENCED_PARAMETER( item )
+	PFF_TEST_UNREFERENCED_PARAMETER( callback_data )
+	PFF_TEST_UNREFERENCED_PARAMETER( error )
+
+	return( 1 );
+}
+
+/* Tests the libpff_item_visitor_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_item_visitor_initialize(
+     void )
+{
+	libcerror_error_t *error            = NULL;
+	libpff_io_handle_t *io_handle       = NULL;
+	libpff_item_tree_t *item_tree       = (libpff_item_tree_t *) 0x12345678UL;
+	libpff_item_visitor_t *item_visitor = NULL;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_item_visitor_initialize(
+	          NULL,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          512,
+	          NULL,
+	          item_tree,
+	          1,
+	          0,
+	          &pff_test_item_visitor_callback_function,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	item_visitor = (libpff_item_visitor_t *) 0x12345678UL;
+
+	result = libpff_item_visitor_initialize(
+	          &item_visitor,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          512,
+	          NULL,
+	          item_tree,
+	          1,
+	          0,
+	          &pff_test_item_visitor_callback_function,
+	          NULL,
+	          &error );
+
+	item_visitor = NULL;
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_item_visitor_initialize(
+	          &item_visitor,
+	          NULL,
+	          NULL,
+	          NULL,
+	          512,
+	          NULL,
+	          item_tree,
+	          1,
+	          0,
+	          &pff_test_item_visitor_callback_function,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_item_visitor_initialize(
+	          &item_visitor,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          512,
+	          NULL,
+	          NULL,
+	          1,
+	          0,
+	          &pff_test_item_visitor_callback_function,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_item_visitor_initialize(
+	          &item_visitor,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          512,
+	          NULL,
+	          item_tree,
+	          0,
+	          0,
+	          &pff_test_item_visitor_callback_function,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_item_visitor_initialize(
+	          &item_visitor,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          512,
+	          NULL,
+	          item_tree,
+	          LIBPFF_MAXIMUM_NUMBER_OF_VISIT_THREADS + 1,
+	          0,
+	          &pff_test_item_visitor_callback_function,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_item_visitor_initialize(
+	          &item_visitor,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          512,
+	          NULL,
+	          item_tree,
+	          1,
+	          0,
+	          NULL,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libpff_item_visitor_initialize with a reader context that cannot be created
+	 */
+	result = libpff_item_visitor_initialize(
+	          &item_visitor,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          512,
+	          NULL,
+	          item_tree,
+	          1,
+	          0,
+	          &pff_test_item_visitor_callback_function,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "item_visitor",
+	 item_visitor );
+
+	/* Clean up
+	 */
+	result = libpff_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( item_visitor != NULL )
+	{
+		libpff_item_visitor_free(
+		 &item_visitor,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libpff_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_item_visitor_free function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_item_visitor_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libpff_item_visitor_free(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_item_visitor_stop function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_item_visitor_stop(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libpff_item_visitor_stop(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_item_visitor_complete_task(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_item_visitor_is_stopped(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_item_visitor_visit function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_item_visitor_visit(
+     void )
+{
+	libcdata_tree_node_t *root_item_tree_node = (libcdata_tree_node_t *) 0x12345678UL;
+	libcerror_error_t *error                  = NULL;
+	int result                                = 0;
+
+	/* Test error cases
+	 */
+	result = libpff_item_visitor_visit(
+	          NULL,
+	          root_item_tree_node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PFF_TEST_UNREFERENCED_PARAMETER( argc )
+	PFF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+	PFF_TEST_RUN(
+	 "libpff_item_visitor_initialize",
+	 pff_test_item_visitor_initialize );
+
+	PFF_TEST_RUN(
+	 "libpff_item_visitor_free",
+	 pff_test_item_visitor_free );
+
+	PFF_TEST_RUN(
+	 "libpff_item_visitor_stop",
+	 pff_test_item_visitor_stop );
+
+	PFF_TEST_RUN(
+	 "libpff_item_visitor_visit",
+	 pff_test_item_visitor_visit );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+}
+
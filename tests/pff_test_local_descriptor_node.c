@@ -312,7 +312,19 @@ int pff_test_local_descriptor_node_read_data(
 	 "error",
 	 error );
 
-	io_handle->file_type = LIBPFF_FILE_TYPE_64BIT;
+	result = libpff_io_handle_set_file_type(
+	          io_handle,
+	          LIBPFF_FILE_TYPE_64BIT,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	result = libpff_local_descriptor_node_initialize(
 	          &local_descriptor_node,
@@ -517,7 +529,19 @@ int pff_test_local_descriptor_node_read_file_io_handle(
 	 "error",
 	 error );
 
-	io_handle->file_type = LIBPFF_FILE_TYPE_64BIT;
+	result = libpff_io_handle_set_file_type(
+	          io_handle,
+	          LIBPFF_FILE_TYPE_64BIT,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	result = libpff_local_descriptor_node_initialize(
 	          &local_descriptor_node,
@@ -1123,7 +1147,19 @@ int main(
 	 "error",
 	 error );
 
-	io_handle->file_type = LIBPFF_FILE_TYPE_64BIT;
+	result = libpff_io_handle_set_file_type(
+	          io_handle,
+	          LIBPFF_FILE_TYPE_64BIT,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	result = libpff_local_descriptor_node_initialize(
 	          &local_descriptor_node,
@@ -0,0 +1,1489 @@
+/*
+ * Library local_descriptor_nodes_cache type test program
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "pff_test_libcerror.h"
+#include "pff_test_libpff.h"
+#include "pff_test_macros.h"
+#include "pff_test_memory.h"
+#include "pff_test_unused.h"
+
+#include "../libpff/libpff_local_descriptor_nodes_cache.h"
+#include "../libpff/libpff_local_descriptor_node.h"
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+/* Value free function that always fails
+ * Returns -1
+ */
+int pff_test_local_descriptor_nodes_cache_value_free_with_error(
+     intptr_t **value PFF_TEST_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	static char *function = "pff_test_local_descriptor_nodes_cache_value_free_with_error";
+
+	PFF_TEST_UNREFERENCED_PARAMETER( value )
+
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+	 "%s: unable to free value.",
+	 function );
+
+	return( -1 );
+}
+
+/* Tests the libpff_local_descriptor_nodes_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_local_descriptor_nodes_cache_initialize(
+     void )
+{
+	libcerror_error_t *error                                            = NULL;
+	libpff_local_descriptor_nodes_cache_t *local_descriptor_nodes_cache = NULL;
+	int result                                                          = 0;
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+	int number_of_malloc_fail_tests   = 5;
+	int number_of_memset_fail_tests   = 4;
+	int test_number                   = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libpff_local_descriptor_nodes_cache_initialize(
+	          &local_descriptor_nodes_cache,
+	          2,
+	          8,
+	          1024,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libpff_local_descriptor_node_free,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "local_descriptor_nodes_cache",
+	 local_descriptor_nodes_cache );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_local_descriptor_nodes_cache_free(
+	          &local_descriptor_nodes_cache,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "local_descriptor_nodes_cache",
+	 local_descriptor_nodes_cache );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_local_descriptor_nodes_cache_initialize(
+	          NULL,
+	          2,
+	          8,
+	          1024,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libpff_local_descriptor_node_free,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	local_descriptor_nodes_cache = (libpff_local_descriptor_nodes_cache_t *) 0x12345678UL;
+
+	result = libpff_local_descriptor_nodes_cache_initialize(
+	          &local_descriptor_nodes_cache,
+	          2,
+	          8,
+	          1024,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libpff_local_descriptor_node_free,
+	          &error );
+
+	local_descriptor_nodes_cache = NULL;
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_local_descriptor_nodes_cache_initialize(
+	          &local_descriptor_nodes_cache,
+	          0,
+	          8,
+	          1024,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libpff_local_descriptor_node_free,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_local_descriptor_nodes_cache_initialize(
+	          &local_descriptor_nodes_cache,
+	          3,
+	          8,
+	          1024,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libpff_local_descriptor_node_free,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_local_descriptor_nodes_cache_initialize(
+	          &local_descriptor_nodes_cache,
+	          16,
+	          8,
+	          1024,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libpff_local_descriptor_node_free,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_local_descriptor_nodes_cache_initialize(
+	          &local_descriptor_nodes_cache,
+	          2,
+	          8,
+	          1024,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libpff_local_descriptor_nodes_cache_initialize with malloc failing
+		 */
+		pff_test_malloc_attempts_before_fail = test_number;
+
+		result = libpff_local_descriptor_nodes_cache_initialize(
+		          &local_descriptor_nodes_cache,
+		          2,
+		          8,
+		          1024,
+		          (int (*)(intptr_t **, libcerror_error_t **)) &libpff_local_descriptor_node_free,
+		          &error );
+
+		if( pff_test_malloc_attempts_before_fail != -1 )
+		{
+			pff_test_malloc_attempts_before_fail = -1;
+
+			if( local_descriptor_nodes_cache != NULL )
+			{
+				libpff_local_descriptor_nodes_cache_free(
+				 &local_descriptor_nodes_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "local_descriptor_nodes_cache",
+			 local_descriptor_nodes_cache );
+
+			PFF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libpff_local_descriptor_nodes_cache_initialize with memset failing
+		 */
+		pff_test_memset_attempts_before_fail = test_number;
+
+		result = libpff_local_descriptor_nodes_cache_initialize(
+		          &local_descriptor_nodes_cache,
+		          2,
+		          8,
+		          1024,
+		          (int (*)(intptr_t **, libcerror_error_t **)) &libpff_local_descriptor_node_free,
+		          &error );
+
+		if( pff_test_memset_attempts_before_fail != -1 )
+		{
+			pff_test_memset_attempts_before_fail = -1;
+
+			if( local_descriptor_nodes_cache != NULL )
+			{
+				libpff_local_descriptor_nodes_cache_free(
+				 &local_descriptor_nodes_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "local_descriptor_nodes_cache",
+			 local_descriptor_nodes_cache );
+
+			PFF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_PFF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( local_descriptor_nodes_cache != NULL )
+	{
+		libpff_local_descriptor_nodes_cache_free(
+		 &local_descriptor_nodes_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_local_descriptor_nodes_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_local_descriptor_nodes_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libpff_local_descriptor_nodes_cache_free(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_local_descriptor_nodes_cache_get_shard_index function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_local_descriptor_nodes_cache_get_shard_index(
+     void )
+{
+	libcerror_error_t *error                                            = NULL;
+	libpff_local_descriptor_nodes_cache_t *local_descriptor_nodes_cache = NULL;
+	int result                                                          = 0;
+	int shard_index                                                     = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_local_descriptor_nodes_cache_initialize(
+	          &local_descriptor_nodes_cache,
+	          4,
+	          8,
+	          1024,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libpff_local_descriptor_node_free,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "local_descriptor_nodes_cache",
+	 local_descriptor_nodes_cache );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libpff_local_descriptor_nodes_cache_get_shard_index(
+	          local_descriptor_nodes_cache,
+	          0x21,
+	          0x48,
+	          &shard_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_GREATER_THAN_INT(
+	 "shard_index",
+	 shard_index,
+	 -1 );
+
+	PFF_TEST_ASSERT_LESS_THAN_INT(
+	 "shard_index",
+	 shard_index,
+	 4 );
+
+	/* Test error cases
+	 */
+	result = libpff_local_descriptor_nodes_cache_get_shard_index(
+	          NULL,
+	          0x21,
+	          0x48,
+	          &shard_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_local_descriptor_nodes_cache_get_shard_index(
+	          local_descriptor_nodes_cache,
+	          0x21,
+	          0x48,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_local_descriptor_nodes_cache_free(
+	          &local_descriptor_nodes_cache,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "local_descriptor_nodes_cache",
+	 local_descriptor_nodes_cache );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( local_descriptor_nodes_cache != NULL )
+	{
+		libpff_local_descriptor_nodes_cache_free(
+		 &local_descriptor_nodes_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_local_descriptor_nodes_cache_get_value, libpff_local_descriptor_nodes_cache_set_value and libpff_local_descriptor_nodes_cache_release_value functions
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_local_descriptor_nodes_cache_get_set_and_release_value(
+     void )
+{
+	libcerror_error_t *error                                            = NULL;
+	libpff_local_descriptor_nodes_cache_t *local_descriptor_nodes_cache = NULL;
+	libpff_local_descriptor_node_t *cached_node                         = NULL;
+	libpff_local_descriptor_node_t *node                                = NULL;
+	libpff_local_descriptor_node_t *pinned_node                         = NULL;
+	int result                                                          = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_local_descriptor_nodes_cache_initialize(
+	          &local_descriptor_nodes_cache,
+	          1,
+	          2,
+	          1024,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libpff_local_descriptor_node_free,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "local_descriptor_nodes_cache",
+	 local_descriptor_nodes_cache );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libpff_local_descriptor_nodes_cache_get_value(
+	          local_descriptor_nodes_cache,
+	          0x21,
+	          0x48,
+	          (intptr_t **) &cached_node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_local_descriptor_node_initialize(
+	          &node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "node",
+	 node );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_local_descriptor_nodes_cache_set_value(
+	          local_descriptor_nodes_cache,
+	          0x21,
+	          0x48,
+	          (intptr_t *) node,
+	          512,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	pinned_node = node;
+	node        = NULL;
+
+	/* Test that a value with the same identifiers is not cached
+	 */
+	result = libpff_local_descriptor_node_initialize(
+	          &node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "node",
+	 node );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_local_descriptor_nodes_cache_set_value(
+	          local_descriptor_nodes_cache,
+	          0x21,
+	          0x48,
+	          (intptr_t *) node,
+	          512,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_local_descriptor_node_free(
+	          &node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_local_descriptor_nodes_cache_release_value(
+	          local_descriptor_nodes_cache,
+	          0x21,
+	          0x48,
+	          (intptr_t *) pinned_node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that releasing an unknown value is ignored
+	 */
+	result = libpff_local_descriptor_nodes_cache_release_value(
+	          local_descriptor_nodes_cache,
+	          0x21,
+	          0x88,
+	          (intptr_t *) pinned_node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_local_descriptor_nodes_cache_get_value(
+	          local_descriptor_nodes_cache,
+	          0x21,
+	          0x48,
+	          (intptr_t **) &cached_node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_INTPTR(
+	 "cached_node",
+	 (intptr_t *) cached_node,
+	 (intptr_t *) pinned_node );
+
+	result = libpff_local_descriptor_nodes_cache_release_value(
+	          local_descriptor_nodes_cache,
+	          0x21,
+	          0x48,
+	          (intptr_t *) cached_node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a value that exceeds the maximum size is not cached
+	 */
+	result = libpff_local_descriptor_node_initialize(
+	          &node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "node",
+	 node );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_local_descriptor_nodes_cache_set_value(
+	          local_descriptor_nodes_cache,
+	          0x21,
+	          0x88,
+	          (intptr_t *) node,
+	          2048,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that an unpinned value is evicted
+	 */
+	result = libpff_local_descriptor_nodes_cache_set_value(
+	          local_descriptor_nodes_cache,
+	          0x21,
+	          0x88,
+	          (intptr_t *) node,
+	          768,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	pinned_node = node;
+	node        = NULL;
+
+	result = libpff_local_descriptor_nodes_cache_get_value(
+	          local_descriptor_nodes_cache,
+	          0x21,
+	          0x48,
+	          (intptr_t **) &cached_node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a pinned value is not evicted
+	 */
+	result = libpff_local_descriptor_node_initialize(
+	          &node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "node",
+	 node );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_local_descriptor_nodes_cache_set_value(
+	          local_descriptor_nodes_cache,
+	          0x21,
+	          0xa8,
+	          (intptr_t *) node,
+	          512,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_local_descriptor_node_free(
+	          &node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_local_descriptor_nodes_cache_release_value(
+	          local_descriptor_nodes_cache,
+	          0x21,
+	          0x88,
+	          (intptr_t *) pinned_node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_local_descriptor_nodes_cache_get_value(
+	          NULL,
+	          0x21,
+	          0x48,
+	          (intptr_t **) &cached_node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_local_descriptor_nodes_cache_get_value(
+	          local_descriptor_nodes_cache,
+	          0x21,
+	          0x48,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_local_descriptor_nodes_cache_set_value(
+	          NULL,
+	          0x21,
+	          0x48,
+	          (intptr_t *) pinned_node,
+	          512,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_local_descriptor_nodes_cache_set_value(
+	          local_descriptor_nodes_cache,
+	          0x21,
+	          0x48,
+	          NULL,
+	          512,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_local_descriptor_nodes_cache_release_value(
+	          NULL,
+	          0x21,
+	          0x48,
+	          (intptr_t *) pinned_node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_local_descriptor_nodes_cache_free(
+	          &local_descriptor_nodes_cache,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "local_descriptor_nodes_cache",
+	 local_descriptor_nodes_cache );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( node != NULL )
+	{
+		libpff_local_descriptor_node_free(
+		 &node,
+		 NULL );
+	}
+	if( local_descriptor_nodes_cache != NULL )
+	{
+		libpff_local_descriptor_nodes_cache_free(
+		 &local_descriptor_nodes_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_local_descriptor_nodes_cache_set_value function with values being evicted
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_local_descriptor_nodes_cache_set_value_evict(
+     void )
+{
+	libcerror_error_t *error                                            = NULL;
+	libpff_local_descriptor_nodes_cache_t *local_descriptor_nodes_cache = NULL;
+	libpff_local_descriptor_node_t *cached_node                         = NULL;
+	libpff_local_descriptor_node_t *node                                = NULL;
+	uint64_t data_identifier                                            = 0;
+	int number_of_cached_values                                         = 0;
+	int result                                                          = 0;
+	int value_index                                                     = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_local_descriptor_nodes_cache_initialize(
+	          &local_descriptor_nodes_cache,
+	          1,
+	          4,
+	          1024,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libpff_local_descriptor_node_free,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "local_descriptor_nodes_cache",
+	 local_descriptor_nodes_cache );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( value_index = 0;
+	     value_index < 16;
+	     value_index++ )
+	{
+		data_identifier = (uint64_t) ( value_index + 1 ) << 5;
+
+		result = libpff_local_descriptor_node_initialize(
+		          &node,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libpff_local_descriptor_nodes_cache_set_value(
+		          local_descriptor_nodes_cache,
+		          0x21,
+		          data_identifier,
+		          (intptr_t *) node,
+		          64,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		cached_node = node;
+		node        = NULL;
+
+		result = libpff_local_descriptor_nodes_cache_release_value(
+		          local_descriptor_nodes_cache,
+		          0x21,
+		          data_identifier,
+		          (intptr_t *) cached_node,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "local_descriptor_nodes_cache->shards[ 0 ].number_of_entries",
+	 local_descriptor_nodes_cache->shards[ 0 ].number_of_entries,
+	 4 );
+
+	/* Test that all the remaining values can be found after the entries were moved
+	 */
+	for( value_index = 0;
+	     value_index < 16;
+	     value_index++ )
+	{
+		data_identifier = (uint64_t) ( value_index + 1 ) << 5;
+
+		result = libpff_local_descriptor_nodes_cache_get_value(
+		          local_descriptor_nodes_cache,
+		          0x21,
+		          data_identifier,
+		          (intptr_t **) &cached_node,
+		          &error );
+
+		PFF_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( result != 0 )
+		{
+			number_of_cached_values++;
+
+			result = libpff_local_descriptor_nodes_cache_release_value(
+			          local_descriptor_nodes_cache,
+			          0x21,
+			          data_identifier,
+			          (intptr_t *) cached_node,
+			          &error );
+
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+	}
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_cached_values",
+	 number_of_cached_values,
+	 4 );
+
+	/* Test that the value that was set last was not evicted
+	 */
+	result = libpff_local_descriptor_nodes_cache_get_value(
+	          local_descriptor_nodes_cache,
+	          0x21,
+	          (uint64_t) 16 << 5,
+	          (intptr_t **) &cached_node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_local_descriptor_nodes_cache_release_value(
+	          local_descriptor_nodes_cache,
+	          0x21,
+	          (uint64_t) 16 << 5,
+	          (intptr_t *) cached_node,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libpff_local_descriptor_nodes_cache_free(
+	          &local_descriptor_nodes_cache,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "local_descriptor_nodes_cache",
+	 local_descriptor_nodes_cache );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( node != NULL )
+	{
+		libpff_local_descriptor_node_free(
+		 &node,
+		 NULL );
+	}
+	if( local_descriptor_nodes_cache != NULL )
+	{
+		libpff_local_descriptor_nodes_cache_free(
+		 &local_descriptor_nodes_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_local_descriptor_nodes_cache_set_value function with a value free function that fails
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_local_descriptor_nodes_cache_set_value_free_error(
+     void )
+{
+	int values[ 3 ] = { 1, 2, 3 };
+
+	libcerror_error_t *error          = NULL;
+	libpff_local_descriptor_nodes_cache_t *local_descriptor_nodes_cache = NULL;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_local_descriptor_nodes_cache_initialize(
+	          &local_descriptor_nodes_cache,
+	          1,
+	          2,
+	          1024,
+	          &pff_test_local_descriptor_nodes_cache_value_free_with_error,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "local_descriptor_nodes_cache",
+	 local_descriptor_nodes_cache );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_local_descriptor_nodes_cache_set_value(
+	          local_descriptor_nodes_cache,
+	          0x21,
+	          0x48,
+	          (intptr_t *) &( values[ 0 ] ),
+	          64,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_local_descriptor_nodes_cache_release_value(
+	          local_descriptor_nodes_cache,
+	          0x21,
+	          0x48,
+	          (intptr_t *) &( values[ 0 ] ),
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_local_descriptor_nodes_cache_set_value(
+	          local_descriptor_nodes_cache,
+	          0x21,
+	          0x68,
+	          (intptr_t *) &( values[ 1 ] ),
+	          64,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_local_descriptor_nodes_cache_release_value(
+	          local_descriptor_nodes_cache,
+	          0x21,
+	          0x68,
+	          (intptr_t *) &( values[ 1 ] ),
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_local_descriptor_nodes_cache_set_value(
+	          local_descriptor_nodes_cache,
+	          0x21,
+	          0x88,
+	          (intptr_t *) &( values[ 2 ] ),
+	          64,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* The evicted entry is removed and the value is not cached
+	 */
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "local_descriptor_nodes_cache->shards[ 0 ].number_of_entries",
+	 local_descriptor_nodes_cache->shards[ 0 ].number_of_entries,
+	 1 );
+
+	result = libpff_local_descriptor_nodes_cache_release_value(
+	          local_descriptor_nodes_cache,
+	          0x21,
+	          0x88,
+	          (intptr_t *) &( values[ 2 ] ),
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libpff_local_descriptor_nodes_cache_free(
+	          &local_descriptor_nodes_cache,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "local_descriptor_nodes_cache",
+	 local_descriptor_nodes_cache );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( local_descriptor_nodes_cache != NULL )
+	{
+		libpff_local_descriptor_nodes_cache_free(
+		 &local_descriptor_nodes_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PFF_TEST_UNREFERENCED_PARAMETER( argc )
+	PFF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+	PFF_TEST_RUN(
+	 "libpff_local_descriptor_nodes_cache_initialize",
+	 pff_test_local_descriptor_nodes_cache_initialize );
+
+	PFF_TEST_RUN(
+	 "libpff_local_descriptor_nodes_cache_free",
+	 pff_test_local_descriptor_nodes_cache_free );
+
+	PFF_TEST_RUN(
+	 "libpff_local_descriptor_nodes_cache_get_shard_index",
+	 pff_test_local_descriptor_nodes_cache_get_shard_index );
+
+	PFF_TEST_RUN(
+	 "libpff_local_descriptor_nodes_cache_get_value",
+	 pff_test_local_descriptor_nodes_cache_get_set_and_release_value );
+
+	PFF_TEST_RUN(
+	 "libpff_local_descriptor_nodes_cache_set_value_evict",
+	 pff_test_local_descriptor_nodes_cache_set_value_evict );
+
+	PFF_TEST_RUN(
+	 "libpff_local_descriptor_nodes_cache_set_value_free_error",
+	 pff_test_local_descriptor_nodes_cache_set_value_free_error );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+}
+
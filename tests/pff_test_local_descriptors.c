@@ -417,6 +417,8 @@ int main(
 
 	/* TODO: add tests for libpff_local_descriptors_read_local_descriptor_node */
 
+	/* TODO: add tests for libpff_local_descriptors_release_local_descriptor_node */
+
 	/* TODO: add tests for libpff_local_descriptors_read_tree_node */
 
 	/* TODO: add tests for libpff_local_descriptors_read_local_descriptor_value */
@@ -656,6 +656,155 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libpff_offsets_index_prefetch function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_offsets_index_prefetch(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libpff_io_handle_t *io_handle         = NULL;
+	libpff_offsets_index_t *offsets_index = NULL;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_offsets_index_initialize(
+	          &offsets_index,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "offsets_index",
+	 offsets_index );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_offsets_index_prefetch(
+	          NULL,
+	          NULL,
+	          2,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test prefetch without a root node
+	 */
+	result = libpff_offsets_index_prefetch(
+	          offsets_index,
+	          NULL,
+	          2,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_offsets_index_free(
+	          &offsets_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "offsets_index",
+	 offsets_index );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( offsets_index != NULL )
+	{
+		libpff_offsets_index_free(
+		 &offsets_index,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libpff_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
 
 /* The main program
@@ -691,6 +840,10 @@ int main(
 	 "libpff_offsets_index_get_index_value_by_identifier",
 	 pff_test_offsets_index_get_index_value_by_identifier );
 
+	PFF_TEST_RUN(
+	 "libpff_offsets_index_prefetch",
+	 pff_test_offsets_index_prefetch );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
@@ -0,0 +1,1213 @@
+/*
+ * Library property_set type test program
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "pff_test_libcdata.h"
+#include "pff_test_libcerror.h"
+#include "pff_test_libpff.h"
+#include "pff_test_macros.h"
+#include "pff_test_memory.h"
+#include "pff_test_unused.h"
+
+#include "../libpff/libpff_definitions.h"
+#include "../libpff/libpff_name_to_id_map.h"
+#include "../libpff/libpff_property_set.h"
+#include "../libpff/libpff_record_entry.h"
+
+uint8_t pff_test_property_set_guid[ 16 ] = {
+	0x08, 0x20, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46 };
+
+/* Tests the libpff_property_set_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_property_set_initialize(
+     void )
+{
+	libcerror_error_t *error            = NULL;
+	libpff_property_set_t *property_set = NULL;
+	int result                          = 0;
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+	int number_of_malloc_fail_tests     = 2;
+	int number_of_memset_fail_tests     = 1;
+	int test_number                     = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libpff_property_set_initialize(
+	          &property_set,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "property_set",
+	 property_set );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_property_set_free(
+	          &property_set,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "property_set",
+	 property_set );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_property_set_initialize(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	property_set = (libpff_property_set_t *) 0x12345678UL;
+
+	result = libpff_property_set_initialize(
+	          &property_set,
+	          &error );
+
+	property_set = NULL;
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libpff_property_set_initialize with malloc failing
+		 * Test libpff_property_set_initialize with malloc failing in libcdata_array_initialize
+		 */
+		pff_test_malloc_attempts_before_fail = test_number;
+
+		result = libpff_property_set_initialize(
+		          &property_set,
+		          &error );
+
+		if( pff_test_malloc_attempts_before_fail != -1 )
+		{
+			pff_test_malloc_attempts_before_fail = -1;
+
+			if( property_set != NULL )
+			{
+				libpff_property_set_free(
+				 &property_set,
+				 NULL );
+			}
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "property_set",
+			 property_set );
+
+			PFF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libpff_property_set_initialize with memset failing
+		 */
+		pff_test_memset_attempts_before_fail = test_number;
+
+		result = libpff_property_set_initialize(
+		          &property_set,
+		          &error );
+
+		if( pff_test_memset_attempts_before_fail != -1 )
+		{
+			pff_test_memset_attempts_before_fail = -1;
+
+			if( property_set != NULL )
+			{
+				libpff_property_set_free(
+				 &property_set,
+				 NULL );
+			}
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "property_set",
+			 property_set );
+
+			PFF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_PFF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( property_set != NULL )
+	{
+		libpff_property_set_free(
+		 &property_set,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_property_set_free function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_property_set_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libpff_property_set_free(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_property_set_append_entry_type function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_property_set_append_entry_type(
+     libpff_property_set_t *property_set )
+{
+	libcerror_error_t *error = NULL;
+	int request_index        = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libpff_property_set_append_entry_type(
+	          property_set,
+	          0x0037,
+	          0x001f,
+	          0,
+	          &request_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "request_index",
+	 request_index,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_property_set_append_entry_type(
+	          property_set,
+	          0x0e07,
+	          0,
+	          LIBPFF_ENTRY_VALUE_FLAG_MATCH_ANY_VALUE_TYPE,
+	          &request_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "request_index",
+	 request_index,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_property_set_append_entry_type(
+	          NULL,
+	          0x0037,
+	          0x001f,
+	          0,
+	          &request_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_property_set_append_entry_type(
+	          property_set,
+	          0x0037,
+	          0x001f,
+	          0xff,
+	          &request_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_property_set_append_numeric_name function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_property_set_append_numeric_name(
+     libpff_property_set_t *property_set )
+{
+	libcerror_error_t *error = NULL;
+	int request_index        = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libpff_property_set_append_numeric_name(
+	          property_set,
+	          pff_test_property_set_guid,
+	          16,
+	          0x8503,
+	          0x000b,
+	          0,
+	          &request_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "request_index",
+	 request_index,
+	 2 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_property_set_append_numeric_name(
+	          NULL,
+	          pff_test_property_set_guid,
+	          16,
+	          0x8503,
+	          0x000b,
+	          0,
+	          &request_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_property_set_append_numeric_name(
+	          property_set,
+	          NULL,
+	          16,
+	          0x8503,
+	          0x000b,
+	          0,
+	          &request_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_property_set_append_numeric_name(
+	          property_set,
+	          pff_test_property_set_guid,
+	          8,
+	          0x8503,
+	          0x000b,
+	          0,
+	          &request_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_property_set_append_numeric_name(
+	          property_set,
+	          pff_test_property_set_guid,
+	          16,
+	          0x8503,
+	          0x000b,
+	          LIBPFF_ENTRY_VALUE_FLAG_IGNORE_NAME_TO_ID_MAP,
+	          &request_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_property_set_append_utf8_name function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_property_set_append_utf8_name(
+     libpff_property_set_t *property_set )
+{
+	uint8_t utf8_string[ 11 ] = { 'K', 'e', 'y', 'w', 'o', 'r', 'd', 's', 0, 0, 0 };
+	libcerror_error_t *error  = NULL;
+	int request_index         = 0;
+	int result                = 0;
+
+	/* Test regular cases
+	 */
+	result = libpff_property_set_append_utf8_name(
+	          property_set,
+	          pff_test_property_set_guid,
+	          16,
+	          utf8_string,
+	          8,
+	          0x101f,
+	          0,
+	          &request_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "request_index",
+	 request_index,
+	 3 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_property_set_append_utf8_name(
+	          NULL,
+	          pff_test_property_set_guid,
+	          16,
+	          utf8_string,
+	          8,
+	          0x101f,
+	          0,
+	          &request_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_property_set_append_utf8_name(
+	          property_set,
+	          pff_test_property_set_guid,
+	          16,
+	          NULL,
+	          8,
+	          0x101f,
+	          0,
+	          &request_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_property_set_append_utf8_name(
+	          property_set,
+	          pff_test_property_set_guid,
+	          16,
+	          utf8_string,
+	          0,
+	          0x101f,
+	          0,
+	          &request_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_property_set_get_number_of_requests function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_property_set_get_number_of_requests(
+     libpff_property_set_t *property_set )
+{
+	libcerror_error_t *error = NULL;
+	int number_of_requests   = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libpff_property_set_get_number_of_requests(
+	          property_set,
+	          &number_of_requests,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_requests",
+	 number_of_requests,
+	 4 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_property_set_get_number_of_requests(
+	          NULL,
+	          &number_of_requests,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+/* Tests the libpff_property_set_prepare and libpff_property_set_match_record_entry functions
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_property_set_match_record_entry(
+     libpff_property_set_t *property_set )
+{
+	libcdata_list_t *name_to_id_map_list                         = NULL;
+	libcerror_error_t *error                                     = NULL;
+	libpff_internal_name_to_id_map_entry_t *name_to_id_map_entry = NULL;
+	libpff_internal_record_entry_t *internal_record_entry        = NULL;
+	libpff_record_entry_t *record_entries[ 4 ]                   = { NULL, NULL, NULL, NULL };
+	libpff_record_entry_t *record_entry                          = NULL;
+	int result                                                   = 0;
+
+	/* Initialize test
+	 */
+	result = libcdata_list_initialize(
+	          &name_to_id_map_list,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_name_to_id_map_entry_initialize(
+	          (libpff_name_to_id_map_entry_t **) &name_to_id_map_entry,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	name_to_id_map_entry->identifier    = 0x8004;
+	name_to_id_map_entry->type          = LIBPFF_NAME_TO_ID_MAP_ENTRY_TYPE_NUMERIC;
+	name_to_id_map_entry->numeric_value = 0x8503;
+	name_to_id_map_entry->value_size    = 4;
+
+	result = memory_copy(
+	          name_to_id_map_entry->guid,
+	          pff_test_property_set_guid,
+	          16 ) != NULL;
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcdata_list_append_value(
+	          name_to_id_map_list,
+	          (intptr_t *) name_to_id_map_entry,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_record_entry_initialize(
+	          &record_entry,
+	          LIBPFF_CODEPAGE_WINDOWS_1252,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	internal_record_entry = (libpff_internal_record_entry_t *) record_entry;
+
+	/* Test libpff_property_set_match_record_entry on a property set that was not prepared
+	 */
+	result = libpff_property_set_is_prepared(
+	          property_set,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_property_set_match_record_entry(
+	          property_set,
+	          internal_record_entry,
+	          record_entries,
+	          4,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test regular cases
+	 */
+	result = libpff_property_set_prepare(
+	          property_set,
+	          NULL,
+	          name_to_id_map_list,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_property_set_is_prepared(
+	          property_set,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The numeric name is resolved to the mapped entry type 0x8004
+	 */
+	internal_record_entry->identifier.format     = LIBPFF_RECORD_ENTRY_IDENTIFIER_FORMAT_MAPI_PROPERTY;
+	internal_record_entry->identifier.entry_type = 0x8004;
+	internal_record_entry->identifier.value_type = 0x000b;
+	internal_record_entry->name_to_id_map_entry  = name_to_id_map_entry;
+
+	result = libpff_property_set_match_record_entry(
+	          property_set,
+	          internal_record_entry,
+	          record_entries,
+	          4,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "record_entries[ 0 ]",
+	 record_entries[ 0 ] );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "record_entries[ 1 ]",
+	 record_entries[ 1 ] );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "record_entries[ 2 ]",
+	 record_entries[ 2 ] );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "record_entries[ 3 ]",
+	 record_entries[ 3 ] );
+
+	record_entries[ 2 ] = NULL;
+
+	/* Entry type requests match an unmapped record entry by its entry type
+	 */
+	internal_record_entry->identifier.entry_type = 0x0e07;
+	internal_record_entry->identifier.value_type = 0x0003;
+	internal_record_entry->name_to_id_map_entry  = NULL;
+
+	result = libpff_property_set_match_record_entry(
+	          property_set,
+	          internal_record_entry,
+	          record_entries,
+	          4,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "record_entries[ 0 ]",
+	 record_entries[ 0 ] );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "record_entries[ 1 ]",
+	 record_entries[ 1 ] );
+
+	record_entries[ 1 ] = NULL;
+
+	/* The value type must match unless any value type is requested
+	 */
+	internal_record_entry->identifier.entry_type = 0x0037;
+	internal_record_entry->identifier.value_type = 0x001e;
+
+	result = libpff_property_set_match_record_entry(
+	          property_set,
+	          internal_record_entry,
+	          record_entries,
+	          4,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "record_entries[ 0 ]",
+	 record_entries[ 0 ] );
+
+	/* Test error cases
+	 */
+	result = libpff_property_set_match_record_entry(
+	          NULL,
+	          internal_record_entry,
+	          record_entries,
+	          4,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_property_set_match_record_entry(
+	          property_set,
+	          NULL,
+	          record_entries,
+	          4,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_property_set_match_record_entry(
+	          property_set,
+	          internal_record_entry,
+	          NULL,
+	          4,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_property_set_prepare(
+	          NULL,
+	          NULL,
+	          name_to_id_map_list,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_internal_record_entry_free(
+	          &internal_record_entry,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_list_free(
+	          &name_to_id_map_list,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libpff_name_to_id_map_entry_free,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( internal_record_entry != NULL )
+	{
+		libpff_internal_record_entry_free(
+		 &internal_record_entry,
+		 NULL );
+	}
+	if( name_to_id_map_list != NULL )
+	{
+		libcdata_list_free(
+		 &name_to_id_map_list,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libpff_name_to_id_map_entry_free,
+		 NULL );
+	}
+	else if( name_to_id_map_entry != NULL )
+	{
+		libpff_name_to_id_map_entry_free(
+		 (libpff_name_to_id_map_entry_t **) &name_to_id_map_entry,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	libcerror_error_t *error            = NULL;
+	libpff_property_set_t *property_set = NULL;
+	int result                          = 0;
+
+	PFF_TEST_UNREFERENCED_PARAMETER( argc )
+	PFF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	PFF_TEST_RUN(
+	 "libpff_property_set_initialize",
+	 pff_test_property_set_initialize );
+
+	PFF_TEST_RUN(
+	 "libpff_property_set_free",
+	 pff_test_property_set_free );
+
+#if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
+
+	/* Initialize test
+	 */
+	result = libpff_property_set_initialize(
+	          &property_set,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "property_set",
+	 property_set );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_RUN_WITH_ARGS(
+	 "libpff_property_set_append_entry_type",
+	 pff_test_property_set_append_entry_type,
+	 property_set );
+
+	PFF_TEST_RUN_WITH_ARGS(
+	 "libpff_property_set_append_numeric_name",
+	 pff_test_property_set_append_numeric_name,
+	 property_set );
+
+	PFF_TEST_RUN_WITH_ARGS(
+	 "libpff_property_set_append_utf8_name",
+	 pff_test_property_set_append_utf8_name,
+	 property_set );
+
+	PFF_TEST_RUN_WITH_ARGS(
+	 "libpff_property_set_get_number_of_requests",
+	 pff_test_property_set_get_number_of_requests,
+	 property_set );
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+	PFF_TEST_RUN_WITH_ARGS(
+	 "libpff_property_set_match_record_entry",
+	 pff_test_property_set_match_record_entry,
+	 property_set );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+	/* Clean up
+	 */
+	result = libpff_property_set_free(
+	          &property_set,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "property_set",
+	 property_set );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#endif /* !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+#if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( property_set != NULL )
+	{
+		libpff_property_set_free(
+		 &property_set,
+		 NULL );
+	}
+#endif /* !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 ) */
+
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,568 @@
+/*
+ * Library reader_context type test program
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "pff_test_libcerror.h"
+#include "pff_test_libpff.h"
+#include "pff_test_macros.h"
+#include "pff_test_memory.h"
+#include "pff_test_unused.h"
+
+#include "../libpff/libpff_definitions.h"
+#include "../libpff/libpff_file_header.h"
+#include "../libpff/libpff_io_handle.h"
+#include "../libpff/libpff_reader_context.h"
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+/* Tests the libpff_reader_context_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_reader_context_initialize(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libpff_file_header_t *file_header       = NULL;
+	libpff_io_handle_t *io_handle           = NULL;
+	libpff_reader_context_t *reader_context = NULL;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_file_header_initialize(
+	          &file_header,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_header",
+	 file_header );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_reader_context_initialize(
+	          NULL,
+	          io_handle,
+	          NULL,
+	          file_header,
+	          512,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	reader_context = (libpff_reader_context_t *) 0x12345678UL;
+
+	result = libpff_reader_context_initialize(
+	          &reader_context,
+	          io_handle,
+	          NULL,
+	          file_header,
+	          512,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	reader_context = NULL;
+
+	result = libpff_reader_context_initialize(
+	          &reader_context,
+	          NULL,
+	          NULL,
+	          file_header,
+	          512,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_reader_context_initialize(
+	          &reader_context,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          512,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_reader_context_initialize(
+	          &reader_context,
+	          io_handle,
+	          NULL,
+	          file_header,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_reader_context_initialize(
+	          &reader_context,
+	          io_handle,
+	          NULL,
+	          file_header,
+	          512,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_file_header_free(
+	          &file_header,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "file_header",
+	 file_header );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_header != NULL )
+	{
+		libpff_file_header_free(
+		 &file_header,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libpff_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_reader_context_free function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_reader_context_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libpff_reader_context_free(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_reader_context_merge_read_state function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_reader_context_merge_read_state(
+     void )
+{
+	libpff_reader_context_t reader_context;
+
+	libcerror_error_t *error             = NULL;
+	libpff_io_handle_t *io_handle        = NULL;
+	libpff_io_handle_t *parent_io_handle = NULL;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_io_handle_initialize(
+	          &parent_io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "parent_io_handle",
+	 parent_io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_set(
+	 &reader_context,
+	 0,
+	 sizeof( libpff_reader_context_t ) );
+
+	parent_io_handle->read_size             = 1024;
+	parent_io_handle->number_of_read_blocks = 2;
+
+	io_handle->read_size             = 5120;
+	io_handle->number_of_read_blocks = 5;
+	io_handle->flags                 = LIBPFF_IO_HANDLE_FLAG_IS_CORRUPTED;
+
+	reader_context.parent_io_handle              = parent_io_handle;
+	reader_context.io_handle                     = io_handle;
+	reader_context.initial_read_size             = 1024;
+	reader_context.initial_number_of_read_blocks = 2;
+
+	/* Test regular cases
+	 */
+	result = libpff_reader_context_merge_read_state(
+	          &reader_context,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "parent_io_handle->read_size",
+	 (uint64_t) parent_io_handle->read_size,
+	 (uint64_t) 5120 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT32(
+	 "parent_io_handle->number_of_read_blocks",
+	 parent_io_handle->number_of_read_blocks,
+	 (uint32_t) 5 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "parent_io_handle->flags",
+	 parent_io_handle->flags,
+	 (uint8_t) LIBPFF_IO_HANDLE_FLAG_IS_CORRUPTED );
+
+	/* Test that a second merge does not count the same reads twice
+	 */
+	result = libpff_reader_context_merge_read_state(
+	          &reader_context,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "parent_io_handle->read_size",
+	 (uint64_t) parent_io_handle->read_size,
+	 (uint64_t) 5120 );
+
+	/* Test error cases
+	 */
+	result = libpff_reader_context_merge_read_state(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	reader_context.io_handle = NULL;
+
+	result = libpff_reader_context_merge_read_state(
+	          &reader_context,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_io_handle_free(
+	          &parent_io_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "parent_io_handle",
+	 parent_io_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_handle != NULL )
+	{
+		libpff_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	if( parent_io_handle != NULL )
+	{
+		libpff_io_handle_free(
+		 &parent_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PFF_TEST_UNREFERENCED_PARAMETER( argc )
+	PFF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+	PFF_TEST_RUN(
+	 "libpff_reader_context_initialize",
+	 pff_test_reader_context_initialize );
+
+	PFF_TEST_RUN(
+	 "libpff_reader_context_free",
+	 pff_test_reader_context_free );
+
+	PFF_TEST_RUN(
+	 "libpff_reader_context_merge_read_state",
+	 pff_test_reader_context_merge_read_state );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+}
+
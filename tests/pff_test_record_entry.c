@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -33,8 +34,21 @@
 #include "pff_test_memory.h"
 #include "pff_test_unused.h"
 
+#include "../libpff/libpff_mapi.h"
 #include "../libpff/libpff_record_entry.h"
 
+/* A conversation index with a header block and 2 child blocks
+ */
+uint8_t pff_test_record_entry_conversation_index_data1[ 32 ] = {
+	0x01, 0xd7, 0x12, 0x34, 0x56, 0x78, 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99,
+	0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff, 0x00, 0x00, 0x00, 0x01, 0x25, 0x80, 0x00, 0x00, 0x02, 0x13 };
+
+/* A message store entry identifier
+ */
+uint8_t pff_test_record_entry_entry_identifier_data1[ 24 ] = {
+	0x00, 0x00, 0x00, 0x00, 0x5d, 0x6d, 0x2f, 0x9d, 0x8c, 0x3e, 0x4b, 0x48, 0x8f, 0x5e, 0x0d, 0x9c,
+	0x1a, 0x25, 0xe7, 0x83, 0x24, 0x00, 0x20, 0x00 };
+
 #if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
 
 /* Tests the libpff_record_entry_initialize function
@@ -1062,27 +1076,43 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libpff_record_entry_get_data function
+/* Tests the libpff_record_entry_set_value_data_list function
  * Returns 1 if successful or 0 if not
  */
-int pff_test_record_entry_get_data(
-     libpff_record_entry_t *record_entry )
+int pff_test_record_entry_set_value_data_list(
+     void )
 {
-	uint8_t data[ 32 ];
-
-	libcerror_error_t *error = NULL;
-	int result               = 0;
+	libcerror_error_t *error            = NULL;
+	libpff_record_entry_t *record_entry = NULL;
+	int result                          = 0;
 
-	/* Test regular cases
+	/* Initialize test
 	 */
-/* TODO implement */
+	result = libpff_record_entry_initialize(
+	          &record_entry,
+	          LIBPFF_CODEPAGE_WINDOWS_1251,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "record_entry",
+	 record_entry );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	/* Test error cases
 	 */
-	result = libpff_record_entry_get_data(
+	result = libpff_record_entry_set_value_data_list(
+	          NULL,
+	          NULL,
+	          NULL,
 	          NULL,
-	          data,
-	          32,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -1097,10 +1127,11 @@ int pff_test_record_entry_get_data(
 	libcerror_error_free(
 	 &error );
 
-	result = libpff_record_entry_get_data(
+	result = libpff_record_entry_set_value_data_list(
 	          record_entry,
 	          NULL,
-	          32,
+	          NULL,
+	          NULL,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -1115,10 +1146,28 @@ int pff_test_record_entry_get_data(
 	libcerror_error_free(
 	 &error );
 
-	result = libpff_record_entry_get_data(
+	/* Test error case where value data is already set
+	 */
+	result = libpff_record_entry_set_value_data(
 	          record_entry,
-	          data,
-	          (size_t) SSIZE_MAX + 1,
+	          (uint8_t *) "test value",
+	          11,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_record_entry_set_value_data_list(
+	          record_entry,
+	          NULL,
+	          NULL,
+	          NULL,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -1133,6 +1182,25 @@ int pff_test_record_entry_get_data(
 	libcerror_error_free(
 	 &error );
 
+	/* Clean up
+	 */
+	result = libpff_internal_record_entry_free(
+	          (libpff_internal_record_entry_t **) &record_entry,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "record_entry",
+	 record_entry );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	return( 1 );
 
 on_error:
@@ -1141,28 +1209,50 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( record_entry != NULL )
+	{
+		libpff_internal_record_entry_free(
+		 (libpff_internal_record_entry_t **) &record_entry,
+		 NULL );
+	}
 	return( 0 );
 }
 
-/* Tests the libpff_record_entry_get_data_as_boolean function
+/* Tests the libpff_record_entry_get_value_data_stream function
  * Returns 1 if successful or 0 if not
  */
-int pff_test_record_entry_get_data_as_boolean(
+int pff_test_record_entry_get_value_data_stream(
      libpff_record_entry_t *record_entry )
 {
-	libcerror_error_t *error = NULL;
-	uint8_t value_boolean    = 0;
-	int result               = 0;
+	libcerror_error_t *error             = NULL;
+	libfdata_stream_t *value_data_stream = NULL;
+	int result                           = 0;
 
 	/* Test regular cases
 	 */
-/* TODO implement */
+	result = libpff_record_entry_get_value_data_stream(
+	          record_entry,
+	          &value_data_stream,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "value_data_stream",
+	 value_data_stream );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	/* Test error cases
 	 */
-	result = libpff_record_entry_get_data_as_boolean(
+	result = libpff_record_entry_get_value_data_stream(
 	          NULL,
-	          &value_boolean,
+	          &value_data_stream,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -1177,7 +1267,7 @@ int pff_test_record_entry_get_data_as_boolean(
 	libcerror_error_free(
 	 &error );
 
-	result = libpff_record_entry_get_data_as_boolean(
+	result = libpff_record_entry_get_value_data_stream(
 	          record_entry,
 	          NULL,
 	          &error );
@@ -1205,14 +1295,15 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libpff_record_entry_get_data_as_16bit_integer function
+/* Tests the libpff_record_entry_get_data function
  * Returns 1 if successful or 0 if not
  */
-int pff_test_record_entry_get_data_as_16bit_integer(
+int pff_test_record_entry_get_data(
      libpff_record_entry_t *record_entry )
 {
+	uint8_t data[ 32 ];
+
 	libcerror_error_t *error = NULL;
-	uint16_t value_16bit     = 0;
 	int result               = 0;
 
 	/* Test regular cases
@@ -1221,9 +1312,10 @@ int pff_test_record_entry_get_data_as_16bit_integer(
 
 	/* Test error cases
 	 */
-	result = libpff_record_entry_get_data_as_16bit_integer(
+	result = libpff_record_entry_get_data(
 	          NULL,
-	          &value_16bit,
+	          data,
+	          32,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -1238,9 +1330,28 @@ int pff_test_record_entry_get_data_as_16bit_integer(
 	libcerror_error_free(
 	 &error );
 
-	result = libpff_record_entry_get_data_as_16bit_integer(
+	result = libpff_record_entry_get_data(
 	          record_entry,
 	          NULL,
+	          32,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_record_entry_get_data(
+	          record_entry,
+	          data,
+	          (size_t) SSIZE_MAX + 1,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -1263,34 +1374,62 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( record_entry != NULL )
-	{
-		libpff_internal_record_entry_free(
-		 (libpff_internal_record_entry_t **) &record_entry,
-		 NULL );
-	}
 	return( 0 );
 }
 
-/* Tests the libpff_record_entry_get_data_as_32bit_integer function
+/* Tests the libpff_record_entry_get_data_pointer function
  * Returns 1 if successful or 0 if not
  */
-int pff_test_record_entry_get_data_as_32bit_integer(
+int pff_test_record_entry_get_data_pointer(
      libpff_record_entry_t *record_entry )
 {
 	libcerror_error_t *error = NULL;
-	uint32_t value_32bit     = 0;
+	const uint8_t *data      = NULL;
+	size_t data_size         = 0;
 	int result               = 0;
 
 	/* Test regular cases
 	 */
-/* TODO implement */
+	result = libpff_record_entry_get_data_pointer(
+	          record_entry,
+	          &data,
+	          &data_size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	PFF_TEST_ASSERT_EQUAL_SIZE(
+	 "data_size",
+	 data_size,
+	 (size_t) 11 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          "test value",
+	          11 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
 
 	/* Test error cases
 	 */
-	result = libpff_record_entry_get_data_as_32bit_integer(
+	result = libpff_record_entry_get_data_pointer(
 	          NULL,
-	          &value_32bit,
+	          &data,
+	          &data_size,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -1305,8 +1444,27 @@ int pff_test_record_entry_get_data_as_32bit_integer(
 	libcerror_error_free(
 	 &error );
 
-	result = libpff_record_entry_get_data_as_32bit_integer(
+	result = libpff_record_entry_get_data_pointer(
+	          record_entry,
+	          NULL,
+	          &data_size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_record_entry_get_data_pointer(
 	          record_entry,
+	          &data,
 	          NULL,
 	          &error );
 
@@ -1333,14 +1491,14 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libpff_record_entry_get_data_as_64bit_integer function
+/* Tests the libpff_record_entry_get_data_as_boolean function
  * Returns 1 if successful or 0 if not
  */
-int pff_test_record_entry_get_data_as_64bit_integer(
+int pff_test_record_entry_get_data_as_boolean(
      libpff_record_entry_t *record_entry )
 {
 	libcerror_error_t *error = NULL;
-	uint64_t value_64bit     = 0;
+	uint8_t value_boolean    = 0;
 	int result               = 0;
 
 	/* Test regular cases
@@ -1349,9 +1507,9 @@ int pff_test_record_entry_get_data_as_64bit_integer(
 
 	/* Test error cases
 	 */
-	result = libpff_record_entry_get_data_as_64bit_integer(
+	result = libpff_record_entry_get_data_as_boolean(
 	          NULL,
-	          &value_64bit,
+	          &value_boolean,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -1366,7 +1524,7 @@ int pff_test_record_entry_get_data_as_64bit_integer(
 	libcerror_error_free(
 	 &error );
 
-	result = libpff_record_entry_get_data_as_64bit_integer(
+	result = libpff_record_entry_get_data_as_boolean(
 	          record_entry,
 	          NULL,
 	          &error );
@@ -1394,14 +1552,14 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libpff_record_entry_get_data_as_filetime function
+/* Tests the libpff_record_entry_get_data_as_16bit_integer function
  * Returns 1 if successful or 0 if not
  */
-int pff_test_record_entry_get_data_as_filetime(
+int pff_test_record_entry_get_data_as_16bit_integer(
      libpff_record_entry_t *record_entry )
 {
 	libcerror_error_t *error = NULL;
-	uint64_t filetime        = 0;
+	uint16_t value_16bit     = 0;
 	int result               = 0;
 
 	/* Test regular cases
@@ -1410,9 +1568,9 @@ int pff_test_record_entry_get_data_as_filetime(
 
 	/* Test error cases
 	 */
-	result = libpff_record_entry_get_data_as_filetime(
+	result = libpff_record_entry_get_data_as_16bit_integer(
 	          NULL,
-	          &filetime,
+	          &value_16bit,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -1427,7 +1585,7 @@ int pff_test_record_entry_get_data_as_filetime(
 	libcerror_error_free(
 	 &error );
 
-	result = libpff_record_entry_get_data_as_filetime(
+	result = libpff_record_entry_get_data_as_16bit_integer(
 	          record_entry,
 	          NULL,
 	          &error );
@@ -1452,17 +1610,23 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( record_entry != NULL )
+	{
+		libpff_internal_record_entry_free(
+		 (libpff_internal_record_entry_t **) &record_entry,
+		 NULL );
+	}
 	return( 0 );
 }
 
-/* Tests the libpff_record_entry_get_data_as_floatingtime function
+/* Tests the libpff_record_entry_get_data_as_32bit_integer function
  * Returns 1 if successful or 0 if not
  */
-int pff_test_record_entry_get_data_as_floatingtime(
+int pff_test_record_entry_get_data_as_32bit_integer(
      libpff_record_entry_t *record_entry )
 {
 	libcerror_error_t *error = NULL;
-	uint64_t floatingtime    = 0;
+	uint32_t value_32bit     = 0;
 	int result               = 0;
 
 	/* Test regular cases
@@ -1471,9 +1635,9 @@ int pff_test_record_entry_get_data_as_floatingtime(
 
 	/* Test error cases
 	 */
-	result = libpff_record_entry_get_data_as_floatingtime(
+	result = libpff_record_entry_get_data_as_32bit_integer(
 	          NULL,
-	          &floatingtime,
+	          &value_32bit,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -1488,7 +1652,7 @@ int pff_test_record_entry_get_data_as_floatingtime(
 	libcerror_error_free(
 	 &error );
 
-	result = libpff_record_entry_get_data_as_floatingtime(
+	result = libpff_record_entry_get_data_as_32bit_integer(
 	          record_entry,
 	          NULL,
 	          &error );
@@ -1516,14 +1680,14 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libpff_record_entry_get_data_as_size function
+/* Tests the libpff_record_entry_get_data_as_64bit_integer function
  * Returns 1 if successful or 0 if not
  */
-int pff_test_record_entry_get_data_as_size(
+int pff_test_record_entry_get_data_as_64bit_integer(
      libpff_record_entry_t *record_entry )
 {
 	libcerror_error_t *error = NULL;
-	size64_t value_size      = 0;
+	uint64_t value_64bit     = 0;
 	int result               = 0;
 
 	/* Test regular cases
@@ -1532,9 +1696,9 @@ int pff_test_record_entry_get_data_as_size(
 
 	/* Test error cases
 	 */
-	result = libpff_record_entry_get_data_as_size(
+	result = libpff_record_entry_get_data_as_64bit_integer(
 	          NULL,
-	          &value_size,
+	          &value_64bit,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -1549,7 +1713,7 @@ int pff_test_record_entry_get_data_as_size(
 	libcerror_error_free(
 	 &error );
 
-	result = libpff_record_entry_get_data_as_size(
+	result = libpff_record_entry_get_data_as_64bit_integer(
 	          record_entry,
 	          NULL,
 	          &error );
@@ -1577,7 +1741,190 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libpff_record_entry_get_data_as_floating_point function
+/* Tests the libpff_record_entry_get_data_as_filetime function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_record_entry_get_data_as_filetime(
+     libpff_record_entry_t *record_entry )
+{
+	libcerror_error_t *error = NULL;
+	uint64_t filetime        = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+/* TODO implement */
+
+	/* Test error cases
+	 */
+	result = libpff_record_entry_get_data_as_filetime(
+	          NULL,
+	          &filetime,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_record_entry_get_data_as_filetime(
+	          record_entry,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_record_entry_get_data_as_floatingtime function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_record_entry_get_data_as_floatingtime(
+     libpff_record_entry_t *record_entry )
+{
+	libcerror_error_t *error = NULL;
+	uint64_t floatingtime    = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+/* TODO implement */
+
+	/* Test error cases
+	 */
+	result = libpff_record_entry_get_data_as_floatingtime(
+	          NULL,
+	          &floatingtime,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_record_entry_get_data_as_floatingtime(
+	          record_entry,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_record_entry_get_data_as_size function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_record_entry_get_data_as_size(
+     libpff_record_entry_t *record_entry )
+{
+	libcerror_error_t *error = NULL;
+	size64_t value_size      = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+/* TODO implement */
+
+	/* Test error cases
+	 */
+	result = libpff_record_entry_get_data_as_size(
+	          NULL,
+	          &value_size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_record_entry_get_data_as_size(
+	          record_entry,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_record_entry_get_data_as_floating_point function
  * Returns 1 if successful or 0 if not
  */
 int pff_test_record_entry_get_data_as_floating_point(
@@ -2430,69 +2777,19 @@ on_error:
 	return( 0 );
 }
 
-#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
-
-/* The main program
+/* Tests the libpff_record_entry_get_data_as_conversation_index_header function
+ * Returns 1 if successful or 0 if not
  */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-int wmain(
-     int argc PFF_TEST_ATTRIBUTE_UNUSED,
-     wchar_t * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
-#else
-int main(
-     int argc PFF_TEST_ATTRIBUTE_UNUSED,
-     char * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
-#endif
+int pff_test_record_entry_get_data_as_conversation_index_header(
+     void )
 {
-#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
-#if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
+	uint8_t guid_data[ 16 ];
 
 	libcerror_error_t *error            = NULL;
 	libpff_record_entry_t *record_entry = NULL;
+	uint64_t filetime                   = 0;
 	int result                          = 0;
 
-#endif /* !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 ) */
-#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
-
-	PFF_TEST_UNREFERENCED_PARAMETER( argc )
-	PFF_TEST_UNREFERENCED_PARAMETER( argv )
-
-#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
-
-	PFF_TEST_RUN(
-	 "libpff_record_entry_initialize",
-	 pff_test_record_entry_initialize );
-
-#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
-
-	PFF_TEST_RUN(
-	 "libpff_record_entry_free",
-	 pff_test_record_entry_free );
-
-#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
-
-	PFF_TEST_RUN(
-	 "libpff_internal_record_entry_free",
-	 pff_test_internal_record_entry_free );
-
-	PFF_TEST_RUN(
-	 "libpff_record_entry_clone",
-	 pff_test_record_entry_clone );
-
-	PFF_TEST_RUN(
-	 "libpff_record_entry_set_value_data",
-	 pff_test_record_entry_set_value_data );
-
-	/* TODO: add tests for libpff_record_entry_set_value_data_from_list */
-
-	/* TODO: add tests for libpff_record_entry_set_value_data_from_stream */
-
-	/* TODO: add tests for libpff_record_entry_read_buffer */
-
-	/* TODO: add tests for libpff_record_entry_seek_offset */
-
-#if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
-
 	/* Initialize test
 	 */
 	result = libpff_record_entry_initialize(
@@ -2513,10 +2810,12 @@ int main(
 	 "error",
 	 error );
 
+	( (libpff_internal_record_entry_t *) record_entry )->identifier.value_type = LIBPFF_VALUE_TYPE_BINARY_DATA;
+
 	result = libpff_record_entry_set_value_data(
 	          record_entry,
-	          (uint8_t *) "test value",
-	          11,
+	          pff_test_record_entry_conversation_index_data1,
+	          32,
 	          &error );
 
 	PFF_TEST_ASSERT_EQUAL_INT(
@@ -2528,15 +2827,873 @@ int main(
 	 "error",
 	 error );
 
-	PFF_TEST_RUN_WITH_ARGS(
-	 "libpff_record_entry_get_entry_type",
-	 pff_test_record_entry_get_entry_type,
-	 record_entry );
-
-	PFF_TEST_RUN_WITH_ARGS(
-	 "libpff_record_entry_get_value_type",
-	 pff_test_record_entry_get_value_type,
-	 record_entry );
+	/* Test regular cases
+	 */
+	result = libpff_record_entry_get_data_as_conversation_index_header(
+	          record_entry,
+	          &filetime,
+	          guid_data,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "filetime",
+	 filetime,
+	 (uint64_t) 0x01d7123456780000UL );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_record_entry_get_data_as_conversation_index_header(
+	          NULL,
+	          &filetime,
+	          guid_data,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_record_entry_get_data_as_conversation_index_header(
+	          record_entry,
+	          NULL,
+	          guid_data,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_record_entry_get_data_as_conversation_index_header(
+	          record_entry,
+	          &filetime,
+	          NULL,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_internal_record_entry_free(
+	          (libpff_internal_record_entry_t **) &record_entry,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "record_entry",
+	 record_entry );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( record_entry != NULL )
+	{
+		libpff_internal_record_entry_free(
+		 (libpff_internal_record_entry_t **) &record_entry,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_record_entry_get_data_as_conversation_index_number_of_child_blocks function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_record_entry_get_data_as_conversation_index_number_of_child_blocks(
+     void )
+{
+	libcerror_error_t *error            = NULL;
+	libpff_record_entry_t *record_entry = NULL;
+	int number_of_child_blocks          = 0;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_record_entry_initialize(
+	          &record_entry,
+	          LIBPFF_CODEPAGE_WINDOWS_1251,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "record_entry",
+	 record_entry );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	( (libpff_internal_record_entry_t *) record_entry )->identifier.value_type = LIBPFF_VALUE_TYPE_BINARY_DATA;
+
+	result = libpff_record_entry_set_value_data(
+	          record_entry,
+	          pff_test_record_entry_conversation_index_data1,
+	          32,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libpff_record_entry_get_data_as_conversation_index_number_of_child_blocks(
+	          record_entry,
+	          &number_of_child_blocks,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_child_blocks",
+	 number_of_child_blocks,
+	 2 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_record_entry_get_data_as_conversation_index_number_of_child_blocks(
+	          NULL,
+	          &number_of_child_blocks,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_record_entry_get_data_as_conversation_index_number_of_child_blocks(
+	          record_entry,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_internal_record_entry_free(
+	          (libpff_internal_record_entry_t **) &record_entry,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "record_entry",
+	 record_entry );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( record_entry != NULL )
+	{
+		libpff_internal_record_entry_free(
+		 (libpff_internal_record_entry_t **) &record_entry,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_record_entry_get_data_as_conversation_index_child_block function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_record_entry_get_data_as_conversation_index_child_block(
+     void )
+{
+	libcerror_error_t *error            = NULL;
+	libpff_record_entry_t *record_entry = NULL;
+	uint64_t time_delta                 = 0;
+	uint8_t random_number               = 0;
+	uint8_t sequence_count              = 0;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_record_entry_initialize(
+	          &record_entry,
+	          LIBPFF_CODEPAGE_WINDOWS_1251,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "record_entry",
+	 record_entry );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	( (libpff_internal_record_entry_t *) record_entry )->identifier.value_type = LIBPFF_VALUE_TYPE_BINARY_DATA;
+
+	result = libpff_record_entry_set_value_data(
+	          record_entry,
+	          pff_test_record_entry_conversation_index_data1,
+	          32,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libpff_record_entry_get_data_as_conversation_index_child_block(
+	          record_entry,
+	          1,
+	          &time_delta,
+	          &random_number,
+	          &sequence_count,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "time_delta",
+	 time_delta,
+	 (uint64_t) 0x0000000001000000UL );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "random_number",
+	 random_number,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "sequence_count",
+	 sequence_count,
+	 3 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_record_entry_get_data_as_conversation_index_child_block(
+	          NULL,
+	          0,
+	          &time_delta,
+	          &random_number,
+	          &sequence_count,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_record_entry_get_data_as_conversation_index_child_block(
+	          record_entry,
+	          2,
+	          &time_delta,
+	          &random_number,
+	          &sequence_count,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_record_entry_get_data_as_conversation_index_child_block(
+	          record_entry,
+	          0,
+	          NULL,
+	          &random_number,
+	          &sequence_count,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_internal_record_entry_free(
+	          (libpff_internal_record_entry_t **) &record_entry,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "record_entry",
+	 record_entry );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( record_entry != NULL )
+	{
+		libpff_internal_record_entry_free(
+		 (libpff_internal_record_entry_t **) &record_entry,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_record_entry_get_data_as_entry_identifier function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_record_entry_get_data_as_entry_identifier(
+     void )
+{
+	uint8_t service_provider_identifier[ 16 ];
+
+	libcerror_error_t *error            = NULL;
+	libpff_record_entry_t *record_entry = NULL;
+	uint32_t flags                      = 0;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_record_entry_initialize(
+	          &record_entry,
+	          LIBPFF_CODEPAGE_WINDOWS_1251,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "record_entry",
+	 record_entry );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	( (libpff_internal_record_entry_t *) record_entry )->identifier.value_type = LIBPFF_VALUE_TYPE_BINARY_DATA;
+
+	result = libpff_record_entry_set_value_data(
+	          record_entry,
+	          pff_test_record_entry_entry_identifier_data1,
+	          24,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libpff_record_entry_get_data_as_entry_identifier(
+	          record_entry,
+	          &flags,
+	          service_provider_identifier,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT32(
+	 "flags",
+	 flags,
+	 (uint32_t) 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_record_entry_get_data_as_entry_identifier(
+	          NULL,
+	          &flags,
+	          service_provider_identifier,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_record_entry_get_data_as_entry_identifier(
+	          record_entry,
+	          NULL,
+	          service_provider_identifier,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_record_entry_get_data_as_entry_identifier(
+	          record_entry,
+	          &flags,
+	          NULL,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_internal_record_entry_free(
+	          (libpff_internal_record_entry_t **) &record_entry,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "record_entry",
+	 record_entry );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( record_entry != NULL )
+	{
+		libpff_internal_record_entry_free(
+		 (libpff_internal_record_entry_t **) &record_entry,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_record_entry_get_data_as_item_identifier function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_record_entry_get_data_as_item_identifier(
+     void )
+{
+	libcerror_error_t *error            = NULL;
+	libpff_record_entry_t *record_entry = NULL;
+	uint32_t item_identifier            = 0;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_record_entry_initialize(
+	          &record_entry,
+	          LIBPFF_CODEPAGE_WINDOWS_1251,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "record_entry",
+	 record_entry );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	( (libpff_internal_record_entry_t *) record_entry )->identifier.value_type = LIBPFF_VALUE_TYPE_BINARY_DATA;
+
+	result = libpff_record_entry_set_value_data(
+	          record_entry,
+	          pff_test_record_entry_entry_identifier_data1,
+	          24,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libpff_record_entry_get_data_as_item_identifier(
+	          record_entry,
+	          &( pff_test_record_entry_entry_identifier_data1[ 4 ] ),
+	          16,
+	          &item_identifier,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT32(
+	 "item_identifier",
+	 item_identifier,
+	 (uint32_t) 0x00200024UL );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_record_entry_get_data_as_item_identifier(
+	          NULL,
+	          &( pff_test_record_entry_entry_identifier_data1[ 4 ] ),
+	          16,
+	          &item_identifier,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_record_entry_get_data_as_item_identifier(
+	          record_entry,
+	          &( pff_test_record_entry_entry_identifier_data1[ 4 ] ),
+	          16,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_internal_record_entry_free(
+	          (libpff_internal_record_entry_t **) &record_entry,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "record_entry",
+	 record_entry );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( record_entry != NULL )
+	{
+		libpff_internal_record_entry_free(
+		 (libpff_internal_record_entry_t **) &record_entry,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+#if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
+
+	libcerror_error_t *error            = NULL;
+	libpff_record_entry_t *record_entry = NULL;
+	int result                          = 0;
+
+#endif /* !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 ) */
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+	PFF_TEST_UNREFERENCED_PARAMETER( argc )
+	PFF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+	PFF_TEST_RUN(
+	 "libpff_record_entry_initialize",
+	 pff_test_record_entry_initialize );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+	PFF_TEST_RUN(
+	 "libpff_record_entry_free",
+	 pff_test_record_entry_free );
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+	PFF_TEST_RUN(
+	 "libpff_internal_record_entry_free",
+	 pff_test_internal_record_entry_free );
+
+	PFF_TEST_RUN(
+	 "libpff_record_entry_clone",
+	 pff_test_record_entry_clone );
+
+	PFF_TEST_RUN(
+	 "libpff_record_entry_set_value_data",
+	 pff_test_record_entry_set_value_data );
+
+	/* TODO: add tests for libpff_record_entry_set_value_data_from_list */
+
+	/* TODO: add tests for libpff_record_entry_set_value_data_from_stream */
+
+	PFF_TEST_RUN(
+	 "libpff_record_entry_set_value_data_list",
+	 pff_test_record_entry_set_value_data_list );
+
+	/* TODO: add tests for libpff_record_entry_read_buffer */
+
+	/* TODO: add tests for libpff_record_entry_seek_offset */
+
+#if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
+
+	/* Initialize test
+	 */
+	result = libpff_record_entry_initialize(
+	          &record_entry,
+	          LIBPFF_CODEPAGE_WINDOWS_1251,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "record_entry",
+	 record_entry );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_record_entry_set_value_data(
+	          record_entry,
+	          (uint8_t *) "test value",
+	          11,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_RUN_WITH_ARGS(
+	 "libpff_record_entry_get_entry_type",
+	 pff_test_record_entry_get_entry_type,
+	 record_entry );
+
+	PFF_TEST_RUN_WITH_ARGS(
+	 "libpff_record_entry_get_value_type",
+	 pff_test_record_entry_get_value_type,
+	 record_entry );
 
 	PFF_TEST_RUN_WITH_ARGS(
 	 "libpff_record_entry_get_name_to_id_map_entry",
@@ -2553,11 +3710,21 @@ int main(
 	 pff_test_record_entry_get_value_data,
 	 record_entry );
 
+	PFF_TEST_RUN_WITH_ARGS(
+	 "libpff_record_entry_get_value_data_stream",
+	 pff_test_record_entry_get_value_data_stream,
+	 record_entry );
+
 	PFF_TEST_RUN_WITH_ARGS(
 	 "libpff_record_entry_get_data",
 	 pff_test_record_entry_get_data,
 	 record_entry );
 
+	PFF_TEST_RUN_WITH_ARGS(
+	 "libpff_record_entry_get_data_pointer",
+	 pff_test_record_entry_get_data_pointer,
+	 record_entry );
+
 	PFF_TEST_RUN_WITH_ARGS(
 	 "libpff_record_entry_get_data_as_boolean",
 	 pff_test_record_entry_get_data_as_boolean,
@@ -2636,6 +3803,26 @@ int main(
 	 "libpff_record_entry_get_data_as_guid",
 	 pff_test_record_entry_get_data_as_guid );
 
+	PFF_TEST_RUN(
+	 "libpff_record_entry_get_data_as_conversation_index_header",
+	 pff_test_record_entry_get_data_as_conversation_index_header );
+
+	PFF_TEST_RUN(
+	 "libpff_record_entry_get_data_as_conversation_index_number_of_child_blocks",
+	 pff_test_record_entry_get_data_as_conversation_index_number_of_child_blocks );
+
+	PFF_TEST_RUN(
+	 "libpff_record_entry_get_data_as_conversation_index_child_block",
+	 pff_test_record_entry_get_data_as_conversation_index_child_block );
+
+	PFF_TEST_RUN(
+	 "libpff_record_entry_get_data_as_entry_identifier",
+	 pff_test_record_entry_get_data_as_entry_identifier );
+
+	PFF_TEST_RUN(
+	 "libpff_record_entry_get_data_as_item_identifier",
+	 pff_test_record_entry_get_data_as_item_identifier );
+
 	/* TODO: add tests for libpff_record_entry_copy_object_identifier */
 
 	/* TODO: add tests for libpff_record_entry_get_multi_value */
@@ -0,0 +1,744 @@
+/*
+ * Library recovered_index type test program
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "pff_test_libcerror.h"
+#include "pff_test_libpff.h"
+#include "pff_test_macros.h"
+#include "pff_test_memory.h"
+#include "pff_test_unused.h"
+
+#include "../libpff/libpff_definitions.h"
+#include "../libpff/libpff_index_value.h"
+#include "../libpff/libpff_recovered_index.h"
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+/* The number of index values used by the tests, chosen so that
+ * the index values are sorted by multiple threads if available
+ */
+#define PFF_TEST_RECOVERED_INDEX_NUMBER_OF_VALUES	20000
+
+/* The number of distinct identifiers used by the tests
+ */
+#define PFF_TEST_RECOVERED_INDEX_NUMBER_OF_IDENTIFIERS	5000
+
+/* Tests the libpff_recovered_index_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_recovered_index_initialize(
+     void )
+{
+	libcerror_error_t *error                  = NULL;
+	libpff_recovered_index_t *recovered_index = NULL;
+	int result                                = 0;
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+	int number_of_malloc_fail_tests           = 1;
+	int number_of_memset_fail_tests           = 1;
+	int test_number                           = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libpff_recovered_index_initialize(
+	          &recovered_index,
+	          LIBPFF_INDEX_TYPE_DESCRIPTOR,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "recovered_index",
+	 recovered_index );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_recovered_index_free(
+	          &recovered_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "recovered_index",
+	 recovered_index );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_recovered_index_initialize(
+	          NULL,
+	          LIBPFF_INDEX_TYPE_DESCRIPTOR,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	recovered_index = (libpff_recovered_index_t *) 0x12345678UL;
+
+	result = libpff_recovered_index_initialize(
+	          &recovered_index,
+	          LIBPFF_INDEX_TYPE_DESCRIPTOR,
+	          &error );
+
+	recovered_index = NULL;
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_recovered_index_initialize(
+	          &recovered_index,
+	          0xff,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libpff_recovered_index_initialize with malloc failing
+		 */
+		pff_test_malloc_attempts_before_fail = test_number;
+
+		result = libpff_recovered_index_initialize(
+		          &recovered_index,
+		          LIBPFF_INDEX_TYPE_DESCRIPTOR,
+		          &error );
+
+		if( pff_test_malloc_attempts_before_fail != -1 )
+		{
+			pff_test_malloc_attempts_before_fail = -1;
+
+			if( recovered_index != NULL )
+			{
+				libpff_recovered_index_free(
+				 &recovered_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "recovered_index",
+			 recovered_index );
+
+			PFF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libpff_recovered_index_initialize with memset failing
+		 */
+		pff_test_memset_attempts_before_fail = test_number;
+
+		result = libpff_recovered_index_initialize(
+		          &recovered_index,
+		          LIBPFF_INDEX_TYPE_DESCRIPTOR,
+		          &error );
+
+		if( pff_test_memset_attempts_before_fail != -1 )
+		{
+			pff_test_memset_attempts_before_fail = -1;
+
+			if( recovered_index != NULL )
+			{
+				libpff_recovered_index_free(
+				 &recovered_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "recovered_index",
+			 recovered_index );
+
+			PFF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_PFF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( recovered_index != NULL )
+	{
+		libpff_recovered_index_free(
+		 &recovered_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_recovered_index_free function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_recovered_index_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libpff_recovered_index_free(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests appending, finalizing and retrieving index values
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_recovered_index_finalize(
+     void )
+{
+	libpff_index_value_t index_value;
+
+	libcerror_error_t *error                  = NULL;
+	libpff_index_value_t *found_index_value   = NULL;
+	libpff_index_value_t *last_index_value    = NULL;
+	libpff_recovered_index_t *recovered_index = NULL;
+	int number_of_index_values                = 0;
+	int result                                = 0;
+	int value_index                           = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_recovered_index_initialize(
+	          &recovered_index,
+	          LIBPFF_INDEX_TYPE_DESCRIPTOR,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "recovered_index",
+	 recovered_index );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Append the index values in a scattered order, every identifier is
+	 * appended multiple times with an increasing data identifier
+	 */
+	memory_set(
+	 &index_value,
+	 0,
+	 sizeof( libpff_index_value_t ) );
+
+	for( value_index = 0;
+	     value_index < PFF_TEST_RECOVERED_INDEX_NUMBER_OF_VALUES;
+	     value_index++ )
+	{
+		index_value.identifier      = ( ( (uint64_t) value_index * 7919 ) % PFF_TEST_RECOVERED_INDEX_NUMBER_OF_IDENTIFIERS ) + 1;
+		index_value.data_identifier = (uint64_t) value_index;
+
+		result = libpff_recovered_index_append_index_value(
+		          recovered_index,
+		          &index_value,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test libpff_recovered_index_has_index_value before finalize
+	 */
+	index_value.identifier      = ( 7919 % PFF_TEST_RECOVERED_INDEX_NUMBER_OF_IDENTIFIERS ) + 1;
+	index_value.data_identifier = 1;
+
+	result = libpff_recovered_index_has_index_value(
+	          recovered_index,
+	          &index_value,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	index_value.data_identifier = PFF_TEST_RECOVERED_INDEX_NUMBER_OF_VALUES;
+
+	result = libpff_recovered_index_has_index_value(
+	          recovered_index,
+	          &index_value,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test libpff_recovered_index_finalize
+	 */
+	result = libpff_recovered_index_finalize(
+	          recovered_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_recovered_index_get_number_of_index_values(
+	          recovered_index,
+	          &number_of_index_values,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_index_values",
+	 number_of_index_values,
+	 PFF_TEST_RECOVERED_INDEX_NUMBER_OF_VALUES );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The index values are sorted by identifier and index values with
+	 * the same identifier are kept in the order they were appended
+	 */
+	for( value_index = 0;
+	     value_index < number_of_index_values;
+	     value_index++ )
+	{
+		result = libpff_recovered_index_get_index_value_by_index(
+		          recovered_index,
+		          value_index,
+		          &found_index_value,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( last_index_value != NULL )
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "index_values_are_sorted",
+			 (int) ( last_index_value->identifier <= found_index_value->identifier ),
+			 1 );
+
+			if( last_index_value->identifier == found_index_value->identifier )
+			{
+				PFF_TEST_ASSERT_LESS_THAN_UINT64(
+				 "last_index_value->data_identifier",
+				 last_index_value->data_identifier,
+				 found_index_value->data_identifier );
+			}
+		}
+		last_index_value = found_index_value;
+	}
+	/* Test libpff_recovered_index_get_number_of_index_values_by_identifier
+	 */
+	result = libpff_recovered_index_get_number_of_index_values_by_identifier(
+	          recovered_index,
+	          1,
+	          &number_of_index_values,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_index_values",
+	 number_of_index_values,
+	 PFF_TEST_RECOVERED_INDEX_NUMBER_OF_VALUES / PFF_TEST_RECOVERED_INDEX_NUMBER_OF_IDENTIFIERS );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_recovered_index_get_number_of_index_values_by_identifier(
+	          recovered_index,
+	          PFF_TEST_RECOVERED_INDEX_NUMBER_OF_IDENTIFIERS + 1,
+	          &number_of_index_values,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_index_values",
+	 number_of_index_values,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test libpff_recovered_index_get_index_value_by_identifier
+	 */
+	result = libpff_recovered_index_get_index_value_by_identifier(
+	          recovered_index,
+	          1,
+	          1,
+	          &found_index_value,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "found_index_value->identifier",
+	 found_index_value->identifier,
+	 (uint64_t) 1 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "found_index_value->data_identifier",
+	 found_index_value->data_identifier,
+	 (uint64_t) PFF_TEST_RECOVERED_INDEX_NUMBER_OF_IDENTIFIERS );
+
+	result = libpff_recovered_index_get_index_value_by_identifier(
+	          recovered_index,
+	          1,
+	          PFF_TEST_RECOVERED_INDEX_NUMBER_OF_VALUES / PFF_TEST_RECOVERED_INDEX_NUMBER_OF_IDENTIFIERS,
+	          &found_index_value,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_recovered_index_get_index_value_by_identifier(
+	          recovered_index,
+	          PFF_TEST_RECOVERED_INDEX_NUMBER_OF_IDENTIFIERS + 1,
+	          0,
+	          &found_index_value,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test libpff_recovered_index_has_index_value after finalize
+	 */
+	index_value.identifier      = ( 7919 % PFF_TEST_RECOVERED_INDEX_NUMBER_OF_IDENTIFIERS ) + 1;
+	index_value.data_identifier = 1;
+
+	result = libpff_recovered_index_has_index_value(
+	          recovered_index,
+	          &index_value,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	index_value.data_identifier = PFF_TEST_RECOVERED_INDEX_NUMBER_OF_VALUES;
+
+	result = libpff_recovered_index_has_index_value(
+	          recovered_index,
+	          &index_value,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_recovered_index_append_index_value(
+	          recovered_index,
+	          &index_value,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_recovered_index_finalize(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_recovered_index_get_index_value_by_index(
+	          recovered_index,
+	          PFF_TEST_RECOVERED_INDEX_NUMBER_OF_VALUES,
+	          &found_index_value,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_recovered_index_free(
+	          &recovered_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "recovered_index",
+	 recovered_index );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( recovered_index != NULL )
+	{
+		libpff_recovered_index_free(
+		 &recovered_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PFF_TEST_UNREFERENCED_PARAMETER( argc )
+	PFF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+	PFF_TEST_RUN(
+	 "libpff_recovered_index_initialize",
+	 pff_test_recovered_index_initialize );
+
+	PFF_TEST_RUN(
+	 "libpff_recovered_index_free",
+	 pff_test_recovered_index_free );
+
+	PFF_TEST_RUN(
+	 "libpff_recovered_index_finalize",
+	 pff_test_recovered_index_finalize );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
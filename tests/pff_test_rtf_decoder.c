@@ -0,0 +1,1039 @@
+/*
+ * Library rtf_decoder type test program
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "pff_test_libcerror.h"
+#include "pff_test_libpff.h"
+#include "pff_test_macros.h"
+#include "pff_test_memory.h"
+#include "pff_test_unused.h"
+
+#include "../libpff/libpff_definitions.h"
+#include "../libpff/libpff_rtf_decoder.h"
+
+/* LZFu compressed RTF with encapsulated HTML:
+ * {\rtf1\ansi\fromhtml1 {\*\htmltag <p>}Hi\htmlrtf x\htmlrtf0 \par}
+ */
+uint8_t pff_test_rtf_decoder_compressed_data1[ 61 ] = {
+	0x39, 0x00, 0x00, 0x00, 0x41, 0x00, 0x00, 0x00, 0x4c, 0x5a, 0x46, 0x75, 0x00, 0x00, 0x00, 0x00,
+	0x03, 0x00, 0x0a, 0x03, 0x52, 0x68, 0x74, 0x6d, 0x6c, 0x31, 0x20, 0x19, 0x00, 0x00, 0x2a, 0x5c,
+	0x0d, 0xf2, 0x01, 0x90, 0x67, 0x20, 0x3c, 0x70, 0x70, 0x3e, 0x7d, 0x48, 0x00, 0xa0, 0x0d, 0xf2,
+	0x00, 0x21, 0x20, 0x2a, 0x78, 0x0f, 0x76, 0x30, 0x0a, 0xe3, 0x7d, 0x11, 0x00 };
+
+/* The same RTF stored without compression
+ */
+uint8_t pff_test_rtf_decoder_uncompressed_data1[ 81 ] = {
+	0x4d, 0x00, 0x00, 0x00, 0x41, 0x00, 0x00, 0x00, 0x4d, 0x45, 0x4c, 0x41, 0x00, 0x00, 0x00, 0x00,
+	0x7b, 0x5c, 0x72, 0x74, 0x66, 0x31, 0x5c, 0x61, 0x6e, 0x73, 0x69, 0x5c, 0x66, 0x72, 0x6f, 0x6d,
+	0x68, 0x74, 0x6d, 0x6c, 0x31, 0x20, 0x7b, 0x5c, 0x2a, 0x5c, 0x68, 0x74, 0x6d, 0x6c, 0x74, 0x61,
+	0x67, 0x20, 0x3c, 0x70, 0x3e, 0x7d, 0x48, 0x69, 0x5c, 0x68, 0x74, 0x6d, 0x6c, 0x72, 0x74, 0x66,
+	0x20, 0x78, 0x5c, 0x68, 0x74, 0x6d, 0x6c, 0x72, 0x74, 0x66, 0x30, 0x20, 0x5c, 0x70, 0x61, 0x72,
+	0x7d };
+
+uint8_t pff_test_rtf_decoder_expected_html1[ 8 ] = {
+	'<', 'p', '>', 'H', 'i', '\r', '\n', 0 };
+
+/* LZFu compressed RTF with encapsulated plain text:
+ * {\rtf1\ansi\ansicpg1252\fromtext \deff0{\fonttbl{\f0\fswiss Arial;}}\pard Hello world\par Second line\par}
+ */
+uint8_t pff_test_rtf_decoder_compressed_data2[ 85 ] = {
+	0x51, 0x00, 0x00, 0x00, 0x6a, 0x00, 0x00, 0x00, 0x4c, 0x5a, 0x46, 0x75, 0x00, 0x00, 0x00, 0x00,
+	0x03, 0x00, 0x0a, 0x00, 0x72, 0x63, 0x70, 0x67, 0x31, 0x32, 0x35, 0xe2, 0x32, 0x03, 0x43, 0x74,
+	0x65, 0x78, 0x05, 0x41, 0x01, 0x03, 0x01, 0xf7, 0x47, 0x02, 0xa4, 0x03, 0xe4, 0x07, 0x13, 0x3b,
+	0x7d, 0x7d, 0x0a, 0xf3, 0x20, 0x00, 0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x20, 0x77, 0x6f, 0x2c, 0x72,
+	0x6c, 0x0b, 0x31, 0x0a, 0xc1, 0x53, 0x05, 0x91, 0x6e, 0x64, 0xa0, 0x20, 0x6c, 0x69, 0x6e, 0x65,
+	0x0a, 0xa2, 0x7d, 0x13, 0x90 };
+
+uint8_t pff_test_rtf_decoder_expected_text2[ 27 ] = {
+	'H', 'e', 'l', 'l', 'o', ' ', 'w', 'o', 'r', 'l', 'd', '\r', '\n', 'S', 'e', 'c',
+	'o', 'n', 'd', ' ', 'l', 'i', 'n', 'e', '\r', '\n', 0 };
+
+/* RTF with encapsulated plain text stored without compression:
+ * {\rtf1\ansi\fromtext Plain\par}
+ */
+uint8_t pff_test_rtf_decoder_uncompressed_data3[ 47 ] = {
+	0x2b, 0x00, 0x00, 0x00, 0x1f, 0x00, 0x00, 0x00, 0x4d, 0x45, 0x4c, 0x41, 0x00, 0x00, 0x00, 0x00,
+	0x7b, 0x5c, 0x72, 0x74, 0x66, 0x31, 0x5c, 0x61, 0x6e, 0x73, 0x69, 0x5c, 0x66, 0x72, 0x6f, 0x6d,
+	0x74, 0x65, 0x78, 0x74, 0x20, 0x50, 0x6c, 0x61, 0x69, 0x6e, 0x5c, 0x70, 0x61, 0x72, 0x7d };
+
+uint8_t pff_test_rtf_decoder_expected_text3[ 8 ] = {
+	'P', 'l', 'a', 'i', 'n', '\r', '\n', 0 };
+
+/* LZFu compressed RTF without an encapsulated body:
+ * {\rtf1\ansi\deff0 Hello\par}
+ */
+uint8_t pff_test_rtf_decoder_compressed_data4[ 33 ] = {
+	0x1d, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x4c, 0x5a, 0x46, 0x75, 0x00, 0x00, 0x00, 0x00,
+	0x03, 0x00, 0x0a, 0x01, 0x03, 0x20, 0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x05, 0x0a, 0xa2, 0x7d, 0x0e,
+	0xb0 };
+
+/* LZFu compressed RTF with encapsulated plain text that is larger than the LZFu dictionary:
+ * {\rtf1\ansi\fromtext 0123456789abcdef ... 0123456789abcdef\par}
+ * where 0123456789abcdef is repeated 300 times
+ */
+uint8_t pff_test_rtf_decoder_compressed_data5[ 650 ] = {
+	0x86, 0x02, 0x00, 0x00, 0xda, 0x12, 0x00, 0x00, 0x4c, 0x5a, 0x46, 0x75, 0x00, 0x00, 0x00, 0x00,
+	0x03, 0x00, 0x0a, 0x03, 0x52, 0x74, 0x65, 0x78, 0x74, 0x20, 0x30, 0x00, 0x31, 0x32, 0x33, 0x34,
+	0x35, 0x36, 0x37, 0x38, 0xf0, 0x39, 0x61, 0x62, 0x63, 0x01, 0x01, 0x0e, 0x4f, 0x0e, 0x5f, 0x0e,
+	0x6f, 0xff, 0x0e, 0x7f, 0x0e, 0x8f, 0x0e, 0x9f, 0x0e, 0xaf, 0x0e, 0xbf, 0x0e, 0xcf, 0x0e, 0xdf,
+	0x0e, 0xef, 0xff, 0x0e, 0xff, 0x0f, 0x0f, 0x0f, 0x1f, 0x0f, 0x2f, 0x0f, 0x3f, 0x0e, 0x4f, 0x0e,
+	0x5f, 0x0e, 0x6f, 0xff, 0x0e, 0x7f, 0x0e, 0x8f, 0x0e, 0x9f, 0x0e, 0xaf, 0x0e, 0xbf, 0x0e, 0xcf,
+	0x0e, 0xdf, 0x0e, 0xef, 0xff, 0x0e, 0xff, 0x0f, 0x0f, 0x0f, 0x1f, 0x0f, 0x2f, 0x0f, 0x3f, 0x0e,
+	0x4f, 0x0e, 0x5f, 0x0e, 0x6f, 0xff, 0x0e, 0x7f, 0x0e, 0x8f, 0x0e, 0x9f, 0x0e, 0xaf, 0x0e, 0xbf,
+	0x0e, 0xcf, 0x0e, 0xdf, 0x0e, 0xef, 0xff, 0x0e, 0xff, 0x0f, 0x0f, 0x0f, 0x1f, 0x0f, 0x2f, 0x0f,
+	0x3f, 0x0e, 0x4f, 0x0e, 0x5f, 0x0e, 0x6f, 0xff, 0x0e, 0x7f, 0x0e, 0x8f, 0x0e, 0x9f, 0x0e, 0xaf,
+	0x0e, 0xbf, 0x0e, 0xcf, 0x0e, 0xdf, 0x0e, 0xef, 0xff, 0x0e, 0xff, 0x0f, 0x0f, 0x0f, 0x1f, 0x0f,
+	0x2f, 0x0f, 0x3f, 0x0e, 0x4f, 0x0e, 0x5f, 0x0e, 0x6f, 0xff, 0x0e, 0x7f, 0x0e, 0x8f, 0x0e, 0x9f,
+	0x0e, 0xaf, 0x0e, 0xbf, 0x0e, 0xcf, 0x0e, 0xdf, 0x0e, 0xef, 0xff, 0x0e, 0xff, 0x0f, 0x0f, 0x0f,
+	0x1f, 0x0f, 0x2f, 0x0f, 0x3f, 0x0e, 0x4f, 0x0e, 0x5f, 0x0e, 0x6f, 0xff, 0x0e, 0x7f, 0x0e, 0x8f,
+	0x0e, 0x9f, 0x0e, 0xaf, 0x0e, 0xbf, 0x0e, 0xcf, 0x0e, 0xdf, 0x0e, 0xef, 0xff, 0x0e, 0xff, 0x0f,
+	0x0f, 0x0f, 0x1f, 0x0f, 0x2f, 0x0f, 0x3f, 0x0e, 0x4f, 0x0e, 0x5f, 0x0e, 0x6f, 0xff, 0x0e, 0x7f,
+	0x0e, 0x8f, 0x0e, 0x9f, 0x0e, 0xaf, 0x0e, 0xbf, 0x0e, 0xcf, 0x0e, 0xdf, 0x0e, 0xef, 0xff, 0x0e,
+	0xff, 0x0f, 0x0f, 0x0f, 0x1f, 0x0f, 0x2f, 0x0f, 0x3f, 0x0e, 0x4f, 0x0e, 0x5f, 0x0e, 0x6f, 0xff,
+	0x0e, 0x7f, 0x0e, 0x8f, 0x0e, 0x9f, 0x0e, 0xaf, 0x0e, 0xbf, 0x0e, 0xcf, 0x0e, 0xdf, 0x0e, 0xef,
+	0xff, 0x0e, 0xff, 0x0f, 0x0f, 0x0f, 0x1f, 0x0f, 0x2f, 0x0f, 0x3f, 0x0e, 0x4f, 0x0e, 0x5f, 0x0e,
+	0x6f, 0xff, 0x0e, 0x7f, 0x0e, 0x8f, 0x0e, 0x9f, 0x0e, 0xaf, 0x0e, 0xbf, 0x0e, 0xcf, 0x0e, 0xdf,
+	0x0e, 0xef, 0xff, 0x0e, 0xff, 0x0f, 0x0f, 0x0f, 0x1f, 0x0f, 0x2f, 0x0f, 0x3f, 0x0e, 0x4f, 0x0e,
+	0x5f, 0x0e, 0x6f, 0xff, 0x0e, 0x7f, 0x0e, 0x8f, 0x0e, 0x9f, 0x0e, 0xaf, 0x0e, 0xbf, 0x0e, 0xcf,
+	0x0e, 0xdf, 0x0e, 0xef, 0xff, 0x0e, 0xff, 0x0f, 0x0f, 0x0f, 0x1f, 0x0f, 0x2f, 0x0f, 0x3f, 0x0e,
+	0x4f, 0x0e, 0x5f, 0x0e, 0x6f, 0xff, 0x0e, 0x7f, 0x0e, 0x8f, 0x0e, 0x9f, 0x0e, 0xaf, 0x0e, 0xbf,
+	0x0e, 0xcf, 0x0e, 0xdf, 0x0e, 0xef, 0xff, 0x0e, 0xff, 0x0f, 0x0f, 0x0f, 0x1f, 0x0f, 0x2f, 0x0f,
+	0x3f, 0x0e, 0x4f, 0x0e, 0x5f, 0x0e, 0x6f, 0xff, 0x0e, 0x7f, 0x0e, 0x8f, 0x0e, 0x9f, 0x0e, 0xaf,
+	0x0e, 0xbf, 0x0e, 0xcf, 0x0e, 0xdf, 0x0e, 0xef, 0xff, 0x0e, 0xff, 0x0f, 0x0f, 0x0f, 0x1f, 0x0f,
+	0x2f, 0x0f, 0x3f, 0x0e, 0x4f, 0x0e, 0x5f, 0x0e, 0x6f, 0xff, 0x0e, 0x7f, 0x0e, 0x8f, 0x0e, 0x9f,
+	0x0e, 0xaf, 0x0e, 0xbf, 0x0e, 0xcf, 0x0e, 0xdf, 0x0e, 0xef, 0xff, 0x0e, 0xff, 0x0f, 0x0f, 0x0f,
+	0x1f, 0x0f, 0x2f, 0x0f, 0x3f, 0x0e, 0x4f, 0x0e, 0x5f, 0x0e, 0x6f, 0xff, 0x0e, 0x7f, 0x0e, 0x8f,
+	0x0e, 0x9f, 0x0e, 0xaf, 0x0e, 0xbf, 0x0e, 0xcf, 0x0e, 0xdf, 0x0e, 0xef, 0xff, 0x0e, 0xff, 0x0f,
+	0x0f, 0x0f, 0x1f, 0x0f, 0x2f, 0x0f, 0x3f, 0x0e, 0x4f, 0x0e, 0x5f, 0x0e, 0x6f, 0xff, 0x0e, 0x7f,
+	0x00, 0x8f, 0x00, 0x9f, 0x00, 0xaf, 0x00, 0xbf, 0x00, 0xcf, 0x00, 0xdf, 0x00, 0xef, 0xff, 0x00,
+	0xff, 0x00, 0x0f, 0x00, 0x1f, 0x00, 0x2f, 0x00, 0x3f, 0x00, 0x4f, 0x00, 0x5f, 0x00, 0x6f, 0xff,
+	0x00, 0x7f, 0x00, 0x8f, 0x00, 0x9f, 0x00, 0xaf, 0x00, 0xbf, 0x00, 0xcf, 0x00, 0xdf, 0x00, 0xef,
+	0xff, 0x00, 0xff, 0x00, 0x0f, 0x00, 0x1f, 0x00, 0x2f, 0x00, 0x3f, 0x00, 0x4f, 0x00, 0x5f, 0x00,
+	0x6f, 0xff, 0x00, 0x7f, 0x00, 0x8f, 0x00, 0x9f, 0x00, 0xaf, 0x00, 0xbf, 0x00, 0xcf, 0x00, 0xdf,
+	0x00, 0xef, 0xff, 0x00, 0xff, 0x00, 0x0f, 0x00, 0x1f, 0x00, 0x2f, 0x00, 0x3f, 0x00, 0x4f, 0x00,
+	0x5f, 0x00, 0x6f, 0x7f, 0x00, 0x7f, 0x00, 0x8f, 0x00, 0x9f, 0x00, 0xaf, 0x00, 0xbf, 0x00, 0xcf,
+	0x00, 0xd5, 0x5c, 0x10, 0x70, 0x61, 0x72, 0x7d, 0x3a, 0x90 };
+
+/* LZFu compressed data that ends in the middle of a dictionary reference
+ */
+uint8_t pff_test_rtf_decoder_corrupted_data1[ 18 ] = {
+	0x0e, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x4c, 0x5a, 0x46, 0x75, 0x00, 0x00, 0x00, 0x00,
+	0x01, 0x00 };
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+/* Tests the libpff_rtf_decoder_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_rtf_decoder_initialize(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libpff_rtf_decoder_t *rtf_decoder = NULL;
+	int result                        = 0;
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+	int number_of_malloc_fail_tests   = 1;
+	int number_of_memset_fail_tests   = 1;
+	int test_number                   = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libpff_rtf_decoder_initialize(
+	          &rtf_decoder,
+	          LIBPFF_CODEPAGE_WINDOWS_1252,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "rtf_decoder",
+	 rtf_decoder );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_rtf_decoder_free(
+	          &rtf_decoder,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "rtf_decoder",
+	 rtf_decoder );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_rtf_decoder_initialize(
+	          NULL,
+	          LIBPFF_CODEPAGE_WINDOWS_1252,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	rtf_decoder = (libpff_rtf_decoder_t *) 0x12345678UL;
+
+	result = libpff_rtf_decoder_initialize(
+	          &rtf_decoder,
+	          LIBPFF_CODEPAGE_WINDOWS_1252,
+	          &error );
+
+	rtf_decoder = NULL;
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libpff_rtf_decoder_initialize with malloc failing
+		 */
+		pff_test_malloc_attempts_before_fail = test_number;
+
+		result = libpff_rtf_decoder_initialize(
+		          &rtf_decoder,
+		          LIBPFF_CODEPAGE_WINDOWS_1252,
+		          &error );
+
+		if( pff_test_malloc_attempts_before_fail != -1 )
+		{
+			pff_test_malloc_attempts_before_fail = -1;
+
+			if( rtf_decoder != NULL )
+			{
+				libpff_rtf_decoder_free(
+				 &rtf_decoder,
+				 NULL );
+			}
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "rtf_decoder",
+			 rtf_decoder );
+
+			PFF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libpff_rtf_decoder_initialize with memset failing
+		 */
+		pff_test_memset_attempts_before_fail = test_number;
+
+		result = libpff_rtf_decoder_initialize(
+		          &rtf_decoder,
+		          LIBPFF_CODEPAGE_WINDOWS_1252,
+		          &error );
+
+		if( pff_test_memset_attempts_before_fail != -1 )
+		{
+			pff_test_memset_attempts_before_fail = -1;
+
+			if( rtf_decoder != NULL )
+			{
+				libpff_rtf_decoder_free(
+				 &rtf_decoder,
+				 NULL );
+			}
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "rtf_decoder",
+			 rtf_decoder );
+
+			PFF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_PFF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( rtf_decoder != NULL )
+	{
+		libpff_rtf_decoder_free(
+		 &rtf_decoder,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_rtf_decoder_free function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_rtf_decoder_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libpff_rtf_decoder_free(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_rtf_decoder_decode_compressed_data function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_rtf_decoder_decode_compressed_data(
+     void )
+{
+	uint8_t html_body[ 16 ];
+	uint8_t text_body[ 4803 ];
+
+	libcerror_error_t *error          = NULL;
+	libpff_rtf_decoder_t *rtf_decoder = NULL;
+	size_t text_body_index            = 0;
+	size_t utf8_string_size           = 0;
+	uint8_t body_type                 = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_rtf_decoder_initialize(
+	          &rtf_decoder,
+	          LIBPFF_CODEPAGE_WINDOWS_1252,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "rtf_decoder",
+	 rtf_decoder );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libpff_rtf_decoder_decode_compressed_data(
+	          rtf_decoder,
+	          pff_test_rtf_decoder_compressed_data1,
+	          61,
+	          NULL,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_rtf_decoder_get_body_type(
+	          rtf_decoder,
+	          &body_type,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "body_type",
+	 body_type,
+	 LIBPFF_RTF_BODY_TYPE_HTML );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_rtf_decoder_get_utf8_string_size(
+	          rtf_decoder,
+	          &utf8_string_size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_SIZE(
+	 "utf8_string_size",
+	 utf8_string_size,
+	 (size_t) 8 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_rtf_decoder_decode_compressed_data(
+	          rtf_decoder,
+	          pff_test_rtf_decoder_compressed_data1,
+	          61,
+	          html_body,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          html_body,
+	          pff_test_rtf_decoder_expected_html1,
+	          8 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libpff_rtf_decoder_decode_compressed_data(
+	          rtf_decoder,
+	          pff_test_rtf_decoder_uncompressed_data1,
+	          81,
+	          html_body,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          html_body,
+	          pff_test_rtf_decoder_expected_html1,
+	          8 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test \fromtext RTF
+	 */
+	result = libpff_rtf_decoder_decode_compressed_data(
+	          rtf_decoder,
+	          pff_test_rtf_decoder_compressed_data2,
+	          85,
+	          NULL,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_rtf_decoder_get_body_type(
+	          rtf_decoder,
+	          &body_type,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "body_type",
+	 body_type,
+	 LIBPFF_RTF_BODY_TYPE_PLAIN_TEXT );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_rtf_decoder_get_utf8_string_size(
+	          rtf_decoder,
+	          &utf8_string_size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_SIZE(
+	 "utf8_string_size",
+	 utf8_string_size,
+	 (size_t) 27 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_rtf_decoder_decode_compressed_data(
+	          rtf_decoder,
+	          pff_test_rtf_decoder_compressed_data2,
+	          85,
+	          text_body,
+	          4803,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          text_body,
+	          pff_test_rtf_decoder_expected_text2,
+	          27 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test \fromtext RTF stored without compression
+	 */
+	result = libpff_rtf_decoder_decode_compressed_data(
+	          rtf_decoder,
+	          pff_test_rtf_decoder_uncompressed_data3,
+	          47,
+	          NULL,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_rtf_decoder_get_body_type(
+	          rtf_decoder,
+	          &body_type,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "body_type",
+	 body_type,
+	 LIBPFF_RTF_BODY_TYPE_PLAIN_TEXT );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_rtf_decoder_get_utf8_string_size(
+	          rtf_decoder,
+	          &utf8_string_size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_SIZE(
+	 "utf8_string_size",
+	 utf8_string_size,
+	 (size_t) 8 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_rtf_decoder_decode_compressed_data(
+	          rtf_decoder,
+	          pff_test_rtf_decoder_uncompressed_data3,
+	          47,
+	          text_body,
+	          4803,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          text_body,
+	          pff_test_rtf_decoder_expected_text3,
+	          8 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test a body that is decoded across multiple passes through the LZFu dictionary
+	 */
+	result = libpff_rtf_decoder_decode_compressed_data(
+	          rtf_decoder,
+	          pff_test_rtf_decoder_compressed_data5,
+	          650,
+	          NULL,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_rtf_decoder_get_body_type(
+	          rtf_decoder,
+	          &body_type,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "body_type",
+	 body_type,
+	 LIBPFF_RTF_BODY_TYPE_PLAIN_TEXT );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_rtf_decoder_get_utf8_string_size(
+	          rtf_decoder,
+	          &utf8_string_size,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_SIZE(
+	 "utf8_string_size",
+	 utf8_string_size,
+	 (size_t) 4803 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_rtf_decoder_decode_compressed_data(
+	          rtf_decoder,
+	          pff_test_rtf_decoder_compressed_data5,
+	          650,
+	          text_body,
+	          4803,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( text_body_index = 0;
+	     text_body_index < 4800;
+	     text_body_index++ )
+	{
+		PFF_TEST_ASSERT_EQUAL_UINT8(
+		 "text_body[ text_body_index ]",
+		 text_body[ text_body_index ],
+		 (uint8_t) "0123456789abcdef"[ text_body_index % 16 ] );
+	}
+	result = memory_compare(
+	          &( text_body[ 4800 ] ),
+	          "\r\n",
+	          3 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test RTF without an encapsulated body
+	 */
+	result = libpff_rtf_decoder_decode_compressed_data(
+	          rtf_decoder,
+	          pff_test_rtf_decoder_compressed_data4,
+	          33,
+	          text_body,
+	          4803,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_rtf_decoder_get_body_type(
+	          rtf_decoder,
+	          &body_type,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT8(
+	 "body_type",
+	 body_type,
+	 LIBPFF_RTF_BODY_TYPE_UNKNOWN );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_rtf_decoder_decode_compressed_data(
+	          NULL,
+	          pff_test_rtf_decoder_compressed_data1,
+	          61,
+	          html_body,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_rtf_decoder_decode_compressed_data(
+	          rtf_decoder,
+	          NULL,
+	          61,
+	          html_body,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_rtf_decoder_decode_compressed_data(
+	          rtf_decoder,
+	          pff_test_rtf_decoder_compressed_data1,
+	          8,
+	          html_body,
+	          16,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_rtf_decoder_decode_compressed_data(
+	          rtf_decoder,
+	          pff_test_rtf_decoder_compressed_data1,
+	          61,
+	          html_body,
+	          4,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test LZFu compressed data that is truncated
+	 */
+	result = libpff_rtf_decoder_decode_compressed_data(
+	          rtf_decoder,
+	          pff_test_rtf_decoder_compressed_data2,
+	          40,
+	          text_body,
+	          4803,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test LZFu compressed data that is corrupted
+	 */
+	result = libpff_rtf_decoder_decode_compressed_data(
+	          rtf_decoder,
+	          pff_test_rtf_decoder_corrupted_data1,
+	          18,
+	          text_body,
+	          4803,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_rtf_decoder_free(
+	          &rtf_decoder,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "rtf_decoder",
+	 rtf_decoder );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( rtf_decoder != NULL )
+	{
+		libpff_rtf_decoder_free(
+		 &rtf_decoder,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PFF_TEST_UNREFERENCED_PARAMETER( argc )
+	PFF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+	PFF_TEST_RUN(
+	 "libpff_rtf_decoder_initialize",
+	 pff_test_rtf_decoder_initialize );
+
+	PFF_TEST_RUN(
+	 "libpff_rtf_decoder_free",
+	 pff_test_rtf_decoder_free );
+
+	PFF_TEST_RUN(
+	 "libpff_rtf_decoder_decode_compressed_data",
+	 pff_test_rtf_decoder_decode_compressed_data );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+}
+
@@ -0,0 +1,435 @@
+/*
+ * Library sort_entry type test program
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "pff_test_libcerror.h"
+#include "pff_test_libpff.h"
+#include "pff_test_macros.h"
+#include "pff_test_memory.h"
+#include "pff_test_unused.h"
+
+#include "../libpff/libpff_definitions.h"
+#include "../libpff/libpff_libcdata.h"
+#include "../libpff/libpff_sort_entry.h"
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+/* Tests the libpff_sort_entry_compare function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_sort_entry_compare(
+     void )
+{
+	libpff_sort_entry_t first_sort_entry;
+	libpff_sort_entry_t second_sort_entry;
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	first_sort_entry.key         = 1;
+	first_sort_entry.has_key     = 1;
+	first_sort_entry.row_index   = 0;
+	first_sort_entry.identifier  = 2097188;
+
+	second_sort_entry.key        = 2;
+	second_sort_entry.has_key    = 1;
+	second_sort_entry.row_index  = 1;
+	second_sort_entry.identifier = 2097220;
+
+	/* Test regular cases
+	 */
+	result = libpff_sort_entry_compare(
+	          &first_sort_entry,
+	          &second_sort_entry,
+	          LIBPFF_SORT_ORDER_ASCENDING,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 LIBCDATA_COMPARE_LESS );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_sort_entry_compare(
+	          &first_sort_entry,
+	          &second_sort_entry,
+	          LIBPFF_SORT_ORDER_DESCENDING,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 LIBCDATA_COMPARE_GREATER );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* An entry without a key is sorted last in both orders
+	 */
+	second_sort_entry.has_key = 0;
+
+	result = libpff_sort_entry_compare(
+	          &first_sort_entry,
+	          &second_sort_entry,
+	          LIBPFF_SORT_ORDER_DESCENDING,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 LIBCDATA_COMPARE_LESS );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Entries with equal keys are sorted by row index
+	 */
+	second_sort_entry.key     = 1;
+	second_sort_entry.has_key = 1;
+
+	result = libpff_sort_entry_compare(
+	          &second_sort_entry,
+	          &first_sort_entry,
+	          LIBPFF_SORT_ORDER_DESCENDING,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 LIBCDATA_COMPARE_GREATER );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_sort_entry_compare(
+	          NULL,
+	          &second_sort_entry,
+	          LIBPFF_SORT_ORDER_ASCENDING,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_sort_entry_compare(
+	          &first_sort_entry,
+	          NULL,
+	          LIBPFF_SORT_ORDER_ASCENDING,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_sort_entry_compare(
+	          &first_sort_entry,
+	          &second_sort_entry,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_sort_entries_select and libpff_sort_entries_sort functions
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_sort_entries_select(
+     void )
+{
+	libpff_sort_entry_t sort_entries[ 3 ];
+
+	libpff_sort_entry_t sort_entry;
+
+	uint64_t keys[ 8 ]       = { 5, 3, 9, 1, 9, 7, 0, 2 };
+	libcerror_error_t *error = NULL;
+	int number_of_entries    = 0;
+	int result               = 0;
+	int row_index            = 0;
+
+	/* Test regular cases
+	 */
+	for( row_index = 0;
+	     row_index < 8;
+	     row_index++ )
+	{
+		sort_entry.key        = keys[ row_index ];
+		sort_entry.has_key    = ( row_index != 6 );
+		sort_entry.row_index  = row_index;
+		sort_entry.identifier = (uint32_t) ( 100 + row_index );
+
+		result = libpff_sort_entries_select(
+		          sort_entries,
+		          3,
+		          &number_of_entries,
+		          &sort_entry,
+		          LIBPFF_SORT_ORDER_DESCENDING,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 3 );
+
+	result = libpff_sort_entries_sort(
+	          sort_entries,
+	          number_of_entries,
+	          LIBPFF_SORT_ORDER_DESCENDING,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The keys 9, 9 and 7 in row order of equal keys
+	 */
+	PFF_TEST_ASSERT_EQUAL_UINT32(
+	 "sort_entries[ 0 ].identifier",
+	 sort_entries[ 0 ].identifier,
+	 (uint32_t) 102 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT32(
+	 "sort_entries[ 1 ].identifier",
+	 sort_entries[ 1 ].identifier,
+	 (uint32_t) 104 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT32(
+	 "sort_entries[ 2 ].identifier",
+	 sort_entries[ 2 ].identifier,
+	 (uint32_t) 105 );
+
+	/* Test error cases
+	 */
+	result = libpff_sort_entries_select(
+	          NULL,
+	          3,
+	          &number_of_entries,
+	          &sort_entry,
+	          LIBPFF_SORT_ORDER_DESCENDING,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_sort_entries_select(
+	          sort_entries,
+	          0,
+	          &number_of_entries,
+	          &sort_entry,
+	          LIBPFF_SORT_ORDER_DESCENDING,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_sort_entries_select(
+	          sort_entries,
+	          3,
+	          NULL,
+	          &sort_entry,
+	          LIBPFF_SORT_ORDER_DESCENDING,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_sort_entries_select(
+	          sort_entries,
+	          3,
+	          &number_of_entries,
+	          NULL,
+	          LIBPFF_SORT_ORDER_DESCENDING,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_sort_entries_sort(
+	          NULL,
+	          3,
+	          LIBPFF_SORT_ORDER_DESCENDING,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PFF_TEST_UNREFERENCED_PARAMETER( argc )
+	PFF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+	PFF_TEST_RUN(
+	 "libpff_sort_entry_compare",
+	 pff_test_sort_entry_compare );
+
+	PFF_TEST_RUN(
+	 "libpff_sort_entries_select",
+	 pff_test_sort_entries_select );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+}
+
@@ -863,6 +863,11 @@ int pff_test_table_clone(
 	 "error",
 	 error );
 
+	PFF_TEST_ASSERT_EQUAL_UINT32(
+	 "destination_table->descriptor_identifier",
+	 destination_table->descriptor_identifier,
+	 source_table->descriptor_identifier );
+
 	result = libpff_table_free(
 	          &destination_table,
 	          &error );
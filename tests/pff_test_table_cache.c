@@ -0,0 +1,1005 @@
+/*
+ * Library table_cache type test program
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "pff_test_libcerror.h"
+#include "pff_test_libpff.h"
+#include "pff_test_macros.h"
+#include "pff_test_memory.h"
+#include "pff_test_unused.h"
+
+#include "../libpff/libpff_table.h"
+#include "../libpff/libpff_table_cache.h"
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+/* Tests the libpff_table_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_table_cache_initialize(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libpff_table_cache_t *table_cache = NULL;
+	int result                        = 0;
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+	int number_of_malloc_fail_tests   = 3;
+	int number_of_memset_fail_tests   = 2;
+	int test_number                   = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libpff_table_cache_initialize(
+	          &table_cache,
+	          8,
+	          1024,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libpff_table_free,
+	          (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libpff_table_clone,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "table_cache",
+	 table_cache );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_table_cache_free(
+	          &table_cache,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "table_cache",
+	 table_cache );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_table_cache_initialize(
+	          NULL,
+	          8,
+	          1024,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libpff_table_free,
+	          (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libpff_table_clone,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	table_cache = (libpff_table_cache_t *) 0x12345678UL;
+
+	result = libpff_table_cache_initialize(
+	          &table_cache,
+	          8,
+	          1024,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libpff_table_free,
+	          (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libpff_table_clone,
+	          &error );
+
+	table_cache = NULL;
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_table_cache_initialize(
+	          &table_cache,
+	          0,
+	          1024,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libpff_table_free,
+	          (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libpff_table_clone,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_table_cache_initialize(
+	          &table_cache,
+	          8,
+	          1024,
+	          NULL,
+	          (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libpff_table_clone,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_table_cache_initialize(
+	          &table_cache,
+	          8,
+	          1024,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libpff_table_free,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libpff_table_cache_initialize with malloc failing
+		 */
+		pff_test_malloc_attempts_before_fail = test_number;
+
+		result = libpff_table_cache_initialize(
+		          &table_cache,
+		          8,
+		          1024,
+		          (int (*)(intptr_t **, libcerror_error_t **)) &libpff_table_free,
+	          (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libpff_table_clone,
+		          &error );
+
+		if( pff_test_malloc_attempts_before_fail != -1 )
+		{
+			pff_test_malloc_attempts_before_fail = -1;
+
+			if( table_cache != NULL )
+			{
+				libpff_table_cache_free(
+				 &table_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "table_cache",
+			 table_cache );
+
+			PFF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libpff_table_cache_initialize with memset failing
+		 */
+		pff_test_memset_attempts_before_fail = test_number;
+
+		result = libpff_table_cache_initialize(
+		          &table_cache,
+		          8,
+		          1024,
+		          (int (*)(intptr_t **, libcerror_error_t **)) &libpff_table_free,
+	          (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libpff_table_clone,
+		          &error );
+
+		if( pff_test_memset_attempts_before_fail != -1 )
+		{
+			pff_test_memset_attempts_before_fail = -1;
+
+			if( table_cache != NULL )
+			{
+				libpff_table_cache_free(
+				 &table_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "table_cache",
+			 table_cache );
+
+			PFF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_PFF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( table_cache != NULL )
+	{
+		libpff_table_cache_free(
+		 &table_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_table_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_table_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libpff_table_cache_free(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_table_cache_remove_entry function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_table_cache_remove_entry(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libpff_table_cache_t *table_cache = NULL;
+	libpff_table_t *cached_table      = NULL;
+	libpff_table_t *table             = NULL;
+	uint32_t descriptor_identifier    = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_table_cache_initialize(
+	          &table_cache,
+	          8,
+	          1024 * 1024,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libpff_table_free,
+	          (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libpff_table_clone,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "table_cache",
+	 table_cache );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Fill the cache past its maximum number of entries so that entries
+	 * are evicted and moved around within the hash bucket chains
+	 */
+	for( descriptor_identifier = 0x21;
+	     descriptor_identifier < ( 0x21 + ( 32 * 32 ) );
+	     descriptor_identifier += 32 )
+	{
+		result = libpff_table_initialize(
+		          &table,
+		          descriptor_identifier,
+		          0x48,
+		          0,
+		          0,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = libpff_table_cache_set_value(
+		          table_cache,
+		          descriptor_identifier,
+		          0x48,
+		          0,
+		          (intptr_t *) table,
+		          64,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		table = NULL;
+	}
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "table_cache->number_of_entries",
+	 table_cache->number_of_entries,
+	 8 );
+
+	for( descriptor_identifier = 0x21;
+	     descriptor_identifier < ( 0x21 + ( 32 * 32 ) );
+	     descriptor_identifier += 32 )
+	{
+		result = libpff_table_cache_get_value(
+		          table_cache,
+		          descriptor_identifier,
+		          0x48,
+		          0,
+		          (intptr_t **) &cached_table,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 ( descriptor_identifier < ( 0x21 + ( 24 * 32 ) ) ) ? 0 : 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( result == 1 )
+		{
+			PFF_TEST_ASSERT_EQUAL_UINT32(
+			 "cached_table->descriptor_identifier",
+			 cached_table->descriptor_identifier,
+			 descriptor_identifier );
+
+			result = libpff_table_free(
+			          &cached_table,
+			          &error );
+
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+	}
+	/* Test regular cases
+	 */
+	result = libpff_table_cache_remove_entry(
+	          table_cache,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "table_cache->number_of_entries",
+	 table_cache->number_of_entries,
+	 7 );
+
+	/* The entry moved into the removed slot must still be found
+	 */
+	result = libpff_table_cache_get_value(
+	          table_cache,
+	          table_cache->entries[ 0 ].descriptor_identifier,
+	          0x48,
+	          0,
+	          (intptr_t **) &cached_table,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_table_free(
+	          &cached_table,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_table_cache_remove_entry(
+	          NULL,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_table_cache_remove_entry(
+	          table_cache,
+	          7,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_table_cache_free(
+	          &table_cache,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "table_cache",
+	 table_cache );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cached_table != NULL )
+	{
+		libpff_table_free(
+		 &cached_table,
+		 NULL );
+	}
+	if( table != NULL )
+	{
+		libpff_table_free(
+		 &table,
+		 NULL );
+	}
+	if( table_cache != NULL )
+	{
+		libpff_table_cache_free(
+		 &table_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_table_cache_get_value and libpff_table_cache_set_value functions
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_table_cache_get_and_set_value(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libpff_table_cache_t *table_cache = NULL;
+	libpff_table_t *cached_table      = NULL;
+	libpff_table_t *table             = NULL;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_table_cache_initialize(
+	          &table_cache,
+	          2,
+	          1024,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libpff_table_free,
+	          (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libpff_table_clone,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "table_cache",
+	 table_cache );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libpff_table_cache_get_value(
+	          table_cache,
+	          0x21,
+	          0x48,
+	          0,
+	          (intptr_t **) &cached_table,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_table_initialize(
+	          &table,
+	          0x21,
+	          0x48,
+	          0,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "table",
+	 table );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_table_cache_set_value(
+	          table_cache,
+	          0x21,
+	          0x48,
+	          0,
+	          (intptr_t *) table,
+	          512,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	table = NULL;
+
+	result = libpff_table_cache_get_value(
+	          table_cache,
+	          0x21,
+	          0x48,
+	          0,
+	          (intptr_t **) &cached_table,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "cached_table",
+	 cached_table );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_UINT32(
+	 "cached_table->descriptor_identifier",
+	 cached_table->descriptor_identifier,
+	 (uint32_t) 0x21 );
+
+	/* Test that a copy of the cached value is returned
+	 */
+	PFF_TEST_ASSERT_NOT_EQUAL_INTPTR(
+	 "cached_table",
+	 (intptr_t *) cached_table,
+	 table_cache->entries[ 0 ].value );
+
+	result = libpff_table_free(
+	          &cached_table,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that setting a value that exceeds the maximum size is refused
+	 */
+	result = libpff_table_initialize(
+	          &table,
+	          0x61,
+	          0x88,
+	          0,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libpff_table_cache_set_value(
+	          table_cache,
+	          0x61,
+	          0x88,
+	          0,
+	          (intptr_t *) table,
+	          2048,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the least recently used value is removed
+	 */
+	result = libpff_table_cache_set_value(
+	          table_cache,
+	          0x61,
+	          0x88,
+	          0,
+	          (intptr_t *) table,
+	          768,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	table = NULL;
+
+	result = libpff_table_cache_get_value(
+	          table_cache,
+	          0x21,
+	          0x48,
+	          0,
+	          (intptr_t **) &cached_table,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_table_cache_get_value(
+	          NULL,
+	          0x21,
+	          0x48,
+	          0,
+	          (intptr_t **) &cached_table,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_table_cache_get_value(
+	          table_cache,
+	          0x21,
+	          0x48,
+	          0,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_table_cache_set_value(
+	          NULL,
+	          0x21,
+	          0x48,
+	          0,
+	          (intptr_t *) cached_table,
+	          512,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_table_cache_set_value(
+	          table_cache,
+	          0x21,
+	          0x48,
+	          0,
+	          NULL,
+	          512,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_table_cache_free(
+	          &table_cache,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "table_cache",
+	 table_cache );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cached_table != NULL )
+	{
+		libpff_table_free(
+		 &cached_table,
+		 NULL );
+	}
+	if( table != NULL )
+	{
+		libpff_table_free(
+		 &table,
+		 NULL );
+	}
+	if( table_cache != NULL )
+	{
+		libpff_table_cache_free(
+		 &table_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PFF_TEST_UNREFERENCED_PARAMETER( argc )
+	PFF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+	PFF_TEST_RUN(
+	 "libpff_table_cache_initialize",
+	 pff_test_table_cache_initialize );
+
+	PFF_TEST_RUN(
+	 "libpff_table_cache_free",
+	 pff_test_table_cache_free );
+
+	PFF_TEST_RUN(
+	 "libpff_table_cache_remove_entry",
+	 pff_test_table_cache_remove_entry );
+
+	PFF_TEST_RUN(
+	 "libpff_table_cache_get_value",
+	 pff_test_table_cache_get_and_set_value );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+}
+
@@ -0,0 +1,779 @@
+/*
+ * Library task_deque type test program
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "pff_test_libcerror.h"
+#include "pff_test_libpff.h"
+#include "pff_test_macros.h"
+#include "pff_test_memory.h"
+#include "pff_test_unused.h"
+
+#include "../libpff/libpff_libcdata.h"
+#include "../libpff/libpff_task_deque.h"
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+/* Tests the libpff_task_deque_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_task_deque_initialize(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libpff_task_deque_t *task_deque = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 3;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libpff_task_deque_initialize(
+	          &task_deque,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "task_deque",
+	 task_deque );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_task_deque_free(
+	          &task_deque,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "task_deque",
+	 task_deque );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_task_deque_initialize(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	task_deque = (libpff_task_deque_t *) 0x12345678UL;
+
+	result = libpff_task_deque_initialize(
+	          &task_deque,
+	          &error );
+
+	task_deque = NULL;
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libpff_task_deque_initialize with malloc failing
+		 */
+		pff_test_malloc_attempts_before_fail = test_number;
+
+		result = libpff_task_deque_initialize(
+		          &task_deque,
+		          &error );
+
+		if( pff_test_malloc_attempts_before_fail != -1 )
+		{
+			pff_test_malloc_attempts_before_fail = -1;
+
+			if( task_deque != NULL )
+			{
+				libpff_task_deque_free(
+				 &task_deque,
+				 NULL );
+			}
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "task_deque",
+			 task_deque );
+
+			PFF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libpff_task_deque_initialize with memset failing
+		 */
+		pff_test_memset_attempts_before_fail = test_number;
+
+		result = libpff_task_deque_initialize(
+		          &task_deque,
+		          &error );
+
+		if( pff_test_memset_attempts_before_fail != -1 )
+		{
+			pff_test_memset_attempts_before_fail = -1;
+
+			if( task_deque != NULL )
+			{
+				libpff_task_deque_free(
+				 &task_deque,
+				 NULL );
+			}
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "task_deque",
+			 task_deque );
+
+			PFF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_PFF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( task_deque != NULL )
+	{
+		libpff_task_deque_free(
+		 &task_deque,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_task_deque_free function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_task_deque_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libpff_task_deque_free(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libpff_task_deque_push_bottom, libpff_task_deque_pop_bottom and libpff_task_deque_steal_top functions
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_task_deque_push_pop_and_steal(
+     void )
+{
+	libpff_task_deque_task_t task;
+
+	libcdata_tree_node_t *first_sub_node = (libcdata_tree_node_t *) 0x87654321UL;
+	libcdata_tree_node_t *item_tree_node = (libcdata_tree_node_t *) 0x12345678UL;
+	libcerror_error_t *error             = NULL;
+	libpff_task_deque_t *task_deque      = NULL;
+	int number_of_tasks                  = 0;
+	int result                           = 0;
+	int task_index                       = 0;
+
+	/* Initialize test
+	 */
+	result = libpff_task_deque_initialize(
+	          &task_deque,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "task_deque",
+	 task_deque );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libpff_task_deque_pop_bottom(
+	          task_deque,
+	          &task,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libpff_task_deque_steal_top(
+	          task_deque,
+	          &task,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Push more tasks than initially fit, so that the tasks are reallocated
+	 * after the top task index has moved
+	 */
+	result = libpff_task_deque_push_bottom(
+	          task_deque,
+	          item_tree_node,
+	          first_sub_node,
+	          0,
+	          1,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libpff_task_deque_steal_top(
+	          task_deque,
+	          &task,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "task.first_sub_node_index",
+	 task.first_sub_node_index,
+	 0 );
+
+	for( task_index = 0;
+	     task_index < 100;
+	     task_index++ )
+	{
+		result = libpff_task_deque_push_bottom(
+		          task_deque,
+		          item_tree_node,
+		          first_sub_node,
+		          task_index,
+		          task_index + 1,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libpff_task_deque_get_number_of_tasks(
+	          task_deque,
+	          &number_of_tasks,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_tasks",
+	 number_of_tasks,
+	 100 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The oldest task is stolen from the top
+	 */
+	result = libpff_task_deque_steal_top(
+	          task_deque,
+	          &task,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INTPTR(
+	 "task.item_tree_node",
+	 (intptr_t *) task.item_tree_node,
+	 (intptr_t *) item_tree_node );
+
+	PFF_TEST_ASSERT_EQUAL_INTPTR(
+	 "task.first_sub_node",
+	 (intptr_t *) task.first_sub_node,
+	 (intptr_t *) first_sub_node );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "task.first_sub_node_index",
+	 task.first_sub_node_index,
+	 0 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "task.number_of_sub_nodes",
+	 task.number_of_sub_nodes,
+	 1 );
+
+	/* The most recent task is popped from the bottom
+	 */
+	result = libpff_task_deque_pop_bottom(
+	          task_deque,
+	          &task,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "task.first_sub_node_index",
+	 task.first_sub_node_index,
+	 99 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "task.number_of_sub_nodes",
+	 task.number_of_sub_nodes,
+	 100 );
+
+	for( task_index = 98;
+	     task_index > 0;
+	     task_index-- )
+	{
+		result = libpff_task_deque_pop_bottom(
+		          task_deque,
+		          &task,
+		          &error );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		PFF_TEST_ASSERT_EQUAL_INT(
+		 "task.first_sub_node_index",
+		 task.first_sub_node_index,
+		 task_index );
+	}
+	result = libpff_task_deque_pop_bottom(
+	          task_deque,
+	          &task,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libpff_task_deque_push_bottom(
+	          NULL,
+	          item_tree_node,
+	          first_sub_node,
+	          0,
+	          1,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_task_deque_push_bottom(
+	          task_deque,
+	          NULL,
+	          first_sub_node,
+	          0,
+	          1,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_task_deque_push_bottom(
+	          task_deque,
+	          item_tree_node,
+	          NULL,
+	          0,
+	          1,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_task_deque_push_bottom(
+	          task_deque,
+	          item_tree_node,
+	          first_sub_node,
+	          -1,
+	          1,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_task_deque_push_bottom(
+	          task_deque,
+	          item_tree_node,
+	          first_sub_node,
+	          0,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_task_deque_pop_bottom(
+	          NULL,
+	          &task,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_task_deque_pop_bottom(
+	          task_deque,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_task_deque_steal_top(
+	          NULL,
+	          &task,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_task_deque_steal_top(
+	          task_deque,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_task_deque_get_number_of_tasks(
+	          NULL,
+	          &number_of_tasks,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libpff_task_deque_get_number_of_tasks(
+	          task_deque,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libpff_task_deque_free(
+	          &task_deque,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "task_deque",
+	 task_deque );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( task_deque != NULL )
+	{
+		libpff_task_deque_free(
+		 &task_deque,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PFF_TEST_UNREFERENCED_PARAMETER( argc )
+	PFF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+	PFF_TEST_RUN(
+	 "libpff_task_deque_initialize",
+	 pff_test_task_deque_initialize );
+
+	PFF_TEST_RUN(
+	 "libpff_task_deque_free",
+	 pff_test_task_deque_free );
+
+	PFF_TEST_RUN(
+	 "libpff_task_deque_push_bottom",
+	 pff_test_task_deque_push_pop_and_steal );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBPFF_DLL_IMPORT ) */
+}
+
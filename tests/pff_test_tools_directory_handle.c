@@ -0,0 +1,2096 @@
+/*
+ * Tools directory_handle type test program
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "pff_test_libcerror.h"
+#include "pff_test_macros.h"
+#include "pff_test_memory.h"
+#include "pff_test_unused.h"
+
+#include "../pfftools/directory_handle.h"
+
+#if defined( DIRECTORY_HANDLE_HAVE_DESCRIPTOR )
+
+/* Removes an entry of a test directory
+ * Returns 1 if successful or -1 on error
+ */
+int pff_test_tools_directory_handle_remove_entry(
+     const char *directory_path,
+     const char *name )
+{
+	char path[ 256 ];
+
+	int print_count = 0;
+
+	print_count = narrow_string_snprintf(
+	               path,
+	               256,
+	               "%s/%s",
+	               directory_path,
+	               name );
+
+	if( ( print_count < 0 )
+	 || ( print_count >= 256 ) )
+	{
+		return( -1 );
+	}
+	if( remove(
+	     path ) != 0 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( DIRECTORY_HANDLE_HAVE_DESCRIPTOR ) */
+
+/* Tests the directory_handle_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_tools_directory_handle_initialize(
+     void )
+{
+	directory_handle_t *directory_handle = NULL;
+	libcerror_error_t *error             = NULL;
+	int result                           = 0;
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+	int number_of_malloc_fail_tests      = 1;
+	int number_of_memset_fail_tests      = 1;
+	int test_number                      = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = directory_handle_initialize(
+	          &directory_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "directory_handle",
+	 directory_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = directory_handle_free(
+	          &directory_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "directory_handle",
+	 directory_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = directory_handle_initialize(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	directory_handle = (directory_handle_t *) 0x12345678UL;
+
+	result = directory_handle_initialize(
+	          &directory_handle,
+	          &error );
+
+	directory_handle = NULL;
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test directory_handle_initialize with malloc failing
+		 */
+		pff_test_malloc_attempts_before_fail = test_number;
+
+		result = directory_handle_initialize(
+		          &directory_handle,
+		          &error );
+
+		if( pff_test_malloc_attempts_before_fail != -1 )
+		{
+			pff_test_malloc_attempts_before_fail = -1;
+
+			if( directory_handle != NULL )
+			{
+				directory_handle_free(
+				 &directory_handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "directory_handle",
+			 directory_handle );
+
+			PFF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test directory_handle_initialize with memset failing
+		 */
+		pff_test_memset_attempts_before_fail = test_number;
+
+		result = directory_handle_initialize(
+		          &directory_handle,
+		          &error );
+
+		if( pff_test_memset_attempts_before_fail != -1 )
+		{
+			pff_test_memset_attempts_before_fail = -1;
+
+			if( directory_handle != NULL )
+			{
+				directory_handle_free(
+				 &directory_handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "directory_handle",
+			 directory_handle );
+
+			PFF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_PFF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( directory_handle != NULL )
+	{
+		directory_handle_free(
+		 &directory_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the directory_handle_free function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_tools_directory_handle_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = directory_handle_free(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the directory_handle_append_name and directory_handle_get_name_index functions
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_tools_directory_handle_append_name(
+     void )
+{
+	directory_handle_t *directory_handle = NULL;
+	libcerror_error_t *error             = NULL;
+	system_character_t *entry_name       = NULL;
+	system_character_t *first_entry_name = NULL;
+	int name_index                       = 0;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = directory_handle_initialize(
+	          &directory_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "directory_handle",
+	 directory_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = directory_handle_append_name(
+	          directory_handle,
+	          _SYSTEM_STRING( "Message00002" ),
+	          12,
+	          &first_entry_name,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "first_entry_name",
+	 first_entry_name );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = directory_handle_append_name(
+	          directory_handle,
+	          _SYSTEM_STRING( "Message00001" ),
+	          12,
+	          &entry_name,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A name that is a prefix of another name is sorted before it
+	 */
+	result = directory_handle_append_name(
+	          directory_handle,
+	          _SYSTEM_STRING( "Message" ),
+	          7,
+	          &entry_name,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "directory_handle->number_of_names",
+	 directory_handle->number_of_names,
+	 3 );
+
+	result = system_string_compare(
+	          directory_handle->names[ 0 ],
+	          _SYSTEM_STRING( "Message" ),
+	          8 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = system_string_compare(
+	          directory_handle->names[ 1 ],
+	          _SYSTEM_STRING( "Message00001" ),
+	          13 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = system_string_compare(
+	          directory_handle->names[ 2 ],
+	          _SYSTEM_STRING( "Message00002" ),
+	          13 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* A name collision returns the name that is already stored
+	 */
+	result = directory_handle_append_name(
+	          directory_handle,
+	          _SYSTEM_STRING( "Message00002" ),
+	          12,
+	          &entry_name,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "directory_handle->number_of_names",
+	 directory_handle->number_of_names,
+	 3 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ( entry_name == first_entry_name );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* The name does not need to be terminated
+	 */
+	result = directory_handle_get_name_index(
+	          directory_handle,
+	          _SYSTEM_STRING( "Message00001.txt" ),
+	          12,
+	          &name_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "name_index",
+	 name_index,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = directory_handle_get_name_index(
+	          directory_handle,
+	          _SYSTEM_STRING( "Message000015" ),
+	          13,
+	          &name_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "name_index",
+	 name_index,
+	 2 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = directory_handle_append_name(
+	          NULL,
+	          _SYSTEM_STRING( "Message" ),
+	          7,
+	          &entry_name,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = directory_handle_append_name(
+	          directory_handle,
+	          _SYSTEM_STRING( "Message" ),
+	          0,
+	          &entry_name,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = directory_handle_append_name(
+	          directory_handle,
+	          _SYSTEM_STRING( "Message" ),
+	          7,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = directory_handle_get_name_index(
+	          directory_handle,
+	          NULL,
+	          7,
+	          &name_index,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = directory_handle_get_name_index(
+	          directory_handle,
+	          _SYSTEM_STRING( "Message" ),
+	          7,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = directory_handle_free(
+	          &directory_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "directory_handle",
+	 directory_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( directory_handle != NULL )
+	{
+		directory_handle_free(
+		 &directory_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( DIRECTORY_HANDLE_HAVE_DESCRIPTOR )
+
+/* Tests the directory_handle_open function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_tools_directory_handle_open(
+     void )
+{
+	char temporary_path[ 64 ];
+
+	directory_handle_t *directory_handle = NULL;
+	libcerror_error_t *error             = NULL;
+	char *directory_path                 = NULL;
+	size_t directory_path_length         = 0;
+	int descriptor                       = -1;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = narrow_string_snprintf(
+	          temporary_path,
+	          64,
+	          "pff_test_directory_handle_XXXXXX" );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 32 );
+
+	directory_path = mkdtemp(
+	                  temporary_path );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "directory_path",
+	 directory_path );
+
+	directory_path_length = narrow_string_length(
+	                         directory_path );
+
+	result = directory_handle_initialize(
+	          &directory_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "directory_handle",
+	 directory_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = directory_handle_open(
+	          directory_handle,
+	          directory_path,
+	          directory_path_length,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "directory_handle->descriptor",
+	 directory_handle->descriptor,
+	 -1 );
+
+	/* Test error cases
+	 */
+	result = directory_handle_open(
+	          NULL,
+	          directory_path,
+	          directory_path_length,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = directory_handle_open(
+	          directory_handle,
+	          directory_path,
+	          directory_path_length,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test if the directory descriptor is closed when the directory handle is freed
+	 */
+	descriptor = directory_handle->descriptor;
+
+	result = directory_handle_free(
+	          &directory_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "directory_handle",
+	 directory_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = fcntl(
+	          descriptor,
+	          F_GETFD );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	/* Test error cases on a directory handle that is not open
+	 */
+	result = directory_handle_initialize(
+	          &directory_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = directory_handle_open(
+	          directory_handle,
+	          NULL,
+	          directory_path_length,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = directory_handle_open(
+	          directory_handle,
+	          directory_path,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test directory_handle_open with a directory that does not exist
+	 */
+	result = directory_handle_open(
+	          directory_handle,
+	          "pff_test_directory_handle_missing",
+	          33,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "directory_handle->path",
+	 directory_handle->path );
+
+	/* Clean up
+	 */
+	result = directory_handle_free(
+	          &directory_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = remove(
+	          directory_path );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( directory_handle != NULL )
+	{
+		directory_handle_free(
+		 &directory_handle,
+		 NULL );
+	}
+	if( directory_path != NULL )
+	{
+		remove(
+		 directory_path );
+	}
+	return( 0 );
+}
+
+/* Tests the directory_handle_open_sub_directory function with nested directories
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_tools_directory_handle_open_sub_directory(
+     void )
+{
+	char temporary_path[ 64 ];
+
+	directory_handle_t *directory_handle        = NULL;
+	directory_handle_t *nested_directory_handle = NULL;
+	directory_handle_t *sub_directory_handle    = NULL;
+	libcerror_error_t *error                    = NULL;
+	FILE *file_stream                           = NULL;
+	char *directory_path                        = NULL;
+	size_t directory_path_length                = 0;
+	int result                                  = 0;
+
+	/* Initialize test
+	 */
+	result = narrow_string_snprintf(
+	          temporary_path,
+	          64,
+	          "pff_test_directory_handle_XXXXXX" );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 32 );
+
+	directory_path = mkdtemp(
+	                  temporary_path );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "directory_path",
+	 directory_path );
+
+	directory_path_length = narrow_string_length(
+	                         directory_path );
+
+	result = directory_handle_initialize(
+	          &directory_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = directory_handle_open(
+	          directory_handle,
+	          directory_path,
+	          directory_path_length,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = directory_handle_make_directory(
+	          directory_handle,
+	          "Folder",
+	          6,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = directory_handle_initialize(
+	          &sub_directory_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = directory_handle_open_sub_directory(
+	          sub_directory_handle,
+	          directory_handle,
+	          "Folder",
+	          6,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = directory_handle_make_directory(
+	          sub_directory_handle,
+	          "Message00001",
+	          12,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = directory_handle_initialize(
+	          &nested_directory_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = directory_handle_open_sub_directory(
+	          nested_directory_handle,
+	          sub_directory_handle,
+	          "Message00001",
+	          12,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The path of the nested directory is joined from the path of its parents
+	 */
+	result = narrow_string_compare(
+	          &( nested_directory_handle->path[ directory_path_length ] ),
+	          "/Folder/Message00001",
+	          21 );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = directory_handle_open_file_stream(
+	          nested_directory_handle,
+	          "Message.txt",
+	          11,
+	          &file_stream,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_stream",
+	 file_stream );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = file_stream_close(
+	          file_stream );
+
+	file_stream = NULL;
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* The file was created relative to the nested directory
+	 */
+	result = access(
+	          nested_directory_handle->path,
+	          F_OK );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = pff_test_tools_directory_handle_remove_entry(
+	          nested_directory_handle->path,
+	          "Message.txt" );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = directory_handle_open_sub_directory(
+	          NULL,
+	          directory_handle,
+	          "Folder",
+	          6,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = directory_handle_open_sub_directory(
+	          sub_directory_handle,
+	          directory_handle,
+	          "Folder",
+	          6,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up the nested directory handles, the parent is closed last
+	 */
+	result = directory_handle_free(
+	          &nested_directory_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = directory_handle_free(
+	          &sub_directory_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases with a parent directory handle that is not open
+	 */
+	result = directory_handle_initialize(
+	          &sub_directory_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = directory_handle_initialize(
+	          &nested_directory_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = directory_handle_open_sub_directory(
+	          nested_directory_handle,
+	          sub_directory_handle,
+	          "Folder",
+	          6,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = directory_handle_open_sub_directory(
+	          nested_directory_handle,
+	          NULL,
+	          "Folder",
+	          6,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = directory_handle_open_sub_directory(
+	          nested_directory_handle,
+	          directory_handle,
+	          NULL,
+	          6,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test directory_handle_open_sub_directory with a sub directory that does not exist
+	 */
+	result = directory_handle_open_sub_directory(
+	          nested_directory_handle,
+	          directory_handle,
+	          "Missing",
+	          7,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "nested_directory_handle->path",
+	 nested_directory_handle->path );
+
+	/* Clean up
+	 */
+	result = directory_handle_free(
+	          &nested_directory_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = directory_handle_free(
+	          &sub_directory_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = directory_handle_free(
+	          &directory_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = pff_test_tools_directory_handle_remove_entry(
+	          directory_path,
+	          "Folder/Message00001" );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = pff_test_tools_directory_handle_remove_entry(
+	          directory_path,
+	          "Folder" );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = remove(
+	          directory_path );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_stream != NULL )
+	{
+		file_stream_close(
+		 file_stream );
+	}
+	if( nested_directory_handle != NULL )
+	{
+		directory_handle_free(
+		 &nested_directory_handle,
+		 NULL );
+	}
+	if( sub_directory_handle != NULL )
+	{
+		directory_handle_free(
+		 &sub_directory_handle,
+		 NULL );
+	}
+	if( directory_handle != NULL )
+	{
+		directory_handle_free(
+		 &directory_handle,
+		 NULL );
+	}
+	if( directory_path != NULL )
+	{
+		pff_test_tools_directory_handle_remove_entry(
+		 directory_path,
+		 "Folder/Message00001/Message.txt" );
+
+		pff_test_tools_directory_handle_remove_entry(
+		 directory_path,
+		 "Folder/Message00001" );
+
+		pff_test_tools_directory_handle_remove_entry(
+		 directory_path,
+		 "Folder" );
+
+		remove(
+		 directory_path );
+	}
+	return( 0 );
+}
+
+/* Tests the directory_handle_make_directory function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_tools_directory_handle_make_directory(
+     void )
+{
+	char temporary_path[ 64 ];
+
+	directory_handle_t *directory_handle = NULL;
+	libcerror_error_t *error             = NULL;
+	char *directory_path                 = NULL;
+	size_t directory_path_length         = 0;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = narrow_string_snprintf(
+	          temporary_path,
+	          64,
+	          "pff_test_directory_handle_XXXXXX" );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 32 );
+
+	directory_path = mkdtemp(
+	                  temporary_path );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "directory_path",
+	 directory_path );
+
+	directory_path_length = narrow_string_length(
+	                         directory_path );
+
+	result = directory_handle_initialize(
+	          &directory_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = directory_handle_open(
+	          directory_handle,
+	          directory_path,
+	          directory_path_length,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = directory_handle_make_directory(
+	          directory_handle,
+	          "Folder",
+	          6,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Remove the directory so that a collision can only be detected
+	 * by the names recorded in the directory handle
+	 */
+	result = pff_test_tools_directory_handle_remove_entry(
+	          directory_path,
+	          "Folder" );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = directory_handle_make_directory(
+	          directory_handle,
+	          "Folder",
+	          6,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = access(
+	          directory_path,
+	          F_OK );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* A directory created outside the directory handle is reported by mkdirat
+	 */
+	result = directory_handle_make_directory(
+	          directory_handle,
+	          "Other",
+	          5,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = directory_handle_free(
+	          &directory_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = directory_handle_initialize(
+	          &directory_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = directory_handle_open(
+	          directory_handle,
+	          directory_path,
+	          directory_path_length,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = directory_handle_make_directory(
+	          directory_handle,
+	          "Other",
+	          5,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = directory_handle_make_directory(
+	          NULL,
+	          "Folder",
+	          6,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = directory_handle_make_directory(
+	          directory_handle,
+	          "Folder",
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = directory_handle_free(
+	          &directory_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = pff_test_tools_directory_handle_remove_entry(
+	          directory_path,
+	          "Other" );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = remove(
+	          directory_path );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( directory_handle != NULL )
+	{
+		directory_handle_free(
+		 &directory_handle,
+		 NULL );
+	}
+	if( directory_path != NULL )
+	{
+		pff_test_tools_directory_handle_remove_entry(
+		 directory_path,
+		 "Folder" );
+
+		pff_test_tools_directory_handle_remove_entry(
+		 directory_path,
+		 "Other" );
+
+		remove(
+		 directory_path );
+	}
+	return( 0 );
+}
+
+/* Tests the directory_handle_open_file_stream function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_tools_directory_handle_open_file_stream(
+     void )
+{
+	char temporary_path[ 64 ];
+
+	directory_handle_t *directory_handle = NULL;
+	libcerror_error_t *error             = NULL;
+	FILE *file_stream                    = NULL;
+	char *directory_path                 = NULL;
+	size_t directory_path_length         = 0;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = narrow_string_snprintf(
+	          temporary_path,
+	          64,
+	          "pff_test_directory_handle_XXXXXX" );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 32 );
+
+	directory_path = mkdtemp(
+	                  temporary_path );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "directory_path",
+	 directory_path );
+
+	directory_path_length = narrow_string_length(
+	                         directory_path );
+
+	result = directory_handle_initialize(
+	          &directory_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = directory_handle_open(
+	          directory_handle,
+	          directory_path,
+	          directory_path_length,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = directory_handle_open_file_stream(
+	          directory_handle,
+	          "Message.txt",
+	          11,
+	          &file_stream,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_stream",
+	 file_stream );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = file_stream_close(
+	          file_stream );
+
+	file_stream = NULL;
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Remove the file so that a collision can only be detected
+	 * by the names recorded in the directory handle
+	 */
+	result = pff_test_tools_directory_handle_remove_entry(
+	          directory_path,
+	          "Message.txt" );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = directory_handle_open_file_stream(
+	          directory_handle,
+	          "Message.txt",
+	          11,
+	          &file_stream,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "file_stream",
+	 file_stream );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A file created outside the directory handle is reported by O_EXCL
+	 */
+	result = directory_handle_open_file_stream(
+	          directory_handle,
+	          "Other.txt",
+	          9,
+	          &file_stream,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = file_stream_close(
+	          file_stream );
+
+	file_stream = NULL;
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = directory_handle_free(
+	          &directory_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = directory_handle_initialize(
+	          &directory_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = directory_handle_open(
+	          directory_handle,
+	          directory_path,
+	          directory_path_length,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = directory_handle_open_file_stream(
+	          directory_handle,
+	          "Other.txt",
+	          9,
+	          &file_stream,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "file_stream",
+	 file_stream );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = directory_handle_open_file_stream(
+	          NULL,
+	          "Message.txt",
+	          11,
+	          &file_stream,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = directory_handle_open_file_stream(
+	          directory_handle,
+	          "Message.txt",
+	          11,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = directory_handle_free(
+	          &directory_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = pff_test_tools_directory_handle_remove_entry(
+	          directory_path,
+	          "Other.txt" );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = remove(
+	          directory_path );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_stream != NULL )
+	{
+		file_stream_close(
+		 file_stream );
+	}
+	if( directory_handle != NULL )
+	{
+		directory_handle_free(
+		 &directory_handle,
+		 NULL );
+	}
+	if( directory_path != NULL )
+	{
+		pff_test_tools_directory_handle_remove_entry(
+		 directory_path,
+		 "Message.txt" );
+
+		pff_test_tools_directory_handle_remove_entry(
+		 directory_path,
+		 "Other.txt" );
+
+		remove(
+		 directory_path );
+	}
+	return( 0 );
+}
+
+#endif /* defined( DIRECTORY_HANDLE_HAVE_DESCRIPTOR ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PFF_TEST_UNREFERENCED_PARAMETER( argc )
+	PFF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	PFF_TEST_RUN(
+	 "directory_handle_initialize",
+	 pff_test_tools_directory_handle_initialize );
+
+	PFF_TEST_RUN(
+	 "directory_handle_free",
+	 pff_test_tools_directory_handle_free );
+
+	PFF_TEST_RUN(
+	 "directory_handle_append_name",
+	 pff_test_tools_directory_handle_append_name );
+
+#if defined( DIRECTORY_HANDLE_HAVE_DESCRIPTOR )
+
+	PFF_TEST_RUN(
+	 "directory_handle_open",
+	 pff_test_tools_directory_handle_open );
+
+	PFF_TEST_RUN(
+	 "directory_handle_open_sub_directory",
+	 pff_test_tools_directory_handle_open_sub_directory );
+
+	PFF_TEST_RUN(
+	 "directory_handle_make_directory",
+	 pff_test_tools_directory_handle_make_directory );
+
+	PFF_TEST_RUN(
+	 "directory_handle_open_file_stream",
+	 pff_test_tools_directory_handle_open_file_stream );
+
+#endif /* defined( DIRECTORY_HANDLE_HAVE_DESCRIPTOR ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,807 @@
+/*
+ * Tools profile_handle type test program
+ *
+ * Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "pff_test_libcerror.h"
+#include "pff_test_macros.h"
+#include "pff_test_memory.h"
+#include "pff_test_unused.h"
+
+#include "../pfftools/profile_handle.h"
+
+/* Tests the profile_handle_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_tools_profile_handle_initialize(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	profile_handle_t *profile_handle = NULL;
+	int result                       = 0;
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+	int number_of_malloc_fail_tests  = 2;
+	int number_of_memset_fail_tests  = 2;
+	int test_number                  = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = profile_handle_initialize(
+	          &profile_handle,
+	          PROFILE_HANDLE_DEFAULT_NUMBER_OF_TOP_ITEMS,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "profile_handle",
+	 profile_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = profile_handle_free(
+	          &profile_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "profile_handle",
+	 profile_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = profile_handle_initialize(
+	          NULL,
+	          PROFILE_HANDLE_DEFAULT_NUMBER_OF_TOP_ITEMS,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	profile_handle = (profile_handle_t *) 0x12345678UL;
+
+	result = profile_handle_initialize(
+	          &profile_handle,
+	          PROFILE_HANDLE_DEFAULT_NUMBER_OF_TOP_ITEMS,
+	          &error );
+
+	profile_handle = NULL;
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = profile_handle_initialize(
+	          &profile_handle,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "profile_handle",
+	 profile_handle );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_PFF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test profile_handle_initialize with malloc failing
+		 */
+		pff_test_malloc_attempts_before_fail = test_number;
+
+		result = profile_handle_initialize(
+		          &profile_handle,
+		          PROFILE_HANDLE_DEFAULT_NUMBER_OF_TOP_ITEMS,
+		          &error );
+
+		if( pff_test_malloc_attempts_before_fail != -1 )
+		{
+			pff_test_malloc_attempts_before_fail = -1;
+
+			if( profile_handle != NULL )
+			{
+				profile_handle_free(
+				 &profile_handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "profile_handle",
+			 profile_handle );
+
+			PFF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test profile_handle_initialize with memset failing
+		 */
+		pff_test_memset_attempts_before_fail = test_number;
+
+		result = profile_handle_initialize(
+		          &profile_handle,
+		          PROFILE_HANDLE_DEFAULT_NUMBER_OF_TOP_ITEMS,
+		          &error );
+
+		if( pff_test_memset_attempts_before_fail != -1 )
+		{
+			pff_test_memset_attempts_before_fail = -1;
+
+			if( profile_handle != NULL )
+			{
+				profile_handle_free(
+				 &profile_handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			PFF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			PFF_TEST_ASSERT_IS_NULL(
+			 "profile_handle",
+			 profile_handle );
+
+			PFF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_PFF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( profile_handle != NULL )
+	{
+		profile_handle_free(
+		 &profile_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the profile_handle_free function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_tools_profile_handle_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = profile_handle_free(
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the profile_handle_add_item function
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_tools_profile_handle_add_item(
+     void )
+{
+	profile_values_t values;
+
+	libcerror_error_t *error         = NULL;
+	profile_handle_t *profile_handle = NULL;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = profile_handle_initialize(
+	          &profile_handle,
+	          2,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "profile_handle",
+	 profile_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	values.elapsed_time                  = 2500;
+	values.read_size                     = 8192;
+	values.number_of_read_blocks         = 2;
+	values.number_of_decompressed_blocks = 0;
+	values.output_size                   = 1024;
+
+	result = profile_handle_add_item(
+	          profile_handle,
+	          100,
+	          LIBPFF_ITEM_TYPE_EMAIL,
+	          _SYSTEM_STRING( "Inbox" ),
+	          5,
+	          &values,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	values.elapsed_time = 500;
+
+	result = profile_handle_add_item(
+	          profile_handle,
+	          200,
+	          LIBPFF_ITEM_TYPE_EMAIL,
+	          _SYSTEM_STRING( "Inbox" ),
+	          5,
+	          &values,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	values.elapsed_time = 70000;
+
+	result = profile_handle_add_item(
+	          profile_handle,
+	          300,
+	          LIBPFF_ITEM_TYPE_CONTACT,
+	          NULL,
+	          0,
+	          &values,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The fastest item is no longer one of the slowest items
+	 */
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "profile_handle->number_of_top_items",
+	 profile_handle->number_of_top_items,
+	 2 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT32(
+	 "profile_handle->top_items[ 0 ].identifier",
+	 profile_handle->top_items[ 0 ].identifier,
+	 300 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT32(
+	 "profile_handle->top_items[ 1 ].identifier",
+	 profile_handle->top_items[ 1 ].identifier,
+	 100 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "profile_handle->item_type_statistics[ LIBPFF_ITEM_TYPE_EMAIL ].number_of_items",
+	 profile_handle->item_type_statistics[ LIBPFF_ITEM_TYPE_EMAIL ].number_of_items,
+	 (uint64_t) 2 );
+
+	PFF_TEST_ASSERT_EQUAL_INT64(
+	 "profile_handle->item_type_statistics[ LIBPFF_ITEM_TYPE_EMAIL ].maximum_elapsed_time",
+	 profile_handle->item_type_statistics[ LIBPFF_ITEM_TYPE_EMAIL ].maximum_elapsed_time,
+	 (int64_t) 2500 );
+
+	/* 0.5 ms is in the < 1 ms bucket and 2.5 ms in the 2 - 4 ms bucket
+	 */
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "profile_handle->item_type_statistics[ LIBPFF_ITEM_TYPE_EMAIL ].time_histogram[ 0 ]",
+	 profile_handle->item_type_statistics[ LIBPFF_ITEM_TYPE_EMAIL ].time_histogram[ 0 ],
+	 (uint64_t) 1 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "profile_handle->item_type_statistics[ LIBPFF_ITEM_TYPE_EMAIL ].time_histogram[ 2 ]",
+	 profile_handle->item_type_statistics[ LIBPFF_ITEM_TYPE_EMAIL ].time_histogram[ 2 ],
+	 (uint64_t) 1 );
+
+	/* Test error cases
+	 */
+	result = profile_handle_add_item(
+	          NULL,
+	          100,
+	          LIBPFF_ITEM_TYPE_EMAIL,
+	          NULL,
+	          0,
+	          &values,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = profile_handle_add_item(
+	          profile_handle,
+	          100,
+	          LIBPFF_ITEM_TYPE_EMAIL,
+	          NULL,
+	          5,
+	          &values,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = profile_handle_add_item(
+	          profile_handle,
+	          100,
+	          LIBPFF_ITEM_TYPE_EMAIL,
+	          NULL,
+	          0,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = profile_handle_free(
+	          &profile_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "profile_handle",
+	 profile_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( profile_handle != NULL )
+	{
+		profile_handle_free(
+		 &profile_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the profile_handle_start_measurement and profile_handle_stop_measurement functions
+ * Returns 1 if successful or 0 if not
+ */
+int pff_test_tools_profile_handle_measurement(
+     void )
+{
+	profile_measurement_t nested_measurement;
+	profile_measurement_t measurement;
+
+	libcerror_error_t *error         = NULL;
+	profile_handle_t *profile_handle = NULL;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = profile_handle_initialize(
+	          &profile_handle,
+	          PROFILE_HANDLE_DEFAULT_NUMBER_OF_TOP_ITEMS,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "profile_handle",
+	 profile_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = profile_handle_start_measurement(
+	          profile_handle,
+	          &measurement,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	profile_handle->output_size += 100;
+
+	result = profile_handle_start_measurement(
+	          profile_handle,
+	          &nested_measurement,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	profile_handle->output_size += 400;
+
+	/* Stopping a measurement that is not the current measurement fails
+	 */
+	result = profile_handle_stop_measurement(
+	          profile_handle,
+	          &measurement,
+	          1,
+	          LIBPFF_ITEM_TYPE_FOLDER,
+	          NULL,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = profile_handle_stop_measurement(
+	          profile_handle,
+	          &nested_measurement,
+	          2,
+	          LIBPFF_ITEM_TYPE_EMAIL,
+	          NULL,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = profile_handle_stop_measurement(
+	          profile_handle,
+	          &measurement,
+	          1,
+	          LIBPFF_ITEM_TYPE_FOLDER,
+	          NULL,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "profile_handle->current_measurement",
+	 profile_handle->current_measurement );
+
+	/* The output of the nested item is not accounted to the enclosing item
+	 */
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "profile_handle->item_type_statistics[ LIBPFF_ITEM_TYPE_EMAIL ].total_values.output_size",
+	 profile_handle->item_type_statistics[ LIBPFF_ITEM_TYPE_EMAIL ].total_values.output_size,
+	 (uint64_t) 400 );
+
+	PFF_TEST_ASSERT_EQUAL_UINT64(
+	 "profile_handle->item_type_statistics[ LIBPFF_ITEM_TYPE_FOLDER ].total_values.output_size",
+	 profile_handle->item_type_statistics[ LIBPFF_ITEM_TYPE_FOLDER ].total_values.output_size,
+	 (uint64_t) 100 );
+
+	/* Test error cases
+	 */
+	result = profile_handle_start_measurement(
+	          NULL,
+	          &measurement,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = profile_handle_start_measurement(
+	          profile_handle,
+	          NULL,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = profile_handle_stop_measurement(
+	          NULL,
+	          &measurement,
+	          1,
+	          LIBPFF_ITEM_TYPE_FOLDER,
+	          NULL,
+	          0,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	PFF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = profile_handle_free(
+	          &profile_handle,
+	          &error );
+
+	PFF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "profile_handle",
+	 profile_handle );
+
+	PFF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( profile_handle != NULL )
+	{
+		profile_handle_free(
+		 &profile_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc PFF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] PFF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	PFF_TEST_UNREFERENCED_PARAMETER( argc )
+	PFF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	PFF_TEST_RUN(
+	 "profile_handle_initialize",
+	 pff_test_tools_profile_handle_initialize );
+
+	PFF_TEST_RUN(
+	 "profile_handle_free",
+	 pff_test_tools_profile_handle_free );
+
+	PFF_TEST_RUN(
+	 "profile_handle_add_item",
+	 pff_test_tools_profile_handle_add_item );
+
+	PFF_TEST_RUN(
+	 "profile_handle_measurement",
+	 pff_test_tools_profile_handle_measurement );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
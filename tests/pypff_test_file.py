@@ -297,6 +297,43 @@ class FileTypeTests(unittest.TestCase):
 
     pff_file.close()
 
+  def test_get_number_of_recovered_items(self):
+    """Tests the get_number_of_recovered_items function and number_of_recovered_items property."""
+    test_source = unittest.source
+    if not test_source:
+      raise unittest.SkipTest("missing source")
+
+    pff_file = pypff.file()
+
+    pff_file.open(test_source)
+
+    number_of_recovered_items = pff_file.get_number_of_recovered_items()
+    self.assertIsNotNone(number_of_recovered_items)
+
+    self.assertIsNotNone(pff_file.number_of_recovered_items)
+
+    pff_file.close()
+
+  def test_get_item_by_identifier(self):
+    """Tests the get_item_by_identifier function."""
+    test_source = unittest.source
+    if not test_source:
+      raise unittest.SkipTest("missing source")
+
+    pff_file = pypff.file()
+
+    pff_file.open(test_source)
+
+    message_store = pff_file.get_message_store()
+    if message_store:
+      identifier = message_store.get_identifier()
+
+      item = pff_file.get_item_by_identifier(identifier)
+      self.assertIsNotNone(item)
+      self.assertEqual(item.identifier, identifier)
+
+    pff_file.close()
+
 
 if __name__ == "__main__":
   argument_parser = argparse.ArgumentParser()
@@ -0,0 +1,150 @@
+#!/usr/bin/env python
+#
+# Python-bindings item reference type test script
+#
+# Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+#
+# Refer to AUTHORS for acknowledgements.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+import argparse
+import os
+import pickle
+import sys
+import unittest
+
+import pypff
+
+
+class ItemReferenceTypeTests(unittest.TestCase):
+  """Tests the item reference type."""
+
+  def test_initialize(self):
+    """Tests the initialize function."""
+    item_reference = pypff.item_reference("test.pst", 33)
+
+    self.assertEqual(item_reference.filename, "test.pst")
+    self.assertEqual(item_reference.identifier, 33)
+    self.assertIsNone(item_reference.item_index)
+    self.assertFalse(item_reference.is_orphan())
+    self.assertFalse(item_reference.is_recovered())
+
+    item_reference = pypff.item_reference(
+        "test.pst", 33, item_index=2, is_recovered=True)
+
+    self.assertEqual(item_reference.item_index, 2)
+    self.assertFalse(item_reference.is_orphan())
+    self.assertTrue(item_reference.is_recovered())
+
+    with self.assertRaises(TypeError):
+      pypff.item_reference(None, 33)
+
+    with self.assertRaises(ValueError):
+      pypff.item_reference("test.pst", 33, is_orphan=True)
+
+    with self.assertRaises(ValueError):
+      pypff.item_reference(
+          "test.pst", 33, item_index=2, is_orphan=True, is_recovered=True)
+
+  def test_pickle(self):
+    """Tests pickling and unpickling."""
+    item_reference = pypff.item_reference(
+        "test.pst", 33, item_index=2, is_orphan=True)
+
+    item_reference = pickle.loads(pickle.dumps(item_reference))
+
+    self.assertEqual(item_reference.filename, "test.pst")
+    self.assertEqual(item_reference.identifier, 33)
+    self.assertEqual(item_reference.item_index, 2)
+    self.assertTrue(item_reference.is_orphan())
+    self.assertFalse(item_reference.is_recovered())
+
+  def test_pickle_recovered(self):
+    """Tests pickling a reference to a recovered item."""
+    item_reference = pypff.item_reference(
+        "test.pst", 33, item_index=2, is_recovered=True)
+
+    # The items are not recovered when the file is opened again.
+    with self.assertRaises(TypeError):
+      pickle.dumps(item_reference)
+
+    with self.assertRaises(IOError):
+      item_reference.get_item()
+
+  def test_get_item(self):
+    """Tests the get_item function."""
+    test_source = unittest.source
+    if not test_source:
+      raise unittest.SkipTest("missing source")
+
+    pff_file = pypff.file()
+
+    pff_file.open(test_source)
+
+    message_store = pff_file.get_message_store()
+    if not message_store:
+      pff_file.close()
+      raise unittest.SkipTest("missing message store")
+
+    item_reference = message_store.get_reference()
+    self.assertIsNotNone(item_reference)
+
+    item_reference = pickle.loads(pickle.dumps(item_reference))
+
+    item = item_reference.get_item()
+    self.assertIsNotNone(item)
+    self.assertEqual(item.identifier, message_store.identifier)
+
+    if pff_file.number_of_orphan_items > 0:
+      orphan_item = pff_file.get_orphan_item(0)
+
+      item_reference = orphan_item.get_reference()
+      self.assertTrue(item_reference.is_orphan())
+
+      item_reference = pickle.loads(pickle.dumps(item_reference))
+
+      item = item_reference.get_item()
+      self.assertIsNotNone(item)
+      self.assertEqual(item.identifier, orphan_item.identifier)
+
+    pff_file.close()
+
+    pypff.clear_file_cache()
+
+    if os.path.isfile(test_source):
+      with open(test_source, "rb") as file_object:
+        pff_file.open_file_object(file_object)
+
+        message_store = pff_file.get_message_store()
+        if message_store:
+          with self.assertRaises(IOError):
+            message_store.get_reference()
+
+        pff_file.close()
+
+
+if __name__ == "__main__":
+  argument_parser = argparse.ArgumentParser()
+
+  argument_parser.add_argument(
+      "source", nargs="?", action="store", metavar="PATH",
+      default=None, help="path of the source file.")
+
+  options, unknown_options = argument_parser.parse_known_args()
+  unknown_options.insert(0, sys.argv[0])
+
+  setattr(unittest, "source", options.source)
+
+  unittest.main(argv=unknown_options, verbosity=2)
@@ -0,0 +1,129 @@
+#!/usr/bin/env python
+#
+# Python-bindings property set type test script
+#
+# Copyright (C) 2008-2021, Joachim Metz <joachim.metz@gmail.com>
+#
+# Refer to AUTHORS for acknowledgements.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+import argparse
+import sys
+import unittest
+
+import pypff
+
+
+# The PS_PUBLIC_STRINGS property set GUID: {00020329-0000-0000-c000-000000000046}
+PS_PUBLIC_STRINGS = (
+    b"\x29\x03\x02\x00\x00\x00\x00\x00\xc0\x00\x00\x00\x00\x00\x00\x46")
+
+
+class PropertySetTypeTests(unittest.TestCase):
+  """Tests the property set type."""
+
+  def test_append(self):
+    """Tests the append functions."""
+    property_set = pypff.property_set()
+
+    self.assertEqual(property_set.number_of_requests, 0)
+    self.assertFalse(property_set.is_prepared())
+
+    request_index = property_set.append_entry_type(0x3001)
+    self.assertEqual(request_index, 0)
+
+    request_index = property_set.append_entry_type(0x3001, value_type=0x001f)
+    self.assertEqual(request_index, 1)
+
+    request_index = property_set.append_numeric_name(
+        PS_PUBLIC_STRINGS, 0x8503)
+    self.assertEqual(request_index, 2)
+
+    request_index = property_set.append_string_name(
+        PS_PUBLIC_STRINGS, "Keywords")
+    self.assertEqual(request_index, 3)
+
+    self.assertEqual(property_set.get_number_of_requests(), 4)
+
+    with self.assertRaises(ValueError):
+      property_set.append_numeric_name(b"\x00" * 8, 0x8503)
+
+    with self.assertRaises(TypeError):
+      property_set.append_string_name(PS_PUBLIC_STRINGS, None)
+
+  def test_get_entries_by_property_set(self):
+    """Tests the get_entries_by_property_set function."""
+    test_source = unittest.source
+    if not test_source:
+      raise unittest.SkipTest("missing source")
+
+    pff_file = pypff.file()
+
+    pff_file.open(test_source)
+
+    message_store = pff_file.get_message_store()
+    if not message_store or message_store.number_of_record_sets == 0:
+      pff_file.close()
+      raise unittest.SkipTest("missing message store")
+
+    property_set = pypff.property_set()
+    property_set.append_entry_type(0x3001)
+    property_set.append_entry_type(0x3001, value_type=0x0003)
+    property_set.append_string_name(PS_PUBLIC_STRINGS, "Keywords")
+
+    with self.assertRaises(IOError):
+      message_store.get_entries_by_property_set(property_set)
+
+    pff_file.prepare_property_set(property_set)
+    self.assertTrue(property_set.is_prepared())
+
+    record_entries = message_store.get_entries_by_property_set(property_set)
+    self.assertEqual(len(record_entries), 3)
+    self.assertIsNone(record_entries[1])
+
+    record_set = message_store.get_record_set(0)
+    expected_record_entry = None
+    for record_entry in record_set.entries:
+      if record_entry.entry_type == 0x3001:
+        expected_record_entry = record_entry
+        break
+
+    if expected_record_entry is None:
+      self.assertIsNone(record_entries[0])
+    else:
+      self.assertIsNotNone(record_entries[0])
+      self.assertEqual(
+          record_entries[0].value_type, expected_record_entry.value_type)
+      self.assertEqual(record_entries[0].data, expected_record_entry.data)
+
+    with self.assertRaises(TypeError):
+      message_store.get_entries_by_property_set(None)
+
+    pff_file.close()
+
+
+if __name__ == "__main__":
+  argument_parser = argparse.ArgumentParser()
+
+  argument_parser.add_argument(
+      "source", nargs="?", action="store", metavar="PATH",
+      default=None, help="path of the source file.")
+
+  options, unknown_options = argument_parser.parse_known_args()
+  unknown_options.insert(0, sys.argv[0])
+
+  setattr(unittest, "source", options.source)
+
+  unittest.main(argv=unknown_options, verbosity=2)
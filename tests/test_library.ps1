@@ -6,7 +6,7 @@ $ExitSuccess = 0
 $ExitFailure = 1
 $ExitIgnore = 77
 
-$LibraryTests = "allocation_table attached_file_io_handle attachment column_definition compression data_array data_array_entry data_block deflate descriptors_index encryption error file_header folder free_map index index_node index_value io_handle io_handle2 index_tree item item_descriptor item_tree item_values local_descriptor_node local_descriptor_value local_descriptors local_descriptors_tree mapi_value message multi_value name_to_id_map_entry notify offsets_index record_entry record_set reference_descriptor table table_block_index table_header table_index_value value_type"
+$LibraryTests = "allocation_statistics allocation_table attached_file_io_handle attachment caller_io_handle caller_open_state column_definition compression conversation_index data_array data_array_entry data_block deflate descriptor_io_handle descriptors_index encryption entry_identifier error file_header folder format_functions free_map index index_layout index_node index_value io_handle io_handle2 index_tree item item_descriptor item_tree item_tree_update item_values item_visitor local_descriptor_node local_descriptor_nodes_cache local_descriptor_value local_descriptors local_descriptors_tree mapi_value message multi_value name_to_id_map_entry notify offsets_index open_worker property_set reader_context record_entry record_set recovered_index reference_descriptor rtf_decoder sort_entry table table_block_index table_cache table_header table_index_value task_deque value_type"
 $LibraryTestsWithInput = "file support"
 $OptionSets = ""
 
@@ -8,7 +8,7 @@ EXIT_FAILURE=1;
 EXIT_IGNORE=77;
 
 TEST_FUNCTIONS="";
-TEST_FUNCTIONS_WITH_INPUT="file support";
+TEST_FUNCTIONS_WITH_INPUT="file item_reference property_set support";
 OPTION_SETS="";
 
 TEST_TOOL_DIRECTORY=".";
@@ -7,7 +7,7 @@ EXIT_SUCCESS=0;
 EXIT_FAILURE=1;
 EXIT_IGNORE=77;
 
-TOOLS_TESTS="info_handle output signal";
+TOOLS_TESTS="directory_handle info_handle output profile_handle signal";
 TOOLS_TESTS_WITH_INPUT="";
 OPTION_SETS="";
 